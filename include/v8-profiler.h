@@ -304,6 +304,33 @@ class V8EXPORT HeapSnapshot {
 };
 
 
+/**
+ * An interface for exporting data from V8 in chunks, using a "push"
+ * model: V8 fills a buffer and hands it over to the embedder.
+ */
+class V8EXPORT OutputStream {
+ public:
+  enum WriteResult {
+    kContinue = 0,
+    kAbort = 1
+  };
+  virtual ~OutputStream() {}
+
+  /** Notifies about the end of stream. */
+  virtual void EndOfStream() = 0;
+
+  /** Returns the preferred output chunk size. Called only once. */
+  virtual int GetChunkSize() { return 1024; }
+
+  /**
+   * Writes the next chunk of data into the stream. Writing can be stopped
+   * by returning kAbort as the result, in which case EndOfStream is not
+   * called.
+   */
+  virtual WriteResult WriteAsciiChunk(char* data, int size) = 0;
+};
+
+
 /**
  * Interface for controlling heap profiling.
  */
@@ -320,6 +347,27 @@ class V8EXPORT HeapProfiler {
 
   /** Takes a heap snapshot and returns it. Title may be an empty string. */
   static const HeapSnapshot* TakeSnapshot(Handle<String> title);
+
+  /**
+   * Writes a heap snapshot to the stream without building it in memory.
+   * Unlike TakeSnapshot, the memory used outside of the JS heap does not
+   * grow with the heap size and the snapshot is not retained.
+   *
+   * The output consists of comma separated ASCII lines:
+   *
+   *   heap-snapshot,"<title>"
+   *   string,<string id>,"<characters>"
+   *   node,<type>,<node id>,<name string id>,<self size>
+   *   edge,<type>,<name string id or element index>,<target node id>
+   *
+   * Node and edge types are the values of HeapGraphNode::Type and
+   * HeapGraphEdge::Type. A node line is followed by the lines of its
+   * outgoing edges. A string line always precedes the first line that
+   * refers to its id; string 0 is the empty string and is not written.
+   * Node 0 is the root. String characters outside of printable ASCII as
+   * well as '"' and the backslash are written as \uXXXX escapes.
+   */
+  static void StreamSnapshot(Handle<String> title, OutputStream* stream);
 };
 
 
@@ -523,6 +523,20 @@ class V8EXPORT ScriptData {  // NOLINT
    */
   static ScriptData* PreCompile(const char* input, int length);
 
+  /**
+   * Pre-compiles the specified script (context-independent).
+   *
+   * Unlike the other variants this does not use the heap and does not
+   * write to any state shared with the VM; it only reads flags and tables
+   * that are fixed once V8 has been initialized. It can therefore be
+   * called on any thread without using Lockers, e.g. to preparse a script
+   * in the background while the VM runs scripts on its own thread.
+   *
+   * \param input Pointer to UTF-16 script source code.
+   * \param length Length of UTF-16 script source code.
+   */
+  static ScriptData* PreCompile(const uint16_t* input, int length);
+
   /**
    * Pre-compiles the specified script (context-independent).
    *
@@ -581,6 +595,50 @@ class V8EXPORT ScriptOrigin {
 };
 
 
+/**
+ * The code generated for a script, which can be stored between runs of the
+ * process.  When a code cache is given to Script::Compile the script is
+ * compiled without parsing it or generating code for it again.
+ */
+class V8EXPORT CodeCacheData {  // NOLINT
+ public:
+  virtual ~CodeCacheData() { }
+
+  /**
+   * Compiles the specified script in the current context and returns the
+   * code generated for it.  Returns NULL if the script could not be
+   * compiled or contains code that can't be cached.
+   *
+   * \param source Script source code.
+   * \param origin Script origin, owned by caller, no references are kept
+   *   when Create() returns.
+   */
+  static CodeCacheData* Create(Handle<String> source,
+                               ScriptOrigin* origin = NULL);
+
+  /**
+   * Load a previous code cache.
+   *
+   * \param data Pointer to data returned by a call to Data() of a previous
+   *   CodeCacheData. Ownership is not transferred.
+   * \param length Length of data.
+   */
+  static CodeCacheData* New(const char* data, int length);
+
+  /**
+   * Returns the length of Data().
+   */
+  virtual int Length() = 0;
+
+  /**
+   * Returns a serialized representation of this CodeCacheData that can later
+   * be passed to New(). NOTE: Serialized data is platform-dependent and is
+   * only used by a V8 of the same version running with the same flags.
+   */
+  virtual const char* Data() = 0;
+};
+
+
 /**
  * A compiled JavaScript script.
  */
@@ -658,6 +716,26 @@ class V8EXPORT Script {
                                Handle<Value> file_name,
                                Handle<String> script_data = Handle<String>());
 
+  /**
+   * Compiles the specified script (bound to current context) using the code
+   * in a code cache that was created by CodeCacheData::Create() for the same
+   * source, possibly by another process.  If the code cache was created for
+   * another source, by another version of V8 or with other flags the script
+   * is compiled as usual.
+   *
+   * \param source Script source code.
+   * \param code_cache Code cache, owned by caller, no references are kept
+   *   when Compile() returns.
+   * \param origin Script origin, owned by caller, no references are kept
+   *   when Compile() returns.  May be NULL.
+   * \return Compiled script object, bound to the context that was active
+   *   when this function was called.  When run it will always use this
+   *   context.
+   */
+  static Local<Script> Compile(Handle<String> source,
+                               CodeCacheData* code_cache,
+                               ScriptOrigin* origin);
+
   /**
    * Runs the script returning the resulting value.  If the script is
    * context independent (created using ::New) it will be run in the
@@ -2416,6 +2494,84 @@ class V8EXPORT HeapStatistics {
 };
 
 
+/**
+ * Isolate represents an isolated instance of the V8 engine.  V8
+ * isolates have completely separate states.  Objects from one isolate
+ * must not be used in other isolates.  When V8 is initialized a
+ * default isolate is implicitly created and used by all threads that
+ * have not entered another isolate.  The embedder can create
+ * additional isolates and use them in parallel in multiple threads.
+ * The v8::Locker and v8::Unlocker objects synchronize the threads
+ * using the isolate that is current when they are constructed.
+ */
+class V8EXPORT Isolate {
+ public:
+  /**
+   * Stack-allocated class which sets the isolate for all operations
+   * executed within a local scope.
+   */
+  class V8EXPORT Scope {
+   public:
+    explicit Scope(Isolate* isolate) : isolate_(isolate) {
+      isolate->Enter();
+    }
+
+    ~Scope() { isolate_->Exit(); }
+
+   private:
+    Isolate* const isolate_;
+
+    // Disallow copying and assigning.
+    Scope(const Scope&);
+    void operator=(const Scope&);
+  };
+
+  /**
+   * Creates a new isolate.  Does not change the currently entered
+   * isolate.  The VM in the new isolate is initialized when it is
+   * first used by a thread that has entered it.
+   */
+  static Isolate* New();
+
+  /**
+   * Returns the entered isolate for the current thread or the default
+   * isolate if the thread has not entered any.
+   */
+  static Isolate* GetCurrent();
+
+  /**
+   * Methods below this point require holding a lock (using Locker) in
+   * a multi-threaded environment.
+   */
+
+  /**
+   * Sets this isolate as the entered one for the current thread.
+   * Saves the previously entered one (if any), so that it can be
+   * restored when exiting.  Re-entering an isolate is allowed.
+   */
+  void Enter();
+
+  /**
+   * Exits this isolate by restoring the previously entered one in the
+   * current thread.  The isolate may still stay the same, if it was
+   * entered more than once.
+   */
+  void Exit();
+
+  /**
+   * Disposes the isolate.  The isolate must not be entered by any
+   * thread to be disposable.  The default isolate cannot be disposed.
+   */
+  void Dispose();
+
+ private:
+  Isolate();
+  Isolate(const Isolate&);
+  ~Isolate();
+  void operator=(const Isolate&);
+};
+
+
 /**
  * Container class for static utility functions.
  */
@@ -2739,7 +2895,9 @@ class V8EXPORT V8 {
 
   /**
    * Optional notification that the embedder is idle.
-   * V8 uses the notification to reduce memory footprint.
+   * V8 uses the notification to reduce memory footprint, and to do a
+   * full garbage collection ahead of time when the old generation is
+   * getting close to the size that would trigger one during execution.
    * This call can be used repeatedly if the embedder remains idle.
    * Returns true if the embedder should stop calling IdleNotification
    * until real work has been done.  This indicates that V8 has done
@@ -67,20 +67,22 @@ namespace v8 {
 
 
 #define EXCEPTION_PREAMBLE()                                      \
-  thread_local.IncrementCallDepth();                              \
+  i::HandleScopeImplementer::instance()->IncrementCallDepth();    \
   ASSERT(!i::Top::external_caught_exception());                   \
   bool has_pending_exception = false
 
 
 #define EXCEPTION_BAILOUT_CHECK(value)                                         \
   do {                                                                         \
-    thread_local.DecrementCallDepth();                                         \
+    i::HandleScopeImplementer* handle_scope_implementer =                      \
+        i::HandleScopeImplementer::instance();                                 \
+    handle_scope_implementer->DecrementCallDepth();                            \
     if (has_pending_exception) {                                               \
-      if (thread_local.CallDepthIsZero() && i::Top::is_out_of_memory()) {      \
-        if (!thread_local.ignore_out_of_memory())                              \
+      bool call_depth_is_zero = handle_scope_implementer->CallDepthIsZero();   \
+      if (call_depth_is_zero && i::Top::is_out_of_memory()) {                  \
+        if (!handle_scope_implementer->ignore_out_of_memory())                 \
           i::V8::FatalProcessOutOfMemory(NULL);                                \
       }                                                                        \
-      bool call_depth_is_zero = thread_local.CallDepthIsZero();                \
       i::Top::OptionalRescheduleException(call_depth_is_zero);                 \
       return value;                                                            \
     }                                                                          \
@@ -96,12 +98,6 @@ namespace v8 {
     }                                                                          \
   } while (false)
 
-// --- D a t a   t h a t   i s   s p e c i f i c   t o   a   t h r e a d ---
-
-
-static i::HandleScopeImplementer thread_local;
-
-
 // --- E x c e p t i o n   B e h a v i o r ---
 
 
@@ -252,7 +248,32 @@ static inline bool EmptyCheck(const char* location, const v8::Data* obj) {
 // --- S t a t i c s ---
 
 
-static i::StringInputBuffer write_input_buffer;
+namespace internal {
+
+class ApiState::Data {
+ public:
+  StringInputBuffer write_input_buffer_;
+
+  // To distinguish the function templates, so that we can find them in the
+  // function cache of the global context.
+  int next_serial_number_;
+
+  // The use counter shared by the fresh strings of StringTracker and the
+  // new space top when it was valid.
+  int string_use_count_;
+  Address string_last_top_;
+
+#ifdef ENABLE_DEBUGGER_SUPPORT
+  // The callbacks of the debugger API that are wrapped for the debugger.
+  v8::Debug::EventCallback event_callback_;
+  v8::Debug::MessageHandler message_handler_;
+#endif
+};
+
+
+DEFINE_ISOLATE_COMPONENT(ApiState)
+
+}  // namespace internal
 
 
 static inline bool EnsureInitialized(const char* location) {
@@ -268,7 +289,7 @@ static inline bool EnsureInitialized(const char* location) {
 
 ImplementationUtilities::HandleScopeData*
     ImplementationUtilities::CurrentHandleScope() {
-  return &i::HandleScope::current_;
+  return &i::HandleScope::data()->current_;
 }
 
 
@@ -332,7 +353,7 @@ RegisteredExtension* RegisteredExtension::first_extension_ = NULL;
 
 
 RegisteredExtension::RegisteredExtension(Extension* extension)
-    : extension_(extension), state_(UNVISITED) { }
+    : extension_(extension) { }
 
 
 void RegisteredExtension::Register(RegisteredExtension* that) {
@@ -475,23 +496,27 @@ void Context::Enter() {
   if (IsDeadCheck("v8::Context::Enter()")) return;
   ENTER_V8;
   i::Handle<i::Context> env = Utils::OpenHandle(this);
-  thread_local.EnterContext(env);
+  i::HandleScopeImplementer* thread_local =
+      i::HandleScopeImplementer::instance();
+  thread_local->EnterContext(env);
 
-  thread_local.SaveContext(i::Top::context());
+  thread_local->SaveContext(i::Top::context());
   i::Top::set_context(*env);
 }
 
 
 void Context::Exit() {
   if (!i::V8::IsRunning()) return;
-  if (!ApiCheck(thread_local.LeaveLastContext(),
+  i::HandleScopeImplementer* thread_local =
+      i::HandleScopeImplementer::instance();
+  if (!ApiCheck(thread_local->LeaveLastContext(),
                 "v8::Context::Exit()",
                 "Cannot exit non-entered context")) {
     return;
   }
 
   // Content of 'last_context' could be NULL.
-  i::Context* last_context = thread_local.RestoreContext();
+  i::Context* last_context = thread_local->RestoreContext();
   i::Top::set_context(last_context);
 }
 
@@ -674,11 +699,6 @@ void FunctionTemplate::Inherit(v8::Handle<FunctionTemplate> value) {
 }
 
 
-// To distinguish the function templates, so that we can find them in the
-// function cache of the global context.
-static int next_serial_number = 0;
-
-
 Local<FunctionTemplate> FunctionTemplate::New(InvocationCallback callback,
     v8::Handle<Value> data, v8::Handle<Signature> signature) {
   EnsureInitialized("v8::FunctionTemplate::New()");
@@ -689,7 +709,8 @@ Local<FunctionTemplate> FunctionTemplate::New(InvocationCallback callback,
   i::Handle<i::FunctionTemplateInfo> obj =
       i::Handle<i::FunctionTemplateInfo>::cast(struct_obj);
   InitializeFunctionTemplate(obj);
-  obj->set_serial_number(i::Smi::FromInt(next_serial_number++));
+  int serial_number = i::ApiState::data()->next_serial_number_++;
+  obj->set_serial_number(i::Smi::FromInt(serial_number));
   if (callback != 0) {
     if (data.IsEmpty()) data = v8::Undefined();
     Utils::ToLocal(obj)->SetCallHandler(callback, data);
@@ -1120,6 +1141,11 @@ ScriptData* ScriptData::PreCompile(const char* input, int length) {
 }
 
 
+ScriptData* ScriptData::PreCompile(const uint16_t* input, int length) {
+  return i::PreParse(i::Vector<const i::uc16>(input, length));
+}
+
+
 ScriptData* ScriptData::PreCompile(v8::Handle<String> source) {
   i::Handle<i::String> str = Utils::OpenHandle(*source);
   return i::PreParse(str, NULL, NULL);
@@ -1142,6 +1168,74 @@ ScriptData* ScriptData::New(const char* data, int length) {
 }
 
 
+static void OpenScriptOrigin(v8::ScriptOrigin* origin,
+                             i::Handle<i::Object>* name_obj,
+                             int* line_offset,
+                             int* column_offset) {
+  *line_offset = 0;
+  *column_offset = 0;
+  if (origin != NULL) {
+    if (!origin->ResourceName().IsEmpty()) {
+      *name_obj = Utils::OpenHandle(*origin->ResourceName());
+    }
+    if (!origin->ResourceLineOffset().IsEmpty()) {
+      *line_offset = static_cast<int>(origin->ResourceLineOffset()->Value());
+    }
+    if (!origin->ResourceColumnOffset().IsEmpty()) {
+      *column_offset =
+          static_cast<int>(origin->ResourceColumnOffset()->Value());
+    }
+  }
+}
+
+
+// --- C o d e C a c h e D a t a ---
+
+
+class CodeCacheDataImpl : public CodeCacheData {
+ public:
+  explicit CodeCacheDataImpl(i::Vector<i::byte> data) : data_(data) { }
+  virtual ~CodeCacheDataImpl() { data_.Dispose(); }
+  virtual int Length() { return data_.length(); }
+  virtual const char* Data() {
+    return reinterpret_cast<const char*>(data_.start());
+  }
+
+ private:
+  i::Vector<i::byte> data_;
+};
+
+
+CodeCacheData* CodeCacheData::Create(v8::Handle<String> source,
+                                     v8::ScriptOrigin* origin) {
+  ON_BAILOUT("v8::CodeCacheData::Create()", return NULL);
+  LOG_API("CodeCacheData::Create");
+  ENTER_V8;
+  i::Handle<i::String> str = Utils::OpenHandle(*source);
+  i::Handle<i::Object> name_obj;
+  int line_offset;
+  int column_offset;
+  OpenScriptOrigin(origin, &name_obj, &line_offset, &column_offset);
+  EXCEPTION_PREAMBLE();
+  i::Vector<i::byte> data =
+      i::Compiler::CompileForCodeCache(str,
+                                       name_obj,
+                                       line_offset,
+                                       column_offset);
+  has_pending_exception = data.is_empty() && i::Top::has_pending_exception();
+  EXCEPTION_BAILOUT_CHECK(NULL);
+  if (data.is_empty()) return NULL;
+  return new CodeCacheDataImpl(data);
+}
+
+
+CodeCacheData* CodeCacheData::New(const char* data, int length) {
+  i::Vector<i::byte> copy = i::Vector<i::byte>::New(length);
+  memcpy(copy.start(), data, length);
+  return new CodeCacheDataImpl(copy);
+}
+
+
 // --- S c r i p t ---
 
 
@@ -1154,19 +1248,9 @@ Local<Script> Script::New(v8::Handle<String> source,
   ENTER_V8;
   i::Handle<i::String> str = Utils::OpenHandle(*source);
   i::Handle<i::Object> name_obj;
-  int line_offset = 0;
-  int column_offset = 0;
-  if (origin != NULL) {
-    if (!origin->ResourceName().IsEmpty()) {
-      name_obj = Utils::OpenHandle(*origin->ResourceName());
-    }
-    if (!origin->ResourceLineOffset().IsEmpty()) {
-      line_offset = static_cast<int>(origin->ResourceLineOffset()->Value());
-    }
-    if (!origin->ResourceColumnOffset().IsEmpty()) {
-      column_offset = static_cast<int>(origin->ResourceColumnOffset()->Value());
-    }
-  }
+  int line_offset;
+  int column_offset;
+  OpenScriptOrigin(origin, &name_obj, &line_offset, &column_offset);
   EXCEPTION_PREAMBLE();
   i::ScriptDataImpl* pre_data_impl = static_cast<i::ScriptDataImpl*>(pre_data);
   // We assert that the pre-data is sane, even though we can actually
@@ -1226,6 +1310,36 @@ Local<Script> Script::Compile(v8::Handle<String> source,
 }
 
 
+Local<Script> Script::Compile(v8::Handle<String> source,
+                              v8::CodeCacheData* code_cache,
+                              v8::ScriptOrigin* origin) {
+  ON_BAILOUT("v8::Script::Compile()", return Local<Script>());
+  LOG_API("Script::Compile");
+  ENTER_V8;
+  i::Handle<i::String> str = Utils::OpenHandle(*source);
+  i::Handle<i::Object> name_obj;
+  int line_offset;
+  int column_offset;
+  OpenScriptOrigin(origin, &name_obj, &line_offset, &column_offset);
+  EXCEPTION_PREAMBLE();
+  i::Vector<const i::byte> data(
+      reinterpret_cast<const i::byte*>(code_cache->Data()),
+      code_cache->Length());
+  i::Handle<i::SharedFunctionInfo> function =
+      i::Compiler::CompileWithCodeCache(str,
+                                        name_obj,
+                                        line_offset,
+                                        column_offset,
+                                        data);
+  has_pending_exception = function.is_null();
+  EXCEPTION_BAILOUT_CHECK(Local<Script>());
+  i::Handle<i::JSFunction> result =
+      i::Factory::NewFunctionFromSharedFunctionInfo(function,
+                                                    i::Top::global_context());
+  return Local<Script>(ToApi<Script>(result));
+}
+
+
 Local<Value> Script::Run() {
   ON_BAILOUT("v8::Script::Run()", return Local<Value>());
   LOG_API("Script::Run");
@@ -2840,16 +2954,18 @@ class StringTracker {
   }
 
   static inline bool IsUseCountLow(i::Address top) {
-    if (last_top_ != top) return true;
-    return use_count_ < kUseLimit;
+    i::ApiState::Data* data = i::ApiState::data();
+    if (data->string_last_top_ != top) return true;
+    return data->string_use_count_ < kUseLimit;
   }
 
   static inline void IncrementUseCount(i::Address top) {
-    if (last_top_ != top) {
-      use_count_ = 0;
-      last_top_ = top;
+    i::ApiState::Data* data = i::ApiState::data();
+    if (data->string_last_top_ != top) {
+      data->string_use_count_ = 0;
+      data->string_last_top_ = top;
     }
-    ++use_count_;
+    ++data->string_use_count_;
   }
 
   // How close to the new space top a fresh string has to be.
@@ -2857,17 +2973,8 @@ class StringTracker {
 
   // The number of uses required to consider a string useful.
   static const int kUseLimit = 32;
-
-  // Single use counter shared by all fresh strings.
-  static int use_count_;
-
-  // Last new space top when the use count above was valid.
-  static i::Address last_top_;
 };
 
-int StringTracker::use_count_ = 0;
-i::Address StringTracker::last_top_ = NULL;
-
 }  // namespace
 
 
@@ -2883,6 +2990,38 @@ int String::Utf8Length() const {
 }
 
 
+// Encodes the characters of a flat two-byte string as UTF-8 like WriteUtf8,
+// but reads them directly from the string and copies ASCII characters
+// without going through the encoder.  Returns the number of bytes written.
+static int WriteUtf8Flat(i::Vector<const i::uc16> chars,
+                         char* buffer,
+                         int capacity,
+                         int* nchars_ref) {
+  int len = chars.length();
+  int fast_end = capacity - (unibrow::Utf8::kMaxEncodedSize - 1);
+  int i;
+  int pos = 0;
+  for (i = 0; i < len && (capacity == -1 || pos < fast_end); i++) {
+    i::uc16 c = chars[i];
+    if (c <= unibrow::Utf8::kMaxOneByteChar) {
+      buffer[pos++] = static_cast<char>(c);
+    } else {
+      pos += unibrow::Utf8::Encode(buffer + pos, c);
+    }
+  }
+  char intermediate[unibrow::Utf8::kMaxEncodedSize];
+  for (; i < len && pos < capacity; i++) {
+    int written = unibrow::Utf8::Encode(intermediate, chars[i]);
+    if (pos + written > capacity) break;
+    for (int j = 0; j < written; j++) buffer[pos + j] = intermediate[j];
+    pos += written;
+  }
+  *nchars_ref = i;
+  if (i == len && (capacity == -1 || pos < capacity)) buffer[pos++] = '\0';
+  return pos;
+}
+
+
 int String::WriteUtf8(char* buffer,
                       int capacity,
                       int* nchars_ref,
@@ -2897,7 +3036,28 @@ int String::WriteUtf8(char* buffer,
     // using StringInputBuffer or Get(i) to access the characters.
     str->TryFlatten();
   }
-  write_input_buffer.Reset(0, *str);
+  if (str->IsFlat()) {
+    int nchars;
+    int pos;
+    if (str->IsAsciiRepresentation()) {
+      // ASCII strings are valid UTF-8 as they are.
+      i::Vector<const char> chars = str->ToAsciiVector();
+      nchars = chars.length();
+      if (capacity != -1 && nchars > capacity) nchars = capacity;
+      memcpy(buffer, chars.start(), nchars);
+      pos = nchars;
+      if (nchars == chars.length() && (capacity == -1 || pos < capacity)) {
+        buffer[pos++] = '\0';
+      }
+    } else {
+      pos = WriteUtf8Flat(str->ToUC16Vector(), buffer, capacity, &nchars);
+    }
+    if (nchars_ref != NULL) *nchars_ref = nchars;
+    return pos;
+  }
+  i::StringInputBuffer* write_input_buffer =
+      &i::ApiState::data()->write_input_buffer_;
+  write_input_buffer->Reset(0, *str);
   int len = str->length();
   // Encode the first K - 3 bytes directly into the buffer since we
   // know there's room for them.  If no capacity is given we copy all
@@ -2907,7 +3067,7 @@ int String::WriteUtf8(char* buffer,
   int pos = 0;
   int nchars = 0;
   for (i = 0; i < len && (capacity == -1 || pos < fast_end); i++) {
-    i::uc32 c = write_input_buffer.GetNext();
+    i::uc32 c = write_input_buffer->GetNext();
     int written = unibrow::Utf8::Encode(buffer + pos, c);
     pos += written;
     nchars++;
@@ -2918,7 +3078,7 @@ int String::WriteUtf8(char* buffer,
     // buffer.
     char intermediate[unibrow::Utf8::kMaxEncodedSize];
     for (; i < len && pos < capacity; i++) {
-      i::uc32 c = write_input_buffer.GetNext();
+      i::uc32 c = write_input_buffer->GetNext();
       int written = unibrow::Utf8::Encode(intermediate, c);
       if (pos + written <= capacity) {
         for (int j = 0; j < written; j++)
@@ -2957,10 +3117,12 @@ int String::WriteAscii(char* buffer,
   if ( (length == -1) || (length > str->length() - start) )
     end = str->length() - start;
   if (end < 0) return 0;
-  write_input_buffer.Reset(start, *str);
+  i::StringInputBuffer* write_input_buffer =
+      &i::ApiState::data()->write_input_buffer_;
+  write_input_buffer->Reset(start, *str);
   int i;
   for (i = 0; i < end; i++) {
-    char c = static_cast<char>(write_input_buffer.GetNext());
+    char c = static_cast<char>(write_input_buffer->GetNext());
     if (c == '\0') c = ' ';
     buffer[i] = c;
   }
@@ -3164,6 +3326,48 @@ void v8::V8::GetHeapStatistics(HeapStatistics* heap_statistics) {
 }
 
 
+// --- I s o l a t e ---
+
+Isolate* Isolate::New() {
+  i::Isolate* isolate = i::Isolate::New();
+  return reinterpret_cast<Isolate*>(isolate);
+}
+
+
+Isolate* Isolate::GetCurrent() {
+  i::Isolate* isolate = i::Isolate::Current();
+  return reinterpret_cast<Isolate*>(isolate);
+}
+
+
+void Isolate::Enter() {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->Enter();
+}
+
+
+void Isolate::Exit() {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->Exit();
+}
+
+
+void Isolate::Dispose() {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  if (!ApiCheck(!isolate->IsDefaultIsolate(),
+                "v8::Isolate::Dispose()",
+                "The default isolate cannot be disposed")) {
+    return;
+  }
+  if (!ApiCheck(i::Isolate::Current() != isolate,
+                "v8::Isolate::Dispose()",
+                "Disposing the isolate that is entered by this thread")) {
+    return;
+  }
+  isolate->Dispose();
+}
+
+
 bool v8::V8::IdleNotification() {
   // Returning true tells the caller that it need not
   // continue to call IdleNotification.
@@ -3310,7 +3514,8 @@ bool Context::InContext() {
 
 v8::Local<v8::Context> Context::GetEntered() {
   if (IsDeadCheck("v8::Context::GetEntered()")) return Local<Context>();
-  i::Handle<i::Object> last = thread_local.LastEnteredContext();
+  i::Handle<i::Object> last =
+      i::HandleScopeImplementer::instance()->LastEnteredContext();
   if (last.is_null()) return Local<Context>();
   i::Handle<i::Context> context = i::Handle<i::Context>::cast(last);
   return Utils::ToLocal(context);
@@ -3743,7 +3948,7 @@ Local<Integer> Integer::NewFromUnsigned(uint32_t value) {
 
 
 void V8::IgnoreOutOfMemoryException() {
-  thread_local.set_ignore_out_of_memory(true);
+  i::HandleScopeImplementer::instance()->set_ignore_out_of_memory(true);
 }
 
 
@@ -4124,9 +4329,9 @@ Local<Value> Exception::Error(v8::Handle<v8::String> raw_message) {
 
 #ifdef ENABLE_DEBUGGER_SUPPORT
 
-static v8::Debug::EventCallback event_callback = NULL;
-
 static void EventCallbackWrapper(const v8::Debug::EventDetails& event_details) {
+  v8::Debug::EventCallback event_callback =
+      i::ApiState::data()->event_callback_;
   if (event_callback) {
     event_callback(event_details.GetEvent(),
                    event_details.GetExecutionState(),
@@ -4141,7 +4346,7 @@ bool Debug::SetDebugEventListener(EventCallback that, Handle<Value> data) {
   ON_BAILOUT("v8::Debug::SetDebugEventListener()", return false);
   ENTER_V8;
 
-  event_callback = that;
+  i::ApiState::data()->event_callback_ = that;
 
   HandleScope scope;
   i::Handle<i::Object> proxy = i::Factory::undefined_value();
@@ -4183,9 +4388,9 @@ void Debug::DebugBreak() {
 }
 
 
-static v8::Debug::MessageHandler message_handler = NULL;
-
 static void MessageHandlerWrapper(const v8::Debug::Message& message) {
+  v8::Debug::MessageHandler message_handler =
+      i::ApiState::data()->message_handler_;
   if (message_handler) {
     v8::String::Value json(message.GetJSON());
     message_handler(*json, json.length(), message.GetClientData());
@@ -4202,8 +4407,8 @@ void Debug::SetMessageHandler(v8::Debug::MessageHandler handler,
   CHECK(!message_handler_thread);
 
   // TODO(sgjesse) support the old message handler API through a simple wrapper.
-  message_handler = handler;
-  if (message_handler != NULL) {
+  i::ApiState::data()->message_handler_ = handler;
+  if (handler != NULL) {
     i::Debugger::SetMessageHandler(MessageHandlerWrapper);
   } else {
     i::Debugger::SetMessageHandler(NULL);
@@ -4636,24 +4841,33 @@ const HeapSnapshot* HeapProfiler::TakeSnapshot(Handle<String> title) {
       i::HeapProfiler::TakeSnapshot(*Utils::OpenHandle(*title)));
 }
 
+
+void HeapProfiler::StreamSnapshot(Handle<String> title, OutputStream* stream) {
+  IsDeadCheck("v8::HeapProfiler::StreamSnapshot");
+  i::HeapProfiler::StreamSnapshot(*Utils::OpenHandle(*title), stream);
+}
+
 #endif  // ENABLE_LOGGING_AND_PROFILING
 
 
 namespace internal {
 
 
+DEFINE_ISOLATE_COMPONENT(HandleScopeImplementer)
+
+
 HandleScopeImplementer* HandleScopeImplementer::instance() {
-  return &thread_local;
+  return &data()->instance_;
 }
 
 
 void HandleScopeImplementer::FreeThreadResources() {
-  thread_local.Free();
+  instance()->Free();
 }
 
 
 char* HandleScopeImplementer::ArchiveThread(char* storage) {
-  return thread_local.ArchiveThreadHelper(storage);
+  return instance()->ArchiveThreadHelper(storage);
 }
 
 
@@ -4671,12 +4885,12 @@ char* HandleScopeImplementer::ArchiveThreadHelper(char* storage) {
 
 
 int HandleScopeImplementer::ArchiveSpacePerThread() {
-  return sizeof(thread_local);
+  return sizeof(HandleScopeImplementer);
 }
 
 
 char* HandleScopeImplementer::RestoreThread(char* storage) {
-  return thread_local.RestoreThreadHelper(storage);
+  return instance()->RestoreThreadHelper(storage);
 }
 
 
@@ -4709,8 +4923,9 @@ void HandleScopeImplementer::IterateThis(ObjectVisitor* v) {
 void HandleScopeImplementer::Iterate(ObjectVisitor* v) {
   v8::ImplementationUtilities::HandleScopeData* current =
       v8::ImplementationUtilities::CurrentHandleScope();
-  thread_local.handle_scope_data_ = *current;
-  thread_local.IterateThis(v);
+  HandleScopeImplementer* thread_local = instance();
+  thread_local->handle_scope_data_ = *current;
+  thread_local->IterateThis(v);
 }
 
 
@@ -144,11 +144,6 @@ v8::Arguments::Arguments(v8::Local<v8::Value> data,
       values_(values), length_(length) { }
 
 
-enum ExtensionTraversalState {
-  UNVISITED, VISITED, INSTALLED
-};
-
-
 class RegisteredExtension {
  public:
   explicit RegisteredExtension(Extension* extension);
@@ -156,14 +151,11 @@ class RegisteredExtension {
   Extension* extension() { return extension_; }
   RegisteredExtension* next() { return next_; }
   RegisteredExtension* next_auto() { return next_auto_; }
-  ExtensionTraversalState state() { return state_; }
-  void set_state(ExtensionTraversalState value) { state_ = value; }
   static RegisteredExtension* first_extension() { return first_extension_; }
  private:
   Extension* extension_;
   RegisteredExtension* next_;
   RegisteredExtension* next_auto_;
-  ExtensionTraversalState state_;
   static RegisteredExtension* first_extension_;
   static RegisteredExtension* first_auto_extension_;
 };
@@ -323,6 +315,19 @@ MAKE_OPEN_HANDLE(StackFrame, JSObject)
 
 namespace internal {
 
+// The state of the API functions that is not copied in and out for each
+// thread, unlike the handle scope implementer below.
+class ApiState : public AllStatic {
+ public:
+  class Data;
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kApiStateData));
+  }
+};
+
+
 // This class is here in order to be able to declare it a friend of
 // HandleScope.  Moving these methods to be members of HandleScope would be
 // neat in some ways, but it would expose external implementation details in
@@ -419,10 +424,26 @@ class HandleScopeImplementer {
   char* RestoreThreadHelper(char* from);
   char* ArchiveThreadHelper(char* to);
 
+  class Data;
+
+  static Data* data() {
+    return static_cast<Data*>(Isolate::Current()->component_data(
+        Isolate::kHandleScopeImplementerData));
+  }
+
+  friend class Isolate;
+
   DISALLOW_COPY_AND_ASSIGN(HandleScopeImplementer);
 };
 
 
+// The handle scope implementer of an isolate.
+class HandleScopeImplementer::Data {
+ public:
+  HandleScopeImplementer instance_;
+};
+
+
 static const int kHandleBlockSize = v8::internal::KB - 2;  // fit in one page
 
 
@@ -45,9 +45,7 @@ namespace v8 {
 namespace internal {
 
 // Safe default is no features.
-unsigned CpuFeatures::supported_ = 0;
-unsigned CpuFeatures::enabled_ = 0;
-unsigned CpuFeatures::found_by_runtime_probing_ = 0;
+DEFINE_ISOLATE_COMPONENT(CpuFeatures)
 
 
 #ifdef __arm__
@@ -71,32 +69,33 @@ static uint64_t CpuFeaturesImpliedByCompiler() {
 
 
 void CpuFeatures::Probe() {
+  Data* data = CpuFeatures::data();
 #ifndef __arm__
   // For the simulator=arm build, use VFP when FLAG_enable_vfp3 is enabled.
   if (FLAG_enable_vfp3) {
-    supported_ |= 1u << VFP3;
+    data->supported_ |= 1u << VFP3;
   }
   // For the simulator=arm build, use ARMv7 when FLAG_enable_armv7 is enabled
   if (FLAG_enable_armv7) {
-    supported_ |= 1u << ARMv7;
+    data->supported_ |= 1u << ARMv7;
   }
 #else  // def __arm__
   if (Serializer::enabled()) {
-    supported_ |= OS::CpuFeaturesImpliedByPlatform();
-    supported_ |= CpuFeaturesImpliedByCompiler();
+    data->supported_ |= OS::CpuFeaturesImpliedByPlatform();
+    data->supported_ |= CpuFeaturesImpliedByCompiler();
     return;  // No features if we might serialize.
   }
 
   if (OS::ArmCpuHasFeature(VFP3)) {
     // This implementation also sets the VFP flags if
     // runtime detection of VFP returns true.
-    supported_ |= 1u << VFP3;
-    found_by_runtime_probing_ |= 1u << VFP3;
+    data->supported_ |= 1u << VFP3;
+    data->found_by_runtime_probing_ |= 1u << VFP3;
   }
 
   if (OS::ArmCpuHasFeature(ARMv7)) {
-    supported_ |= 1u << ARMv7;
-    found_by_runtime_probing_ |= 1u << ARMv7;
+    data->supported_ |= 1u << ARMv7;
+    data->found_by_runtime_probing_ |= 1u << ARMv7;
   }
 #endif
 }
@@ -310,7 +309,7 @@ static const Instr kLdrStrOffsetMask = 0x00000fff;
 
 // Spare buffer.
 static const int kMinimalBufferSize = 4*KB;
-static byte* spare_buffer_ = NULL;
+DEFINE_ISOLATE_COMPONENT(Assembler)
 
 Assembler::Assembler(void* buffer, int buffer_size) {
   if (buffer == NULL) {
@@ -318,9 +317,10 @@ Assembler::Assembler(void* buffer, int buffer_size) {
     if (buffer_size <= kMinimalBufferSize) {
       buffer_size = kMinimalBufferSize;
 
-      if (spare_buffer_ != NULL) {
-        buffer = spare_buffer_;
-        spare_buffer_ = NULL;
+      Data* data = Assembler::data();
+      if (data->spare_buffer_ != NULL) {
+        buffer = data->spare_buffer_;
+        data->spare_buffer_ = NULL;
       }
     }
     if (buffer == NULL) {
@@ -359,8 +359,9 @@ Assembler::Assembler(void* buffer, int buffer_size) {
 Assembler::~Assembler() {
   ASSERT(const_pool_blocked_nesting_ == 0);
   if (own_buffer_) {
-    if (spare_buffer_ == NULL && buffer_size_ == kMinimalBufferSize) {
-      spare_buffer_ = buffer_;
+    Data* data = Assembler::data();
+    if (data->spare_buffer_ == NULL && buffer_size_ == kMinimalBufferSize) {
+      data->spare_buffer_ = buffer_;
     } else {
       DeleteArray(buffer_);
     }
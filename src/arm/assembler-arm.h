@@ -497,12 +497,18 @@ class CpuFeatures : public AllStatic {
   // Check whether a feature is supported by the target CPU.
   static bool IsSupported(CpuFeature f) {
     if (f == VFP3 && !FLAG_enable_vfp3) return false;
-    return (supported_ & (1u << f)) != 0;
+    Data* data = CpuFeatures::data();
+    // Code that may be serialized can't rely on features of this CPU.
+    if (Serializer::enabled() &&
+        (data->found_by_runtime_probing_ & (1u << f)) != 0) {
+      return false;
+    }
+    return (data->supported_ & (1u << f)) != 0;
   }
 
   // Check whether a feature is currently enabled.
   static bool IsEnabled(CpuFeature f) {
-    return (enabled_ & (1u << f)) != 0;
+    return (data()->enabled_ & (1u << f)) != 0;
   }
 
   // Enable a specified feature within a scope.
@@ -510,13 +516,14 @@ class CpuFeatures : public AllStatic {
 #ifdef DEBUG
    public:
     explicit Scope(CpuFeature f) {
+      Data* data = CpuFeatures::data();
       ASSERT(CpuFeatures::IsSupported(f));
       ASSERT(!Serializer::enabled() ||
-             (found_by_runtime_probing_ & (1u << f)) == 0);
-      old_enabled_ = CpuFeatures::enabled_;
-      CpuFeatures::enabled_ |= 1u << f;
+             (data->found_by_runtime_probing_ & (1u << f)) == 0);
+      old_enabled_ = data->enabled_;
+      data->enabled_ |= 1u << f;
     }
-    ~Scope() { CpuFeatures::enabled_ = old_enabled_; }
+    ~Scope() { CpuFeatures::data()->enabled_ = old_enabled_; }
    private:
     unsigned old_enabled_;
 #else
@@ -526,9 +533,19 @@ class CpuFeatures : public AllStatic {
   };
 
  private:
-  static unsigned supported_;
-  static unsigned enabled_;
-  static unsigned found_by_runtime_probing_;
+  class Data {
+   public:
+    unsigned supported_;
+    unsigned enabled_;
+    unsigned found_by_runtime_probing_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kCpuFeaturesData));
+  }
+
+  friend class Isolate;
 };
 
 
@@ -1101,6 +1118,20 @@ class Assembler : public Malloced {
   // True if the assembler owns the buffer, false if buffer is external.
   bool own_buffer_;
 
+  class Data {
+   public:
+    ~Data() { DeleteArray(spare_buffer_); }
+    // A previously allocated buffer of kMinimalBufferSize bytes, or NULL.
+    byte* spare_buffer_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kAssemblerData));
+  }
+
+  friend class Isolate;
+
   // Buffer size and constant pool distance are checked together at regular
   // intervals of kBufferCheckInterval emitted bytes
   static const int kBufferCheckInterval = 1*KB/2;
@@ -8324,7 +8324,8 @@ void TranscendentalCacheStub::Generate(MacroAssembler* masm) {
     __ mov(r0,
            Operand(ExternalReference::transcendental_cache_array_address()));
     // r0 points to cache array.
-    __ ldr(r0, MemOperand(r0, type_ * sizeof(TranscendentalCache::caches_[0])));
+    __ ldr(r0, MemOperand(r0, type_ *
+                          sizeof(TranscendentalCache::data()->caches_[0])));
     // r0 points to the cache for the type type_.
     // If NULL, the cache hasn't been initialized yet, so go through runtime.
     __ cmp(r0, Operand(0));
@@ -9247,6 +9248,21 @@ void RegExpExecStub::Generate(MacroAssembler* masm) {
   __ cmp(r3, Operand(r0));
   __ b(ls, &runtime);
 
+  // r0: Previous index as a smi
+  // r3: Length of subject string as a smi
+  // regexp_data: RegExp data (FixedArray)
+  // Leave long subjects to the runtime if the regexp has a literal prefix,
+  // as searching for the prefix first is faster than trying each position.
+  Label no_prefix_scan;
+  __ sub(r0, r3, Operand(r0));
+  __ cmp(r0, Operand(Smi::FromInt(RegExpImpl::kPrefixScanMinLength)));
+  __ b(lt, &no_prefix_scan);
+  __ ldr(r0, FieldMemOperand(regexp_data, JSRegExp::kIrregexpPrefixOffset));
+  __ LoadRoot(ip, Heap::kUndefinedValueRootIndex);
+  __ cmp(r0, ip);
+  __ b(ne, &runtime);
+  __ bind(&no_prefix_scan);
+
   // r2: Number of capture registers
   // subject: Subject string
   // regexp_data: RegExp data (FixedArray)
@@ -9396,7 +9412,8 @@ void RegExpExecStub::Generate(MacroAssembler* masm) {
   __ cmp(r0, Operand(NativeRegExpMacroAssembler::FAILURE));
   __ b(eq, &failure);
   __ cmp(r0, Operand(NativeRegExpMacroAssembler::EXCEPTION));
-  // If not exception it can only be retry. Handle that in the runtime system.
+  // If not exception it can only be retry or an exceeded backtrack limit.
+  // Handle that in the runtime system.
   __ b(ne, &runtime);
   // Result must now be exception. If there is no pending exception already a
   // stack overflow (on the backtrack stack) was detected in RegExp code but
@@ -9628,7 +9645,12 @@ void StringCharCodeAtGenerator::GenerateFast(MacroAssembler* masm) {
   __ b(eq, &flat_string);
 
   // Handle non-flat strings.
-  __ tst(result_, Operand(kIsConsStringMask));
+  Label sliced_string;
+  __ and_(result_, result_, Operand(kStringRepresentationMask));
+  ASSERT(kConsStringTag < kExternalStringTag);
+  ASSERT(kSlicedStringTag > kExternalStringTag);
+  __ cmp(result_, Operand(kExternalStringTag));
+  __ b(gt, &sliced_string);
   __ b(eq, &call_runtime_);
 
   // ConsString.
@@ -9648,6 +9670,23 @@ void StringCharCodeAtGenerator::GenerateFast(MacroAssembler* masm) {
   ASSERT(kSeqStringTag == 0);
   __ tst(result_, Operand(kStringRepresentationMask));
   __ b(nz, &call_runtime_);
+  __ jmp(&flat_string);
+
+  // SlicedString.
+  // The parent of a sliced string is either sequential or external. Only
+  // handle a sequential parent here and read the character from it at the
+  // index adjusted by the offset of the slice.
+  __ bind(&sliced_string);
+  __ ldr(result_, FieldMemOperand(object_, SlicedString::kParentOffset));
+  __ ldr(result_, FieldMemOperand(result_, HeapObject::kMapOffset));
+  __ ldrb(result_, FieldMemOperand(result_, Map::kInstanceTypeOffset));
+  ASSERT(kSeqStringTag == 0);
+  __ tst(result_, Operand(kStringRepresentationMask));
+  __ b(nz, &call_runtime_);
+  // Both the index and the offset are smis.
+  __ ldr(ip, FieldMemOperand(object_, SlicedString::kOffsetOffset));
+  __ add(scratch_, scratch_, Operand(ip));
+  __ ldr(object_, FieldMemOperand(object_, SlicedString::kParentOffset));
 
   // Check for 1-byte or 2-byte string.
   __ bind(&flat_string);
@@ -10195,8 +10234,9 @@ void SubStringStub::Generate(MacroAssembler* masm) {
   __ and_(r4, r1, Operand(kStringRepresentationMask));
   ASSERT(kSeqStringTag < kConsStringTag);
   ASSERT(kExternalStringTag > kConsStringTag);
+  ASSERT(kSlicedStringTag > kConsStringTag);
   __ cmp(r4, Operand(kConsStringTag));
-  __ b(gt, &runtime);  // External strings go to runtime.
+  __ b(gt, &runtime);  // External and sliced strings go to runtime.
   __ b(lt, &seq_string);  // Sequential strings are handled directly.
 
   // Cons string. Try to recurse (once) on the first substring.
@@ -10222,6 +10262,31 @@ void SubStringStub::Generate(MacroAssembler* masm) {
   __ cmp(r4, Operand(r7));
   __ b(lt, &runtime);  // Fail if to > length.
 
+  // Long sub strings share the characters of the string instead of copying
+  // them.
+  Label copy_string;
+  __ cmp(r2, Operand(SlicedString::kMinLength));
+  __ b(lt, &copy_string);
+  Label two_byte_slice, set_slice_fields;
+  __ tst(r1, Operand(kStringEncodingMask));
+  ASSERT_EQ(0, kTwoByteStringTag);
+  __ b(eq, &two_byte_slice);
+  __ AllocateAsciiSlicedString(r0, r2, r3, r4, &runtime);
+  __ jmp(&set_slice_fields);
+  __ bind(&two_byte_slice);
+  __ AllocateTwoByteSlicedString(r0, r2, r3, r4, &runtime);
+  __ bind(&set_slice_fields);
+  // r0: result string.
+  // r5: sequential parent string.
+  // r6: from offset (smi)
+  __ str(r5, FieldMemOperand(r0, SlicedString::kParentOffset));
+  __ str(r6, FieldMemOperand(r0, SlicedString::kOffsetOffset));
+  __ IncrementCounter(&Counters::sub_string_native, 1, r3, r4);
+  __ add(sp, sp, Operand(3 * kPointerSize));
+  __ Ret();
+
+  __ bind(&copy_string);
+
   // r1: instance type.
   // r2: result string length.
   // r3: from index (untaged smi)
@@ -79,6 +79,8 @@ namespace internal {
  *         position -1). Used to initialize capture registers to a non-position.
  *       - At start (if 1, we are starting at the start of the
  *         string, otherwise 0)
+ *       - Number of backtracks so far (only used when backtracking is
+ *         limited, see --regexp-backtrack-limit).
  *       - register 0         (Only positions must be stored in the first
  *       - register 1          num_saved_registers_ registers)
  *       - ...
@@ -164,6 +166,14 @@ void RegExpMacroAssemblerARM::AdvanceRegister(int reg, int by) {
 
 void RegExpMacroAssemblerARM::Backtrack() {
   CheckPreemption();
+  int limit = backtrack_limit();
+  if (limit > 0) {
+    __ ldr(r0, MemOperand(frame_pointer(), kBacktrackCount));
+    __ add(r0, r0, Operand(1));
+    __ str(r0, MemOperand(frame_pointer(), kBacktrackCount));
+    __ cmp(r0, Operand(limit));
+    __ b(eq, &backtrack_limit_label_);
+  }
   // Pop Code* offset from backtrack stack, add Code* and jump to location.
   Pop(r0);
   __ add(pc, r0, Operand(code_pointer()));
@@ -614,6 +624,8 @@ Handle<Object> RegExpMacroAssemblerARM::GetCode(Handle<String> source) {
   __ add(frame_pointer(), sp, Operand(4 * kPointerSize));
   __ push(r0);  // Make room for "position - 1" constant (value is irrelevant).
   __ push(r0);  // Make room for "at start" constant (value is irrelevant).
+  __ mov(r0, Operand(0));
+  __ push(r0);  // Backtrack count.
   // Check if we have space on the stack for registers.
   Label stack_limit_hit;
   Label stack_ok;
@@ -748,6 +760,13 @@ Handle<Object> RegExpMacroAssemblerARM::GetCode(Handle<String> source) {
 
   Label exit_with_exception;
 
+  // Exit after too many backtracks.
+  if (backtrack_limit_label_.is_linked()) {
+    __ bind(&backtrack_limit_label_);
+    __ mov(r0, Operand(BACKTRACK_LIMIT));
+    __ jmp(&exit_label_);
+  }
+
   // Preempt-code
   if (check_preempt_label_.is_linked()) {
     SafeCallTarget(&check_preempt_label_);
@@ -1042,10 +1061,11 @@ int RegExpMacroAssemblerARM::CheckStackGuardState(Address* return_address,
   }
 
   // Otherwise, the content of the string might have moved. It must still
-  // be a sequential or external string with the same content.
+  // be a sequential, sliced or external string with the same content.
   // Update the start and end pointers in the stack frame to the current
   // location (whether it has actually moved or not).
   ASSERT(StringShape(*subject).IsSequential() ||
+      StringShape(*subject).IsSliced() ||
       StringShape(*subject).IsExternal());
 
   // The original start address of the characters to match.
@@ -136,8 +136,10 @@ class RegExpMacroAssemblerARM: public NativeRegExpMacroAssembler {
   // the frame in GetCode.
   static const int kInputStartMinusOne = kInputString - kPointerSize;
   static const int kAtStart = kInputStartMinusOne - kPointerSize;
+  // Number of backtracks done so far, if backtracking is limited.
+  static const int kBacktrackCount = kAtStart - kPointerSize;
   // First register address. Following registers are below it on the stack.
-  static const int kRegisterZero = kAtStart - kPointerSize;
+  static const int kRegisterZero = kBacktrackCount - kPointerSize;
 
   // Initial size of code buffer.
   static const size_t kRegExpCodeSize = 1024;
@@ -240,6 +242,7 @@ class RegExpMacroAssemblerARM: public NativeRegExpMacroAssembler {
   Label exit_label_;
   Label check_preempt_label_;
   Label stack_overflow_label_;
+  Label backtrack_limit_label_;
 };
 
 
@@ -2051,6 +2051,11 @@ Object* ConstructStubCompiler::CompileConstructStub(
   __ Check(ne, "Function constructed by construct stub.");
 #endif
 
+  // Pretenured objects are allocated in old space by the generic stub.
+  __ ldrb(r3, FieldMemOperand(r2, Map::kBitField2Offset));
+  __ tst(r3, Operand(1 << Map::kIsPretenured));
+  __ b(ne, &generic_stub_call);
+
   // Now allocate the JSObject in new space.
   // r0: argc
   // r1: constructor function
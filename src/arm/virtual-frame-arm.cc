@@ -414,7 +414,7 @@ const VirtualFrame::TopOfStack VirtualFrame::kStateAfterPush[TOS_STATES] =
     { R0_TOS, R1_R0_TOS, R0_R1_TOS, R0_R1_TOS, R1_R0_TOS };
 
 
-bool VirtualFrame::SpilledScope::is_spilled_ = false;
+DEFINE_ISOLATE_COMPONENT(VirtualFrame)
 
 
 void VirtualFrame::Drop(int count) {
@@ -55,23 +55,24 @@ class VirtualFrame : public ZoneObject {
   class SpilledScope BASE_EMBEDDED {
    public:
     explicit SpilledScope(VirtualFrame* frame)
-      : old_is_spilled_(is_spilled_) {
+      : old_is_spilled_(is_spilled()) {
       if (frame != NULL) {
-        if (!is_spilled_) {
+        if (!old_is_spilled_) {
           frame->SpillAll();
         } else {
           frame->AssertIsSpilled();
         }
       }
-      is_spilled_ = true;
+      set_is_spilled(true);
     }
     ~SpilledScope() {
-      is_spilled_ = old_is_spilled_;
+      set_is_spilled(old_is_spilled_);
     }
-    static bool is_spilled() { return is_spilled_; }
+    static bool is_spilled() { return data()->is_spilled_; }
 
    private:
-    static bool is_spilled_;
+    static void set_is_spilled(bool value) { data()->is_spilled_ = value; }
+
     int old_is_spilled_;
 
     SpilledScope() { }
@@ -501,7 +502,19 @@ class VirtualFrame : public ZoneObject {
     }
   }
 
+  class Data {
+   public:
+    // Whether the code generator is inside a SpilledScope.
+    bool is_spilled_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kVirtualFrameData));
+  }
+
   friend class JumpTarget;
+  friend class Isolate;
 };
 
 
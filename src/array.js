@@ -110,6 +110,12 @@ function Join(array, length, separator, convert) {
 
   // Attempt to convert the elements.
   try {
+    // Dense arrays of strings are joined without copying the elements.
+    if (is_array) {
+      var result = %StringBuilderJoin(array, length, separator);
+      if (!IS_UNDEFINED(result)) return result;
+    }
+
     if (UseSparseVariant(array, length, is_array) && (separator.length == 0)) {
       return SparseJoin(array, length, convert);
     }
@@ -124,12 +130,11 @@ function Join(array, length, separator, convert) {
     }
 
     // Construct an array for the elements.
-    var elements;
-    var elements_length = 0;
+    var elements = new $Array(length);
 
     // We pull the empty separator check outside the loop for speed!
     if (separator.length == 0) {
-      elements = new $Array(length);
+      var elements_length = 0;
       for (var i = 0; i < length; i++) {
         var e = array[i];
         if (!IS_UNDEFINED(e) || (i in array)) {
@@ -137,18 +142,31 @@ function Join(array, length, separator, convert) {
           elements[elements_length++] = e;
         }
       }
-    } else {
-      elements = new $Array(length << 1);
-      for (var i = 0; i < length; i++) {
-        var e = array[i];
-        if (i != 0) elements[elements_length++] = separator;
-        if (!IS_UNDEFINED(e) || (i in array)) {
-          if (!IS_STRING(e)) e = convert(e);
-          elements[elements_length++] = e;
-        }
+      return %StringBuilderConcat(elements, elements_length, '');
+    }
+
+    // The separators are added when the elements are joined.
+    for (var i = 0; i < length; i++) {
+      var e = array[i];
+      if (!IS_UNDEFINED(e) || (i in array)) {
+        if (!IS_STRING(e)) e = convert(e);
+      } else {
+        e = '';
       }
+      elements[i] = e;
+    }
+    var result = %StringBuilderJoin(elements, length, separator);
+    if (!IS_UNDEFINED(result)) return result;
+
+    // The elements array is not in fast mode, so interleave the separators
+    // and concatenate the parts instead.
+    var parts = new $Array(length << 1);
+    var parts_length = 0;
+    for (var i = 0; i < length; i++) {
+      if (i != 0) parts[parts_length++] = separator;
+      parts[parts_length++] = elements[i];
     }
-    return %StringBuilderConcat(elements, elements_length, '');
+    return %StringBuilderConcat(parts, parts_length, '');
   } finally {
     // Make sure to pop the visited array no matter what happens.
     if (is_array) visited_arrays.pop();
@@ -34,6 +34,7 @@
 #include "debug.h"
 #include "execution.h"
 #include "global-handles.h"
+#include "hashmap.h"
 #include "macro-assembler.h"
 #include "natives.h"
 #include "snapshot.h"
@@ -59,6 +60,8 @@ class SourceCodeCache BASE_EMBEDDED {
     v->VisitPointer(BitCast<Object**, FixedArray**>(&cache_));
   }
 
+  bool is_empty() { return cache_ == NULL || cache_->length() == 0; }
+
 
   bool Lookup(Vector<const char> name, Handle<SharedFunctionInfo>* handle) {
     for (int i = 0; i < cache_->length(); i+=2) {
@@ -92,21 +95,30 @@ class SourceCodeCache BASE_EMBEDDED {
   DISALLOW_COPY_AND_ASSIGN(SourceCodeCache);
 };
 
-static SourceCodeCache extensions_cache(Script::TYPE_EXTENSION);
-// This is for delete, not delete[].
-static List<char*>* delete_these_non_arrays_on_tear_down = NULL;
-// This is for delete[]
-static List<char*>* delete_these_arrays_on_tear_down = NULL;
+class Bootstrapper::Data {
+ public:
+  Data() : extensions_cache_(Script::TYPE_EXTENSION) { }
+
+  SourceCodeCache extensions_cache_;
+  // This is for delete, not delete[].
+  List<char*>* delete_these_non_arrays_on_tear_down_;
+  // This is for delete[]
+  List<char*>* delete_these_arrays_on_tear_down_;
+};
+
+
+DEFINE_ISOLATE_COMPONENT(Bootstrapper)
 
 
 NativesExternalStringResource::NativesExternalStringResource(const char* source)
     : data_(source), length_(StrLength(source)) {
-  if (delete_these_non_arrays_on_tear_down == NULL) {
-    delete_these_non_arrays_on_tear_down = new List<char*>(2);
+  Bootstrapper::Data* data = Bootstrapper::data();
+  if (data->delete_these_non_arrays_on_tear_down_ == NULL) {
+    data->delete_these_non_arrays_on_tear_down_ = new List<char*>(2);
   }
   // The resources are small objects and we only make a fixed number of
   // them, but let's clean them up on exit for neatness.
-  delete_these_non_arrays_on_tear_down->
+  data->delete_these_non_arrays_on_tear_down_->
       Add(reinterpret_cast<char*>(this));
 }
 
@@ -135,49 +147,89 @@ Handle<String> Bootstrapper::NativesSourceLookup(int index) {
 
 
 void Bootstrapper::Initialize(bool create_heap_objects) {
-  extensions_cache.Initialize(create_heap_objects);
+  data()->extensions_cache_.Initialize(create_heap_objects);
 }
 
 
 char* Bootstrapper::AllocateAutoDeletedArray(int bytes) {
   char* memory = new char[bytes];
   if (memory != NULL) {
-    if (delete_these_arrays_on_tear_down == NULL) {
-      delete_these_arrays_on_tear_down = new List<char*>(2);
+    Data* data = Bootstrapper::data();
+    if (data->delete_these_arrays_on_tear_down_ == NULL) {
+      data->delete_these_arrays_on_tear_down_ = new List<char*>(2);
     }
-    delete_these_arrays_on_tear_down->Add(memory);
+    data->delete_these_arrays_on_tear_down_->Add(memory);
   }
   return memory;
 }
 
 
 void Bootstrapper::TearDown() {
-  if (delete_these_non_arrays_on_tear_down != NULL) {
-    int len = delete_these_non_arrays_on_tear_down->length();
+  Data* data = Bootstrapper::data();
+  List<char*>* non_arrays = data->delete_these_non_arrays_on_tear_down_;
+  if (non_arrays != NULL) {
+    int len = non_arrays->length();
     ASSERT(len < 20);  // Don't use this mechanism for unbounded allocations.
     for (int i = 0; i < len; i++) {
-      delete delete_these_non_arrays_on_tear_down->at(i);
-      delete_these_non_arrays_on_tear_down->at(i) = NULL;
+      delete non_arrays->at(i);
+      non_arrays->at(i) = NULL;
     }
-    delete delete_these_non_arrays_on_tear_down;
-    delete_these_non_arrays_on_tear_down = NULL;
+    delete non_arrays;
+    data->delete_these_non_arrays_on_tear_down_ = NULL;
   }
 
-  if (delete_these_arrays_on_tear_down != NULL) {
-    int len = delete_these_arrays_on_tear_down->length();
+  List<char*>* arrays = data->delete_these_arrays_on_tear_down_;
+  if (arrays != NULL) {
+    int len = arrays->length();
     ASSERT(len < 1000);  // Don't use this mechanism for unbounded allocations.
     for (int i = 0; i < len; i++) {
-      delete[] delete_these_arrays_on_tear_down->at(i);
-      delete_these_arrays_on_tear_down->at(i) = NULL;
+      delete[] arrays->at(i);
+      arrays->at(i) = NULL;
     }
-    delete delete_these_arrays_on_tear_down;
-    delete_these_arrays_on_tear_down = NULL;
+    delete arrays;
+    data->delete_these_arrays_on_tear_down_ = NULL;
   }
 
-  extensions_cache.Initialize(false);  // Yes, symmetrical
+  data->extensions_cache_.Initialize(false);  // Yes, symmetrical
 }
 
 
+enum ExtensionTraversalState {
+  UNVISITED, VISITED, INSTALLED
+};
+
+
+// The state of each registered extension while the extensions are installed
+// in a new context.  Extensions that have not been seen are UNVISITED.
+class ExtensionStates {
+ public:
+  ExtensionStates() : map_(ExtensionsMatch) { }
+
+  ExtensionTraversalState get_state(v8::RegisteredExtension* extension) {
+    HashMap::Entry* entry = map_.Lookup(extension, Hash(extension), false);
+    if (entry == NULL) return UNVISITED;
+    return static_cast<ExtensionTraversalState>(
+        reinterpret_cast<intptr_t>(entry->value));
+  }
+
+  void set_state(v8::RegisteredExtension* extension,
+                 ExtensionTraversalState state) {
+    HashMap::Entry* entry = map_.Lookup(extension, Hash(extension), true);
+    entry->value = reinterpret_cast<void*>(static_cast<intptr_t>(state));
+  }
+
+ private:
+  static uint32_t Hash(v8::RegisteredExtension* extension) {
+    return static_cast<uint32_t>(reinterpret_cast<intptr_t>(extension));
+  }
+  static bool ExtensionsMatch(void* key1, void* key2) { return key1 == key2; }
+
+  HashMap map_;
+
+  DISALLOW_COPY_AND_ASSIGN(ExtensionStates);
+};
+
+
 class Genesis BASE_EMBEDDED {
  public:
   Genesis(Handle<Object> global_object,
@@ -235,8 +287,10 @@ class Genesis BASE_EMBEDDED {
   // provided.
   static bool InstallExtensions(Handle<Context> global_context,
                                 v8::ExtensionConfiguration* extensions);
-  static bool InstallExtension(const char* name);
-  static bool InstallExtension(v8::RegisteredExtension* current);
+  static bool InstallExtension(const char* name,
+                               ExtensionStates* extension_states);
+  static bool InstallExtension(v8::RegisteredExtension* current,
+                               ExtensionStates* extension_states);
   static void InstallSpecialObjects(Handle<Context> global_context);
   bool InstallJSBuiltins(Handle<JSBuiltinsObject> builtins);
   bool ConfigureApiObject(Handle<JSObject> object,
@@ -276,7 +330,7 @@ class Genesis BASE_EMBEDDED {
 
 
 void Bootstrapper::Iterate(ObjectVisitor* v) {
-  extensions_cache.Iterate(v);
+  data()->extensions_cache_.Iterate(v);
   v->Synchronize("Extensions");
 }
 
@@ -1389,7 +1443,7 @@ void Genesis::InstallJSFunctionResultCaches() {
 }
 
 
-int BootstrapperActive::nesting_ = 0;
+DEFINE_ISOLATE_COMPONENT(BootstrapperActive)
 
 
 bool Bootstrapper::InstallExtensions(Handle<Context> global_context,
@@ -1403,6 +1457,12 @@ bool Bootstrapper::InstallExtensions(Handle<Context> global_context,
 }
 
 
+bool Bootstrapper::HasInstalledExtensions() {
+  // Extensions are compiled through the cache when they are installed.
+  return !data()->extensions_cache_.is_empty();
+}
+
+
 void Genesis::InstallSpecialObjects(Handle<Context> global_context) {
   HandleScope scope;
   Handle<JSGlobalObject> js_global(
@@ -1447,28 +1507,25 @@ void Genesis::InstallSpecialObjects(Handle<Context> global_context) {
 
 bool Genesis::InstallExtensions(Handle<Context> global_context,
                                 v8::ExtensionConfiguration* extensions) {
-  // Clear coloring of extension list
-  v8::RegisteredExtension* current = v8::RegisteredExtension::first_extension();
-  while (current != NULL) {
-    current->set_state(v8::UNVISITED);
-    current = current->next();
-  }
+  // The coloring of the extension list is local to this installation, since
+  // the extensions are shared by all isolates.
+  ExtensionStates extension_states;
   // Install auto extensions.
-  current = v8::RegisteredExtension::first_extension();
+  v8::RegisteredExtension* current = v8::RegisteredExtension::first_extension();
   while (current != NULL) {
     if (current->extension()->auto_enable())
-      InstallExtension(current);
+      InstallExtension(current, &extension_states);
     current = current->next();
   }
 
-  if (FLAG_expose_gc) InstallExtension("v8/gc");
+  if (FLAG_expose_gc) InstallExtension("v8/gc", &extension_states);
 
   if (extensions == NULL) return true;
   // Install required extensions
   int count = v8::ImplementationUtilities::GetNameCount(extensions);
   const char** names = v8::ImplementationUtilities::GetNames(extensions);
   for (int i = 0; i < count; i++) {
-    if (!InstallExtension(names[i]))
+    if (!InstallExtension(names[i], &extension_states))
       return false;
   }
 
@@ -1478,7 +1535,8 @@ bool Genesis::InstallExtensions(Handle<Context> global_context,
 
 // Installs a named extension.  This methods is unoptimized and does
 // not scale well if we want to support a large number of extensions.
-bool Genesis::InstallExtension(const char* name) {
+bool Genesis::InstallExtension(const char* name,
+                               ExtensionStates* extension_states) {
   v8::RegisteredExtension* current = v8::RegisteredExtension::first_extension();
   // Loop until we find the relevant extension
   while (current != NULL) {
@@ -1491,33 +1549,36 @@ bool Genesis::InstallExtension(const char* name) {
         "v8::Context::New()", "Cannot find required extension");
     return false;
   }
-  return InstallExtension(current);
+  return InstallExtension(current, extension_states);
 }
 
 
-bool Genesis::InstallExtension(v8::RegisteredExtension* current) {
+bool Genesis::InstallExtension(v8::RegisteredExtension* current,
+                               ExtensionStates* extension_states) {
   HandleScope scope;
 
-  if (current->state() == v8::INSTALLED) return true;
+  if (extension_states->get_state(current) == INSTALLED) return true;
   // The current node has already been visited so there must be a
   // cycle in the dependency graph; fail.
-  if (current->state() == v8::VISITED) {
+  if (extension_states->get_state(current) == VISITED) {
     v8::Utils::ReportApiFailure(
         "v8::Context::New()", "Circular extension dependency");
     return false;
   }
-  ASSERT(current->state() == v8::UNVISITED);
-  current->set_state(v8::VISITED);
+  ASSERT(extension_states->get_state(current) == UNVISITED);
+  extension_states->set_state(current, VISITED);
   v8::Extension* extension = current->extension();
   // Install the extension's dependencies
   for (int i = 0; i < extension->dependency_count(); i++) {
-    if (!InstallExtension(extension->dependencies()[i])) return false;
+    if (!InstallExtension(extension->dependencies()[i], extension_states)) {
+      return false;
+    }
   }
   Vector<const char> source = CStrVector(extension->source());
   Handle<String> source_code = Factory::NewStringFromAscii(source);
   bool result = CompileScriptCached(CStrVector(extension->name()),
                                     source_code,
-                                    &extensions_cache,
+                                    &Bootstrapper::data()->extensions_cache_,
                                     extension,
                                     Handle<Context>(Top::context()),
                                     false);
@@ -1525,7 +1586,7 @@ bool Genesis::InstallExtension(v8::RegisteredExtension* current) {
   if (!result) {
     Top::clear_pending_exception();
   }
-  current->set_state(v8::INSTALLED);
+  extension_states->set_state(current, INSTALLED);
   return result;
 }
 
@@ -1794,22 +1855,22 @@ void Bootstrapper::FreeThreadResources() {
 
 // Reserve space for statics needing saving and restoring.
 int BootstrapperActive::ArchiveSpacePerThread() {
-  return sizeof(nesting_);
+  return sizeof(int);
 }
 
 
 // Archive statics that are thread local.
 char* BootstrapperActive::ArchiveState(char* to) {
-  *reinterpret_cast<int*>(to) = nesting_;
-  nesting_ = 0;
-  return to + sizeof(nesting_);
+  *reinterpret_cast<int*>(to) = data()->nesting_;
+  data()->nesting_ = 0;
+  return to + sizeof(int);
 }
 
 
 // Restore statics that are thread local.
 char* BootstrapperActive::RestoreState(char* from) {
-  nesting_ = *reinterpret_cast<int*>(from);
-  return from + sizeof(nesting_);
+  data()->nesting_ = *reinterpret_cast<int*>(from);
+  return from + sizeof(int);
 }
 
 } }  // namespace v8::internal
@@ -35,8 +35,8 @@ namespace internal {
 
 class BootstrapperActive BASE_EMBEDDED {
  public:
-  BootstrapperActive() { nesting_++; }
-  ~BootstrapperActive() { nesting_--; }
+  BootstrapperActive() { data()->nesting_++; }
+  ~BootstrapperActive() { data()->nesting_--; }
 
   // Support for thread preemption.
   static int ArchiveSpacePerThread();
@@ -44,9 +44,19 @@ class BootstrapperActive BASE_EMBEDDED {
   static char* RestoreState(char* from);
 
  private:
-  static bool IsActive() { return nesting_ != 0; }
-  static int nesting_;
+  class Data {
+   public:
+    int nesting_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kBootstrapperActiveData));
+  }
+
+  static bool IsActive() { return data()->nesting_ != 0; }
   friend class Bootstrapper;
+  friend class Isolate;
 };
 
 
@@ -93,6 +103,23 @@ class Bootstrapper : public AllStatic {
   // Used for new context creation.
   static bool InstallExtensions(Handle<Context> global_context,
                                 v8::ExtensionConfiguration* extensions);
+
+  // Tells whether an extension has been installed in a context since the
+  // bootstrapper was initialized.
+  static bool HasInstalledExtensions();
+
+ private:
+  // Defined in bootstrapper.cc, next to the caches it holds.
+  class Data;
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kBootstrapperData));
+  }
+
+  friend class Genesis;
+  friend class Isolate;
+  friend class NativesExternalStringResource;
 };
 
 
@@ -1376,8 +1376,7 @@ static void Generate_FrameDropper_LiveEdit(MacroAssembler* masm) {
 }
 #endif
 
-Object* Builtins::builtins_[builtin_count] = { NULL, };
-const char* Builtins::names_[builtin_count] = { NULL, };
+DEFINE_ISOLATE_COMPONENT(Builtins)
 
 #define DEF_ENUM_C(name, ignore) FUNCTION_ADDR(Builtin_##name),
   Address Builtins::c_functions_[cfunction_count] = {
@@ -1397,9 +1396,9 @@ int Builtins::javascript_argc_[id_count] = {
 #undef DEF_JS_NAME
 #undef DEF_JS_ARGC
 
-static bool is_initialized = false;
 void Builtins::Setup(bool create_heap_objects) {
-  ASSERT(!is_initialized);
+  Data* data = Builtins::data();
+  ASSERT(!data->initialized_);
 
   // Create a scope for the handles in the builtins.
   HandleScope scope;
@@ -1477,7 +1476,7 @@ void Builtins::Setup(bool create_heap_objects) {
       // Log the event and add the code to the builtins array.
       PROFILE(CodeCreateEvent(Logger::BUILTIN_TAG,
                               Code::cast(code), functions[i].s_name));
-      builtins_[i] = code;
+      data->builtins_[i] = code;
 #ifdef ENABLE_DISASSEMBLER
       if (FLAG_print_builtin_code) {
         PrintF("Builtin: %s\n", functions[i].s_name);
@@ -1487,32 +1486,35 @@ void Builtins::Setup(bool create_heap_objects) {
 #endif
     } else {
       // Deserializing. The values will be filled in during IterateBuiltins.
-      builtins_[i] = NULL;
+      data->builtins_[i] = NULL;
     }
-    names_[i] = functions[i].s_name;
+    data->names_[i] = functions[i].s_name;
   }
 
   // Mark as initialized.
-  is_initialized = true;
+  data->initialized_ = true;
 }
 
 
 void Builtins::TearDown() {
-  is_initialized = false;
+  data()->initialized_ = false;
 }
 
 
 void Builtins::IterateBuiltins(ObjectVisitor* v) {
-  v->VisitPointers(&builtins_[0], &builtins_[0] + builtin_count);
+  Object** builtins = data()->builtins_;
+  v->VisitPointers(&builtins[0], &builtins[0] + builtin_count);
 }
 
 
 const char* Builtins::Lookup(byte* pc) {
-  if (is_initialized) {  // may be called during initialization (disassembler!)
+  Data* data = Builtins::data();
+  // May be called during initialization (disassembler!).
+  if (data->initialized_) {
     for (int i = 0; i < builtin_count; i++) {
-      Code* entry = Code::cast(builtins_[i]);
+      Code* entry = Code::cast(data->builtins_[i]);
       if (entry->contains(pc)) {
-        return names_[i];
+        return data->names_[i];
       }
     }
   }
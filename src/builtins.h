@@ -212,11 +212,11 @@ class Builtins : public AllStatic {
   static Code* builtin(Name name) {
     // Code::cast cannot be used here since we access builtins
     // during the marking phase of mark sweep. See IC::Clear.
-    return reinterpret_cast<Code*>(builtins_[name]);
+    return reinterpret_cast<Code*>(data()->builtins_[name]);
   }
 
   static Address builtin_address(Name name) {
-    return reinterpret_cast<Address>(&builtins_[name]);
+    return reinterpret_cast<Address>(&data()->builtins_[name]);
   }
 
   static Address c_function_address(CFunctionId id) {
@@ -232,11 +232,21 @@ class Builtins : public AllStatic {
   // The external C++ functions called from the code.
   static Address c_functions_[cfunction_count];
 
-  // Note: These are always Code objects, but to conform with
-  // IterateBuiltins() above which assumes Object**'s for the callback
-  // function f, we use an Object* array here.
-  static Object* builtins_[builtin_count];
-  static const char* names_[builtin_count];
+  class Data {
+   public:
+    // Note: These are always Code objects, but to conform with
+    // IterateBuiltins() above which assumes Object**'s for the callback
+    // function f, we use an Object* array here.
+    Object* builtins_[builtin_count];
+    const char* names_[builtin_count];
+    bool initialized_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kBuiltinsData));
+  }
+
   static const char* javascript_names_[id_count];
   static int javascript_argc_[id_count];
 
@@ -255,6 +265,8 @@ class Builtins : public AllStatic {
 
   static void Generate_ArrayCode(MacroAssembler* masm);
   static void Generate_ArrayConstructCode(MacroAssembler* masm);
+
+  friend class Isolate;
 };
 
 } }  // namespace v8::internal
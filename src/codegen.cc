@@ -62,7 +62,7 @@ Comment::~Comment() {
 #undef __
 
 
-CodeGenerator* CodeGeneratorScope::top_ = NULL;
+DEFINE_ISOLATE_COMPONENT(CodeGeneratorScope)
 
 
 void CodeGenerator::ProcessDeferred() {
@@ -161,22 +161,35 @@ class Comment BASE_EMBEDDED {
 class CodeGeneratorScope BASE_EMBEDDED {
  public:
   explicit CodeGeneratorScope(CodeGenerator* cgen) {
-    previous_ = top_;
-    top_ = cgen;
+    Data* data = CodeGeneratorScope::data();
+    previous_ = data->top_;
+    data->top_ = cgen;
   }
 
   ~CodeGeneratorScope() {
-    top_ = previous_;
+    data()->top_ = previous_;
   }
 
   static CodeGenerator* Current() {
-    ASSERT(top_ != NULL);
-    return top_;
+    CodeGenerator* top = data()->top_;
+    ASSERT(top != NULL);
+    return top;
   }
 
  private:
-  static CodeGenerator* top_;
+  class Data {
+   public:
+    CodeGenerator* top_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kCodeGeneratorScopeData));
+  }
+
   CodeGenerator* previous_;
+
+  friend class Isolate;
 };
 
 
@@ -44,6 +44,9 @@ static const int kEvalGlobalGenerations = 2;
 static const int kEvalContextualGenerations = 2;
 static const int kRegExpGenerations = 2;
 
+// Maximum number of regexps kept in the long-lived regexp table.
+static const int kRegExpLongLivedSize = 256;
+
 // Initial size of each compilation cache table allocated.
 static const int kInitialCacheSize = 64;
 
@@ -152,36 +155,73 @@ class CompilationCacheEval: public CompilationSubCache {
 class CompilationCacheRegExp: public CompilationSubCache {
  public:
   explicit CompilationCacheRegExp(int generations)
-      : CompilationSubCache(generations) { }
+      : CompilationSubCache(generations), long_lived_(NULL) { }
 
   Handle<FixedArray> Lookup(Handle<String> source, JSRegExp::Flags flags);
 
   void Put(Handle<String> source,
            JSRegExp::Flags flags,
            Handle<FixedArray> data);
+
+  // Adds the data to the long-lived table, which is not aged and only
+  // emptied by ClearLongLived. Returns false if the table is full.
+  bool Retain(Handle<String> source,
+              JSRegExp::Flags flags,
+              Handle<FixedArray> data);
+
+  // GC support for the long-lived table.
+  void IterateLongLived(ObjectVisitor* v) { v->VisitPointer(&long_lived_); }
+
+  void ClearLongLived() { long_lived_ = Heap::undefined_value(); }
+
  private:
+  Handle<CompilationCacheTable> GetLongLivedTable();
+
   // Note: Returns a new hash table if operation results in expansion.
-  Handle<CompilationCacheTable> TablePut(Handle<String> source,
+  Handle<CompilationCacheTable> TablePut(Handle<CompilationCacheTable> table,
+                                         Handle<String> source,
                                          JSRegExp::Flags flags,
                                          Handle<FixedArray> data);
 
+  // Table of regexps that have been looked up again while they were still
+  // in the generational tables, or that were compiled into the snapshot.
+  Object* long_lived_;
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(CompilationCacheRegExp);
 };
 
 
-// Statically allocate all the sub-caches.
-static CompilationCacheScript script(kScriptGenerations);
-static CompilationCacheEval eval_global(kEvalGlobalGenerations);
-static CompilationCacheEval eval_contextual(kEvalContextualGenerations);
-static CompilationCacheRegExp reg_exp(kRegExpGenerations);
-static CompilationSubCache* subcaches[kSubCacheCount] =
-    {&script, &eval_global, &eval_contextual, &reg_exp};
+// The sub-caches of an isolate.
+class CompilationCache::Data {
+ public:
+  Data()
+      : script_(kScriptGenerations),
+        eval_global_(kEvalGlobalGenerations),
+        eval_contextual_(kEvalContextualGenerations),
+        reg_exp_(kRegExpGenerations),
+        enabled_(true) {
+    subcaches_[0] = &script_;
+    subcaches_[1] = &eval_global_;
+    subcaches_[2] = &eval_contextual_;
+    subcaches_[3] = &reg_exp_;
+  }
 
+  CompilationCacheScript script_;
+  CompilationCacheEval eval_global_;
+  CompilationCacheEval eval_contextual_;
+  CompilationCacheRegExp reg_exp_;
+  CompilationSubCache* subcaches_[kSubCacheCount];
 
-// Current enable state of the compilation cache.
-static bool enabled = true;
-static inline bool IsEnabled() {
-  return FLAG_compilation_cache && enabled;
+  // Current enable state of the compilation cache.
+  bool enabled_;
+};
+
+
+DEFINE_ISOLATE_COMPONENT(CompilationCache)
+
+
+bool CompilationCache::IsEnabled() {
+  return FLAG_compilation_cache && data()->enabled_;
 }
 
 
@@ -399,6 +439,15 @@ void CompilationCacheEval::Put(Handle<String> source,
 
 Handle<FixedArray> CompilationCacheRegExp::Lookup(Handle<String> source,
                                                   JSRegExp::Flags flags) {
+  if (!long_lived_->IsUndefined()) {
+    Object* result = CompilationCacheTable::cast(long_lived_)->LookupRegExp(
+        *source, flags);
+    if (result->IsFixedArray()) {
+      Counters::compilation_cache_hits.Increment();
+      return Handle<FixedArray>(FixedArray::cast(result));
+    }
+  }
+
   // Make sure not to leak the table into the surrounding handle
   // scope. Otherwise, we risk keeping old tables around even after
   // having cleared the cache.
@@ -415,7 +464,10 @@ Handle<FixedArray> CompilationCacheRegExp::Lookup(Handle<String> source,
   }
   if (result->IsFixedArray()) {
     Handle<FixedArray> data(FixedArray::cast(result));
-    if (generation != 0) {
+    // The regexp is used again before it was aged out, so it is likely to
+    // be a literal that is evaluated in many contexts. Keep it around for
+    // longer if there is room.
+    if (!Retain(source, flags, data) && generation != 0) {
       Put(source, flags, data);
     }
     Counters::compilation_cache_hits.Increment();
@@ -428,10 +480,11 @@ Handle<FixedArray> CompilationCacheRegExp::Lookup(Handle<String> source,
 
 
 Handle<CompilationCacheTable> CompilationCacheRegExp::TablePut(
+    Handle<CompilationCacheTable> table,
     Handle<String> source,
     JSRegExp::Flags flags,
     Handle<FixedArray> data) {
-  CALL_HEAP_FUNCTION(GetFirstTable()->PutRegExp(*source, flags, *data),
+  CALL_HEAP_FUNCTION(table->PutRegExp(*source, flags, *data),
                      CompilationCacheTable);
 }
 
@@ -440,7 +493,27 @@ void CompilationCacheRegExp::Put(Handle<String> source,
                                  JSRegExp::Flags flags,
                                  Handle<FixedArray> data) {
   HandleScope scope;
-  SetFirstTable(TablePut(source, flags, data));
+  SetFirstTable(TablePut(GetFirstTable(), source, flags, data));
+}
+
+
+Handle<CompilationCacheTable> CompilationCacheRegExp::GetLongLivedTable() {
+  if (long_lived_->IsUndefined()) {
+    long_lived_ = *AllocateTable(kInitialCacheSize);
+  }
+  return Handle<CompilationCacheTable>(
+      CompilationCacheTable::cast(long_lived_));
+}
+
+
+bool CompilationCacheRegExp::Retain(Handle<String> source,
+                                    JSRegExp::Flags flags,
+                                    Handle<FixedArray> data) {
+  HandleScope scope;
+  Handle<CompilationCacheTable> table = GetLongLivedTable();
+  if (table->NumberOfElements() >= kRegExpLongLivedSize) return false;
+  long_lived_ = *TablePut(table, source, flags, data);
+  return true;
 }
 
 
@@ -452,7 +525,7 @@ Handle<SharedFunctionInfo> CompilationCache::LookupScript(Handle<String> source,
     return Handle<SharedFunctionInfo>::null();
   }
 
-  return script.Lookup(source, name, line_offset, column_offset);
+  return data()->script_.Lookup(source, name, line_offset, column_offset);
 }
 
 
@@ -465,9 +538,9 @@ Handle<SharedFunctionInfo> CompilationCache::LookupEval(Handle<String> source,
 
   Handle<SharedFunctionInfo> result;
   if (is_global) {
-    result = eval_global.Lookup(source, context);
+    result = data()->eval_global_.Lookup(source, context);
   } else {
-    result = eval_contextual.Lookup(source, context);
+    result = data()->eval_contextual_.Lookup(source, context);
   }
   return result;
 }
@@ -479,7 +552,7 @@ Handle<FixedArray> CompilationCache::LookupRegExp(Handle<String> source,
     return Handle<FixedArray>::null();
   }
 
-  return reg_exp.Lookup(source, flags);
+  return data()->reg_exp_.Lookup(source, flags);
 }
 
 
@@ -489,7 +562,7 @@ void CompilationCache::PutScript(Handle<String> source,
     return;
   }
 
-  script.Put(source, function_info);
+  data()->script_.Put(source, function_info);
 }
 
 
@@ -503,9 +576,9 @@ void CompilationCache::PutEval(Handle<String> source,
 
   HandleScope scope;
   if (is_global) {
-    eval_global.Put(source, context, function_info);
+    data()->eval_global_.Put(source, context, function_info);
   } else {
-    eval_contextual.Put(source, context, function_info);
+    data()->eval_contextual_.Put(source, context, function_info);
   }
 }
 
@@ -518,43 +591,64 @@ void CompilationCache::PutRegExp(Handle<String> source,
     return;
   }
 
-  reg_exp.Put(source, flags, data);
+  CompilationCache::data()->reg_exp_.Put(source, flags, data);
+}
+
+
+void CompilationCache::RetainRegExp(Handle<String> source,
+                                    JSRegExp::Flags flags,
+                                    Handle<FixedArray> data) {
+  if (!IsEnabled()) {
+    return;
+  }
+
+  CompilationCache::data()->reg_exp_.Retain(source, flags, data);
 }
 
 
 void CompilationCache::Clear() {
+  ClearGenerations();
+  data()->reg_exp_.ClearLongLived();
+}
+
+
+void CompilationCache::ClearGenerations() {
+  Data* data = CompilationCache::data();
   for (int i = 0; i < kSubCacheCount; i++) {
-    subcaches[i]->Clear();
+    data->subcaches_[i]->Clear();
   }
 }
 
 
 bool CompilationCache::HasFunction(SharedFunctionInfo* function_info) {
-  return script.HasFunction(function_info);
+  return data()->script_.HasFunction(function_info);
 }
 
 
 void CompilationCache::Iterate(ObjectVisitor* v) {
+  Data* data = CompilationCache::data();
   for (int i = 0; i < kSubCacheCount; i++) {
-    subcaches[i]->Iterate(v);
+    data->subcaches_[i]->Iterate(v);
   }
+  data->reg_exp_.IterateLongLived(v);
 }
 
 
 void CompilationCache::MarkCompactPrologue() {
+  Data* data = CompilationCache::data();
   for (int i = 0; i < kSubCacheCount; i++) {
-    subcaches[i]->Age();
+    data->subcaches_[i]->Age();
   }
 }
 
 
 void CompilationCache::Enable() {
-  enabled = true;
+  data()->enabled_ = true;
 }
 
 
 void CompilationCache::Disable() {
-  enabled = false;
+  data()->enabled_ = false;
   Clear();
 }
 
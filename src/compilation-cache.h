@@ -35,7 +35,10 @@ namespace internal {
 // The compilation cache keeps shared function infos for compiled
 // scripts and evals. The shared function infos are looked up using
 // the source string as the key. For regular expressions the
-// compilation data is cached.
+// compilation data is cached. Regular expressions that are looked up
+// again while still cached are moved to a bounded long-lived table that
+// is not aged by garbage collections, so that their compiled code is
+// shared by all contexts and, when built by mksnapshot, the snapshot.
 class CompilationCache {
  public:
   // Finds the script shared function info for a source
@@ -76,9 +79,17 @@ class CompilationCache {
                         JSRegExp::Flags flags,
                         Handle<FixedArray> data);
 
+  // Add the regexp data to the long-lived table if there is room.
+  static void RetainRegExp(Handle<String> source,
+                           JSRegExp::Flags flags,
+                           Handle<FixedArray> data);
+
   // Clear the cache - also used to initialize the cache at startup.
   static void Clear();
 
+  // Clear everything but the long-lived regexp table.
+  static void ClearGenerations();
+
 
   static bool HasFunction(SharedFunctionInfo* function_info);
 
@@ -94,6 +105,19 @@ class CompilationCache {
   // cache during debugging to make sure new scripts are always compiled.
   static void Enable();
   static void Disable();
+
+ private:
+  // Defined in compilation-cache.cc, next to the sub-caches it holds.
+  class Data;
+
+  static inline bool IsEnabled();
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kCompilationCacheData));
+  }
+
+  friend class Isolate;
 };
 
 
@@ -40,6 +40,7 @@
 #include "oprofile-agent.h"
 #include "rewriter.h"
 #include "scopes.h"
+#include "serialize.h"
 
 namespace v8 {
 namespace internal {
@@ -275,7 +276,13 @@ static Handle<SharedFunctionInfo> MakeFunctionInfo(bool is_global,
 }
 
 
-static StaticResource<SafeStringInputBuffer> safe_string_input_buffer;
+class Compiler::Data {
+ public:
+  StaticResource<SafeStringInputBuffer> safe_string_input_buffer_;
+};
+
+
+DEFINE_ISOLATE_COMPONENT(Compiler)
 
 
 Handle<SharedFunctionInfo> Compiler::Compile(Handle<String> source,
@@ -306,7 +313,7 @@ Handle<SharedFunctionInfo> Compiler::Compile(Handle<String> source,
     // No cache entry found. Do pre-parsing and compile the script.
     ScriptDataImpl* pre_data = input_pre_data;
     if (pre_data == NULL && source_length >= FLAG_min_preparse_length) {
-      Access<SafeStringInputBuffer> buf(&safe_string_input_buffer);
+      Access<SafeStringInputBuffer> buf(&data()->safe_string_input_buffer_);
       buf->Reset(source.location());
       pre_data = PreParse(source, buf.value(), extension);
     }
@@ -325,6 +332,13 @@ Handle<SharedFunctionInfo> Compiler::Compile(Handle<String> source,
     script->set_data(script_data.is_null() ? Heap::undefined_value()
                                            : *script_data);
 
+    // Keep the function entries of the preparse data with the script, to
+    // skip the bodies of inner functions when functions are compiled lazily.
+    if (pre_data != NULL && extension == NULL && natives != NATIVES_CODE) {
+      script->set_preparse_data(
+          *pre_data->FunctionEntriesForLazyCompilation());
+    }
+
     // Compile the function and add it to the cache.
     result = MakeFunctionInfo(true,
                               false,
@@ -348,6 +362,85 @@ Handle<SharedFunctionInfo> Compiler::Compile(Handle<String> source,
 }
 
 
+Handle<SharedFunctionInfo> Compiler::CompileWithCodeCache(
+    Handle<String> source,
+    Handle<Object> script_name,
+    int line_offset,
+    int column_offset,
+    Vector<const byte> code_cache) {
+  Handle<SharedFunctionInfo> result =
+      CompilationCache::LookupScript(source,
+                                     script_name,
+                                     line_offset,
+                                     column_offset);
+  if (!result.is_null()) return result;
+
+  {
+    VMState state(COMPILER);
+    Handle<Script> script = Factory::NewScript(source);
+    if (!script_name.is_null()) {
+      script->set_name(*script_name);
+      script->set_line_offset(Smi::FromInt(line_offset));
+      script->set_column_offset(Smi::FromInt(column_offset));
+    }
+    script->set_context_data((*Top::global_context())->data());
+    result = CodeSerializer::Deserialize(code_cache, script);
+    if (!result.is_null()) {
+      Counters::total_load_size.Increment(source->length());
+#ifdef ENABLE_DEBUGGER_SUPPORT
+      Debugger::OnAfterCompile(script, Debugger::NO_AFTER_COMPILE_FLAGS);
+#endif
+      CompilationCache::PutScript(source, result);
+      return result;
+    }
+  }
+
+  return Compile(source,
+                 script_name,
+                 line_offset,
+                 column_offset,
+                 NULL,
+                 NULL,
+                 Handle<Object>::null(),
+                 NOT_NATIVES_CODE);
+}
+
+
+Vector<byte> Compiler::CompileForCodeCache(Handle<String> source,
+                                           Handle<Object> script_name,
+                                           int line_offset,
+                                           int column_offset) {
+  // The VM is in the COMPILER state until exiting this function.
+  VMState state(COMPILER);
+
+  Handle<Script> script = Factory::NewScript(source);
+  if (!script_name.is_null()) {
+    script->set_name(*script_name);
+    script->set_line_offset(Smi::FromInt(line_offset));
+    script->set_column_offset(Smi::FromInt(column_offset));
+  }
+
+  // The script is compiled without looking in the compilation cache, whose
+  // code can't be serialized.
+  Handle<SharedFunctionInfo> result;
+  Vector<byte> code_cache;
+  {
+    CodeSerializer::CodeGenerationScope code_generation_scope;
+    result = MakeFunctionInfo(true,
+                              false,
+                              DONT_VALIDATE_JSON,
+                              script,
+                              Handle<Context>::null(),
+                              NULL,
+                              NULL);
+    if (!result.is_null()) code_cache = CodeSerializer::Serialize(result);
+  }
+
+  if (result.is_null()) Top::ReportPendingMessages();
+  return code_cache;
+}
+
+
 Handle<SharedFunctionInfo> Compiler::CompileEval(Handle<String> source,
                                                  Handle<Context> context,
                                                  bool is_global,
@@ -409,13 +502,23 @@ bool Compiler::CompileLazy(CompilationInfo* info) {
   bool is_expression = shared->is_expression();
   Counters::total_compile_size.Increment(end_position - start_position);
 
+  // The bodies of the inner functions can be skipped if they are compiled
+  // lazily themselves.
+  ScriptDataImpl* pre_data = NULL;
+  if (FLAG_lazy && !LiveEditFunctionTracker::IsActive()) {
+    pre_data = ScriptDataImpl::ForLazyCompilation(info->script(),
+                                                  start_position);
+  }
+
   // Generate the AST for the lazily compiled function. The AST may be
   // NULL in case of parser stack overflow.
   FunctionLiteral* lit = MakeLazyAST(info->script(),
                                      name,
                                      start_position,
                                      end_position,
-                                     is_expression);
+                                     is_expression,
+                                     pre_data);
+  delete pre_data;
 
   // Check for parse errors.
   if (lit == NULL) {
@@ -238,6 +238,25 @@ class Compiler : public AllStatic {
                                             Handle<Object> script_data,
                                             NativesFlag is_natives_code);
 
+  // Compile a String source within a context using the code in a code cache
+  // made by CompileForCodeCache.  If the code cache doesn't fit the source
+  // or this VM the source is compiled like by Compile.
+  static Handle<SharedFunctionInfo> CompileWithCodeCache(
+      Handle<String> source,
+      Handle<Object> script_name,
+      int line_offset,
+      int column_offset,
+      Vector<const byte> code_cache);
+
+  // Compile a String source within a context and serialize the generated
+  // code into a code cache, see CodeSerializer.  Returns an empty vector if
+  // the source could not be compiled or the code can't be cached.  The
+  // caller owns the data.
+  static Vector<byte> CompileForCodeCache(Handle<String> source,
+                                          Handle<Object> script_name,
+                                          int line_offset,
+                                          int column_offset);
+
   // Compile a String source within a context for Eval.
   static Handle<SharedFunctionInfo> CompileEval(Handle<String> source,
                                                 Handle<Context> context,
@@ -269,6 +288,15 @@ class Compiler : public AllStatic {
                                         int start_position,
                                         Handle<Script> script,
                                         Handle<Code> code);
+
+  class Data;
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kCompilerData));
+  }
+
+  friend class Isolate;
 };
 
 
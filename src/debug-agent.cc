@@ -36,16 +36,20 @@ namespace internal {
 // Public V8 debugger API message handler function. This function just delegates
 // to the debugger agent through it's data parameter.
 void DebuggerAgentMessageHandler(const v8::Debug::Message& message) {
-  DebuggerAgent::instance_->DebuggerMessage(message);
+  DebuggerAgent::data()->instance_->DebuggerMessage(message);
 }
 
-// static
-DebuggerAgent* DebuggerAgent::instance_ = NULL;
+
+DEFINE_ISOLATE_COMPONENT(DebuggerAgent)
+
 
 // Debugger agent main thread.
 void DebuggerAgent::Run() {
   const int kOneSecondInMicros = 1000000;
 
+  // The sessions are hooked up to the debugger of the agent's isolate.
+  isolate_->Enter();
+
   // Allow this socket to reuse port even if still in TIME_WAIT.
   server_->SetReuseAddress(true);
 
@@ -78,6 +82,8 @@ void DebuggerAgent::Run() {
       }
     }
   }
+
+  isolate_->Exit();
 }
 
 
@@ -164,12 +170,16 @@ void DebuggerAgentSession::Run() {
   bool ok = DebuggerAgentUtil::SendConnectMessage(client_, *agent_->name_);
   if (!ok) return;
 
+  // The requests go to the debugger of the agent's isolate.
+  agent_->isolate_->Enter();
+
   while (true) {
     // Read data from the debugger front end.
     SmartPointer<char> message = DebuggerAgentUtil::ReceiveMessage(client_);
     if (*message == NULL) {
       // Session is closed.
       agent_->OnSessionClosed(this);
+      agent_->isolate_->Exit();
       return;
     }
 
@@ -48,12 +48,13 @@ class DebuggerAgent: public Thread {
         server_(OS::CreateSocket()), terminate_(false),
         session_access_(OS::CreateMutex()), session_(NULL),
         terminate_now_(OS::CreateSemaphore(0)),
-        listening_(OS::CreateSemaphore(0)) {
-    ASSERT(instance_ == NULL);
-    instance_ = this;
+        listening_(OS::CreateSemaphore(0)),
+        isolate_(Isolate::Current()) {
+    ASSERT(data()->instance_ == NULL);
+    data()->instance_ = this;
   }
   ~DebuggerAgent() {
-     instance_ = NULL;
+     data()->instance_ = NULL;
      delete server_;
   }
 
@@ -75,10 +76,20 @@ class DebuggerAgent: public Thread {
   DebuggerAgentSession* session_;  // Current active session if any.
   Semaphore* terminate_now_;  // Semaphore to signal termination.
   Semaphore* listening_;
+  Isolate* isolate_;  // The isolate whose debugger the agent talks to.
 
-  static DebuggerAgent* instance_;
+  class Data {
+   public:
+    DebuggerAgent* instance_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kDebuggerAgentData));
+  }
 
   friend class DebuggerAgentSession;
+  friend class Isolate;
   friend void DebuggerAgentMessageHandler(const v8::Debug::Message& message);
 
   DISALLOW_COPY_AND_ASSIGN(DebuggerAgent);
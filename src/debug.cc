@@ -529,37 +529,35 @@ void BreakLocationIterator::RinfoNext() {
 }
 
 
-bool Debug::has_break_points_ = false;
-ScriptCache* Debug::script_cache_ = NULL;
-DebugInfoListNode* Debug::debug_info_list_ = NULL;
+DEFINE_ISOLATE_COMPONENT(Debug)
 
 
 // Threading support.
 void Debug::ThreadInit() {
-  thread_local_.break_count_ = 0;
-  thread_local_.break_id_ = 0;
-  thread_local_.break_frame_id_ = StackFrame::NO_ID;
-  thread_local_.last_step_action_ = StepNone;
-  thread_local_.last_statement_position_ = RelocInfo::kNoPosition;
-  thread_local_.step_count_ = 0;
-  thread_local_.last_fp_ = 0;
-  thread_local_.step_into_fp_ = 0;
-  thread_local_.step_out_fp_ = 0;
-  thread_local_.after_break_target_ = 0;
-  thread_local_.debugger_entry_ = NULL;
-  thread_local_.pending_interrupts_ = 0;
+  Data* data = Debug::data();
+  data->thread_local_.break_count_ = 0;
+  data->thread_local_.break_id_ = 0;
+  data->thread_local_.break_frame_id_ = StackFrame::NO_ID;
+  data->thread_local_.last_step_action_ = StepNone;
+  data->thread_local_.last_statement_position_ = RelocInfo::kNoPosition;
+  data->thread_local_.step_count_ = 0;
+  data->thread_local_.last_fp_ = 0;
+  data->thread_local_.step_into_fp_ = 0;
+  data->thread_local_.step_out_fp_ = 0;
+  data->thread_local_.after_break_target_ = 0;
+  data->thread_local_.debugger_entry_ = NULL;
+  data->thread_local_.pending_interrupts_ = 0;
 }
 
 
-JSCallerSavedBuffer Debug::registers_;
-Debug::ThreadLocal Debug::thread_local_;
-
-
 char* Debug::ArchiveDebug(char* storage) {
+  Data* data = Debug::data();
   char* to = storage;
-  memcpy(to, reinterpret_cast<char*>(&thread_local_), sizeof(ThreadLocal));
+  memcpy(to, reinterpret_cast<char*>(&data->thread_local_),
+         sizeof(ThreadLocal));
   to += sizeof(ThreadLocal);
-  memcpy(to, reinterpret_cast<char*>(&registers_), sizeof(registers_));
+  memcpy(to, reinterpret_cast<char*>(&data->registers_),
+         sizeof(data->registers_));
   ThreadInit();
   ASSERT(to <= storage + ArchiveSpacePerThread());
   return storage + ArchiveSpacePerThread();
@@ -567,32 +565,23 @@ char* Debug::ArchiveDebug(char* storage) {
 
 
 char* Debug::RestoreDebug(char* storage) {
+  Data* data = Debug::data();
   char* from = storage;
-  memcpy(reinterpret_cast<char*>(&thread_local_), from, sizeof(ThreadLocal));
+  memcpy(reinterpret_cast<char*>(&data->thread_local_), from,
+         sizeof(ThreadLocal));
   from += sizeof(ThreadLocal);
-  memcpy(reinterpret_cast<char*>(&registers_), from, sizeof(registers_));
+  memcpy(reinterpret_cast<char*>(&data->registers_), from,
+         sizeof(data->registers_));
   ASSERT(from <= storage + ArchiveSpacePerThread());
   return storage + ArchiveSpacePerThread();
 }
 
 
 int Debug::ArchiveSpacePerThread() {
-  return sizeof(ThreadLocal) + sizeof(registers_);
+  return sizeof(ThreadLocal) + sizeof(JSCallerSavedBuffer);
 }
 
 
-// Default break enabled.
-bool Debug::disable_break_ = false;
-
-// Default call debugger on uncaught exception.
-bool Debug::break_on_exception_ = false;
-bool Debug::break_on_uncaught_exception_ = true;
-
-Handle<Context> Debug::debug_context_ = Handle<Context>();
-Code* Debug::debug_break_return_ = NULL;
-Code* Debug::debug_break_slot_ = NULL;
-
-
 void ScriptCache::Add(Handle<Script> script) {
   // Create an entry in the hash map for the script.
   int id = Smi::cast(script->id())->value();
@@ -668,16 +657,17 @@ void ScriptCache::HandleWeakScript(v8::Persistent<v8::Value> obj, void* data) {
 
 
 void Debug::Setup(bool create_heap_objects) {
+  Data* data = Debug::data();
   ThreadInit();
   if (create_heap_objects) {
     // Get code to handle debug break on return.
-    debug_break_return_ =
+    data->debug_break_return_ =
         Builtins::builtin(Builtins::Return_DebugBreak);
-    ASSERT(debug_break_return_->IsCode());
+    ASSERT(data->debug_break_return_->IsCode());
     // Get code to handle debug break in debug break slots.
-    debug_break_slot_ =
+    data->debug_break_slot_ =
         Builtins::builtin(Builtins::Slot_DebugBreak);
-    ASSERT(debug_break_slot_->IsCode());
+    ASSERT(data->debug_break_slot_->IsCode());
   }
 }
 
@@ -686,7 +676,7 @@ void Debug::HandleWeakDebugInfo(v8::Persistent<v8::Value> obj, void* data) {
   DebugInfoListNode* node = reinterpret_cast<DebugInfoListNode*>(data);
   RemoveDebugInfo(node->debug_info());
 #ifdef DEBUG
-  node = Debug::debug_info_list_;
+  node = Debug::data()->debug_info_list_;
   while (node != NULL) {
     ASSERT(node != reinterpret_cast<DebugInfoListNode*>(data));
     node = node->next();
@@ -766,6 +756,7 @@ bool Debug::CompileDebuggerScript(int index) {
 
 bool Debug::Load() {
   // Return if debugger is already loaded.
+  Data* data = Debug::data();
   if (IsLoaded()) return true;
 
   // Bail out if we're already in the process of compiling the native
@@ -816,7 +807,7 @@ bool Debug::Load() {
   if (caught_exception) return false;
 
   // Debugger loaded.
-  debug_context_ = Handle<Context>::cast(GlobalHandles::Create(*context));
+  data->debug_context_ = Handle<Context>::cast(GlobalHandles::Create(*context));
 
   return true;
 }
@@ -824,6 +815,7 @@ bool Debug::Load() {
 
 void Debug::Unload() {
   // Return debugger is not loaded.
+  Data* data = Debug::data();
   if (!IsLoaded()) {
     return;
   }
@@ -832,8 +824,9 @@ void Debug::Unload() {
   DestroyScriptCache();
 
   // Clear debugger context global handle.
-  GlobalHandles::Destroy(reinterpret_cast<Object**>(debug_context_.location()));
-  debug_context_ = Handle<Context>();
+  GlobalHandles::Destroy(
+      reinterpret_cast<Object**>(data->debug_context_.location()));
+  data->debug_context_ = Handle<Context>();
 }
 
 
@@ -845,16 +838,17 @@ void Debug::PreemptionWhileInDebugger() {
 
 
 void Debug::Iterate(ObjectVisitor* v) {
-  v->VisitPointer(BitCast<Object**, Code**>(&(debug_break_return_)));
-  v->VisitPointer(BitCast<Object**, Code**>(&(debug_break_slot_)));
+  v->VisitPointer(BitCast<Object**, Code**>(&(data()->debug_break_return_)));
+  v->VisitPointer(BitCast<Object**, Code**>(&(data()->debug_break_slot_)));
 }
 
 
 Object* Debug::Break(Arguments args) {
+  Data* data = Debug::data();
   HandleScope scope;
   ASSERT(args.length() == 0);
 
-  thread_local_.frames_are_dropped_ = false;
+  data->thread_local_.frames_are_dropped_ = false;
 
   // Get the top-most JavaScript frame.
   JavaScriptFrameIterator it;
@@ -888,8 +882,8 @@ Object* Debug::Break(Arguments args) {
   // Check whether step next reached a new statement.
   if (!StepNextContinue(&break_location_iterator, frame)) {
     // Decrease steps left if performing multiple steps.
-    if (thread_local_.step_count_ > 0) {
-      thread_local_.step_count_--;
+    if (data->thread_local_.step_count_ > 0) {
+      data->thread_local_.step_count_--;
     }
   }
 
@@ -907,10 +901,10 @@ Object* Debug::Break(Arguments args) {
   if (Debug::StepOutActive() && frame->fp() != Debug::step_out_fp() &&
       break_points_hit->IsUndefined() ) {
       // Step count should always be 0 for StepOut.
-      ASSERT(thread_local_.step_count_ == 0);
+      ASSERT(data->thread_local_.step_count_ == 0);
   } else if (!break_points_hit->IsUndefined() ||
-             (thread_local_.last_step_action_ != StepNone &&
-              thread_local_.step_count_ == 0)) {
+             (data->thread_local_.last_step_action_ != StepNone &&
+              data->thread_local_.step_count_ == 0)) {
     // Notify debugger if a real break point is triggered or if performing
     // single stepping with no more steps to perform. Otherwise do another step.
 
@@ -919,11 +913,11 @@ Object* Debug::Break(Arguments args) {
 
     // Notify the debug event listeners.
     Debugger::OnDebugBreak(break_points_hit, false);
-  } else if (thread_local_.last_step_action_ != StepNone) {
+  } else if (data->thread_local_.last_step_action_ != StepNone) {
     // Hold on to last step action as it is cleared by the call to
     // ClearStepping.
-    StepAction step_action = thread_local_.last_step_action_;
-    int step_count = thread_local_.step_count_;
+    StepAction step_action = data->thread_local_.last_step_action_;
+    int step_count = data->thread_local_.step_count_;
 
     // Clear all current stepping setup.
     ClearStepping();
@@ -932,10 +926,10 @@ Object* Debug::Break(Arguments args) {
     PrepareStep(step_action, step_count);
   }
 
-  if (thread_local_.frames_are_dropped_) {
+  if (data->thread_local_.frames_are_dropped_) {
     // We must have been calling IC stub. Do not return there anymore.
     Code* plain_return = Builtins::builtin(Builtins::PlainReturn_LiveEdit);
-    thread_local_.after_break_target_ = plain_return->entry();
+    data->thread_local_.after_break_target_ = plain_return->entry();
   } else {
     SetAfterBreakTarget(frame);
   }
@@ -1054,7 +1048,7 @@ void Debug::SetBreakPoint(Handle<SharedFunctionInfo> shared,
 void Debug::ClearBreakPoint(Handle<Object> break_point_object) {
   HandleScope scope;
 
-  DebugInfoListNode* node = debug_info_list_;
+  DebugInfoListNode* node = data()->debug_info_list_;
   while (node != NULL) {
     Object* result = DebugInfo::FindBreakPointInfo(node->debug_info(),
                                                    break_point_object);
@@ -1087,7 +1081,8 @@ void Debug::ClearBreakPoint(Handle<Object> break_point_object) {
 
 
 void Debug::ClearAllBreakPoints() {
-  DebugInfoListNode* node = debug_info_list_;
+  Data* data = Debug::data();
+  DebugInfoListNode* node = data->debug_info_list_;
   while (node != NULL) {
     // Remove all debug break code.
     BreakLocationIterator it(node->debug_info(), ALL_BREAK_LOCATIONS);
@@ -1096,8 +1091,8 @@ void Debug::ClearAllBreakPoints() {
   }
 
   // Remove all debug info.
-  while (debug_info_list_ != NULL) {
-    RemoveDebugInfo(debug_info_list_->debug_info());
+  while (data->debug_info_list_ != NULL) {
+    RemoveDebugInfo(data->debug_info_list_->debug_info());
   }
 }
 
@@ -1141,25 +1136,26 @@ void Debug::FloodHandlerWithOneShot() {
 
 void Debug::ChangeBreakOnException(ExceptionBreakType type, bool enable) {
   if (type == BreakUncaughtException) {
-    break_on_uncaught_exception_ = enable;
+    data()->break_on_uncaught_exception_ = enable;
   } else {
-    break_on_exception_ = enable;
+    data()->break_on_exception_ = enable;
   }
 }
 
 
 void Debug::PrepareStep(StepAction step_action, int step_count) {
+  Data* data = Debug::data();
   HandleScope scope;
   ASSERT(Debug::InDebugger());
 
   // Remember this step action and count.
-  thread_local_.last_step_action_ = step_action;
+  data->thread_local_.last_step_action_ = step_action;
   if (step_action == StepOut) {
     // For step out target frame will be found on the stack so there is no need
     // to set step counter for it. It's expected to always be 0 for StepOut.
-    thread_local_.step_count_ = 0;
+    data->thread_local_.step_count_ = 0;
   } else {
-    thread_local_.step_count_ = step_count;
+    data->thread_local_.step_count_ = step_count;
   }
 
   // Get the frame where the execution has stopped and skip the debug frame if
@@ -1271,9 +1267,9 @@ void Debug::PrepareStep(StepAction step_action, int step_count) {
     FloodWithOneShot(shared);
 
     // Remember source position and frame to handle step next.
-    thread_local_.last_statement_position_ =
+    data->thread_local_.last_statement_position_ =
         debug_info->code()->SourceStatementPosition(frame->pc());
-    thread_local_.last_fp_ = frame->fp();
+    data->thread_local_.last_fp_ = frame->fp();
   } else {
     // If it's CallFunction stub ensure target function is compiled and flood
     // it with one shot breakpoints.
@@ -1327,9 +1323,9 @@ void Debug::PrepareStep(StepAction step_action, int step_count) {
       // there is a custom getter/setter it will be handled in
       // Object::Get/SetPropertyWithCallback, otherwise the step action will be
       // propagated on the next Debug::Break.
-      thread_local_.last_statement_position_ =
+      data->thread_local_.last_statement_position_ =
           debug_info->code()->SourceStatementPosition(frame->pc());
-      thread_local_.last_fp_ = frame->fp();
+      data->thread_local_.last_fp_ = frame->fp();
     }
 
     // Step in or Step in min
@@ -1349,16 +1345,18 @@ bool Debug::StepNextContinue(BreakLocationIterator* break_location_iterator,
                              JavaScriptFrame* frame) {
   // If the step last action was step next or step in make sure that a new
   // statement is hit.
-  if (thread_local_.last_step_action_ == StepNext ||
-      thread_local_.last_step_action_ == StepIn) {
+  Data* data = Debug::data();
+  if (data->thread_local_.last_step_action_ == StepNext ||
+      data->thread_local_.last_step_action_ == StepIn) {
     // Never continue if returning from function.
     if (break_location_iterator->IsExit()) return false;
 
     // Continue if we are still on the same frame and in the same statement.
     int current_statement_position =
         break_location_iterator->code()->SourceStatementPosition(frame->pc());
-    return thread_local_.last_fp_ == frame->fp() &&
-        thread_local_.last_statement_position_ == current_statement_position;
+    return data->thread_local_.last_fp_ == frame->fp() &&
+        data->thread_local_.last_statement_position_ ==
+            current_statement_position;
   }
 
   // No step next action - don't continue.
@@ -1462,14 +1460,15 @@ Handle<Object> Debug::GetSourceBreakLocations(
 
 
 void Debug::NewBreak(StackFrame::Id break_frame_id) {
-  thread_local_.break_frame_id_ = break_frame_id;
-  thread_local_.break_id_ = ++thread_local_.break_count_;
+  Data* data = Debug::data();
+  data->thread_local_.break_frame_id_ = break_frame_id;
+  data->thread_local_.break_id_ = ++data->thread_local_.break_count_;
 }
 
 
 void Debug::SetBreak(StackFrame::Id break_frame_id, int break_id) {
-  thread_local_.break_frame_id_ = break_frame_id;
-  thread_local_.break_id_ = break_id;
+  data()->thread_local_.break_frame_id_ = break_frame_id;
+  data()->thread_local_.break_id_ = break_id;
 }
 
 
@@ -1525,7 +1524,7 @@ void Debug::ClearStepping() {
   ClearStepNext();
 
   // Clear multiple step counter.
-  thread_local_.step_count_ = 0;
+  data()->thread_local_.step_count_ = 0;
 }
 
 // Clears all the one-shot break points that are currently set. Normally this
@@ -1536,7 +1535,7 @@ void Debug::ClearOneShot() {
   // last break point for a function is removed that function is automatically
   // removed from the list.
 
-  DebugInfoListNode* node = debug_info_list_;
+  DebugInfoListNode* node = data()->debug_info_list_;
   while (node != NULL) {
     BreakLocationIterator it(node->debug_info(), ALL_BREAK_LOCATIONS);
     while (!it.Done()) {
@@ -1550,36 +1549,38 @@ void Debug::ClearOneShot() {
 
 void Debug::ActivateStepIn(StackFrame* frame) {
   ASSERT(!StepOutActive());
-  thread_local_.step_into_fp_ = frame->fp();
+  data()->thread_local_.step_into_fp_ = frame->fp();
 }
 
 
 void Debug::ClearStepIn() {
-  thread_local_.step_into_fp_ = 0;
+  data()->thread_local_.step_into_fp_ = 0;
 }
 
 
 void Debug::ActivateStepOut(StackFrame* frame) {
   ASSERT(!StepInActive());
-  thread_local_.step_out_fp_ = frame->fp();
+  data()->thread_local_.step_out_fp_ = frame->fp();
 }
 
 
 void Debug::ClearStepOut() {
-  thread_local_.step_out_fp_ = 0;
+  data()->thread_local_.step_out_fp_ = 0;
 }
 
 
 void Debug::ClearStepNext() {
-  thread_local_.last_step_action_ = StepNone;
-  thread_local_.last_statement_position_ = RelocInfo::kNoPosition;
-  thread_local_.last_fp_ = 0;
+  Data* data = Debug::data();
+  data->thread_local_.last_step_action_ = StepNone;
+  data->thread_local_.last_statement_position_ = RelocInfo::kNoPosition;
+  data->thread_local_.last_fp_ = 0;
 }
 
 
 // Ensures the debug information is present for shared.
 bool Debug::EnsureDebugInfo(Handle<SharedFunctionInfo> shared) {
   // Return if we already have the debug info for shared.
+  Data* data = Debug::data();
   if (HasDebugInfo(shared)) return true;
 
   // Ensure shared in compiled. Return false if this failed.
@@ -1590,26 +1591,27 @@ bool Debug::EnsureDebugInfo(Handle<SharedFunctionInfo> shared) {
 
   // Add debug info to the list.
   DebugInfoListNode* node = new DebugInfoListNode(*debug_info);
-  node->set_next(debug_info_list_);
-  debug_info_list_ = node;
+  node->set_next(data->debug_info_list_);
+  data->debug_info_list_ = node;
 
   // Now there is at least one break point.
-  has_break_points_ = true;
+  data->has_break_points_ = true;
 
   return true;
 }
 
 
 void Debug::RemoveDebugInfo(Handle<DebugInfo> debug_info) {
-  ASSERT(debug_info_list_ != NULL);
+  Data* data = Debug::data();
+  ASSERT(data->debug_info_list_ != NULL);
   // Run through the debug info objects to find this one and remove it.
   DebugInfoListNode* prev = NULL;
-  DebugInfoListNode* current = debug_info_list_;
+  DebugInfoListNode* current = data->debug_info_list_;
   while (current != NULL) {
     if (*current->debug_info() == *debug_info) {
       // Unlink from list. If prev is NULL we are looking at the first element.
       if (prev == NULL) {
-        debug_info_list_ = current->next();
+        data->debug_info_list_ = current->next();
       } else {
         prev->set_next(current->next());
       }
@@ -1618,7 +1620,7 @@ void Debug::RemoveDebugInfo(Handle<DebugInfo> debug_info) {
 
       // If there are no more debug info objects there are not more break
       // points.
-      has_break_points_ = debug_info_list_ != NULL;
+      data->has_break_points_ = data->debug_info_list_ != NULL;
 
       return;
     }
@@ -1631,6 +1633,7 @@ void Debug::RemoveDebugInfo(Handle<DebugInfo> debug_info) {
 
 
 void Debug::SetAfterBreakTarget(JavaScriptFrame* frame) {
+  Data* data = Debug::data();
   HandleScope scope;
 
   // Get the executing function in which the debug break occurred.
@@ -1683,14 +1686,15 @@ void Debug::SetAfterBreakTarget(JavaScriptFrame* frame) {
     }
 
     // Move back to where the call instruction sequence started.
-    thread_local_.after_break_target_ =
+    data->thread_local_.after_break_target_ =
         addr - Assembler::kPatchReturnSequenceAddressOffset;
   } else if (at_debug_break_slot) {
     // Address of where the debug break slot starts.
     addr = addr - Assembler::kPatchDebugBreakSlotAddressOffset;
 
     // Continue just after the slot.
-    thread_local_.after_break_target_ = addr + Assembler::kDebugBreakSlotLength;
+    data->thread_local_.after_break_target_ =
+        addr + Assembler::kDebugBreakSlotLength;
   } else if (IsDebugBreak(Assembler::target_address_at(addr))) {
     // We now know that there is still a debug break call at the target address,
     // so the break point is still there and the original code will hold the
@@ -1702,13 +1706,15 @@ void Debug::SetAfterBreakTarget(JavaScriptFrame* frame) {
 
     // Install jump to the call address in the original code. This will be the
     // call which was overwritten by the call to DebugBreakXXX.
-    thread_local_.after_break_target_ = Assembler::target_address_at(addr);
+    data->thread_local_.after_break_target_ =
+        Assembler::target_address_at(addr);
   } else {
     // There is no longer a break point present. Don't try to look in the
     // original code as the running code will have the right address. This takes
     // care of the case where the last break point is removed from the function
     // and therefore no "original code" is available.
-    thread_local_.after_break_target_ = Assembler::target_address_at(addr);
+    data->thread_local_.after_break_target_ =
+        Assembler::target_address_at(addr);
   }
 }
 
@@ -1748,8 +1754,8 @@ bool Debug::IsBreakAtReturn(JavaScriptFrame* frame) {
 
 
 void Debug::FramesHaveBeenDropped(StackFrame::Id new_break_frame_id) {
-  thread_local_.frames_are_dropped_ = true;
-  thread_local_.break_frame_id_ = new_break_frame_id;
+  data()->thread_local_.frames_are_dropped_ = true;
+  data()->thread_local_.break_frame_id_ = new_break_frame_id;
 }
 
 
@@ -1776,6 +1782,7 @@ void Debug::ClearMirrorCache() {
 
 
 void Debug::CreateScriptCache() {
+  Data* data = Debug::data();
   HandleScope scope;
 
   // Perform two GCs to get rid of all unreferenced scripts. The first GC gets
@@ -1784,15 +1791,15 @@ void Debug::CreateScriptCache() {
   Heap::CollectAllGarbage(false);
   Heap::CollectAllGarbage(false);
 
-  ASSERT(script_cache_ == NULL);
-  script_cache_ = new ScriptCache();
+  ASSERT(data->script_cache_ == NULL);
+  data->script_cache_ = new ScriptCache();
 
   // Scan heap for Script objects.
   int count = 0;
   HeapIterator iterator;
   for (HeapObject* obj = iterator.next(); obj != NULL; obj = iterator.next()) {
     if (obj->IsScript() && Script::cast(obj)->HasValidSource()) {
-      script_cache_->Add(Handle<Script>(Script::cast(obj)));
+      data->script_cache_->Add(Handle<Script>(Script::cast(obj)));
       count++;
     }
   }
@@ -1801,16 +1808,17 @@ void Debug::CreateScriptCache() {
 
 void Debug::DestroyScriptCache() {
   // Get rid of the script cache if it was created.
-  if (script_cache_ != NULL) {
-    delete script_cache_;
-    script_cache_ = NULL;
+  Data* data = Debug::data();
+  if (data->script_cache_ != NULL) {
+    delete data->script_cache_;
+    data->script_cache_ = NULL;
   }
 }
 
 
 void Debug::AddScriptToScriptCache(Handle<Script> script) {
-  if (script_cache_ != NULL) {
-    script_cache_->Add(script);
+  if (data()->script_cache_ != NULL) {
+    data()->script_cache_->Add(script);
   }
 }
 
@@ -1818,13 +1826,14 @@ void Debug::AddScriptToScriptCache(Handle<Script> script) {
 Handle<FixedArray> Debug::GetLoadedScripts() {
   // Create and fill the script cache when the loaded scripts is requested for
   // the first time.
-  if (script_cache_ == NULL) {
+  Data* data = Debug::data();
+  if (data->script_cache_ == NULL) {
     CreateScriptCache();
   }
 
   // If the script cache is not active just return an empty array.
-  ASSERT(script_cache_ != NULL);
-  if (script_cache_ == NULL) {
+  ASSERT(data->script_cache_ != NULL);
+  if (data->script_cache_ == NULL) {
     Factory::NewFixedArray(0);
   }
 
@@ -1833,35 +1842,36 @@ Handle<FixedArray> Debug::GetLoadedScripts() {
   Heap::CollectAllGarbage(false);
 
   // Get the scripts from the cache.
-  return script_cache_->GetScripts();
+  return data->script_cache_->GetScripts();
 }
 
 
 void Debug::AfterGarbageCollection() {
   // Generate events for collected scripts.
-  if (script_cache_ != NULL) {
-    script_cache_->ProcessCollectedScripts();
+  Data* data = Debug::data();
+  if (data->script_cache_ != NULL) {
+    data->script_cache_->ProcessCollectedScripts();
   }
 }
 
 
-Mutex* Debugger::debugger_access_ = OS::CreateMutex();
-Handle<Object> Debugger::event_listener_ = Handle<Object>();
-Handle<Object> Debugger::event_listener_data_ = Handle<Object>();
-bool Debugger::compiling_natives_ = false;
-bool Debugger::is_loading_debugger_ = false;
-bool Debugger::never_unload_debugger_ = false;
-v8::Debug::MessageHandler2 Debugger::message_handler_ = NULL;
-bool Debugger::debugger_unload_pending_ = false;
-v8::Debug::HostDispatchHandler Debugger::host_dispatch_handler_ = NULL;
-Mutex* Debugger::dispatch_handler_access_ = OS::CreateMutex();
-v8::Debug::DebugMessageDispatchHandler
-    Debugger::debug_message_dispatch_handler_ = NULL;
-MessageDispatchHelperThread* Debugger::message_dispatch_helper_thread_ = NULL;
-int Debugger::host_dispatch_micros_ = 100 * 1000;
-DebuggerAgent* Debugger::agent_ = NULL;
-LockingCommandMessageQueue Debugger::command_queue_(kQueueInitialSize);
-Semaphore* Debugger::command_received_ = OS::CreateSemaphore(0);
+Debugger::Data::Data()
+    : debugger_access_(OS::CreateMutex()),
+      dispatch_handler_access_(OS::CreateMutex()),
+      host_dispatch_micros_(100 * 1000),
+      command_queue_(kQueueInitialSize),
+      command_received_(OS::CreateSemaphore(0)) {
+}
+
+
+Debugger::Data::~Data() {
+  delete debugger_access_;
+  delete dispatch_handler_access_;
+  delete command_received_;
+}
+
+
+DEFINE_ISOLATE_COMPONENT(Debugger)
 
 
 Handle<Object> Debugger::MakeJSObject(Vector<const char> constructor_name,
@@ -2167,6 +2177,7 @@ void Debugger::OnScriptCollected(int id) {
 void Debugger::ProcessDebugEvent(v8::DebugEvent event,
                                  Handle<JSObject> event_data,
                                  bool auto_continue) {
+  Data* data = Debugger::data();
   HandleScope scope;
 
   // Clear any pending debug break if this is a real break.
@@ -2181,7 +2192,7 @@ void Debugger::ProcessDebugEvent(v8::DebugEvent event,
     return;
   }
   // First notify the message handler if any.
-  if (message_handler_ != NULL) {
+  if (data->message_handler_ != NULL) {
     NotifyMessageHandler(event,
                          Handle<JSObject>::cast(exec_state),
                          event_data,
@@ -2189,29 +2200,29 @@ void Debugger::ProcessDebugEvent(v8::DebugEvent event,
   }
   // Notify registered debug event listener. This can be either a C or a
   // JavaScript function.
-  if (!event_listener_.is_null()) {
-    if (event_listener_->IsProxy()) {
+  if (!data->event_listener_.is_null()) {
+    if (data->event_listener_->IsProxy()) {
       // C debug event listener.
-      Handle<Proxy> callback_obj(Handle<Proxy>::cast(event_listener_));
+      Handle<Proxy> callback_obj(Handle<Proxy>::cast(data->event_listener_));
       v8::Debug::EventCallback2 callback =
             FUNCTION_CAST<v8::Debug::EventCallback2>(callback_obj->proxy());
       EventDetailsImpl event_details(
           event,
           Handle<JSObject>::cast(exec_state),
           event_data,
-          event_listener_data_);
+          data->event_listener_data_);
       callback(event_details);
     } else {
       // JavaScript debug event listener.
-      ASSERT(event_listener_->IsJSFunction());
-      Handle<JSFunction> fun(Handle<JSFunction>::cast(event_listener_));
+      ASSERT(data->event_listener_->IsJSFunction());
+      Handle<JSFunction> fun(Handle<JSFunction>::cast(data->event_listener_));
 
       // Invoke the JavaScript debug event listener.
       const int argc = 4;
       Object** argv[argc] = { Handle<Object>(Smi::FromInt(event)).location(),
                               exec_state.location(),
                               Handle<Object>::cast(event_data).location(),
-                              event_listener_data_.location() };
+                              data->event_listener_data_.location() };
       Handle<Object> result = Execution::TryCall(fun, Top::global(),
                                                  argc, argv, &caught_exception);
       // Silently ignore exceptions from debug event listeners.
@@ -2221,7 +2232,7 @@ void Debugger::ProcessDebugEvent(v8::DebugEvent event,
 
 
 Handle<Context> Debugger::GetDebugContext() {
-    never_unload_debugger_ = true;
+    data()->never_unload_debugger_ = true;
     EnterDebugger debugger;
     return Debug::debug_context();
 }
@@ -2232,12 +2243,12 @@ void Debugger::UnloadDebugger() {
   Debug::ClearAllBreakPoints();
 
   // Unload the debugger if feasible.
-  if (!never_unload_debugger_) {
+  if (!data()->never_unload_debugger_) {
     Debug::Unload();
   }
 
   // Clear the flag indicating that the debugger should be unloaded.
-  debugger_unload_pending_ = false;
+  data()->debugger_unload_pending_ = false;
 }
 
 
@@ -2245,6 +2256,7 @@ void Debugger::NotifyMessageHandler(v8::DebugEvent event,
                                     Handle<JSObject> exec_state,
                                     Handle<JSObject> event_data,
                                     bool auto_continue) {
+  Data* data = Debugger::data();
   HandleScope scope;
 
   if (!Debug::Load()) return;
@@ -2325,20 +2337,20 @@ void Debugger::NotifyMessageHandler(v8::DebugEvent event,
   // Process requests from the debugger.
   while (true) {
     // Wait for new command in the queue.
-    if (Debugger::host_dispatch_handler_) {
+    if (data->host_dispatch_handler_) {
       // In case there is a host dispatch - do periodic dispatches.
-      if (!command_received_->Wait(host_dispatch_micros_)) {
+      if (!data->command_received_->Wait(data->host_dispatch_micros_)) {
         // Timout expired, do the dispatch.
-        Debugger::host_dispatch_handler_();
+        data->host_dispatch_handler_();
         continue;
       }
     } else {
       // In case there is no host dispatch - just wait.
-      command_received_->Wait();
+      data->command_received_->Wait();
     }
 
     // Get the command from the queue.
-    CommandMessage command = command_queue_.Get();
+    CommandMessage command = data->command_queue_.Get();
     Logger::DebugTag("Got request from command queue, in interactive loop.");
     if (!Debugger::IsDebuggerActive()) {
       // Delete command text and user data.
@@ -2415,27 +2427,31 @@ void Debugger::SetEventListener(Handle<Object> callback,
                                 Handle<Object> data) {
   HandleScope scope;
 
+  Data* debugger_data = Debugger::data();
+
   // Clear the global handles for the event listener and the event listener data
   // object.
-  if (!event_listener_.is_null()) {
+  if (!debugger_data->event_listener_.is_null()) {
     GlobalHandles::Destroy(
-        reinterpret_cast<Object**>(event_listener_.location()));
-    event_listener_ = Handle<Object>();
+        reinterpret_cast<Object**>(debugger_data->event_listener_.location()));
+    debugger_data->event_listener_ = Handle<Object>();
   }
-  if (!event_listener_data_.is_null()) {
-    GlobalHandles::Destroy(
-        reinterpret_cast<Object**>(event_listener_data_.location()));
-    event_listener_data_ = Handle<Object>();
+  if (!debugger_data->event_listener_data_.is_null()) {
+    GlobalHandles::Destroy(reinterpret_cast<Object**>(
+        debugger_data->event_listener_data_.location()));
+    debugger_data->event_listener_data_ = Handle<Object>();
   }
 
   // If there is a new debug event listener register it together with its data
   // object.
   if (!callback->IsUndefined() && !callback->IsNull()) {
-    event_listener_ = Handle<Object>::cast(GlobalHandles::Create(*callback));
+    debugger_data->event_listener_ =
+        Handle<Object>::cast(GlobalHandles::Create(*callback));
     if (data.is_null()) {
       data = Factory::undefined_value();
     }
-    event_listener_data_ = Handle<Object>::cast(GlobalHandles::Create(*data));
+    debugger_data->event_listener_data_ =
+        Handle<Object>::cast(GlobalHandles::Create(*data));
   }
 
   ListenersChanged();
@@ -2443,9 +2459,9 @@ void Debugger::SetEventListener(Handle<Object> callback,
 
 
 void Debugger::SetMessageHandler(v8::Debug::MessageHandler2 handler) {
-  ScopedLock with(debugger_access_);
+  ScopedLock with(data()->debugger_access_);
 
-  message_handler_ = handler;
+  data()->message_handler_ = handler;
   ListenersChanged();
   if (handler == NULL) {
     // Send an empty command to the debugger if in a break to make JavaScript
@@ -2461,31 +2477,32 @@ void Debugger::ListenersChanged() {
   if (IsDebuggerActive()) {
     // Disable the compilation cache when the debugger is active.
     CompilationCache::Disable();
-    debugger_unload_pending_ = false;
+    data()->debugger_unload_pending_ = false;
   } else {
     CompilationCache::Enable();
     // Unload the debugger if event listener and message handler cleared.
     // Schedule this for later, because we may be in non-V8 thread.
-    debugger_unload_pending_ = true;
+    data()->debugger_unload_pending_ = true;
   }
 }
 
 
 void Debugger::SetHostDispatchHandler(v8::Debug::HostDispatchHandler handler,
                                       int period) {
-  host_dispatch_handler_ = handler;
-  host_dispatch_micros_ = period * 1000;
+  data()->host_dispatch_handler_ = handler;
+  data()->host_dispatch_micros_ = period * 1000;
 }
 
 
 void Debugger::SetDebugMessageDispatchHandler(
     v8::Debug::DebugMessageDispatchHandler handler, bool provide_locker) {
-  ScopedLock with(dispatch_handler_access_);
-  debug_message_dispatch_handler_ = handler;
+  Data* data = Debugger::data();
+  ScopedLock with(data->dispatch_handler_access_);
+  data->debug_message_dispatch_handler_ = handler;
 
-  if (provide_locker && message_dispatch_helper_thread_ == NULL) {
-    message_dispatch_helper_thread_ = new MessageDispatchHelperThread;
-    message_dispatch_helper_thread_->Start();
+  if (provide_locker && data->message_dispatch_helper_thread_ == NULL) {
+    data->message_dispatch_helper_thread_ = new MessageDispatchHelperThread;
+    data->message_dispatch_helper_thread_->Start();
   }
 }
 
@@ -2493,10 +2510,11 @@ void Debugger::SetDebugMessageDispatchHandler(
 // Calls the registered debug message handler. This callback is part of the
 // public API.
 void Debugger::InvokeMessageHandler(MessageImpl message) {
-  ScopedLock with(debugger_access_);
+  Data* data = Debugger::data();
+  ScopedLock with(data->debugger_access_);
 
-  if (message_handler_ != NULL) {
-    message_handler_(message);
+  if (data->message_handler_ != NULL) {
+    data->message_handler_(message);
   }
 }
 
@@ -2508,13 +2526,14 @@ void Debugger::InvokeMessageHandler(MessageImpl message) {
 void Debugger::ProcessCommand(Vector<const uint16_t> command,
                               v8::Debug::ClientData* client_data) {
   // Need to cast away const.
+  Data* data = Debugger::data();
   CommandMessage message = CommandMessage::New(
       Vector<uint16_t>(const_cast<uint16_t*>(command.start()),
                        command.length()),
       client_data);
   Logger::DebugTag("Put command on command_queue.");
-  command_queue_.Put(message);
-  command_received_->Signal();
+  data->command_queue_.Put(message);
+  data->command_received_->Signal();
 
   // Set the debug command break flag to have the command processed.
   if (!Debug::InDebugger()) {
@@ -2523,8 +2542,8 @@ void Debugger::ProcessCommand(Vector<const uint16_t> command,
 
   MessageDispatchHelperThread* dispatch_thread;
   {
-    ScopedLock with(dispatch_handler_access_);
-    dispatch_thread = message_dispatch_helper_thread_;
+    ScopedLock with(data->dispatch_handler_access_);
+    dispatch_thread = data->message_dispatch_helper_thread_;
   }
 
   if (dispatch_thread == NULL) {
@@ -2536,14 +2555,15 @@ void Debugger::ProcessCommand(Vector<const uint16_t> command,
 
 
 bool Debugger::HasCommands() {
-  return !command_queue_.IsEmpty();
+  return !data()->command_queue_.IsEmpty();
 }
 
 
 bool Debugger::IsDebuggerActive() {
-  ScopedLock with(debugger_access_);
+  Data* data = Debugger::data();
+  ScopedLock with(data->debugger_access_);
 
-  return message_handler_ != NULL || !event_listener_.is_null();
+  return data->message_handler_ != NULL || !data->event_listener_.is_null();
 }
 
 
@@ -2551,7 +2571,7 @@ Handle<Object> Debugger::Call(Handle<JSFunction> fun,
                               Handle<Object> data,
                               bool* pending_exception) {
   // When calling functions in the debugger prevent it from beeing unloaded.
-  Debugger::never_unload_debugger_ = true;
+  Debugger::data()->never_unload_debugger_ = true;
 
   // Enter the debugger.
   EnterDebugger debugger;
@@ -2570,7 +2590,7 @@ Handle<Object> Debugger::Call(Handle<JSFunction> fun,
   Object** argv[kArgc] = { exec_state.location(), data.location() };
   Handle<Object> result = Execution::Call(
       fun,
-      Handle<Object>(Debug::debug_context_->global_proxy()),
+      Handle<Object>(Debug::debug_context()->global_proxy()),
       kArgc,
       argv,
       pending_exception);
@@ -2585,6 +2605,7 @@ static void StubMessageHandler2(const v8::Debug::Message& message) {
 
 bool Debugger::StartAgent(const char* name, int port,
                           bool wait_for_connection) {
+  Data* data = Debugger::data();
   if (wait_for_connection) {
     // Suspend V8 if it is already running or set V8 to suspend whenever
     // it starts.
@@ -2592,13 +2613,13 @@ bool Debugger::StartAgent(const char* name, int port,
     // when there is no message handler; we doesn't need it.
     // Once become suspended, V8 will stay so indefinitely long, until remote
     // debugger connects and issues "continue" command.
-    Debugger::message_handler_ = StubMessageHandler2;
+    data->message_handler_ = StubMessageHandler2;
     v8::Debug::DebugBreak();
   }
 
   if (Socket::Setup()) {
-    agent_ = new DebuggerAgent(name, port);
-    agent_->Start();
+    data->agent_ = new DebuggerAgent(name, port);
+    data->agent_->Start();
     return true;
   }
 
@@ -2607,26 +2628,27 @@ bool Debugger::StartAgent(const char* name, int port,
 
 
 void Debugger::StopAgent() {
-  if (agent_ != NULL) {
-    agent_->Shutdown();
-    agent_->Join();
-    delete agent_;
-    agent_ = NULL;
+  Data* data = Debugger::data();
+  if (data->agent_ != NULL) {
+    data->agent_->Shutdown();
+    data->agent_->Join();
+    delete data->agent_;
+    data->agent_ = NULL;
   }
 }
 
 
 void Debugger::WaitForAgent() {
-  if (agent_ != NULL)
-    agent_->WaitUntilListening();
+  if (data()->agent_ != NULL)
+    data()->agent_->WaitUntilListening();
 }
 
 
 void Debugger::CallMessageDispatchHandler() {
   v8::Debug::DebugMessageDispatchHandler handler;
   {
-    ScopedLock with(dispatch_handler_access_);
-    handler = Debugger::debug_message_dispatch_handler_;
+    ScopedLock with(data()->dispatch_handler_access_);
+    handler = Debugger::data()->debug_message_dispatch_handler_;
   }
   if (handler != NULL) {
     handler();
@@ -2888,7 +2910,7 @@ void LockingCommandMessageQueue::Clear() {
 
 MessageDispatchHelperThread::MessageDispatchHelperThread()
     : sem_(OS::CreateSemaphore(0)), mutex_(OS::CreateMutex()),
-      already_signalled_(false) {
+      already_signalled_(false), isolate_(Isolate::Current()) {
 }
 
 
@@ -2911,6 +2933,7 @@ void MessageDispatchHelperThread::Schedule() {
 
 
 void MessageDispatchHelperThread::Run() {
+  isolate_->Enter();
   while (true) {
     sem_->Wait();
     {
@@ -223,8 +223,10 @@ class Debug {
   static void Setup(bool create_heap_objects);
   static bool Load();
   static void Unload();
-  static bool IsLoaded() { return !debug_context_.is_null(); }
-  static bool InDebugger() { return thread_local_.debugger_entry_ != NULL; }
+  static bool IsLoaded() { return !data()->debug_context_.is_null(); }
+  static bool InDebugger() {
+    return data()->thread_local_.debugger_entry_ != NULL;
+  }
   static void PreemptionWhileInDebugger();
   static void Iterate(ObjectVisitor* v);
 
@@ -265,7 +267,9 @@ class Debug {
       Handle<SharedFunctionInfo> shared);
 
   // Getter for the debug_context.
-  inline static Handle<Context> debug_context() { return debug_context_; }
+  inline static Handle<Context> debug_context() {
+    return data()->debug_context_;
+  }
 
   // Check whether a global object is the debug global object.
   static bool IsDebugGlobal(GlobalObject* global);
@@ -274,58 +278,64 @@ class Debug {
   static bool IsBreakAtReturn(JavaScriptFrame* frame);
 
   // Fast check to see if any break points are active.
-  inline static bool has_break_points() { return has_break_points_; }
+  inline static bool has_break_points() { return data()->has_break_points_; }
 
   static void NewBreak(StackFrame::Id break_frame_id);
   static void SetBreak(StackFrame::Id break_frame_id, int break_id);
   static StackFrame::Id break_frame_id() {
-    return thread_local_.break_frame_id_;
+    return data()->thread_local_.break_frame_id_;
   }
-  static int break_id() { return thread_local_.break_id_; }
+  static int break_id() { return data()->thread_local_.break_id_; }
 
-  static bool StepInActive() { return thread_local_.step_into_fp_ != 0; }
+  static bool StepInActive() {
+    return data()->thread_local_.step_into_fp_ != 0;
+  }
   static void HandleStepIn(Handle<JSFunction> function,
                            Handle<Object> holder,
                            Address fp,
                            bool is_constructor);
-  static Address step_in_fp() { return thread_local_.step_into_fp_; }
-  static Address* step_in_fp_addr() { return &thread_local_.step_into_fp_; }
+  static Address step_in_fp() { return data()->thread_local_.step_into_fp_; }
+  static Address* step_in_fp_addr() {
+    return &data()->thread_local_.step_into_fp_;
+  }
 
-  static bool StepOutActive() { return thread_local_.step_out_fp_ != 0; }
-  static Address step_out_fp() { return thread_local_.step_out_fp_; }
+  static bool StepOutActive() {
+    return data()->thread_local_.step_out_fp_ != 0;
+  }
+  static Address step_out_fp() { return data()->thread_local_.step_out_fp_; }
 
   static EnterDebugger* debugger_entry() {
-    return thread_local_.debugger_entry_;
+    return data()->thread_local_.debugger_entry_;
   }
   static void set_debugger_entry(EnterDebugger* entry) {
-    thread_local_.debugger_entry_ = entry;
+    data()->thread_local_.debugger_entry_ = entry;
   }
 
   // Check whether any of the specified interrupts are pending.
   static bool is_interrupt_pending(InterruptFlag what) {
-    return (thread_local_.pending_interrupts_ & what) != 0;
+    return (data()->thread_local_.pending_interrupts_ & what) != 0;
   }
 
   // Set specified interrupts as pending.
   static void set_interrupts_pending(InterruptFlag what) {
-    thread_local_.pending_interrupts_ |= what;
+    data()->thread_local_.pending_interrupts_ |= what;
   }
 
   // Clear specified interrupts from pending.
   static void clear_interrupt_pending(InterruptFlag what) {
-    thread_local_.pending_interrupts_ &= ~static_cast<int>(what);
+    data()->thread_local_.pending_interrupts_ &= ~static_cast<int>(what);
   }
 
   // Getter and setter for the disable break state.
-  static bool disable_break() { return disable_break_; }
+  static bool disable_break() { return data()->disable_break_; }
   static void set_disable_break(bool disable_break) {
-    disable_break_ = disable_break;
+    data()->disable_break_ = disable_break;
   }
 
   // Getters for the current exception break state.
-  static bool break_on_exception() { return break_on_exception_; }
+  static bool break_on_exception() { return data()->break_on_exception_; }
   static bool break_on_uncaught_exception() {
-    return break_on_uncaught_exception_;
+    return data()->break_on_uncaught_exception_;
   }
 
   enum AddressId {
@@ -337,24 +347,25 @@ class Debug {
 
   // Support for setting the address to jump to when returning from break point.
   static Address* after_break_target_address() {
-    return reinterpret_cast<Address*>(&thread_local_.after_break_target_);
+    return reinterpret_cast<Address*>(
+        &data()->thread_local_.after_break_target_);
   }
 
   // Support for saving/restoring registers when handling debug break calls.
   static Object** register_address(int r) {
-    return &registers_[r];
+    return &data()->registers_[r];
   }
 
   // Access to the debug break on return code.
-  static Code* debug_break_return() { return debug_break_return_; }
+  static Code* debug_break_return() { return data()->debug_break_return_; }
   static Code** debug_break_return_address() {
-    return &debug_break_return_;
+    return &data()->debug_break_return_;
   }
 
   // Access to the debug break in debug break slot code.
-  static Code* debug_break_slot() { return debug_break_slot_; }
+  static Code* debug_break_slot() { return data()->debug_break_slot_; }
   static Code** debug_break_slot_address() {
-    return &debug_break_slot_;
+    return &data()->debug_break_slot_;
   }
 
   static const int kEstimatedNofDebugInfoEntries = 16;
@@ -420,23 +431,6 @@ class Debug {
   static Handle<Object> CheckBreakPoints(Handle<Object> break_point);
   static bool CheckBreakPoint(Handle<Object> break_point_object);
 
-  // Global handle to debug context where all the debugger JavaScript code is
-  // loaded.
-  static Handle<Context> debug_context_;
-
-  // Boolean state indicating whether any break points are set.
-  static bool has_break_points_;
-
-  // Cache of all scripts in the heap.
-  static ScriptCache* script_cache_;
-
-  // List of active debug info objects.
-  static DebugInfoListNode* debug_info_list_;
-
-  static bool disable_break_;
-  static bool break_on_exception_;
-  static bool break_on_uncaught_exception_;
-
   // Per-thread data.
   class ThreadLocal {
    public:
@@ -481,16 +475,47 @@ class Debug {
     int pending_interrupts_;
   };
 
-  // Storage location for registers when handling debug break calls
-  static JSCallerSavedBuffer registers_;
-  static ThreadLocal thread_local_;
-  static void ThreadInit();
+  class Data {
+   public:
+    // Default call debugger on uncaught exception.
+    Data() : break_on_uncaught_exception_(true) { }
+
+    // Global handle to debug context where all the debugger JavaScript code
+    // is loaded.
+    Handle<Context> debug_context_;
+
+    // Boolean state indicating whether any break points are set.
+    bool has_break_points_;
+
+    // Cache of all scripts in the heap.
+    ScriptCache* script_cache_;
+
+    // List of active debug info objects.
+    DebugInfoListNode* debug_info_list_;
 
-  // Code to call for handling debug break on return.
-  static Code* debug_break_return_;
+    bool disable_break_;
+    bool break_on_exception_;
+    bool break_on_uncaught_exception_;
 
-  // Code to call for handling debug break in debug break slots.
-  static Code* debug_break_slot_;
+    // Storage location for registers when handling debug break calls
+    JSCallerSavedBuffer registers_;
+    ThreadLocal thread_local_;
+
+    // Code to call for handling debug break on return.
+    Code* debug_break_return_;
+
+    // Code to call for handling debug break in debug break slots.
+    Code* debug_break_slot_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kDebugData));
+  }
+
+  static void ThreadInit();
+
+  friend class Isolate;
 
   DISALLOW_COPY_AND_ASSIGN(Debug);
 };
@@ -714,52 +739,69 @@ class Debugger {
   friend void ForceUnloadDebugger();  // In test-debug.cc
 
   inline static bool EventActive(v8::DebugEvent event) {
-    ScopedLock with(debugger_access_);
+    ScopedLock with(data()->debugger_access_);
 
     // Check whether the message handler was been cleared.
-    if (debugger_unload_pending_) {
+    if (data()->debugger_unload_pending_) {
       if (Debug::debugger_entry() == NULL) {
         UnloadDebugger();
       }
     }
 
     // Currently argument event is not used.
-    return !compiling_natives_ && Debugger::IsDebuggerActive();
+    return !data()->compiling_natives_ && Debugger::IsDebuggerActive();
   }
 
   static void set_compiling_natives(bool compiling_natives) {
-    Debugger::compiling_natives_ = compiling_natives;
+    Debugger::data()->compiling_natives_ = compiling_natives;
+  }
+  static bool compiling_natives() {
+    return Debugger::data()->compiling_natives_;
+  }
+  static void set_loading_debugger(bool v) { data()->is_loading_debugger_ = v; }
+  static bool is_loading_debugger() {
+    return Debugger::data()->is_loading_debugger_;
   }
-  static bool compiling_natives() { return Debugger::compiling_natives_; }
-  static void set_loading_debugger(bool v) { is_loading_debugger_ = v; }
-  static bool is_loading_debugger() { return Debugger::is_loading_debugger_; }
 
   static bool IsDebuggerActive();
 
  private:
   static void ListenersChanged();
 
-  static Mutex* debugger_access_;  // Mutex guarding debugger variables.
-  static Handle<Object> event_listener_;  // Global handle to listener.
-  static Handle<Object> event_listener_data_;
-  static bool compiling_natives_;  // Are we compiling natives?
-  static bool is_loading_debugger_;  // Are we loading the debugger?
-  static bool never_unload_debugger_;  // Can we unload the debugger?
-  static v8::Debug::MessageHandler2 message_handler_;
-  static bool debugger_unload_pending_;  // Was message handler cleared?
-  static v8::Debug::HostDispatchHandler host_dispatch_handler_;
-  static Mutex* dispatch_handler_access_;  // Mutex guarding dispatch handler.
-  static v8::Debug::DebugMessageDispatchHandler debug_message_dispatch_handler_;
-  static MessageDispatchHelperThread* message_dispatch_helper_thread_;
-  static int host_dispatch_micros_;
-
-  static DebuggerAgent* agent_;
-
   static const int kQueueInitialSize = 4;
-  static LockingCommandMessageQueue command_queue_;
-  static Semaphore* command_received_;  // Signaled for each command received.
+
+  class Data {
+   public:
+    Data();
+    ~Data();
+
+    Mutex* debugger_access_;  // Mutex guarding debugger variables.
+    Handle<Object> event_listener_;  // Global handle to listener.
+    Handle<Object> event_listener_data_;
+    bool compiling_natives_;  // Are we compiling natives?
+    bool is_loading_debugger_;  // Are we loading the debugger?
+    bool never_unload_debugger_;  // Can we unload the debugger?
+    v8::Debug::MessageHandler2 message_handler_;
+    bool debugger_unload_pending_;  // Was message handler cleared?
+    v8::Debug::HostDispatchHandler host_dispatch_handler_;
+    Mutex* dispatch_handler_access_;  // Mutex guarding dispatch handler.
+    v8::Debug::DebugMessageDispatchHandler debug_message_dispatch_handler_;
+    MessageDispatchHelperThread* message_dispatch_helper_thread_;
+    int host_dispatch_micros_;
+
+    DebuggerAgent* agent_;
+
+    LockingCommandMessageQueue command_queue_;
+    Semaphore* command_received_;  // Signaled for each command received.
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kDebuggerData));
+  }
 
   friend class EnterDebugger;
+  friend class Isolate;
 };
 
 
@@ -946,6 +988,7 @@ class MessageDispatchHelperThread: public Thread {
   Semaphore* const sem_;
   Mutex* const mutex_;
   bool already_signalled_;
+  Isolate* const isolate_;  // The isolate whose handler is called.
 
   DISALLOW_COPY_AND_ASSIGN(MessageDispatchHelperThread);
 };
@@ -206,13 +206,13 @@ Handle<Object> Execution::GetConstructorDelegate(Handle<Object> object) {
 
 
 // Static state for stack guards.
-StackGuard::ThreadLocal StackGuard::thread_local_;
+DEFINE_ISOLATE_COMPONENT(StackGuard)
 
 
 bool StackGuard::IsStackOverflow() {
   ExecutionAccess access;
-  return (thread_local_.jslimit_ != kInterruptLimit &&
-          thread_local_.climit_ != kInterruptLimit);
+  return (data()->thread_local_.jslimit_ != kInterruptLimit &&
+          data()->thread_local_.climit_ != kInterruptLimit);
 }
 
 
@@ -229,14 +229,14 @@ void StackGuard::SetStackLimit(uintptr_t limit) {
   // If the current limits are special (eg due to a pending interrupt) then
   // leave them alone.
   uintptr_t jslimit = SimulatorStack::JsLimitFromCLimit(limit);
-  if (thread_local_.jslimit_ == thread_local_.real_jslimit_) {
-    thread_local_.jslimit_ = jslimit;
+  if (data()->thread_local_.jslimit_ == data()->thread_local_.real_jslimit_) {
+    data()->thread_local_.jslimit_ = jslimit;
   }
-  if (thread_local_.climit_ == thread_local_.real_climit_) {
-    thread_local_.climit_ = limit;
+  if (data()->thread_local_.climit_ == data()->thread_local_.real_climit_) {
+    data()->thread_local_.climit_ = limit;
   }
-  thread_local_.real_climit_ = limit;
-  thread_local_.real_jslimit_ = jslimit;
+  data()->thread_local_.real_climit_ = limit;
+  data()->thread_local_.real_jslimit_ = jslimit;
 }
 
 
@@ -248,39 +248,39 @@ void StackGuard::DisableInterrupts() {
 
 bool StackGuard::IsInterrupted() {
   ExecutionAccess access;
-  return thread_local_.interrupt_flags_ & INTERRUPT;
+  return data()->thread_local_.interrupt_flags_ & INTERRUPT;
 }
 
 
 void StackGuard::Interrupt() {
   ExecutionAccess access;
-  thread_local_.interrupt_flags_ |= INTERRUPT;
+  data()->thread_local_.interrupt_flags_ |= INTERRUPT;
   set_interrupt_limits(access);
 }
 
 
 bool StackGuard::IsPreempted() {
   ExecutionAccess access;
-  return thread_local_.interrupt_flags_ & PREEMPT;
+  return data()->thread_local_.interrupt_flags_ & PREEMPT;
 }
 
 
 void StackGuard::Preempt() {
   ExecutionAccess access;
-  thread_local_.interrupt_flags_ |= PREEMPT;
+  data()->thread_local_.interrupt_flags_ |= PREEMPT;
   set_interrupt_limits(access);
 }
 
 
 bool StackGuard::IsTerminateExecution() {
   ExecutionAccess access;
-  return thread_local_.interrupt_flags_ & TERMINATE;
+  return data()->thread_local_.interrupt_flags_ & TERMINATE;
 }
 
 
 void StackGuard::TerminateExecution() {
   ExecutionAccess access;
-  thread_local_.interrupt_flags_ |= TERMINATE;
+  data()->thread_local_.interrupt_flags_ |= TERMINATE;
   set_interrupt_limits(access);
 }
 
@@ -288,27 +288,27 @@ void StackGuard::TerminateExecution() {
 #ifdef ENABLE_DEBUGGER_SUPPORT
 bool StackGuard::IsDebugBreak() {
   ExecutionAccess access;
-  return thread_local_.interrupt_flags_ & DEBUGBREAK;
+  return data()->thread_local_.interrupt_flags_ & DEBUGBREAK;
 }
 
 
 void StackGuard::DebugBreak() {
   ExecutionAccess access;
-  thread_local_.interrupt_flags_ |= DEBUGBREAK;
+  data()->thread_local_.interrupt_flags_ |= DEBUGBREAK;
   set_interrupt_limits(access);
 }
 
 
 bool StackGuard::IsDebugCommand() {
   ExecutionAccess access;
-  return thread_local_.interrupt_flags_ & DEBUGCOMMAND;
+  return data()->thread_local_.interrupt_flags_ & DEBUGCOMMAND;
 }
 
 
 void StackGuard::DebugCommand() {
   if (FLAG_debugger_auto_break) {
     ExecutionAccess access;
-    thread_local_.interrupt_flags_ |= DEBUGCOMMAND;
+    data()->thread_local_.interrupt_flags_ |= DEBUGCOMMAND;
     set_interrupt_limits(access);
   }
 }
@@ -316,7 +316,7 @@ void StackGuard::DebugCommand() {
 
 void StackGuard::Continue(InterruptFlag after_what) {
   ExecutionAccess access;
-  thread_local_.interrupt_flags_ &= ~static_cast<int>(after_what);
+  data()->thread_local_.interrupt_flags_ &= ~static_cast<int>(after_what);
   if (!should_postpone_interrupts(access) && !has_pending_interrupts(access)) {
     reset_limits(access);
   }
@@ -330,16 +330,18 @@ int StackGuard::ArchiveSpacePerThread() {
 
 char* StackGuard::ArchiveStackGuard(char* to) {
   ExecutionAccess access;
-  memcpy(to, reinterpret_cast<char*>(&thread_local_), sizeof(ThreadLocal));
+  ThreadLocal* thread_local = &data()->thread_local_;
+  memcpy(to, reinterpret_cast<char*>(thread_local), sizeof(ThreadLocal));
   ThreadLocal blank;
-  thread_local_ = blank;
+  *thread_local = blank;
   return to + sizeof(ThreadLocal);
 }
 
 
 char* StackGuard::RestoreStackGuard(char* from) {
   ExecutionAccess access;
-  memcpy(reinterpret_cast<char*>(&thread_local_), from, sizeof(ThreadLocal));
+  memcpy(reinterpret_cast<char*>(&data()->thread_local_), from,
+         sizeof(ThreadLocal));
   Heap::SetStackLimits();
   return from + sizeof(ThreadLocal);
 }
@@ -352,7 +354,7 @@ static internal::Thread::LocalStorageKey stack_limit_key =
 void StackGuard::FreeThreadResources() {
   Thread::SetThreadLocal(
       stack_limit_key,
-      reinterpret_cast<void*>(thread_local_.real_climit_));
+      reinterpret_cast<void*>(data()->thread_local_.real_climit_));
 }
 
 
@@ -387,12 +389,12 @@ void StackGuard::ThreadLocal::Initialize() {
 
 
 void StackGuard::ClearThread(const ExecutionAccess& lock) {
-  thread_local_.Clear();
+  data()->thread_local_.Clear();
 }
 
 
 void StackGuard::InitThread(const ExecutionAccess& lock) {
-  thread_local_.Initialize();
+  data()->thread_local_.Initialize();
   void* stored_limit = Thread::GetThreadLocal(stack_limit_key);
   // You should hold the ExecutionAccess lock when you call this.
   if (stored_limit != NULL) {
@@ -182,19 +182,19 @@ class StackGuard : public AllStatic {
   // thread.  There are no locks protecting this, but it is assumed that you
   // have the global V8 lock if you are using multiple V8 threads.
   static uintptr_t climit() {
-    return thread_local_.climit_;
+    return data()->thread_local_.climit_;
   }
   static uintptr_t jslimit() {
-    return thread_local_.jslimit_;
+    return data()->thread_local_.jslimit_;
   }
   static uintptr_t real_jslimit() {
-    return thread_local_.real_jslimit_;
+    return data()->thread_local_.real_jslimit_;
   }
   static Address address_of_jslimit() {
-    return reinterpret_cast<Address>(&thread_local_.jslimit_);
+    return reinterpret_cast<Address>(&data()->thread_local_.jslimit_);
   }
   static Address address_of_real_jslimit() {
-    return reinterpret_cast<Address>(&thread_local_.real_jslimit_);
+    return reinterpret_cast<Address>(&data()->thread_local_.real_jslimit_);
   }
 
  private:
@@ -203,28 +203,28 @@ class StackGuard : public AllStatic {
     // Sanity check: We shouldn't be asking about pending interrupts
     // unless we're not postponing them anymore.
     ASSERT(!should_postpone_interrupts(lock));
-    return thread_local_.interrupt_flags_ != 0;
+    return data()->thread_local_.interrupt_flags_ != 0;
   }
 
   // You should hold the ExecutionAccess lock when calling this method.
   static bool should_postpone_interrupts(const ExecutionAccess& lock) {
-    return thread_local_.postpone_interrupts_nesting_ > 0;
+    return data()->thread_local_.postpone_interrupts_nesting_ > 0;
   }
 
   // You should hold the ExecutionAccess lock when calling this method.
   static void set_interrupt_limits(const ExecutionAccess& lock) {
     // Ignore attempts to interrupt when interrupts are postponed.
     if (should_postpone_interrupts(lock)) return;
-    thread_local_.jslimit_ = kInterruptLimit;
-    thread_local_.climit_ = kInterruptLimit;
+    data()->thread_local_.jslimit_ = kInterruptLimit;
+    data()->thread_local_.climit_ = kInterruptLimit;
     Heap::SetStackLimits();
   }
 
   // Reset limits to actual values. For example after handling interrupt.
   // You should hold the ExecutionAccess lock when calling this method.
   static void reset_limits(const ExecutionAccess& lock) {
-    thread_local_.jslimit_ = thread_local_.real_jslimit_;
-    thread_local_.climit_ = thread_local_.real_climit_;
+    data()->thread_local_.jslimit_ = data()->thread_local_.real_jslimit_;
+    data()->thread_local_.climit_ = data()->thread_local_.real_climit_;
     Heap::SetStackLimits();
   }
 
@@ -244,7 +244,16 @@ class StackGuard : public AllStatic {
 
   class ThreadLocal {
    public:
-    ThreadLocal() { Clear(); }
+    // Unlike Clear, the constructor does not touch the heap, which may not
+    // exist yet.
+    ThreadLocal()
+        : real_jslimit_(kIllegalLimit),
+          jslimit_(kIllegalLimit),
+          real_climit_(kIllegalLimit),
+          climit_(kIllegalLimit),
+          nesting_(0),
+          postpone_interrupts_nesting_(0),
+          interrupt_flags_(0) { }
     // You should hold the ExecutionAccess lock when you call Initialize or
     // Clear.
     void Initialize();
@@ -269,8 +278,17 @@ class StackGuard : public AllStatic {
     int interrupt_flags_;
   };
 
-  static ThreadLocal thread_local_;
+  class Data {
+   public:
+    ThreadLocal thread_local_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kStackGuardData));
+  }
 
+  friend class Isolate;
   friend class StackLimitCheck;
   friend class PostponeInterruptsScope;
 };
@@ -297,12 +315,12 @@ class StackLimitCheck BASE_EMBEDDED {
 class PostponeInterruptsScope BASE_EMBEDDED {
  public:
   PostponeInterruptsScope() {
-    StackGuard::thread_local_.postpone_interrupts_nesting_++;
+    StackGuard::data()->thread_local_.postpone_interrupts_nesting_++;
     StackGuard::DisableInterrupts();
   }
 
   ~PostponeInterruptsScope() {
-    if (--StackGuard::thread_local_.postpone_interrupts_nesting_ == 0) {
+    if (--StackGuard::data()->thread_local_.postpone_interrupts_nesting_ == 0) {
       StackGuard::EnableInterrupts();
     }
   }
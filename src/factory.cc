@@ -193,6 +193,7 @@ Handle<Script> Factory::NewScript(Handle<String> source) {
   script->set_line_ends(Heap::undefined_value());
   script->set_eval_from_shared(Heap::undefined_value());
   script->set_eval_from_instructions_offset(Smi::FromInt(0));
+  script->set_preparse_data(Heap::undefined_value());
 
   return script;
 }
@@ -957,6 +958,9 @@ void Factory::SetRegExpIrregexpData(Handle<JSRegExp> regexp,
   store->set(JSRegExp::kIrregexpMaxRegisterCountIndex, Smi::FromInt(0));
   store->set(JSRegExp::kIrregexpCaptureCountIndex,
              Smi::FromInt(capture_count));
+  store->set(JSRegExp::kIrregexpPrefixIndex, Heap::undefined_value());
+  store->set(JSRegExp::kIrregexpNfaCodeIndex, Heap::the_hole_value());
+  store->set(JSRegExp::kIrregexpBacktrackLimitIndex, Smi::FromInt(0));
   regexp->set_data(*store);
 }
 
@@ -326,7 +326,7 @@ class Factory : public AllStatic {
 #define ROOT_ACCESSOR(type, name, camel_name)                                  \
   static inline Handle<type> name() {                                          \
     return Handle<type>(BitCast<type**, Object**>(                             \
-        &Heap::roots_[Heap::k##camel_name##RootIndex]));                       \
+        &Heap::data()->roots_[Heap::k##camel_name##RootIndex]));               \
   }
   ROOT_LIST(ROOT_ACCESSOR)
 #undef ROOT_ACCESSOR_ACCESSOR
@@ -334,13 +334,13 @@ class Factory : public AllStatic {
 #define SYMBOL_ACCESSOR(name, str) \
   static inline Handle<String> name() {                                        \
     return Handle<String>(BitCast<String**, Object**>(                         \
-        &Heap::roots_[Heap::k##name##RootIndex]));                             \
+        &Heap::data()->roots_[Heap::k##name##RootIndex]));                     \
   }
   SYMBOL_LIST(SYMBOL_ACCESSOR)
 #undef SYMBOL_ACCESSOR
 
   static Handle<String> hidden_symbol() {
-    return Handle<String>(&Heap::hidden_symbol_);
+    return Handle<String>(&Heap::data()->hidden_symbol_);
   }
 
   static Handle<SharedFunctionInfo> NewSharedFunctionInfo(
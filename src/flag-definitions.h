@@ -193,6 +193,15 @@ DEFINE_bool(collect_maps, true,
             "garbage collect maps from which no objects can be reached")
 DEFINE_bool(flush_code, false,
             "flush code that we expect not to use again before full gc")
+DEFINE_int(max_code_age, 5,
+           "number of full gcs code can survive without being found on a "
+           "stack before it is flushed")
+DEFINE_bool(pretenuring, true,
+            "allocate objects in old space when most objects with the same "
+            "map survive scavenges")
+DEFINE_bool(parallel_scavenge, false,
+            "Use several threads to scan dirty regions of the old generation "
+            "during scavenges.")
 
 // v8.cc
 DEFINE_bool(use_idle_notification, true,
@@ -212,6 +221,13 @@ DEFINE_bool(cleanup_ics_at_gc, true,
             "Flush inline caches prior to mark compact collection.")
 DEFINE_bool(cleanup_caches_in_maps_at_gc, true,
             "Flush code caches in maps during mark compact cycle.")
+DEFINE_bool(parallel_marking, false,
+            "Use several threads to mark live objects during full GCs.")
+DEFINE_bool(parallel_sweeping, false,
+            "Use several threads to sweep pages during full GCs.")
+DEFINE_int(parallel_gc_threads, 4,
+           "Number of threads, including the main thread, used for "
+           "parallel marking, sweeping and scavenging.")
 DEFINE_int(random_seed, 0,
            "Default seed for initializing random generator "
            "(0, the default, means to use system random).")
@@ -230,6 +246,9 @@ DEFINE_int(max_map_space_pages, MapSpace::kMaxMapPageIndex - 1,
 // mksnapshot.cc
 DEFINE_bool(h, false, "print this message")
 DEFINE_bool(new_snapshot, true, "use new snapshot implementation")
+DEFINE_string(snapshot_regexps, NULL,
+              "file with regexps to compile into the snapshot, one "
+              "/pattern/flags per line")
 
 // parser.cc
 DEFINE_bool(allow_natives_syntax, false, "allow natives syntax")
@@ -258,6 +277,14 @@ DEFINE_bool(preemption, false,
 DEFINE_bool(trace_regexps, false, "trace regexp execution")
 DEFINE_bool(regexp_optimization, true, "generate optimized regexp code")
 DEFINE_bool(regexp_entry_native, true, "use native code to enter regexp")
+DEFINE_bool(regexp_prefix_scan, true,
+            "search for the literal prefix of a regexp before matching")
+DEFINE_int(regexp_backtrack_limit, 0,
+           "give up matching a regexp after this many backtracks "
+           "(0 for no limit)")
+DEFINE_bool(regexp_nfa_fallback, true,
+            "match regexps that hit the backtrack limit in linear time "
+            "if possible")
 
 // Testing flags test/cctest/test-{flags,api,serialization}.cc
 DEFINE_bool(testing_bool_flag, true, "testing_bool_flag")
@@ -33,9 +33,11 @@
 namespace v8 {
 namespace internal {
 
+DEFINE_ISOLATE_COMPONENT(FrameElement)
+
+
 FrameElement::ZoneObjectList* FrameElement::ConstantList() {
-  static ZoneObjectList list(10);
-  return &list;
+  return &data()->constant_list_;
 }
 
 
@@ -265,7 +265,20 @@ class FrameElement BASE_EMBEDDED {
   class TypeInfoField: public BitField<int, 6, 6> {};
   class DataField: public BitField<uint32_t, 12, 32 - 12> {};
 
+  class Data {
+   public:
+    Data() : constant_list_(0) { }
+
+    ZoneObjectList constant_list_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kFrameElementData));
+  }
+
   friend class VirtualFrame;
+  friend class Isolate;
 };
 
 } }  // namespace v8::internal
@@ -66,9 +66,9 @@ class GlobalHandles::Node : public Malloced {
 
   void Destroy() {
     if (state_ == WEAK || IsNearDeath()) {
-      GlobalHandles::number_of_weak_handles_--;
+      GlobalHandles::data()->number_of_weak_handles_--;
       if (object_->IsJSGlobalObject()) {
-        GlobalHandles::number_of_global_object_weak_handles_--;
+        GlobalHandles::data()->number_of_global_object_weak_handles_--;
       }
     }
     state_ = DESTROYED;
@@ -103,9 +103,9 @@ class GlobalHandles::Node : public Malloced {
     LOG(HandleEvent("GlobalHandle::MakeWeak", handle().location()));
     ASSERT(state_ != DESTROYED);
     if (state_ != WEAK && !IsNearDeath()) {
-      GlobalHandles::number_of_weak_handles_++;
+      GlobalHandles::data()->number_of_weak_handles_++;
       if (object_->IsJSGlobalObject()) {
-        GlobalHandles::number_of_global_object_weak_handles_++;
+        GlobalHandles::data()->number_of_global_object_weak_handles_++;
       }
     }
     state_ = WEAK;
@@ -117,9 +117,9 @@ class GlobalHandles::Node : public Malloced {
     LOG(HandleEvent("GlobalHandle::ClearWeakness", handle().location()));
     ASSERT(state_ != DESTROYED);
     if (state_ == WEAK || IsNearDeath()) {
-      GlobalHandles::number_of_weak_handles_--;
+      GlobalHandles::data()->number_of_weak_handles_--;
       if (object_->IsJSGlobalObject()) {
-        GlobalHandles::number_of_global_object_weak_handles_--;
+        GlobalHandles::data()->number_of_global_object_weak_handles_--;
       }
     }
     state_ = NORMAL;
@@ -213,7 +213,7 @@ class GlobalHandles::Node : public Malloced {
 };
 
 
-class GlobalHandles::Pool BASE_EMBEDDED {
+class GlobalHandles::Pool : public Malloced {
   public:
     Pool() {
       current_ = new Chunk();
@@ -265,7 +265,19 @@ class GlobalHandles::Pool BASE_EMBEDDED {
 };
 
 
-static GlobalHandles::Pool pool_;
+GlobalHandles::Data::Data() : object_groups_(4), pool_(new Pool()) {
+}
+
+
+GlobalHandles::Data::~Data() {
+  for (int i = 0; i < object_groups_.length(); i++) {
+    delete object_groups_[i];
+  }
+  delete pool_;
+}
+
+
+DEFINE_ISOLATE_COMPONENT(GlobalHandles)
 
 
 Handle<Object> GlobalHandles::Create(Object* value) {
@@ -283,7 +295,7 @@ Handle<Object> GlobalHandles::Create(Object* value) {
     set_head(result);
   } else {
     // Allocate a new node.
-    result = pool_.Allocate();
+    result = data()->pool_->Allocate();
     result->set_next(head());
     set_head(result);
   }
@@ -328,7 +340,7 @@ bool GlobalHandles::IsWeak(Object** location) {
 void GlobalHandles::IterateWeakRoots(ObjectVisitor* v) {
   // Traversal of GC roots in the global handle list that are marked as
   // WEAK or PENDING.
-  for (Node* current = head_; current != NULL; current = current->next()) {
+  for (Node* current = head(); current != NULL; current = current->next()) {
     if (current->state_ == Node::WEAK
       || current->state_ == Node::PENDING
       || current->state_ == Node::NEAR_DEATH) {
@@ -340,7 +352,7 @@ void GlobalHandles::IterateWeakRoots(ObjectVisitor* v) {
 
 void GlobalHandles::IterateWeakRoots(WeakReferenceGuest f,
                                      WeakReferenceCallback callback) {
-  for (Node* current = head_; current != NULL; current = current->next()) {
+  for (Node* current = head(); current != NULL; current = current->next()) {
     if (current->IsWeak() && current->callback() == callback) {
       f(current->object_, current->parameter());
     }
@@ -349,7 +361,7 @@ void GlobalHandles::IterateWeakRoots(WeakReferenceGuest f,
 
 
 void GlobalHandles::IdentifyWeakHandles(WeakSlotCallback f) {
-  for (Node* current = head_; current != NULL; current = current->next()) {
+  for (Node* current = head(); current != NULL; current = current->next()) {
     if (current->state_ == Node::WEAK) {
       if (f(&current->object_)) {
         current->state_ = Node::PENDING;
@@ -360,19 +372,20 @@ void GlobalHandles::IdentifyWeakHandles(WeakSlotCallback f) {
 }
 
 
-int post_gc_processing_count = 0;
-
 void GlobalHandles::PostGarbageCollectionProcessing() {
   // Process weak global handle callbacks. This must be done after the
   // GC is completely done, because the callbacks may invoke arbitrary
   // API functions.
   // At the same time deallocate all DESTROYED nodes.
   ASSERT(Heap::gc_state() == Heap::NOT_IN_GC);
-  const int initial_post_gc_processing_count = ++post_gc_processing_count;
-  Node** p = &head_;
+  Data* data = GlobalHandles::data();
+  const int initial_post_gc_processing_count =
+      ++data->post_gc_processing_count_;
+  Node** p = &data->head_;
   while (*p != NULL) {
     if ((*p)->PostGarbageCollectionProcessing()) {
-      if (initial_post_gc_processing_count != post_gc_processing_count) {
+      if (initial_post_gc_processing_count !=
+          data->post_gc_processing_count_) {
         // Weak callback triggered another GC and another round of
         // PostGarbageCollection processing.  The current node might
         // have been deleted in that round, so we need to bail out (or
@@ -402,7 +415,7 @@ void GlobalHandles::PostGarbageCollectionProcessing() {
 
 void GlobalHandles::IterateStrongRoots(ObjectVisitor* v) {
   // Traversal of global handles marked as NORMAL.
-  for (Node* current = head_; current != NULL; current = current->next()) {
+  for (Node* current = head(); current != NULL; current = current->next()) {
     if (current->state_ == Node::NORMAL) {
       v->VisitPointer(&current->object_);
     }
@@ -411,7 +424,7 @@ void GlobalHandles::IterateStrongRoots(ObjectVisitor* v) {
 
 
 void GlobalHandles::IterateAllRoots(ObjectVisitor* v) {
-  for (Node* current = head_; current != NULL; current = current->next()) {
+  for (Node* current = head(); current != NULL; current = current->next()) {
     if (current->state_ != Node::DESTROYED) {
       v->VisitPointer(&current->object_);
     }
@@ -424,24 +437,17 @@ void GlobalHandles::TearDown() {
   set_head(NULL);
   set_first_free(NULL);
   set_first_deallocated(NULL);
-  pool_.Release();
+  data()->pool_->Release();
 }
 
 
-int GlobalHandles::number_of_weak_handles_ = 0;
-int GlobalHandles::number_of_global_object_weak_handles_ = 0;
-
-GlobalHandles::Node* GlobalHandles::head_ = NULL;
-GlobalHandles::Node* GlobalHandles::first_free_ = NULL;
-GlobalHandles::Node* GlobalHandles::first_deallocated_ = NULL;
-
 void GlobalHandles::RecordStats(HeapStats* stats) {
   *stats->global_handle_count = 0;
   *stats->weak_global_handle_count = 0;
   *stats->pending_global_handle_count = 0;
   *stats->near_death_global_handle_count = 0;
   *stats->destroyed_global_handle_count = 0;
-  for (Node* current = head_; current != NULL; current = current->next()) {
+  for (Node* current = head(); current != NULL; current = current->next()) {
     *stats->global_handle_count += 1;
     if (current->state_ == Node::WEAK) {
       *stats->weak_global_handle_count += 1;
@@ -464,7 +470,7 @@ void GlobalHandles::PrintStats() {
   int near_death = 0;
   int destroyed = 0;
 
-  for (Node* current = head_; current != NULL; current = current->next()) {
+  for (Node* current = head(); current != NULL; current = current->next()) {
     total++;
     if (current->state_ == Node::WEAK) weak++;
     if (current->state_ == Node::PENDING) pending++;
@@ -483,7 +489,7 @@ void GlobalHandles::PrintStats() {
 
 void GlobalHandles::Print() {
   PrintF("Global handles:\n");
-  for (Node* current = head_; current != NULL; current = current->next()) {
+  for (Node* current = head(); current != NULL; current = current->next()) {
     PrintF("  handle %p to %p (weak=%d)\n", current->handle().location(),
            *current->handle(), current->state_ == Node::WEAK);
   }
@@ -492,9 +498,7 @@ void GlobalHandles::Print() {
 #endif
 
 List<ObjectGroup*>* GlobalHandles::ObjectGroups() {
-  // Lazily initialize the list to avoid startup time static constructors.
-  static List<ObjectGroup*> groups(4);
-  return &groups;
+  return &data()->object_groups_;
 }
 
 void GlobalHandles::AddGroup(Object*** handles, size_t length) {
@@ -107,8 +107,8 @@ class Handle {
 // for which the handle scope has been deleted is undefined.
 class HandleScope {
  public:
-  HandleScope() : previous_(current_) {
-    current_.extensions = 0;
+  HandleScope() : previous_(data()->current_) {
+    data()->current_.extensions = 0;
   }
 
   ~HandleScope() {
@@ -121,12 +121,13 @@ class HandleScope {
   // Creates a new handle with the given value.
   template <typename T>
   static inline T** CreateHandle(T* value) {
-    internal::Object** cur = current_.next;
-    if (cur == current_.limit) cur = Extend();
+    v8::ImplementationUtilities::HandleScopeData* current = &data()->current_;
+    internal::Object** cur = current->next;
+    if (cur == current->limit) cur = Extend();
     // Update the current next field, set the value in the created
     // handle, and return the result.
-    ASSERT(cur < current_.limit);
-    current_.next = cur + 1;
+    ASSERT(cur < current->limit);
+    current->next = cur + 1;
 
     T** result = reinterpret_cast<T**>(cur);
     *result = value;
@@ -147,26 +148,43 @@ class HandleScope {
   void* operator new(size_t size);
   void operator delete(void* size_t);
 
-  static v8::ImplementationUtilities::HandleScopeData current_;
+  class Data {
+   public:
+    Data() {
+      current_.extensions = -1;
+      current_.next = NULL;
+      current_.limit = NULL;
+    }
+
+    // The handle scope data of the innermost handle scope.
+    v8::ImplementationUtilities::HandleScopeData current_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kHandleScopeData));
+  }
+
   const v8::ImplementationUtilities::HandleScopeData previous_;
 
   // Pushes a fresh handle scope to be used when allocating new handles.
   static void Enter(
       v8::ImplementationUtilities::HandleScopeData* previous) {
-    *previous = current_;
-    current_.extensions = 0;
+    *previous = data()->current_;
+    data()->current_.extensions = 0;
   }
 
   // Re-establishes the previous scope state. Should be called only
   // once, and only for the current scope.
   static void Leave(
       const v8::ImplementationUtilities::HandleScopeData* previous) {
-    if (current_.extensions > 0) {
+    v8::ImplementationUtilities::HandleScopeData* current = &data()->current_;
+    if (current->extensions > 0) {
       DeleteExtensions();
     }
-    current_ = *previous;
+    *current = *previous;
 #ifdef DEBUG
-    ZapRange(current_.next, current_.limit);
+    ZapRange(current->next, current->limit);
 #endif
   }
 
@@ -178,6 +196,7 @@ class HandleScope {
 
   friend class v8::HandleScope;
   friend class v8::ImplementationUtilities;
+  friend class Isolate;
 };
 
 
@@ -195,6 +214,10 @@ void TransformToFastProperties(Handle<JSObject> object,
                                int unused_property_fields);
 void FlattenString(Handle<String> str);
 
+// Flattens a string and returns the underlying external or sequential
+// string.
+Handle<String> FlattenGetString(Handle<String> str);
+
 Handle<Object> SetProperty(Handle<JSObject> object,
                            Handle<String> key,
                            Handle<Object> value,
@@ -34,6 +34,14 @@
 namespace v8 {
 namespace internal {
 
+void PromotionQueue::insert(HeapObject* object, Map* map) {
+  *(--rear_) = object;
+  *(--rear_) = map;
+  // Assert no overflow into live objects.
+  ASSERT(reinterpret_cast<Address>(rear_) >= Heap::new_space()->top());
+}
+
+
 int Heap::MaxObjectSizeInPagedSpace() {
   return Page::kMaxHeapObjectSize;
 }
@@ -51,15 +59,16 @@ Object* Heap::AllocateSymbol(Vector<const char> str,
 Object* Heap::AllocateRaw(int size_in_bytes,
                           AllocationSpace space,
                           AllocationSpace retry_space) {
-  ASSERT(allocation_allowed_ && gc_state_ == NOT_IN_GC);
+  Data* data = Heap::data();
+  ASSERT(data->allocation_allowed_ && data->gc_state_ == NOT_IN_GC);
   ASSERT(space != NEW_SPACE ||
          retry_space == OLD_POINTER_SPACE ||
          retry_space == OLD_DATA_SPACE ||
          retry_space == LO_SPACE);
 #ifdef DEBUG
   if (FLAG_gc_interval >= 0 &&
-      !disallow_allocation_failure_ &&
-      Heap::allocation_timeout_-- <= 0) {
+      !data->disallow_allocation_failure_ &&
+      data->allocation_timeout_-- <= 0) {
     return Failure::RetryAfterGC(size_in_bytes, space);
   }
   Counters::objs_since_last_full.Increment();
@@ -67,7 +76,7 @@ Object* Heap::AllocateRaw(int size_in_bytes,
 #endif
   Object* result;
   if (NEW_SPACE == space) {
-    result = new_space_.AllocateRaw(size_in_bytes);
+    result = data->new_space_.AllocateRaw(size_in_bytes);
     if (always_allocate() && result->IsFailure()) {
       space = retry_space;
     } else {
@@ -76,20 +85,20 @@ Object* Heap::AllocateRaw(int size_in_bytes,
   }
 
   if (OLD_POINTER_SPACE == space) {
-    result = old_pointer_space_->AllocateRaw(size_in_bytes);
+    result = data->old_pointer_space_->AllocateRaw(size_in_bytes);
   } else if (OLD_DATA_SPACE == space) {
-    result = old_data_space_->AllocateRaw(size_in_bytes);
+    result = data->old_data_space_->AllocateRaw(size_in_bytes);
   } else if (CODE_SPACE == space) {
-    result = code_space_->AllocateRaw(size_in_bytes);
+    result = data->code_space_->AllocateRaw(size_in_bytes);
   } else if (LO_SPACE == space) {
-    result = lo_space_->AllocateRaw(size_in_bytes);
+    result = data->lo_space_->AllocateRaw(size_in_bytes);
   } else if (CELL_SPACE == space) {
-    result = cell_space_->AllocateRaw(size_in_bytes);
+    result = data->cell_space_->AllocateRaw(size_in_bytes);
   } else {
     ASSERT(MAP_SPACE == space);
-    result = map_space_->AllocateRaw(size_in_bytes);
+    result = data->map_space_->AllocateRaw(size_in_bytes);
   }
-  if (result->IsFailure()) old_gen_exhausted_ = true;
+  if (result->IsFailure()) data->old_gen_exhausted_ = true;
   return result;
 }
 
@@ -133,8 +142,9 @@ Object* Heap::AllocateRawMap() {
   Counters::objs_since_last_full.Increment();
   Counters::objs_since_last_young.Increment();
 #endif
-  Object* result = map_space_->AllocateRaw(Map::kSize);
-  if (result->IsFailure()) old_gen_exhausted_ = true;
+  Data* data = Heap::data();
+  Object* result = data->map_space_->AllocateRaw(Map::kSize);
+  if (result->IsFailure()) data->old_gen_exhausted_ = true;
 #ifdef DEBUG
   if (!result->IsFailure()) {
     // Maps have their own alignment.
@@ -151,28 +161,29 @@ Object* Heap::AllocateRawCell() {
   Counters::objs_since_last_full.Increment();
   Counters::objs_since_last_young.Increment();
 #endif
-  Object* result = cell_space_->AllocateRaw(JSGlobalPropertyCell::kSize);
-  if (result->IsFailure()) old_gen_exhausted_ = true;
+  Data* data = Heap::data();
+  Object* result = data->cell_space_->AllocateRaw(JSGlobalPropertyCell::kSize);
+  if (result->IsFailure()) data->old_gen_exhausted_ = true;
   return result;
 }
 
 
 bool Heap::InNewSpace(Object* object) {
-  bool result = new_space_.Contains(object);
+  bool result = data()->new_space_.Contains(object);
   ASSERT(!result ||                  // Either not in new space
-         gc_state_ != NOT_IN_GC ||   // ... or in the middle of GC
+         gc_state() != NOT_IN_GC ||  // ... or in the middle of GC
          InToSpace(object));         // ... or in to-space (where we allocate).
   return result;
 }
 
 
 bool Heap::InFromSpace(Object* object) {
-  return new_space_.FromSpaceContains(object);
+  return data()->new_space_.FromSpaceContains(object);
 }
 
 
 bool Heap::InToSpace(Object* object) {
-  return new_space_.ToSpaceContains(object);
+  return data()->new_space_.ToSpaceContains(object);
 }
 
 
@@ -180,22 +191,23 @@ bool Heap::ShouldBePromoted(Address old_address, int object_size) {
   // An object should be promoted if:
   // - the object has survived a scavenge operation or
   // - to space is already 25% full.
-  return old_address < new_space_.age_mark()
-      || (new_space_.Size() + object_size) >= (new_space_.Capacity() >> 2);
+  NewSpace* new_space = &data()->new_space_;
+  return old_address < new_space->age_mark()
+      || (new_space->Size() + object_size) >= (new_space->Capacity() >> 2);
 }
 
 
 void Heap::RecordWrite(Address address, int offset) {
-  if (new_space_.Contains(address)) return;
-  ASSERT(!new_space_.FromSpaceContains(address));
+  if (data()->new_space_.Contains(address)) return;
+  ASSERT(!data()->new_space_.FromSpaceContains(address));
   SLOW_ASSERT(Contains(address + offset));
   Page::FromAddress(address)->MarkRegionDirty(address + offset);
 }
 
 
 void Heap::RecordWrites(Address address, int start, int len) {
-  if (new_space_.Contains(address)) return;
-  ASSERT(!new_space_.FromSpaceContains(address));
+  if (data()->new_space_.Contains(address)) return;
+  ASSERT(!data()->new_space_.FromSpaceContains(address));
   Page* page = Page::FromAddress(address);
   page->SetRegionMarks(page->GetRegionMarks() |
       page->GetRegionMaskForSpan(address + start, len * kPointerSize));
@@ -206,8 +218,8 @@ OldSpace* Heap::TargetSpace(HeapObject* object) {
   InstanceType type = object->map()->instance_type();
   AllocationSpace space = TargetSpaceId(type);
   return (space == OLD_POINTER_SPACE)
-      ? old_pointer_space_
-      : old_data_space_;
+      ? data()->old_pointer_space_
+      : data()->old_data_space_;
 }
 
 
@@ -224,10 +236,11 @@ AllocationSpace Heap::TargetSpaceId(InstanceType type) {
   ASSERT(type != JS_GLOBAL_PROPERTY_CELL_TYPE);
 
   if (type < FIRST_NONSTRING_TYPE) {
-    // There are three string representations: sequential strings, cons
-    // strings, and external strings.  Only cons strings contain
-    // non-map-word pointers to heap objects.
-    return ((type & kStringRepresentationMask) == kConsStringTag)
+    // There are four string representations: sequential strings, cons
+    // strings, sliced strings and external strings.  Only cons and sliced
+    // strings contain non-map-word pointers to heap objects.
+    uint32_t tag = type & kStringRepresentationMask;
+    return (tag == kConsStringTag || tag == kSlicedStringTag)
         ? OLD_POINTER_SPACE
         : OLD_DATA_SPACE;
   } else {
@@ -333,11 +346,11 @@ Object* Heap::PrepareForCompare(String* str) {
   const int length = str->length();
   Object* obj = str->TryFlatten();
   if (length <= kMaxAlwaysFlattenLength ||
-      unflattened_strings_length_ >= kFlattenLongThreshold) {
+      data()->unflattened_strings_length_ >= kFlattenLongThreshold) {
     return obj;
   }
   if (obj->IsFailure()) {
-    unflattened_strings_length_ += length;
+    data()->unflattened_strings_length_ += length;
   }
   return str;
 }
@@ -345,31 +358,31 @@ Object* Heap::PrepareForCompare(String* str) {
 
 int Heap::AdjustAmountOfExternalAllocatedMemory(int change_in_bytes) {
   ASSERT(HasBeenSetup());
-  int amount = amount_of_external_allocated_memory_ + change_in_bytes;
+  int amount = data()->amount_of_external_allocated_memory_ + change_in_bytes;
   if (change_in_bytes >= 0) {
     // Avoid overflow.
-    if (amount > amount_of_external_allocated_memory_) {
-      amount_of_external_allocated_memory_ = amount;
+    if (amount > data()->amount_of_external_allocated_memory_) {
+      data()->amount_of_external_allocated_memory_ = amount;
     }
     int amount_since_last_global_gc =
-        amount_of_external_allocated_memory_ -
-        amount_of_external_allocated_memory_at_last_global_gc_;
-    if (amount_since_last_global_gc > external_allocation_limit_) {
+        data()->amount_of_external_allocated_memory_ -
+        data()->amount_of_external_allocated_memory_at_last_global_gc_;
+    if (amount_since_last_global_gc > data()->external_allocation_limit_) {
       CollectAllGarbage(false);
     }
   } else {
     // Avoid underflow.
     if (amount >= 0) {
-      amount_of_external_allocated_memory_ = amount;
+      data()->amount_of_external_allocated_memory_ = amount;
     }
   }
-  ASSERT(amount_of_external_allocated_memory_ >= 0);
-  return amount_of_external_allocated_memory_;
+  ASSERT(data()->amount_of_external_allocated_memory_ >= 0);
+  return data()->amount_of_external_allocated_memory_;
 }
 
 
 void Heap::SetLastScriptId(Object* last_script_id) {
-  roots_[kLastScriptIdRootIndex] = last_script_id;
+  data()->roots_[kLastScriptIdRootIndex] = last_script_id;
 }
 
 
@@ -430,8 +443,8 @@ void Heap::SetLastScriptId(Object* last_script_id) {
 #ifdef DEBUG
 
 inline bool Heap::allow_allocation(bool new_state) {
-  bool old = allocation_allowed_;
-  allocation_allowed_ = new_state;
+  bool old = data()->allocation_allowed_;
+  data()->allocation_allowed_ = new_state;
   return old;
 }
 
@@ -441,21 +454,21 @@ inline bool Heap::allow_allocation(bool new_state) {
 void ExternalStringTable::AddString(String* string) {
   ASSERT(string->IsExternalString());
   if (Heap::InNewSpace(string)) {
-    new_space_strings_.Add(string);
+    data()->new_space_strings_.Add(string);
   } else {
-    old_space_strings_.Add(string);
+    data()->old_space_strings_.Add(string);
   }
 }
 
 
 void ExternalStringTable::Iterate(ObjectVisitor* v) {
-  if (!new_space_strings_.is_empty()) {
-    Object** start = &new_space_strings_[0];
-    v->VisitPointers(start, start + new_space_strings_.length());
+  if (!data()->new_space_strings_.is_empty()) {
+    Object** start = &data()->new_space_strings_[0];
+    v->VisitPointers(start, start + data()->new_space_strings_.length());
   }
-  if (!old_space_strings_.is_empty()) {
-    Object** start = &old_space_strings_[0];
-    v->VisitPointers(start, start + old_space_strings_.length());
+  if (!data()->old_space_strings_.is_empty()) {
+    Object** start = &data()->old_space_strings_[0];
+    v->VisitPointers(start, start + data()->old_space_strings_.length());
   }
 }
 
@@ -464,13 +477,13 @@ void ExternalStringTable::Iterate(ObjectVisitor* v) {
 // mode.
 void ExternalStringTable::Verify() {
 #ifdef DEBUG
-  for (int i = 0; i < new_space_strings_.length(); ++i) {
-    ASSERT(Heap::InNewSpace(new_space_strings_[i]));
-    ASSERT(new_space_strings_[i] != Heap::raw_unchecked_null_value());
+  for (int i = 0; i < data()->new_space_strings_.length(); ++i) {
+    ASSERT(Heap::InNewSpace(data()->new_space_strings_[i]));
+    ASSERT(data()->new_space_strings_[i] != Heap::raw_unchecked_null_value());
   }
-  for (int i = 0; i < old_space_strings_.length(); ++i) {
-    ASSERT(!Heap::InNewSpace(old_space_strings_[i]));
-    ASSERT(old_space_strings_[i] != Heap::raw_unchecked_null_value());
+  for (int i = 0; i < data()->old_space_strings_.length(); ++i) {
+    ASSERT(!Heap::InNewSpace(data()->old_space_strings_[i]));
+    ASSERT(data()->old_space_strings_[i] != Heap::raw_unchecked_null_value());
   }
 #endif
 }
@@ -479,12 +492,12 @@ void ExternalStringTable::Verify() {
 void ExternalStringTable::AddOldString(String* string) {
   ASSERT(string->IsExternalString());
   ASSERT(!Heap::InNewSpace(string));
-  old_space_strings_.Add(string);
+  data()->old_space_strings_.Add(string);
 }
 
 
 void ExternalStringTable::ShrinkNewStrings(int position) {
-  new_space_strings_.Rewind(position);
+  data()->new_space_strings_.Rewind(position);
   Verify();
 }
 
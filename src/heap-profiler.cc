@@ -383,6 +383,12 @@ HeapSnapshot* HeapProfiler::FindSnapshot(unsigned uid) {
 }
 
 
+void HeapProfiler::StreamSnapshot(String* title, v8::OutputStream* stream) {
+  HeapSnapshotStreamWriter writer(stream);
+  writer.WriteSnapshot(title);
+}
+
+
 const JSObjectsClusterTreeConfig::Key JSObjectsClusterTreeConfig::kNoKey;
 const JSObjectsClusterTreeConfig::Value JSObjectsClusterTreeConfig::kNoValue;
 
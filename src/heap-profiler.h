@@ -29,6 +29,7 @@
 #define V8_HEAP_PROFILER_H_
 
 #include "zone-inl.h"
+#include "../include/v8-profiler.h"
 
 namespace v8 {
 namespace internal {
@@ -49,6 +50,7 @@ class HeapProfiler {
   static int GetSnapshotsCount();
   static HeapSnapshot* GetSnapshot(int index);
   static HeapSnapshot* FindSnapshot(unsigned uid);
+  static void StreamSnapshot(String* title, v8::OutputStream* stream);
 
   // Obsolete interface.
   // Write a single heap sample to the log file.
@@ -35,6 +35,8 @@
 #include "debug.h"
 #include "heap-profiler.h"
 #include "global-handles.h"
+#include "hashmap.h"
+#include "liveedit.h"
 #include "mark-compact.h"
 #include "natives.h"
 #include "scanner.h"
@@ -51,138 +53,99 @@ namespace v8 {
 namespace internal {
 
 
-String* Heap::hidden_symbol_;
-Object* Heap::roots_[Heap::kRootListLength];
-
-
-NewSpace Heap::new_space_;
-OldSpace* Heap::old_pointer_space_ = NULL;
-OldSpace* Heap::old_data_space_ = NULL;
-OldSpace* Heap::code_space_ = NULL;
-MapSpace* Heap::map_space_ = NULL;
-CellSpace* Heap::cell_space_ = NULL;
-LargeObjectSpace* Heap::lo_space_ = NULL;
-
 static const int kMinimumPromotionLimit = 2*MB;
 static const int kMinimumAllocationLimit = 8*MB;
 
-int Heap::old_gen_promotion_limit_ = kMinimumPromotionLimit;
-int Heap::old_gen_allocation_limit_ = kMinimumAllocationLimit;
 
-int Heap::old_gen_exhausted_ = false;
-
-int Heap::amount_of_external_allocated_memory_ = 0;
-int Heap::amount_of_external_allocated_memory_at_last_global_gc_ = 0;
-
-// semispace_size_ should be a power of 2 and old_generation_size_ should be
-// a multiple of Page::kPageSize.
+Heap::Data::Data()
+    : old_pointer_space_(NULL),
+      old_data_space_(NULL),
+      code_space_(NULL),
+      map_space_(NULL),
+      cell_space_(NULL),
+      lo_space_(NULL),
+      gc_state_(NOT_IN_GC),
+#ifdef DEBUG
+      allocation_allowed_(true),
+#endif
+      old_gen_promotion_limit_(kMinimumPromotionLimit),
+      old_gen_idle_limit_(kMinimumPromotionLimit),
+      old_gen_allocation_limit_(kMinimumAllocationLimit),
+      tracer_(NULL) {
+  // semispace_size_ should be a power of 2 and old_generation_size_ should be
+  // a multiple of Page::kPageSize.
 #if defined(ANDROID)
-int Heap::max_semispace_size_  = 2*MB;
-int Heap::max_old_generation_size_ = 192*MB;
-int Heap::initial_semispace_size_ = 128*KB;
-size_t Heap::code_range_size_ = 0;
+  max_semispace_size_  = 2*MB;
+  max_old_generation_size_ = 192*MB;
+  initial_semispace_size_ = 128*KB;
+  code_range_size_ = 0;
 #elif defined(V8_TARGET_ARCH_X64)
-int Heap::max_semispace_size_  = 16*MB;
-int Heap::max_old_generation_size_ = 1*GB;
-int Heap::initial_semispace_size_ = 1*MB;
-size_t Heap::code_range_size_ = 512*MB;
+  max_semispace_size_  = 16*MB;
+  max_old_generation_size_ = 1*GB;
+  initial_semispace_size_ = 1*MB;
+  code_range_size_ = 512*MB;
 #else
-int Heap::max_semispace_size_  = 8*MB;
-int Heap::max_old_generation_size_ = 512*MB;
-int Heap::initial_semispace_size_ = 512*KB;
-size_t Heap::code_range_size_ = 0;
+  max_semispace_size_  = 8*MB;
+  max_old_generation_size_ = 512*MB;
+  initial_semispace_size_ = 512*KB;
+  code_range_size_ = 0;
 #endif
 
-// The snapshot semispace size will be the default semispace size if
-// snapshotting is used and will be the requested semispace size as
-// set up by ConfigureHeap otherwise.
-int Heap::reserved_semispace_size_ = Heap::max_semispace_size_;
-
-List<Heap::GCPrologueCallbackPair> Heap::gc_prologue_callbacks_;
-List<Heap::GCEpilogueCallbackPair> Heap::gc_epilogue_callbacks_;
-
-GCCallback Heap::global_gc_prologue_callback_ = NULL;
-GCCallback Heap::global_gc_epilogue_callback_ = NULL;
-
-// Variables set based on semispace_size_ and old_generation_size_ in
-// ConfigureHeap.
-
-// Will be 4 * reserved_semispace_size_ to ensure that young
-// generation can be aligned to its size.
-int Heap::survived_since_last_expansion_ = 0;
-int Heap::external_allocation_limit_ = 0;
-
-Heap::HeapState Heap::gc_state_ = NOT_IN_GC;
-
-int Heap::mc_count_ = 0;
-int Heap::ms_count_ = 0;
-int Heap::gc_count_ = 0;
-
-GCTracer* Heap::tracer_ = NULL;
-
-int Heap::unflattened_strings_length_ = 0;
-
-int Heap::always_allocate_scope_depth_ = 0;
-int Heap::linear_allocation_scope_depth_ = 0;
-int Heap::contexts_disposed_ = 0;
+  // The snapshot semispace size will be the default semispace size if
+  // snapshotting is used and will be the requested semispace size as
+  // set up by ConfigureHeap otherwise.
+  reserved_semispace_size_ = max_semispace_size_;
+}
 
-#ifdef DEBUG
-bool Heap::allocation_allowed_ = true;
 
-int Heap::allocation_timeout_ = 0;
-bool Heap::disallow_allocation_failure_ = false;
-#endif  // DEBUG
+DEFINE_ISOLATE_COMPONENT(Heap)
+DEFINE_ISOLATE_COMPONENT(GCTracer)
 
-int GCTracer::alive_after_last_gc_ = 0;
-double GCTracer::last_gc_end_timestamp_ = 0.0;
-int GCTracer::max_gc_pause_ = 0;
-int GCTracer::max_alive_after_gc_ = 0;
-int GCTracer::min_in_mutator_ = kMaxInt;
 
 int Heap::Capacity() {
   if (!HasBeenSetup()) return 0;
 
-  return new_space_.Capacity() +
-      old_pointer_space_->Capacity() +
-      old_data_space_->Capacity() +
-      code_space_->Capacity() +
-      map_space_->Capacity() +
-      cell_space_->Capacity();
+  return data()->new_space_.Capacity() +
+      data()->old_pointer_space_->Capacity() +
+      data()->old_data_space_->Capacity() +
+      data()->code_space_->Capacity() +
+      data()->map_space_->Capacity() +
+      data()->cell_space_->Capacity();
 }
 
 
 int Heap::CommittedMemory() {
   if (!HasBeenSetup()) return 0;
 
-  return new_space_.CommittedMemory() +
-      old_pointer_space_->CommittedMemory() +
-      old_data_space_->CommittedMemory() +
-      code_space_->CommittedMemory() +
-      map_space_->CommittedMemory() +
-      cell_space_->CommittedMemory() +
-      lo_space_->Size();
+  return data()->new_space_.CommittedMemory() +
+      data()->old_pointer_space_->CommittedMemory() +
+      data()->old_data_space_->CommittedMemory() +
+      data()->code_space_->CommittedMemory() +
+      data()->map_space_->CommittedMemory() +
+      data()->cell_space_->CommittedMemory() +
+      data()->lo_space_->Size();
 }
 
 
 int Heap::Available() {
   if (!HasBeenSetup()) return 0;
 
-  return new_space_.Available() +
-      old_pointer_space_->Available() +
-      old_data_space_->Available() +
-      code_space_->Available() +
-      map_space_->Available() +
-      cell_space_->Available();
+  return data()->new_space_.Available() +
+      data()->old_pointer_space_->Available() +
+      data()->old_data_space_->Available() +
+      data()->code_space_->Available() +
+      data()->map_space_->Available() +
+      data()->cell_space_->Available();
 }
 
 
 bool Heap::HasBeenSetup() {
-  return old_pointer_space_ != NULL &&
-         old_data_space_ != NULL &&
-         code_space_ != NULL &&
-         map_space_ != NULL &&
-         cell_space_ != NULL &&
-         lo_space_ != NULL;
+  return data()->old_pointer_space_ != NULL &&
+         data()->old_data_space_ != NULL &&
+         data()->code_space_ != NULL &&
+         data()->map_space_ != NULL &&
+         data()->cell_space_ != NULL &&
+         data()->lo_space_ != NULL;
 }
 
 
@@ -200,7 +163,7 @@ GarbageCollector Heap::SelectGarbageCollector(AllocationSpace space) {
   }
 
   // Have allocation in OLD and LO failed?
-  if (old_gen_exhausted_) {
+  if (data()->old_gen_exhausted_) {
     Counters::gc_compactor_caused_by_oldspace_exhaustion.Increment();
     return MARK_COMPACTOR;
   }
@@ -214,7 +177,7 @@ GarbageCollector Heap::SelectGarbageCollector(AllocationSpace space) {
   // and does not count available bytes already in the old space or code
   // space.  Undercounting is safe---we may get an unrequested full GC when
   // a scavenge would have succeeded.
-  if (MemoryAllocator::MaxAvailable() <= new_space_.Size()) {
+  if (MemoryAllocator::MaxAvailable() <= data()->new_space_.Size()) {
     Counters::gc_compactor_caused_by_oldspace_exhaustion.Increment();
     return MARK_COMPACTOR;
   }
@@ -232,24 +195,24 @@ void Heap::ReportStatisticsBeforeGC() {
   // compiled with ENABLE_LOGGING_AND_PROFILING and --log-gc is set.  The
   // following logic is used to avoid double logging.
 #if defined(DEBUG) && defined(ENABLE_LOGGING_AND_PROFILING)
-  if (FLAG_heap_stats || FLAG_log_gc) new_space_.CollectStatistics();
+  if (FLAG_heap_stats || FLAG_log_gc) data()->new_space_.CollectStatistics();
   if (FLAG_heap_stats) {
     ReportHeapStatistics("Before GC");
   } else if (FLAG_log_gc) {
-    new_space_.ReportStatistics();
+    data()->new_space_.ReportStatistics();
   }
-  if (FLAG_heap_stats || FLAG_log_gc) new_space_.ClearHistograms();
+  if (FLAG_heap_stats || FLAG_log_gc) data()->new_space_.ClearHistograms();
 #elif defined(DEBUG)
   if (FLAG_heap_stats) {
-    new_space_.CollectStatistics();
+    data()->new_space_.CollectStatistics();
     ReportHeapStatistics("Before GC");
-    new_space_.ClearHistograms();
+    data()->new_space_.ClearHistograms();
   }
 #elif defined(ENABLE_LOGGING_AND_PROFILING)
   if (FLAG_log_gc) {
-    new_space_.CollectStatistics();
-    new_space_.ReportStatistics();
-    new_space_.ClearHistograms();
+    data()->new_space_.CollectStatistics();
+    data()->new_space_.ReportStatistics();
+    data()->new_space_.ClearHistograms();
   }
 #endif
 }
@@ -262,31 +225,31 @@ void Heap::PrintShortHeapStatistics() {
          MemoryAllocator::Size(),
          MemoryAllocator::Available());
   PrintF("New space,          used: %8d, available: %8d\n",
-         Heap::new_space_.Size(),
-         new_space_.Available());
+         Heap::data()->new_space_.Size(),
+         data()->new_space_.Available());
   PrintF("Old pointers,       used: %8d, available: %8d, waste: %8d\n",
-         old_pointer_space_->Size(),
-         old_pointer_space_->Available(),
-         old_pointer_space_->Waste());
+         data()->old_pointer_space_->Size(),
+         data()->old_pointer_space_->Available(),
+         data()->old_pointer_space_->Waste());
   PrintF("Old data space,     used: %8d, available: %8d, waste: %8d\n",
-         old_data_space_->Size(),
-         old_data_space_->Available(),
-         old_data_space_->Waste());
+         data()->old_data_space_->Size(),
+         data()->old_data_space_->Available(),
+         data()->old_data_space_->Waste());
   PrintF("Code space,         used: %8d, available: %8d, waste: %8d\n",
-         code_space_->Size(),
-         code_space_->Available(),
-         code_space_->Waste());
+         data()->code_space_->Size(),
+         data()->code_space_->Available(),
+         data()->code_space_->Waste());
   PrintF("Map space,          used: %8d, available: %8d, waste: %8d\n",
-         map_space_->Size(),
-         map_space_->Available(),
-         map_space_->Waste());
+         data()->map_space_->Size(),
+         data()->map_space_->Available(),
+         data()->map_space_->Waste());
   PrintF("Cell space,         used: %8d, available: %8d, waste: %8d\n",
-         cell_space_->Size(),
-         cell_space_->Available(),
-         cell_space_->Waste());
+         data()->cell_space_->Size(),
+         data()->cell_space_->Available(),
+         data()->cell_space_->Waste());
   PrintF("Large object space, used: %8d, avaialble: %8d\n",
-         lo_space_->Size(),
-         lo_space_->Available());
+         data()->lo_space_->Size(),
+         data()->lo_space_->Available());
 }
 #endif
 
@@ -298,15 +261,15 @@ void Heap::ReportStatisticsAfterGC() {
   // NewSpace statistics are logged exactly once when --log-gc is turned on.
 #if defined(DEBUG) && defined(ENABLE_LOGGING_AND_PROFILING)
   if (FLAG_heap_stats) {
-    new_space_.CollectStatistics();
+    data()->new_space_.CollectStatistics();
     ReportHeapStatistics("After GC");
   } else if (FLAG_log_gc) {
-    new_space_.ReportStatistics();
+    data()->new_space_.ReportStatistics();
   }
 #elif defined(DEBUG)
   if (FLAG_heap_stats) ReportHeapStatistics("After GC");
 #elif defined(ENABLE_LOGGING_AND_PROFILING)
-  if (FLAG_log_gc) new_space_.ReportStatistics();
+  if (FLAG_log_gc) data()->new_space_.ReportStatistics();
 #endif
 }
 #endif  // defined(DEBUG) || defined(ENABLE_LOGGING_AND_PROFILING)
@@ -315,10 +278,10 @@ void Heap::ReportStatisticsAfterGC() {
 void Heap::GarbageCollectionPrologue() {
   TranscendentalCache::Clear();
   ClearJSFunctionResultCaches();
-  gc_count_++;
-  unflattened_strings_length_ = 0;
+  data()->gc_count_++;
+  data()->unflattened_strings_length_ = 0;
 #ifdef DEBUG
-  ASSERT(allocation_allowed_ && gc_state_ == NOT_IN_GC);
+  ASSERT(data()->allocation_allowed_ && data()->gc_state_ == NOT_IN_GC);
   allow_allocation(false);
 
   if (FLAG_verify_heap) {
@@ -390,14 +353,14 @@ bool Heap::CollectGarbage(int requested_size, AllocationSpace space) {
   // for this is that we have a lot of allocation sequences and we
   // assume that a garbage collection will allow the subsequent
   // allocation attempts to go through.
-  allocation_timeout_ = Max(6, FLAG_gc_interval);
+  data()->allocation_timeout_ = Max(6, FLAG_gc_interval);
 #endif
 
   { GCTracer tracer;
     GarbageCollectionPrologue();
     // The GC count was incremented in the prologue.  Tell the tracer about
     // it.
-    tracer.set_gc_count(gc_count_);
+    tracer.set_gc_count(data()->gc_count_);
 
     GarbageCollector collector = SelectGarbageCollector(space);
     // Tell the tracer which collector we've selected.
@@ -420,19 +383,19 @@ bool Heap::CollectGarbage(int requested_size, AllocationSpace space) {
 
   switch (space) {
     case NEW_SPACE:
-      return new_space_.Available() >= requested_size;
+      return data()->new_space_.Available() >= requested_size;
     case OLD_POINTER_SPACE:
-      return old_pointer_space_->Available() >= requested_size;
+      return data()->old_pointer_space_->Available() >= requested_size;
     case OLD_DATA_SPACE:
-      return old_data_space_->Available() >= requested_size;
+      return data()->old_data_space_->Available() >= requested_size;
     case CODE_SPACE:
-      return code_space_->Available() >= requested_size;
+      return data()->code_space_->Available() >= requested_size;
     case MAP_SPACE:
-      return map_space_->Available() >= requested_size;
+      return data()->map_space_->Available() >= requested_size;
     case CELL_SPACE:
-      return cell_space_->Available() >= requested_size;
+      return data()->cell_space_->Available() >= requested_size;
     case LO_SPACE:
-      return lo_space_->Available() >= requested_size;
+      return data()->lo_space_->Available() >= requested_size;
   }
   return false;
 }
@@ -529,12 +492,12 @@ void Heap::ReserveSpace(
 
 
 void Heap::EnsureFromSpaceIsCommitted() {
-  if (new_space_.CommitFromSpaceIfNeeded()) return;
+  if (data()->new_space_.CommitFromSpaceIfNeeded()) return;
 
   // Committing memory to from space failed.
   // Try shrinking and try again.
   Shrink();
-  if (new_space_.CommitFromSpaceIfNeeded()) return;
+  if (data()->new_space_.CommitFromSpaceIfNeeded()) return;
 
   // Committing memory to from space failed again.
   // Memory is exhausted and we will die.
@@ -587,18 +550,18 @@ void Heap::PerformGarbageCollection(AllocationSpace space,
                                     GarbageCollector collector,
                                     GCTracer* tracer) {
   VerifySymbolTable();
-  if (collector == MARK_COMPACTOR && global_gc_prologue_callback_) {
-    ASSERT(!allocation_allowed_);
+  if (collector == MARK_COMPACTOR && data()->global_gc_prologue_callback_) {
+    ASSERT(!data()->allocation_allowed_);
     GCTracer::Scope scope(tracer, GCTracer::Scope::EXTERNAL);
-    global_gc_prologue_callback_();
+    data()->global_gc_prologue_callback_();
   }
 
   GCType gc_type =
       collector == MARK_COMPACTOR ? kGCTypeMarkSweepCompact : kGCTypeScavenge;
 
-  for (int i = 0; i < gc_prologue_callbacks_.length(); ++i) {
-    if (gc_type & gc_prologue_callbacks_[i].gc_type) {
-      gc_prologue_callbacks_[i].callback(gc_type, kNoGCCallbackFlags);
+  for (int i = 0; i < data()->gc_prologue_callbacks_.length(); ++i) {
+    if (gc_type & data()->gc_prologue_callbacks_[i].gc_type) {
+      data()->gc_prologue_callbacks_[i].callback(gc_type, kNoGCCallbackFlags);
     }
   }
 
@@ -607,22 +570,24 @@ void Heap::PerformGarbageCollection(AllocationSpace space,
   if (collector == MARK_COMPACTOR) {
     if (FLAG_flush_code) {
       // Flush all potentially unused code.
-      FlushCode();
+      FlushCode(tracer);
     }
 
     // Perform mark-sweep with optional compaction.
     MarkCompact(tracer);
 
     int old_gen_size = PromotedSpaceSize();
-    old_gen_promotion_limit_ =
+    data()->old_gen_promotion_limit_ =
         old_gen_size + Max(kMinimumPromotionLimit, old_gen_size / 3);
-    old_gen_allocation_limit_ =
+    data()->old_gen_allocation_limit_ =
         old_gen_size + Max(kMinimumAllocationLimit, old_gen_size / 2);
-    old_gen_exhausted_ = false;
+    data()->old_gen_idle_limit_ =
+        old_gen_size + (data()->old_gen_promotion_limit_ - old_gen_size) / 2;
+    data()->old_gen_exhausted_ = false;
   } else {
-    tracer_ = tracer;
+    data()->tracer_ = tracer;
     Scavenge();
-    tracer_ = NULL;
+    data()->tracer_ = NULL;
   }
 
   Counters::objs_since_last_young.Set(0);
@@ -638,30 +603,187 @@ void Heap::PerformGarbageCollection(AllocationSpace space,
 
   if (collector == MARK_COMPACTOR) {
     // Register the amount of external allocated memory.
-    amount_of_external_allocated_memory_at_last_global_gc_ =
-        amount_of_external_allocated_memory_;
+    data()->amount_of_external_allocated_memory_at_last_global_gc_ =
+        data()->amount_of_external_allocated_memory_;
   }
 
   GCCallbackFlags callback_flags = tracer->is_compacting()
       ? kGCCallbackFlagCompacted
       : kNoGCCallbackFlags;
-  for (int i = 0; i < gc_epilogue_callbacks_.length(); ++i) {
-    if (gc_type & gc_epilogue_callbacks_[i].gc_type) {
-      gc_epilogue_callbacks_[i].callback(gc_type, callback_flags);
+  for (int i = 0; i < data()->gc_epilogue_callbacks_.length(); ++i) {
+    if (gc_type & data()->gc_epilogue_callbacks_[i].gc_type) {
+      data()->gc_epilogue_callbacks_[i].callback(gc_type, callback_flags);
     }
   }
 
-  if (collector == MARK_COMPACTOR && global_gc_epilogue_callback_) {
-    ASSERT(!allocation_allowed_);
+  if (collector == MARK_COMPACTOR && data()->global_gc_epilogue_callback_) {
+    ASSERT(!data()->allocation_allowed_);
     GCTracer::Scope scope(tracer, GCTracer::Scope::EXTERNAL);
-    global_gc_epilogue_callback_();
+    data()->global_gc_epilogue_callback_();
   }
   VerifySymbolTable();
 }
 
 
+// Survival feedback used to decide which objects to pretenure.
+//
+// With --pretenuring the scavenger counts, per map of plain JavaScript
+// objects, how many objects survive their first scavenge and how many of
+// those get promoted, either because they survive a second one or because
+// to space is filling up with survivors.  Once enough objects with a map
+// have survived and most of them were promoted, the map is marked as
+// pretenured and objects with it are allocated in old space from then on
+// (see AllocateJSObjectFromMap, CopyJSObject and the construct stubs).
+// Maps can move or die in full GCs, so the counts are dropped before each
+// full GC.  The decisions are dropped as well, so that a map whose objects
+// were long-lived only for a while, for instance during startup, is not
+// pretenured for the rest of the process.  Maps whose objects keep
+// surviving are pretenured again once enough new feedback is collected.
+class PretenuringFeedback : public AllStatic {
+ public:
+  static void RecordSurvivor(Map* map, bool first_survival, bool promoted) {
+    Counts* counts = Lookup(map);
+    if (first_survival) counts->survived++;
+    if (promoted) counts->promoted++;
+  }
+
+  // Mark the maps whose objects should be pretenured.  Called after each
+  // scavenge.
+  static void ProcessFeedback();
+
+  static void Clear();
+  static void TearDown();
+
+ private:
+  struct Counts {
+    Map* map;
+    int survived;
+    int promoted;
+  };
+
+  static Counts* Lookup(Map* map);
+  static void Pretenure(Map* map);
+  static void SetPretenured(Map* map);
+
+  static bool MapsMatch(void* key1, void* key2) { return key1 == key2; }
+
+  // Minimum number of survivors needed for a decision, the percentage of
+  // them that have to be promoted, and the number of survivors at which
+  // the counts start to decay.
+  static const int kMinSurvivors = 256;
+  static const int kMinPromotedPercent = 80;
+  static const int kMaxSurvivors = 64 * KB;
+
+  class Data {
+   public:
+    HashMap* table_;
+    List<Counts>* counts_;
+    // The maps pretenured since the last full GC.
+    List<Map*>* pretenured_maps_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kPretenuringFeedbackData));
+  }
+
+  friend class Isolate;
+};
+
+
+DEFINE_ISOLATE_COMPONENT(PretenuringFeedback)
+
+
+PretenuringFeedback::Counts* PretenuringFeedback::Lookup(Map* map) {
+  if (data()->table_ == NULL) {
+    data()->table_ = new HashMap(&MapsMatch);
+    data()->counts_ = new List<Counts>();
+    data()->pretenured_maps_ = new List<Map*>();
+  }
+  uint32_t hash = ComputeIntegerHash(
+      static_cast<uint32_t>(reinterpret_cast<uintptr_t>(map)));
+  HashMap::Entry* entry = data()->table_->Lookup(map, hash, true);
+  if (entry->value == NULL) {
+    Counts counts = { map, 0, 0 };
+    data()->counts_->Add(counts);
+    // Store the index plus one, so that NULL means a new entry.
+    entry->value = reinterpret_cast<void*>(data()->counts_->length());
+  }
+  int index = static_cast<int>(reinterpret_cast<intptr_t>(entry->value)) - 1;
+  return &data()->counts_->at(index);
+}
+
+
+void PretenuringFeedback::ProcessFeedback() {
+  if (data()->counts_ == NULL) return;
+  for (int i = 0; i < data()->counts_->length(); i++) {
+    Counts* counts = &data()->counts_->at(i);
+    if (counts->map->is_pretenured()) continue;
+    if (counts->survived >= kMinSurvivors &&
+        counts->promoted * 100 >= counts->survived * kMinPromotedPercent) {
+      Pretenure(counts->map);
+      if (FLAG_trace_gc) {
+        PrintF("Pretenuring objects with map %p: %d of %d survivors "
+               "promoted\n",
+               reinterpret_cast<void*>(counts->map),
+               counts->promoted,
+               counts->survived);
+      }
+    } else if (counts->survived > kMaxSurvivors) {
+      counts->survived /= 2;
+      counts->promoted /= 2;
+    }
+  }
+}
+
+
+void PretenuringFeedback::Pretenure(Map* map) {
+  SetPretenured(map);
+  // Objects created by a constructor are allocated with its initial map,
+  // but have usually moved on to other maps when they survive a scavenge.
+  // Object literals and objects created by 'new Object()' have the object
+  // function as constructor and do not affect each other.
+  Object* constructor = map->constructor();
+  if (constructor->IsJSFunction()) {
+    JSFunction* function = JSFunction::cast(constructor);
+    if (function->has_initial_map() &&
+        function != function->context()->global_context()->object_function()) {
+      SetPretenured(function->initial_map());
+    }
+  }
+}
+
+
+void PretenuringFeedback::SetPretenured(Map* map) {
+  if (map->is_pretenured()) return;
+  map->set_is_pretenured(true);
+  data()->pretenured_maps_->Add(map);
+}
+
+
+void PretenuringFeedback::Clear() {
+  if (data()->table_ == NULL) return;
+  data()->table_->Clear();
+  data()->counts_->Rewind(0);
+  for (int i = 0; i < data()->pretenured_maps_->length(); i++) {
+    data()->pretenured_maps_->at(i)->set_is_pretenured(false);
+  }
+  data()->pretenured_maps_->Rewind(0);
+}
+
+
+void PretenuringFeedback::TearDown() {
+  delete data()->table_;
+  data()->table_ = NULL;
+  delete data()->counts_;
+  data()->counts_ = NULL;
+  delete data()->pretenured_maps_;
+  data()->pretenured_maps_ = NULL;
+}
+
+
 void Heap::MarkCompact(GCTracer* tracer) {
-  gc_state_ = MARK_COMPACT;
+  data()->gc_state_ = MARK_COMPACT;
   LOG(ResourceEvent("markcompact", "begin"));
 
   MarkCompactCollector::Prepare(tracer);
@@ -669,11 +791,11 @@ void Heap::MarkCompact(GCTracer* tracer) {
   bool is_compacting = MarkCompactCollector::IsCompacting();
 
   if (is_compacting) {
-    mc_count_++;
+    data()->mc_count_++;
   } else {
-    ms_count_++;
+    data()->ms_count_++;
   }
-  tracer->set_full_gc_count(mc_count_ + ms_count_);
+  tracer->set_full_gc_count(data()->mc_count_ + data()->ms_count_);
 
   MarkCompactPrologue(is_compacting);
 
@@ -683,13 +805,13 @@ void Heap::MarkCompact(GCTracer* tracer) {
 
   LOG(ResourceEvent("markcompact", "end"));
 
-  gc_state_ = NOT_IN_GC;
+  data()->gc_state_ = NOT_IN_GC;
 
   Shrink();
 
   Counters::objs_since_last_full.Set(0);
 
-  contexts_disposed_ = 0;
+  data()->contexts_disposed_ = 0;
 }
 
 
@@ -699,6 +821,8 @@ void Heap::MarkCompactPrologue(bool is_compacting) {
   KeyedLookupCache::Clear();
   ContextSlotCache::Clear();
   DescriptorLookupCache::Clear();
+  RegExpResultsCache::Clear();
+  PretenuringFeedback::Clear();
 
   CompilationCache::MarkCompactPrologue();
 
@@ -718,9 +842,9 @@ void Heap::MarkCompactEpilogue(bool is_compacting) {
 
 
 Object* Heap::FindCodeObject(Address a) {
-  Object* obj = code_space_->FindObject(a);
+  Object* obj = data()->code_space_->FindObject(a);
   if (obj->IsFailure()) {
-    obj = lo_space_->FindObject(a);
+    obj = data()->lo_space_->FindObject(a);
   }
   ASSERT(!obj->IsFailure());
   return obj;
@@ -748,41 +872,6 @@ class ScavengeVisitor: public ObjectVisitor {
 };
 
 
-// A queue of pointers and maps of to-be-promoted objects during a
-// scavenge collection.
-class PromotionQueue {
- public:
-  void Initialize(Address start_address) {
-    front_ = rear_ = reinterpret_cast<HeapObject**>(start_address);
-  }
-
-  bool is_empty() { return front_ <= rear_; }
-
-  void insert(HeapObject* object, Map* map) {
-    *(--rear_) = object;
-    *(--rear_) = map;
-    // Assert no overflow into live objects.
-    ASSERT(reinterpret_cast<Address>(rear_) >= Heap::new_space()->top());
-  }
-
-  void remove(HeapObject** object, Map** map) {
-    *object = *(--front_);
-    *map = Map::cast(*(--front_));
-    // Assert no underflow.
-    ASSERT(front_ >= rear_);
-  }
-
- private:
-  // The front of the queue is higher in memory than the rear.
-  HeapObject** front_;
-  HeapObject** rear_;
-};
-
-
-// Shared state read by the scavenge collector and set by ScavengeObject.
-static PromotionQueue promotion_queue;
-
-
 #ifdef DEBUG
 // Visitor class to verify pointers in code or data space do not point into
 // new space.
@@ -816,27 +905,193 @@ static void VerifyNonPointerSpacePointers() {
 
 
 void Heap::CheckNewSpaceExpansionCriteria() {
-  if (new_space_.Capacity() < new_space_.MaximumCapacity() &&
-      survived_since_last_expansion_ > new_space_.Capacity()) {
+  if (data()->new_space_.Capacity() < data()->new_space_.MaximumCapacity() &&
+      data()->survived_since_last_expansion_ > data()->new_space_.Capacity()) {
     // Grow the size of new space if there is room to grow and enough
     // data has survived scavenge since the last expansion.
-    new_space_.Grow();
-    survived_since_last_expansion_ = 0;
+    data()->new_space_.Grow();
+    data()->survived_since_last_expansion_ = 0;
   }
 }
 
 
+// Scanning of dirty regions with several threads during scavenges.
+//
+// With --parallel_scavenge the GC threads claim pages of a space in the
+// old generation and collect the slots in its dirty regions that point
+// into new space.  Only the old generation is read while doing so.  The
+// main thread then goes through the pages in order, scavenges the
+// collected slots and updates the region marks, with the same result as
+// IterateDirtyRegions with IteratePointersInDirtyRegion.  The threads
+// share the scanning of dirty regions, most of which usually contain few
+// or no pointers to new space, while copying objects stays on the main
+// thread since allocation in new space and the old generation is not
+// thread safe.
+class DirtyRegionScanner : public AllStatic {
+ public:
+  static bool CanScan() {
+    return FLAG_parallel_scavenge && FLAG_parallel_gc_threads > 1;
+  }
+
+  // Scavenge the pointers to new space in the dirty regions of the pages
+  // in use in space and update the region marks of the pages.
+  static void ScavengeDirtyRegions(PagedSpace* space);
+
+  static void TearDown();
+
+ private:
+  struct PageSlots {
+    // The thread that scanned the page and the range of the slots found
+    // on it in that thread's list.
+    int thread;
+    int first_slot;
+    int last_slot;
+  };
+
+  static void ScanTask(int index);
+  static void ScanPage(int thread, int page_index);
+
+  class Data {
+   public:
+    List<Page*>* pages_;
+    List<PageSlots>* page_slots_;
+    volatile AtomicWord next_page_;
+
+    // Per thread lists of slots pointing to new space.
+    int thread_count_;
+    List<Object**>* slots_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kDirtyRegionScannerData));
+  }
+
+  friend class Isolate;
+};
+
+
+DEFINE_ISOLATE_COMPONENT(DirtyRegionScanner)
+
+
+void DirtyRegionScanner::ScavengeDirtyRegions(PagedSpace* space) {
+  GCThreads::EnsureThreads(FLAG_parallel_gc_threads);
+  if (data()->thread_count_ != GCThreads::count()) {
+    TearDown();
+    data()->thread_count_ = GCThreads::count();
+    data()->slots_ = new List<Object**>[data()->thread_count_];
+    data()->pages_ = new List<Page*>();
+    data()->page_slots_ = new List<PageSlots>();
+  }
+  for (int i = 0; i < data()->thread_count_; i++) data()->slots_[i].Rewind(0);
+
+  data()->pages_->Rewind(0);
+  PageIterator it(space, PageIterator::PAGES_IN_USE);
+  while (it.has_next()) data()->pages_->Add(it.next());
+  data()->page_slots_->Rewind(0);
+  PageSlots empty = { 0, 0, 0 };
+  data()->page_slots_->AddBlock(empty, data()->pages_->length());
+
+  data()->next_page_ = 0;
+  GCThreads::Run(&ScanTask);
+
+  for (int i = 0; i < data()->pages_->length(); i++) {
+    Page* page = data()->pages_->at(i);
+    const PageSlots& page_slots = data()->page_slots_->at(i);
+    if (page->GetRegionMarks() != Page::kAllRegionsCleanMarks) {
+      List<Object**>* slots = &data()->slots_[page_slots.thread];
+      uint32_t marks = Page::kAllRegionsCleanMarks;
+      for (int j = page_slots.first_slot; j < page_slots.last_slot; j++) {
+        Object** slot = slots->at(j);
+        if (Heap::InNewSpace(*slot)) {
+          Heap::ScavengePointer(reinterpret_cast<HeapObject**>(slot));
+          if (Heap::InNewSpace(*slot)) {
+            marks |= page->GetRegionMaskForAddress(
+                reinterpret_cast<Address>(slot));
+          }
+        }
+      }
+      page->SetRegionMarks(marks);
+    }
+
+    // Mark page watermark as invalid to maintain watermark validity invariant.
+    // See Page::FlipMeaningOfInvalidatedWatermarkFlag() for details.
+    page->InvalidateWatermark(true);
+  }
+}
+
+
+void DirtyRegionScanner::ScanTask(int index) {
+  while (true) {
+    AtomicWord page_index = data()->next_page_;
+    if (page_index >= data()->pages_->length()) return;
+    if (OS::CompareAndSwap(&data()->next_page_, page_index, page_index + 1) ==
+        page_index) {
+      ScanPage(index, static_cast<int>(page_index));
+    }
+  }
+}
+
+
+void DirtyRegionScanner::ScanPage(int thread, int page_index) {
+  Page* page = data()->pages_->at(page_index);
+  List<Object**>* slots = &data()->slots_[thread];
+  PageSlots* page_slots = &data()->page_slots_->at(page_index);
+  page_slots->thread = thread;
+  page_slots->first_slot = slots->length();
+
+  uint32_t marks = page->GetRegionMarks();
+  if (marks != Page::kAllRegionsCleanMarks) {
+    // Do not try to visit pointers beyond page allocation watermark.
+    // Page can contain garbage pointers there.
+    Address end = page->IsWatermarkValid()
+        ? page->AllocationWatermark()
+        : page->CachedAllocationWatermark();
+    Address region_start = page->ObjectAreaStart();
+    while (region_start < end) {
+      Address region_end = Min(
+          reinterpret_cast<Address>(
+              reinterpret_cast<intptr_t>(region_start + Page::kRegionSize) &
+              ~Page::kRegionAlignmentMask),
+          end);
+      if ((marks & page->GetRegionMaskForAddress(region_start)) != 0) {
+        for (Address slot_address = region_start;
+             slot_address < region_end;
+             slot_address += kPointerSize) {
+          Object** slot = reinterpret_cast<Object**>(slot_address);
+          if (Heap::InNewSpace(*slot)) slots->Add(slot);
+        }
+      }
+      region_start = region_end;
+    }
+  }
+
+  page_slots->last_slot = slots->length();
+}
+
+
+void DirtyRegionScanner::TearDown() {
+  delete[] data()->slots_;
+  data()->slots_ = NULL;
+  data()->thread_count_ = 0;
+  delete data()->pages_;
+  data()->pages_ = NULL;
+  delete data()->page_slots_;
+  data()->page_slots_ = NULL;
+}
+
+
 void Heap::Scavenge() {
 #ifdef DEBUG
   if (FLAG_enable_slow_asserts) VerifyNonPointerSpacePointers();
 #endif
 
-  gc_state_ = SCAVENGE;
+  data()->gc_state_ = SCAVENGE;
 
   Page::FlipMeaningOfInvalidatedWatermarkFlag();
 #ifdef DEBUG
-  VerifyPageWatermarkValidity(old_pointer_space_, ALL_VALID);
-  VerifyPageWatermarkValidity(map_space_, ALL_VALID);
+  VerifyPageWatermarkValidity(data()->old_pointer_space_, ALL_VALID);
+  VerifyPageWatermarkValidity(data()->map_space_, ALL_VALID);
 #endif
 
   // We do not update an allocation watermark of the top page during linear
@@ -844,8 +1099,8 @@ void Heap::Scavenge() {
   // we have to manually cache the watermark and mark the top page as having an
   // invalid watermark. This guarantees that dirty regions iteration will use a
   // correct watermark even if a linear allocation happens.
-  old_pointer_space_->FlushTopPageWatermark();
-  map_space_->FlushTopPageWatermark();
+  data()->old_pointer_space_->FlushTopPageWatermark();
+  data()->map_space_->FlushTopPageWatermark();
 
   // Implements Cheney's copying algorithm
   LOG(ResourceEvent("scavenge", "begin"));
@@ -860,8 +1115,8 @@ void Heap::Scavenge() {
 
   // Flip the semispaces.  After flipping, to space is empty, from space has
   // live objects.
-  new_space_.Flip();
-  new_space_.ResetAllocationInfo();
+  data()->new_space_.Flip();
+  data()->new_space_.ResetAllocationInfo();
 
   // We need to sweep newly copied objects which can be either in the
   // to space or promoted to the old generation.  For to-space
@@ -880,8 +1135,8 @@ void Heap::Scavenge() {
   // for the addresses of promoted objects: every object promoted
   // frees up its size in bytes from the top of the new space, and
   // objects are at least one pointer in size.
-  Address new_space_front = new_space_.ToSpaceLow();
-  promotion_queue.Initialize(new_space_.ToSpaceHigh());
+  Address new_space_front = data()->new_space_.ToSpaceLow();
+  data()->promotion_queue_.Initialize(data()->new_space_.ToSpaceHigh());
 
   ScavengeVisitor scavenge_visitor;
   // Copy roots.
@@ -889,20 +1144,28 @@ void Heap::Scavenge() {
 
   // Copy objects reachable from the old generation.  By definition,
   // there are no intergenerational pointers in code or data spaces.
-  IterateDirtyRegions(old_pointer_space_,
-                      &IteratePointersInDirtyRegion,
-                      &ScavengePointer,
-                      WATERMARK_CAN_BE_INVALID);
+  {
+    GCTracer::Scope scope(data()->tracer_,
+                          GCTracer::Scope::SCAVENGE_DIRTY_REGIONS);
+    if (DirtyRegionScanner::CanScan()) {
+      DirtyRegionScanner::ScavengeDirtyRegions(data()->old_pointer_space_);
+    } else {
+      IterateDirtyRegions(data()->old_pointer_space_,
+                          &IteratePointersInDirtyRegion,
+                          &ScavengePointer,
+                          WATERMARK_CAN_BE_INVALID);
+    }
+  }
 
-  IterateDirtyRegions(map_space_,
+  IterateDirtyRegions(data()->map_space_,
                       &IteratePointersInDirtyMapsRegion,
                       &ScavengePointer,
                       WATERMARK_CAN_BE_INVALID);
 
-  lo_space_->IterateDirtyRegions(&ScavengePointer);
+  data()->lo_space_->IterateDirtyRegions(&ScavengePointer);
 
   // Copy objects reachable from cells by scavenging cell values directly.
-  HeapObjectIterator cell_iterator(cell_space_);
+  HeapObjectIterator cell_iterator(data()->cell_space_);
   for (HeapObject* cell = cell_iterator.next();
        cell != NULL; cell = cell_iterator.next()) {
     if (cell->IsJSGlobalPropertyCell()) {
@@ -918,18 +1181,20 @@ void Heap::Scavenge() {
   UpdateNewSpaceReferencesInExternalStringTable(
       &UpdateNewSpaceReferenceInExternalStringTableEntry);
 
-  ASSERT(new_space_front == new_space_.top());
+  ASSERT(new_space_front == data()->new_space_.top());
 
   // Set age mark.
-  new_space_.set_age_mark(new_space_.top());
+  data()->new_space_.set_age_mark(data()->new_space_.top());
 
   // Update how much has survived scavenge.
   IncrementYoungSurvivorsCounter(
-      (PromotedSpaceSize() - survived_watermark) + new_space_.Size());
+      (PromotedSpaceSize() - survived_watermark) + data()->new_space_.Size());
+
+  if (FLAG_pretenuring) PretenuringFeedback::ProcessFeedback();
 
   LOG(ResourceEvent("scavenge", "end"));
 
-  gc_state_ = NOT_IN_GC;
+  data()->gc_state_ = NOT_IN_GC;
 }
 
 
@@ -951,10 +1216,12 @@ void Heap::UpdateNewSpaceReferencesInExternalStringTable(
     ExternalStringTableUpdaterCallback updater_func) {
   ExternalStringTable::Verify();
 
-  if (ExternalStringTable::new_space_strings_.is_empty()) return;
+  if (ExternalStringTable::data()->new_space_strings_.is_empty()) return;
 
-  Object** start = &ExternalStringTable::new_space_strings_[0];
-  Object** end = start + ExternalStringTable::new_space_strings_.length();
+  List<Object*>* new_space_strings =
+      &ExternalStringTable::data()->new_space_strings_;
+  Object** start = &(*new_space_strings)[0];
+  Object** end = start + new_space_strings->length();
   Object** last = start;
 
   for (Object** p = start; p < end; ++p) {
@@ -983,22 +1250,22 @@ void Heap::UpdateNewSpaceReferencesInExternalStringTable(
 Address Heap::DoScavenge(ObjectVisitor* scavenge_visitor,
                          Address new_space_front) {
   do {
-    ASSERT(new_space_front <= new_space_.top());
+    ASSERT(new_space_front <= data()->new_space_.top());
 
     // The addresses new_space_front and new_space_.top() define a
     // queue of unprocessed copied objects.  Process them until the
     // queue is empty.
-    while (new_space_front < new_space_.top()) {
+    while (new_space_front < data()->new_space_.top()) {
       HeapObject* object = HeapObject::FromAddress(new_space_front);
       object->Iterate(scavenge_visitor);
       new_space_front += object->Size();
     }
 
     // Promote and process all the to-be-promoted objects.
-    while (!promotion_queue.is_empty()) {
+    while (!data()->promotion_queue_.is_empty()) {
       HeapObject* source;
       Map* map;
-      promotion_queue.remove(&source, &map);
+      data()->promotion_queue_.remove(&source, &map);
       // Copy the from-space object to its new location (given by the
       // forwarding address) and fix its map.
       HeapObject* target = source->map_word().ToForwardingAddress();
@@ -1019,7 +1286,7 @@ Address Heap::DoScavenge(ObjectVisitor* scavenge_visitor,
 
     // Take another spin if there are now unswept objects in new space
     // (there are currently no more unswept promoted objects).
-  } while (new_space_front < new_space_.top());
+  } while (new_space_front < data()->new_space_.top());
 
   return new_space_front;
 }
@@ -1035,10 +1302,10 @@ void Heap::RecordCopiedObject(HeapObject* obj) {
   should_record = should_record || FLAG_log_gc;
 #endif
   if (should_record) {
-    if (new_space_.Contains(obj)) {
-      new_space_.RecordAllocation(obj);
+    if (data()->new_space_.Contains(obj)) {
+      data()->new_space_.RecordAllocation(obj);
     } else {
-      new_space_.RecordPromotion(obj);
+      data()->new_space_.RecordPromotion(obj);
     }
   }
 }
@@ -1094,16 +1361,27 @@ void Heap::ScavengeObjectSlow(HeapObject** p, HeapObject* object) {
   }
 
   int object_size = object->SizeFromMap(first_word.ToMap());
+
   // We rely on live objects in new space to be at least two pointers,
   // so we can store the from-space address and map pointer of promoted
   // objects in the to space.
   ASSERT(object_size >= 2 * kPointerSize);
 
+  bool promote = ShouldBePromoted(object->address(), object_size);
+
+  if (FLAG_pretenuring) {
+    Map* map = first_word.ToMap();
+    if (map->instance_type() == JS_OBJECT_TYPE && !map->is_pretenured()) {
+      bool first_survival = object->address() >= data()->new_space_.age_mark();
+      PretenuringFeedback::RecordSurvivor(map, first_survival, promote);
+    }
+  }
+
   // If the object should be promoted, we try to copy it to old space.
-  if (ShouldBePromoted(object->address(), object_size)) {
+  if (promote) {
     Object* result;
     if (object_size > MaxObjectSizeInPagedSpace()) {
-      result = lo_space_->AllocateRawFixedArray(object_size);
+      result = data()->lo_space_->AllocateRawFixedArray(object_size);
       if (!result->IsFailure()) {
         HeapObject* target = HeapObject::cast(result);
 
@@ -1112,7 +1390,7 @@ void Heap::ScavengeObjectSlow(HeapObject** p, HeapObject* object) {
           // top of the to space to be swept and copied later.  Write the
           // forwarding address over the map word of the from-space
           // object.
-          promotion_queue.insert(object, first_word.ToMap());
+          data()->promotion_queue_.insert(object, first_word.ToMap());
           object->set_map_word(MapWord::FromForwardingAddress(target));
 
           // Give the space allocated for the result a proper map by
@@ -1134,17 +1412,17 @@ void Heap::ScavengeObjectSlow(HeapObject** p, HeapObject* object) {
       }
     } else {
       OldSpace* target_space = Heap::TargetSpace(object);
-      ASSERT(target_space == Heap::old_pointer_space_ ||
-             target_space == Heap::old_data_space_);
+      ASSERT(target_space == Heap::data()->old_pointer_space_ ||
+             target_space == Heap::data()->old_data_space_);
       result = target_space->AllocateRaw(object_size);
       if (!result->IsFailure()) {
         HeapObject* target = HeapObject::cast(result);
-        if (target_space == Heap::old_pointer_space_) {
+        if (target_space == Heap::data()->old_pointer_space_) {
           // Save the from-space object pointer and its map pointer at the
           // top of the to space to be swept and copied later.  Write the
           // forwarding address over the map word of the from-space
           // object.
-          promotion_queue.insert(object, first_word.ToMap());
+          data()->promotion_queue_.insert(object, first_word.ToMap());
           object->set_map_word(MapWord::FromForwardingAddress(target));
 
           // Give the space allocated for the result a proper map by
@@ -1171,7 +1449,7 @@ void Heap::ScavengeObjectSlow(HeapObject** p, HeapObject* object) {
     }
   }
   // The object should remain in new space or the old space allocation failed.
-  Object* result = new_space_.AllocateRaw(object_size);
+  Object* result = data()->new_space_.AllocateRaw(object_size);
   // Failed allocation at this point is utterly unexpected.
   ASSERT(!result->IsFailure());
   *p = MigrateObject(object, HeapObject::cast(result), object_size);
@@ -1325,7 +1603,7 @@ bool Heap::CreateInitialMaps() {
     const StringTypeTable& entry = string_type_table[i];
     obj = AllocateMap(entry.type, entry.size);
     if (obj->IsFailure()) return false;
-    roots_[entry.index] = Map::cast(obj);
+    data()->roots_[entry.index] = Map::cast(obj);
   }
 
   obj = AllocateMap(STRING_TYPE, SeqTwoByteString::kAlignedSize);
@@ -1402,7 +1680,7 @@ bool Heap::CreateInitialMaps() {
     const StructTable& entry = struct_table[i];
     obj = AllocateMap(entry.type, entry.size);
     if (obj->IsFailure()) return false;
-    roots_[entry.index] = Map::cast(obj);
+    data()->roots_[entry.index] = Map::cast(obj);
   }
 
   obj = AllocateMap(FIXED_ARRAY_TYPE, HeapObject::kHeaderSize);
@@ -1453,8 +1731,8 @@ Object* Heap::AllocateHeapNumber(double value) {
   // This version of AllocateHeapNumber is optimized for
   // allocation in new space.
   STATIC_ASSERT(HeapNumber::kSize <= Page::kMaxHeapObjectSize);
-  ASSERT(allocation_allowed_ && gc_state_ == NOT_IN_GC);
-  Object* result = new_space_.AllocateRaw(HeapNumber::kSize);
+  ASSERT(data()->allocation_allowed_ && data()->gc_state_ == NOT_IN_GC);
+  Object* result = data()->new_space_.AllocateRaw(HeapNumber::kSize);
   if (result->IsFailure()) return result;
   HeapObject::cast(result)->set_map(heap_number_map());
   HeapNumber::cast(result)->set_value(value);
@@ -1569,7 +1847,7 @@ bool Heap::CreateInitialObjects() {
   obj = SymbolTable::Allocate(kInitialSymbolTableSize);
   if (obj->IsFailure()) return false;
   // Don't use set_symbol_table() due to asserts.
-  roots_[kSymbolTableRootIndex] = obj;
+  data()->roots_[kSymbolTableRootIndex] = obj;
 
   // Assign the print strings for oddballs after creating symboltable.
   Object* symbol = LookupAsciiSymbol("undefined");
@@ -1609,7 +1887,7 @@ bool Heap::CreateInitialObjects() {
   for (unsigned i = 0; i < ARRAY_SIZE(constant_symbol_table); i++) {
     obj = LookupAsciiSymbol(constant_symbol_table[i].contents);
     if (obj->IsFailure()) return false;
-    roots_[constant_symbol_table[i].index] = String::cast(obj);
+    data()->roots_[constant_symbol_table[i].index] = String::cast(obj);
   }
 
   // Allocate the hidden symbol which is used to identify the hidden properties
@@ -1620,7 +1898,7 @@ bool Heap::CreateInitialObjects() {
   // that it will always be at the first entry in property descriptors.
   obj = AllocateSymbol(CStrVector(""), 0, String::kZeroHash);
   if (obj->IsFailure()) return false;
-  hidden_symbol_ = String::cast(obj);
+  data()->hidden_symbol_ = String::cast(obj);
 
   // Allocate the proxy for __proto__.
   obj = AllocateProxy((Address) &Accessors::ObjectPrototype);
@@ -1657,6 +1935,18 @@ bool Heap::CreateInitialObjects() {
   if (obj->IsFailure()) return false;
   set_natives_source_cache(FixedArray::cast(obj));
 
+  // Allocate caches for the results of splitting and matching strings.
+  obj = AllocateFixedArray(RegExpResultsCache::kRegExpResultsCacheSize *
+                           RegExpResultsCache::kEntrySize,
+                           TENURED);
+  if (obj->IsFailure()) return false;
+  set_string_split_cache(FixedArray::cast(obj));
+  obj = AllocateFixedArray(RegExpResultsCache::kRegExpResultsCacheSize *
+                           RegExpResultsCache::kEntrySize,
+                           TENURED);
+  if (obj->IsFailure()) return false;
+  set_string_match_cache(FixedArray::cast(obj));
+
   // Handling of script id generation is in Factory::NewScript.
   set_last_script_id(undefined_value());
 
@@ -1680,7 +1970,7 @@ Object* Heap::InitializeNumberStringCache() {
   // Compute the size of the number string cache based on the max heap size.
   // max_semispace_size_ == 512 KB => number_string_cache_size = 32.
   // max_semispace_size_ ==   8 MB => number_string_cache_size = 16KB.
-  int number_string_cache_size = max_semispace_size_ / 512;
+  int number_string_cache_size = data()->max_semispace_size_ / 512;
   number_string_cache_size = Max(32, Min(16*KB, number_string_cache_size));
   Object* obj = AllocateFixedArray(number_string_cache_size * 2, TENURED);
   if (!obj->IsFailure()) set_number_string_cache(FixedArray::cast(obj));
@@ -1771,7 +2061,7 @@ Object* Heap::NumberToString(Object* number, bool check_number_string_cache) {
 
 
 Map* Heap::MapForExternalArrayType(ExternalArrayType array_type) {
-  return Map::cast(roots_[RootIndexForExternalArrayType(array_type)]);
+  return Map::cast(data()->roots_[RootIndexForExternalArrayType(array_type)]);
 }
 
 
@@ -2021,6 +2311,34 @@ Object* Heap::AllocateSubString(String* buffer,
   // Make an attempt to flatten the buffer to reduce access time.
   buffer = buffer->TryFlattenGetString();
 
+  // Long substrings of flat strings share the characters of the underlying
+  // sequential or external string instead of copying them.
+  if (length >= SlicedString::kMinLength && buffer->IsFlat()) {
+    if (StringShape(buffer).IsCons()) {
+      buffer = ConsString::cast(buffer)->first();
+    } else if (StringShape(buffer).IsSliced()) {
+      SlicedString* slice = SlicedString::cast(buffer);
+      start += slice->offset();
+      buffer = slice->parent();
+    }
+    ASSERT(buffer->IsSeqString() || buffer->IsExternalString());
+    Map* map = buffer->IsAsciiRepresentation()
+        ? sliced_ascii_string_map()
+        : sliced_string_map();
+    Object* result =
+        Allocate(map, (pretenure == TENURED) ? OLD_POINTER_SPACE : NEW_SPACE);
+    if (result->IsFailure()) return result;
+
+    AssertNoAllocation no_gc;
+    SlicedString* sliced_string = SlicedString::cast(result);
+    WriteBarrierMode mode = sliced_string->GetWriteBarrierMode(no_gc);
+    sliced_string->set_length(length);
+    sliced_string->set_hash_field(String::kEmptyHashField);
+    sliced_string->set_parent(buffer, mode);
+    sliced_string->set_offset(start);
+    return result;
+  }
+
   Object* result = buffer->IsAsciiRepresentation()
       ? AllocateRawAsciiString(length, pretenure )
       : AllocateRawTwoByteString(length, pretenure);
@@ -2114,8 +2432,8 @@ Object* Heap::AllocateByteArray(int length, PretenureFlag pretenure) {
   }
   int size = ByteArray::SizeFor(length);
   Object* result = (size <= MaxObjectSizeInPagedSpace())
-      ? old_data_space_->AllocateRaw(size)
-      : lo_space_->AllocateRaw(size);
+      ? data()->old_data_space_->AllocateRaw(size)
+      : data()->lo_space_->AllocateRaw(size);
   if (result->IsFailure()) return result;
 
   reinterpret_cast<ByteArray*>(result)->set_map(byte_array_map());
@@ -2189,84 +2507,111 @@ Object* Heap::AllocateExternalArray(int length,
 }
 
 
-// The StackVisitor is used to traverse all the archived threads to see if
-// there are activations on any of the stacks corresponding to the code.
-class FlushingStackVisitor : public ThreadVisitor {
+// Resets the code age of every function with an activation on the stacks
+// visited, as its code is still in use.
+class CodeAgeResettingVisitor : public ThreadVisitor {
  public:
-  explicit FlushingStackVisitor(Code* code) : found_(false), code_(code) {}
-
   void VisitThread(ThreadLocalTop* top) {
-    // If we already found the code in a previous traversed thread we return.
-    if (found_) return;
-
     for (StackFrameIterator it(top); !it.done(); it.Advance()) {
-      if (code_->contains(it.frame()->pc())) {
-        found_ = true;
-        return;
-      }
+      VisitFrame(it.frame());
+    }
+  }
+
+  void VisitCurrentThread() {
+    for (StackFrameIterator it; !it.done(); it.Advance()) {
+      VisitFrame(it.frame());
     }
   }
-  bool FoundCode() {return found_;}
 
  private:
-  bool found_;
-  Code* code_;
+  void VisitFrame(StackFrame* frame) {
+    if (!frame->is_java_script()) return;
+    Object* function = JavaScriptFrame::cast(frame)->function();
+    if (!function->IsJSFunction()) return;
+    JSFunction::cast(function)->shared()->set_code_age(0);
+  }
 };
 
 
-static void FlushCodeForFunction(SharedFunctionInfo* function_info) {
+static bool IsFlushable(SharedFunctionInfo* function_info) {
   // The function must be compiled and have the source code available,
   // to be able to recompile it in case we need the function again.
-  if (!(function_info->is_compiled() && function_info->HasSourceCode())) return;
+  if (!(function_info->is_compiled() && function_info->HasSourceCode())) {
+    return false;
+  }
 
   // We never flush code for Api functions.
-  if (function_info->IsApiFunction()) return;
+  if (function_info->IsApiFunction()) return false;
 
   // Only flush code for functions.
-  if (!function_info->code()->kind() == Code::FUNCTION) return;
+  if (function_info->code()->kind() != Code::FUNCTION) return false;
 
   // Function must be lazy compilable.
-  if (!function_info->allows_lazy_compilation()) return;
+  if (!function_info->allows_lazy_compilation()) return false;
 
   // If this is a full script wrapped in a function we do no flush the code.
-  if (function_info->is_toplevel()) return;
+  if (function_info->is_toplevel()) return false;
 
-  // If this function is in the compilation cache we do not flush the code.
-  if (CompilationCache::HasFunction(function_info)) return;
+  // Builtins and extensions are compiled with special flags, so only code
+  // from ordinary scripts is flushed.
+  Script* script = Script::cast(function_info->script());
+  if (script->type()->value() != Script::TYPE_NORMAL) return false;
 
-  // Make sure we are not referencing the code from the stack.
-  for (StackFrameIterator it; !it.done(); it.Advance()) {
-    if (function_info->code()->contains(it.frame()->pc())) return;
+  // Lookups of the locals in the context allocated by the function use the
+  // scope info in its code, so that code has to stay.
+  if (ScopeInfo<>::NumberOfContextSlots(function_info->code()) >
+      Context::MIN_CONTEXT_SLOTS) {
+    return false;
   }
-  // Iterate the archived stacks in all threads to check if
-  // the code is referenced.
-  FlushingStackVisitor threadvisitor(function_info->code());
-  ThreadManager::IterateArchivedThreads(&threadvisitor);
-  if (threadvisitor.FoundCode()) return;
 
-  HandleScope scope;
-  // Compute the lazy compilable version of the code.
-  function_info->set_code(*ComputeLazyCompile(function_info->length()));
+  return true;
 }
 
 
-void Heap::FlushCode() {
+void Heap::FlushCode(GCTracer* tracer) {
 #ifdef ENABLE_DEBUGGER_SUPPORT
   // Do not flush code if the debugger is loaded or there are breakpoints.
   if (Debug::IsLoaded() || Debug::has_break_points()) return;
 #endif
+  // LiveEdit compares the code of functions while it is patching them.
+  if (LiveEditFunctionTracker::IsActive()) return;
+
+  // Functions with activations on any of the stacks are in use.
+  CodeAgeResettingVisitor visitor;
+  visitor.VisitCurrentThread();
+  ThreadManager::IterateArchivedThreads(&visitor);
+
+  int max_age = Min(Max(FLAG_max_code_age, 1), SharedFunctionInfo::kMaxCodeAge);
+
+  // Computing the lazy compile stubs may allocate, so the functions to flush
+  // are collected before the heap is changed.
+  List<SharedFunctionInfo*> flushed;
   HeapObjectIterator it(old_pointer_space());
   for (HeapObject* obj = it.next(); obj != NULL; obj = it.next()) {
-    if (obj->IsJSFunction()) {
-      JSFunction* jsfunction = JSFunction::cast(obj);
+    if (!obj->IsSharedFunctionInfo()) continue;
+    SharedFunctionInfo* function_info = SharedFunctionInfo::cast(obj);
+    if (!IsFlushable(function_info)) continue;
 
-      // The function must have a valid context and not be a builtin.
-      if (jsfunction->unchecked_context()->IsContext() &&
-          !jsfunction->IsBuiltin()) {
-        FlushCodeForFunction(jsfunction->shared());
-      }
+    int age = Min(function_info->code_age() + 1, max_age);
+    function_info->set_code_age(age);
+
+    // If this function is in the compilation cache we do not flush the code.
+    if (age == max_age && !CompilationCache::HasFunction(function_info)) {
+      flushed.Add(function_info);
     }
   }
+
+  HandleScope scope;
+  int flushed_code_size = 0;
+  for (int i = 0; i < flushed.length(); i++) {
+    SharedFunctionInfo* function_info = flushed[i];
+    flushed_code_size += function_info->code()->Size();
+    // Compute the lazy compilable version of the code. The preparse data of
+    // the script is kept, so recompiling still skips inner functions.
+    function_info->set_code(*ComputeLazyCompile(function_info->length()));
+    function_info->set_code_age(0);
+  }
+  tracer->add_flushed_code(flushed.length(), flushed_code_size);
 }
 
 
@@ -2282,9 +2627,9 @@ Object* Heap::CreateCode(const CodeDesc& desc,
   ASSERT(IsAligned(obj_size, Code::kCodeAlignment));
   Object* result;
   if (obj_size > MaxObjectSizeInPagedSpace()) {
-    result = lo_space_->AllocateRawCode(obj_size);
+    result = data()->lo_space_->AllocateRawCode(obj_size);
   } else {
-    result = code_space_->AllocateRaw(obj_size);
+    result = data()->code_space_->AllocateRaw(obj_size);
   }
 
   if (result->IsFailure()) return result;
@@ -2322,9 +2667,9 @@ Object* Heap::CopyCode(Code* code) {
   int obj_size = code->Size();
   Object* result;
   if (obj_size > MaxObjectSizeInPagedSpace()) {
-    result = lo_space_->AllocateRawCode(obj_size);
+    result = data()->lo_space_->AllocateRawCode(obj_size);
   } else {
-    result = code_space_->AllocateRaw(obj_size);
+    result = data()->code_space_->AllocateRaw(obj_size);
   }
 
   if (result->IsFailure()) return result;
@@ -2356,9 +2701,9 @@ Object* Heap::CopyCode(Code* code, Vector<byte> reloc_info) {
 
   Object* result;
   if (new_obj_size > MaxObjectSizeInPagedSpace()) {
-    result = lo_space_->AllocateRawCode(new_obj_size);
+    result = data()->lo_space_->AllocateRawCode(new_obj_size);
   } else {
-    result = code_space_->AllocateRaw(new_obj_size);
+    result = data()->code_space_->AllocateRaw(new_obj_size);
   }
 
   if (result->IsFailure()) return result;
@@ -2392,7 +2737,7 @@ Object* Heap::CopyCode(Code* code, Vector<byte> reloc_info) {
 
 
 Object* Heap::Allocate(Map* map, AllocationSpace space) {
-  ASSERT(gc_state_ == NOT_IN_GC);
+  ASSERT(data()->gc_state_ == NOT_IN_GC);
   ASSERT(map->instance_type() != MAP_TYPE);
   // If allocation failures are disallowed, we may allocate in a different
   // space when new space is full and the object is not a large object.
@@ -2460,7 +2805,7 @@ Object* Heap::AllocateArgumentsObject(Object* callee, int length) {
 
   // This calls Copy directly rather than using Heap::AllocateRaw so we
   // duplicate the check here.
-  ASSERT(allocation_allowed_ && gc_state_ == NOT_IN_GC);
+  ASSERT(data()->allocation_allowed_ && data()->gc_state_ == NOT_IN_GC);
 
   JSObject* boilerplate =
       Top::context()->global_context()->arguments_boilerplate();
@@ -2577,6 +2922,8 @@ Object* Heap::AllocateJSObjectFromMap(Map* map, PretenureFlag pretenure) {
   ASSERT(map->instance_type() != JS_GLOBAL_OBJECT_TYPE);
   ASSERT(map->instance_type() != JS_BUILTINS_OBJECT_TYPE);
 
+  if (map->is_pretenured()) pretenure = TENURED;
+
   // Allocate the backing storage for the properties.
   int prop_size =
       map->pre_allocated_property_fields() +
@@ -2693,12 +3040,16 @@ Object* Heap::CopyJSObject(JSObject* source) {
   // Make the clone.
   Map* map = source->map();
   int object_size = map->instance_size();
+  PretenureFlag pretenure = map->is_pretenured() ? TENURED : NOT_TENURED;
   Object* clone;
 
   // If we're forced to always allocate, we use the general allocation
-  // functions which may leave us with an object in old space.
-  if (always_allocate()) {
-    clone = AllocateRaw(object_size, NEW_SPACE, OLD_POINTER_SPACE);
+  // functions which may leave us with an object in old space.  Objects
+  // that are pretenured are allocated in old space right away.
+  if (always_allocate() || pretenure == TENURED) {
+    AllocationSpace space =
+        (pretenure == TENURED) ? OLD_POINTER_SPACE : NEW_SPACE;
+    clone = AllocateRaw(object_size, space, OLD_POINTER_SPACE);
     if (clone->IsFailure()) return clone;
     Address clone_address = HeapObject::cast(clone)->address();
     CopyBlock(clone_address,
@@ -2709,7 +3060,7 @@ Object* Heap::CopyJSObject(JSObject* source) {
                  JSObject::kHeaderSize,
                  (object_size - JSObject::kHeaderSize) / kPointerSize);
   } else {
-    clone = new_space_.AllocateRaw(object_size);
+    clone = data()->new_space_.AllocateRaw(object_size);
     if (clone->IsFailure()) return clone;
     ASSERT(Heap::InNewSpace(clone));
     // Since we know the clone is allocated in new space, we can copy
@@ -2723,13 +3074,13 @@ Object* Heap::CopyJSObject(JSObject* source) {
   FixedArray* properties = FixedArray::cast(source->properties());
   // Update elements if necessary.
   if (elements->length() > 0) {
-    Object* elem = CopyFixedArray(elements);
+    Object* elem = CopyFixedArray(elements, pretenure);
     if (elem->IsFailure()) return elem;
     JSObject::cast(clone)->set_elements(FixedArray::cast(elem));
   }
   // Update properties if necessary.
   if (properties->length() > 0) {
-    Object* prop = CopyFixedArray(properties);
+    Object* prop = CopyFixedArray(properties, pretenure);
     if (prop->IsFailure()) return prop;
     JSObject::cast(clone)->set_properties(FixedArray::cast(prop));
   }
@@ -2787,31 +3138,33 @@ Object* Heap::AllocateStringFromAscii(Vector<const char> string,
 
 Object* Heap::AllocateStringFromUtf8(Vector<const char> string,
                                      PretenureFlag pretenure) {
-  // Count the number of characters in the UTF-8 string and check if
-  // it is an ASCII string.
+  // If the string is ascii, we do not need to convert the characters
+  // since UTF8 is backwards compatible with ascii.
+  int ascii_length = NonAsciiStart(string.start(), string.length());
+  if (ascii_length == string.length()) {
+    return AllocateStringFromAscii(string, pretenure);
+  }
+
+  // Only the characters after the ASCII prefix need to be decoded to count
+  // them.
+  Vector<const char> rest = string.SubVector(ascii_length, string.length());
   Access<Scanner::Utf8Decoder> decoder(Scanner::utf8_decoder());
-  decoder->Reset(string.start(), string.length());
-  int chars = 0;
-  bool is_ascii = true;
+  decoder->Reset(rest.start(), rest.length());
+  int chars = ascii_length;
   while (decoder->has_more()) {
-    uc32 r = decoder->GetNext();
-    if (r > String::kMaxAsciiCharCode) is_ascii = false;
+    decoder->GetNext();
     chars++;
   }
 
-  // If the string is ascii, we do not need to convert the characters
-  // since UTF8 is backwards compatible with ascii.
-  if (is_ascii) return AllocateStringFromAscii(string, pretenure);
-
   Object* result = AllocateRawTwoByteString(chars, pretenure);
   if (result->IsFailure()) return result;
 
   // Convert and copy the characters into the new object.
-  String* string_result = String::cast(result);
-  decoder->Reset(string.start(), string.length());
-  for (int i = 0; i < chars; i++) {
-    uc32 r = decoder->GetNext();
-    string_result->Set(i, r);
+  uc16* dest = SeqTwoByteString::cast(result)->GetChars();
+  CopyChars(dest, string.start(), ascii_length);
+  decoder->Reset(rest.start(), rest.length());
+  for (int i = ascii_length; i < chars; i++) {
+    dest[i] = static_cast<uc16>(decoder->GetNext());
   }
   return result;
 }
@@ -2895,8 +3248,8 @@ Object* Heap::AllocateInternalSymbol(unibrow::CharacterStream* buffer,
 
   // Allocate string.
   Object* result = (size > MaxObjectSizeInPagedSpace())
-      ? lo_space_->AllocateRaw(size)
-      : old_data_space_->AllocateRaw(size);
+      ? data()->lo_space_->AllocateRaw(size)
+      : data()->old_data_space_->AllocateRaw(size);
   if (result->IsFailure()) return result;
 
   reinterpret_cast<HeapObject*>(result)->set_map(map);
@@ -3001,14 +3354,16 @@ Object* Heap::AllocateRawFixedArray(int length) {
   // Allocate the raw data for a fixed array.
   int size = FixedArray::SizeFor(length);
   return size <= kMaxObjectSizeInNewSpace
-      ? new_space_.AllocateRaw(size)
-      : lo_space_->AllocateRawFixedArray(size);
+      ? data()->new_space_.AllocateRaw(size)
+      : data()->lo_space_->AllocateRawFixedArray(size);
 }
 
 
-Object* Heap::CopyFixedArray(FixedArray* src) {
+Object* Heap::CopyFixedArray(FixedArray* src, PretenureFlag pretenure) {
   int len = src->length();
-  Object* obj = AllocateRawFixedArray(len);
+  Object* obj = (pretenure == TENURED)
+      ? AllocateRawFixedArray(len, TENURED)
+      : AllocateRawFixedArray(len);
   if (obj->IsFailure()) return obj;
   if (Heap::InNewSpace(obj)) {
     HeapObject* dst = HeapObject::cast(obj);
@@ -3190,67 +3545,79 @@ bool Heap::IdleNotification() {
   static const int kIdlesBeforeScavenge = 4;
   static const int kIdlesBeforeMarkSweep = 7;
   static const int kIdlesBeforeMarkCompact = 8;
-  static int number_idle_notifications = 0;
-  static int last_gc_count = gc_count_;
 
   bool uncommit = true;
   bool finished = false;
 
-  if (last_gc_count == gc_count_) {
-    number_idle_notifications++;
+  if (data()->last_idle_notification_gc_count_ == data()->gc_count_) {
+    data()->number_idle_notifications_++;
   } else {
-    number_idle_notifications = 0;
-    last_gc_count = gc_count_;
+    data()->number_idle_notifications_ = 0;
+    data()->last_idle_notification_gc_count_ = data()->gc_count_;
   }
 
-  if (number_idle_notifications == kIdlesBeforeScavenge) {
-    if (contexts_disposed_ > 0) {
+  if (data()->number_idle_notifications_ == kIdlesBeforeScavenge) {
+    if (data()->contexts_disposed_ > 0) {
       HistogramTimerScope scope(&Counters::gc_context);
       CollectAllGarbage(false);
     } else {
       CollectGarbage(0, NEW_SPACE);
     }
-    new_space_.Shrink();
-    last_gc_count = gc_count_;
+    data()->new_space_.Shrink();
+    data()->last_idle_notification_gc_count_ = data()->gc_count_;
 
-  } else if (number_idle_notifications == kIdlesBeforeMarkSweep) {
+  } else if (data()->number_idle_notifications_ == kIdlesBeforeMarkSweep) {
     // Before doing the mark-sweep collections we clear the
     // compilation cache to avoid hanging on to source code and
-    // generated code for cached functions.
-    CompilationCache::Clear();
+    // generated code for cached functions. The long-lived regexps are
+    // bounded in number and kept.
+    CompilationCache::ClearGenerations();
 
     CollectAllGarbage(false);
-    new_space_.Shrink();
-    last_gc_count = gc_count_;
+    data()->new_space_.Shrink();
+    data()->last_idle_notification_gc_count_ = data()->gc_count_;
 
-  } else if (number_idle_notifications == kIdlesBeforeMarkCompact) {
+  } else if (data()->number_idle_notifications_ == kIdlesBeforeMarkCompact) {
     CollectAllGarbage(true);
-    new_space_.Shrink();
-    last_gc_count = gc_count_;
-    number_idle_notifications = 0;
+    data()->new_space_.Shrink();
+    data()->last_idle_notification_gc_count_ = data()->gc_count_;
+    data()->number_idle_notifications_ = 0;
     finished = true;
 
-  } else if (contexts_disposed_ > 0) {
+  } else if (OldGenerationIdleLimitReached()) {
+    // The next scavenge is getting close to being turned into a full
+    // collection.  Do the full collection now while the embedder is idle
+    // instead of in the middle of its next piece of work.
+    if (FLAG_trace_gc) {
+      PrintF("Idle notification: old generation %d bytes, idle limit %d\n",
+             PromotedSpaceSize() + PromotedExternalMemorySize(),
+             data()->old_gen_idle_limit_);
+    }
+    CollectAllGarbage(false);
+    data()->last_idle_notification_gc_count_ = data()->gc_count_;
+    data()->number_idle_notifications_ = 0;
+
+  } else if (data()->contexts_disposed_ > 0) {
     if (FLAG_expose_gc) {
-      contexts_disposed_ = 0;
+      data()->contexts_disposed_ = 0;
     } else {
       HistogramTimerScope scope(&Counters::gc_context);
       CollectAllGarbage(false);
-      last_gc_count = gc_count_;
+      data()->last_idle_notification_gc_count_ = data()->gc_count_;
     }
     // If this is the first idle notification, we reset the
     // notification count to avoid letting idle notifications for
     // context disposal garbage collections start a potentially too
     // aggressive idle GC cycle.
-    if (number_idle_notifications <= 1) {
-      number_idle_notifications = 0;
+    if (data()->number_idle_notifications_ <= 1) {
+      data()->number_idle_notifications_ = 0;
       uncommit = false;
     }
   }
 
   // Make sure that we have no pending context disposals and
   // conditionally uncommit from space.
-  ASSERT(contexts_disposed_ == 0);
+  ASSERT(data()->contexts_disposed_ == 0);
   if (uncommit) Heap::UncommitFromSpace();
   return finished;
 }
@@ -3272,8 +3639,8 @@ void Heap::ReportCodeStatistics(const char* title) {
   PagedSpace::ResetCodeStatistics();
   // We do not look for code in new space, map space, or old space.  If code
   // somehow ends up in those spaces, we would miss it here.
-  code_space_->CollectCodeStatistics();
-  lo_space_->CollectCodeStatistics();
+  data()->code_space_->CollectCodeStatistics();
+  data()->lo_space_->CollectCodeStatistics();
   PagedSpace::ReportCodeStatistics();
 }
 
@@ -3284,10 +3651,10 @@ void Heap::ReportCodeStatistics(const char* title) {
 void Heap::ReportHeapStatistics(const char* title) {
   USE(title);
   PrintF(">>>>>> =============== %s (%d) =============== >>>>>>\n",
-         title, gc_count_);
-  PrintF("mark-compact GC : %d\n", mc_count_);
-  PrintF("old_gen_promotion_limit_ %d\n", old_gen_promotion_limit_);
-  PrintF("old_gen_allocation_limit_ %d\n", old_gen_allocation_limit_);
+         title, data()->gc_count_);
+  PrintF("mark-compact GC : %d\n", data()->mc_count_);
+  PrintF("old_gen_promotion_limit_ %d\n", data()->old_gen_promotion_limit_);
+  PrintF("old_gen_allocation_limit_ %d\n", data()->old_gen_allocation_limit_);
 
   PrintF("\n");
   PrintF("Number of handles : %d\n", HandleScope::NumberOfHandles());
@@ -3297,19 +3664,19 @@ void Heap::ReportHeapStatistics(const char* title) {
   PrintF("Heap statistics : ");
   MemoryAllocator::ReportStatistics();
   PrintF("To space : ");
-  new_space_.ReportStatistics();
+  data()->new_space_.ReportStatistics();
   PrintF("Old pointer space : ");
-  old_pointer_space_->ReportStatistics();
+  data()->old_pointer_space_->ReportStatistics();
   PrintF("Old data space : ");
-  old_data_space_->ReportStatistics();
+  data()->old_data_space_->ReportStatistics();
   PrintF("Code space : ");
-  code_space_->ReportStatistics();
+  data()->code_space_->ReportStatistics();
   PrintF("Map space : ");
-  map_space_->ReportStatistics();
+  data()->map_space_->ReportStatistics();
   PrintF("Cell space : ");
-  cell_space_->ReportStatistics();
+  data()->cell_space_->ReportStatistics();
   PrintF("Large object space : ");
-  lo_space_->ReportStatistics();
+  data()->lo_space_->ReportStatistics();
   PrintF(">>>>>> ========================================= >>>>>>\n");
 }
 
@@ -3323,13 +3690,13 @@ bool Heap::Contains(HeapObject* value) {
 bool Heap::Contains(Address addr) {
   if (OS::IsOutsideAllocatedSpace(addr)) return false;
   return HasBeenSetup() &&
-    (new_space_.ToSpaceContains(addr) ||
-     old_pointer_space_->Contains(addr) ||
-     old_data_space_->Contains(addr) ||
-     code_space_->Contains(addr) ||
-     map_space_->Contains(addr) ||
-     cell_space_->Contains(addr) ||
-     lo_space_->SlowContains(addr));
+    (data()->new_space_.ToSpaceContains(addr) ||
+     data()->old_pointer_space_->Contains(addr) ||
+     data()->old_data_space_->Contains(addr) ||
+     data()->code_space_->Contains(addr) ||
+     data()->map_space_->Contains(addr) ||
+     data()->cell_space_->Contains(addr) ||
+     data()->lo_space_->SlowContains(addr));
 }
 
 
@@ -3344,19 +3711,19 @@ bool Heap::InSpace(Address addr, AllocationSpace space) {
 
   switch (space) {
     case NEW_SPACE:
-      return new_space_.ToSpaceContains(addr);
+      return data()->new_space_.ToSpaceContains(addr);
     case OLD_POINTER_SPACE:
-      return old_pointer_space_->Contains(addr);
+      return data()->old_pointer_space_->Contains(addr);
     case OLD_DATA_SPACE:
-      return old_data_space_->Contains(addr);
+      return data()->old_data_space_->Contains(addr);
     case CODE_SPACE:
-      return code_space_->Contains(addr);
+      return data()->code_space_->Contains(addr);
     case MAP_SPACE:
-      return map_space_->Contains(addr);
+      return data()->map_space_->Contains(addr);
     case CELL_SPACE:
-      return cell_space_->Contains(addr);
+      return data()->cell_space_->Contains(addr);
     case LO_SPACE:
-      return lo_space_->SlowContains(addr);
+      return data()->lo_space_->SlowContains(addr);
   }
 
   return false;
@@ -3413,27 +3780,27 @@ void Heap::Verify() {
   VerifyPointersVisitor visitor;
   IterateRoots(&visitor, VISIT_ONLY_STRONG);
 
-  new_space_.Verify();
+  data()->new_space_.Verify();
 
   VerifyPointersAndDirtyRegionsVisitor dirty_regions_visitor;
-  old_pointer_space_->Verify(&dirty_regions_visitor);
-  map_space_->Verify(&dirty_regions_visitor);
+  data()->old_pointer_space_->Verify(&dirty_regions_visitor);
+  data()->map_space_->Verify(&dirty_regions_visitor);
 
-  VerifyPointersUnderWatermark(old_pointer_space_,
+  VerifyPointersUnderWatermark(data()->old_pointer_space_,
                                &IteratePointersInDirtyRegion);
-  VerifyPointersUnderWatermark(map_space_,
+  VerifyPointersUnderWatermark(data()->map_space_,
                                &IteratePointersInDirtyMapsRegion);
-  VerifyPointersUnderWatermark(lo_space_);
+  VerifyPointersUnderWatermark(data()->lo_space_);
 
-  VerifyPageWatermarkValidity(old_pointer_space_, ALL_INVALID);
-  VerifyPageWatermarkValidity(map_space_, ALL_INVALID);
+  VerifyPageWatermarkValidity(data()->old_pointer_space_, ALL_INVALID);
+  VerifyPageWatermarkValidity(data()->map_space_, ALL_INVALID);
 
   VerifyPointersVisitor no_dirty_regions_visitor;
-  old_data_space_->Verify(&no_dirty_regions_visitor);
-  code_space_->Verify(&no_dirty_regions_visitor);
-  cell_space_->Verify(&no_dirty_regions_visitor);
+  data()->old_data_space_->Verify(&no_dirty_regions_visitor);
+  data()->code_space_->Verify(&no_dirty_regions_visitor);
+  data()->cell_space_->Verify(&no_dirty_regions_visitor);
 
-  lo_space_->Verify();
+  data()->lo_space_->Verify();
 }
 #endif  // DEBUG
 
@@ -3444,7 +3811,7 @@ Object* Heap::LookupSymbol(Vector<const char> string) {
   if (new_table->IsFailure()) return new_table;
   // Can't use set_symbol_table because SymbolTable::cast knows that
   // SymbolTable is a singleton and checks for identity.
-  roots_[kSymbolTableRootIndex] = new_table;
+  data()->roots_[kSymbolTableRootIndex] = new_table;
   ASSERT(symbol != NULL);
   return symbol;
 }
@@ -3457,7 +3824,7 @@ Object* Heap::LookupSymbol(String* string) {
   if (new_table->IsFailure()) return new_table;
   // Can't use set_symbol_table because SymbolTable::cast knows that
   // SymbolTable is a singleton and checks for identity.
-  roots_[kSymbolTableRootIndex] = new_table;
+  data()->roots_[kSymbolTableRootIndex] = new_table;
   ASSERT(symbol != NULL);
   return symbol;
 }
@@ -3475,8 +3842,8 @@ bool Heap::LookupSymbolIfExists(String* string, String** symbol) {
 #ifdef DEBUG
 void Heap::ZapFromSpace() {
   ASSERT(reinterpret_cast<Object*>(kFromSpaceZapValue)->IsHeapObject());
-  for (Address a = new_space_.FromSpaceLow();
-       a < new_space_.FromSpaceHigh();
+  for (Address a = data()->new_space_.FromSpaceLow();
+       a < data()->new_space_.FromSpaceHigh();
        a += kPointerSize) {
     Memory::Address_at(a) = kFromSpaceZapValue;
   }
@@ -3717,8 +4084,8 @@ void Heap::IterateDirtyRegions(
         end = page->CachedAllocationWatermark();
       }
 
-      ASSERT(space == old_pointer_space_ ||
-             (space == map_space_ &&
+      ASSERT(space == data()->old_pointer_space_ ||
+             (space == data()->map_space_ &&
               ((page->ObjectAreaStart() - end) % Map::kSize == 0)));
 
       page->SetRegionMarks(IterateDirtyRegions(marks,
@@ -3742,7 +4109,8 @@ void Heap::IterateRoots(ObjectVisitor* v, VisitMode mode) {
 
 
 void Heap::IterateWeakRoots(ObjectVisitor* v, VisitMode mode) {
-  v->VisitPointer(reinterpret_cast<Object**>(&roots_[kSymbolTableRootIndex]));
+  v->VisitPointer(
+      reinterpret_cast<Object**>(&data()->roots_[kSymbolTableRootIndex]));
   v->Synchronize("symbol_table");
   if (mode != VISIT_ALL_IN_SCAVENGE) {
     // Scavenge collections have special processing for this.
@@ -3753,10 +4121,10 @@ void Heap::IterateWeakRoots(ObjectVisitor* v, VisitMode mode) {
 
 
 void Heap::IterateStrongRoots(ObjectVisitor* v, VisitMode mode) {
-  v->VisitPointers(&roots_[0], &roots_[kStrongRootListLength]);
+  v->VisitPointers(&data()->roots_[0], &data()->roots_[kStrongRootListLength]);
   v->Synchronize("strong_root_list");
 
-  v->VisitPointer(BitCast<Object**, String**>(&hidden_symbol_));
+  v->VisitPointer(BitCast<Object**, String**>(&data()->hidden_symbol_));
   v->Synchronize("symbol");
 
   Bootstrapper::Iterate(v);
@@ -3813,17 +4181,14 @@ void Heap::IterateStrongRoots(ObjectVisitor* v, VisitMode mode) {
 }
 
 
-// Flag is set when the heap has been configured.  The heap can be repeatedly
-// configured through the API until it is setup.
-static bool heap_configured = false;
-
 // TODO(1236194): Since the heap size is configurable on the command line
 // and through the API, we should gracefully handle the case that the heap
 // size is not big enough to fit all the initial objects.
 bool Heap::ConfigureHeap(int max_semispace_size, int max_old_gen_size) {
+  Data* data = Heap::data();
   if (HasBeenSetup()) return false;
 
-  if (max_semispace_size > 0) max_semispace_size_ = max_semispace_size;
+  if (max_semispace_size > 0) data->max_semispace_size_ = max_semispace_size;
 
   if (Snapshot::IsEnabled()) {
     // If we are using a snapshot we always reserve the default amount
@@ -3831,28 +4196,31 @@ bool Heap::ConfigureHeap(int max_semispace_size, int max_old_gen_size) {
     // write-barrier code that relies on the size and alignment of new
     // space.  We therefore cannot use a larger max semispace size
     // than the default reserved semispace size.
-    if (max_semispace_size_ > reserved_semispace_size_) {
-      max_semispace_size_ = reserved_semispace_size_;
+    if (data->max_semispace_size_ > data->reserved_semispace_size_) {
+      data->max_semispace_size_ = data->reserved_semispace_size_;
     }
   } else {
     // If we are not using snapshots we reserve space for the actual
     // max semispace size.
-    reserved_semispace_size_ = max_semispace_size_;
+    data->reserved_semispace_size_ = data->max_semispace_size_;
   }
 
-  if (max_old_gen_size > 0) max_old_generation_size_ = max_old_gen_size;
+  if (max_old_gen_size > 0) data->max_old_generation_size_ = max_old_gen_size;
 
   // The new space size must be a power of two to support single-bit testing
   // for containment.
-  max_semispace_size_ = RoundUpToPowerOf2(max_semispace_size_);
-  reserved_semispace_size_ = RoundUpToPowerOf2(reserved_semispace_size_);
-  initial_semispace_size_ = Min(initial_semispace_size_, max_semispace_size_);
-  external_allocation_limit_ = 10 * max_semispace_size_;
+  data->max_semispace_size_ = RoundUpToPowerOf2(data->max_semispace_size_);
+  data->reserved_semispace_size_ =
+      RoundUpToPowerOf2(data->reserved_semispace_size_);
+  data->initial_semispace_size_ =
+      Min(data->initial_semispace_size_, data->max_semispace_size_);
+  data->external_allocation_limit_ = 10 * data->max_semispace_size_;
 
   // The old generation is paged.
-  max_old_generation_size_ = RoundUp(max_old_generation_size_, Page::kPageSize);
+  data->max_old_generation_size_ =
+      RoundUp(data->max_old_generation_size_, Page::kPageSize);
 
-  heap_configured = true;
+  data->configured_ = true;
   return true;
 }
 
@@ -3863,40 +4231,43 @@ bool Heap::ConfigureHeapDefault() {
 
 
 void Heap::RecordStats(HeapStats* stats) {
+  Data* data = Heap::data();
   *stats->start_marker = 0xDECADE00;
   *stats->end_marker = 0xDECADE01;
-  *stats->new_space_size = new_space_.Size();
-  *stats->new_space_capacity = new_space_.Capacity();
-  *stats->old_pointer_space_size = old_pointer_space_->Size();
-  *stats->old_pointer_space_capacity = old_pointer_space_->Capacity();
-  *stats->old_data_space_size = old_data_space_->Size();
-  *stats->old_data_space_capacity = old_data_space_->Capacity();
-  *stats->code_space_size = code_space_->Size();
-  *stats->code_space_capacity = code_space_->Capacity();
-  *stats->map_space_size = map_space_->Size();
-  *stats->map_space_capacity = map_space_->Capacity();
-  *stats->cell_space_size = cell_space_->Size();
-  *stats->cell_space_capacity = cell_space_->Capacity();
-  *stats->lo_space_size = lo_space_->Size();
+  *stats->new_space_size = data->new_space_.Size();
+  *stats->new_space_capacity = data->new_space_.Capacity();
+  *stats->old_pointer_space_size = data->old_pointer_space_->Size();
+  *stats->old_pointer_space_capacity = data->old_pointer_space_->Capacity();
+  *stats->old_data_space_size = data->old_data_space_->Size();
+  *stats->old_data_space_capacity = data->old_data_space_->Capacity();
+  *stats->code_space_size = data->code_space_->Size();
+  *stats->code_space_capacity = data->code_space_->Capacity();
+  *stats->map_space_size = data->map_space_->Size();
+  *stats->map_space_capacity = data->map_space_->Capacity();
+  *stats->cell_space_size = data->cell_space_->Size();
+  *stats->cell_space_capacity = data->cell_space_->Capacity();
+  *stats->lo_space_size = data->lo_space_->Size();
   GlobalHandles::RecordStats(stats);
 }
 
 
 int Heap::PromotedSpaceSize() {
-  return old_pointer_space_->Size()
-      + old_data_space_->Size()
-      + code_space_->Size()
-      + map_space_->Size()
-      + cell_space_->Size()
-      + lo_space_->Size();
+  Data* data = Heap::data();
+  return data->old_pointer_space_->Size()
+      + data->old_data_space_->Size()
+      + data->code_space_->Size()
+      + data->map_space_->Size()
+      + data->cell_space_->Size()
+      + data->lo_space_->Size();
 }
 
 
 int Heap::PromotedExternalMemorySize() {
-  if (amount_of_external_allocated_memory_
-      <= amount_of_external_allocated_memory_at_last_global_gc_) return 0;
-  return amount_of_external_allocated_memory_
-      - amount_of_external_allocated_memory_at_last_global_gc_;
+  Data* data = Heap::data();
+  if (data->amount_of_external_allocated_memory_
+      <= data->amount_of_external_allocated_memory_at_last_global_gc_) return 0;
+  return data->amount_of_external_allocated_memory_
+      - data->amount_of_external_allocated_memory_at_last_global_gc_;
 }
 
 
@@ -3909,7 +4280,8 @@ bool Heap::Setup(bool create_heap_objects) {
   // Configuration is based on the flags new-space-size (really the semispace
   // size) and old-space-size if set or the initial values of semispace_size_
   // and old_generation_size_ otherwise.
-  if (!heap_configured) {
+  Data* data = Heap::data();
+  if (!data->configured_) {
     if (!ConfigureHeapDefault()) return false;
   }
 
@@ -3919,64 +4291,70 @@ bool Heap::Setup(bool create_heap_objects) {
   // are contiguous and aligned to their size.
   if (!MemoryAllocator::Setup(MaxReserved())) return false;
   void* chunk =
-      MemoryAllocator::ReserveInitialChunk(4 * reserved_semispace_size_);
+      MemoryAllocator::ReserveInitialChunk(4 * data->reserved_semispace_size_);
   if (chunk == NULL) return false;
 
   // Align the pair of semispaces to their size, which must be a power
   // of 2.
   Address new_space_start =
-      RoundUp(reinterpret_cast<byte*>(chunk), 2 * reserved_semispace_size_);
-  if (!new_space_.Setup(new_space_start, 2 * reserved_semispace_size_)) {
+      RoundUp(reinterpret_cast<byte*>(chunk),
+              2 * data->reserved_semispace_size_);
+  if (!data->new_space_.Setup(new_space_start,
+                              2 * data->reserved_semispace_size_)) {
     return false;
   }
 
   // Initialize old pointer space.
-  old_pointer_space_ =
-      new OldSpace(max_old_generation_size_, OLD_POINTER_SPACE, NOT_EXECUTABLE);
-  if (old_pointer_space_ == NULL) return false;
-  if (!old_pointer_space_->Setup(NULL, 0)) return false;
+  data->old_pointer_space_ =
+      new OldSpace(data->max_old_generation_size_,
+                   OLD_POINTER_SPACE,
+                   NOT_EXECUTABLE);
+  if (data->old_pointer_space_ == NULL) return false;
+  if (!data->old_pointer_space_->Setup(NULL, 0)) return false;
 
   // Initialize old data space.
-  old_data_space_ =
-      new OldSpace(max_old_generation_size_, OLD_DATA_SPACE, NOT_EXECUTABLE);
-  if (old_data_space_ == NULL) return false;
-  if (!old_data_space_->Setup(NULL, 0)) return false;
+  data->old_data_space_ =
+      new OldSpace(data->max_old_generation_size_,
+                   OLD_DATA_SPACE,
+                   NOT_EXECUTABLE);
+  if (data->old_data_space_ == NULL) return false;
+  if (!data->old_data_space_->Setup(NULL, 0)) return false;
 
   // Initialize the code space, set its maximum capacity to the old
   // generation size. It needs executable memory.
   // On 64-bit platform(s), we put all code objects in a 2 GB range of
   // virtual address space, so that they can call each other with near calls.
-  if (code_range_size_ > 0) {
-    if (!CodeRange::Setup(code_range_size_)) {
+  if (data->code_range_size_ > 0) {
+    if (!CodeRange::Setup(data->code_range_size_)) {
       return false;
     }
   }
 
-  code_space_ =
-      new OldSpace(max_old_generation_size_, CODE_SPACE, EXECUTABLE);
-  if (code_space_ == NULL) return false;
-  if (!code_space_->Setup(NULL, 0)) return false;
+  data->code_space_ =
+      new OldSpace(data->max_old_generation_size_, CODE_SPACE, EXECUTABLE);
+  if (data->code_space_ == NULL) return false;
+  if (!data->code_space_->Setup(NULL, 0)) return false;
 
   // Initialize map space.
-  map_space_ = new MapSpace(FLAG_use_big_map_space
-      ? max_old_generation_size_
+  data->map_space_ = new MapSpace(FLAG_use_big_map_space
+      ? data->max_old_generation_size_
       : MapSpace::kMaxMapPageIndex * Page::kPageSize,
       FLAG_max_map_space_pages,
       MAP_SPACE);
-  if (map_space_ == NULL) return false;
-  if (!map_space_->Setup(NULL, 0)) return false;
+  if (data->map_space_ == NULL) return false;
+  if (!data->map_space_->Setup(NULL, 0)) return false;
 
   // Initialize global property cell space.
-  cell_space_ = new CellSpace(max_old_generation_size_, CELL_SPACE);
-  if (cell_space_ == NULL) return false;
-  if (!cell_space_->Setup(NULL, 0)) return false;
+  data->cell_space_ = new CellSpace(data->max_old_generation_size_, CELL_SPACE);
+  if (data->cell_space_ == NULL) return false;
+  if (!data->cell_space_->Setup(NULL, 0)) return false;
 
   // The large object code space may contain code or data.  We set the memory
   // to be non-executable here for safety, but this means we need to enable it
   // explicitly when allocating large code objects.
-  lo_space_ = new LargeObjectSpace(LO_SPACE);
-  if (lo_space_ == NULL) return false;
-  if (!lo_space_->Setup()) return false;
+  data->lo_space_ = new LargeObjectSpace(LO_SPACE);
+  if (data->lo_space_ == NULL) return false;
+  if (!data->lo_space_->Setup()) return false;
 
   if (create_heap_objects) {
     // Create initial maps.
@@ -4005,10 +4383,10 @@ void Heap::SetStackLimits() {
 
   // Set up the special root array entries containing the stack limits.
   // These are actually addresses, but the tag makes the GC ignore it.
-  roots_[kStackLimitRootIndex] =
+  data()->roots_[kStackLimitRootIndex] =
       reinterpret_cast<Object*>(
           (StackGuard::jslimit() & ~kSmiTagMask) | kSmiTag);
-  roots_[kRealStackLimitRootIndex] =
+  data()->roots_[kRealStackLimitRootIndex] =
       reinterpret_cast<Object*>(
           (StackGuard::real_jslimit() & ~kSmiTagMask) | kSmiTag);
 }
@@ -4017,9 +4395,9 @@ void Heap::SetStackLimits() {
 void Heap::TearDown() {
   if (FLAG_print_cumulative_gc_stat) {
     PrintF("\n\n");
-    PrintF("gc_count=%d ", gc_count_);
-    PrintF("mark_sweep_count=%d ", ms_count_);
-    PrintF("mark_compact_count=%d ", mc_count_);
+    PrintF("gc_count=%d ", data()->gc_count_);
+    PrintF("mark_sweep_count=%d ", data()->ms_count_);
+    PrintF("mark_compact_count=%d ", data()->mc_count_);
     PrintF("max_gc_pause=%d ", GCTracer::get_max_gc_pause());
     PrintF("min_in_mutator=%d ", GCTracer::get_min_in_mutator());
     PrintF("max_alive_after_gc=%d ", GCTracer::get_max_alive_after_gc());
@@ -4030,42 +4408,46 @@ void Heap::TearDown() {
 
   ExternalStringTable::TearDown();
 
-  new_space_.TearDown();
+  DirtyRegionScanner::TearDown();
+  PretenuringFeedback::TearDown();
+  MarkCompactCollector::TearDown();
 
-  if (old_pointer_space_ != NULL) {
-    old_pointer_space_->TearDown();
-    delete old_pointer_space_;
-    old_pointer_space_ = NULL;
+  data()->new_space_.TearDown();
+
+  if (data()->old_pointer_space_ != NULL) {
+    data()->old_pointer_space_->TearDown();
+    delete data()->old_pointer_space_;
+    data()->old_pointer_space_ = NULL;
   }
 
-  if (old_data_space_ != NULL) {
-    old_data_space_->TearDown();
-    delete old_data_space_;
-    old_data_space_ = NULL;
+  if (data()->old_data_space_ != NULL) {
+    data()->old_data_space_->TearDown();
+    delete data()->old_data_space_;
+    data()->old_data_space_ = NULL;
   }
 
-  if (code_space_ != NULL) {
-    code_space_->TearDown();
-    delete code_space_;
-    code_space_ = NULL;
+  if (data()->code_space_ != NULL) {
+    data()->code_space_->TearDown();
+    delete data()->code_space_;
+    data()->code_space_ = NULL;
   }
 
-  if (map_space_ != NULL) {
-    map_space_->TearDown();
-    delete map_space_;
-    map_space_ = NULL;
+  if (data()->map_space_ != NULL) {
+    data()->map_space_->TearDown();
+    delete data()->map_space_;
+    data()->map_space_ = NULL;
   }
 
-  if (cell_space_ != NULL) {
-    cell_space_->TearDown();
-    delete cell_space_;
-    cell_space_ = NULL;
+  if (data()->cell_space_ != NULL) {
+    data()->cell_space_->TearDown();
+    delete data()->cell_space_;
+    data()->cell_space_ = NULL;
   }
 
-  if (lo_space_ != NULL) {
-    lo_space_->TearDown();
-    delete lo_space_;
-    lo_space_ = NULL;
+  if (data()->lo_space_ != NULL) {
+    data()->lo_space_->TearDown();
+    delete data()->lo_space_;
+    data()->lo_space_ = NULL;
   }
 
   MemoryAllocator::TearDown();
@@ -4105,16 +4487,16 @@ void Heap::Unprotect() {
 void Heap::AddGCPrologueCallback(GCPrologueCallback callback, GCType gc_type) {
   ASSERT(callback != NULL);
   GCPrologueCallbackPair pair(callback, gc_type);
-  ASSERT(!gc_prologue_callbacks_.Contains(pair));
-  return gc_prologue_callbacks_.Add(pair);
+  ASSERT(!data()->gc_prologue_callbacks_.Contains(pair));
+  return data()->gc_prologue_callbacks_.Add(pair);
 }
 
 
 void Heap::RemoveGCPrologueCallback(GCPrologueCallback callback) {
   ASSERT(callback != NULL);
-  for (int i = 0; i < gc_prologue_callbacks_.length(); ++i) {
-    if (gc_prologue_callbacks_[i].callback == callback) {
-      gc_prologue_callbacks_.Remove(i);
+  for (int i = 0; i < data()->gc_prologue_callbacks_.length(); ++i) {
+    if (data()->gc_prologue_callbacks_[i].callback == callback) {
+      data()->gc_prologue_callbacks_.Remove(i);
       return;
     }
   }
@@ -4125,16 +4507,16 @@ void Heap::RemoveGCPrologueCallback(GCPrologueCallback callback) {
 void Heap::AddGCEpilogueCallback(GCEpilogueCallback callback, GCType gc_type) {
   ASSERT(callback != NULL);
   GCEpilogueCallbackPair pair(callback, gc_type);
-  ASSERT(!gc_epilogue_callbacks_.Contains(pair));
-  return gc_epilogue_callbacks_.Add(pair);
+  ASSERT(!data()->gc_epilogue_callbacks_.Contains(pair));
+  return data()->gc_epilogue_callbacks_.Add(pair);
 }
 
 
 void Heap::RemoveGCEpilogueCallback(GCEpilogueCallback callback) {
   ASSERT(callback != NULL);
-  for (int i = 0; i < gc_epilogue_callbacks_.length(); ++i) {
-    if (gc_epilogue_callbacks_[i].callback == callback) {
-      gc_epilogue_callbacks_.Remove(i);
+  for (int i = 0; i < data()->gc_epilogue_callbacks_.length(); ++i) {
+    if (data()->gc_epilogue_callbacks_[i].callback == callback) {
+      data()->gc_epilogue_callbacks_.Remove(i);
       return;
     }
   }
@@ -4522,7 +4904,9 @@ GCTracer::GCTracer()
       marked_count_(0),
       allocated_since_last_gc_(0),
       spent_in_mutator_(0),
-      promoted_objects_size_(0) {
+      promoted_objects_size_(0),
+      flushed_functions_(0),
+      flushed_code_size_(0) {
   // These two fields reflect the state of the previous full collection.
   // Set them before they are changed by the collector.
   previous_has_compacted_ = MarkCompactCollector::HasCompacted();
@@ -4537,31 +4921,34 @@ GCTracer::GCTracer()
 
   in_free_list_or_wasted_before_gc_ = CountTotalHolesSize();
 
-  allocated_since_last_gc_ = Heap::SizeOfObjects() - alive_after_last_gc_;
+  allocated_since_last_gc_ =
+      Heap::SizeOfObjects() - data()->alive_after_last_gc_;
 
-  if (last_gc_end_timestamp_ > 0) {
-    spent_in_mutator_ = Max(start_time_ - last_gc_end_timestamp_, 0.0);
+  if (data()->last_gc_end_timestamp_ > 0) {
+    spent_in_mutator_ = Max(start_time_ - data()->last_gc_end_timestamp_, 0.0);
   }
 }
 
 
 GCTracer::~GCTracer() {
   // Printf ONE line iff flag is set.
+  Data* data = GCTracer::data();
   if (!FLAG_trace_gc && !FLAG_print_cumulative_gc_stat) return;
 
-  bool first_gc = (last_gc_end_timestamp_ == 0);
+  bool first_gc = (data->last_gc_end_timestamp_ == 0);
 
-  alive_after_last_gc_ = Heap::SizeOfObjects();
-  last_gc_end_timestamp_ = OS::TimeCurrentMillis();
+  data->alive_after_last_gc_ = Heap::SizeOfObjects();
+  data->last_gc_end_timestamp_ = OS::TimeCurrentMillis();
 
-  int time = static_cast<int>(last_gc_end_timestamp_ - start_time_);
+  int time = static_cast<int>(data->last_gc_end_timestamp_ - start_time_);
 
   // Update cumulative GC statistics if required.
   if (FLAG_print_cumulative_gc_stat) {
-    max_gc_pause_ = Max(max_gc_pause_, time);
-    max_alive_after_gc_ = Max(max_alive_after_gc_, alive_after_last_gc_);
+    data->max_gc_pause_ = Max(data->max_gc_pause_, time);
+    data->max_alive_after_gc_ =
+        Max(data->max_alive_after_gc_, data->alive_after_last_gc_);
     if (!first_gc) {
-      min_in_mutator_ = Min(min_in_mutator_,
+      data->min_in_mutator_ = Min(data->min_in_mutator_,
                             static_cast<int>(spent_in_mutator_));
     }
   }
@@ -4574,6 +4961,11 @@ GCTracer::~GCTracer() {
            static_cast<double>(start_size_) / MB,
            SizeOfHeapObjects());
 
+    if (flushed_functions_ > 0) {
+      PrintF("flushed %d functions (%.1f KB), ",
+             flushed_functions_,
+             static_cast<double>(flushed_code_size_) / KB);
+    }
     if (external_time > 0) PrintF("%d / ", external_time);
     PrintF("%d ms.\n", time);
   } else {
@@ -4598,6 +4990,8 @@ GCTracer::~GCTracer() {
     PrintF("mark=%d ", static_cast<int>(scopes_[Scope::MC_MARK]));
     PrintF("sweep=%d ", static_cast<int>(scopes_[Scope::MC_SWEEP]));
     PrintF("compact=%d ", static_cast<int>(scopes_[Scope::MC_COMPACT]));
+    PrintF("dirty_regions=%d ",
+           static_cast<int>(scopes_[Scope::SCAVENGE_DIRTY_REGIONS]));
 
     PrintF("total_size_before=%d ", start_size_);
     PrintF("total_size_after=%d ", Heap::SizeOfObjects());
@@ -4606,6 +5000,8 @@ GCTracer::~GCTracer() {
 
     PrintF("allocated=%d ", allocated_since_last_gc_);
     PrintF("promoted=%d ", promoted_objects_size_);
+    PrintF("flushed_functions=%d ", flushed_functions_);
+    PrintF("flushed_code_size=%d ", flushed_code_size_);
 
     PrintF("\n");
   }
@@ -4638,9 +5034,9 @@ int KeyedLookupCache::Hash(Map* map, String* name) {
 
 int KeyedLookupCache::Lookup(Map* map, String* name) {
   int index = Hash(map, name);
-  Key& key = keys_[index];
+  Key& key = data()->keys_[index];
   if ((key.map == map) && key.name->Equals(name)) {
-    return field_offsets_[index];
+    return data()->field_offsets_[index];
   }
   return -1;
 }
@@ -4650,34 +5046,88 @@ void KeyedLookupCache::Update(Map* map, String* name, int field_offset) {
   String* symbol;
   if (Heap::LookupSymbolIfExists(name, &symbol)) {
     int index = Hash(map, symbol);
-    Key& key = keys_[index];
+    Key& key = data()->keys_[index];
     key.map = map;
     key.name = symbol;
-    field_offsets_[index] = field_offset;
+    data()->field_offsets_[index] = field_offset;
   }
 }
 
 
-void KeyedLookupCache::Clear() {
-  for (int index = 0; index < kLength; index++) keys_[index].map = NULL;
-}
+DEFINE_ISOLATE_COMPONENT(KeyedLookupCache)
 
 
-KeyedLookupCache::Key KeyedLookupCache::keys_[KeyedLookupCache::kLength];
+void KeyedLookupCache::Clear() {
+  for (int index = 0; index < kLength; index++) data()->keys_[index].map = NULL;
+}
 
 
-int KeyedLookupCache::field_offsets_[KeyedLookupCache::kLength];
+DEFINE_ISOLATE_COMPONENT(DescriptorLookupCache)
 
 
 void DescriptorLookupCache::Clear() {
-  for (int index = 0; index < kLength; index++) keys_[index].array = NULL;
+  Key* keys = data()->keys_;
+  for (int index = 0; index < kLength; index++) keys[index].array = NULL;
 }
 
 
-DescriptorLookupCache::Key
-DescriptorLookupCache::keys_[DescriptorLookupCache::kLength];
-
-int DescriptorLookupCache::results_[DescriptorLookupCache::kLength];
+int RegExpResultsCache::Hash(String* subject, Object* key) {
+  uint32_t key_hash;
+  if (key->IsString()) {
+    key_hash = String::cast(key)->Hash();
+  } else {
+    // The data array of a regexp, hash its source.
+    FixedArray* data = FixedArray::cast(key);
+    key_hash = String::cast(data->get(JSRegExp::kSourceIndex))->Hash();
+  }
+  return ((subject->Hash() ^ key_hash) & (kRegExpResultsCacheSize - 1)) *
+      kEntrySize;
+}
+
+
+Object* RegExpResultsCache::Lookup(String* subject,
+                                   Object* key,
+                                   ResultsCacheType type,
+                                   Object** last_match) {
+  *last_match = Heap::undefined_value();
+  if (!subject->IsSymbol()) return Heap::undefined_value();
+  FixedArray* cache = GetCache(type);
+  int index = Hash(subject, key);
+  if (cache->get(index + kSubjectIndex) != subject ||
+      cache->get(index + kKeyIndex) != key) {
+    Counters::regexp_results_cache_misses.Increment();
+    return Heap::undefined_value();
+  }
+  Counters::regexp_results_cache_hits.Increment();
+  *last_match = cache->get(index + kLastMatchIndex);
+  return cache->get(index + kResultsIndex);
+}
+
+
+void RegExpResultsCache::Enter(String* subject,
+                               Object* key,
+                               ResultsCacheType type,
+                               Object* results,
+                               Object* last_match) {
+  if (!subject->IsSymbol()) return;
+  FixedArray* cache = GetCache(type);
+  int index = Hash(subject, key);
+  cache->set(index + kSubjectIndex, subject);
+  cache->set(index + kKeyIndex, key);
+  cache->set(index + kResultsIndex, results);
+  cache->set(index + kLastMatchIndex, last_match);
+}
+
+
+void RegExpResultsCache::Clear() {
+  FixedArray* caches[] = { Heap::string_split_cache(),
+                           Heap::string_match_cache() };
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < caches[i]->length(); j++) {
+      caches[i]->set_undefined(j);
+    }
+  }
+}
 
 
 #ifdef DEBUG
@@ -4702,48 +5152,52 @@ TranscendentalCache::TranscendentalCache(TranscendentalCache::Type t)
 }
 
 
-TranscendentalCache* TranscendentalCache::caches_[kNumberOfCaches];
+DEFINE_ISOLATE_COMPONENT(TranscendentalCache)
 
 
 void TranscendentalCache::Clear() {
   for (int i = 0; i < kNumberOfCaches; i++) {
-    if (caches_[i] != NULL) {
-      delete caches_[i];
-      caches_[i] = NULL;
+    if (data()->caches_[i] != NULL) {
+      delete data()->caches_[i];
+      data()->caches_[i] = NULL;
     }
   }
 }
 
 
+DEFINE_ISOLATE_COMPONENT(ExternalStringTable)
+
+
 void ExternalStringTable::CleanUp() {
+  Data* data = ExternalStringTable::data();
   int last = 0;
-  for (int i = 0; i < new_space_strings_.length(); ++i) {
-    if (new_space_strings_[i] == Heap::raw_unchecked_null_value()) continue;
-    if (Heap::InNewSpace(new_space_strings_[i])) {
-      new_space_strings_[last++] = new_space_strings_[i];
+  for (int i = 0; i < data->new_space_strings_.length(); ++i) {
+    if (data->new_space_strings_[i] == Heap::raw_unchecked_null_value()) {
+      continue;
+    }
+    if (Heap::InNewSpace(data->new_space_strings_[i])) {
+      data->new_space_strings_[last++] = data->new_space_strings_[i];
     } else {
-      old_space_strings_.Add(new_space_strings_[i]);
+      data->old_space_strings_.Add(data->new_space_strings_[i]);
     }
   }
-  new_space_strings_.Rewind(last);
+  data->new_space_strings_.Rewind(last);
   last = 0;
-  for (int i = 0; i < old_space_strings_.length(); ++i) {
-    if (old_space_strings_[i] == Heap::raw_unchecked_null_value()) continue;
-    ASSERT(!Heap::InNewSpace(old_space_strings_[i]));
-    old_space_strings_[last++] = old_space_strings_[i];
+  for (int i = 0; i < data->old_space_strings_.length(); ++i) {
+    if (data->old_space_strings_[i] == Heap::raw_unchecked_null_value()) {
+      continue;
+    }
+    ASSERT(!Heap::InNewSpace(data->old_space_strings_[i]));
+    data->old_space_strings_[last++] = data->old_space_strings_[i];
   }
-  old_space_strings_.Rewind(last);
+  data->old_space_strings_.Rewind(last);
   Verify();
 }
 
 
 void ExternalStringTable::TearDown() {
-  new_space_strings_.Free();
-  old_space_strings_.Free();
+  data()->new_space_strings_.Free();
+  data()->old_space_strings_.Free();
 }
 
-
-List<Object*> ExternalStringTable::new_space_strings_;
-List<Object*> ExternalStringTable::old_space_strings_;
-
 } }  // namespace v8::internal
@@ -74,6 +74,8 @@ class ZoneScopeInfo;
   V(Map, cons_ascii_string_map, ConsAsciiStringMap)                            \
   V(Map, external_string_map, ExternalStringMap)                               \
   V(Map, external_ascii_string_map, ExternalAsciiStringMap)                    \
+  V(Map, sliced_string_map, SlicedStringMap)                                  \
+  V(Map, sliced_ascii_string_map, SlicedAsciiStringMap)                        \
   V(Map, undetectable_string_map, UndetectableStringMap)                       \
   V(Map, undetectable_ascii_string_map, UndetectableAsciiStringMap)            \
   V(Map, pixel_array_map, PixelArrayMap)                                       \
@@ -109,6 +111,8 @@ class ZoneScopeInfo;
   V(FixedArray, number_string_cache, NumberStringCache)                        \
   V(FixedArray, single_character_string_cache, SingleCharacterStringCache)     \
   V(FixedArray, natives_source_cache, NativesSourceCache)                      \
+  V(FixedArray, string_split_cache, StringSplitCache)                          \
+  V(FixedArray, string_match_cache, StringMatchCache)                          \
   V(Object, last_script_id, LastScriptId)                                      \
   V(Script, empty_script, EmptyScript)                                         \
   V(Smi, real_stack_limit, RealStackLimit)                                     \
@@ -165,6 +169,7 @@ class ZoneScopeInfo;
   V(Date_symbol, "Date")                                                 \
   V(this_symbol, "this")                                                 \
   V(to_string_symbol, "toString")                                        \
+  V(to_json_symbol, "toJSON")                                            \
   V(char_at_symbol, "CharAt")                                            \
   V(undefined_symbol, "undefined")                                       \
   V(value_of_symbol, "valueOf")                                          \
@@ -211,8 +216,35 @@ typedef bool (*DirtyRegionCallback)(Address start,
                                     ObjectSlotCallback copy_object_func);
 
 
-// The all static Heap captures the interface to the global object heap.
-// All JavaScript contexts by this process share the same object heap.
+// A queue of pointers and maps of to-be-promoted objects during a
+// scavenge collection.
+class PromotionQueue {
+ public:
+  void Initialize(Address start_address) {
+    front_ = rear_ = reinterpret_cast<HeapObject**>(start_address);
+  }
+
+  bool is_empty() { return front_ <= rear_; }
+
+  inline void insert(HeapObject* object, Map* map);
+
+  void remove(HeapObject** object, Map** map) {
+    *object = *(--front_);
+    *map = Map::cast(*(--front_));
+    // Assert no underflow.
+    ASSERT(front_ >= rear_);
+  }
+
+ private:
+  // The front of the queue is higher in memory than the rear.
+  HeapObject** front_;
+  HeapObject** rear_;
+};
+
+
+// The all static Heap captures the interface to the object heap of the
+// current isolate. All JavaScript contexts of an isolate share the same
+// object heap.
 
 class Heap : public AllStatic {
  public:
@@ -243,12 +275,15 @@ class Heap : public AllStatic {
   // we reserve twice the amount needed for those in order to ensure
   // that new space can be aligned to its size.
   static int MaxReserved() {
-    return 4 * reserved_semispace_size_ + max_old_generation_size_;
+    return 4 * data()->reserved_semispace_size_ +
+        data()->max_old_generation_size_;
+  }
+  static int MaxSemiSpaceSize() { return data()->max_semispace_size_; }
+  static int ReservedSemiSpaceSize() {
+    return data()->reserved_semispace_size_;
   }
-  static int MaxSemiSpaceSize() { return max_semispace_size_; }
-  static int ReservedSemiSpaceSize() { return reserved_semispace_size_; }
-  static int InitialSemiSpaceSize() { return initial_semispace_size_; }
-  static int MaxOldGenerationSize() { return max_old_generation_size_; }
+  static int InitialSemiSpaceSize() { return data()->initial_semispace_size_; }
+  static int MaxOldGenerationSize() { return data()->max_old_generation_size_; }
 
   // Returns the capacity of the heap in bytes w/o growing. Heap grows when
   // more spaces are needed until it reaches the limit.
@@ -271,35 +306,39 @@ class Heap : public AllStatic {
   // Return the starting address and a mask for the new space.  And-masking an
   // address with the mask will result in the start address of the new space
   // for all addresses in either semispace.
-  static Address NewSpaceStart() { return new_space_.start(); }
-  static uintptr_t NewSpaceMask() { return new_space_.mask(); }
-  static Address NewSpaceTop() { return new_space_.top(); }
-
-  static NewSpace* new_space() { return &new_space_; }
-  static OldSpace* old_pointer_space() { return old_pointer_space_; }
-  static OldSpace* old_data_space() { return old_data_space_; }
-  static OldSpace* code_space() { return code_space_; }
-  static MapSpace* map_space() { return map_space_; }
-  static CellSpace* cell_space() { return cell_space_; }
-  static LargeObjectSpace* lo_space() { return lo_space_; }
-
-  static bool always_allocate() { return always_allocate_scope_depth_ != 0; }
+  static Address NewSpaceStart() { return data()->new_space_.start(); }
+  static uintptr_t NewSpaceMask() { return data()->new_space_.mask(); }
+  static Address NewSpaceTop() { return data()->new_space_.top(); }
+
+  static NewSpace* new_space() { return &data()->new_space_; }
+  static OldSpace* old_pointer_space() { return data()->old_pointer_space_; }
+  static OldSpace* old_data_space() { return data()->old_data_space_; }
+  static OldSpace* code_space() { return data()->code_space_; }
+  static MapSpace* map_space() { return data()->map_space_; }
+  static CellSpace* cell_space() { return data()->cell_space_; }
+  static LargeObjectSpace* lo_space() { return data()->lo_space_; }
+
+  static bool always_allocate() {
+    return data()->always_allocate_scope_depth_ != 0;
+  }
   static Address always_allocate_scope_depth_address() {
-    return reinterpret_cast<Address>(&always_allocate_scope_depth_);
+    return reinterpret_cast<Address>(&data()->always_allocate_scope_depth_);
   }
   static bool linear_allocation() {
-    return linear_allocation_scope_depth_ != 0;
+    return data()->linear_allocation_scope_depth_ != 0;
   }
 
   static Address* NewSpaceAllocationTopAddress() {
-    return new_space_.allocation_top_address();
+    return data()->new_space_.allocation_top_address();
   }
   static Address* NewSpaceAllocationLimitAddress() {
-    return new_space_.allocation_limit_address();
+    return data()->new_space_.allocation_limit_address();
   }
 
   // Uncommit unused semi space.
-  static bool UncommitFromSpace() { return new_space_.UncommitFromSpace(); }
+  static bool UncommitFromSpace() {
+    return data()->new_space_.UncommitFromSpace();
+  }
 
 #ifdef ENABLE_HEAP_PROTECTION
   // Protect/unprotect the heap by marking all spaces read-only/writable.
@@ -489,7 +528,8 @@ class Heap : public AllStatic {
 
   // Make a copy of src and return it. Returns
   // Failure::RetryAfterGC(requested_bytes, space) if the allocation failed.
-  static Object* CopyFixedArray(FixedArray* src);
+  static Object* CopyFixedArray(FixedArray* src,
+                                PretenureFlag pretenure = NOT_TENURED);
 
   // Allocates a fixed array initialized with the hole values.
   // Returns Failure::RetryAfterGC(requested_bytes, space) if the allocation
@@ -679,7 +719,7 @@ class Heap : public AllStatic {
   static void CollectAllGarbage(bool force_compaction);
 
   // Notify the heap that a context has been disposed.
-  static int NotifyContextDisposed() { return ++contexts_disposed_; }
+  static int NotifyContextDisposed() { return ++data()->contexts_disposed_; }
 
   // Utility to invoke the scavenger. This is needed in test code to
   // ensure correct callback for weak global handles.
@@ -699,22 +739,22 @@ class Heap : public AllStatic {
   static void RemoveGCEpilogueCallback(GCEpilogueCallback callback);
 
   static void SetGlobalGCPrologueCallback(GCCallback callback) {
-    ASSERT((callback == NULL) ^ (global_gc_prologue_callback_ == NULL));
-    global_gc_prologue_callback_ = callback;
+    ASSERT((callback == NULL) ^ (data()->global_gc_prologue_callback_ == NULL));
+    data()->global_gc_prologue_callback_ = callback;
   }
   static void SetGlobalGCEpilogueCallback(GCCallback callback) {
-    ASSERT((callback == NULL) ^ (global_gc_epilogue_callback_ == NULL));
-    global_gc_epilogue_callback_ = callback;
+    ASSERT((callback == NULL) ^ (data()->global_gc_epilogue_callback_ == NULL));
+    data()->global_gc_epilogue_callback_ = callback;
   }
 
   // Heap root getters.  We have versions with and without type::cast() here.
   // You can't use type::cast during GC because the assert fails.
 #define ROOT_ACCESSOR(type, name, camel_name)                                  \
   static inline type* name() {                                                 \
-    return type::cast(roots_[k##camel_name##RootIndex]);                       \
+    return type::cast(data()->roots_[k##camel_name##RootIndex]);               \
   }                                                                            \
   static inline type* raw_unchecked_##name() {                                 \
-    return reinterpret_cast<type*>(roots_[k##camel_name##RootIndex]);          \
+    return reinterpret_cast<type*>(data()->roots_[k##camel_name##RootIndex]);  \
   }
   ROOT_LIST(ROOT_ACCESSOR)
 #undef ROOT_ACCESSOR
@@ -722,20 +762,20 @@ class Heap : public AllStatic {
 // Utility type maps
 #define STRUCT_MAP_ACCESSOR(NAME, Name, name)                                  \
     static inline Map* name##_map() {                                          \
-      return Map::cast(roots_[k##Name##MapRootIndex]);                         \
+      return Map::cast(data()->roots_[k##Name##MapRootIndex]);                 \
     }
   STRUCT_LIST(STRUCT_MAP_ACCESSOR)
 #undef STRUCT_MAP_ACCESSOR
 
 #define SYMBOL_ACCESSOR(name, str) static inline String* name() {              \
-    return String::cast(roots_[k##name##RootIndex]);                           \
+    return String::cast(data()->roots_[k##name##RootIndex]);                   \
   }
   SYMBOL_LIST(SYMBOL_ACCESSOR)
 #undef SYMBOL_ACCESSOR
 
   // The hidden_symbol is special because it is the empty string, but does
   // not match the empty string.
-  static String* hidden_symbol() { return hidden_symbol_; }
+  static String* hidden_symbol() { return data()->hidden_symbol_; }
 
   // Iterates over all roots in the heap.
   static void IterateRoots(ObjectVisitor* v, VisitMode mode);
@@ -814,23 +854,23 @@ class Heap : public AllStatic {
 
   // Sets the stub_cache_ (only used when expanding the dictionary).
   static void public_set_code_stubs(NumberDictionary* value) {
-    roots_[kCodeStubsRootIndex] = value;
+    data()->roots_[kCodeStubsRootIndex] = value;
   }
 
   // Sets the non_monomorphic_cache_ (only used when expanding the dictionary).
   static void public_set_non_monomorphic_cache(NumberDictionary* value) {
-    roots_[kNonMonomorphicCacheRootIndex] = value;
+    data()->roots_[kNonMonomorphicCacheRootIndex] = value;
   }
 
   static void public_set_empty_script(Script* script) {
-    roots_[kEmptyScriptRootIndex] = script;
+    data()->roots_[kEmptyScriptRootIndex] = script;
   }
 
   // Update the next script id.
   static inline void SetLastScriptId(Object* last_script_id);
 
   // Generated code can embed this address to get access to the roots.
-  static Object** roots_address() { return roots_; }
+  static Object** roots_address() { return data()->roots_; }
 
 #ifdef DEBUG
   static void Print();
@@ -872,14 +912,18 @@ class Heap : public AllStatic {
   static void Shrink();
 
   enum HeapState { NOT_IN_GC, SCAVENGE, MARK_COMPACT };
-  static inline HeapState gc_state() { return gc_state_; }
+  static inline HeapState gc_state() { return data()->gc_state_; }
+
+  // Returns the number of garbage collections so far.  Objects are neither
+  // moved nor freed while it stays the same.
+  static int gc_count() { return data()->gc_count_; }
 
 #ifdef DEBUG
-  static bool IsAllocationAllowed() { return allocation_allowed_; }
+  static bool IsAllocationAllowed() { return data()->allocation_allowed_; }
   static inline bool allow_allocation(bool enable);
 
   static bool disallow_allocation_failure() {
-    return disallow_allocation_failure_;
+    return data()->disallow_allocation_failure_;
   }
 
   static void TracePathToObject(Object* target);
@@ -937,11 +981,11 @@ class Heap : public AllStatic {
   // should force the next GC (caused normally) to be a full one.
   static bool OldGenerationPromotionLimitReached() {
     return (PromotedSpaceSize() + PromotedExternalMemorySize())
-           > old_gen_promotion_limit_;
+           > data()->old_gen_promotion_limit_;
   }
 
   static intptr_t OldGenerationSpaceAvailable() {
-    return old_gen_allocation_limit_ -
+    return data()->old_gen_allocation_limit_ -
            (PromotedSpaceSize() + PromotedExternalMemorySize());
   }
 
@@ -951,6 +995,14 @@ class Heap : public AllStatic {
     return OldGenerationSpaceAvailable() < 0;
   }
 
+  // True if the old generation has grown far enough towards the promotion
+  // limit that a full GC is better done now, if the embedder is idle, than
+  // during the next scavenge.
+  static bool OldGenerationIdleLimitReached() {
+    return (PromotedSpaceSize() + PromotedExternalMemorySize())
+           > data()->old_gen_idle_limit_;
+  }
+
   // Can be called when the embedding application is idle.
   static bool IdleNotification();
 
@@ -1003,7 +1055,7 @@ class Heap : public AllStatic {
   static void CheckNewSpaceExpansionCriteria();
 
   static inline void IncrementYoungSurvivorsCounter(int survived) {
-    survived_since_last_expansion_ += survived;
+    data()->survived_since_last_expansion_ += survived;
   }
 
   static void UpdateNewSpaceReferencesInExternalStringTable(
@@ -1019,100 +1071,28 @@ class Heap : public AllStatic {
 
   static void ClearJSFunctionResultCaches();
 
-  static GCTracer* tracer() { return tracer_; }
+  static GCTracer* tracer() { return data()->tracer_; }
 
  private:
-  static int reserved_semispace_size_;
-  static int max_semispace_size_;
-  static int initial_semispace_size_;
-  static int max_old_generation_size_;
-  static size_t code_range_size_;
-
-  // For keeping track of how much data has survived
-  // scavenge since last new space expansion.
-  static int survived_since_last_expansion_;
-
-  static int always_allocate_scope_depth_;
-  static int linear_allocation_scope_depth_;
-
-  // For keeping track of context disposals.
-  static int contexts_disposed_;
-
 #if defined(V8_TARGET_ARCH_X64)
   static const int kMaxObjectSizeInNewSpace = 512*KB;
 #else
   static const int kMaxObjectSizeInNewSpace = 256*KB;
 #endif
 
-  static NewSpace new_space_;
-  static OldSpace* old_pointer_space_;
-  static OldSpace* old_data_space_;
-  static OldSpace* code_space_;
-  static MapSpace* map_space_;
-  static CellSpace* cell_space_;
-  static LargeObjectSpace* lo_space_;
-  static HeapState gc_state_;
-
   // Returns the size of object residing in non new spaces.
   static int PromotedSpaceSize();
 
   // Returns the amount of external memory registered since last global gc.
   static int PromotedExternalMemorySize();
 
-  static int mc_count_;  // how many mark-compact collections happened
-  static int ms_count_;  // how many mark-sweep collections happened
-  static int gc_count_;  // how many gc happened
-
-  // Total length of the strings we failed to flatten since the last GC.
-  static int unflattened_strings_length_;
-
 #define ROOT_ACCESSOR(type, name, camel_name)                                  \
   static inline void set_##name(type* value) {                                 \
-    roots_[k##camel_name##RootIndex] = value;                                  \
+    data()->roots_[k##camel_name##RootIndex] = value;                          \
   }
   ROOT_LIST(ROOT_ACCESSOR)
 #undef ROOT_ACCESSOR
 
-#ifdef DEBUG
-  static bool allocation_allowed_;
-
-  // If the --gc-interval flag is set to a positive value, this
-  // variable holds the value indicating the number of allocations
-  // remain until the next failure and garbage collection.
-  static int allocation_timeout_;
-
-  // Do we expect to be able to handle allocation failure at this
-  // time?
-  static bool disallow_allocation_failure_;
-#endif  // DEBUG
-
-  // Limit that triggers a global GC on the next (normally caused) GC.  This
-  // is checked when we have already decided to do a GC to help determine
-  // which collector to invoke.
-  static int old_gen_promotion_limit_;
-
-  // Limit that triggers a global GC as soon as is reasonable.  This is
-  // checked before expanding a paged space in the old generation and on
-  // every allocation in large object space.
-  static int old_gen_allocation_limit_;
-
-  // Limit on the amount of externally allocated memory allowed
-  // between global GCs. If reached a global GC is forced.
-  static int external_allocation_limit_;
-
-  // The amount of external memory registered through the API kept alive
-  // by global handles
-  static int amount_of_external_allocated_memory_;
-
-  // Caches the amount of external memory registered at the last global gc.
-  static int amount_of_external_allocated_memory_at_last_global_gc_;
-
-  // Indicates that an allocation has failed in the old generation since the
-  // last GC.
-  static int old_gen_exhausted_;
-
-  static Object* roots_[kRootListLength];
-
   struct StringTypeTable {
     InstanceType type;
     int size;
@@ -1134,10 +1114,6 @@ class Heap : public AllStatic {
   static const ConstantSymbolTable constant_symbol_table[];
   static const StructTable struct_table[];
 
-  // The special hidden symbol which is an empty string, but does not match
-  // any string when looked up in properties.
-  static String* hidden_symbol_;
-
   // GC callback function, called before and after mark-compact GC.
   // Allocations in the callback function are disallowed.
   struct GCPrologueCallbackPair {
@@ -1150,7 +1126,6 @@ class Heap : public AllStatic {
     GCPrologueCallback callback;
     GCType gc_type;
   };
-  static List<GCPrologueCallbackPair> gc_prologue_callbacks_;
 
   struct GCEpilogueCallbackPair {
     GCEpilogueCallbackPair(GCEpilogueCallback callback, GCType gc_type)
@@ -1162,10 +1137,6 @@ class Heap : public AllStatic {
     GCEpilogueCallback callback;
     GCType gc_type;
   };
-  static List<GCEpilogueCallbackPair> gc_epilogue_callbacks_;
-
-  static GCCallback global_gc_prologue_callback_;
-  static GCCallback global_gc_epilogue_callback_;
 
   // Checks whether a global GC is necessary
   static GarbageCollector SelectGarbageCollector(AllocationSpace space);
@@ -1258,21 +1229,134 @@ class Heap : public AllStatic {
                                            SharedFunctionInfo* shared,
                                            Object* prototype);
 
-  static GCTracer* tracer_;
-
 
   // Initializes the number to string cache based on the max semispace size.
   static Object* InitializeNumberStringCache();
   // Flush the number to string cache.
   static void FlushNumberStringCache();
 
-  // Flush code from functions we do not expect to use again. The code will
-  // be replaced with a lazy compilable version.
-  static void FlushCode();
+  // Age the code of all compiled functions and flush it from functions
+  // that have not been found on a stack for --max_code_age full
+  // collections. The code will be replaced with a lazy compilable version.
+  static void FlushCode(GCTracer* tracer);
 
   static const int kInitialSymbolTableSize = 2048;
   static const int kInitialEvalCacheSize = 64;
 
+  // The state of the heap of an isolate.
+  class Data {
+   public:
+    Data();
+
+    int reserved_semispace_size_;
+    int max_semispace_size_;
+    int initial_semispace_size_;
+    int max_old_generation_size_;
+    size_t code_range_size_;
+
+    // For keeping track of how much data has survived
+    // scavenge since last new space expansion.
+    int survived_since_last_expansion_;
+
+    int always_allocate_scope_depth_;
+    int linear_allocation_scope_depth_;
+
+    // For keeping track of context disposals.
+    int contexts_disposed_;
+
+    NewSpace new_space_;
+    OldSpace* old_pointer_space_;
+    OldSpace* old_data_space_;
+    OldSpace* code_space_;
+    MapSpace* map_space_;
+    CellSpace* cell_space_;
+    LargeObjectSpace* lo_space_;
+    HeapState gc_state_;
+
+    int mc_count_;  // how many mark-compact collections happened
+    int ms_count_;  // how many mark-sweep collections happened
+    int gc_count_;  // how many gc happened
+
+    // Total length of the strings we failed to flatten since the last GC.
+    int unflattened_strings_length_;
+
+#ifdef DEBUG
+    bool allocation_allowed_;
+
+    // If the --gc-interval flag is set to a positive value, this
+    // variable holds the value indicating the number of allocations
+    // remain until the next failure and garbage collection.
+    int allocation_timeout_;
+
+    // Do we expect to be able to handle allocation failure at this
+    // time?
+    bool disallow_allocation_failure_;
+#endif  // DEBUG
+
+    // Limit that triggers a global GC on the next (normally caused) GC.  This
+    // is checked when we have already decided to do a GC to help determine
+    // which collector to invoke.
+    int old_gen_promotion_limit_;
+
+    // Limit that triggers a global GC on the next idle notification.  It is
+    // half way between the size of the old generation after the last global
+    // GC and the promotion limit.  Until the first global GC it is the
+    // promotion limit, as the old generation of a fresh heap is mostly the
+    // deserialized snapshot.
+    int old_gen_idle_limit_;
+
+    // Limit that triggers a global GC as soon as is reasonable.  This is
+    // checked before expanding a paged space in the old generation and on
+    // every allocation in large object space.
+    int old_gen_allocation_limit_;
+
+    // Limit on the amount of externally allocated memory allowed
+    // between global GCs. If reached a global GC is forced.
+    int external_allocation_limit_;
+
+    // The amount of external memory registered through the API kept alive
+    // by global handles
+    int amount_of_external_allocated_memory_;
+
+    // Caches the amount of external memory registered at the last global gc.
+    int amount_of_external_allocated_memory_at_last_global_gc_;
+
+    // Indicates that an allocation has failed in the old generation since
+    // the last GC.
+    int old_gen_exhausted_;
+
+    Object* roots_[kRootListLength];
+
+    // The special hidden symbol which is an empty string, but does not match
+    // any string when looked up in properties.
+    String* hidden_symbol_;
+
+    List<GCPrologueCallbackPair> gc_prologue_callbacks_;
+    List<GCEpilogueCallbackPair> gc_epilogue_callbacks_;
+
+    GCCallback global_gc_prologue_callback_;
+    GCCallback global_gc_epilogue_callback_;
+
+    GCTracer* tracer_;
+
+    // Shared state read by the scavenge collector and set by ScavengeObject.
+    PromotionQueue promotion_queue_;
+
+    // Set when the heap has been configured.  The heap can be repeatedly
+    // configured through the API until it is setup.
+    bool configured_;
+
+    // The state of IdleNotification.
+    int number_idle_notifications_;
+    int last_idle_notification_gc_count_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kHeapData));
+  }
+
+  friend class Isolate;
   friend class Factory;
   friend class DisallowAllocationFailure;
   friend class AlwaysAllocateScope;
@@ -1312,13 +1396,13 @@ class AlwaysAllocateScope {
     // non-handle code to call handle code. The code still works but
     // performance will degrade, so we want to catch this situation
     // in debug mode.
-    ASSERT(Heap::always_allocate_scope_depth_ == 0);
-    Heap::always_allocate_scope_depth_++;
+    ASSERT(Heap::data()->always_allocate_scope_depth_ == 0);
+    Heap::data()->always_allocate_scope_depth_++;
   }
 
   ~AlwaysAllocateScope() {
-    Heap::always_allocate_scope_depth_--;
-    ASSERT(Heap::always_allocate_scope_depth_ == 0);
+    Heap::data()->always_allocate_scope_depth_--;
+    ASSERT(Heap::data()->always_allocate_scope_depth_ == 0);
   }
 };
 
@@ -1326,12 +1410,12 @@ class AlwaysAllocateScope {
 class LinearAllocationScope {
  public:
   LinearAllocationScope() {
-    Heap::linear_allocation_scope_depth_++;
+    Heap::data()->linear_allocation_scope_depth_++;
   }
 
   ~LinearAllocationScope() {
-    Heap::linear_allocation_scope_depth_--;
-    ASSERT(Heap::linear_allocation_scope_depth_ >= 0);
+    Heap::data()->linear_allocation_scope_depth_--;
+    ASSERT(Heap::data()->linear_allocation_scope_depth_ >= 0);
   }
 };
 
@@ -1483,21 +1567,30 @@ class KeyedLookupCache {
   // Get the address of the keys and field_offsets arrays.  Used in
   // generated code to perform cache lookups.
   static Address keys_address() {
-    return reinterpret_cast<Address>(&keys_);
+    return reinterpret_cast<Address>(&data()->keys_);
   }
 
   static Address field_offsets_address() {
-    return reinterpret_cast<Address>(&field_offsets_);
+    return reinterpret_cast<Address>(&data()->field_offsets_);
   }
 
   struct Key {
     Map* map;
     String* name;
   };
-  static Key keys_[kLength];
-  static int field_offsets_[kLength];
+  class Data {
+   public:
+    Key keys_[kLength];
+    int field_offsets_[kLength];
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kKeyedLookupCacheData));
+  }
 
   friend class ExternalReference;
+  friend class Isolate;
 };
 
 
@@ -1512,8 +1605,10 @@ class DescriptorLookupCache {
   static int Lookup(DescriptorArray* array, String* name) {
     if (!StringShape(name).IsSymbol()) return kAbsent;
     int index = Hash(array, name);
-    Key& key = keys_[index];
-    if ((key.array == array) && (key.name == name)) return results_[index];
+    Key& key = data()->keys_[index];
+    if ((key.array == array) && (key.name == name)) {
+      return data()->results_[index];
+    }
     return kAbsent;
   }
 
@@ -1522,10 +1617,10 @@ class DescriptorLookupCache {
     ASSERT(result != kAbsent);
     if (StringShape(name).IsSymbol()) {
       int index = Hash(array, name);
-      Key& key = keys_[index];
+      Key& key = data()->keys_[index];
       key.array = array;
       key.name = name;
-      results_[index] = result;
+      data()->results_[index] = result;
     }
   }
 
@@ -1549,8 +1644,67 @@ class DescriptorLookupCache {
     String* name;
   };
 
-  static Key keys_[kLength];
-  static int results_[kLength];
+  class Data {
+   public:
+    Key keys_[kLength];
+    int results_[kLength];
+  };
+
+  static Data* data() {
+    Isolate* isolate = Isolate::Current();
+    return static_cast<Data*>(
+        isolate->component_data(Isolate::kDescriptorLookupCacheData));
+  }
+
+  friend class Isolate;
+};
+
+
+// Cache for the results of splitting and globally matching symbols, keyed
+// by the subject and either the separator string or the data array of the
+// regexp.  For regexps the capture offsets of the last match are cached
+// along with the results, so that the last match info can be updated on a
+// hit.  The cache arrays are heap roots and are cleared prior to mark-compact
+// collections.
+class RegExpResultsCache : public AllStatic {
+ public:
+  enum ResultsCacheType {
+    STRING_SPLIT,
+    STRING_MATCH
+  };
+
+  // Returns the cached results for (subject, key), or undefined if absent.
+  // *last_match is set to the cached capture offsets, or undefined.
+  static Object* Lookup(String* subject,
+                        Object* key,
+                        ResultsCacheType type,
+                        Object** last_match);
+
+  // Enters results for (subject, key) into the cache.  Does nothing unless
+  // the subject is a symbol.
+  static void Enter(String* subject,
+                    Object* key,
+                    ResultsCacheType type,
+                    Object* results,
+                    Object* last_match);
+
+  // Clear the caches.
+  static void Clear();
+
+  static const int kRegExpResultsCacheSize = 0x100;
+  static const int kEntrySize = 4;
+
+ private:
+  static FixedArray* GetCache(ResultsCacheType type) {
+    return type == STRING_SPLIT ?
+        Heap::string_split_cache() : Heap::string_match_cache();
+  }
+  static int Hash(String* subject, Object* key);
+
+  static const int kSubjectIndex = 0;
+  static const int kKeyIndex = 1;
+  static const int kResultsIndex = 2;
+  static const int kLastMatchIndex = 3;
 };
 
 
@@ -1614,11 +1768,11 @@ class MarkingStack {
 class DisallowAllocationFailure {
  public:
   DisallowAllocationFailure() {
-    old_state_ = Heap::disallow_allocation_failure_;
-    Heap::disallow_allocation_failure_ = true;
+    old_state_ = Heap::data()->disallow_allocation_failure_;
+    Heap::data()->disallow_allocation_failure_ = true;
   }
   ~DisallowAllocationFailure() {
-    Heap::disallow_allocation_failure_ = old_state_;
+    Heap::data()->disallow_allocation_failure_ = old_state_;
   }
  private:
   bool old_state_;
@@ -1680,6 +1834,7 @@ class GCTracer BASE_EMBEDDED {
       MC_MARK,
       MC_SWEEP,
       MC_COMPACT,
+      SCAVENGE_DIRTY_REGIONS,
       kNumberOfScopes
     };
 
@@ -1719,6 +1874,7 @@ class GCTracer BASE_EMBEDDED {
   // Increment and decrement the count of marked objects.
   void increment_marked_count() { ++marked_count_; }
   void decrement_marked_count() { --marked_count_; }
+  void add_marked_count(int count) { marked_count_ += count; }
 
   int marked_count() { return marked_count_; }
 
@@ -1726,14 +1882,20 @@ class GCTracer BASE_EMBEDDED {
     promoted_objects_size_ += object_size;
   }
 
+  // Records code flushed from functions before a full GC.
+  void add_flushed_code(int functions, int code_size) {
+    flushed_functions_ += functions;
+    flushed_code_size_ += code_size;
+  }
+
   // Returns maximum GC pause.
-  static int get_max_gc_pause() { return max_gc_pause_; }
+  static int get_max_gc_pause() { return data()->max_gc_pause_; }
 
   // Returns maximum size of objects alive after GC.
-  static int get_max_alive_after_gc() { return max_alive_after_gc_; }
+  static int get_max_alive_after_gc() { return data()->max_alive_after_gc_; }
 
   // Returns minimal interval between two subsequent collections.
-  static int get_min_in_mutator() { return min_in_mutator_; }
+  static int get_min_in_mutator() { return data()->min_in_mutator_; }
 
  private:
   // Returns a string matching the collector.
@@ -1790,19 +1952,37 @@ class GCTracer BASE_EMBEDDED {
   // Size of objects promoted during the current collection.
   int promoted_objects_size_;
 
-  // Maximum GC pause.
-  static int max_gc_pause_;
+  // Number of functions whose code was flushed during the current
+  // collection and the total size of the flushed code.
+  int flushed_functions_;
+  int flushed_code_size_;
+
+  // Statistics kept across collections.
+  class Data {
+   public:
+    Data() : min_in_mutator_(kMaxInt) { }
+
+    // Maximum GC pause.
+    int max_gc_pause_;
+
+    // Maximum size of objects alive after GC.
+    int max_alive_after_gc_;
 
-  // Maximum size of objects alive after GC.
-  static int max_alive_after_gc_;
+    // Minimal interval between two subsequent collections.
+    int min_in_mutator_;
 
-  // Minimal interval between two subsequent collections.
-  static int min_in_mutator_;
+    // Size of objects alive after last GC.
+    int alive_after_last_gc_;
 
-  // Size of objects alive after last GC.
-  static int alive_after_last_gc_;
+    double last_gc_end_timestamp_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kGCTracerData));
+  }
 
-  static double last_gc_end_timestamp_;
+  friend class Isolate;
 };
 
 
@@ -1815,9 +1995,9 @@ class TranscendentalCache {
   // Returns a heap number with f(input), where f is a math function specified
   // by the 'type' argument.
   static inline Object* Get(Type type, double input) {
-    TranscendentalCache* cache = caches_[type];
+    TranscendentalCache* cache = data()->caches_[type];
     if (cache == NULL) {
-      caches_[type] = cache = new TranscendentalCache(type);
+      data()->caches_[type] = cache = new TranscendentalCache(type);
     }
     return cache->Get(input);
   }
@@ -1889,7 +2069,7 @@ class TranscendentalCache {
 
   static Address cache_array_address() {
     // Used to create an external reference.
-    return reinterpret_cast<Address>(caches_);
+    return reinterpret_cast<Address>(data()->caches_);
   }
 
   // Allow access to the caches_ array as an ExternalReference.
@@ -1897,7 +2077,18 @@ class TranscendentalCache {
   // Inline implementation of the caching.
   friend class TranscendentalCacheStub;
 
-  static TranscendentalCache* caches_[kNumberOfCaches];
+  class Data {
+   public:
+    TranscendentalCache* caches_[kNumberOfCaches];
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kTranscendentalCacheData));
+  }
+
+  friend class Isolate;
+
   Element elements_[kCacheSize];
   Type type_;
 };
@@ -1932,8 +2123,18 @@ class ExternalStringTable : public AllStatic {
 
   // To speed up scavenge collections new space string are kept
   // separate from old space strings.
-  static List<Object*> new_space_strings_;
-  static List<Object*> old_space_strings_;
+  class Data {
+   public:
+    List<Object*> new_space_strings_;
+    List<Object*> old_space_strings_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kExternalStringTableData));
+  }
+
+  friend class Isolate;
 };
 
 } }  // namespace v8::internal
@@ -49,18 +49,17 @@ namespace internal {
 // Implementation of CpuFeatures
 
 // Safe default is no features.
-uint64_t CpuFeatures::supported_ = 0;
-uint64_t CpuFeatures::enabled_ = 0;
-uint64_t CpuFeatures::found_by_runtime_probing_ = 0;
+DEFINE_ISOLATE_COMPONENT(CpuFeatures)
 
 
 // The Probe method needs executable memory, so it uses Heap::CreateCode.
 // Allocation failure is silent and leads to safe default.
 void CpuFeatures::Probe() {
+  Data* data = CpuFeatures::data();
   ASSERT(Heap::HasBeenSetup());
-  ASSERT(supported_ == 0);
+  ASSERT(data->supported_ == 0);
   if (Serializer::enabled()) {
-    supported_ |= OS::CpuFeaturesImpliedByPlatform();
+    data->supported_ |= OS::CpuFeaturesImpliedByPlatform();
     return;  // No features if we might serialize.
   }
 
@@ -96,11 +95,11 @@ void CpuFeatures::Probe() {
   // safe here.
   __ bind(&cpuid);
   __ mov(eax, 1);
-  supported_ = (1 << CPUID);
+  data->supported_ = (1 << CPUID);
   { Scope fscope(CPUID);
     __ cpuid();
   }
-  supported_ = 0;
+  data->supported_ = 0;
 
   // Move the result from ecx:edx to edx:eax and make sure to mark the
   // CPUID feature as supported.
@@ -129,11 +128,11 @@ void CpuFeatures::Probe() {
                           Code::cast(code), "CpuFeatures::Probe"));
   typedef uint64_t (*F0)();
   F0 probe = FUNCTION_CAST<F0>(Code::cast(code)->entry());
-  supported_ = probe();
-  found_by_runtime_probing_ = supported_;
+  data->supported_ = probe();
+  data->found_by_runtime_probing_ = data->supported_;
   uint64_t os_guarantees = OS::CpuFeaturesImpliedByPlatform();
-  supported_ |= os_guarantees;
-  found_by_runtime_probing_ &= ~os_guarantees;
+  data->supported_ |= os_guarantees;
+  data->found_by_runtime_probing_ &= ~os_guarantees;
 }
 
 
@@ -291,7 +290,7 @@ static void InitCoverageLog();
 #endif
 
 // Spare buffer.
-byte* Assembler::spare_buffer_ = NULL;
+DEFINE_ISOLATE_COMPONENT(Assembler)
 
 Assembler::Assembler(void* buffer, int buffer_size) {
   if (buffer == NULL) {
@@ -299,9 +298,10 @@ Assembler::Assembler(void* buffer, int buffer_size) {
     if (buffer_size <= kMinimalBufferSize) {
       buffer_size = kMinimalBufferSize;
 
-      if (spare_buffer_ != NULL) {
-        buffer = spare_buffer_;
-        spare_buffer_ = NULL;
+      Data* data = Assembler::data();
+      if (data->spare_buffer_ != NULL) {
+        buffer = data->spare_buffer_;
+        data->spare_buffer_ = NULL;
       }
     }
     if (buffer == NULL) {
@@ -346,8 +346,9 @@ Assembler::Assembler(void* buffer, int buffer_size) {
 
 Assembler::~Assembler() {
   if (own_buffer_) {
-    if (spare_buffer_ == NULL && buffer_size_ == kMinimalBufferSize) {
-      spare_buffer_ = buffer_;
+    Data* data = Assembler::data();
+    if (data->spare_buffer_ == NULL && buffer_size_ == kMinimalBufferSize) {
+      data->spare_buffer_ = buffer_;
     } else {
       DeleteArray(buffer_);
     }
@@ -2465,8 +2466,9 @@ void Assembler::GrowBuffer() {
           reloc_info_writer.pos(), desc.reloc_size);
 
   // Switch buffers.
-  if (spare_buffer_ == NULL && buffer_size_ == kMinimalBufferSize) {
-    spare_buffer_ = buffer_;
+  Data* data = Assembler::data();
+  if (data->spare_buffer_ == NULL && buffer_size_ == kMinimalBufferSize) {
+    data->spare_buffer_ = buffer_;
   } else {
     DeleteArray(buffer_);
   }
@@ -373,24 +373,33 @@ class CpuFeatures : public AllStatic {
     if (f == SSE3 && !FLAG_enable_sse3) return false;
     if (f == CMOV && !FLAG_enable_cmov) return false;
     if (f == RDTSC && !FLAG_enable_rdtsc) return false;
-    return (supported_ & (static_cast<uint64_t>(1) << f)) != 0;
+    uint64_t mask = static_cast<uint64_t>(1) << f;
+    Data* data = CpuFeatures::data();
+    // Code that may be serialized can't rely on features of this CPU.
+    if (Serializer::enabled() &&
+        (data->found_by_runtime_probing_ & mask) != 0) {
+      return false;
+    }
+    return (data->supported_ & mask) != 0;
   }
   // Check whether a feature is currently enabled.
   static bool IsEnabled(CpuFeature f) {
-    return (enabled_ & (static_cast<uint64_t>(1) << f)) != 0;
+    return (data()->enabled_ & (static_cast<uint64_t>(1) << f)) != 0;
   }
   // Enable a specified feature within a scope.
   class Scope BASE_EMBEDDED {
 #ifdef DEBUG
    public:
     explicit Scope(CpuFeature f) {
+      Data* data = CpuFeatures::data();
       uint64_t mask = static_cast<uint64_t>(1) << f;
       ASSERT(CpuFeatures::IsSupported(f));
-      ASSERT(!Serializer::enabled() || (found_by_runtime_probing_ & mask) == 0);
-      old_enabled_ = CpuFeatures::enabled_;
-      CpuFeatures::enabled_ |= mask;
+      ASSERT(!Serializer::enabled() ||
+             (data->found_by_runtime_probing_ & mask) == 0);
+      old_enabled_ = data->enabled_;
+      data->enabled_ |= mask;
     }
-    ~Scope() { CpuFeatures::enabled_ = old_enabled_; }
+    ~Scope() { CpuFeatures::data()->enabled_ = old_enabled_; }
    private:
     uint64_t old_enabled_;
 #else
@@ -399,9 +408,19 @@ class CpuFeatures : public AllStatic {
 #endif
   };
  private:
-  static uint64_t supported_;
-  static uint64_t enabled_;
-  static uint64_t found_by_runtime_probing_;
+  class Data {
+   public:
+    uint64_t supported_;
+    uint64_t enabled_;
+    uint64_t found_by_runtime_probing_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kCpuFeaturesData));
+  }
+
+  friend class Isolate;
 };
 
 
@@ -913,8 +932,20 @@ class Assembler : public Malloced {
   int buffer_size_;
   // True if the assembler owns the buffer, false if buffer is external.
   bool own_buffer_;
-  // A previously allocated buffer of kMinimalBufferSize bytes, or NULL.
-  static byte* spare_buffer_;
+
+  class Data {
+   public:
+    ~Data() { DeleteArray(spare_buffer_); }
+    // A previously allocated buffer of kMinimalBufferSize bytes, or NULL.
+    byte* spare_buffer_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kAssemblerData));
+  }
+
+  friend class Isolate;
 
   // code generation
   byte* pc_;  // the program counter; moves forward
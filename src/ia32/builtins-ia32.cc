@@ -151,6 +151,11 @@ static void Generate_JSConstructStubHelper(MacroAssembler* masm,
     __ CmpInstanceType(eax, JS_FUNCTION_TYPE);
     __ j(equal, &rt_call);
 
+    // Pretenured objects are allocated in old space by the runtime.
+    __ test_b(FieldOperand(eax, Map::kBitField2Offset),
+              1 << Map::kIsPretenured);
+    __ j(not_zero, &rt_call);
+
     // Now allocate the JSObject on the heap.
     // edi: constructor
     // eax: initial map
@@ -10313,7 +10313,8 @@ void TranscendentalCacheStub::Generate(MacroAssembler* masm) {
   __ mov(eax,
          Immediate(ExternalReference::transcendental_cache_array_address()));
   // Eax points to cache array.
-  __ mov(eax, Operand(eax, type_ * sizeof(TranscendentalCache::caches_[0])));
+  __ mov(eax, Operand(eax, type_ *
+                      sizeof(TranscendentalCache::data()->caches_[0])));
   // Eax points to the cache for the type type_.
   // If NULL, the cache hasn't been initialized yet, so go through runtime.
   __ test(eax, Operand(eax));
@@ -11290,6 +11291,21 @@ void RegExpExecStub::Generate(MacroAssembler* masm) {
   __ cmp(eax, Operand(ebx));
   __ j(above_equal, &runtime);
 
+  // eax: Previous index as a smi
+  // ebx: Length of subject string as a smi
+  // ecx: RegExp data (FixedArray)
+  // Leave long subjects to the runtime if the regexp has a literal prefix,
+  // as searching for the prefix first is faster than trying each position.
+  Label no_prefix_scan;
+  __ sub(ebx, Operand(eax));
+  __ cmp(Operand(ebx),
+         Immediate(Smi::FromInt(RegExpImpl::kPrefixScanMinLength)));
+  __ j(less, &no_prefix_scan);
+  __ cmp(FieldOperand(ecx, JSRegExp::kIrregexpPrefixOffset),
+         Factory::undefined_value());
+  __ j(not_equal, &runtime);
+  __ bind(&no_prefix_scan);
+
   // ecx: RegExp data (FixedArray)
   // edx: Number of capture registers
   // Check that the fourth object is a JSArray object.
@@ -11446,7 +11462,8 @@ void RegExpExecStub::Generate(MacroAssembler* masm) {
   __ cmp(eax, NativeRegExpMacroAssembler::FAILURE);
   __ j(equal, &failure, taken);
   __ cmp(eax, NativeRegExpMacroAssembler::EXCEPTION);
-  // If not exception it can only be retry. Handle that in the runtime system.
+  // If not exception it can only be retry or an exceeded backtrack limit.
+  // Handle that in the runtime system.
   __ j(not_equal, &runtime);
   // Result must now be exception. If there is no pending exception already a
   // stack overflow (on the backtrack stack) was detected in RegExp code but
@@ -12598,8 +12615,13 @@ void StringCharCodeAtGenerator::GenerateFast(MacroAssembler* masm) {
   __ j(zero, &flat_string);
 
   // Handle non-flat strings.
-  __ test(result_, Immediate(kIsConsStringMask));
-  __ j(zero, &call_runtime_);
+  Label sliced_string;
+  __ and_(result_, kStringRepresentationMask);
+  ASSERT(kConsStringTag < kExternalStringTag);
+  ASSERT(kSlicedStringTag > kExternalStringTag);
+  __ cmp(result_, kExternalStringTag);
+  __ j(greater, &sliced_string);
+  __ j(equal, &call_runtime_);
 
   // ConsString.
   // Check whether the right hand side is the empty string (i.e. if
@@ -12617,6 +12639,22 @@ void StringCharCodeAtGenerator::GenerateFast(MacroAssembler* masm) {
   ASSERT(kSeqStringTag == 0);
   __ test(result_, Immediate(kStringRepresentationMask));
   __ j(not_zero, &call_runtime_);
+  __ jmp(&flat_string);
+
+  // SlicedString.
+  // The parent of a sliced string is either sequential or external. Only
+  // handle a sequential parent here and read the character from it at the
+  // index adjusted by the offset of the slice.
+  __ bind(&sliced_string);
+  __ mov(result_, FieldOperand(object_, SlicedString::kParentOffset));
+  __ mov(result_, FieldOperand(result_, HeapObject::kMapOffset));
+  __ movzx_b(result_, FieldOperand(result_, Map::kInstanceTypeOffset));
+  ASSERT(kSeqStringTag == 0);
+  __ test(result_, Immediate(kStringRepresentationMask));
+  __ j(not_zero, &call_runtime_);
+  // Both the index and the offset are smis.
+  __ add(scratch_, FieldOperand(object_, SlicedString::kOffsetOffset));
+  __ mov(object_, FieldOperand(object_, SlicedString::kParentOffset));
 
   // Check for 1-byte or 2-byte string.
   __ bind(&flat_string);
@@ -13313,6 +13351,52 @@ void SubStringStub::Generate(MacroAssembler* masm) {
   // eax: string
   // ebx: instance type
   // ecx: result string length
+  // Long sub strings share the characters of the string instead of copying
+  // them. The sliced string refers to the underlying sequential string.
+  Label copy_string, make_sliced_string, set_slice_fields;
+  __ cmp(ecx, SlicedString::kMinLength);
+  __ j(less, &copy_string);
+  __ mov(edx, Operand(esp, 2 * kPointerSize));  // From index.
+  __ mov(edi, ebx);
+  __ and_(edi, kStringRepresentationMask);
+  ASSERT_EQ(0, kSeqStringTag);
+  __ j(zero, &make_sliced_string);
+  __ cmp(edi, kSlicedStringTag);
+  __ j(not_equal, &runtime);
+  // A slice of a sliced string refers to the parent of the slice.
+  __ add(edx, FieldOperand(eax, SlicedString::kOffsetOffset));
+  __ mov(eax, FieldOperand(eax, SlicedString::kParentOffset));
+  __ mov(ebx, FieldOperand(eax, HeapObject::kMapOffset));
+  __ movzx_b(ebx, FieldOperand(ebx, Map::kInstanceTypeOffset));
+  // External parents are handled in the runtime system.
+  __ test(ebx, Immediate(kStringRepresentationMask));
+  __ j(not_zero, &runtime);
+
+  __ bind(&make_sliced_string);
+  // eax: sequential parent string
+  // ebx: instance type of parent string
+  // ecx: result string length
+  // edx: offset of the result in the parent (smi)
+  Label two_byte_slice;
+  ASSERT(kAsciiStringTag != 0);
+  __ test(ebx, Immediate(kStringEncodingMask));
+  __ j(zero, &two_byte_slice);
+  __ AllocateAsciiSlicedString(edi, ebx, no_reg, &runtime);
+  __ jmp(&set_slice_fields);
+  __ bind(&two_byte_slice);
+  __ AllocateSlicedString(edi, ebx, no_reg, &runtime);
+  __ bind(&set_slice_fields);
+  __ SmiTag(ecx);
+  __ mov(FieldOperand(edi, String::kLengthOffset), ecx);
+  __ mov(FieldOperand(edi, String::kHashFieldOffset),
+         Immediate(String::kEmptyHashField));
+  __ mov(FieldOperand(edi, SlicedString::kParentOffset), eax);
+  __ mov(FieldOperand(edi, SlicedString::kOffsetOffset), edx);
+  __ mov(eax, edi);
+  __ IncrementCounter(&Counters::sub_string_native, 1);
+  __ ret(3 * kPointerSize);
+
+  __ bind(&copy_string);
   // Check for flat ascii string
   Label non_ascii_flat;
   __ JumpIfInstanceTypeIsNotSequentialAscii(ebx, ebx, &non_ascii_flat);
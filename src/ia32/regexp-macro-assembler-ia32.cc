@@ -75,6 +75,8 @@ namespace internal {
  *       - backup of caller ebx
  *       - Offset of location before start of input (effectively character
  *         position -1). Used to initialize capture registers to a non-position.
+ *       - Number of backtracks so far (only used when backtracking is
+ *         limited, see --regexp-backtrack-limit).
  *       - register 0  ebp[-4]  (Only positions must be stored in the first
  *       - register 1  ebp[-8]   num_saved_registers_ registers)
  *       - ...
@@ -152,6 +154,12 @@ void RegExpMacroAssemblerIA32::AdvanceRegister(int reg, int by) {
 
 void RegExpMacroAssemblerIA32::Backtrack() {
   CheckPreemption();
+  int limit = backtrack_limit();
+  if (limit > 0) {
+    __ inc(Operand(ebp, kBacktrackCount));
+    __ cmp(Operand(ebp, kBacktrackCount), Immediate(limit));
+    __ j(equal, &backtrack_limit_label_);
+  }
   // Pop Code* offset from backtrack stack, add Code* and jump to location.
   Pop(ebx);
   __ add(Operand(ebx), Immediate(masm_->CodeObject()));
@@ -677,6 +685,7 @@ Handle<Object> RegExpMacroAssemblerIA32::GetCode(Handle<String> source) {
   __ push(edi);
   __ push(ebx);  // Callee-save on MacOS.
   __ push(Immediate(0));  // Make room for "input start - 1" constant.
+  __ push(Immediate(0));  // Backtrack count.
 
   // Check if we have space on the stack for registers.
   Label stack_limit_hit;
@@ -811,6 +820,13 @@ Handle<Object> RegExpMacroAssemblerIA32::GetCode(Handle<String> source) {
 
   Label exit_with_exception;
 
+  // Exit after too many backtracks.
+  if (backtrack_limit_label_.is_linked()) {
+    __ bind(&backtrack_limit_label_);
+    __ mov(eax, BACKTRACK_LIMIT);
+    __ jmp(&exit_label_);
+  }
+
   // Preempt-code
   if (check_preempt_label_.is_linked()) {
     SafeCallTarget(&check_preempt_label_);
@@ -1081,10 +1097,11 @@ int RegExpMacroAssemblerIA32::CheckStackGuardState(Address* return_address,
   }
 
   // Otherwise, the content of the string might have moved. It must still
-  // be a sequential or external string with the same content.
+  // be a sequential, sliced or external string with the same content.
   // Update the start and end pointers in the stack frame to the current
   // location (whether it has actually moved or not).
   ASSERT(StringShape(*subject).IsSequential() ||
+      StringShape(*subject).IsSliced() ||
       StringShape(*subject).IsExternal());
 
   // The original start address of the characters to match.
@@ -2397,6 +2397,11 @@ Object* ConstructStubCompiler::CompileConstructStub(
   __ Assert(not_equal, "Function constructed by construct stub.");
 #endif
 
+  // Pretenured objects are allocated in old space by the generic stub.
+  __ test_b(FieldOperand(ebx, Map::kBitField2Offset),
+            1 << Map::kIsPretenured);
+  __ j(not_zero, &generic_stub_call);
+
   // Now allocate the JSObject on the heap by moving the new space allocation
   // top forward.
   // edi: constructor
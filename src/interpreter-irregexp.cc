@@ -40,7 +40,16 @@ namespace v8 {
 namespace internal {
 
 
-static unibrow::Mapping<unibrow::Ecma262Canonicalize> interp_canonicalize;
+class IrregexpInterpreter::Data {
+ public:
+  ~Data() { DeleteArray(backtrack_stack_cache_); }
+
+  // A backtrack stack that is not in use, or NULL.
+  int* backtrack_stack_cache_;
+};
+
+
+DEFINE_ISOLATE_COMPONENT(IrregexpInterpreter)
 
 
 static bool BackRefMatchesNoCase(int from,
@@ -53,8 +62,10 @@ static bool BackRefMatchesNoCase(int from,
     if (old_char == new_char) continue;
     unibrow::uchar old_string[1] = { old_char };
     unibrow::uchar new_string[1] = { new_char };
-    interp_canonicalize.get(old_char, '\0', old_string);
-    interp_canonicalize.get(new_char, '\0', new_string);
+    unibrow::Mapping<unibrow::Ecma262Canonicalize>* canonicalize =
+        &RegExpEngine::data()->canonicalize_;
+    canonicalize->get(old_char, '\0', old_string);
+    canonicalize->get(new_char, '\0', new_string);
     if (old_string[0] != new_string[0]) {
       return false;
     }
@@ -151,10 +162,11 @@ static int32_t Load16Aligned(const byte* pc) {
 class BacktrackStack {
  public:
   explicit BacktrackStack() {
-    if (cache_ != NULL) {
+    int** cache = cache_location();
+    if (*cache != NULL) {
       // If the cache is not empty reuse the previously allocated stack.
-      data_ = cache_;
-      cache_ = NULL;
+      data_ = *cache;
+      *cache = NULL;
     } else {
       // Cache was empty. Allocate a new backtrack stack.
       data_ = NewArray<int>(kBacktrackStackSize);
@@ -162,9 +174,10 @@ class BacktrackStack {
   }
 
   ~BacktrackStack() {
-    if (cache_ == NULL) {
+    int** cache = cache_location();
+    if (*cache == NULL) {
       // The cache is empty. Keep this backtrack stack around.
-      cache_ = data_;
+      *cache = data_;
     } else {
       // A backtrack stack was already cached, just release this one.
       DeleteArray(data_);
@@ -178,21 +191,22 @@ class BacktrackStack {
  private:
   static const int kBacktrackStackSize = 10000;
 
+  static int** cache_location() {
+    return &IrregexpInterpreter::data()->backtrack_stack_cache_;
+  }
+
   int* data_;
-  static int* cache_;
 
   DISALLOW_COPY_AND_ASSIGN(BacktrackStack);
 };
 
-int* BacktrackStack::cache_ = NULL;
-
 
 template <typename Char>
-static bool RawMatch(const byte* code_base,
-                     Vector<const Char> subject,
-                     int* registers,
-                     int current,
-                     uint32_t current_char) {
+static IrregexpInterpreter::Result RawMatch(const byte* code_base,
+                                            Vector<const Char> subject,
+                                            int* registers,
+                                            int current,
+                                            uint32_t current_char) {
   const byte* pc = code_base;
   // BacktrackStack ensures that the memory allocated for the backtracking stack
   // is returned to the system or cached if there is no stack being cached at
@@ -201,6 +215,9 @@ static bool RawMatch(const byte* code_base,
   int* backtrack_stack_base = backtrack_stack.data();
   int* backtrack_sp = backtrack_stack_base;
   int backtrack_stack_space = backtrack_stack.max_size();
+  // Give up after backtracking this many times if it is not zero.
+  int backtrack_limit = FLAG_regexp_backtrack_limit;
+  int backtrack_count = 0;
 #ifdef DEBUG
   if (FLAG_trace_regexp_bytecodes) {
     PrintF("\n\nStart bytecode interpreter\n\n");
@@ -211,24 +228,27 @@ static bool RawMatch(const byte* code_base,
     switch (insn & BYTECODE_MASK) {
       BYTECODE(BREAK)
         UNREACHABLE();
-        return false;
+        return IrregexpInterpreter::FAILURE;
       BYTECODE(PUSH_CP)
         if (--backtrack_stack_space < 0) {
-          return false;  // No match on backtrack stack overflow.
+          // No match on backtrack stack overflow.
+          return IrregexpInterpreter::FAILURE;
         }
         *backtrack_sp++ = current;
         pc += BC_PUSH_CP_LENGTH;
         break;
       BYTECODE(PUSH_BT)
         if (--backtrack_stack_space < 0) {
-          return false;  // No match on backtrack stack overflow.
+          // No match on backtrack stack overflow.
+          return IrregexpInterpreter::FAILURE;
         }
         *backtrack_sp++ = Load32Aligned(pc + 4);
         pc += BC_PUSH_BT_LENGTH;
         break;
       BYTECODE(PUSH_REGISTER)
         if (--backtrack_stack_space < 0) {
-          return false;  // No match on backtrack stack overflow.
+          // No match on backtrack stack overflow.
+          return IrregexpInterpreter::FAILURE;
         }
         *backtrack_sp++ = registers[insn >> BYTECODE_SHIFT];
         pc += BC_PUSH_REGISTER_LENGTH;
@@ -267,6 +287,9 @@ static bool RawMatch(const byte* code_base,
         pc += BC_POP_CP_LENGTH;
         break;
       BYTECODE(POP_BT)
+        if (backtrack_limit > 0 && ++backtrack_count == backtrack_limit) {
+          return IrregexpInterpreter::BACKTRACK_LIMIT;
+        }
         backtrack_stack_space++;
         --backtrack_sp;
         pc = code_base + *backtrack_sp;
@@ -278,9 +301,9 @@ static bool RawMatch(const byte* code_base,
         pc += BC_POP_REGISTER_LENGTH;
         break;
       BYTECODE(FAIL)
-        return false;
+        return IrregexpInterpreter::FAILURE;
       BYTECODE(SUCCEED)
-        return true;
+        return IrregexpInterpreter::SUCCESS;
       BYTECODE(ADVANCE_CP)
         current += insn >> BYTECODE_SHIFT;
         pc += BC_ADVANCE_CP_LENGTH;
@@ -615,10 +638,11 @@ static bool RawMatch(const byte* code_base,
 }
 
 
-bool IrregexpInterpreter::Match(Handle<ByteArray> code_array,
-                                Handle<String> subject,
-                                int* registers,
-                                int start_position) {
+IrregexpInterpreter::Result IrregexpInterpreter::Match(
+    Handle<ByteArray> code_array,
+    Handle<String> subject,
+    int* registers,
+    int start_position) {
   ASSERT(subject->IsFlat());
 
   AssertNoAllocation a;
@@ -36,10 +36,22 @@ namespace internal {
 
 class IrregexpInterpreter {
  public:
-  static bool Match(Handle<ByteArray> code,
-                    Handle<String> subject,
-                    int* captures,
-                    int start_position);
+  // BACKTRACK_LIMIT means that matching was abandoned after backtracking
+  // --regexp-backtrack-limit times.
+  enum Result { BACKTRACK_LIMIT = -1, FAILURE = 0, SUCCESS = 1 };
+
+  static Result Match(Handle<ByteArray> code,
+                      Handle<String> subject,
+                      int* captures,
+                      int start_position);
+
+  // The state of the interpreter, which is used by the helpers of Match.
+  class Data;
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kIrregexpInterpreterData));
+  }
 };
 
 
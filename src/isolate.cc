@@ -0,0 +1,142 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "v8.h"
+
+#include "isolate.h"
+
+namespace v8 {
+namespace internal {
+
+Isolate* Isolate::default_isolate_ = NULL;
+#ifdef V8_FAST_TLS
+__thread Isolate* Isolate::current_ = NULL;
+__thread Isolate::EntryStackItem* Isolate::entry_stack_ = NULL;
+#else
+Thread::LocalStorageKey Isolate::current_key_;
+Thread::LocalStorageKey Isolate::entry_stack_key_;
+#endif
+
+
+// Create the default isolate before main, so that it exists before any
+// threads are started, just like the statics it replaces.
+static Isolate* const kDefaultIsolate = Isolate::default_isolate();
+
+
+void* Isolate::AllocateComponentData(size_t size) {
+  void* data = Malloced::New(size);
+  memset(data, 0, size);
+  return data;
+}
+
+
+void Isolate::FreeComponentData(void* data) {
+  Malloced::Delete(data);
+}
+
+
+Isolate::Isolate() {
+#define NEW_COMPONENT_DATA(Name)                                              \
+  component_data_[k##Name##Data] = New##Name##Data();
+  ISOLATE_COMPONENT_LIST(NEW_COMPONENT_DATA)
+#undef NEW_COMPONENT_DATA
+}
+
+
+Isolate::~Isolate() {
+#define DELETE_COMPONENT_DATA(Name)                                           \
+  Delete##Name##Data(component_data_[k##Name##Data]);
+  ISOLATE_COMPONENT_LIST(DELETE_COMPONENT_DATA)
+#undef DELETE_COMPONENT_DATA
+}
+
+
+Isolate* Isolate::EnsureDefaultIsolate() {
+  // This first happens while the statics are initialized, before there are
+  // other threads.
+  if (default_isolate_ == NULL) {
+#ifndef V8_FAST_TLS
+    current_key_ = Thread::CreateThreadLocalKey();
+    entry_stack_key_ = Thread::CreateThreadLocalKey();
+#endif
+    default_isolate_ = new Isolate();
+  }
+  return default_isolate_;
+}
+
+
+Isolate* Isolate::New() {
+  EnsureDefaultIsolate();
+  return new Isolate();
+}
+
+
+void Isolate::Dispose() {
+  ASSERT(!IsDefaultIsolate());
+  Enter();
+  V8::TearDown();
+  Exit();
+  delete this;
+}
+
+
+void Isolate::SetCurrent(Isolate* isolate, EntryStackItem* stack) {
+#ifdef V8_FAST_TLS
+  current_ = isolate;
+  entry_stack_ = stack;
+#else
+  Thread::SetThreadLocal(current_key_, isolate);
+  Thread::SetThreadLocal(entry_stack_key_, stack);
+#endif
+}
+
+
+Isolate::EntryStackItem* Isolate::CurrentEntryStack() {
+#ifdef V8_FAST_TLS
+  return entry_stack_;
+#else
+  return reinterpret_cast<EntryStackItem*>(
+      Thread::GetThreadLocal(entry_stack_key_));
+#endif
+}
+
+
+void Isolate::Enter() {
+  EnsureDefaultIsolate();
+  SetCurrent(this, new EntryStackItem(this, CurrentEntryStack()));
+}
+
+
+void Isolate::Exit() {
+  EntryStackItem* item = CurrentEntryStack();
+  ASSERT(item != NULL && item->isolate_ == this);
+  EntryStackItem* previous = item->previous_;
+  delete item;
+  SetCurrent(previous != NULL ? previous->isolate_ : NULL, previous);
+}
+
+} }  // namespace v8::internal
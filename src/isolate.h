@@ -0,0 +1,257 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef V8_ISOLATE_H_
+#define V8_ISOLATE_H_
+
+#include <new>
+
+#include "platform.h"
+
+namespace v8 {
+namespace internal {
+
+// Use the compiler's thread-local variables to find the current isolate
+// where they are known to work, and the thread-local storage of the
+// platform elsewhere.
+#if defined(__GNUC__) && defined(__linux__) && !defined(ANDROID)
+#define V8_FAST_TLS
+#endif
+
+
+// The components that only some architectures have.
+#if defined(V8_TARGET_ARCH_IA32) || defined(V8_TARGET_ARCH_X64)
+#define ISOLATE_ARCH_COMPONENT_LIST(V)                                        \
+  V(CpuFeatures)                                                               \
+  V(JumpTarget)
+#elif defined(V8_TARGET_ARCH_ARM)
+#define ISOLATE_ARCH_COMPONENT_LIST(V)                                        \
+  V(CpuFeatures)                                                               \
+  V(VirtualFrame)
+#else
+#define ISOLATE_ARCH_COMPONENT_LIST(V)
+#endif
+
+// The components of the debugger, when it is compiled in.
+#ifdef ENABLE_DEBUGGER_SUPPORT
+#define ISOLATE_DEBUGGER_COMPONENT_LIST(V)                                    \
+  V(Debug)                                                                     \
+  V(Debugger)                                                                  \
+  V(DebuggerAgent)
+#else
+#define ISOLATE_DEBUGGER_COMPONENT_LIST(V)
+#endif
+
+
+// The components that keep their state in the isolate.
+#define ISOLATE_COMPONENT_LIST(V)                                             \
+  V(V8)                                                                        \
+  V(Heap)                                                                      \
+  V(GCTracer)                                                                  \
+  V(PretenuringFeedback)                                                       \
+  V(DirtyRegionScanner)                                                        \
+  V(KeyedLookupCache)                                                          \
+  V(DescriptorLookupCache)                                                     \
+  V(TranscendentalCache)                                                       \
+  V(ExternalStringTable)                                                       \
+  V(MarkCompactCollector)                                                      \
+  V(GCThreads)                                                                 \
+  V(ParallelMarker)                                                            \
+  V(ParallelSweeper)                                                           \
+  V(Page)                                                                      \
+  V(CodeRange)                                                                 \
+  V(MemoryAllocator)                                                           \
+  V(GlobalHandles)                                                             \
+  V(HandleScope)                                                               \
+  V(HandleScopeImplementer)                                                    \
+  V(Top)                                                                       \
+  V(StackGuard)                                                                \
+  V(RegExpStack)                                                               \
+  V(ThreadManager)                                                             \
+  V(ContextSwitcher)                                                           \
+  V(Relocatable)                                                               \
+  V(VMState)                                                                   \
+  V(Zone)                                                                      \
+  V(AssertNoZoneAllocation)                                                    \
+  V(ZoneScope)                                                                 \
+  V(Segment)                                                                   \
+  V(Builtins)                                                                  \
+  V(Bootstrapper)                                                              \
+  V(BootstrapperActive)                                                        \
+  V(StubCache)                                                                 \
+  V(CompilationCache)                                                          \
+  V(ContextSlotCache)                                                          \
+  V(ExternalReferenceTable)                                                    \
+  V(SerializerDeserializer)                                                    \
+  V(Serializer)                                                                \
+  V(Assembler)                                                                 \
+  V(CodeGeneratorScope)                                                        \
+  V(FrameElement)                                                              \
+  V(Result)                                                                    \
+  V(String)                                                                    \
+  V(Runtime)                                                                   \
+  V(Compiler)                                                                  \
+  V(Scanner)                                                                   \
+  V(RegExpEngine)                                                              \
+  V(OffsetsVector)                                                             \
+  V(IrregexpInterpreter)                                                       \
+  V(ApiState)                                                                  \
+  V(LiveEditFunctionTracker)                                                   \
+  ISOLATE_DEBUGGER_COMPONENT_LIST(V)                                           \
+  ISOLATE_ARCH_COMPONENT_LIST(V)
+
+
+// An isolate is an independent instance of the VM. It has its own heap,
+// handles, caches and execution state, so threads that have entered
+// different isolates can run JavaScript in parallel.
+//
+// The VM components are still used through their static functions. Each
+// component that has state keeps it in a nested Data class, one instance of
+// which is owned by every isolate, and finds the instance of the current
+// isolate through a static data() function. Threads that have not entered
+// an isolate use the default isolate, which is the only isolate of an
+// embedder that does not create any.
+//
+// Flags, the natives sources, the snapshot, the counters, the log, the
+// profilers and the registered extensions are shared by all isolates, as
+// are the constant AST sentinels and the state that is only used to print
+// diagnostics. The embedder API wraps isolates in v8::Isolate.
+class Isolate {
+ public:
+  enum Component {
+#define DECLARE_ENUM(Name) k##Name##Data,
+    ISOLATE_COMPONENT_LIST(DECLARE_ENUM)
+#undef DECLARE_ENUM
+    kComponentCount
+  };
+
+  // Returns the isolate the current thread has entered, or the default
+  // isolate if it has not entered any.
+  static inline Isolate* Current();
+
+  // Returns the isolate used by threads that have not entered one.
+  static Isolate* default_isolate() {
+    return default_isolate_ != NULL ? default_isolate_
+                                    : EnsureDefaultIsolate();
+  }
+
+  // Creates a new isolate. The VM in it is initialized when it is first
+  // used, like the VM in the default isolate.
+  static Isolate* New();
+
+  // Tears down the VM in a non-default isolate and frees the isolate. No
+  // thread may have it entered.
+  void Dispose();
+
+  // Makes this the current isolate of the calling thread until the
+  // matching Exit. Enter and Exit nest, also across isolates.
+  void Enter();
+  void Exit();
+
+  bool IsDefaultIsolate() { return this == default_isolate_; }
+
+  // Returns the state of the given component in this isolate.
+  void* component_data(Component component) {
+    return component_data_[component];
+  }
+
+ private:
+  Isolate();
+  ~Isolate();
+
+  static Isolate* EnsureDefaultIsolate();
+
+  // The isolates a thread has entered, most recent first.
+  class EntryStackItem : public Malloced {
+   public:
+    EntryStackItem(Isolate* isolate, EntryStackItem* previous)
+        : isolate_(isolate), previous_(previous) { }
+    Isolate* isolate_;
+    EntryStackItem* previous_;
+  };
+
+  static inline void SetCurrent(Isolate* isolate, EntryStackItem* stack);
+  static inline EntryStackItem* CurrentEntryStack();
+
+  // Component state is allocated zeroed, as static data is.
+  static void* AllocateComponentData(size_t size);
+  static void FreeComponentData(void* data);
+
+  // Create and delete the state of a component.  They are defined next to
+  // the component with DEFINE_ISOLATE_COMPONENT, so that classes local to a
+  // file can keep their state in the isolate too.
+#define DECLARE_COMPONENT_FUNCTIONS(Name)                                     \
+  static void* New##Name##Data();                                             \
+  static void Delete##Name##Data(void* data);
+  ISOLATE_COMPONENT_LIST(DECLARE_COMPONENT_FUNCTIONS)
+#undef DECLARE_COMPONENT_FUNCTIONS
+
+  void* component_data_[kComponentCount];
+
+  static Isolate* default_isolate_;
+#ifdef V8_FAST_TLS
+  static __thread Isolate* current_;
+  static __thread EntryStackItem* entry_stack_;
+#else
+  static Thread::LocalStorageKey current_key_;
+  static Thread::LocalStorageKey entry_stack_key_;
+#endif
+
+  DISALLOW_COPY_AND_ASSIGN(Isolate);
+};
+
+
+// Defines the functions that create and delete the state of the given
+// component, which is its nested Data class.
+#define DEFINE_ISOLATE_COMPONENT(Name)                                        \
+  void* Isolate::New##Name##Data() {                                          \
+    return new(AllocateComponentData(sizeof(Name::Data))) Name::Data();       \
+  }                                                                           \
+  void Isolate::Delete##Name##Data(void* data) {                              \
+    static_cast<Name::Data*>(data)->~Data();                                  \
+    FreeComponentData(data);                                                  \
+  }
+
+
+Isolate* Isolate::Current() {
+#ifdef V8_FAST_TLS
+  Isolate* isolate = current_;
+  if (isolate != NULL) return isolate;
+  return default_isolate();
+#else
+  // The thread-local storage key only exists once the default isolate does.
+  if (default_isolate_ == NULL) return EnsureDefaultIsolate();
+  Isolate* isolate =
+      reinterpret_cast<Isolate*>(Thread::GetThreadLocal(current_key_));
+  return isolate != NULL ? isolate : default_isolate_;
+#endif
+}
+
+
+} }  // namespace v8::internal
+
+#endif  // V8_ISOLATE_H_
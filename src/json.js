@@ -28,9 +28,7 @@
 var $JSON = global.JSON;
 
 function ParseJSONUnfiltered(text) {
-  var s = $String(text);
-  var f = %CompileString(text, true);
-  return f();
+  return %ParseJson(TO_STRING_INLINE(text));
 }
 
 function Revive(holder, name, reviver) {
@@ -67,36 +65,8 @@ function JSONParse(text, reviver) {
   }
 }
 
-var characterQuoteCache = {
-  '\"': '\\"',
-  '\\': '\\\\',
-  '/': '\\/',
-  '\b': '\\b',
-  '\f': '\\f',
-  '\n': '\\n',
-  '\r': '\\r',
-  '\t': '\\t',
-  '\x0B': '\\u000b'
-};
-
-function QuoteSingleJSONCharacter(c) {
-  if (c in characterQuoteCache) {
-    return characterQuoteCache[c];
-  }
-  var charCode = c.charCodeAt(0);
-  var result;
-  if (charCode < 16) result = '\\u000';
-  else if (charCode < 256) result = '\\u00';
-  else if (charCode < 4096) result = '\\u0';
-  else result = '\\u';
-  result += charCode.toString(16);
-  characterQuoteCache[c] = result;
-  return result;
-}
-
 function QuoteJSONString(str) {
-  var quotable = /[\\\"\x00-\x1f\x80-\uffff]/g;
-  return '"' + str.replace(quotable, QuoteSingleJSONCharacter) + '"';
+  return %QuoteJSONString(str);
 }
 
 function StackContains(stack, val) {
@@ -229,8 +199,6 @@ function JSONSerialize(key, holder, replacer, stack, indent, gap) {
 }
 
 function JSONStringify(value, replacer, space) {
-  var stack = [];
-  var indent = "";
   if (IS_OBJECT(space)) {
     // Unwrap 'space' if it is wrapped
     if (IS_NUMBER_WRAPPER(space)) {
@@ -255,6 +223,14 @@ function JSONStringify(value, replacer, space) {
   } else {
     gap = "";
   }
+  if (!IS_FUNCTION(replacer) && !IS_ARRAY(replacer)) {
+    // The native serializer returns false if it finds something it cannot
+    // handle, such as a toJSON method or an accessor.
+    var result = %JSONStringify(value, gap);
+    if (result !== false) return result;
+  }
+  var stack = [];
+  var indent = "";
   return JSONSerialize('', {'': value}, replacer, stack, indent, gap);
 }
 
@@ -41,6 +41,7 @@
 #include "regexp-macro-assembler.h"
 #include "regexp-macro-assembler-tracer.h"
 #include "regexp-macro-assembler-irregexp.h"
+#include "regexp-nfa.h"
 #include "regexp-stack.h"
 
 #ifndef V8_INTERPRETED_REGEXP
@@ -107,6 +108,52 @@ static inline void ThrowRegExpException(Handle<JSRegExp> re,
 // Generic RegExp methods. Dispatches to implementation specific methods.
 
 
+static void AppendAtom(RegExpAtom* atom, ZoneList<uc16>* prefix) {
+  Vector<const uc16> data = atom->data();
+  for (int i = 0; i < data.length(); i++) prefix->Add(data[i]);
+}
+
+
+// Appends the characters that every match of the tree starts with to the
+// prefix.  Returns true if the tree always matches exactly the appended
+// characters, in which case the prefix of whatever follows the tree can be
+// appended too.  Zero-width assertions and lookaheads don't end the prefix.
+static bool AppendLiteralPrefix(RegExpTree* tree, ZoneList<uc16>* prefix) {
+  if (tree->IsAtom()) {
+    AppendAtom(tree->AsAtom(), prefix);
+    return true;
+  }
+  if (tree->IsText()) {
+    ZoneList<TextElement>* elements = tree->AsText()->elements();
+    for (int i = 0; i < elements->length(); i++) {
+      TextElement element = elements->at(i);
+      if (element.type != TextElement::ATOM) return false;
+      AppendAtom(element.data.u_atom, prefix);
+    }
+    return true;
+  }
+  if (tree->IsAlternative()) {
+    ZoneList<RegExpTree*>* nodes = tree->AsAlternative()->nodes();
+    for (int i = 0; i < nodes->length(); i++) {
+      if (!AppendLiteralPrefix(nodes->at(i), prefix)) return false;
+    }
+    return true;
+  }
+  if (tree->IsCapture()) {
+    return AppendLiteralPrefix(tree->AsCapture()->body(), prefix);
+  }
+  if (tree->IsQuantifier()) {
+    RegExpQuantifier* quantifier = tree->AsQuantifier();
+    if (quantifier->min() == 0) return false;
+    // The body is matched at least once, but only its first iteration
+    // is known to come first.
+    bool complete = AppendLiteralPrefix(quantifier->body(), prefix);
+    return complete && quantifier->max() == 1;
+  }
+  return tree->IsAssertion() || tree->IsLookahead() || tree->IsEmpty();
+}
+
+
 Handle<Object> RegExpImpl::Compile(Handle<JSRegExp> re,
                                    Handle<String> pattern,
                                    Handle<String> flag_str) {
@@ -146,6 +193,15 @@ Handle<Object> RegExpImpl::Compile(Handle<JSRegExp> re,
     AtomCompile(re, pattern, flags, atom_string);
   } else {
     IrregexpInitialize(re, pattern, flags, parse_result.capture_count);
+    if (FLAG_regexp_prefix_scan && !flags.is_ignore_case()) {
+      ZoneList<uc16> prefix(4);
+      AppendLiteralPrefix(parse_result.tree, &prefix);
+      if (!prefix.is_empty()) {
+        Handle<String> prefix_string =
+            Factory::NewStringFromTwoByte(prefix.ToConstVector());
+        re->SetDataAt(JSRegExp::kIrregexpPrefixIndex, *prefix_string);
+      }
+    }
   }
   ASSERT(re->data()->IsFixedArray());
   // Compilation succeeded so the data is set on the regexp
@@ -157,6 +213,25 @@ Handle<Object> RegExpImpl::Compile(Handle<JSRegExp> re,
 }
 
 
+bool RegExpImpl::Precompile(Handle<String> pattern, Handle<String> flags) {
+  Handle<JSFunction> constructor(Top::global_context()->regexp_function());
+  bool has_pending_exception;
+  Handle<Object> result = CreateRegExpLiteral(constructor,
+                                              pattern,
+                                              flags,
+                                              &has_pending_exception);
+  if (has_pending_exception) return false;
+  Handle<JSRegExp> re = Handle<JSRegExp>::cast(result);
+  if (re->TypeTag() == JSRegExp::IRREGEXP) {
+    if (!EnsureCompiledIrregexp(re, true)) return false;
+    if (!EnsureCompiledIrregexp(re, false)) return false;
+  }
+  Handle<FixedArray> data(FixedArray::cast(re->data()));
+  CompilationCache::RetainRegExp(pattern, re->GetFlags(), data);
+  return true;
+}
+
+
 Handle<Object> RegExpImpl::Exec(Handle<JSRegExp> regexp,
                                 Handle<String> subject,
                                 int index,
@@ -235,10 +310,23 @@ Handle<Object> RegExpImpl::AtomExec(Handle<JSRegExp> re,
 // If compilation fails, an exception is thrown and this function
 // returns false.
 bool RegExpImpl::EnsureCompiledIrregexp(Handle<JSRegExp> re, bool is_ascii) {
-  Object* compiled_code = re->DataAt(JSRegExp::code_index(is_ascii));
 #ifdef V8_INTERPRETED_REGEXP
+  Object* compiled_code = re->DataAt(JSRegExp::code_index(is_ascii));
   if (compiled_code->IsByteArray()) return true;
 #else  // V8_INTERPRETED_REGEXP (RegExp native code)
+  Smi* limit = Smi::FromInt(NativeRegExpMacroAssembler::backtrack_limit());
+  if (re->DataAt(JSRegExp::kIrregexpBacktrackLimitIndex) != limit) {
+    // The backtrack limit is part of the generated code, so code that was
+    // generated with another limit, e.g. by mksnapshot, is regenerated.
+    if (re->DataAt(JSRegExp::kIrregexpASCIICodeIndex)->IsCode()) {
+      re->SetDataAt(JSRegExp::kIrregexpASCIICodeIndex, Heap::the_hole_value());
+    }
+    if (re->DataAt(JSRegExp::kIrregexpUC16CodeIndex)->IsCode()) {
+      re->SetDataAt(JSRegExp::kIrregexpUC16CodeIndex, Heap::the_hole_value());
+    }
+    re->SetDataAt(JSRegExp::kIrregexpBacktrackLimitIndex, limit);
+  }
+  Object* compiled_code = re->DataAt(JSRegExp::code_index(is_ascii));
   if (compiled_code->IsCode()) return true;
 #endif
   return CompileIrregexp(re, is_ascii);
@@ -381,6 +469,17 @@ RegExpImpl::IrregexpResult RegExpImpl::IrregexpExecOnce(Handle<JSRegExp> regexp,
   ASSERT(index <= subject->length());
   ASSERT(subject->IsFlat());
 
+  // Every match starts with the literal prefix, if there is one, so skip
+  // directly to its first occurrence instead of trying to match at each
+  // position before it.
+  Object* prefix = irregexp->get(JSRegExp::kIrregexpPrefixIndex);
+  if (prefix->IsString()) {
+    index = Runtime::StringMatch(subject,
+                                 Handle<String>(String::cast(prefix)),
+                                 index);
+    if (index < 0) return RE_FAILURE;
+  }
+
 #ifndef V8_INTERPRETED_REGEXP
   ASSERT(output.length() >=
       (IrregexpNumberOfCaptures(*irregexp) + 1) * 2);
@@ -393,6 +492,9 @@ RegExpImpl::IrregexpResult RegExpImpl::IrregexpExecOnce(Handle<JSRegExp> regexp,
                                           output.start(),
                                           output.length(),
                                           index);
+    if (res == NativeRegExpMacroAssembler::BACKTRACK_LIMIT) {
+      return IrregexpExecNfa(regexp, subject, index, output);
+    }
     if (res != NativeRegExpMacroAssembler::RETRY) {
       ASSERT(res != NativeRegExpMacroAssembler::EXCEPTION ||
              Top::has_pending_exception());
@@ -428,17 +530,64 @@ RegExpImpl::IrregexpResult RegExpImpl::IrregexpExecOnce(Handle<JSRegExp> regexp,
   }
   Handle<ByteArray> byte_codes(IrregexpByteCode(*irregexp, is_ascii));
 
-  if (IrregexpInterpreter::Match(byte_codes,
-                                 subject,
-                                 register_vector,
-                                 index)) {
-    return RE_SUCCESS;
+  IrregexpInterpreter::Result res = IrregexpInterpreter::Match(byte_codes,
+                                                               subject,
+                                                               register_vector,
+                                                               index);
+  if (res == IrregexpInterpreter::BACKTRACK_LIMIT) {
+    return IrregexpExecNfa(regexp, subject, index, output);
   }
+  if (res == IrregexpInterpreter::SUCCESS) return RE_SUCCESS;
   return RE_FAILURE;
 #endif  // V8_INTERPRETED_REGEXP
 }
 
 
+RegExpImpl::IrregexpResult RegExpImpl::IrregexpExecNfa(Handle<JSRegExp> regexp,
+                                                       Handle<String> subject,
+                                                       int index,
+                                                       Vector<int> output) {
+  Counters::regexp_backtrack_limit_hits.Increment();
+  if (!FLAG_regexp_nfa_fallback) return RE_FAILURE;
+  if (regexp->DataAt(JSRegExp::kIrregexpNfaCodeIndex)->IsTheHole()) {
+    CompileIrregexpNfa(regexp);
+  }
+  Object* program = regexp->DataAt(JSRegExp::kIrregexpNfaCodeIndex);
+  if (!program->IsByteArray()) return RE_FAILURE;
+  Counters::regexp_nfa_matches.Increment();
+  if (RegExpNfa::Match(Handle<ByteArray>(ByteArray::cast(program)),
+                       subject,
+                       output.start(),
+                       index)) {
+    return RE_SUCCESS;
+  }
+  return RE_FAILURE;
+}
+
+
+void RegExpImpl::CompileIrregexpNfa(Handle<JSRegExp> re) {
+  CompilationZoneScope zone_scope(DELETE_ON_EXIT);
+  JSRegExp::Flags flags = re->GetFlags();
+  Handle<String> pattern(re->Pattern());
+  if (!pattern->IsFlat()) {
+    FlattenString(pattern);
+  }
+  RegExpCompileData compile_data;
+  FlatStringReader reader(pattern);
+  Handle<ByteArray> program;
+  if (ParseRegExp(&reader, flags.is_multiline(), &compile_data)) {
+    program = RegExpNfa::Compile(compile_data.tree,
+                                 compile_data.capture_count,
+                                 flags.is_ignore_case());
+  }
+  if (program.is_null()) {
+    re->SetDataAt(JSRegExp::kIrregexpNfaCodeIndex, Heap::undefined_value());
+  } else {
+    re->SetDataAt(JSRegExp::kIrregexpNfaCodeIndex, *program);
+  }
+}
+
+
 Handle<Object> RegExpImpl::IrregexpExec(Handle<JSRegExp> jsregexp,
                                         Handle<String> subject,
                                         int previous_index,
@@ -1248,8 +1397,7 @@ void ChoiceNode::GenerateGuard(RegExpMacroAssembler* macro_assembler,
 }
 
 
-static unibrow::Mapping<unibrow::Ecma262UnCanonicalize> uncanonicalize;
-static unibrow::Mapping<unibrow::CanonicalizationRange> canonrange;
+DEFINE_ISOLATE_COMPONENT(RegExpEngine)
 
 
 // Returns the number of characters in the equivalence class, omitting those
@@ -1257,7 +1405,8 @@ static unibrow::Mapping<unibrow::CanonicalizationRange> canonrange;
 static int GetCaseIndependentLetters(uc16 character,
                                      bool ascii_subject,
                                      unibrow::uchar* letters) {
-  int length = uncanonicalize.get(character, '\0', letters);
+  int length =
+      RegExpEngine::data()->uncanonicalize_.get(character, '\0', letters);
   // Unibrow returns 0 or 1 for characters where case independependence is
   // trivial.
   if (length == 0) {
@@ -4000,10 +4149,11 @@ void CharacterRange::AddCaseEquivalents(ZoneList<CharacterRange>* ranges,
     if (bottom > String::kMaxAsciiCharCode) return;
     if (top > String::kMaxAsciiCharCode) top = String::kMaxAsciiCharCode;
   }
+  RegExpEngine::Data* data = RegExpEngine::data();
   unibrow::uchar chars[unibrow::Ecma262UnCanonicalize::kMaxWidth];
   if (top == bottom) {
     // If this is a singleton we just expand the one character.
-    int length = uncanonicalize.get(bottom, '\0', chars);
+    int length = data->uncanonicalize_.get(bottom, '\0', chars);
     for (int i = 0; i < length; i++) {
       uc32 chr = chars[i];
       if (chr != bottom) {
@@ -4031,7 +4181,7 @@ void CharacterRange::AddCaseEquivalents(ZoneList<CharacterRange>* ranges,
     // covered by the range.
     unibrow::uchar range[unibrow::Ecma262UnCanonicalize::kMaxWidth];
     // First, look up the block that contains the 'bottom' character.
-    int length = canonrange.get(bottom, '\0', range);
+    int length = data->canonrange_.get(bottom, '\0', range);
     if (length == 0) {
       range[0] = bottom;
     } else {
@@ -4052,7 +4202,7 @@ void CharacterRange::AddCaseEquivalents(ZoneList<CharacterRange>* ranges,
     // position to be after the last block each time.  The position
     // always points to the start of a block.
     while (pos < top) {
-      length = canonrange.get(start, '\0', range);
+      length = data->canonrange_.get(start, '\0', range);
       if (length == 0) {
         range[0] = start;
       } else {
@@ -4063,7 +4213,7 @@ void CharacterRange::AddCaseEquivalents(ZoneList<CharacterRange>* ranges,
       // of the range.
       int block_end = start + (range[0] & kPayloadMask) - 1;
       int end = (block_end > top) ? top : block_end;
-      length = uncanonicalize.get(start, '\0', range);
+      length = data->uncanonicalize_.get(start, '\0', range);
       for (int i = 0; i < length; i++) {
         uc32 c = range[i];
         uc16 range_from = c + (pos - start);
@@ -4180,6 +4330,7 @@ SetRelation CharacterRange::WordCharacterRelation(
 static void AddUncanonicals(ZoneList<CharacterRange>* ranges,
                             int bottom,
                             int top) {
+  RegExpEngine::Data* data = RegExpEngine::data();
   unibrow::uchar chars[unibrow::Ecma262UnCanonicalize::kMaxWidth];
   // Zones with no case mappings.  There is a DEBUG-mode loop to assert that
   // this table is correct.
@@ -4228,7 +4379,7 @@ static void AddUncanonicals(ZoneList<CharacterRange>* ranges,
 #ifdef DEBUG
       for (int j = bottom; j <= top; j++) {
         unsigned current_char = j;
-        int length = uncanonicalize.get(current_char, '\0', chars);
+        int length = data->uncanonicalize_.get(current_char, '\0', chars);
         for (int k = 0; k < length; k++) {
           ASSERT(chars[k] == current_char);
         }
@@ -4241,7 +4392,7 @@ static void AddUncanonicals(ZoneList<CharacterRange>* ranges,
   // Step through the range finding equivalent characters.
   ZoneList<unibrow::uchar> *characters = new ZoneList<unibrow::uchar>(100);
   for (int i = bottom; i <= top; i++) {
-    int length = uncanonicalize.get(i, '\0', chars);
+    int length = data->uncanonicalize_.get(i, '\0', chars);
     for (int j = 0; j < length; j++) {
       uc32 chr = chars[j];
       if (chr != i && (chr < bottom || chr > top)) {
@@ -5261,7 +5412,6 @@ RegExpEngine::CompilationResult RegExpEngine::Compile(RegExpCompileData* data,
 }
 
 
-int OffsetsVector::static_offsets_vector_[
-    OffsetsVector::kStaticOffsetsVectorSize];
+DEFINE_ISOLATE_COMPONENT(OffsetsVector)
 
 }}  // namespace v8::internal
@@ -69,6 +69,12 @@ class RegExpImpl {
                                 Handle<String> pattern,
                                 Handle<String> flags);
 
+  // Compiles a regexp for both ASCII and two byte subjects and keeps its
+  // data in the long-lived part of the compilation cache, so that mksnapshot
+  // can include it in the snapshot. Returns false, with an exception
+  // pending, if the regexp cannot be compiled.
+  static bool Precompile(Handle<String> pattern, Handle<String> flags);
+
   // See ECMA-262 section 15.10.6.2.
   // This function calls the garbage collector if necessary.
   static Handle<Object> Exec(Handle<JSRegExp> regexp,
@@ -125,6 +131,11 @@ class RegExpImpl {
                                      int index,
                                      Handle<JSArray> lastMatchInfo);
 
+  // Subjects at least this long, counted from the start index, are left to
+  // the runtime by the RegExpExecStub if the regexp has a literal prefix,
+  // so that IrregexpExecOnce can search for the prefix first.
+  static const int kPrefixScanMinLength = 128;
+
   // Array index in the lastMatchInfo array.
   static const int kLastCaptureCount = 0;
   static const int kLastSubject = 1;
@@ -182,6 +193,15 @@ class RegExpImpl {
   static bool CompileIrregexp(Handle<JSRegExp> re, bool is_ascii);
   static inline bool EnsureCompiledIrregexp(Handle<JSRegExp> re, bool is_ascii);
 
+  // Called when matching exceeded --regexp-backtrack-limit.  Redoes the
+  // match with the linear time matcher if the pattern allows it, otherwise
+  // the match fails.
+  static IrregexpResult IrregexpExecNfa(Handle<JSRegExp> regexp,
+                                        Handle<String> subject,
+                                        int index,
+                                        Vector<int> output);
+  static void CompileIrregexpNfa(Handle<JSRegExp> re);
+
 
   // Set the subject cache.  The previous string buffer is not deleted, so the
   // caller should ensure that it doesn't leak.
@@ -1421,6 +1441,20 @@ class RegExpEngine: public AllStatic {
                                    bool is_ascii);
 
   static void DotPrint(const char* label, RegExpNode* node, bool ignore_case);
+
+  // The case mappings of the compiler and of the generated code, which are
+  // not used by members of this class.
+  class Data {
+   public:
+    unibrow::Mapping<unibrow::Ecma262UnCanonicalize> uncanonicalize_;
+    unibrow::Mapping<unibrow::CanonicalizationRange> canonrange_;
+    unibrow::Mapping<unibrow::Ecma262Canonicalize> canonicalize_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kRegExpEngineData));
+  }
 };
 
 
@@ -1431,7 +1465,7 @@ class OffsetsVector {
     if (offsets_vector_length_ > kStaticOffsetsVectorSize) {
       vector_ = NewArray<int>(offsets_vector_length_);
     } else {
-      vector_ = static_offsets_vector_;
+      vector_ = data()->static_offsets_vector_;
     }
   }
   inline ~OffsetsVector() {
@@ -1447,14 +1481,24 @@ class OffsetsVector {
 
  private:
   static Address static_offsets_vector_address() {
-    return reinterpret_cast<Address>(&static_offsets_vector_);
+    return reinterpret_cast<Address>(&data()->static_offsets_vector_);
+  }
+
+  class Data {
+   public:
+    int static_offsets_vector_[kStaticOffsetsVectorSize];
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kOffsetsVectorData));
   }
 
   int* vector_;
   int offsets_vector_length_;
-  static int static_offsets_vector_[kStaticOffsetsVectorSize];
 
   friend class ExternalReference;
+  friend class Isolate;
 };
 
 
@@ -35,7 +35,7 @@ namespace v8 {
 namespace internal {
 
 
-bool JumpTarget::compiling_deferred_code_ = false;
+DEFINE_ISOLATE_COMPONENT(JumpTarget)
 
 
 void JumpTarget::Jump(Result* arg) {
@@ -145,7 +145,7 @@ void JumpTarget::ComputeEntryFrame() {
 
   Counters::compute_entry_frame.Increment();
 #ifdef DEBUG
-  if (compiling_deferred_code_) {
+  if (data()->compiling_deferred_code_) {
     ASSERT(reaching_frames_.length() > 1);
     VirtualFrame* frame = reaching_frames_[0];
     bool all_identical = true;
@@ -136,7 +136,7 @@ class JumpTarget : public ZoneObject {  // Shadows are dynamically allocated.
   void Call();
 
   static void set_compiling_deferred_code(bool flag) {
-    compiling_deferred_code_ = flag;
+    data()->compiling_deferred_code_ = flag;
   }
 
  protected:
@@ -164,7 +164,15 @@ class JumpTarget : public ZoneObject {  // Shadows are dynamically allocated.
   void DoBind();
 
  private:
-  static bool compiling_deferred_code_;
+  class Data {
+   public:
+    bool compiling_deferred_code_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kJumpTargetData));
+  }
 
   // Add a virtual frame reaching this labeled block via a forward jump,
   // and a corresponding merge code label.
@@ -178,6 +186,8 @@ class JumpTarget : public ZoneObject {  // Shadows are dynamically allocated.
   // Compute a frame to use for entry to this block.
   void ComputeEntryFrame();
 
+  friend class Isolate;
+
   DISALLOW_COPY_AND_ASSIGN(JumpTarget);
 };
 
@@ -40,6 +40,9 @@ namespace v8 {
 namespace internal {
 
 
+DEFINE_ISOLATE_COMPONENT(LiveEditFunctionTracker)
+
+
 #ifdef ENABLE_DEBUGGER_SUPPORT
 
 
@@ -254,8 +257,8 @@ void Comparator::CalculateDifference(Comparator::Input* input,
 
 static bool CompareSubstrings(Handle<String> s1, int pos1,
                               Handle<String> s2, int pos2, int len) {
-  static StringInputBuffer buf1;
-  static StringInputBuffer buf2;
+  StringInputBuffer buf1;
+  StringInputBuffer buf2;
   buf1.Reset(*s1);
   buf1.Seek(pos1);
   buf2.Reset(*s2);
@@ -699,8 +702,6 @@ class FunctionInfoListener {
   int current_parent_index_;
 };
 
-static FunctionInfoListener* active_function_info_listener = NULL;
-
 JSArray* LiveEdit::GatherCompileInfo(Handle<Script> script,
                                      Handle<String> source) {
   CompilationZoneScope zone_scope(DELETE_ON_EXIT);
@@ -708,9 +709,10 @@ JSArray* LiveEdit::GatherCompileInfo(Handle<Script> script,
   FunctionInfoListener listener;
   Handle<Object> original_source = Handle<Object>(script->source());
   script->set_source(*source);
-  active_function_info_listener = &listener;
+  LiveEditFunctionTracker::Data* data = LiveEditFunctionTracker::data();
+  data->active_function_info_listener_ = &listener;
   CompileScriptForTracker(script);
-  active_function_info_listener = NULL;
+  data->active_function_info_listener_ = NULL;
   script->set_source(*original_source);
 
   return *(listener.GetResult());
@@ -1405,34 +1407,37 @@ Handle<JSArray> LiveEdit::CheckAndDropActivations(
 
 
 LiveEditFunctionTracker::LiveEditFunctionTracker(FunctionLiteral* fun) {
-  if (active_function_info_listener != NULL) {
-    active_function_info_listener->FunctionStarted(fun);
+  FunctionInfoListener* listener = data()->active_function_info_listener_;
+  if (listener != NULL) {
+    listener->FunctionStarted(fun);
   }
 }
 
 
 LiveEditFunctionTracker::~LiveEditFunctionTracker() {
-  if (active_function_info_listener != NULL) {
-    active_function_info_listener->FunctionDone();
+  FunctionInfoListener* listener = data()->active_function_info_listener_;
+  if (listener != NULL) {
+    listener->FunctionDone();
   }
 }
 
 
 void LiveEditFunctionTracker::RecordFunctionInfo(
     Handle<SharedFunctionInfo> info, FunctionLiteral* lit) {
-  if (active_function_info_listener != NULL) {
-    active_function_info_listener->FunctionInfo(info, lit->scope());
+  FunctionInfoListener* listener = data()->active_function_info_listener_;
+  if (listener != NULL) {
+    listener->FunctionInfo(info, lit->scope());
   }
 }
 
 
 void LiveEditFunctionTracker::RecordRootFunctionInfo(Handle<Code> code) {
-  active_function_info_listener->FunctionCode(code);
+  data()->active_function_info_listener_->FunctionCode(code);
 }
 
 
 bool LiveEditFunctionTracker::IsActive() {
-  return active_function_info_listener != NULL;
+  return data()->active_function_info_listener_ != NULL;
 }
 
 
@@ -54,6 +54,8 @@
 namespace v8 {
 namespace internal {
 
+class FunctionInfoListener;
+
 // This class collects some specific information on structure of functions
 // in a particular script. It gets called from compiler all the time, but
 // actually records any data only when liveedit operation is in process;
@@ -72,6 +74,21 @@ class LiveEditFunctionTracker {
   void RecordRootFunctionInfo(Handle<Code> code);
 
   static bool IsActive();
+
+ private:
+  class Data {
+   public:
+    // The listener of the compilation done by LiveEdit, or NULL.
+    FunctionInfoListener* active_function_info_listener_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(Isolate::Current()->component_data(
+        Isolate::kLiveEditFunctionTrackerData));
+  }
+
+  friend class Isolate;
+  friend class LiveEdit;
 };
 
 #ifdef ENABLE_DEBUGGER_SUPPORT
@@ -39,37 +39,17 @@ namespace internal {
 // -------------------------------------------------------------------------
 // MarkCompactCollector
 
-bool MarkCompactCollector::force_compaction_ = false;
-bool MarkCompactCollector::compacting_collection_ = false;
-bool MarkCompactCollector::compact_on_next_gc_ = false;
+DEFINE_ISOLATE_COMPONENT(MarkCompactCollector)
 
-int MarkCompactCollector::previous_marked_count_ = 0;
-GCTracer* MarkCompactCollector::tracer_ = NULL;
-
-
-#ifdef DEBUG
-MarkCompactCollector::CollectorState MarkCompactCollector::state_ = IDLE;
-
-// Counters used for debugging the marking phase of mark-compact or mark-sweep
-// collection.
-int MarkCompactCollector::live_bytes_ = 0;
-int MarkCompactCollector::live_young_objects_size_ = 0;
-int MarkCompactCollector::live_old_data_objects_size_ = 0;
-int MarkCompactCollector::live_old_pointer_objects_size_ = 0;
-int MarkCompactCollector::live_code_objects_size_ = 0;
-int MarkCompactCollector::live_map_objects_size_ = 0;
-int MarkCompactCollector::live_cell_objects_size_ = 0;
-int MarkCompactCollector::live_lo_objects_size_ = 0;
-#endif
 
 void MarkCompactCollector::CollectGarbage() {
   // Make sure that Prepare() has been called. The individual steps below will
   // update the state as they proceed.
-  ASSERT(state_ == PREPARE_GC);
+  ASSERT(data()->state_ == PREPARE_GC);
 
   // Prepare has selected whether to compact the old generation or not.
   // Tell the tracer.
-  if (IsCompacting()) tracer_->set_is_compacting();
+  if (IsCompacting()) data()->tracer_->set_is_compacting();
 
   MarkLiveObjects();
 
@@ -78,7 +58,7 @@ void MarkCompactCollector::CollectGarbage() {
   SweepLargeObjectSpace();
 
   if (IsCompacting()) {
-    GCTracer::Scope gc_scope(tracer_, GCTracer::Scope::MC_COMPACT);
+    GCTracer::Scope gc_scope(data()->tracer_, GCTracer::Scope::MC_COMPACT);
     EncodeForwardingAddresses();
 
     UpdatePointers();
@@ -92,55 +72,57 @@ void MarkCompactCollector::CollectGarbage() {
 
   // Save the count of marked objects remaining after the collection and
   // null out the GC tracer.
-  previous_marked_count_ = tracer_->marked_count();
-  ASSERT(previous_marked_count_ == 0);
-  tracer_ = NULL;
+  data()->previous_marked_count_ = data()->tracer_->marked_count();
+  ASSERT(data()->previous_marked_count_ == 0);
+  data()->tracer_ = NULL;
 }
 
 
 void MarkCompactCollector::Prepare(GCTracer* tracer) {
   // Rather than passing the tracer around we stash it in a static member
   // variable.
-  tracer_ = tracer;
+  data()->tracer_ = tracer;
 
 #ifdef DEBUG
-  ASSERT(state_ == IDLE);
-  state_ = PREPARE_GC;
+  ASSERT(data()->state_ == IDLE);
+  data()->state_ = PREPARE_GC;
 #endif
   ASSERT(!FLAG_always_compact || !FLAG_never_compact);
 
-  compacting_collection_ =
-      FLAG_always_compact || force_compaction_ || compact_on_next_gc_;
-  compact_on_next_gc_ = false;
+  data()->compacting_collection_ =
+      FLAG_always_compact ||
+      data()->force_compaction_ ||
+      data()->compact_on_next_gc_;
+  data()->compact_on_next_gc_ = false;
 
-  if (FLAG_never_compact) compacting_collection_ = false;
+  if (FLAG_never_compact) data()->compacting_collection_ = false;
   if (!Heap::map_space()->MapPointersEncodable())
-      compacting_collection_ = false;
+      data()->compacting_collection_ = false;
   if (FLAG_collect_maps) CreateBackPointers();
 
   PagedSpaces spaces;
   for (PagedSpace* space = spaces.next();
        space != NULL; space = spaces.next()) {
-    space->PrepareForMarkCompact(compacting_collection_);
+    space->PrepareForMarkCompact(data()->compacting_collection_);
   }
 
 #ifdef DEBUG
-  live_bytes_ = 0;
-  live_young_objects_size_ = 0;
-  live_old_pointer_objects_size_ = 0;
-  live_old_data_objects_size_ = 0;
-  live_code_objects_size_ = 0;
-  live_map_objects_size_ = 0;
-  live_cell_objects_size_ = 0;
-  live_lo_objects_size_ = 0;
+  data()->live_bytes_ = 0;
+  data()->live_young_objects_size_ = 0;
+  data()->live_old_pointer_objects_size_ = 0;
+  data()->live_old_data_objects_size_ = 0;
+  data()->live_code_objects_size_ = 0;
+  data()->live_map_objects_size_ = 0;
+  data()->live_cell_objects_size_ = 0;
+  data()->live_lo_objects_size_ = 0;
 #endif
 }
 
 
 void MarkCompactCollector::Finish() {
 #ifdef DEBUG
-  ASSERT(state_ == SWEEP_SPACES || state_ == RELOCATE_OBJECTS);
-  state_ = IDLE;
+  ASSERT(data()->state_ == SWEEP_SPACES || data()->state_ == RELOCATE_OBJECTS);
+  data()->state_ = IDLE;
 #endif
   // The stub cache is not traversed during GC; clear the cache to
   // force lazy re-initialization of it. This must be done after the
@@ -172,7 +154,7 @@ void MarkCompactCollector::Finish() {
       static_cast<int>((old_gen_recoverable * 100.0) / old_gen_used);
   if (old_gen_fragmentation > kFragmentationLimit &&
       old_gen_recoverable > kFragmentationAllowed) {
-    compact_on_next_gc_ = true;
+    data()->compact_on_next_gc_ = true;
   }
 }
 
@@ -205,8 +187,6 @@ void MarkCompactCollector::Finish() {
 // and continue with marking.  This process repeats until all reachable
 // objects have been marked.
 
-static MarkingStack marking_stack;
-
 
 static inline HeapObject* ShortCircuitConsString(Object** p) {
   // Optimization: If the heap object pointed to by p is a non-symbol
@@ -243,6 +223,552 @@ static inline HeapObject* ShortCircuitConsString(Object** p) {
 }
 
 
+// -------------------------------------------------------------------------
+// Parallel marking.
+//
+// With --parallel_marking the work done by EmptyMarkingStack is split
+// between --parallel_gc_threads threads, one of which is the thread
+// running the collection.  Objects are marked by atomically clearing the
+// marking bit in their map word, so every live object is claimed by
+// exactly one thread, which is also the only thread visiting its body.
+//
+// Each thread pushes the objects it marks on a private marking deque.
+// The deques are carved out of the top of the marking stack's memory,
+// and the rest of the marking stack is shared by all threads.  A thread
+// whose deque is full moves the older half of it to the shared stack,
+// and a thread that runs out of work takes entries from there.  Busy
+// threads hand over part of their deque when the shared stack is empty
+// and other threads are idle.  If the shared stack itself overflows,
+// objects are marked as overflowed and RefillMarkingStack finds them
+// later, just as in the single threaded case.
+//
+// Clearing inline caches patches code and looks up stubs, so the marking
+// threads only record the call sites and the main thread clears them
+// once the marking threads are done.
+
+// Atomically set the mark bit of an object.  Returns false if the object
+// was already marked, possibly by another marking thread.  Otherwise the
+// (unmarked) map of the object is returned in map.
+static inline bool TryMarkAtomically(HeapObject* object, Map** map) {
+  volatile AtomicWord* map_word = reinterpret_cast<volatile AtomicWord*>(
+      HeapObject::RawField(object, HeapObject::kMapOffset));
+  AtomicWord value = *map_word;
+  while ((value & MapWord::kMarkingMask) != 0) {
+    AtomicWord previous = OS::CompareAndSwap(
+        map_word, value, value & ~MapWord::kMarkingMask);
+    if (previous == value) {
+      ASSERT((value & MapWord::kOverflowMask) == 0);
+      *map = reinterpret_cast<Map*>(value);
+      return true;
+    }
+    value = previous;
+  }
+  return false;
+}
+
+
+// A fixed size ring buffer of marked objects whose bodies have not been
+// visited yet.  The owning thread pushes and pops objects at the top,
+// while work handed over to other threads is taken from the bottom.
+class MarkingDeque {
+ public:
+  void Initialize(HeapObject** array, int capacity) {
+    ASSERT(IsPowerOf2(capacity));
+    array_ = array;
+    mask_ = capacity - 1;
+    bottom_ = 0;
+    size_ = 0;
+  }
+
+  bool is_empty() { return size_ == 0; }
+  bool is_full() { return size_ > mask_; }
+  int size() { return size_; }
+
+  void Push(HeapObject* object) {
+    ASSERT(!is_full());
+    array_[(bottom_ + size_) & mask_] = object;
+    size_++;
+  }
+
+  HeapObject* Pop() {
+    ASSERT(!is_empty());
+    size_--;
+    return array_[(bottom_ + size_) & mask_];
+  }
+
+  HeapObject* PopBottom() {
+    ASSERT(!is_empty());
+    HeapObject* object = array_[bottom_];
+    bottom_ = (bottom_ + 1) & mask_;
+    size_--;
+    return object;
+  }
+
+ private:
+  HeapObject** array_;
+  int mask_;
+  int bottom_;
+  int size_;
+};
+
+
+class MarkingWorker;
+
+
+// Visitor used by the marking threads.  Unlike MarkingVisitor it never
+// recurses, as the stack limit is only known for the main thread.
+class ParallelMarkingVisitor : public ObjectVisitor {
+ public:
+  explicit ParallelMarkingVisitor(MarkingWorker* worker) : worker_(worker) { }
+
+  inline void VisitPointer(Object** p);
+  inline void VisitPointers(Object** start, Object** end);
+  inline void VisitCodeTarget(RelocInfo* rinfo);
+  inline void VisitDebugTarget(RelocInfo* rinfo);
+
+ private:
+  MarkingWorker* worker_;
+};
+
+
+// The state of one marking thread.
+class MarkingWorker {
+ public:
+  MarkingWorker() : visitor_(this), marked_count_(0) {
+#ifdef DEBUG
+    visited_count_ = 0;
+#endif
+  }
+
+  MarkingDeque* deque() { return &deque_; }
+
+  // Mark an object and push it on the deque unless it was already marked.
+  inline void MarkObject(HeapObject* object);
+
+  // Visit the map and the body of an object popped from the deque.
+  inline void VisitObject(HeapObject* object);
+
+  void RecordInlineCache(Address address) { inline_caches_.Add(address); }
+
+  // Clear the recorded inline caches and reset the marked object count
+  // after adding it to the GC tracer.  Called on the main thread.
+  void Finish();
+
+#ifdef DEBUG
+  // The number of objects visited since the last reset.
+  int visited_count() { return visited_count_; }
+  void ResetVisitedCount() { visited_count_ = 0; }
+#endif
+
+ private:
+  inline void Push(HeapObject* object);
+  inline void CountMarkedObject(HeapObject* object, Map* map);
+  void MarkMapContents(Map* map);
+  void MarkDescriptorArray(DescriptorArray* descriptors);
+
+  MarkingDeque deque_;
+  ParallelMarkingVisitor visitor_;
+  int marked_count_;
+  List<Address> inline_caches_;
+#ifdef DEBUG
+  int visited_count_;
+#endif
+};
+
+
+DEFINE_ISOLATE_COMPONENT(GCThreads)
+
+
+class GCThread : public Thread {
+ public:
+  explicit GCThread(int index)
+      : index_(index),
+        isolate_(Isolate::Current()),
+        start_semaphore_(OS::CreateSemaphore(0)) { }
+  ~GCThread() { delete start_semaphore_; }
+
+  void StartTask() { start_semaphore_->Signal(); }
+
+  void Run() {
+    // The tasks work on the heap of the isolate the thread was started for.
+    isolate_->Enter();
+    while (true) {
+      start_semaphore_->Wait();
+      if (GCThreads::data()->stopping_) break;
+      GCThreads::data()->task_(index_);
+      GCThreads::data()->done_semaphore_->Signal();
+    }
+    isolate_->Exit();
+  }
+
+ private:
+  int index_;
+  Isolate* isolate_;
+  Semaphore* start_semaphore_;
+};
+
+
+void GCThreads::EnsureThreads(int count) {
+  ASSERT(count > 0);
+  if (data()->count_ == count) return;
+  TearDown();
+  data()->count_ = count;
+  data()->mutex_ = OS::CreateMutex();
+  data()->done_semaphore_ = OS::CreateSemaphore(0);
+  data()->threads_ = NewArray<GCThread*>(data()->count_);
+  data()->threads_[0] = NULL;
+  for (int i = 1; i < data()->count_; i++) {
+    data()->threads_[i] = new GCThread(i);
+    data()->threads_[i]->Start();
+  }
+}
+
+
+void GCThreads::Run(Task task) {
+  data()->task_ = task;
+  for (int i = 1; i < data()->count_; i++) data()->threads_[i]->StartTask();
+  task(0);
+  for (int i = 1; i < data()->count_; i++) data()->done_semaphore_->Wait();
+}
+
+
+void GCThreads::TearDown() {
+  if (data()->count_ == 0) return;
+  data()->stopping_ = true;
+  for (int i = 1; i < data()->count_; i++) {
+    data()->threads_[i]->StartTask();
+    data()->threads_[i]->Join();
+    delete data()->threads_[i];
+  }
+  data()->stopping_ = false;
+  DeleteArray(data()->threads_);
+  data()->threads_ = NULL;
+  delete data()->done_semaphore_;
+  data()->done_semaphore_ = NULL;
+  delete data()->mutex_;
+  data()->mutex_ = NULL;
+  data()->count_ = 0;
+}
+
+
+class ParallelMarker : public AllStatic {
+ public:
+  // Reserve the marking deques at the top of the memory [low, high) that
+  // is about to be used for the marking stack, and start the GC threads
+  // if needed.  Returns the new upper limit for the marking stack.  If
+  // there is too little memory for the deques parallel marking is not
+  // used in this collection.
+  static Address Prepare(Address low, Address high);
+
+  static bool is_active() { return data()->active_; }
+  static void Deactivate() { data()->active_ = false; }
+
+  // Mark all objects reachable from the marking stack using all the GC
+  // threads.  May leave overflowed objects in the heap.
+  static void EmptyMarkingStack();
+
+  // Move the given number of entries from the bottom of a worker's deque
+  // to the shared marking stack.
+  static void ShareWork(MarkingWorker* worker, int count);
+
+  static void TearDown();
+
+#ifdef DEBUG
+  static void UpdateLiveObjectCount(HeapObject* object, Map* map) {
+    ScopedLock lock(GCThreads::mutex());
+    MarkCompactCollector::UpdateLiveObjectCount(object, map);
+  }
+
+  static int visited_count(int index) {
+    if (index >= data()->worker_count_) return 0;
+    return data()->workers_[index].visited_count();
+  }
+#endif
+
+ private:
+  // Process the marking deque of a thread's worker, taking work from the
+  // shared marking stack when it is empty, until there is no work left
+  // for any of the threads.
+  static void Mark(int index);
+
+  // Move entries from the shared marking stack to the worker's deque.
+  // If there are none, wait until there are or until all threads are out
+  // of work, in which case false is returned.
+  static bool TakeWork(MarkingWorker* worker);
+
+  // The marking stack of the collector, which is shared by all threads.
+  static MarkingStack* marking_stack() {
+    return &MarkCompactCollector::data()->marking_stack_;
+  }
+
+  static const int kMinDequeCapacity = 256;
+  static const int kMaxDequeCapacity = 4 * KB;
+  static const int kTransferSize = 64;
+
+  class Data {
+   public:
+    bool active_;
+    int worker_count_;
+    MarkingWorker* workers_;
+    volatile int idle_workers_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kParallelMarkerData));
+  }
+
+  friend class Isolate;
+};
+
+
+DEFINE_ISOLATE_COMPONENT(ParallelMarker)
+
+
+void ParallelMarkingVisitor::VisitPointer(Object** p) {
+  if (!(*p)->IsHeapObject()) return;
+  worker_->MarkObject(ShortCircuitConsString(p));
+}
+
+
+void ParallelMarkingVisitor::VisitPointers(Object** start, Object** end) {
+  for (Object** p = start; p < end; p++) {
+    if (!(*p)->IsHeapObject()) continue;
+    worker_->MarkObject(ShortCircuitConsString(p));
+  }
+}
+
+
+void ParallelMarkingVisitor::VisitCodeTarget(RelocInfo* rinfo) {
+  ASSERT(RelocInfo::IsCodeTarget(rinfo->rmode()));
+  Code* code = Code::GetCodeFromTargetAddress(rinfo->target_address());
+  if (FLAG_cleanup_ics_at_gc && code->is_inline_cache_stub()) {
+    // The target does not have to be marked, see
+    // MarkingVisitor::VisitCodeTarget.
+    worker_->RecordInlineCache(rinfo->pc());
+  } else {
+    worker_->MarkObject(code);
+  }
+}
+
+
+void ParallelMarkingVisitor::VisitDebugTarget(RelocInfo* rinfo) {
+  ASSERT((RelocInfo::IsJSReturn(rinfo->rmode()) &&
+          rinfo->IsPatchedReturnSequence()) ||
+         (RelocInfo::IsDebugBreakSlot(rinfo->rmode()) &&
+          rinfo->IsPatchedDebugBreakSlotSequence()));
+  worker_->MarkObject(Code::GetCodeFromTargetAddress(rinfo->call_address()));
+}
+
+
+void MarkingWorker::CountMarkedObject(HeapObject* object, Map* map) {
+  marked_count_++;
+#ifdef DEBUG
+  ParallelMarker::UpdateLiveObjectCount(object, map);
+#endif
+}
+
+
+void MarkingWorker::Push(HeapObject* object) {
+  if (deque_.is_full()) ParallelMarker::ShareWork(this, deque_.size() / 2);
+  deque_.Push(object);
+}
+
+
+// Mirrors MarkCompactCollector::MarkUnmarkedObject.
+void MarkingWorker::MarkObject(HeapObject* object) {
+  if (object->IsMarked()) return;
+  Map* map;
+  if (!TryMarkAtomically(object, &map)) return;
+  ASSERT(Heap::Contains(object));
+  CountMarkedObject(object, map);
+  if (map->instance_type() == MAP_TYPE) {
+    // The object is marked, so Map::cast cannot be used.
+    Map* object_map = reinterpret_cast<Map*>(object);
+    if (FLAG_cleanup_caches_in_maps_at_gc) {
+      object_map->ClearCodeCache();
+    }
+    if (FLAG_collect_maps &&
+        object_map->instance_type() >= FIRST_JS_OBJECT_TYPE &&
+        object_map->instance_type() <= JS_FUNCTION_TYPE) {
+      MarkMapContents(object_map);
+      return;
+    }
+  }
+  Push(object);
+}
+
+
+void MarkingWorker::VisitObject(HeapObject* object) {
+  ASSERT(object->IsMarked());
+  ASSERT(!object->IsOverflowed());
+#ifdef DEBUG
+  visited_count_++;
+#endif
+  MapWord map_word = object->map_word();
+  map_word.ClearMark();
+  Map* map = map_word.ToMap();
+  MarkObject(map);
+  object->IterateBody(map->instance_type(), object->SizeFromMap(map),
+                      &visitor_);
+}
+
+
+// Mirrors MarkCompactCollector::MarkMapContents.
+void MarkingWorker::MarkMapContents(Map* map) {
+  MarkDescriptorArray(reinterpret_cast<DescriptorArray*>(
+      *HeapObject::RawField(map, Map::kInstanceDescriptorsOffset)));
+  visitor_.VisitPointers(HeapObject::RawField(map, Map::kPrototypeOffset),
+                         HeapObject::RawField(map, Map::kSize));
+}
+
+
+// Mirrors MarkCompactCollector::MarkDescriptorArray.
+void MarkingWorker::MarkDescriptorArray(DescriptorArray* descriptors) {
+  if (descriptors->IsMarked()) return;
+  Map* map;
+  if (!TryMarkAtomically(descriptors, &map)) return;
+  // Empty descriptor array is marked as a root before any maps are marked.
+  ASSERT(descriptors != Heap::raw_unchecked_empty_descriptor_array());
+  CountMarkedObject(descriptors, map);
+
+  // The contents array is only referenced from the descriptor array, so
+  // no other thread can be marking it.
+  FixedArray* contents = reinterpret_cast<FixedArray*>(
+      descriptors->get(DescriptorArray::kContentArrayIndex));
+  ASSERT(contents->IsHeapObject());
+  ASSERT(!contents->IsMarked());
+  ASSERT(contents->IsFixedArray());
+  ASSERT(contents->length() >= 2);
+  int length = contents->length();
+  if (TryMarkAtomically(contents, &map)) CountMarkedObject(contents, map);
+  for (int i = 0; i < length; i += 2) {
+    PropertyDetails details(Smi::cast(contents->get(i + 1)));
+    if (details.type() < FIRST_PHANTOM_PROPERTY_TYPE) {
+      Object* value = contents->get(i);
+      if (value->IsHeapObject()) MarkObject(HeapObject::cast(value));
+    }
+  }
+  Push(descriptors);
+}
+
+
+void MarkingWorker::Finish() {
+  MarkCompactCollector::tracer()->add_marked_count(marked_count_);
+  marked_count_ = 0;
+  for (int i = 0; i < inline_caches_.length(); i++) {
+    IC::Clear(inline_caches_[i]);
+  }
+  inline_caches_.Clear();
+}
+
+
+Address ParallelMarker::Prepare(Address low, Address high) {
+  data()->active_ = false;
+#ifdef DEBUG
+  for (int i = 0; i < data()->worker_count_; i++) {
+    data()->workers_[i].ResetVisitedCount();
+  }
+#endif
+  if (FLAG_parallel_gc_threads < 2) return high;
+
+  GCThreads::EnsureThreads(FLAG_parallel_gc_threads);
+  if (data()->worker_count_ != GCThreads::count()) {
+    delete[] data()->workers_;
+    data()->worker_count_ = GCThreads::count();
+    data()->workers_ = new MarkingWorker[data()->worker_count_];
+  }
+
+  // Use at most half of the memory for the deques.
+  int entries = static_cast<int>((high - low) / kPointerSize);
+  int capacity = kMaxDequeCapacity;
+  while (capacity * data()->worker_count_ > entries / 2) {
+    capacity /= 2;
+    if (capacity < kMinDequeCapacity) return high;
+  }
+
+  HeapObject** deques =
+      reinterpret_cast<HeapObject**>(high) - capacity * data()->worker_count_;
+  for (int i = 0; i < data()->worker_count_; i++) {
+    data()->workers_[i].deque()->Initialize(deques + i * capacity, capacity);
+  }
+  data()->active_ = true;
+  return reinterpret_cast<Address>(deques);
+}
+
+
+void ParallelMarker::EmptyMarkingStack() {
+  ASSERT(data()->active_);
+  ASSERT(data()->worker_count_ == GCThreads::count());
+  data()->idle_workers_ = 0;
+  GCThreads::Run(&Mark);
+  ASSERT(marking_stack()->is_empty());
+
+  for (int i = 0; i < data()->worker_count_; i++) data()->workers_[i].Finish();
+}
+
+
+void ParallelMarker::Mark(int index) {
+  MarkingWorker* worker = &data()->workers_[index];
+  MarkingDeque* deque = worker->deque();
+  do {
+    while (!deque->is_empty()) {
+      worker->VisitObject(deque->Pop());
+      if (data()->idle_workers_ > 0 && deque->size() > 1 &&
+          marking_stack()->is_empty()) {
+        ShareWork(worker, deque->size() / 2);
+      }
+    }
+  } while (TakeWork(worker));
+}
+
+
+void ParallelMarker::ShareWork(MarkingWorker* worker, int count) {
+  ScopedLock lock(GCThreads::mutex());
+  MarkingDeque* deque = worker->deque();
+  for (int i = 0; i < count; i++) {
+    // Objects that do not fit on the marking stack are marked as
+    // overflowed.
+    marking_stack()->Push(deque->PopBottom());
+  }
+}
+
+
+bool ParallelMarker::TakeWork(MarkingWorker* worker) {
+  bool idle = false;
+  while (true) {
+    {
+      ScopedLock lock(GCThreads::mutex());
+      MarkingStack* stack = marking_stack();
+      if (!stack->is_empty()) {
+        if (idle) data()->idle_workers_--;
+        MarkingDeque* deque = worker->deque();
+        for (int i = 0; i < kTransferSize && !stack->is_empty(); i++) {
+          deque->Push(stack->Pop());
+        }
+        return true;
+      }
+      if (!idle) {
+        idle = true;
+        data()->idle_workers_++;
+      }
+      // When all threads are idle and the marking stack is empty no more
+      // work can appear.
+      if (data()->idle_workers_ == data()->worker_count_) return false;
+    }
+    Thread::YieldCPU();
+  }
+}
+
+
+void ParallelMarker::TearDown() {
+  data()->active_ = false;
+  delete[] data()->workers_;
+  data()->workers_ = NULL;
+  data()->worker_count_ = 0;
+}
+
+
 // Helper class for marking pointers in HeapObjects.
 class MarkingVisitor : public ObjectVisitor {
  public:
@@ -356,8 +882,11 @@ class RootMarkingVisitor : public ObjectVisitor {
                         &stack_visitor_);
 
     // Mark all the objects reachable from the map and body.  May leave
-    // overflowed objects in the heap.
-    MarkCompactCollector::EmptyMarkingStack(&stack_visitor_);
+    // overflowed objects in the heap.  When marking in parallel it is
+    // cheaper to collect the objects reachable from many roots first.
+    if (!ParallelMarker::is_active()) {
+      MarkCompactCollector::EmptyMarkingStack(&stack_visitor_);
+    }
   }
 };
 
@@ -408,11 +937,11 @@ void MarkCompactCollector::MarkUnmarkedObject(HeapObject* object) {
         map->instance_type() <= JS_FUNCTION_TYPE) {
       MarkMapContents(map);
     } else {
-      marking_stack.Push(map);
+      data()->marking_stack_.Push(map);
     }
   } else {
     SetMark(object);
-    marking_stack.Push(object);
+    data()->marking_stack_.Push(object);
   }
 }
 
@@ -456,13 +985,13 @@ void MarkCompactCollector::MarkDescriptorArray(
       HeapObject* object = reinterpret_cast<HeapObject*>(contents->get(i));
       if (object->IsHeapObject() && !object->IsMarked()) {
         SetMark(object);
-        marking_stack.Push(object);
+        data()->marking_stack_.Push(object);
       }
     }
   }
   // The DescriptorArray descriptors contains a pointer to its contents array,
   // but the contents array is already marked.
-  marking_stack.Push(descriptors);
+  data()->marking_stack_.Push(descriptors);
 }
 
 
@@ -497,18 +1026,18 @@ static int OverflowObjectSize(HeapObject* obj) {
 // iterator.  Stop when the marking stack is filled or the end of the space
 // is reached, whichever comes first.
 template<class T>
-static void ScanOverflowedObjects(T* it) {
+static void ScanOverflowedObjects(T* it, MarkingStack* marking_stack) {
   // The caller should ensure that the marking stack is initially not full,
   // so that we don't waste effort pointlessly scanning for objects.
-  ASSERT(!marking_stack.is_full());
+  ASSERT(!marking_stack->is_full());
 
   for (HeapObject* object = it->next(); object != NULL; object = it->next()) {
     if (object->IsOverflowed()) {
       object->ClearOverflow();
       ASSERT(object->IsMarked());
       ASSERT(Heap::Contains(object));
-      marking_stack.Push(object);
-      if (marking_stack.is_full()) return;
+      marking_stack->Push(object);
+      if (marking_stack->is_full()) return;
     }
   }
 }
@@ -539,7 +1068,7 @@ void MarkCompactCollector::MarkRoots(RootMarkingVisitor* visitor) {
   MarkSymbolTable();
 
   // There may be overflowed objects in the heap.  Visit them now.
-  while (marking_stack.overflowed()) {
+  while (data()->marking_stack_.overflowed()) {
     RefillMarkingStack();
     EmptyMarkingStack(visitor->stack_visitor());
   }
@@ -585,8 +1114,13 @@ void MarkCompactCollector::MarkObjectGroups() {
 // After: the marking stack is empty, and all objects reachable from the
 // marking stack have been marked, or are overflowed in the heap.
 void MarkCompactCollector::EmptyMarkingStack(MarkingVisitor* visitor) {
-  while (!marking_stack.is_empty()) {
-    HeapObject* object = marking_stack.Pop();
+  if (ParallelMarker::is_active() && !data()->marking_stack_.is_empty()) {
+    ParallelMarker::EmptyMarkingStack();
+    return;
+  }
+
+  while (!data()->marking_stack_.is_empty()) {
+    HeapObject* object = data()->marking_stack_.Pop();
     ASSERT(object->IsHeapObject());
     ASSERT(Heap::Contains(object));
     ASSERT(object->IsMarked());
@@ -610,38 +1144,39 @@ void MarkCompactCollector::EmptyMarkingStack(MarkingVisitor* visitor) {
 // overflowed objects in the heap so the overflow flag on the markings stack
 // is cleared.
 void MarkCompactCollector::RefillMarkingStack() {
-  ASSERT(marking_stack.overflowed());
+  MarkingStack* marking_stack = &data()->marking_stack_;
+  ASSERT(marking_stack->overflowed());
 
   SemiSpaceIterator new_it(Heap::new_space(), &OverflowObjectSize);
-  ScanOverflowedObjects(&new_it);
-  if (marking_stack.is_full()) return;
+  ScanOverflowedObjects(&new_it, marking_stack);
+  if (marking_stack->is_full()) return;
 
   HeapObjectIterator old_pointer_it(Heap::old_pointer_space(),
                                     &OverflowObjectSize);
-  ScanOverflowedObjects(&old_pointer_it);
-  if (marking_stack.is_full()) return;
+  ScanOverflowedObjects(&old_pointer_it, marking_stack);
+  if (marking_stack->is_full()) return;
 
   HeapObjectIterator old_data_it(Heap::old_data_space(), &OverflowObjectSize);
-  ScanOverflowedObjects(&old_data_it);
-  if (marking_stack.is_full()) return;
+  ScanOverflowedObjects(&old_data_it, marking_stack);
+  if (marking_stack->is_full()) return;
 
   HeapObjectIterator code_it(Heap::code_space(), &OverflowObjectSize);
-  ScanOverflowedObjects(&code_it);
-  if (marking_stack.is_full()) return;
+  ScanOverflowedObjects(&code_it, marking_stack);
+  if (marking_stack->is_full()) return;
 
   HeapObjectIterator map_it(Heap::map_space(), &OverflowObjectSize);
-  ScanOverflowedObjects(&map_it);
-  if (marking_stack.is_full()) return;
+  ScanOverflowedObjects(&map_it, marking_stack);
+  if (marking_stack->is_full()) return;
 
   HeapObjectIterator cell_it(Heap::cell_space(), &OverflowObjectSize);
-  ScanOverflowedObjects(&cell_it);
-  if (marking_stack.is_full()) return;
+  ScanOverflowedObjects(&cell_it, marking_stack);
+  if (marking_stack->is_full()) return;
 
   LargeObjectIterator lo_it(Heap::lo_space(), &OverflowObjectSize);
-  ScanOverflowedObjects(&lo_it);
-  if (marking_stack.is_full()) return;
+  ScanOverflowedObjects(&lo_it, marking_stack);
+  if (marking_stack->is_full()) return;
 
-  marking_stack.clear_overflowed();
+  marking_stack->clear_overflowed();
 }
 
 
@@ -651,7 +1186,7 @@ void MarkCompactCollector::RefillMarkingStack() {
 // objects in the heap.
 void MarkCompactCollector::ProcessMarkingStack(MarkingVisitor* visitor) {
   EmptyMarkingStack(visitor);
-  while (marking_stack.overflowed()) {
+  while (data()->marking_stack_.overflowed()) {
     RefillMarkingStack();
     EmptyMarkingStack(visitor);
   }
@@ -660,27 +1195,30 @@ void MarkCompactCollector::ProcessMarkingStack(MarkingVisitor* visitor) {
 
 void MarkCompactCollector::ProcessObjectGroups(MarkingVisitor* visitor) {
   bool work_to_do = true;
-  ASSERT(marking_stack.is_empty());
+  ASSERT(data()->marking_stack_.is_empty());
   while (work_to_do) {
     MarkObjectGroups();
-    work_to_do = !marking_stack.is_empty();
+    work_to_do = !data()->marking_stack_.is_empty();
     ProcessMarkingStack(visitor);
   }
 }
 
 
 void MarkCompactCollector::MarkLiveObjects() {
-  GCTracer::Scope gc_scope(tracer_, GCTracer::Scope::MC_MARK);
+  GCTracer::Scope gc_scope(data()->tracer_, GCTracer::Scope::MC_MARK);
 #ifdef DEBUG
-  ASSERT(state_ == PREPARE_GC);
-  state_ = MARK_LIVE_OBJECTS;
+  ASSERT(data()->state_ == PREPARE_GC);
+  data()->state_ = MARK_LIVE_OBJECTS;
 #endif
   // The to space contains live objects, the from space is used as a marking
-  // stack.
-  marking_stack.Initialize(Heap::new_space()->FromSpaceLow(),
-                           Heap::new_space()->FromSpaceHigh());
+  // stack.  When marking in parallel the top of the from space holds the
+  // marking deques of the marking threads.
+  Address low = Heap::new_space()->FromSpaceLow();
+  Address high = Heap::new_space()->FromSpaceHigh();
+  if (FLAG_parallel_marking) high = ParallelMarker::Prepare(low, high);
+  data()->marking_stack_.Initialize(low, high);
 
-  ASSERT(!marking_stack.overflowed());
+  ASSERT(!data()->marking_stack_.overflowed());
 
   RootMarkingVisitor root_visitor;
   MarkRoots(&root_visitor);
@@ -700,10 +1238,7 @@ void MarkCompactCollector::MarkLiveObjects() {
   GlobalHandles::IdentifyWeakHandles(&IsUnmarkedHeapObject);
   // Then we mark the objects and process the transitive closure.
   GlobalHandles::IterateWeakRoots(&root_visitor);
-  while (marking_stack.overflowed()) {
-    RefillMarkingStack();
-    EmptyMarkingStack(root_visitor.stack_visitor());
-  }
+  ProcessMarkingStack(root_visitor.stack_visitor());
 
   // Repeat the object groups to mark unmarked groups reachable from the
   // weak roots.
@@ -721,6 +1256,8 @@ void MarkCompactCollector::MarkLiveObjects() {
 
   // Remove object groups after marking phase.
   GlobalHandles::RemoveObjectGroups();
+
+  ParallelMarker::Deactivate();
 }
 
 
@@ -732,24 +1269,30 @@ static int CountMarkedCallback(HeapObject* obj) {
 
 
 #ifdef DEBUG
-void MarkCompactCollector::UpdateLiveObjectCount(HeapObject* obj) {
-  live_bytes_ += obj->Size();
+int MarkCompactCollector::ParallelMarkingWorkCount(int thread) {
+  return ParallelMarker::visited_count(thread);
+}
+
+
+void MarkCompactCollector::UpdateLiveObjectCount(HeapObject* obj, Map* map) {
+  int size = obj->SizeFromMap(map);
+  data()->live_bytes_ += size;
   if (Heap::new_space()->Contains(obj)) {
-    live_young_objects_size_ += obj->Size();
+    data()->live_young_objects_size_ += size;
   } else if (Heap::map_space()->Contains(obj)) {
-    ASSERT(obj->IsMap());
-    live_map_objects_size_ += obj->Size();
+    ASSERT(map->instance_type() == MAP_TYPE);
+    data()->live_map_objects_size_ += size;
   } else if (Heap::cell_space()->Contains(obj)) {
-    ASSERT(obj->IsJSGlobalPropertyCell());
-    live_cell_objects_size_ += obj->Size();
+    ASSERT(map->instance_type() == JS_GLOBAL_PROPERTY_CELL_TYPE);
+    data()->live_cell_objects_size_ += size;
   } else if (Heap::old_pointer_space()->Contains(obj)) {
-    live_old_pointer_objects_size_ += obj->Size();
+    data()->live_old_pointer_objects_size_ += size;
   } else if (Heap::old_data_space()->Contains(obj)) {
-    live_old_data_objects_size_ += obj->Size();
+    data()->live_old_data_objects_size_ += size;
   } else if (Heap::code_space()->Contains(obj)) {
-    live_code_objects_size_ += obj->Size();
+    data()->live_code_objects_size_ += size;
   } else if (Heap::lo_space()->Contains(obj)) {
-    live_lo_objects_size_ += obj->Size();
+    data()->live_lo_objects_size_ += size;
   } else {
     UNREACHABLE();
   }
@@ -759,9 +1302,9 @@ void MarkCompactCollector::UpdateLiveObjectCount(HeapObject* obj) {
 
 void MarkCompactCollector::SweepLargeObjectSpace() {
 #ifdef DEBUG
-  ASSERT(state_ == MARK_LIVE_OBJECTS);
-  state_ =
-      compacting_collection_ ? ENCODE_FORWARDING_ADDRESSES : SWEEP_SPACES;
+  ASSERT(data()->state_ == MARK_LIVE_OBJECTS);
+  data()->state_ = data()->compacting_collection_ ?
+      ENCODE_FORWARDING_ADDRESSES : SWEEP_SPACES;
 #endif
   // Deallocate unmarked objects and clear marked bits for marked objects.
   Heap::lo_space()->FreeUnmarkedObjects();
@@ -1290,6 +1833,236 @@ static void SweepNewSpace(NewSpace* space) {
 }
 
 
+// Sweep a single page: clear the marks of live objects and deallocate the
+// blocks of dead objects that are followed by live objects.  Returns the
+// start of the dead block at the end of the page, or NULL if the page ends
+// with a live object.  The trailing block is left to the caller, which
+// may be able to free the whole page or move the allocation top instead.
+static Address SweepPage(Page* p, DeallocateFunction dealloc) {
+  bool is_previous_alive = true;
+  Address free_start = NULL;
+  HeapObject* object;
+
+  for (Address current = p->ObjectAreaStart();
+       current < p->AllocationTop();
+       current += object->Size()) {
+    object = HeapObject::FromAddress(current);
+    if (object->IsMarked()) {
+      object->ClearMark();
+      MarkCompactCollector::tracer()->decrement_marked_count();
+
+      if (!is_previous_alive) {  // Transition from free to live.
+        dealloc(free_start,
+                static_cast<int>(current - free_start),
+                true,
+                false);
+        is_previous_alive = true;
+      }
+    } else {
+      MarkCompactCollector::ReportDeleteIfNeeded(object);
+      if (is_previous_alive) {  // Transition from live to free.
+        free_start = current;
+        is_previous_alive = false;
+      }
+    }
+    // The object is now unmarked for the call to Size() at the top of the
+    // loop.
+  }
+
+  return is_previous_alive ? NULL : free_start;
+}
+
+
+// -------------------------------------------------------------------------
+// Parallel sweeping.
+//
+// Sweeping cannot be postponed until after the collection, because the
+// mark bits live in the map words and must all be cleared before the
+// mutator runs again.  Instead, with --parallel_sweeping the pages of a
+// space are swept by all the GC threads.  Each thread claims pages one at
+// a time, clears the marks of the live objects and records the blocks of
+// dead objects.  Dead objects and their maps are only read, so the
+// threads do not interfere with each other.
+//
+// The main thread then goes through the pages in order and deallocates
+// the recorded blocks.  This touches the free lists and the space's
+// accounting, which are not thread safe, and keeps the freeing of empty
+// pages at the end of the space exactly as in the serial sweeper.  Code
+// and object delete events need the logger, so parallel sweeping is not
+// used while logging or profiling.
+class ParallelSweeper : public AllStatic {
+ public:
+  static bool CanSweep() {
+    return FLAG_parallel_sweeping &&
+           FLAG_parallel_gc_threads > 1 &&
+           !Logger::is_logging() &&
+           !CpuProfiler::is_profiling();
+  }
+
+  // Clear the marks on all pages of a space in use and record the dead
+  // blocks on them using all the GC threads.
+  static void SweepPages(PagedSpace* space);
+
+  // Deallocate the blocks recorded for the page with the given index,
+  // except for the trailing one.  Returns the same as SweepPage.
+  static Address DeallocateDeadBlocks(int page_index,
+                                      DeallocateFunction dealloc);
+
+  static void TearDown();
+
+ private:
+  struct PageResult {
+    // The thread that swept the page and the range of its dead blocks in
+    // that thread's list.
+    int thread;
+    int first_block;
+    int last_block;
+    Address free_start;
+  };
+
+  static void SweepTask(int index);
+  static void SweepPage(int thread, int page_index);
+
+  class Data {
+   public:
+    List<Page*>* pages_;
+    List<PageResult>* results_;
+    volatile AtomicWord next_page_;
+
+    // Per thread lists of dead blocks as start and end addresses, and the
+    // number of marks each thread cleared.
+    int thread_count_;
+    List<Address>* dead_blocks_;
+    int* cleared_marks_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kParallelSweeperData));
+  }
+
+  friend class Isolate;
+};
+
+
+DEFINE_ISOLATE_COMPONENT(ParallelSweeper)
+
+
+void ParallelSweeper::SweepPages(PagedSpace* space) {
+  Data* data = ParallelSweeper::data();
+  GCThreads::EnsureThreads(FLAG_parallel_gc_threads);
+  if (data->thread_count_ != GCThreads::count()) {
+    TearDown();
+    data->thread_count_ = GCThreads::count();
+    data->dead_blocks_ = new List<Address>[data->thread_count_];
+    data->cleared_marks_ = NewArray<int>(data->thread_count_);
+    data->pages_ = new List<Page*>();
+    data->results_ = new List<PageResult>();
+  }
+  for (int i = 0; i < data->thread_count_; i++) {
+    data->dead_blocks_[i].Rewind(0);
+    data->cleared_marks_[i] = 0;
+  }
+
+  data->pages_->Rewind(0);
+  PageIterator it(space, PageIterator::PAGES_IN_USE);
+  while (it.has_next()) data->pages_->Add(it.next());
+  data->results_->Rewind(0);
+  PageResult empty = { 0, 0, 0, NULL };
+  data->results_->AddBlock(empty, data->pages_->length());
+
+  data->next_page_ = 0;
+  GCThreads::Run(&SweepTask);
+
+  int cleared_marks = 0;
+  for (int i = 0; i < data->thread_count_; i++) {
+    cleared_marks += data->cleared_marks_[i];
+  }
+  MarkCompactCollector::tracer()->add_marked_count(-cleared_marks);
+}
+
+
+void ParallelSweeper::SweepTask(int index) {
+  while (true) {
+    AtomicWord page_index = data()->next_page_;
+    if (page_index >= data()->pages_->length()) return;
+    if (OS::CompareAndSwap(&data()->next_page_, page_index, page_index + 1) ==
+        page_index) {
+      SweepPage(index, static_cast<int>(page_index));
+    }
+  }
+}
+
+
+void ParallelSweeper::SweepPage(int thread, int page_index) {
+  Page* p = data()->pages_->at(page_index);
+  List<Address>* blocks = &data()->dead_blocks_[thread];
+  PageResult* result = &data()->results_->at(page_index);
+  result->thread = thread;
+  result->first_block = blocks->length();
+
+  int cleared_marks = 0;
+  bool is_previous_alive = true;
+  Address free_start = NULL;
+  HeapObject* object;
+
+  for (Address current = p->ObjectAreaStart();
+       current < p->AllocationTop();
+       current += object->Size()) {
+    object = HeapObject::FromAddress(current);
+    if (object->IsMarked()) {
+      object->ClearMark();
+      cleared_marks++;
+
+      if (!is_previous_alive) {  // Transition from free to live.
+        blocks->Add(free_start);
+        blocks->Add(current);
+        is_previous_alive = true;
+      }
+    } else if (is_previous_alive) {  // Transition from live to free.
+      free_start = current;
+      is_previous_alive = false;
+    }
+  }
+
+  result->last_block = blocks->length();
+  result->free_start = is_previous_alive ? NULL : free_start;
+  data()->cleared_marks_[thread] += cleared_marks;
+}
+
+
+Address ParallelSweeper::DeallocateDeadBlocks(int page_index,
+                                              DeallocateFunction dealloc) {
+  const PageResult& result = data()->results_->at(page_index);
+  List<Address>* blocks = &data()->dead_blocks_[result.thread];
+  for (int i = result.first_block; i < result.last_block; i += 2) {
+    Address start = blocks->at(i);
+    dealloc(start, static_cast<int>(blocks->at(i + 1) - start), true, false);
+  }
+  return result.free_start;
+}
+
+
+void ParallelSweeper::TearDown() {
+  delete[] data()->dead_blocks_;
+  data()->dead_blocks_ = NULL;
+  DeleteArray(data()->cleared_marks_);
+  data()->cleared_marks_ = NULL;
+  data()->thread_count_ = 0;
+  delete data()->pages_;
+  data()->pages_ = NULL;
+  delete data()->results_;
+  data()->results_ = NULL;
+}
+
+
+void MarkCompactCollector::TearDown() {
+  ParallelMarker::TearDown();
+  ParallelSweeper::TearDown();
+  GCThreads::TearDown();
+}
+
+
 static void SweepSpace(PagedSpace* space, DeallocateFunction dealloc) {
   PageIterator it(space, PageIterator::PAGES_IN_USE);
 
@@ -1315,38 +2088,17 @@ static void SweepSpace(PagedSpace* space, DeallocateFunction dealloc) {
   Address last_free_start = NULL;
   int last_free_size = 0;
 
+  bool parallel = ParallelSweeper::CanSweep();
+  if (parallel) ParallelSweeper::SweepPages(space);
+  int page_index = 0;
+
   while (it.has_next()) {
     Page* p = it.next();
 
-    bool is_previous_alive = true;
-    Address free_start = NULL;
-    HeapObject* object;
-
-    for (Address current = p->ObjectAreaStart();
-         current < p->AllocationTop();
-         current += object->Size()) {
-      object = HeapObject::FromAddress(current);
-      if (object->IsMarked()) {
-        object->ClearMark();
-        MarkCompactCollector::tracer()->decrement_marked_count();
-
-        if (!is_previous_alive) {  // Transition from free to live.
-          dealloc(free_start,
-                  static_cast<int>(current - free_start),
-                  true,
-                  false);
-          is_previous_alive = true;
-        }
-      } else {
-        MarkCompactCollector::ReportDeleteIfNeeded(object);
-        if (is_previous_alive) {  // Transition from live to free.
-          free_start = current;
-          is_previous_alive = false;
-        }
-      }
-      // The object is now unmarked for the call to Size() at the top of the
-      // loop.
-    }
+    Address free_start = parallel
+        ? ParallelSweeper::DeallocateDeadBlocks(page_index++, dealloc)
+        : SweepPage(p, dealloc);
+    bool is_previous_alive = (free_start == NULL);
 
     bool page_is_empty = (p->ObjectAreaStart() == p->AllocationTop())
         || (!is_previous_alive && free_start == p->ObjectAreaStart());
@@ -1488,7 +2240,7 @@ void MarkCompactCollector::DeallocateCellBlock(Address start,
 
 
 void MarkCompactCollector::EncodeForwardingAddresses() {
-  ASSERT(state_ == ENCODE_FORWARDING_ADDRESSES);
+  ASSERT(data()->state_ == ENCODE_FORWARDING_ADDRESSES);
   // Objects in the active semispace of the young generation may be
   // relocated to the inactive semispace (if not promoted).  Set the
   // relocation info to the beginning of the inactive semispace.
@@ -1742,9 +2494,9 @@ MapCompact::MapUpdatingVisitor MapCompact::map_updating_visitor_;
 
 
 void MarkCompactCollector::SweepSpaces() {
-  GCTracer::Scope gc_scope(tracer_, GCTracer::Scope::MC_SWEEP);
+  GCTracer::Scope gc_scope(data()->tracer_, GCTracer::Scope::MC_SWEEP);
 
-  ASSERT(state_ == SWEEP_SPACES);
+  ASSERT(data()->state_ == SWEEP_SPACES);
   ASSERT(!IsCompacting());
   // Noncompacting collections simply sweep the spaces to clear the mark
   // bits and free the nonlive blocks (for old and map spaces).  We sweep
@@ -1765,7 +2517,7 @@ void MarkCompactCollector::SweepSpaces() {
 
   int live_maps_size = Heap::map_space()->Size();
   int live_maps = live_maps_size / Map::kSize;
-  ASSERT(live_map_objects_size_ == live_maps_size);
+  ASSERT(data()->live_map_objects_size_ == live_maps_size);
 
   if (Heap::map_space()->NeedsCompaction(live_maps)) {
     MapCompact map_compact(live_maps);
@@ -1816,14 +2568,16 @@ int MarkCompactCollector::IterateLiveObjectsInRange(
 
 int MarkCompactCollector::IterateLiveObjects(NewSpace* space,
                                              HeapObjectCallback size_f) {
-  ASSERT(MARK_LIVE_OBJECTS < state_ && state_ <= RELOCATE_OBJECTS);
+  ASSERT(MARK_LIVE_OBJECTS < data()->state_ &&
+         data()->state_ <= RELOCATE_OBJECTS);
   return IterateLiveObjectsInRange(space->bottom(), space->top(), size_f);
 }
 
 
 int MarkCompactCollector::IterateLiveObjects(PagedSpace* space,
                                              HeapObjectCallback size_f) {
-  ASSERT(MARK_LIVE_OBJECTS < state_ && state_ <= RELOCATE_OBJECTS);
+  ASSERT(MARK_LIVE_OBJECTS < data()->state_ &&
+         data()->state_ <= RELOCATE_OBJECTS);
   int total = 0;
   PageIterator it(space, PageIterator::PAGES_IN_USE);
   while (it.has_next()) {
@@ -1931,8 +2685,8 @@ class UpdatingVisitor: public ObjectVisitor {
 
 void MarkCompactCollector::UpdatePointers() {
 #ifdef DEBUG
-  ASSERT(state_ == ENCODE_FORWARDING_ADDRESSES);
-  state_ = UPDATE_POINTERS;
+  ASSERT(data()->state_ == ENCODE_FORWARDING_ADDRESSES);
+  data()->state_ = UPDATE_POINTERS;
 #endif
   UpdatingVisitor updating_visitor;
   Heap::IterateRoots(&updating_visitor, VISIT_ONLY_STRONG);
@@ -1962,12 +2716,12 @@ void MarkCompactCollector::UpdatePointers() {
   USE(live_codes_size);
   USE(live_cells_size);
   USE(live_news_size);
-  ASSERT(live_maps_size == live_map_objects_size_);
-  ASSERT(live_data_olds_size == live_old_data_objects_size_);
-  ASSERT(live_pointer_olds_size == live_old_pointer_objects_size_);
-  ASSERT(live_codes_size == live_code_objects_size_);
-  ASSERT(live_cells_size == live_cell_objects_size_);
-  ASSERT(live_news_size == live_young_objects_size_);
+  ASSERT(live_maps_size == data()->live_map_objects_size_);
+  ASSERT(live_data_olds_size == data()->live_old_data_objects_size_);
+  ASSERT(live_pointer_olds_size == data()->live_old_pointer_objects_size_);
+  ASSERT(live_codes_size == data()->live_code_objects_size_);
+  ASSERT(live_cells_size == data()->live_cell_objects_size_);
+  ASSERT(live_news_size == data()->live_young_objects_size_);
 }
 
 
@@ -2076,8 +2830,8 @@ Address MarkCompactCollector::GetForwardingAddressInOldSpace(HeapObject* obj) {
 
 void MarkCompactCollector::RelocateObjects() {
 #ifdef DEBUG
-  ASSERT(state_ == UPDATE_POINTERS);
-  state_ = RELOCATE_OBJECTS;
+  ASSERT(data()->state_ == UPDATE_POINTERS);
+  data()->state_ = RELOCATE_OBJECTS;
 #endif
   // Relocates objects, always relocate map objects first. Relocating
   // objects in other space relies on map objects to get object size.
@@ -2100,12 +2854,12 @@ void MarkCompactCollector::RelocateObjects() {
   USE(live_codes_size);
   USE(live_cells_size);
   USE(live_news_size);
-  ASSERT(live_maps_size == live_map_objects_size_);
-  ASSERT(live_data_olds_size == live_old_data_objects_size_);
-  ASSERT(live_pointer_olds_size == live_old_pointer_objects_size_);
-  ASSERT(live_codes_size == live_code_objects_size_);
-  ASSERT(live_cells_size == live_cell_objects_size_);
-  ASSERT(live_news_size == live_young_objects_size_);
+  ASSERT(live_maps_size == data()->live_map_objects_size_);
+  ASSERT(live_data_olds_size == data()->live_old_data_objects_size_);
+  ASSERT(live_pointer_olds_size == data()->live_old_pointer_objects_size_);
+  ASSERT(live_codes_size == data()->live_code_objects_size_);
+  ASSERT(live_cells_size == data()->live_cell_objects_size_);
+  ASSERT(live_news_size == data()->live_young_objects_size_);
 
   // Flip from and to spaces
   Heap::new_space()->Flip();
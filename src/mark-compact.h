@@ -48,6 +48,8 @@ typedef void (*DeallocateFunction)(Address start,
 // Forward declarations.
 class RootMarkingVisitor;
 class MarkingVisitor;
+class ParallelMarker;
+class GCThread;
 
 
 // -------------------------------------------------------------------------
@@ -83,7 +85,7 @@ class MarkCompactCollector: public AllStatic {
   // Set the global force_compaction flag, it must be called before Prepare
   // to take effect.
   static void SetForceCompaction(bool value) {
-    force_compaction_ = value;
+    data()->force_compaction_ = value;
   }
 
   // Prepares for GC by resetting relocation info in old and map spaces and
@@ -94,35 +96,42 @@ class MarkCompactCollector: public AllStatic {
   static void CollectGarbage();
 
   // True if the last full GC performed heap compaction.
-  static bool HasCompacted() { return compacting_collection_; }
+  static bool HasCompacted() { return data()->compacting_collection_; }
 
   // True after the Prepare phase if the compaction is taking place.
   static bool IsCompacting() {
 #ifdef DEBUG
     // For the purposes of asserts we don't want this to keep returning true
     // after the collection is completed.
-    return state_ != IDLE && compacting_collection_;
+    return data()->state_ != IDLE && data()->compacting_collection_;
 #else
-    return compacting_collection_;
+    return data()->compacting_collection_;
 #endif
   }
 
   // The count of the number of objects left marked at the end of the last
   // completed full GC (expected to be zero).
-  static int previous_marked_count() { return previous_marked_count_; }
+  static int previous_marked_count() { return data()->previous_marked_count_; }
 
   // During a full GC, there is a stack-allocated GCTracer that is used for
   // bookkeeping information.  Return a pointer to that tracer.
-  static GCTracer* tracer() { return tracer_; }
+  static GCTracer* tracer() { return data()->tracer_; }
 
 #ifdef DEBUG
   // Checks whether performing mark-compact collection.
-  static bool in_use() { return state_ > PREPARE_GC; }
+  static bool in_use() { return data()->state_ > PREPARE_GC; }
+
+  // Returns the number of objects visited by the given parallel marking
+  // thread during the last full GC, zero if parallel marking was not used.
+  static int ParallelMarkingWorkCount(int thread);
 #endif
 
   // Determine type of object and emit deletion log event.
   static void ReportDeleteIfNeeded(HeapObject* obj);
 
+  // Stops the threads used for parallel marking.
+  static void TearDown();
+
  private:
 #ifdef DEBUG
   enum CollectorState {
@@ -135,27 +144,8 @@ class MarkCompactCollector: public AllStatic {
     RELOCATE_OBJECTS
   };
 
-  // The current stage of the collector.
-  static CollectorState state_;
 #endif
 
-  // Global flag that forces a compaction.
-  static bool force_compaction_;
-
-  // Global flag indicating whether spaces were compacted on the last GC.
-  static bool compacting_collection_;
-
-  // Global flag indicating whether spaces will be compacted on the next GC.
-  static bool compact_on_next_gc_;
-
-  // The number of objects left marked at the end of the last completed full
-  // GC (expected to be zero).
-  static int previous_marked_count_;
-
-  // A pointer to the current stack-allocated GC tracer object during a full
-  // collection (NULL before and after).
-  static GCTracer* tracer_;
-
   // Finishes GC, performs heap verification if enabled.
   static void Finish();
 
@@ -171,6 +161,7 @@ class MarkCompactCollector: public AllStatic {
 
   friend class RootMarkingVisitor;
   friend class MarkingVisitor;
+  friend class ParallelMarker;
 
   // Marking operations for objects reachable from roots.
   static void MarkLiveObjects();
@@ -182,9 +173,9 @@ class MarkCompactCollector: public AllStatic {
   }
 
   static inline void SetMark(HeapObject* obj) {
-    tracer_->increment_marked_count();
+    data()->tracer_->increment_marked_count();
 #ifdef DEBUG
-    UpdateLiveObjectCount(obj);
+    UpdateLiveObjectCount(obj, obj->map());
 #endif
     obj->SetMark();
   }
@@ -236,7 +227,10 @@ class MarkCompactCollector: public AllStatic {
   static bool IsUnmarkedHeapObject(Object** p);
 
 #ifdef DEBUG
-  static void UpdateLiveObjectCount(HeapObject* obj);
+  // Update the live object counters for an object that is being marked.
+  // The map is passed explicitly because the object's map word might
+  // already be marked.
+  static void UpdateLiveObjectCount(HeapObject* obj, Map* map);
 #endif
 
   // We sweep the large object space in the same way whether we are
@@ -413,36 +407,119 @@ class MarkCompactCollector: public AllStatic {
   // Counters used for debugging the marking phase of mark-compact or
   // mark-sweep collection.
 
-  // Size of live objects in Heap::to_space_.
-  static int live_young_objects_size_;
+  friend class MarkObjectVisitor;
+  static void VisitObject(HeapObject* obj);
 
-  // Size of live objects in Heap::old_pointer_space_.
-  static int live_old_pointer_objects_size_;
+  friend class UnmarkObjectVisitor;
+  static void UnmarkObject(HeapObject* obj);
+#endif
 
-  // Size of live objects in Heap::old_data_space_.
-  static int live_old_data_objects_size_;
+  // The state of the collector of an isolate.
+  class Data {
+   public:
+#ifdef DEBUG
+    // The current stage of the collector.
+    CollectorState state_;
+#endif
 
-  // Size of live objects in Heap::code_space_.
-  static int live_code_objects_size_;
+    // Global flag that forces a compaction.
+    bool force_compaction_;
 
-  // Size of live objects in Heap::map_space_.
-  static int live_map_objects_size_;
+    // Global flag indicating whether spaces were compacted on the last GC.
+    bool compacting_collection_;
 
-  // Size of live objects in Heap::cell_space_.
-  static int live_cell_objects_size_;
+    // Global flag indicating whether spaces will be compacted on the next GC.
+    bool compact_on_next_gc_;
 
-  // Size of live objects in Heap::lo_space_.
-  static int live_lo_objects_size_;
+    // The number of objects left marked at the end of the last completed
+    // full GC (expected to be zero).
+    int previous_marked_count_;
 
-  // Number of live bytes in this collection.
-  static int live_bytes_;
+    // A pointer to the current stack-allocated GC tracer object during a
+    // full collection (NULL before and after).
+    GCTracer* tracer_;
 
-  friend class MarkObjectVisitor;
-  static void VisitObject(HeapObject* obj);
+    // The stack of objects whose children still have to be marked.
+    MarkingStack marking_stack_;
 
-  friend class UnmarkObjectVisitor;
-  static void UnmarkObject(HeapObject* obj);
+#ifdef DEBUG
+    // Counters used for debugging the marking phase of mark-compact or
+    // mark-sweep collection.
+
+    // Size of live objects in Heap::to_space_.
+    int live_young_objects_size_;
+
+    // Size of live objects in Heap::old_pointer_space_.
+    int live_old_pointer_objects_size_;
+
+    // Size of live objects in Heap::old_data_space_.
+    int live_old_data_objects_size_;
+
+    // Size of live objects in Heap::code_space_.
+    int live_code_objects_size_;
+
+    // Size of live objects in Heap::map_space_.
+    int live_map_objects_size_;
+
+    // Size of live objects in Heap::cell_space_.
+    int live_cell_objects_size_;
+
+    // Size of live objects in Heap::lo_space_.
+    int live_lo_objects_size_;
+
+    // Number of live bytes in this collection.
+    int live_bytes_;
 #endif
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kMarkCompactCollectorData));
+  }
+
+  friend class Isolate;
+};
+
+
+// A pool of threads helping the main thread with the parallel parts of
+// garbage collections.  The threads are started on first use and wait for
+// the next task between collections.
+class GCThreads : public AllStatic {
+ public:
+  // A task is run once on every thread and is passed the index of the
+  // thread, which is zero for the main thread.
+  typedef void (*Task)(int index);
+
+  // Make sure there are count threads, the main thread included.
+  static void EnsureThreads(int count);
+
+  static int count() { return data()->count_; }
+  static Mutex* mutex() { return data()->mutex_; }
+
+  // Run a task on all the threads and wait until they are all done.
+  static void Run(Task task);
+
+  static void TearDown();
+
+ private:
+  // The threads of an isolate.
+  class Data {
+   public:
+    int count_;
+    GCThread** threads_;
+    Mutex* mutex_;
+    Semaphore* done_semaphore_;
+    Task task_;
+    volatile bool stopping_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kGCThreadsData));
+  }
+
+  friend class GCThread;
+  friend class Isolate;
 };
 
 
@@ -230,7 +230,7 @@ MemOperand::MemOperand(Register rm, int16_t offset) : Operand(rm) {
 // Implementation of Assembler.
 
 static const int kMinimalBufferSize = 4*KB;
-static byte* spare_buffer_ = NULL;
+DEFINE_ISOLATE_COMPONENT(Assembler)
 
 Assembler::Assembler(void* buffer, int buffer_size) {
   if (buffer == NULL) {
@@ -238,9 +238,10 @@ Assembler::Assembler(void* buffer, int buffer_size) {
     if (buffer_size <= kMinimalBufferSize) {
       buffer_size = kMinimalBufferSize;
 
-      if (spare_buffer_ != NULL) {
-        buffer = spare_buffer_;
-        spare_buffer_ = NULL;
+      Data* data = Assembler::data();
+      if (data->spare_buffer_ != NULL) {
+        buffer = data->spare_buffer_;
+        data->spare_buffer_ = NULL;
       }
     }
     if (buffer == NULL) {
@@ -272,8 +273,9 @@ Assembler::Assembler(void* buffer, int buffer_size) {
 
 Assembler::~Assembler() {
   if (own_buffer_) {
-    if (spare_buffer_ == NULL && buffer_size_ == kMinimalBufferSize) {
-      spare_buffer_ = buffer_;
+    Data* data = Assembler::data();
+    if (data->spare_buffer_ == NULL && buffer_size_ == kMinimalBufferSize) {
+      data->spare_buffer_ = buffer_;
     } else {
       DeleteArray(buffer_);
     }
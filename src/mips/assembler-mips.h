@@ -573,6 +573,20 @@ class Assembler : public Malloced {
   // True if the assembler owns the buffer, false if buffer is external.
   bool own_buffer_;
 
+  class Data {
+   public:
+    ~Data() { DeleteArray(spare_buffer_); }
+    // A previously allocated buffer of kMinimalBufferSize bytes, or NULL.
+    byte* spare_buffer_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kAssemblerData));
+  }
+
+  friend class Isolate;
+
   // Buffer size and constant pool distance are checked together at regular
   // intervals of kBufferCheckInterval emitted bytes.
   static const int kBufferCheckInterval = 1*KB/2;
@@ -32,6 +32,7 @@
 #include "v8.h"
 
 #include "bootstrapper.h"
+#include "jsregexp.h"
 #include "natives.h"
 #include "platform.h"
 #include "serialize.h"
@@ -204,6 +205,44 @@ class CppByteSink : public i::SnapshotByteSink {
 };
 
 
+// Compiles the regexps listed in the given file, one /pattern/flags per
+// line, so that their code is part of the snapshot.
+static void CompileRegExps(const char* file_name) {
+  bool exists;
+  i::Vector<const char> file = i::ReadFile(file_name, &exists);
+  if (!exists) exit(1);
+  int line_number = 0;
+  int start = 0;
+  while (start < file.length()) {
+    int end = start;
+    while (end < file.length() && file[end] != '\n') end++;
+    line_number++;
+    int line_end = end;
+    if (line_end > start && file[line_end - 1] == '\r') line_end--;
+    if (line_end > start) {
+      int slash = line_end - 1;
+      while (slash > start && file[slash] != '/') slash--;
+      if (file[start] != '/' || slash == start) {
+        i::PrintF("%s:%d: expected /pattern/flags\n", file_name, line_number);
+        exit(1);
+      }
+      HandleScope scope;
+      i::Handle<i::String> pattern = i::Factory::NewStringFromUtf8(
+          i::Vector<const char>(file.start() + start + 1, slash - start - 1));
+      int flags_length = line_end - slash - 1;
+      i::Handle<i::String> flags = i::Factory::NewStringFromAscii(
+          i::Vector<const char>(file.start() + slash + 1, flags_length));
+      if (!i::RegExpImpl::Precompile(pattern, flags)) {
+        i::PrintF("%s:%d: unable to compile regexp\n", file_name, line_number);
+        exit(1);
+      }
+    }
+    start = end + 1;
+  }
+  file.Dispose();
+}
+
+
 int main(int argc, char** argv) {
 #ifdef ENABLE_LOGGING_AND_PROFILING
   // By default, log code create information in the snapshot.
@@ -226,6 +265,10 @@ int main(int argc, char** argv) {
       i::Bootstrapper::NativesSourceLookup(i);
     }
   }
+  if (i::FLAG_snapshot_regexps != NULL) {
+    Context::Scope scope(context);
+    CompileRegExps(i::FLAG_snapshot_regexps);
+  }
   // If we don't do this then we end up with a stray root pointing at the
   // context even after we have disposed of the context.
   i::Heap::CollectAllGarbage(true);
@@ -557,6 +557,8 @@ static const char* TypeToString(InstanceType type) {
     case STRING_TYPE: return "TWO_BYTE_STRING";
     case CONS_STRING_TYPE:
     case CONS_ASCII_STRING_TYPE: return "CONS_STRING";
+    case SLICED_STRING_TYPE:
+    case SLICED_ASCII_STRING_TYPE: return "SLICED_STRING";
     case EXTERNAL_ASCII_STRING_TYPE:
     case EXTERNAL_STRING_TYPE: return "EXTERNAL_STRING";
     case FIXED_ARRAY_TYPE: return "FIXED_ARRAY";
@@ -719,6 +721,14 @@ void String::StringVerify() {
   if (IsSymbol()) {
     CHECK(!Heap::InNewSpace(this));
   }
+  if (StringShape(this).IsSliced()) {
+    SlicedString* slice = SlicedString::cast(this);
+    CHECK(!StringShape(this).IsSymbol());
+    CHECK(slice->parent()->IsSeqString() ||
+          slice->parent()->IsExternalString());
+    CHECK(slice->offset() >= 0);
+    CHECK(slice->offset() + length() <= slice->parent()->length());
+  }
 }
 
 
@@ -928,6 +938,12 @@ void JSRegExp::JSRegExpVerify() {
           (is_native ? uc16_data->IsCode() : uc16_data->IsByteArray()));
       ASSERT(arr->get(JSRegExp::kIrregexpCaptureCountIndex)->IsSmi());
       ASSERT(arr->get(JSRegExp::kIrregexpMaxRegisterCountIndex)->IsSmi());
+      Object* prefix = arr->get(JSRegExp::kIrregexpPrefixIndex);
+      ASSERT(prefix->IsUndefined() || prefix->IsString());
+      Object* nfa_code = arr->get(JSRegExp::kIrregexpNfaCodeIndex);
+      ASSERT(nfa_code->IsTheHole() || nfa_code->IsUndefined() ||
+             nfa_code->IsByteArray());
+      ASSERT(arr->get(JSRegExp::kIrregexpBacktrackLimitIndex)->IsSmi());
       break;
     }
     default:
@@ -1134,6 +1150,7 @@ void Script::ScriptVerify() {
   type()->SmiVerify();
   VerifyPointer(line_ends());
   VerifyPointer(id());
+  VerifyPointer(preparse_data());
 }
 
 
@@ -1165,6 +1182,8 @@ void Script::ScriptPrint() {
   eval_from_shared()->ShortPrint();
   PrintF("\n - eval from instructions offset: ");
   eval_from_instructions_offset()->ShortPrint();
+  PrintF("\n - preparse data: ");
+  preparse_data()->ShortPrint();
   PrintF("\n");
 }
 
@@ -167,6 +167,14 @@ bool Object::IsConsString() {
 }
 
 
+bool Object::IsSlicedString() {
+  if (!this->IsHeapObject()) return false;
+  uint32_t type = HeapObject::cast(this)->map()->instance_type();
+  return (type & (kIsNotStringMask | kStringRepresentationMask)) ==
+         (kStringTag | kSlicedStringTag);
+}
+
+
 bool Object::IsSeqString() {
   if (!IsString()) return false;
   return StringShape(String::cast(this)).IsSequential();
@@ -241,6 +249,9 @@ bool String::IsAsciiRepresentation() {
       ConsString::cast(this)->second()->length() == 0) {
     return ConsString::cast(this)->first()->IsAsciiRepresentation();
   }
+  if ((type & kStringRepresentationMask) == kSlicedStringTag) {
+    return SlicedString::cast(this)->parent()->IsAsciiRepresentation();
+  }
   return (type & kStringEncodingMask) == kAsciiStringTag;
 }
 
@@ -251,6 +262,9 @@ bool String::IsTwoByteRepresentation() {
              ConsString::cast(this)->second()->length() == 0) {
     return ConsString::cast(this)->first()->IsTwoByteRepresentation();
   }
+  if ((type & kStringRepresentationMask) == kSlicedStringTag) {
+    return SlicedString::cast(this)->parent()->IsTwoByteRepresentation();
+  }
   return (type & kStringEncodingMask) == kTwoByteStringTag;
 }
 
@@ -270,6 +284,11 @@ bool StringShape::IsCons() {
 }
 
 
+bool StringShape::IsSliced() {
+  return (type_ & kStringRepresentationMask) == kSlicedStringTag;
+}
+
+
 bool StringShape::IsExternal() {
   return (type_ & kStringRepresentationMask) == kExternalStringTag;
 }
@@ -1624,6 +1643,7 @@ CAST_ACCESSOR(SeqString)
 CAST_ACCESSOR(SeqAsciiString)
 CAST_ACCESSOR(SeqTwoByteString)
 CAST_ACCESSOR(ConsString)
+CAST_ACCESSOR(SlicedString)
 CAST_ACCESSOR(ExternalString)
 CAST_ACCESSOR(ExternalAsciiString)
 CAST_ACCESSOR(ExternalTwoByteString)
@@ -1716,6 +1736,22 @@ String* String::TryFlattenGetString(PretenureFlag pretenure) {
 }
 
 
+bool StringCharacterStream::has_more() {
+  return position_ < end_ || NextLeaf();
+}
+
+
+uint16_t StringCharacterStream::GetNext() {
+  if (position_ == end_) {
+    bool more = NextLeaf();
+    ASSERT(more);
+    USE(more);
+  }
+  if (is_ascii_) return static_cast<uint8_t>(ascii_chars_[position_++]);
+  return two_byte_chars_[position_++];
+}
+
+
 uint16_t String::Get(int index) {
   ASSERT(index >= 0 && index < length());
   switch (StringShape(this).full_representation_tag()) {
@@ -1726,6 +1762,9 @@ uint16_t String::Get(int index) {
     case kConsStringTag | kAsciiStringTag:
     case kConsStringTag | kTwoByteStringTag:
       return ConsString::cast(this)->ConsStringGet(index);
+    case kSlicedStringTag | kAsciiStringTag:
+    case kSlicedStringTag | kTwoByteStringTag:
+      return SlicedString::cast(this)->SlicedStringGet(index);
     case kExternalStringTag | kAsciiStringTag:
       return ExternalAsciiString::cast(this)->ExternalAsciiStringGet(index);
     case kExternalStringTag | kTwoByteStringTag:
@@ -1849,6 +1888,21 @@ void ConsString::set_second(String* value, WriteBarrierMode mode) {
 }
 
 
+String* SlicedString::parent() {
+  return String::cast(READ_FIELD(this, kParentOffset));
+}
+
+
+void SlicedString::set_parent(String* value, WriteBarrierMode mode) {
+  ASSERT(value->IsSeqString() || value->IsExternalString());
+  WRITE_FIELD(this, kParentOffset, value);
+  CONDITIONAL_WRITE_BARRIER(this, kParentOffset, mode);
+}
+
+
+SMI_ACCESSORS(SlicedString, offset, kOffsetOffset)
+
+
 ExternalAsciiString::Resource* ExternalAsciiString::resource() {
   return *reinterpret_cast<Resource**>(FIELD_ADDR(this, kResourceOffset));
 }
@@ -2428,6 +2482,7 @@ ACCESSORS(Script, line_ends, Object, kLineEndsOffset)
 ACCESSORS(Script, eval_from_shared, Object, kEvalFromSharedOffset)
 ACCESSORS(Script, eval_from_instructions_offset, Smi,
           kEvalFrominstructionsOffsetOffset)
+ACCESSORS(Script, preparse_data, Object, kPreparseDataOffset)
 
 #ifdef ENABLE_DEBUGGER_SUPPORT
 ACCESSORS(DebugInfo, shared, SharedFunctionInfo, kSharedFunctionInfoIndex)
@@ -2578,6 +2633,18 @@ void SharedFunctionInfo::set_code(Code* value, WriteBarrierMode mode) {
 }
 
 
+int SharedFunctionInfo::code_age() {
+  return (compiler_hints() >> kCodeAgeShift) & kCodeAgeMask;
+}
+
+
+void SharedFunctionInfo::set_code_age(int age) {
+  ASSERT(0 <= age && age <= kMaxCodeAge);
+  set_compiler_hints((compiler_hints() & ~(kCodeAgeMask << kCodeAgeShift)) |
+                     (age << kCodeAgeShift));
+}
+
+
 bool SharedFunctionInfo::is_compiled() {
   // TODO(1242782): Create a code kind for uncompiled code.
   return code()->kind() != Code::STUB;
@@ -3038,6 +3105,19 @@ void StringHasher::AddCharacterNoIndex(uc32 c) {
 }
 
 
+template <typename Char>
+void StringHasher::AddCharactersNoIndex(const Char* chars, int length) {
+  ASSERT(!is_array_index());
+  uint32_t running_hash = raw_running_hash_;
+  for (int i = 0; i < length; i++) {
+    running_hash += chars[i];
+    running_hash += (running_hash << 10);
+    running_hash ^= (running_hash >> 6);
+  }
+  raw_running_hash_ = running_hash;
+}
+
+
 uint32_t StringHasher::GetHash() {
   // Get the calculated raw hash value and do some more bit ops to distribute
   // the hash further. Ensure that we never return zero as the hash value.
@@ -677,6 +677,100 @@ Object* String::SlowTryFlatten(PretenureFlag pretenure) {
 }
 
 
+static const int kUnflattenedConsStringEntries = 2;
+
+
+class String::Data {
+ public:
+  Data() : utf8_length_cache_gc_count_(-1) { }
+
+  // The cons strings last accessed without flattening them and the number
+  // of uses in a row of each. There are two entries so that comparisons of
+  // two cons strings are counted too. The pointers are only compared, so it
+  // does not matter that they are not updated by the garbage collector.
+  String* unflattened_cons_strings_[kUnflattenedConsStringEntries];
+  int unflattened_cons_string_uses_[kUnflattenedConsStringEntries];
+  int unflattened_cons_string_next_entry_;
+
+  // The last two-byte string whose UTF-8 length was computed, since
+  // embedders often ask for the length of the same string more than once.
+  // The entry is only valid until the next garbage collection, which may
+  // move or free the string.
+  String* utf8_length_cache_string_;
+  int utf8_length_cache_gc_count_;
+  int utf8_length_cache_result_;
+
+  StaticResource<StringInputBuffer> string_input_buffer_;
+  StringInputBuffer string_compare_buffer_a_;
+  StringInputBuffer string_compare_buffer_b_;
+};
+
+
+DEFINE_ISOLATE_COMPONENT(String)
+
+
+bool String::ShouldFlatten() {
+  if (IsFlat() || length() <= kMaxAlwaysFlattenLength) return true;
+  Data* data = String::data();
+  for (int i = 0; i < kUnflattenedConsStringEntries; i++) {
+    if (data->unflattened_cons_strings_[i] == this) {
+      return ++data->unflattened_cons_string_uses_[i] >=
+          kConsStringUsesBeforeFlattening;
+    }
+  }
+  int entry = data->unflattened_cons_string_next_entry_;
+  data->unflattened_cons_string_next_entry_ =
+      (entry + 1) % kUnflattenedConsStringEntries;
+  data->unflattened_cons_strings_[entry] = this;
+  data->unflattened_cons_string_uses_[entry] = 1;
+  return false;
+}
+
+
+StringCharacterStream::StringCharacterStream(String* string, int offset)
+    : pending_(NULL) {
+  Descend(string, offset);
+}
+
+
+StringCharacterStream::~StringCharacterStream() {
+  delete pending_;
+}
+
+
+void StringCharacterStream::Descend(String* string, int offset) {
+  while (StringShape(string).IsCons()) {
+    ConsString* cons = ConsString::cast(string);
+    String* first = cons->first();
+    if (offset < first->length()) {
+      if (pending_ == NULL) pending_ = new List<String*>(4);
+      pending_->Add(cons->second());
+      string = first;
+    } else {
+      offset -= first->length();
+      string = cons->second();
+    }
+  }
+  is_ascii_ = string->IsAsciiRepresentation();
+  if (is_ascii_) {
+    ascii_chars_ = string->ToAsciiVector().start();
+  } else {
+    two_byte_chars_ = string->ToUC16Vector().start();
+  }
+  position_ = offset;
+  end_ = string->length();
+}
+
+
+bool StringCharacterStream::NextLeaf() {
+  while (pending_ != NULL && !pending_->is_empty()) {
+    Descend(pending_->RemoveLast(), 0);
+    if (position_ < end_) return true;
+  }
+  return false;
+}
+
+
 bool String::MakeExternal(v8::String::ExternalStringResource* resource) {
 #ifdef DEBUG
   if (FLAG_enable_slow_asserts) {
@@ -1067,6 +1161,9 @@ void HeapObject::IterateBody(InstanceType type, int object_size,
       case kConsStringTag:
         reinterpret_cast<ConsString*>(this)->ConsStringIterateBody(v);
         break;
+      case kSlicedStringTag:
+        reinterpret_cast<SlicedString*>(this)->SlicedStringIterateBody(v);
+        break;
       case kExternalStringTag:
         if ((type & kStringEncodingMask) == kAsciiStringTag) {
           reinterpret_cast<ExternalAsciiString*>(this)->
@@ -3776,9 +3873,6 @@ bool DescriptorArray::IsEqualTo(DescriptorArray* other) {
 #endif
 
 
-static StaticResource<StringInputBuffer> string_input_buffer;
-
-
 bool String::LooksValid() {
   if (!Heap::Contains(this)) return false;
   return true;
@@ -3792,7 +3886,26 @@ int String::Utf8Length() {
   // the string will be accessed later (for example by WriteUtf8)
   // so it's still a good idea.
   TryFlatten();
-  Access<StringInputBuffer> buffer(&string_input_buffer);
+  Data* data = String::data();
+  if (IsFlat()) {
+    if (data->utf8_length_cache_string_ == this &&
+        data->utf8_length_cache_gc_count_ == Heap::gc_count()) {
+      return data->utf8_length_cache_result_;
+    }
+    Vector<const uc16> chars = ToUC16Vector();
+    int result = 0;
+    for (int i = 0; i < chars.length(); i++) {
+      uc16 c = chars[i];
+      result += (c <= unibrow::Utf8::kMaxOneByteChar)
+          ? 1
+          : unibrow::Utf8::Length(c);
+    }
+    data->utf8_length_cache_string_ = this;
+    data->utf8_length_cache_gc_count_ = Heap::gc_count();
+    data->utf8_length_cache_result_ = result;
+    return result;
+  }
+  Access<StringInputBuffer> buffer(&data->string_input_buffer_);
   buffer->Reset(0, this);
   int result = 0;
   while (buffer->has_more())
@@ -3814,6 +3927,11 @@ Vector<const char> String::ToAsciiVector() {
     ASSERT(cons->second()->length() == 0);
     string = cons->first();
     string_tag = StringShape(string).representation_tag();
+  } else if (string_tag == kSlicedStringTag) {
+    SlicedString* slice = SlicedString::cast(string);
+    offset = slice->offset();
+    string = slice->parent();
+    string_tag = StringShape(string).representation_tag();
   }
   if (string_tag == kSeqStringTag) {
     SeqAsciiString* seq = SeqAsciiString::cast(string);
@@ -3840,6 +3958,11 @@ Vector<const uc16> String::ToUC16Vector() {
     ASSERT(cons->second()->length() == 0);
     string = cons->first();
     string_tag = StringShape(string).representation_tag();
+  } else if (string_tag == kSlicedStringTag) {
+    SlicedString* slice = SlicedString::cast(string);
+    offset = slice->offset();
+    string = slice->parent();
+    string_tag = StringShape(string).representation_tag();
   }
   if (string_tag == kSeqStringTag) {
     SeqTwoByteString* seq = SeqTwoByteString::cast(string);
@@ -3867,7 +3990,7 @@ SmartPointer<char> String::ToCString(AllowNullsFlag allow_nulls,
   if (length < 0) length = kMaxInt - offset;
 
   // Compute the size of the UTF-8 string. Start at the specified offset.
-  Access<StringInputBuffer> buffer(&string_input_buffer);
+  Access<StringInputBuffer> buffer(&data()->string_input_buffer_);
   buffer->Reset(offset, this);
   int character_position = offset;
   int utf8_bytes = 0;
@@ -3926,6 +4049,10 @@ const uc16* String::GetTwoByteData(unsigned start) {
     case kExternalStringTag:
       return ExternalTwoByteString::cast(this)->
         ExternalTwoByteStringGetData(start);
+    case kSlicedStringTag: {
+      SlicedString* slice = SlicedString::cast(this);
+      return slice->parent()->GetTwoByteData(start + slice->offset());
+    }
     case kConsStringTag:
       UNREACHABLE();
       return NULL;
@@ -3942,7 +4069,7 @@ SmartPointer<uc16> String::ToWideCString(RobustnessFlag robust_flag) {
     return SmartPointer<uc16>();
   }
 
-  Access<StringInputBuffer> buffer(&string_input_buffer);
+  Access<StringInputBuffer> buffer(&data()->string_input_buffer_);
   buffer->Reset(this);
 
   uc16* result = NewArray<uc16>(length() + 1);
@@ -4203,6 +4330,10 @@ const unibrow::byte* String::ReadBlock(String* input,
       return ConsString::cast(input)->ConsStringReadBlock(rbb,
                                                           offset_ptr,
                                                           max_chars);
+    case kSlicedStringTag:
+      return SlicedString::cast(input)->SlicedStringReadBlock(rbb,
+                                                              offset_ptr,
+                                                              max_chars);
     case kExternalStringTag:
       if (input->IsAsciiRepresentation()) {
         return ExternalAsciiString::cast(input)->ExternalAsciiStringReadBlock(
@@ -4225,11 +4356,11 @@ const unibrow::byte* String::ReadBlock(String* input,
 }
 
 
-Relocatable* Relocatable::top_ = NULL;
+DEFINE_ISOLATE_COMPONENT(Relocatable)
 
 
 void Relocatable::PostGarbageCollectionProcessing() {
-  Relocatable* current = top_;
+  Relocatable* current = data()->top_;
   while (current != NULL) {
     current->PostGarbageCollection();
     current = current->prev_;
@@ -4239,21 +4370,21 @@ void Relocatable::PostGarbageCollectionProcessing() {
 
 // Reserve space for statics needing saving and restoring.
 int Relocatable::ArchiveSpacePerThread() {
-  return sizeof(top_);
+  return sizeof(Relocatable*);
 }
 
 
 // Archive statics that are thread local.
 char* Relocatable::ArchiveState(char* to) {
-  *reinterpret_cast<Relocatable**>(to) = top_;
-  top_ = NULL;
+  *reinterpret_cast<Relocatable**>(to) = data()->top_;
+  data()->top_ = NULL;
   return to + ArchiveSpacePerThread();
 }
 
 
 // Restore statics that are thread local.
 char* Relocatable::RestoreState(char* from) {
-  top_ = *reinterpret_cast<Relocatable**>(from);
+  data()->top_ = *reinterpret_cast<Relocatable**>(from);
   return from + ArchiveSpacePerThread();
 }
 
@@ -4266,7 +4397,7 @@ char* Relocatable::Iterate(ObjectVisitor* v, char* thread_storage) {
 
 
 void Relocatable::Iterate(ObjectVisitor* v) {
-  Iterate(v, top_);
+  Iterate(v, data()->top_);
 }
 
 
@@ -4345,6 +4476,11 @@ void String::ReadBlockIntoBuffer(String* input,
                                                              offset_ptr,
                                                              max_chars);
       return;
+    case kSlicedStringTag:
+      SlicedString::cast(input)->SlicedStringReadBlockIntoBuffer(rbb,
+                                                                 offset_ptr,
+                                                                 max_chars);
+      return;
     case kExternalStringTag:
       if (input->IsAsciiRepresentation()) {
         ExternalAsciiString::cast(input)->
@@ -4464,6 +4600,41 @@ void ConsString::ConsStringIterateBody(ObjectVisitor* v) {
 }
 
 
+uint16_t SlicedString::SlicedStringGet(int index) {
+  ASSERT(index >= 0 && index < length());
+  return parent()->Get(offset() + index);
+}
+
+
+// The parent of a sliced string is never a cons string, so reading a block
+// only needs to translate the offset into the parent.
+const unibrow::byte* SlicedString::SlicedStringReadBlock(ReadBlockBuffer* rbb,
+                                                         unsigned* offset_ptr,
+                                                         unsigned max_chars) {
+  unsigned offset = this->offset();
+  *offset_ptr += offset;
+  const unibrow::byte* answer =
+      String::ReadBlock(parent(), rbb, offset_ptr, max_chars);
+  *offset_ptr -= offset;
+  return answer;
+}
+
+
+void SlicedString::SlicedStringReadBlockIntoBuffer(ReadBlockBuffer* rbb,
+                                                   unsigned* offset_ptr,
+                                                   unsigned max_chars) {
+  unsigned offset = this->offset();
+  *offset_ptr += offset;
+  String::ReadBlockIntoBuffer(parent(), rbb, offset_ptr, max_chars);
+  *offset_ptr -= offset;
+}
+
+
+void SlicedString::SlicedStringIterateBody(ObjectVisitor* v) {
+  IteratePointer(v, kParentOffset);
+}
+
+
 void JSGlobalPropertyCell::JSGlobalPropertyCellIterateBody(ObjectVisitor* v) {
   IteratePointers(v, kValueOffset, kValueOffset + kPointerSize);
 }
@@ -4567,6 +4738,14 @@ void String::WriteToFlat(String* src,
         }
         break;
       }
+      case kAsciiStringTag | kSlicedStringTag:
+      case kTwoByteStringTag | kSlicedStringTag: {
+        SlicedString* slice = SlicedString::cast(source);
+        from += slice->offset();
+        to += slice->offset();
+        source = slice->parent();
+        break;
+      }
     }
   }
 }
@@ -4605,7 +4784,7 @@ static inline bool CompareStringContents(IteratorA* ia, IteratorB* ib) {
 
 
 // Compares the contents of two strings by reading and comparing
-// int-sized blocks of characters.
+// word-sized blocks of characters.
 template <typename Char>
 static inline bool CompareRawStringContents(Vector<Char> a, Vector<Char> b) {
   int length = a.length();
@@ -4614,20 +4793,20 @@ static inline bool CompareRawStringContents(Vector<Char> a, Vector<Char> b) {
   const Char* pb = b.start();
   int i = 0;
 #ifndef V8_HOST_CAN_READ_UNALIGNED
-  // If this architecture isn't comfortable reading unaligned ints
+  // If this architecture isn't comfortable reading unaligned words
   // then we have to check that the strings are aligned before
   // comparing them blockwise.
-  const int kAlignmentMask = sizeof(uint32_t) - 1;  // NOLINT
-  uint32_t pa_addr = reinterpret_cast<uint32_t>(pa);
-  uint32_t pb_addr = reinterpret_cast<uint32_t>(pb);
+  const uintptr_t kAlignmentMask = sizeof(uintptr_t) - 1;  // NOLINT
+  uintptr_t pa_addr = reinterpret_cast<uintptr_t>(pa);
+  uintptr_t pb_addr = reinterpret_cast<uintptr_t>(pb);
   if (((pa_addr & kAlignmentMask) | (pb_addr & kAlignmentMask)) == 0) {
 #endif
-    const int kStepSize = sizeof(int) / sizeof(Char);  // NOLINT
+    const int kStepSize = sizeof(uintptr_t) / sizeof(Char);  // NOLINT
     int endpoint = length - kStepSize;
     // Compare blocks until we reach near the end of the string.
     for (; i <= endpoint; i += kStepSize) {
-      uint32_t wa = *reinterpret_cast<const uint32_t*>(pa + i);
-      uint32_t wb = *reinterpret_cast<const uint32_t*>(pb + i);
+      uintptr_t wa = *reinterpret_cast<const uintptr_t*>(pa + i);
+      uintptr_t wb = *reinterpret_cast<const uintptr_t*>(pb + i);
       if (wa != wb) {
         return false;
       }
@@ -4645,11 +4824,10 @@ static inline bool CompareRawStringContents(Vector<Char> a, Vector<Char> b) {
 }
 
 
-static StringInputBuffer string_compare_buffer_b;
-
-
 template <typename IteratorA>
-static inline bool CompareStringContentsPartial(IteratorA* ia, String* b) {
+static inline bool CompareStringContentsPartial(IteratorA* ia,
+                                                String* b,
+                                                StringInputBuffer* buffer) {
   if (b->IsFlat()) {
     if (b->IsAsciiRepresentation()) {
       VectorIterator<char> ib(b->ToAsciiVector());
@@ -4659,15 +4837,12 @@ static inline bool CompareStringContentsPartial(IteratorA* ia, String* b) {
       return CompareStringContents(ia, &ib);
     }
   } else {
-    string_compare_buffer_b.Reset(0, b);
-    return CompareStringContents(ia, &string_compare_buffer_b);
+    buffer->Reset(0, b);
+    return CompareStringContents(ia, buffer);
   }
 }
 
 
-static StringInputBuffer string_compare_buffer_a;
-
-
 bool String::SlowEquals(String* other) {
   // Fast check: negative check with lengths.
   int len = length();
@@ -4684,6 +4859,15 @@ bool String::SlowEquals(String* other) {
   // before we try to flatten the strings.
   if (this->Get(0) != other->Get(0)) return false;
 
+  // Cons strings that are compared once are read without flattening them.
+  bool flatten_lhs = ShouldFlatten();
+  bool flatten_rhs = other->ShouldFlatten();
+  if (!flatten_lhs || !flatten_rhs) {
+    StringCharacterStream lhs_stream(this);
+    StringCharacterStream rhs_stream(other);
+    return CompareStringContents(&lhs_stream, &rhs_stream);
+  }
+
   String* lhs = this->TryFlattenGetString();
   String* rhs = other->TryFlattenGetString();
 
@@ -4703,35 +4887,38 @@ bool String::SlowEquals(String* other) {
           Vector<const char> vec2 = rhs->ToAsciiVector();
           return CompareRawStringContents(vec1, vec2);
         } else {
-          VectorIterator<char> buf1(vec1);
-          VectorIterator<uc16> ib(rhs->ToUC16Vector());
-          return CompareStringContents(&buf1, &ib);
+          Vector<const uc16> vec2 = rhs->ToUC16Vector();
+          return CompareChars(vec1.start(), vec2.start(), len) == 0;
         }
       } else {
         VectorIterator<char> buf1(vec1);
-        string_compare_buffer_b.Reset(0, rhs);
-        return CompareStringContents(&buf1, &string_compare_buffer_b);
+        StringInputBuffer* buf2 = &data()->string_compare_buffer_b_;
+        buf2->Reset(0, rhs);
+        return CompareStringContents(&buf1, buf2);
       }
     } else {
       Vector<const uc16> vec1 = lhs->ToUC16Vector();
       if (rhs->IsFlat()) {
         if (rhs->IsAsciiRepresentation()) {
-          VectorIterator<uc16> buf1(vec1);
-          VectorIterator<char> ib(rhs->ToAsciiVector());
-          return CompareStringContents(&buf1, &ib);
+          Vector<const char> vec2 = rhs->ToAsciiVector();
+          return CompareChars(vec1.start(), vec2.start(), len) == 0;
         } else {
           Vector<const uc16> vec2(rhs->ToUC16Vector());
           return CompareRawStringContents(vec1, vec2);
         }
       } else {
         VectorIterator<uc16> buf1(vec1);
-        string_compare_buffer_b.Reset(0, rhs);
-        return CompareStringContents(&buf1, &string_compare_buffer_b);
+        StringInputBuffer* buf2 = &data()->string_compare_buffer_b_;
+        buf2->Reset(0, rhs);
+        return CompareStringContents(&buf1, buf2);
       }
     }
   } else {
-    string_compare_buffer_a.Reset(0, lhs);
-    return CompareStringContentsPartial(&string_compare_buffer_a, rhs);
+    Data* data = String::data();
+    data->string_compare_buffer_a_.Reset(0, lhs);
+    return CompareStringContentsPartial(&data->string_compare_buffer_a_,
+                                        rhs,
+                                        &data->string_compare_buffer_b_);
   }
 }
 
@@ -4773,9 +4960,7 @@ static inline uint32_t HashSequentialString(const schar* chars, int length) {
     for (i = 0; hasher.is_array_index() && (i < length); i++) {
       hasher.AddCharacter(chars[i]);
     }
-    for (; i < length; i++) {
-      hasher.AddCharacterNoIndex(chars[i]);
-    }
+    if (i < length) hasher.AddCharactersNoIndex(chars + i, length - i);
   }
   return hasher.GetHashField();
 }
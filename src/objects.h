@@ -81,6 +81,7 @@
 //           - SeqAsciiString
 //           - SeqTwoByteString
 //         - ConsString
+//         - SlicedString
 //         - ExternalString
 //           - ExternalAsciiString
 //           - ExternalTwoByteString
@@ -348,6 +349,14 @@ enum PropertyNormalizationMode {
     ExternalAsciiString::kSize,                                                \
     external_ascii_string,                                                     \
     ExternalAsciiString)                                                       \
+  V(SLICED_STRING_TYPE,                                                        \
+    SlicedString::kSize,                                                       \
+    sliced_string,                                                             \
+    SlicedString)                                                              \
+  V(SLICED_ASCII_STRING_TYPE,                                                  \
+    SlicedString::kSize,                                                       \
+    sliced_ascii_string,                                                       \
+    SlicedAsciiString)                                                         \
 
 // A struct is a simple object a set of object-valued fields.  Including an
 // object type in this causes the compiler to generate most of the boilerplate
@@ -403,14 +412,14 @@ const uint32_t kTwoByteStringTag = 0x0;
 const uint32_t kAsciiStringTag = 0x4;
 
 // If bit 7 is clear, the low-order 2 bits indicate the representation
-// of the string.
+// of the string.  Sliced strings are never symbols.
 const uint32_t kStringRepresentationMask = 0x03;
 enum StringRepresentationTag {
   kSeqStringTag = 0x0,
   kConsStringTag = 0x1,
-  kExternalStringTag = 0x2
+  kExternalStringTag = 0x2,
+  kSlicedStringTag = 0x3
 };
-const uint32_t kIsConsStringMask = 0x1;
 
 
 // A ConsString with an empty string as the right side is a candidate
@@ -441,6 +450,8 @@ enum InstanceType {
   EXTERNAL_STRING_TYPE = kExternalStringTag,
   EXTERNAL_ASCII_STRING_TYPE = kAsciiStringTag | kExternalStringTag,
   PRIVATE_EXTERNAL_ASCII_STRING_TYPE = EXTERNAL_ASCII_STRING_TYPE,
+  SLICED_STRING_TYPE = kSlicedStringTag,
+  SLICED_ASCII_STRING_TYPE = kAsciiStringTag | kSlicedStringTag,
 
   // Objects allocated in their own spaces (never in new space).
   MAP_TYPE = kNotStringTag,  // FIRST_NONSTRING_TYPE
@@ -569,6 +580,7 @@ class Object BASE_EMBEDDED {
   inline bool IsSeqTwoByteString();
   inline bool IsSeqAsciiString();
   inline bool IsConsString();
+  inline bool IsSlicedString();
 
   inline bool IsNumber();
   inline bool IsByteArray();
@@ -2963,6 +2975,20 @@ class Map: public HeapObject {
     return ((1 << kIsExtensible) & bit_field2()) != 0;
   }
 
+  // Tells whether instances are allocated directly in old space, because
+  // most of them have been found to survive scavenges.
+  inline void set_is_pretenured(bool value) {
+    if (value) {
+      set_bit_field2(bit_field2() | (1 << kIsPretenured));
+    } else {
+      set_bit_field2(bit_field2() & ~(1 << kIsPretenured));
+    }
+  }
+
+  inline bool is_pretenured() {
+    return ((1 << kIsPretenured) & bit_field2()) != 0;
+  }
+
   // Tells whether the instance needs security checks when accessing its
   // properties.
   inline void set_is_access_check_needed(bool access_check_needed);
@@ -3087,6 +3113,7 @@ class Map: public HeapObject {
   // Bit positions for bit field 2
   static const int kIsExtensible = 0;
   static const int kFunctionWithPrototype = 1;
+  static const int kIsPretenured = 2;
 
   // Layout of the default cache. It holds alternating name and code objects.
   static const int kCodeCacheEntrySize = 2;
@@ -3167,6 +3194,10 @@ class Script: public Struct {
   // function from which eval was called where eval was called.
   DECL_ACCESSORS(eval_from_instructions_offset, Smi)
 
+  // [preparse_data]: ByteArray of the function entries of the preparse data,
+  // used when compiling functions lazily, or undefined.
+  DECL_ACCESSORS(preparse_data, Object)
+
   static inline Script* cast(Object* obj);
 
   // If script source is an external string, check that the underlying
@@ -3192,7 +3223,9 @@ class Script: public Struct {
   static const int kEvalFromSharedOffset = kIdOffset + kPointerSize;
   static const int kEvalFrominstructionsOffsetOffset =
       kEvalFromSharedOffset + kPointerSize;
-  static const int kSize = kEvalFrominstructionsOffsetOffset + kPointerSize;
+  static const int kPreparseDataOffset =
+      kEvalFrominstructionsOffsetOffset + kPointerSize;
+  static const int kSize = kPreparseDataOffset + kPointerSize;
 
  private:
   DISALLOW_IMPLICIT_CONSTRUCTORS(Script);
@@ -3319,6 +3352,12 @@ class SharedFunctionInfo: public HeapObject {
   inline bool allows_lazy_compilation();
   inline void set_allows_lazy_compilation(bool flag);
 
+  // Indicates how many full garbage collections the compiled code of this
+  // function has survived without being found on a stack. The code is
+  // flushed when the age reaches --max_code_age.
+  inline int code_age();
+  inline void set_code_age(int age);
+
   // Check whether a inlined constructor can be generated with the given
   // prototype.
   bool CanGenerateInlineConstructor(Object* prototype);
@@ -3357,6 +3396,7 @@ class SharedFunctionInfo: public HeapObject {
 
   // Constants.
   static const int kDontAdaptArgumentsSentinel = -1;
+  static const int kMaxCodeAge = 0x1f;
 
   // Layout description.
   // Pointer fields.
@@ -3445,6 +3485,8 @@ class SharedFunctionInfo: public HeapObject {
   static const int kHasOnlySimpleThisPropertyAssignments = 0;
   static const int kTryFullCodegen = 1;
   static const int kAllowLazyCompilation = 2;
+  static const int kCodeAgeShift = 3;
+  static const int kCodeAgeMask = kMaxCodeAge;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(SharedFunctionInfo);
 };
@@ -3798,8 +3840,18 @@ class JSRegExp: public JSObject {
   static const int kIrregexpMaxRegisterCountIndex = kDataIndex + 2;
   // Number of captures in the compiled regexp.
   static const int kIrregexpCaptureCountIndex = kDataIndex + 3;
-
-  static const int kIrregexpDataSize = kIrregexpCaptureCountIndex + 1;
+  // Literal string that every match must start with, or undefined if
+  // there is no such string.  Used to skip ahead in long subjects before
+  // running the compiled code.
+  static const int kIrregexpPrefixIndex = kDataIndex + 4;
+  // Program for the linear time matcher used when a match exceeds the
+  // backtrack limit (see RegExpNfa).  The hole if it has not been compiled
+  // yet, undefined if the pattern is not supported, otherwise a ByteArray.
+  static const int kIrregexpNfaCodeIndex = kDataIndex + 5;
+  // Backtrack limit that the native code was generated with.
+  static const int kIrregexpBacktrackLimitIndex = kDataIndex + 6;
+
+  static const int kIrregexpDataSize = kIrregexpBacktrackLimitIndex + 1;
 
   // Offsets directly into the data fixed array.
   static const int kDataTagOffset =
@@ -3810,6 +3862,8 @@ class JSRegExp: public JSObject {
       FixedArray::kHeaderSize + kIrregexpUC16CodeIndex * kPointerSize;
   static const int kIrregexpCaptureCountOffset =
       FixedArray::kHeaderSize + kIrregexpCaptureCountIndex * kPointerSize;
+  static const int kIrregexpPrefixOffset =
+      FixedArray::kHeaderSize + kIrregexpPrefixIndex * kPointerSize;
 
   // In-object fields.
   static const int kSourceFieldIndex = 0;
@@ -3972,6 +4026,11 @@ class StringHasher {
   // that the input is not an array index.
   inline void AddCharacterNoIndex(uc32 c);
 
+  // Adds a run of characters with AddCharacterNoIndex, keeping the running
+  // hash in a local variable in the loop.
+  template <typename Char>
+  inline void AddCharactersNoIndex(const Char* chars, int length);
+
   // Returns the value to store in the hash field of a string with
   // the given length and contents.
   uint32_t GetHashField();
@@ -4022,6 +4081,7 @@ class StringShape BASE_EMBEDDED {
   inline bool IsSequential();
   inline bool IsExternal();
   inline bool IsCons();
+  inline bool IsSliced();
   inline bool IsExternalAscii();
   inline bool IsExternalTwoByte();
   inline bool IsSequentialAscii();
@@ -4104,6 +4164,15 @@ class String: public HeapObject {
   // string.
   inline String* TryFlattenGetString(PretenureFlag pretenure = NOT_TENURED);
 
+  // Flattening copies the whole string, which does not pay off for an
+  // operation that only needs a part of a cons string, or that looks at a
+  // string once, like when a string is inspected after each += while it is
+  // built. Such operations work on the cons string tree instead, unless
+  // this returns true. It returns true for strings that are flat or short,
+  // and for cons strings that are used repeatedly (see
+  // kConsStringUsesBeforeFlattening).
+  bool ShouldFlatten();
+
   Vector<const char> ToAsciiVector();
   Vector<const uc16> ToUC16Vector();
 
@@ -4200,6 +4269,13 @@ class String: public HeapObject {
   // Minimum length for a cons string.
   static const int kMinNonFlatLength = 13;
 
+  // Cons strings up to this length are always flattened by ShouldFlatten.
+  static const int kMaxAlwaysFlattenLength = 256;
+
+  // Number of uses of one of the last two cons strings seen by ShouldFlatten
+  // after which it is flattened.
+  static const int kConsStringUsesBeforeFlattening = 4;
+
   // Mask constant for checking if a string has a computed hash code
   // and if it is an array index.  The least significant bit indicates
   // whether a hash code has been computed.  If the hash code has been
@@ -4327,6 +4403,15 @@ class String: public HeapObject {
   // Compute and set the hash code.
   uint32_t ComputeAndSetHash();
 
+  class Data;
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kStringData));
+  }
+
+  friend class Isolate;
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(String);
 };
 
@@ -4499,6 +4584,57 @@ class ConsString: public String {
 };
 
 
+// The SlicedString class describes strings that are substrings of another
+// string.  A SlicedString consists of a pointer to the parent string and
+// the offset of its first character in the parent, and shares the
+// characters of the parent instead of copying them.  The parent is always
+// a sequential or an external string, never a cons string or another
+// sliced string, so a sliced string is always flat.  Sliced strings are
+// never symbols.
+//
+// Note that a sliced string keeps its entire parent alive, so only
+// substrings of at least kMinLength characters are created as slices.
+class SlicedString: public String {
+ public:
+  // The string whose characters are shared.
+  inline String* parent();
+  inline void set_parent(String* parent,
+                         WriteBarrierMode mode = UPDATE_WRITE_BARRIER);
+
+  // Index in the parent of the first character of this string.
+  inline int offset();
+  inline void set_offset(int offset);
+
+  // Dispatched behavior.
+  uint16_t SlicedStringGet(int index);
+
+  // Casting.
+  static inline SlicedString* cast(Object* obj);
+
+  // Garbage collection support.
+  void SlicedStringIterateBody(ObjectVisitor* v);
+
+  // Layout description.
+  static const int kParentOffset = POINTER_SIZE_ALIGN(String::kSize);
+  static const int kOffsetOffset = kParentOffset + kPointerSize;
+  static const int kSize = kOffsetOffset + kPointerSize;
+
+  // Support for StringInputBuffer.
+  inline const unibrow::byte* SlicedStringReadBlock(ReadBlockBuffer* buffer,
+                                                    unsigned* offset_ptr,
+                                                    unsigned chars);
+  inline void SlicedStringReadBlockIntoBuffer(ReadBlockBuffer* buffer,
+                                              unsigned* offset_ptr,
+                                              unsigned chars);
+
+  // Minimum length for a sliced string.  Shorter substrings are copied.
+  static const int kMinLength = 13;
+
+ private:
+  DISALLOW_IMPLICIT_CONSTRUCTORS(SlicedString);
+};
+
+
 // The ExternalString class describes string values that are backed by
 // a string resource that lies outside the V8 heap.  ExternalStrings
 // consist of the length field common to all strings, a pointer to the
@@ -4593,10 +4729,15 @@ class ExternalTwoByteString: public ExternalString {
 // iterating or updating after gc.
 class Relocatable BASE_EMBEDDED {
  public:
-  inline Relocatable() : prev_(top_) { top_ = this; }
+  inline Relocatable() {
+    Data* data = Relocatable::data();
+    prev_ = data->top_;
+    data->top_ = this;
+  }
   virtual ~Relocatable() {
-    ASSERT_EQ(top_, this);
-    top_ = prev_;
+    Data* data = Relocatable::data();
+    ASSERT_EQ(data->top_, this);
+    data->top_ = prev_;
   }
   virtual void IterateInstance(ObjectVisitor* v) { }
   virtual void PostGarbageCollection() { }
@@ -4609,8 +4750,19 @@ class Relocatable BASE_EMBEDDED {
   static void Iterate(ObjectVisitor* v, Relocatable* top);
   static char* Iterate(ObjectVisitor* v, char* t);
  private:
-  static Relocatable* top_;
+  class Data {
+   public:
+    Relocatable* top_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kRelocatableData));
+  }
+
   Relocatable* prev_;
+
+  friend class Isolate;
 };
 
 
@@ -4661,6 +4813,40 @@ class SafeStringInputBuffer
 };
 
 
+// Reads the characters of a string from left to right without flattening
+// it.  Unlike StringInputBuffer it reads the flat strings at the leaves of
+// a cons string tree directly and keeps the parts of the tree still to be
+// read on a stack, so a string is read in time linear in its length and
+// number of cons strings whatever the shape of the tree.  There must be no
+// allocation in the heap while a stream is in use.
+class StringCharacterStream {
+ public:
+  // Starts reading at the given offset.
+  explicit StringCharacterStream(String* string, int offset = 0);
+  ~StringCharacterStream();
+
+  inline bool has_more();
+  inline uint16_t GetNext();
+
+ private:
+  // Goes down to the leaf holding the character at offset, remembering the
+  // second parts of the cons strings on the way.
+  void Descend(String* string, int offset);
+
+  // Moves to the next non-empty leaf.  Returns false if there is none.
+  bool NextLeaf();
+
+  bool is_ascii_;
+  const char* ascii_chars_;
+  const uc16* two_byte_chars_;
+  int position_;
+  int end_;
+  List<String*>* pending_;
+
+  DISALLOW_COPY_AND_ASSIGN(StringCharacterStream);
+};
+
+
 template <typename T>
 class VectorIterator {
  public:
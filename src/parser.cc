@@ -104,6 +104,11 @@ class Parser {
   // success, false if a stack-overflow happened during parsing.
   bool PreParseProgram(Handle<String> source, unibrow::CharacterStream* stream);
 
+  // Pre-parse the program from a UTF-16 array outside the heap without
+  // touching any state of the VM, so it can run on any thread. Stack
+  // overflow is detected against the given limit.
+  bool PreParseProgram(Vector<const uc16> source, uintptr_t stack_limit);
+
   void ReportMessage(const char* message, Vector<const char*> args);
   virtual void ReportMessageAt(Scanner::Location loc,
                                const char* message,
@@ -160,6 +165,9 @@ class Parser {
   Mode mode() const  { return mode_; }
   ScriptDataImpl* pre_data() const  { return pre_data_; }
 
+  // Pre-parses the program once the scanner has been initialized.
+  bool PreParseSourceElements();
+
   // All ParseXXX functions take as the last argument an *ok parameter
   // which is set to false if parsing failed; it is unchanged otherwise.
   // By making the 'exception handling' explicit, we are forced to check
@@ -847,10 +855,26 @@ class ParserLog BASE_EMBEDDED {
  public:
   virtual ~ParserLog() { }
 
-  // Records the occurrence of a function.  The returned object is
-  // only guaranteed to be valid until the next function has been
-  // logged.
-  virtual FunctionEntry LogFunction(int start) { return FunctionEntry(); }
+  // Records the start of a function, so the functions are recorded in the
+  // order they start in.
+  virtual void LogFunctionStart(int start) { }
+
+  // Records the end of the innermost function started.  The returned
+  // object is only guaranteed to be valid until the next function has
+  // been logged.
+  virtual FunctionEntry LogFunctionEnd() { return FunctionEntry(); }
+
+  // Records the name of a function expression, which is declared in the
+  // function started next.  Names are the 0-terminated literals of the
+  // scanner.
+  virtual void LogFunctionName(Vector<const char> name) { }
+
+  // Records a variable declared or used in the innermost function.
+  virtual void LogDeclaration(Vector<const char> name) { }
+  virtual void LogUse(Vector<const char> name) { }
+
+  // Records a with statement or a catch block in the innermost function.
+  virtual void LogWithStatement() { }
 
   virtual void LogError() { }
 };
@@ -884,10 +908,19 @@ class AstBuildingParserFactory : public ParserFactory {
 };
 
 
+// Records the function entries of the preparse data.  To find out which
+// functions may need a context, the recorder keeps track of the variables
+// declared and used in the functions being preparsed, by name.
 class ParserRecorder: public ParserLog {
  public:
   ParserRecorder();
-  virtual FunctionEntry LogFunction(int start);
+  virtual ~ParserRecorder();
+  virtual void LogFunctionStart(int start);
+  virtual FunctionEntry LogFunctionEnd();
+  virtual void LogFunctionName(Vector<const char> name);
+  virtual void LogDeclaration(Vector<const char> name);
+  virtual void LogUse(Vector<const char> name);
+  virtual void LogWithStatement();
   virtual void LogError() { }
   virtual void LogMessage(Scanner::Location loc,
                           const char* message,
@@ -896,25 +929,144 @@ class ParserRecorder: public ParserLog {
   static const char* ReadString(unsigned* start, int* chars);
   List<unsigned>* store() { return &store_; }
  private:
+  enum VariableFlags {
+    kDeclared = 1 << 0,
+    kUsed = 1 << 1,
+    kUsedByInnerFunction = 1 << 2
+  };
+
+  // The variables of a function being preparsed, or of the program.
+  struct FunctionScope : public Malloced {
+    FunctionScope() : variables(NamesMatch) { }
+    int entry;  // Position of the entry in the store, or -1.
+    HashMap variables;  // Interned name -> VariableFlags.
+    bool calls_eval;  // Eval is used in the function or an inner function.
+    bool contains_with;
+  };
+
+  static bool NamesMatch(void* key1, void* key2) { return key1 == key2; }
+  static bool StringsMatch(void* key1, void* key2) {
+    return strcmp(reinterpret_cast<char*>(key1),
+                  reinterpret_cast<char*>(key2)) == 0;
+  }
+
+  char* Intern(Vector<const char> name, uint32_t* hash);
+  void AddVariable(FunctionScope* scope, char* name, uint32_t hash, int flags);
+  FunctionScope* current() { return scopes_[depth_ - 1]; }
+
   bool has_error_;
   List<unsigned> store_;
+
+  // Interned name -> 0-terminated copy of the name.
+  HashMap names_;
+  char* arguments_name_;
+  uint32_t arguments_hash_;
+  char* eval_name_;
+  char* function_name_;
+  uint32_t function_name_hash_;
+
+  // The scopes of the functions being preparsed, innermost last.  The
+  // scopes beyond depth_ are kept for reuse.
+  List<FunctionScope*> scopes_;
+  int depth_;
 };
 
 
+// Binary search for the entry of the function starting at start, among
+// entries sorted by start position.  Returns -1 if there is no such entry.
+static int FindFunctionEntry(Vector<unsigned> entries, int low, int start) {
+  int count = entries.length() / FunctionEntry::kSize;
+  int high = count;
+  while (low < high) {
+    int mid = low + (high - low) / 2;
+    int offset = mid * FunctionEntry::kSize;
+    FunctionEntry entry(entries.SubVector(offset,
+                                          offset + FunctionEntry::kSize));
+    if (entry.start_pos() < start) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  if (low == count) return -1;
+  int offset = low * FunctionEntry::kSize;
+  FunctionEntry entry(entries.SubVector(offset,
+                                        offset + FunctionEntry::kSize));
+  return entry.start_pos() == start ? low : -1;
+}
+
+
 FunctionEntry ScriptDataImpl::GetFunctionEnd(int start) {
-  if (nth(last_entry_).start_pos() > start) {
-    // If the last entry we looked up is higher than what we're
-    // looking for then it's useless and we reset it.
-    last_entry_ = 0;
+  // The functions are usually looked up in the order they start in.
+  int low = 0;
+  if (last_entry_ < EntryCount() && nth(last_entry_).start_pos() <= start) {
+    low = last_entry_;
   }
-  for (int i = last_entry_; i < EntryCount(); i++) {
+  Vector<unsigned> entries = store_.SubVector(kHeaderSize, store_.length());
+  int index = FindFunctionEntry(entries, low, start);
+  if (index < 0) return FunctionEntry();
+  last_entry_ = index;
+  return nth(index);
+}
+
+
+Handle<Object> ScriptDataImpl::FunctionEntriesForLazyCompilation() {
+  if (has_error()) return Factory::undefined_value();
+  int count = EntryCount();
+  for (int i = 0; i < count; i++) {
     FunctionEntry entry = nth(i);
-    if (entry.start_pos() == start) {
-      last_entry_ = i;
-      return entry;
+    if (entry.inner_function_count() > 0 && !entry.needs_context()) {
+      int length = count * FunctionEntry::kSize * sizeof(unsigned);
+      Handle<ByteArray> result = Factory::NewByteArray(length, TENURED);
+      memcpy(result->GetDataStartAddress(), &store_[kHeaderSize], length);
+      return result;
     }
   }
-  return FunctionEntry();
+  return Factory::undefined_value();
+}
+
+
+ScriptDataImpl* ScriptDataImpl::ForLazyCompilation(Handle<Script> script,
+                                                   int start_position) {
+  if (!script->preparse_data()->IsByteArray()) return NULL;
+  ByteArray* data = ByteArray::cast(script->preparse_data());
+  Vector<unsigned> entries(
+      reinterpret_cast<unsigned*>(data->GetDataStartAddress()),
+      data->length() / sizeof(unsigned));
+  int index = FindFunctionEntry(entries, 0, start_position);
+  if (index < 0) return NULL;
+  int offset = index * FunctionEntry::kSize;
+  FunctionEntry function(entries.SubVector(offset,
+                                           offset + FunctionEntry::kSize));
+  if (function.needs_context() || function.inner_function_count() == 0) {
+    return NULL;
+  }
+
+  // Copy the entries of the functions directly inside the function, which
+  // are found by skipping the entries of the functions nested in them.
+  int end = offset + (function.inner_function_count() + 1) *
+      FunctionEntry::kSize;
+  int count = 0;
+  for (int i = offset + FunctionEntry::kSize; i < end; ) {
+    FunctionEntry entry(entries.SubVector(i, i + FunctionEntry::kSize));
+    i += (entry.inner_function_count() + 1) * FunctionEntry::kSize;
+    count++;
+  }
+  Vector<unsigned> store =
+      Vector<unsigned>::New(kHeaderSize + count * FunctionEntry::kSize);
+  store[kMagicOffset] = kMagicNumber;
+  store[kVersionOffset] = kCurrentVersion;
+  store[kHasErrorOffset] = false;
+  store[kSizeOffset] = 0;
+  int position = kHeaderSize;
+  for (int i = offset + FunctionEntry::kSize; i < end; ) {
+    FunctionEntry entry(entries.SubVector(i, i + FunctionEntry::kSize));
+    for (int j = 0; j < FunctionEntry::kSize; j++) {
+      store[position++] = entries[i + j];
+    }
+    i += (entry.inner_function_count() + 1) * FunctionEntry::kSize;
+  }
+  return new ScriptDataImpl(store);
 }
 
 
@@ -942,11 +1094,146 @@ FunctionEntry ScriptDataImpl::nth(int n) {
 
 
 ParserRecorder::ParserRecorder()
-  : has_error_(false), store_(4) {
+  : has_error_(false),
+    store_(4),
+    names_(StringsMatch),
+    function_name_(NULL),
+    function_name_hash_(0),
+    scopes_(4),
+    depth_(0) {
   Vector<unsigned> preamble = store()->AddBlock(0, ScriptDataImpl::kHeaderSize);
   preamble[ScriptDataImpl::kMagicOffset] = ScriptDataImpl::kMagicNumber;
   preamble[ScriptDataImpl::kVersionOffset] = ScriptDataImpl::kCurrentVersion;
   preamble[ScriptDataImpl::kHasErrorOffset] = false;
+  arguments_name_ = Intern(CStrVector("arguments"), &arguments_hash_);
+  uint32_t eval_hash;
+  eval_name_ = Intern(CStrVector("eval"), &eval_hash);
+  // The scope of the program.
+  LogFunctionStart(RelocInfo::kNoPosition);
+}
+
+
+ParserRecorder::~ParserRecorder() {
+  for (int i = 0; i < scopes_.length(); i++) delete scopes_[i];
+  for (HashMap::Entry* p = names_.Start(); p != NULL; p = names_.Next(p)) {
+    DeleteArray(reinterpret_cast<char*>(p->value));
+  }
+}
+
+
+char* ParserRecorder::Intern(Vector<const char> name, uint32_t* hash) {
+  uint32_t result = 0;
+  for (int i = 0; i < name.length(); i++) {
+    result += name[i];
+    result += result << 10;
+    result ^= result >> 6;
+  }
+  result += result << 3;
+  result ^= result >> 11;
+  result += result << 15;
+  *hash = result;
+  HashMap::Entry* entry =
+      names_.Lookup(const_cast<char*>(name.start()), result, true);
+  if (entry->value == NULL) {
+    char* copy = NewArray<char>(name.length() + 1);
+    memcpy(copy, name.start(), name.length());
+    copy[name.length()] = '\0';
+    entry->key = copy;
+    entry->value = copy;
+  }
+  return reinterpret_cast<char*>(entry->value);
+}
+
+
+void ParserRecorder::AddVariable(FunctionScope* scope,
+                                 char* name,
+                                 uint32_t hash,
+                                 int flags) {
+  HashMap::Entry* entry = scope->variables.Lookup(name, hash, true);
+  intptr_t value = reinterpret_cast<intptr_t>(entry->value);
+  entry->value = reinterpret_cast<void*>(value | flags);
+}
+
+
+void ParserRecorder::LogFunctionStart(int start) {
+  if (depth_ == scopes_.length()) scopes_.Add(new FunctionScope());
+  FunctionScope* scope = scopes_[depth_++];
+  scope->variables.Clear();
+  scope->calls_eval = false;
+  scope->contains_with = false;
+  scope->entry = -1;
+  if (start != RelocInfo::kNoPosition) {
+    AddVariable(scope, arguments_name_, arguments_hash_, kDeclared);
+    if (!has_error_) {
+      scope->entry = store()->length();
+      FunctionEntry entry(store()->AddBlock(0, FunctionEntry::kSize));
+      entry.set_start_pos(start);
+    }
+  }
+  if (function_name_ != NULL) {
+    AddVariable(scope, function_name_, function_name_hash_, kDeclared);
+    function_name_ = NULL;
+  }
+}
+
+
+FunctionEntry ParserRecorder::LogFunctionEnd() {
+  ASSERT(depth_ > 1);
+  FunctionScope* scope = scopes_[--depth_];
+  FunctionScope* outer = current();
+
+  // Variables that aren't declared in the function are used by an inner
+  // function of the outer function.  The function needs a context if it
+  // declares a variable used by one of its inner functions.
+  bool needs_context = scope->calls_eval || scope->contains_with;
+  for (HashMap::Entry* p = scope->variables.Start();
+       p != NULL;
+       p = scope->variables.Next(p)) {
+    intptr_t flags = reinterpret_cast<intptr_t>(p->value);
+    if ((flags & kDeclared) == 0) {
+      AddVariable(outer,
+                  reinterpret_cast<char*>(p->key),
+                  p->hash,
+                  kUsedByInnerFunction);
+    } else if ((flags & kUsedByInnerFunction) != 0) {
+      needs_context = true;
+    }
+  }
+  if (scope->calls_eval) outer->calls_eval = true;
+
+  if (has_error_ || scope->entry < 0) return FunctionEntry();
+  int end = scope->entry + FunctionEntry::kSize;
+  FunctionEntry result(store()->ToVector().SubVector(scope->entry, end));
+  result.set_inner_function_count(
+      (store()->length() - end) / FunctionEntry::kSize);
+  result.set_needs_context(needs_context);
+  return result;
+}
+
+
+void ParserRecorder::LogFunctionName(Vector<const char> name) {
+  function_name_ = Intern(name, &function_name_hash_);
+}
+
+
+void ParserRecorder::LogDeclaration(Vector<const char> name) {
+  uint32_t hash;
+  char* interned = Intern(name, &hash);
+  AddVariable(current(), interned, hash, kDeclared);
+}
+
+
+void ParserRecorder::LogUse(Vector<const char> name) {
+  uint32_t hash;
+  char* interned = Intern(name, &hash);
+  // Any use of eval may be a call of it.
+  if (interned == eval_name_) current()->calls_eval = true;
+  AddVariable(current(), interned, hash, kUsed);
+}
+
+
+void ParserRecorder::LogWithStatement() {
+  current()->contains_with = true;
 }
 
 
@@ -971,6 +1258,7 @@ const char* ParserRecorder::ReadString(unsigned* start, int* chars) {
 void ParserRecorder::LogMessage(Scanner::Location loc, const char* message,
                                 Vector<const char*> args) {
   if (has_error_) return;
+  has_error_ = true;
   store()->Rewind(ScriptDataImpl::kHeaderSize);
   store()->at(ScriptDataImpl::kHasErrorOffset) = true;
   store()->Add(loc.beg_pos);
@@ -1018,14 +1306,6 @@ unsigned* ScriptDataImpl::ReadAddress(int position) {
 }
 
 
-FunctionEntry ParserRecorder::LogFunction(int start) {
-  if (has_error_) return FunctionEntry();
-  FunctionEntry result(store()->AddBlock(0, FunctionEntry::kSize));
-  result.set_start_pos(start);
-  return result;
-}
-
-
 class AstBuildingParser : public Parser {
  public:
   AstBuildingParser(Handle<Script> script, bool allow_natives_syntax,
@@ -1221,6 +1501,21 @@ bool Parser::PreParseProgram(Handle<String> source,
   AssertNoAllocation assert_no_allocation;
   NoHandleAllocation no_handle_allocation;
   scanner_.Initialize(source, stream, JAVASCRIPT);
+  return PreParseSourceElements();
+}
+
+
+bool Parser::PreParseProgram(Vector<const uc16> source,
+                             uintptr_t stack_limit) {
+  // The timer and the allocation assertion scopes all use global state, so
+  // they are left out here.
+  scanner_.set_stack_limit(stack_limit);
+  scanner_.Initialize(source, JAVASCRIPT);
+  return PreParseSourceElements();
+}
+
+
+bool Parser::PreParseSourceElements() {
   ASSERT(target_stack_ == NULL);
   mode_ = PARSE_EAGERLY;
   DummyScope top_scope;
@@ -1303,7 +1598,9 @@ FunctionLiteral* Parser::ParseLazy(Handle<String> source,
   source->TryFlatten();
   scanner_.Initialize(source, start_position, end_position, JAVASCRIPT);
   ASSERT(target_stack_ == NULL);
-  mode_ = PARSE_EAGERLY;
+  // The preparse data, if any, has entries for the inner functions that
+  // are compiled lazily, but not for the function itself.
+  mode_ = pre_data() != NULL ? PARSE_LAZILY : PARSE_EAGERLY;
 
   // Place holder for the result.
   FunctionLiteral* result = NULL;
@@ -1992,6 +2289,7 @@ Statement* Parser::ParseFunctionDeclaration(bool* ok) {
   Expect(Token::FUNCTION, CHECK_OK);
   int function_token_position = scanner().location().beg_pos;
   Handle<String> name = ParseIdentifier(CHECK_OK);
+  if (is_pre_parsing_) log()->LogDeclaration(scanner_.literal());
   FunctionLiteral* fun = ParseFunctionLiteral(name,
                                               function_token_position,
                                               DECLARATION,
@@ -2078,6 +2376,7 @@ Block* Parser::ParseVariableDeclarations(bool accept_IN,
     // Parse variable name.
     if (nvars > 0) Consume(Token::COMMA);
     Handle<String> name = ParseIdentifier(CHECK_OK);
+    if (is_pre_parsing_) log()->LogDeclaration(scanner_.literal());
 
     // Declare variable.
     // Note that we *always* must treat the initial value via a separate init
@@ -2404,6 +2703,7 @@ Block* Parser::WithHelper(Expression* obj,
   { Target target(this, &collector);
     with_nesting_level_++;
     top_scope_->RecordWithStatement();
+    log()->LogWithStatement();
     stat = ParseStatement(labels, CHECK_OK);
     with_nesting_level_--;
   }
@@ -3184,7 +3484,10 @@ Expression* Parser::ParseMemberWithNewPrefixesExpression(PositionStack* stack,
     Expect(Token::FUNCTION, CHECK_OK);
     int function_token_position = scanner().location().beg_pos;
     Handle<String> name;
-    if (peek() == Token::IDENTIFIER) name = ParseIdentifier(CHECK_OK);
+    if (peek() == Token::IDENTIFIER) {
+      name = ParseIdentifier(CHECK_OK);
+      if (is_pre_parsing_) log()->LogFunctionName(scanner_.literal());
+    }
     result = ParseFunctionLiteral(name, function_token_position,
                                   NESTED, CHECK_OK);
   } else {
@@ -3308,6 +3611,7 @@ Expression* Parser::ParsePrimaryExpression(bool* ok) {
     case Token::IDENTIFIER: {
       Handle<String> name = ParseIdentifier(CHECK_OK);
       if (is_pre_parsing_) {
+        log()->LogUse(scanner_.literal());
         result = VariableProxySentinel::identifier_proxy();
       } else {
         result = top_scope_->NewUnresolved(name, inside_with());
@@ -3317,6 +3621,9 @@ Expression* Parser::ParsePrimaryExpression(bool* ok) {
 
     case Token::NUMBER: {
       Consume(Token::NUMBER);
+      // The preparser has no use for the value, and the conversion uses
+      // shared state that is not safe off the VM thread.
+      if (is_pre_parsing_) break;
       double value =
         StringToDouble(scanner_.literal_string(), ALLOW_HEX | ALLOW_OCTALS);
       result = NewNumberLiteral(value);
@@ -3630,6 +3937,7 @@ Expression* Parser::ParseObjectLiteral(bool* ok) {
 
       case Token::NUMBER: {
         Consume(Token::NUMBER);
+        if (is_pre_parsing_) break;
         double value =
           StringToDouble(scanner_.literal_string(), ALLOW_HEX | ALLOW_OCTALS);
         key = NewNumberLiteral(value);
@@ -3766,6 +4074,7 @@ FunctionLiteral* Parser::ParseFunctionLiteral(Handle<String> var_name,
     //    '(' (Identifier)*[','] ')'
     Expect(Token::LPAREN, CHECK_OK);
     int start_pos = scanner_.location().beg_pos;
+    log()->LogFunctionStart(start_pos);
     bool done = (peek() == Token::RPAREN);
     while (!done) {
       Handle<String> param_name = ParseIdentifier(CHECK_OK);
@@ -3773,6 +4082,8 @@ FunctionLiteral* Parser::ParseFunctionLiteral(Handle<String> var_name,
         top_scope_->AddParameter(top_scope_->DeclareLocal(param_name,
                                                           Variable::VAR));
         num_parameters++;
+      } else {
+        log()->LogDeclaration(scanner_.literal());
       }
       done = (peek() == Token::RPAREN);
       if (!done) Expect(Token::COMMA, CHECK_OK);
@@ -3808,13 +4119,16 @@ FunctionLiteral* Parser::ParseFunctionLiteral(Handle<String> var_name,
     int expected_property_count;
     bool only_simple_this_property_assignments;
     Handle<FixedArray> this_property_assignments;
+    FunctionEntry pre_data_entry;
     if (is_lazily_compiled && pre_data() != NULL) {
-      FunctionEntry entry = pre_data()->GetFunctionEnd(start_pos);
-      int end_pos = entry.end_pos();
+      pre_data_entry = pre_data()->GetFunctionEnd(start_pos);
+    }
+    if (pre_data_entry.is_valid()) {
+      int end_pos = pre_data_entry.end_pos();
       Counters::total_preparse_skipped.Increment(end_pos - start_pos);
       scanner_.SeekForward(end_pos);
-      materialized_literal_count = entry.literal_count();
-      expected_property_count = entry.property_count();
+      materialized_literal_count = pre_data_entry.literal_count();
+      expected_property_count = pre_data_entry.property_count();
       only_simple_this_property_assignments = false;
       this_property_assignments = Factory::empty_fixed_array();
     } else {
@@ -3829,7 +4143,7 @@ FunctionLiteral* Parser::ParseFunctionLiteral(Handle<String> var_name,
     Expect(Token::RBRACE, CHECK_OK);
     int end_pos = scanner_.location().end_pos;
 
-    FunctionEntry entry = log()->LogFunction(start_pos);
+    FunctionEntry entry = log()->LogFunctionEnd();
     if (entry.is_valid()) {
       entry.set_end_pos(end_pos);
       entry.set_literal_count(materialized_literal_count);
@@ -4259,6 +4573,402 @@ Expression* Parser::ParseJsonArray(bool* ok) {
 }
 
 
+// ----------------------------------------------------------------------------
+// JsonParser
+
+Handle<Object> JsonParser::Parse(Handle<String> source) {
+  JsonParser parser(FlattenGetString(source));
+  return parser.ParseJson();
+}
+
+
+JsonParser::JsonParser(Handle<String> source)
+    : source_(source),
+      source_length_(source->length()),
+      is_sequential_ascii_(source->IsSeqAsciiString()),
+      position_(-1),
+      c0_(kEndOfString),
+      element_stack_(16),
+      ascii_buffer_(16),
+      two_byte_buffer_(16) {
+  ASSERT(source->IsFlat());
+}
+
+
+void JsonParser::Advance() {
+  position_++;
+  if (position_ >= source_length_) {
+    c0_ = kEndOfString;
+  } else if (is_sequential_ascii_) {
+    c0_ = Handle<SeqAsciiString>::cast(source_)->SeqAsciiStringGet(position_);
+  } else {
+    c0_ = source_->Get(position_);
+  }
+}
+
+
+void JsonParser::SkipWhitespace() {
+  // JSON WhiteSpace is tab, carriage-return, newline and space.
+  while (c0_ == ' ' || c0_ == '\t' || c0_ == '\n' || c0_ == '\r') {
+    Advance();
+  }
+}
+
+
+void JsonParser::AdvanceSkipWhitespace() {
+  Advance();
+  SkipWhitespace();
+}
+
+
+Handle<Object> JsonParser::ParseJson() {
+  AdvanceSkipWhitespace();
+  Handle<Object> result = ParseJsonValue();
+  if (result.is_null()) return result;
+  if (c0_ != kEndOfString) return ReportUnexpectedCharacter();
+  return result;
+}
+
+
+Handle<Object> JsonParser::ParseJsonValue() {
+  switch (c0_) {
+    case '"':
+      return ParseJsonString(false);
+    case '-':
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+      return ParseJsonNumber();
+    case 'f':
+      return ParseJsonLiteral("false", Factory::false_value());
+    case 't':
+      return ParseJsonLiteral("true", Factory::true_value());
+    case 'n':
+      return ParseJsonLiteral("null", Factory::null_value());
+    case '{':
+    case '[': {
+      StackLimitCheck check;
+      if (check.HasOverflowed()) {
+        Top::StackOverflow();
+        return Handle<Object>::null();
+      }
+      return (c0_ == '{') ? ParseJsonObject() : ParseJsonArray();
+    }
+    default:
+      return ReportUnexpectedCharacter();
+  }
+}
+
+
+Handle<Object> JsonParser::ParseJsonObject() {
+  ASSERT_EQ('{', c0_);
+  Object* result;
+  {
+    HandleScope scope;
+    Handle<JSFunction> object_function(
+        Top::global_context()->object_function());
+    Handle<JSObject> json_object = Factory::NewJSObject(object_function);
+    AdvanceSkipWhitespace();
+    if (c0_ != '}') {
+      while (true) {
+        if (c0_ != '"') return ReportUnexpectedCharacter();
+        Handle<String> key = ParseJsonString(true);
+        if (key.is_null()) return Handle<Object>::null();
+        if (c0_ != ':') return ReportUnexpectedCharacter();
+        AdvanceSkipWhitespace();
+        Handle<Object> value = ParseJsonValue();
+        if (value.is_null()) return Handle<Object>::null();
+        uint32_t index;
+        if (key->AsArrayIndex(&index)) {
+          value = SetElement(json_object, index, value);
+        } else if (key->Equals(Heap::Proto_symbol())) {
+          // Setting __proto__ changes the prototype as it does for object
+          // literals.
+          value = SetProperty(json_object, key, value, NONE);
+        } else {
+          value = IgnoreAttributesAndSetLocalProperty(json_object,
+                                                      key,
+                                                      value,
+                                                      NONE);
+        }
+        if (value.is_null()) return Handle<Object>::null();
+        if (c0_ != ',') break;
+        AdvanceSkipWhitespace();
+      }
+      if (c0_ != '}') return ReportUnexpectedCharacter();
+    }
+    AdvanceSkipWhitespace();
+    result = *json_object;
+  }
+  return Handle<Object>(result);
+}
+
+
+Handle<Object> JsonParser::ParseJsonArray() {
+  ASSERT_EQ('[', c0_);
+  Object* result;
+  {
+    HandleScope scope;
+    int start = element_stack_.length();
+    AdvanceSkipWhitespace();
+    if (c0_ != ']') {
+      while (true) {
+        Handle<Object> element = ParseJsonValue();
+        if (element.is_null()) return Handle<Object>::null();
+        element_stack_.Add(element);
+        if (c0_ != ',') break;
+        AdvanceSkipWhitespace();
+      }
+      if (c0_ != ']') return ReportUnexpectedCharacter();
+    }
+    AdvanceSkipWhitespace();
+    int length = element_stack_.length() - start;
+    Handle<FixedArray> elements = Factory::NewFixedArray(length);
+    for (int i = 0; i < length; i++) {
+      elements->set(i, *element_stack_[start + i]);
+    }
+    element_stack_.Rewind(start);
+    result = *Factory::NewJSArrayWithElements(elements);
+  }
+  return Handle<Object>(result);
+}
+
+
+Handle<Object> JsonParser::ParseJsonNumber() {
+  int start = position_;
+  bool negative = false;
+  if (c0_ == '-') {
+    negative = true;
+    Advance();
+  }
+  if (c0_ == '0') {
+    Advance();
+    // Prefix zero is only allowed if it's the only digit before
+    // a decimal point or exponent.
+    if (IsDecimalDigit(c0_)) return ReportUnexpectedToken("unexpected_token",
+                                                          "ILLEGAL");
+  } else {
+    if (c0_ < '1' || c0_ > '9') return ReportUnexpectedToken("unexpected_token",
+                                                             "ILLEGAL");
+    int value = 0;
+    int digits = 0;
+    do {
+      value = value * 10 + (c0_ - '0');
+      digits++;
+      Advance();
+    } while (IsDecimalDigit(c0_));
+    // Nine decimal digits always fit in a smi.
+    if (digits < 10 && c0_ != '.' && (c0_ | 0x20) != 'e') {
+      SkipWhitespace();
+      return Handle<Object>(Smi::FromInt(negative ? -value : value));
+    }
+  }
+  if (c0_ == '.') {
+    Advance();
+    if (!IsDecimalDigit(c0_)) return ReportUnexpectedToken("unexpected_token",
+                                                           "ILLEGAL");
+    do {
+      Advance();
+    } while (IsDecimalDigit(c0_));
+  }
+  if ((c0_ | 0x20) == 'e') {
+    Advance();
+    if (c0_ == '-' || c0_ == '+') Advance();
+    if (!IsDecimalDigit(c0_)) return ReportUnexpectedToken("unexpected_token",
+                                                           "ILLEGAL");
+    do {
+      Advance();
+    } while (IsDecimalDigit(c0_));
+  }
+  // The number only contains ASCII characters, so it can be copied to a
+  // C string and handed to the generic conversion code.
+  ascii_buffer_.Rewind(0);
+  for (int i = start; i < position_; i++) {
+    ascii_buffer_.Add(static_cast<char>(source_->Get(i)));
+  }
+  ascii_buffer_.Add('\0');
+  double value = StringToDouble(ascii_buffer_.ToVector().start(),
+                                NO_FLAGS,  // Hex, octal or trailing junk.
+                                OS::nan_value());
+  SkipWhitespace();
+  return Factory::NewNumber(value);
+}
+
+
+Handle<String> JsonParser::ParseJsonString(bool is_symbol) {
+  ASSERT_EQ('"', c0_);
+  Advance();
+  int start = position_;
+  bool is_ascii = true;
+  while (c0_ != '"') {
+    // Check for control character (0x00-0x1f) or unterminated string (<0).
+    if (c0_ < 0x20) {
+      ReportUnexpectedToken("unexpected_token", "ILLEGAL");
+      return Handle<String>::null();
+    }
+    if (c0_ == '\\') return SlowParseJsonString(start, is_symbol);
+    if (c0_ > String::kMaxAsciiCharCode) is_ascii = false;
+    Advance();
+  }
+  int end = position_;
+  AdvanceSkipWhitespace();
+  if (!is_symbol) return Factory::NewSubString(source_, start, end);
+  if (is_ascii) {
+    // Copy the characters out of the source, which can move if looking up
+    // the symbol causes a garbage collection.
+    ascii_buffer_.Rewind(0);
+    for (int i = start; i < end; i++) {
+      ascii_buffer_.Add(static_cast<char>(source_->Get(i)));
+    }
+    return Factory::LookupSymbol(ascii_buffer_.ToConstVector());
+  }
+  return Factory::SymbolFromString(Factory::NewSubString(source_, start, end));
+}
+
+
+Handle<String> JsonParser::SlowParseJsonString(int start, bool is_symbol) {
+  two_byte_buffer_.Rewind(0);
+  for (int i = start; i < position_; i++) {
+    two_byte_buffer_.Add(source_->Get(i));
+  }
+  while (c0_ != '"') {
+    if (c0_ < 0x20) {
+      ReportUnexpectedToken("unexpected_token", "ILLEGAL");
+      return Handle<String>::null();
+    }
+    if (c0_ != '\\') {
+      two_byte_buffer_.Add(static_cast<uc16>(c0_));
+      Advance();
+      continue;
+    }
+    Advance();
+    switch (c0_) {
+      case '"':
+      case '\\':
+      case '/':
+        two_byte_buffer_.Add(static_cast<uc16>(c0_));
+        break;
+      case 'b':
+        two_byte_buffer_.Add('\x08');
+        break;
+      case 'f':
+        two_byte_buffer_.Add('\x0c');
+        break;
+      case 'n':
+        two_byte_buffer_.Add('\x0a');
+        break;
+      case 'r':
+        two_byte_buffer_.Add('\x0d');
+        break;
+      case 't':
+        two_byte_buffer_.Add('\x09');
+        break;
+      case 'u': {
+        uc32 value = 0;
+        for (int i = 0; i < 4; i++) {
+          Advance();
+          int digit = HexValue(c0_);
+          if (digit < 0) {
+            ReportUnexpectedToken("unexpected_token", "ILLEGAL");
+            return Handle<String>::null();
+          }
+          value = value * 16 + digit;
+        }
+        two_byte_buffer_.Add(static_cast<uc16>(value));
+        break;
+      }
+      default:
+        ReportUnexpectedToken("unexpected_token", "ILLEGAL");
+        return Handle<String>::null();
+    }
+    Advance();
+  }
+  AdvanceSkipWhitespace();
+  // The result is converted to an ASCII string if possible.
+  Handle<String> result =
+      Factory::NewStringFromTwoByte(two_byte_buffer_.ToConstVector());
+  if (is_symbol) return Factory::SymbolFromString(result);
+  return result;
+}
+
+
+Handle<Object> JsonParser::ParseJsonLiteral(const char* text,
+                                            Handle<Object> value) {
+  ASSERT_EQ(*text, c0_);
+  while (*text != '\0') {
+    if (c0_ != *text) return ReportUnexpectedToken("unexpected_token",
+                                                   "ILLEGAL");
+    Advance();
+    text++;
+  }
+  SkipWhitespace();
+  return value;
+}
+
+
+Handle<Object> JsonParser::ReportUnexpectedCharacter() {
+  // Report the error in the same way as the scanner based JSON parser
+  // would report the token starting at the current position.
+  switch (c0_) {
+    case kEndOfString:
+      return ReportUnexpectedToken("unexpected_eos", NULL);
+    case '"':
+      return ReportUnexpectedToken("unexpected_token_string", NULL);
+    case '-':
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+      return ReportUnexpectedToken("unexpected_token_number", NULL);
+    case '{':
+      return ReportUnexpectedToken("unexpected_token", "{");
+    case '}':
+      return ReportUnexpectedToken("unexpected_token", "}");
+    case '[':
+      return ReportUnexpectedToken("unexpected_token", "[");
+    case ']':
+      return ReportUnexpectedToken("unexpected_token", "]");
+    case ':':
+      return ReportUnexpectedToken("unexpected_token", ":");
+    case ',':
+      return ReportUnexpectedToken("unexpected_token", ",");
+    case 't':
+      return ReportUnexpectedToken("unexpected_token", "true");
+    case 'f':
+      return ReportUnexpectedToken("unexpected_token", "false");
+    case 'n':
+      return ReportUnexpectedToken("unexpected_token", "null");
+    default:
+      return ReportUnexpectedToken("unexpected_token", "ILLEGAL");
+  }
+}
+
+
+Handle<Object> JsonParser::ReportUnexpectedToken(const char* message,
+                                                 const char* arg) {
+  Handle<JSArray> array = Factory::NewJSArray(arg == NULL ? 0 : 1);
+  if (arg != NULL) {
+    SetElement(array, 0, Factory::NewStringFromUtf8(CStrVector(arg)));
+  }
+  Handle<Object> result = Factory::NewSyntaxError(message, array);
+  Top::Throw(*result);
+  return Handle<Object>::null();
+}
+
+
 // ----------------------------------------------------------------------------
 // Regular expressions
 
@@ -5060,8 +5770,6 @@ RegExpTree* RegExpParser::ParseCharacterClass() {
 // MakeAST() is just a wrapper for the corresponding Parser calls
 // so we don't have to expose the entire Parser class in the .h file.
 
-static bool always_allow_natives_syntax = false;
-
 
 ParserMessage::~ParserMessage() {
   for (int i = 0; i < args().length(); i++)
@@ -5095,9 +5803,7 @@ ScriptDataImpl* PreParse(Handle<String> source,
                          v8::Extension* extension) {
   Handle<Script> no_script;
   bool allow_natives_syntax =
-      always_allow_natives_syntax ||
-      FLAG_allow_natives_syntax ||
-      Bootstrapper::IsActive();
+      FLAG_allow_natives_syntax || Bootstrapper::IsActive();
   PreParser parser(no_script, allow_natives_syntax, extension);
   if (!parser.PreParseProgram(source, stream)) return NULL;
   // The list owns the backing store so we need to clone the vector.
@@ -5108,6 +5814,25 @@ ScriptDataImpl* PreParse(Handle<String> source,
 }
 
 
+// Stack budget for preparsing off the VM thread; the same as the StackGuard
+// gives the VM thread.
+static const uintptr_t kPreParseStackSize = kPointerSize * 128 * KB;
+
+
+ScriptDataImpl* PreParse(Vector<const uc16> source) {
+  // The StackGuard only knows the stack limit of the VM thread, so limit
+  // the stack used here relative to the current position instead.
+  uintptr_t stack_limit =
+      reinterpret_cast<uintptr_t>(&stack_limit) - kPreParseStackSize;
+  ASSERT(reinterpret_cast<uintptr_t>(&stack_limit) > kPreParseStackSize);
+  Handle<Script> no_script;
+  PreParser parser(no_script, FLAG_allow_natives_syntax, NULL);
+  if (!parser.PreParseProgram(source, stack_limit)) return NULL;
+  Vector<unsigned> store = parser.recorder()->store()->ToVector().Clone();
+  return new ScriptDataImpl(store);
+}
+
+
 bool ParseRegExp(FlatStringReader* input,
                  bool multiline,
                  RegExpCompileData* result) {
@@ -5136,9 +5861,7 @@ FunctionLiteral* MakeAST(bool compile_in_global_context,
                          ScriptDataImpl* pre_data,
                          bool is_json) {
   bool allow_natives_syntax =
-      always_allow_natives_syntax ||
-      FLAG_allow_natives_syntax ||
-      Bootstrapper::IsActive();
+      FLAG_allow_natives_syntax || Bootstrapper::IsActive();
   AstBuildingParser parser(script, allow_natives_syntax, extension, pre_data);
   if (pre_data != NULL && pre_data->has_error()) {
     Scanner::Location loc = pre_data->MessageLocation();
@@ -5168,11 +5891,9 @@ FunctionLiteral* MakeLazyAST(Handle<Script> script,
                              Handle<String> name,
                              int start_position,
                              int end_position,
-                             bool is_expression) {
-  bool allow_natives_syntax_before = always_allow_natives_syntax;
-  always_allow_natives_syntax = true;
-  AstBuildingParser parser(script, true, NULL, NULL);  // always allow
-  always_allow_natives_syntax = allow_natives_syntax_before;
+                             bool is_expression,
+                             ScriptDataImpl* pre_data) {
+  AstBuildingParser parser(script, true, NULL, pre_data);  // always allow
   // Parse the function by pointing to the function source in the script source.
   Handle<String> script_source(String::cast(script->source()));
   FunctionLiteral* result =
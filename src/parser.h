@@ -70,9 +70,24 @@ class FunctionEntry BASE_EMBEDDED {
   int property_count() { return backing_[kPropertyCountOffset]; }
   void set_property_count(int value) { backing_[kPropertyCountOffset] = value; }
 
+  // The number of functions nested in this function at any depth.  Their
+  // entries follow the entry of this function.
+  int inner_function_count() { return backing_[kInnerFunctionCountOffset]; }
+  void set_inner_function_count(int value) {
+    backing_[kInnerFunctionCountOffset] = value;
+  }
+
+  // Whether the function may need a context of its own, because it calls
+  // eval, contains a with statement or declares variables that are used by
+  // inner functions.  If it doesn't, the inner functions don't need to be
+  // parsed when the function is compiled lazily, as they are compiled
+  // lazily themselves.
+  bool needs_context() { return backing_[kNeedsContextOffset] != 0; }
+  void set_needs_context(bool value) { backing_[kNeedsContextOffset] = value; }
+
   bool is_valid() { return backing_.length() > 0; }
 
-  static const int kSize = 4;
+  static const int kSize = 6;
 
  private:
   Vector<unsigned> backing_;
@@ -80,9 +95,14 @@ class FunctionEntry BASE_EMBEDDED {
   static const int kEndPosOffset = 1;
   static const int kLiteralCountOffset = 2;
   static const int kPropertyCountOffset = 3;
+  static const int kInnerFunctionCountOffset = 4;
+  static const int kNeedsContextOffset = 5;
 };
 
 
+// The function entries of the preparse data are recorded in the order the
+// functions start in the source, so the entry of a function is followed by
+// the entries of its inner functions.
 class ScriptDataImpl : public ScriptData {
  public:
   explicit ScriptDataImpl(Vector<unsigned> store)
@@ -99,12 +119,23 @@ class ScriptDataImpl : public ScriptData {
   const char* BuildMessage();
   Vector<const char*> BuildArgs();
 
+  // Returns the function entries to keep with the script for lazy
+  // compilation, or undefined if they don't allow skipping any function.
+  Handle<Object> FunctionEntriesForLazyCompilation();
+
+  // Returns preparse data with the entries of the functions directly inside
+  // the function starting at start_position, taken from the function entries
+  // kept with the script.  Returns NULL if the inner functions have to be
+  // parsed when the function is compiled lazily.
+  static ScriptDataImpl* ForLazyCompilation(Handle<Script> script,
+                                            int start_position);
+
   bool has_error() { return store_[kHasErrorOffset]; }
   unsigned magic() { return store_[kMagicOffset]; }
   unsigned version() { return store_[kVersionOffset]; }
 
   static const unsigned kMagicNumber = 0xBadDead;
-  static const unsigned kCurrentVersion = 1;
+  static const unsigned kCurrentVersion = 2;
 
   static const unsigned kMagicOffset = 0;
   static const unsigned kVersionOffset = 1;
@@ -142,6 +173,12 @@ ScriptDataImpl* PreParse(Handle<String> source,
                          v8::Extension* extension);
 
 
+// Preparses UTF-16 source outside the heap. Uses neither the heap nor the
+// per-thread state of the VM, so it may run on any thread once V8 has been
+// initialized. Returns NULL on stack overflow.
+ScriptDataImpl* PreParse(Vector<const uc16> source);
+
+
 bool ParseRegExp(FlatStringReader* input,
                  bool multiline,
                  RegExpCompileData* result);
@@ -154,13 +191,15 @@ bool ParseRegExp(FlatStringReader* input,
 //
 //    (<formal parameters>) { <function body> }
 //
-// without any function keyword or name.
+// without any function keyword or name.  The bodies of the inner functions
+// that have entries in pre_data, if any, are skipped.
 //
 FunctionLiteral* MakeLazyAST(Handle<Script> script,
                              Handle<String> name,
                              int start_position,
                              int end_position,
-                             bool is_expression);
+                             bool is_expression,
+                             ScriptDataImpl* pre_data);
 
 
 // Support for handling complex values (array and object literals) that
@@ -192,6 +231,87 @@ class CompileTimeValue: public AllStatic {
 };
 
 
+// A single pass parser for JSON text (ECMA-262 5th edition, section 15.12.1)
+// that builds the resulting JavaScript value directly on the heap instead
+// of going through the AST, the code generator and a function call.
+// Objects with the same sequence of keys end up sharing maps through the
+// normal map transitions.
+class JsonParser BASE_EMBEDDED {
+ public:
+  // Parse a string containing a single JSON value into a JavaScript value.
+  // Returns a null handle if the input is not valid JSON, in which case a
+  // SyntaxError (or a stack overflow exception) has been thrown.
+  static Handle<Object> Parse(Handle<String> source);
+
+ private:
+  explicit JsonParser(Handle<String> source);
+
+  static const int kEndOfString = -1;
+
+  // Move to the next character of the source and skip whitespace.
+  inline void Advance();
+  inline void SkipWhitespace();
+  inline void AdvanceSkipWhitespace();
+
+  // Parse the top-level JSON value and check that nothing but whitespace
+  // follows it.
+  Handle<Object> ParseJson();
+
+  // Parse a single JSON value (grammar production JSONValue) starting at
+  // the current character.  Trailing whitespace is consumed.
+  Handle<Object> ParseJsonValue();
+
+  // Parse a JSON object (production JSONObject).  The current character
+  // must be '{'.
+  Handle<Object> ParseJsonObject();
+
+  // Parse a JSON array (production JSONArray).  The current character
+  // must be '['.
+  Handle<Object> ParseJsonArray();
+
+  // Parse a JSON number (production JSONNumber).  Integers that fit in a
+  // smi are converted without going through the double conversion code.
+  Handle<Object> ParseJsonNumber();
+
+  // Parse a JSON string (production JSONString).  Strings without escape
+  // sequences are copied straight out of the source.  If is_symbol is true
+  // the result is a symbol, as used for property keys.
+  Handle<String> ParseJsonString(bool is_symbol);
+
+  // Finish parsing a string that contains escape sequences.  The
+  // characters between start and the current position have already been
+  // scanned and contain no escapes.
+  Handle<String> SlowParseJsonString(int start, bool is_symbol);
+
+  // Parse one of the literals 'true', 'false' and 'null'.
+  Handle<Object> ParseJsonLiteral(const char* text, Handle<Object> value);
+
+  // Throw a SyntaxError for the token starting at the current character.
+  // Always returns a null handle.
+  Handle<Object> ReportUnexpectedCharacter();
+  Handle<Object> ReportUnexpectedToken(const char* message, const char* arg);
+
+  Handle<String> source_;
+  int source_length_;
+  bool is_sequential_ascii_;
+
+  // Current position in the source and the character at that position.
+  int position_;
+  uc32 c0_;
+
+  // Values of the arrays that are currently being parsed, innermost
+  // array last.
+  List<Handle<Object> > element_stack_;
+
+  // Scratch buffers for strings that need to be copied before they can be
+  // used to create a string or a number.
+  List<char> ascii_buffer_;
+  List<uc16> two_byte_buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(JsonParser);
+};
+
+
 } }  // namespace v8::internal
 
 #endif  // V8_PARSER_H_
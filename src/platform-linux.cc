@@ -174,6 +174,15 @@ int OS::ActivationFrameAlignment() {
 typedef void (*LinuxKernelMemoryBarrierFunc)(void);
 LinuxKernelMemoryBarrierFunc pLinuxKernelMemoryBarrier __attribute__((weak)) =
     (LinuxKernelMemoryBarrierFunc) 0xffff0fa0;
+
+// 0xffff0fc0 is the hard coded address of the kernel provided
+// compare-and-exchange function. It returns zero if the new value was
+// stored.
+typedef int (*LinuxKernelCmpxchgFunc)(AtomicWord old_value,
+                                      AtomicWord new_value,
+                                      volatile AtomicWord* ptr);
+LinuxKernelCmpxchgFunc pLinuxKernelCmpxchg __attribute__((weak)) =
+    (LinuxKernelCmpxchgFunc) 0xffff0fc0;
 #endif
 
 void OS::ReleaseStore(volatile AtomicWord* ptr, AtomicWord value) {
@@ -188,6 +197,22 @@ void OS::ReleaseStore(volatile AtomicWord* ptr, AtomicWord value) {
 }
 
 
+AtomicWord OS::CompareAndSwap(volatile AtomicWord* ptr,
+                              AtomicWord old_value,
+                              AtomicWord new_value) {
+#if defined(V8_TARGET_ARCH_ARM) && defined(__arm__)
+  // Only use on ARM hardware.
+  while (true) {
+    AtomicWord previous = *ptr;
+    if (previous != old_value) return previous;
+    if (pLinuxKernelCmpxchg(old_value, new_value, ptr) == 0) return old_value;
+  }
+#else
+  return __sync_val_compare_and_swap(ptr, old_value, new_value);
+#endif
+}
+
+
 const char* OS::LocalTimezone(double time) {
   if (isnan(time)) return "";
   time_t tv = static_cast<time_t>(floor(time/msPerSecond));
@@ -266,6 +266,22 @@ void OS::ReleaseStore(volatile AtomicWord* ptr, AtomicWord value) {
 }
 
 
+AtomicWord OS::CompareAndSwap(volatile AtomicWord* ptr,
+                              AtomicWord old_value,
+                              AtomicWord new_value) {
+  while (true) {
+    AtomicWord previous = *ptr;
+    if (previous != old_value) return previous;
+    void* volatile* location = reinterpret_cast<void* volatile*>(ptr);
+    if (OSAtomicCompareAndSwapPtrBarrier(reinterpret_cast<void*>(old_value),
+                                         reinterpret_cast<void*>(new_value),
+                                         location)) {
+      return old_value;
+    }
+  }
+}
+
+
 const char* OS::LocalTimezone(double time) {
   if (isnan(time)) return "";
   time_t tv = static_cast<time_t>(floor(time/msPerSecond));
@@ -279,6 +279,14 @@ class OS {
 
   static void ReleaseStore(volatile AtomicWord* ptr, AtomicWord value);
 
+  // Atomically stores new_value in *ptr if *ptr is equal to old_value.
+  // Returns the value *ptr had before the operation, so the store took
+  // place if and only if the result is equal to old_value.  The operation
+  // is a full memory barrier.
+  static AtomicWord CompareAndSwap(volatile AtomicWord* ptr,
+                                   AtomicWord old_value,
+                                   AtomicWord new_value);
+
  private:
   static const int msPerSecond = 1000;
 
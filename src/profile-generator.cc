@@ -1516,6 +1516,9 @@ void HeapSnapshotGenerator::ExtractReferences(HeapObject* obj) {
       ConsString* cs = ConsString::cast(obj);
       snapshot_->SetElementReference(entry, 0, cs->first());
       snapshot_->SetElementReference(entry, 1, cs->second());
+    } else if (obj->IsSlicedString()) {
+      SlicedString* ss = SlicedString::cast(obj);
+      snapshot_->SetElementReference(entry, 0, ss->parent());
     }
   } else if (obj->IsCode() || obj->IsSharedFunctionInfo() || obj->IsScript()) {
     IndexedReferencesExtractor refs_extractor(snapshot_, entry);
@@ -1609,6 +1612,376 @@ void HeapSnapshotGenerator::ExtractElementReferences(JSObject* js_obj,
   }
 }
 
+
+class IndexedReferencesWriter : public ObjectVisitor {
+ public:
+  explicit IndexedReferencesWriter(HeapSnapshotStreamWriter* writer)
+      : writer_(writer),
+        next_index_(1) {
+  }
+
+  void VisitPointer(Object** o) {
+    if (writer_->GetNodeObject(*o) != NULL) {
+      writer_->WriteEdge(HeapGraphEdge::ELEMENT, next_index_++, *o);
+    }
+  }
+
+  void VisitPointers(Object** start, Object** end) {
+    for (Object** p = start; p < end; p++) VisitPointer(p);
+  }
+
+ private:
+  HeapSnapshotStreamWriter* writer_;
+  int next_index_;
+};
+
+
+HeapSnapshotStreamWriter::HeapSnapshotStreamWriter(v8::OutputStream* stream)
+    : stream_(stream),
+      chunk_(NewArray<char>(stream->GetChunkSize()),
+             stream->GetChunkSize()),
+      chunk_position_(0),
+      aborted_(false),
+      global_security_token_(NULL),
+      string_cache_(NewArray<StringCacheEntry>(kStringCacheSize)),
+      next_string_id_(1) {
+  ASSERT(chunk_.length() > 0);
+  for (int i = 0; i < kStringCacheSize; i++) {
+    string_cache_[i].string = NULL;
+    string_cache_[i].id = 0;
+  }
+}
+
+
+HeapSnapshotStreamWriter::~HeapSnapshotStreamWriter() {
+  DeleteArray(chunk_.start());
+  DeleteArray(string_cache_);
+}
+
+
+void HeapSnapshotStreamWriter::WriteSnapshot(String* title) {
+  AssertNoAllocation no_alloc;
+  global_security_token_ =
+      Top::context()->global()->global_context()->security_token();
+
+  AddString("heap-snapshot,");
+  AddQuotedString(title);
+  AddCharacter('\n');
+  WriteRoot();
+
+  HeapIterator iterator;
+  for (HeapObject* obj = iterator.next();
+       obj != NULL && !aborted_;
+       obj = iterator.next()) {
+    if (GetNodeObject(obj) != obj) continue;
+    WriteNode(obj);
+    if (!IsForeignGlobalContext(obj)) WriteReferences(obj);
+  }
+
+  Flush();
+  if (!aborted_) stream_->EndOfStream();
+}
+
+
+HeapObject* HeapSnapshotStreamWriter::GetNodeObject(Object* obj) {
+  if (!obj->IsHeapObject()) return NULL;
+  if (obj->IsJSGlobalPropertyCell()) {
+    // Property cells are not written as nodes. References to a cell are
+    // written as references to its value instead.
+    Object* value = JSGlobalPropertyCell::cast(obj)->value();
+    if (!value->IsHeapObject() || value->IsJSGlobalPropertyCell()) return NULL;
+    return GetNodeObject(value);
+  }
+  HeapEntry::Type type;
+  String* name;
+  return GetNodeTypeAndName(HeapObject::cast(obj), &type, &name) ?
+      HeapObject::cast(obj) : NULL;
+}
+
+
+// Mirrors HeapSnapshot::GetEntry.
+bool HeapSnapshotStreamWriter::GetNodeTypeAndName(HeapObject* obj,
+                                                  HeapEntry::Type* type,
+                                                  String** name) {
+  *name = NULL;
+  if (obj->IsJSFunction()) {
+    SharedFunctionInfo* shared = JSFunction::cast(obj)->shared();
+    *type = HeapEntry::CLOSURE;
+    *name = String::cast(shared->name())->length() > 0 ?
+        String::cast(shared->name()) : shared->inferred_name();
+  } else if (obj->IsJSObject()) {
+    *type = HeapEntry::OBJECT;
+    *name = JSObject::cast(obj)->constructor_name();
+  } else if (obj->IsString()) {
+    *type = HeapEntry::STRING;
+    *name = String::cast(obj);
+  } else if (obj->IsCode()) {
+    *type = HeapEntry::CODE;
+  } else if (obj->IsSharedFunctionInfo()) {
+    SharedFunctionInfo* shared = SharedFunctionInfo::cast(obj);
+    *type = HeapEntry::CODE;
+    *name = String::cast(shared->name())->length() > 0 ?
+        String::cast(shared->name()) : shared->inferred_name();
+  } else if (obj->IsScript()) {
+    Object* script_name = Script::cast(obj)->name();
+    *type = HeapEntry::CODE;
+    if (script_name->IsString()) *name = String::cast(script_name);
+  } else if (obj->IsFixedArray()) {
+    *type = HeapEntry::ARRAY;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+
+// References from global contexts of other security domains are left out,
+// as HeapSnapshot::CutObjectsFromForeignSecurityContexts does.
+bool HeapSnapshotStreamWriter::IsForeignGlobalContext(HeapObject* obj) {
+  return obj->IsGlobalContext() &&
+      Context::cast(obj)->security_token() != global_security_token_;
+}
+
+
+void HeapSnapshotStreamWriter::WriteRoot() {
+  AddString("node,");
+  AddNumber(HeapEntry::INTERNAL);
+  AddString(",0,0,0\n");
+  // The root refers to the JS global objects of the current security
+  // domain, see HeapSnapshot::AddEntry.
+  int index = 1;
+  HeapIterator iterator;
+  for (HeapObject* obj = iterator.next(); obj != NULL; obj = iterator.next()) {
+    if (!obj->IsJSGlobalProxy()) continue;
+    Object* token =
+        Context::cast(JSGlobalProxy::cast(obj)->context())->security_token();
+    if (token == global_security_token_) {
+      WriteEdge(HeapGraphEdge::ELEMENT, index++, obj->map()->prototype());
+    }
+  }
+}
+
+
+void HeapSnapshotStreamWriter::WriteNode(HeapObject* obj) {
+  HeapEntry::Type type;
+  String* name;
+  GetNodeTypeAndName(obj, &type, &name);
+  int name_id = name != NULL ? GetStringId(name) : 0;
+  AddString("node,");
+  AddNumber(type);
+  AddCharacter(',');
+  AddNumber(GetNodeId(obj));
+  AddCharacter(',');
+  AddNumber(name_id);
+  AddCharacter(',');
+  AddNumber(HeapSnapshot::GetObjectSize(obj));
+  AddCharacter('\n');
+}
+
+
+// Mirrors HeapSnapshotGenerator::ExtractReferences.
+void HeapSnapshotStreamWriter::WriteReferences(HeapObject* obj) {
+  if (obj->IsJSObject()) {
+    JSObject* js_obj = JSObject::cast(obj);
+    WriteClosureReferences(js_obj);
+    WritePropertyReferences(js_obj);
+    WriteElementReferences(js_obj);
+    WriteEdge(HeapGraphEdge::PROPERTY,
+              Heap::prototype_symbol(),
+              js_obj->map()->prototype());
+  } else if (obj->IsConsString()) {
+    ConsString* cs = ConsString::cast(obj);
+    WriteEdge(HeapGraphEdge::ELEMENT, 0, cs->first());
+    WriteEdge(HeapGraphEdge::ELEMENT, 1, cs->second());
+  } else if (obj->IsSlicedString()) {
+    WriteEdge(HeapGraphEdge::ELEMENT, 0, SlicedString::cast(obj)->parent());
+  } else if (obj->IsCode() ||
+             obj->IsSharedFunctionInfo() ||
+             obj->IsScript() ||
+             obj->IsFixedArray()) {
+    IndexedReferencesWriter refs_writer(this);
+    obj->Iterate(&refs_writer);
+  }
+}
+
+
+void HeapSnapshotStreamWriter::WriteClosureReferences(JSObject* js_obj) {
+  if (!js_obj->IsJSFunction()) return;
+  HandleScope hs;
+  Context* context = JSFunction::cast(js_obj)->context();
+  ZoneScope zscope(DELETE_ON_EXIT);
+  ScopeInfo<ZoneListAllocationPolicy> scope_info(
+      context->closure()->shared()->code());
+  int locals_number = scope_info.NumberOfLocals();
+  for (int i = 0; i < locals_number; ++i) {
+    String* local_name = *scope_info.LocalName(i);
+    int idx = ScopeInfo<>::ContextSlotIndex(
+        context->closure()->shared()->code(), local_name, NULL);
+    if (idx >= 0 && idx < context->length()) {
+      WriteEdge(HeapGraphEdge::CONTEXT_VARIABLE, local_name, context->get(idx));
+    }
+  }
+}
+
+
+void HeapSnapshotStreamWriter::WritePropertyReferences(JSObject* js_obj) {
+  if (js_obj->HasFastProperties()) {
+    DescriptorArray* descs = js_obj->map()->instance_descriptors();
+    for (int i = 0; i < descs->number_of_descriptors(); i++) {
+      switch (descs->GetType(i)) {
+        case FIELD:
+          WriteEdge(HeapGraphEdge::PROPERTY,
+                    descs->GetKey(i),
+                    js_obj->FastPropertyAt(descs->GetFieldIndex(i)));
+          break;
+        case CONSTANT_FUNCTION:
+          WriteEdge(HeapGraphEdge::PROPERTY,
+                    descs->GetKey(i),
+                    descs->GetConstantFunction(i));
+          break;
+        default: ;
+      }
+    }
+  } else {
+    StringDictionary* dictionary = js_obj->property_dictionary();
+    int length = dictionary->Capacity();
+    for (int i = 0; i < length; ++i) {
+      Object* k = dictionary->KeyAt(i);
+      if (dictionary->IsKey(k)) {
+        WriteEdge(HeapGraphEdge::PROPERTY,
+                  String::cast(k),
+                  dictionary->ValueAt(i));
+      }
+    }
+  }
+}
+
+
+void HeapSnapshotStreamWriter::WriteElementReferences(JSObject* js_obj) {
+  if (js_obj->HasFastElements()) {
+    FixedArray* elements = FixedArray::cast(js_obj->elements());
+    int length = js_obj->IsJSArray() ?
+        Smi::cast(JSArray::cast(js_obj)->length())->value() :
+        elements->length();
+    for (int i = 0; i < length; ++i) {
+      if (!elements->get(i)->IsTheHole()) {
+        WriteEdge(HeapGraphEdge::ELEMENT, i, elements->get(i));
+      }
+    }
+  } else if (js_obj->HasDictionaryElements()) {
+    NumberDictionary* dictionary = js_obj->element_dictionary();
+    int length = dictionary->Capacity();
+    for (int i = 0; i < length; ++i) {
+      Object* k = dictionary->KeyAt(i);
+      if (dictionary->IsKey(k)) {
+        ASSERT(k->IsNumber());
+        uint32_t index = static_cast<uint32_t>(k->Number());
+        WriteEdge(HeapGraphEdge::ELEMENT,
+                  static_cast<int>(index),
+                  dictionary->ValueAt(i));
+      }
+    }
+  }
+}
+
+
+void HeapSnapshotStreamWriter::WriteEdge(HeapGraphEdge::Type type,
+                                         String* name,
+                                         Object* child) {
+  if (GetNodeObject(child) == NULL) return;
+  WriteEdge(type, GetStringId(name), child);
+}
+
+
+void HeapSnapshotStreamWriter::WriteEdge(HeapGraphEdge::Type type,
+                                         int name_or_index,
+                                         Object* child) {
+  HeapObject* target = GetNodeObject(child);
+  if (target == NULL) return;
+  AddString("edge,");
+  AddNumber(type);
+  AddCharacter(',');
+  AddNumber(name_or_index);
+  AddCharacter(',');
+  AddNumber(GetNodeId(target));
+  AddCharacter('\n');
+}
+
+
+int HeapSnapshotStreamWriter::GetStringId(String* string) {
+  // Only symbols are cached: names of properties, variables and
+  // constructors are symbols and repeat a lot, while the contents of
+  // other strings are usually written only once, as names of string nodes.
+  StringCacheEntry* entry = NULL;
+  if (string->IsSymbol()) {
+    uint32_t hash = static_cast<uint32_t>(
+        reinterpret_cast<intptr_t>(string) >> kObjectAlignmentBits);
+    entry = &string_cache_[hash & (kStringCacheSize - 1)];
+    if (entry->string == string) return entry->id;
+  }
+  int id = next_string_id_++;
+  AddString("string,");
+  AddNumber(id);
+  AddCharacter(',');
+  AddQuotedString(string);
+  AddCharacter('\n');
+  if (entry != NULL) {
+    entry->string = string;
+    entry->id = id;
+  }
+  return id;
+}
+
+
+void HeapSnapshotStreamWriter::AddCharacter(char c) {
+  if (chunk_position_ == chunk_.length()) Flush();
+  chunk_[chunk_position_++] = c;
+}
+
+
+void HeapSnapshotStreamWriter::AddString(const char* s) {
+  while (*s != '\0') AddCharacter(*s++);
+}
+
+
+void HeapSnapshotStreamWriter::AddNumber(intptr_t n) {
+  EmbeddedVector<char, 32> buffer;
+  OS::SNPrintF(buffer, "%" V8PRIdPTR, n);
+  AddString(buffer.start());
+}
+
+
+void HeapSnapshotStreamWriter::AddQuotedString(String* string) {
+  static const char kHexDigits[] = "0123456789abcdef";
+  AddCharacter('"');
+  StringInputBuffer buffer(string);
+  while (buffer.has_more()) {
+    uc32 c = buffer.GetNext();
+    if (c >= 0x20 && c < 0x7f && c != '"' && c != '\\') {
+      AddCharacter(static_cast<char>(c));
+    } else {
+      AddString("\\u");
+      for (int shift = 12; shift >= 0; shift -= 4) {
+        AddCharacter(kHexDigits[(c >> shift) & 0xf]);
+      }
+    }
+  }
+  AddCharacter('"');
+}
+
+
+void HeapSnapshotStreamWriter::Flush() {
+  if (aborted_ || chunk_position_ == 0) {
+    chunk_position_ = 0;
+    return;
+  }
+  if (stream_->WriteAsciiChunk(chunk_.start(), chunk_position_) ==
+      v8::OutputStream::kAbort) {
+    aborted_ = true;
+  }
+  chunk_position_ = 0;
+}
+
 } }  // namespace v8::internal
 
 #endif  // ENABLE_LOGGING_AND_PROFILING
@@ -653,6 +653,8 @@ class HeapSnapshot {
 
   void Print(int max_depth);
 
+  static int GetObjectSize(HeapObject* obj);
+
  private:
   HeapEntry* AddEntry(HeapObject* object, HeapEntry::Type type) {
     return AddEntry(object, type, "");
@@ -667,7 +669,6 @@ class HeapSnapshot {
   }
   int GetGlobalSecurityToken();
   int GetObjectSecurityToken(HeapObject* obj);
-  static int GetObjectSize(HeapObject* obj);
   static int CalculateNetworkSize(JSObject* obj);
 
   HeapSnapshotsCollection* collection_;
@@ -725,6 +726,73 @@ class HeapSnapshotGenerator {
   DISALLOW_COPY_AND_ASSIGN(HeapSnapshotGenerator);
 };
 
+
+// HeapSnapshotStreamWriter writes a heap snapshot directly to an output
+// stream (see v8::HeapProfiler::StreamSnapshot for the format), visiting
+// the same objects and references as HeapSnapshotGenerator. Instead of
+// keeping a HeapEntry per object, node ids are derived from object
+// addresses, so apart from the output chunk and a fixed size cache of
+// recently written strings no memory is needed outside of the heap.
+class HeapSnapshotStreamWriter {
+ public:
+  explicit HeapSnapshotStreamWriter(v8::OutputStream* stream);
+  ~HeapSnapshotStreamWriter();
+
+  void WriteSnapshot(String* title);
+
+ private:
+  struct StringCacheEntry {
+    String* string;
+    int id;
+  };
+
+  // Returns the object represented by a node for a reference to obj, or
+  // NULL if such references are not included into the snapshot.
+  HeapObject* GetNodeObject(Object* obj);
+  bool GetNodeTypeAndName(HeapObject* obj,
+                          HeapEntry::Type* type,
+                          String** name);
+  bool IsForeignGlobalContext(HeapObject* obj);
+
+  void WriteRoot();
+  void WriteNode(HeapObject* obj);
+  void WriteReferences(HeapObject* obj);
+  void WriteClosureReferences(JSObject* js_obj);
+  void WritePropertyReferences(JSObject* js_obj);
+  void WriteElementReferences(JSObject* js_obj);
+  void WriteEdge(HeapGraphEdge::Type type, String* name, Object* child);
+  void WriteEdge(HeapGraphEdge::Type type, int name_or_index, Object* child);
+
+  // Returns the id of the string, writing it out first if it is not in
+  // the cache.
+  int GetStringId(String* string);
+
+  // Output buffering.
+  void AddCharacter(char c);
+  void AddString(const char* s);
+  void AddNumber(intptr_t n);
+  void AddQuotedString(String* string);
+  void Flush();
+
+  static intptr_t GetNodeId(HeapObject* obj) {
+    return reinterpret_cast<intptr_t>(obj->address()) >> kObjectAlignmentBits;
+  }
+
+  static const int kStringCacheSize = 1024;
+
+  friend class IndexedReferencesWriter;
+
+  v8::OutputStream* stream_;
+  Vector<char> chunk_;
+  int chunk_position_;
+  bool aborted_;
+  Object* global_security_token_;
+  StringCacheEntry* string_cache_;
+  int next_string_id_;
+
+  DISALLOW_COPY_AND_ASSIGN(HeapSnapshotStreamWriter);
+};
+
 } }  // namespace v8::internal
 
 #endif  // ENABLE_LOGGING_AND_PROFILING
@@ -73,10 +73,16 @@ bool NativeRegExpMacroAssembler::CanReadUnaligned() {
 const byte* NativeRegExpMacroAssembler::StringCharacterPosition(
     String* subject,
     int start_index) {
-  // Not just flat, but ultra flat.
-  ASSERT(subject->IsExternalString() || subject->IsSeqString());
   ASSERT(start_index >= 0);
   ASSERT(start_index <= subject->length());
+  // A sliced string uses the characters of its parent.
+  if (StringShape(subject).IsSliced()) {
+    SlicedString* slice = SlicedString::cast(subject);
+    start_index += slice->offset();
+    subject = slice->parent();
+  }
+  // Not just flat, but ultra flat.
+  ASSERT(subject->IsExternalString() || subject->IsSeqString());
   if (subject->IsAsciiRepresentation()) {
     const byte* address;
     if (StringShape(subject).IsExternal()) {
@@ -130,8 +136,10 @@ NativeRegExpMacroAssembler::Result NativeRegExpMacroAssembler::Match(
   }
   // Ensure that an underlying string has the same ascii-ness.
   ASSERT(subject_ptr->IsAsciiRepresentation() == is_ascii);
-  ASSERT(subject_ptr->IsExternalString() || subject_ptr->IsSeqString());
-  // String is now either Sequential or External
+  // String is now either sequential, sliced or external.  A sliced string
+  // is passed to the generated code as the subject so that the start of the
+  // slice is the start of input, while the character positions point into
+  // its parent.
   int char_size_shift = is_ascii ? 0 : 1;
   int char_length = end_offset - start_offset;
 
@@ -174,7 +182,7 @@ NativeRegExpMacroAssembler::Result NativeRegExpMacroAssembler::Execute(
                                           stack_base,
                                           direct_call);
   ASSERT(result <= SUCCESS);
-  ASSERT(result >= RETRY);
+  ASSERT(result >= BACKTRACK_LIMIT);
 
   if (result == EXCEPTION && !Top::has_pending_exception()) {
     // We detected a stack overflow (on the backtrack stack) in RegExp code,
@@ -185,9 +193,6 @@ NativeRegExpMacroAssembler::Result NativeRegExpMacroAssembler::Execute(
 }
 
 
-static unibrow::Mapping<unibrow::Ecma262Canonicalize> canonicalize;
-
-
 byte NativeRegExpMacroAssembler::word_character_map[] = {
     0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
     0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
@@ -222,16 +227,18 @@ int NativeRegExpMacroAssembler::CaseInsensitiveCompareUC16(
   uc16* substring1 = reinterpret_cast<uc16*>(byte_offset1);
   uc16* substring2 = reinterpret_cast<uc16*>(byte_offset2);
   size_t length = byte_length >> 1;
+  unibrow::Mapping<unibrow::Ecma262Canonicalize>* canonicalize =
+      &RegExpEngine::data()->canonicalize_;
 
   for (size_t i = 0; i < length; i++) {
     unibrow::uchar c1 = substring1[i];
     unibrow::uchar c2 = substring2[i];
     if (c1 != c2) {
       unibrow::uchar s1[1] = { c1 };
-      canonicalize.get(c1, '\0', s1);
+      canonicalize->get(c1, '\0', s1);
       if (s1[0] != c2) {
         unibrow::uchar s2[1] = { c2 };
-        canonicalize.get(c2, '\0', s2);
+        canonicalize->get(c2, '\0', s2);
         if (s1[0] != s2[0]) {
           return 0;
         }
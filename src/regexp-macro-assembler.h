@@ -177,7 +177,16 @@ class NativeRegExpMacroAssembler: public RegExpMacroAssembler {
   // FAILURE: Matching failed.
   // SUCCESS: Matching succeeded, and the output array has been filled with
   //        capture positions.
-  enum Result { RETRY = -2, EXCEPTION = -1, FAILURE = 0, SUCCESS = 1 };
+  // BACKTRACK_LIMIT: Matching was abandoned after backtracking
+  //        --regexp-backtrack-limit times. The result of the match is
+  //        unknown.
+  enum Result {
+    BACKTRACK_LIMIT = -3,
+    RETRY = -2,
+    EXCEPTION = -1,
+    FAILURE = 0,
+    SUCCESS = 1
+  };
 
   NativeRegExpMacroAssembler();
   virtual ~NativeRegExpMacroAssembler();
@@ -204,6 +213,10 @@ class NativeRegExpMacroAssembler: public RegExpMacroAssembler {
 
   static const byte* StringCharacterPosition(String* subject, int start_index);
 
+  // Number of backtracks after which generated code gives up and returns
+  // BACKTRACK_LIMIT, or zero if backtracking is not limited.
+  static int backtrack_limit() { return FLAG_regexp_backtrack_limit; }
+
   // Byte map of ASCII characters with a 0xff if the character is a word
   // character (digit, letter or underscore) and 0x00 otherwise.
   // Used by generated RegExp code.
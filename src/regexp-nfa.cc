@@ -0,0 +1,562 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "v8.h"
+
+#include "ast.h"
+#include "jsregexp.h"
+#include "regexp-nfa.h"
+
+namespace v8 {
+namespace internal {
+
+// A program is an array of 32 bit integers.  It starts with the number of
+// registers and the number of instructions that threads can wait at
+// (CONSUME and MATCH), followed by the instructions.  Branch targets are
+// indices into the array.
+//
+//   CONSUME negated count (from to)*   Consume a character in (or, if
+//                                      negated, not in) one of the ranges.
+//   ASSERT type                        Check a RegExpAssertion::Type.
+//   FORK target                        Continue with the next instruction,
+//                                      then try target.
+//   FORK_JUMP_FIRST target             Try target, then the next
+//                                      instruction.
+//   JUMP target
+//   SAVE register                      Store the current position.
+//   CLEAR from to                      Reset registers from..to to -1.
+//   MATCH
+enum NfaOpcode {
+  NFA_CONSUME,
+  NFA_ASSERT,
+  NFA_FORK,
+  NFA_FORK_JUMP_FIRST,
+  NFA_JUMP,
+  NFA_SAVE,
+  NFA_CLEAR,
+  NFA_MATCH
+};
+
+
+static const int kNfaRegisterCountIndex = 0;
+static const int kNfaThreadCountIndex = 1;
+static const int kNfaHeaderSize = 2;
+
+// Patterns whose programs would be longer than this are not supported.
+static const int kNfaMaxProgramLength = 16 * KB;
+// Nor are patterns where the thread lists would need more registers than
+// this.
+static const int kNfaMaxThreadRegisters = 256 * KB;
+
+
+class RegExpNfaCompiler: public RegExpVisitor {
+ public:
+  RegExpNfaCompiler(int capture_count, bool ignore_case)
+      : code_(64),
+        register_count_((capture_count + 1) * 2),
+        thread_count_(0),
+        ignore_case_(ignore_case),
+        ok_(true) { }
+
+  // Returns false if the pattern is not supported.
+  bool Compile(RegExpTree* tree);
+  Vector<const int> code() { return code_.ToConstVector(); }
+
+#define MAKE_CASE(Name) virtual void* Visit##Name(RegExp##Name*, void* data);
+  FOR_EACH_REG_EXP_TREE_TYPE(MAKE_CASE)
+#undef MAKE_CASE
+
+ private:
+  int pc() { return code_.length(); }
+
+  void Emit(int value) {
+    if (code_.length() < kNfaMaxProgramLength) {
+      code_.Add(value);
+    } else {
+      ok_ = false;
+    }
+  }
+
+  // Emits a branch and returns the location of its target for Patch.
+  int EmitBranch(NfaOpcode opcode) {
+    Emit(opcode);
+    Emit(0);
+    return pc() - 1;
+  }
+
+  void Patch(int location, int target) {
+    if (ok_) code_[location] = target;
+  }
+
+  void EmitConsume(ZoneList<CharacterRange>* ranges, bool negated);
+  void EmitIteration(RegExpTree* body, Interval captures);
+
+  ZoneList<int> code_;
+  int register_count_;
+  int thread_count_;
+  bool ignore_case_;
+  bool ok_;
+};
+
+
+bool RegExpNfaCompiler::Compile(RegExpTree* tree) {
+  Emit(register_count_);
+  Emit(0);
+  Emit(NFA_SAVE);
+  Emit(0);
+  tree->Accept(this, NULL);
+  Emit(NFA_SAVE);
+  Emit(1);
+  Emit(NFA_MATCH);
+  thread_count_++;
+  if (!ok_) return false;
+  code_[kNfaThreadCountIndex] = thread_count_;
+  return thread_count_ * register_count_ <= kNfaMaxThreadRegisters;
+}
+
+
+void RegExpNfaCompiler::EmitConsume(ZoneList<CharacterRange>* ranges,
+                                    bool negated) {
+  Emit(NFA_CONSUME);
+  Emit(negated ? 1 : 0);
+  Emit(ranges->length());
+  for (int i = 0; i < ranges->length() && ok_; i++) {
+    Emit(ranges->at(i).from());
+    Emit(ranges->at(i).to());
+  }
+  thread_count_++;
+}
+
+
+void RegExpNfaCompiler::EmitIteration(RegExpTree* body, Interval captures) {
+  // Captures inside a quantified expression are reset on each iteration.
+  if (!captures.is_empty()) {
+    Emit(NFA_CLEAR);
+    Emit(captures.from());
+    Emit(captures.to());
+  }
+  body->Accept(this, NULL);
+}
+
+
+void* RegExpNfaCompiler::VisitDisjunction(RegExpDisjunction* that,
+                                          void* data) {
+  ZoneList<RegExpTree*>* alternatives = that->alternatives();
+  ZoneList<int> exits(alternatives->length());
+  int last = alternatives->length() - 1;
+  for (int i = 0; i < last && ok_; i++) {
+    int next = EmitBranch(NFA_FORK);
+    alternatives->at(i)->Accept(this, data);
+    exits.Add(EmitBranch(NFA_JUMP));
+    Patch(next, pc());
+  }
+  alternatives->at(last)->Accept(this, data);
+  for (int i = 0; i < exits.length(); i++) {
+    Patch(exits[i], pc());
+  }
+  return NULL;
+}
+
+
+void* RegExpNfaCompiler::VisitAlternative(RegExpAlternative* that,
+                                          void* data) {
+  ZoneList<RegExpTree*>* nodes = that->nodes();
+  for (int i = 0; i < nodes->length() && ok_; i++) {
+    nodes->at(i)->Accept(this, data);
+  }
+  return NULL;
+}
+
+
+void* RegExpNfaCompiler::VisitAssertion(RegExpAssertion* that, void* data) {
+  Emit(NFA_ASSERT);
+  Emit(that->type());
+  return NULL;
+}
+
+
+void* RegExpNfaCompiler::VisitCharacterClass(RegExpCharacterClass* that,
+                                             void* data) {
+  ZoneList<CharacterRange>* ranges = that->ranges();
+  // As in TextNode::MakeCaseIndependent the standard classes are the same
+  // when ignoring case.
+  if (ignore_case_ && !that->is_standard()) {
+    int range_count = ranges->length();
+    for (int i = 0; i < range_count; i++) {
+      ranges->at(i).AddCaseEquivalents(ranges, false);
+    }
+  }
+  EmitConsume(ranges, that->is_negated());
+  return NULL;
+}
+
+
+void* RegExpNfaCompiler::VisitAtom(RegExpAtom* that, void* data) {
+  Vector<const uc16> chars = that->data();
+  for (int i = 0; i < chars.length() && ok_; i++) {
+    ZoneList<CharacterRange> ranges(2);
+    ranges.Add(CharacterRange::Singleton(chars[i]));
+    if (ignore_case_) {
+      CharacterRange::Singleton(chars[i]).AddCaseEquivalents(&ranges, false);
+    }
+    EmitConsume(&ranges, false);
+  }
+  return NULL;
+}
+
+
+void* RegExpNfaCompiler::VisitQuantifier(RegExpQuantifier* that, void* data) {
+  RegExpTree* body = that->body();
+  int min = that->min();
+  int max = that->max();
+  // A loop whose body can match the empty string has to stop iterating
+  // when an iteration matches nothing, which the program has no way of
+  // expressing.
+  if (that->is_possessive() || (max > min && body->min_match() == 0)) {
+    ok_ = false;
+    return NULL;
+  }
+  NfaOpcode skip = that->is_greedy() ? NFA_FORK : NFA_FORK_JUMP_FIRST;
+  Interval captures = body->CaptureRegisters();
+  for (int i = 0; i < min && ok_; i++) {
+    EmitIteration(body, captures);
+  }
+  if (max == RegExpTree::kInfinity) {
+    int loop = pc();
+    int exit = EmitBranch(skip);
+    EmitIteration(body, captures);
+    Emit(NFA_JUMP);
+    Emit(loop);
+    Patch(exit, pc());
+  } else {
+    ZoneList<int> exits(2);
+    for (int i = min; i < max && ok_; i++) {
+      exits.Add(EmitBranch(skip));
+      EmitIteration(body, captures);
+    }
+    for (int i = 0; i < exits.length(); i++) {
+      Patch(exits[i], pc());
+    }
+  }
+  return NULL;
+}
+
+
+void* RegExpNfaCompiler::VisitCapture(RegExpCapture* that, void* data) {
+  Emit(NFA_SAVE);
+  Emit(RegExpCapture::StartRegister(that->index()));
+  that->body()->Accept(this, data);
+  Emit(NFA_SAVE);
+  Emit(RegExpCapture::EndRegister(that->index()));
+  return NULL;
+}
+
+
+void* RegExpNfaCompiler::VisitLookahead(RegExpLookahead* that, void* data) {
+  ok_ = false;
+  return NULL;
+}
+
+
+void* RegExpNfaCompiler::VisitBackReference(RegExpBackReference* that,
+                                            void* data) {
+  ok_ = false;
+  return NULL;
+}
+
+
+void* RegExpNfaCompiler::VisitEmpty(RegExpEmpty* that, void* data) {
+  return NULL;
+}
+
+
+void* RegExpNfaCompiler::VisitText(RegExpText* that, void* data) {
+  ZoneList<TextElement>* elements = that->elements();
+  for (int i = 0; i < elements->length() && ok_; i++) {
+    TextElement elm = elements->at(i);
+    if (elm.type == TextElement::ATOM) {
+      VisitAtom(elm.data.u_atom, data);
+    } else {
+      ASSERT(elm.type == TextElement::CHAR_CLASS);
+      VisitCharacterClass(elm.data.u_char_class, data);
+    }
+  }
+  return NULL;
+}
+
+
+Handle<ByteArray> RegExpNfa::Compile(RegExpTree* tree,
+                                     int capture_count,
+                                     bool ignore_case) {
+  RegExpNfaCompiler compiler(capture_count, ignore_case);
+  if (!compiler.Compile(tree)) return Handle<ByteArray>::null();
+  Vector<const int> code = compiler.code();
+  Handle<ByteArray> program =
+      Factory::NewByteArray(code.length() * sizeof(int32_t), TENURED);
+  int32_t* words = reinterpret_cast<int32_t*>(program->GetDataStartAddress());
+  for (int i = 0; i < code.length(); i++) words[i] = code[i];
+  return program;
+}
+
+
+static inline bool IsNfaLineTerminator(int c) {
+  return c == '\n' || c == '\r' || c == 0x2028 || c == 0x2029;
+}
+
+
+static inline bool IsNfaWordCharacter(int c) {
+  return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') ||
+      ('0' <= c && c <= '9') || c == '_';
+}
+
+
+// A list of threads in priority order.  Each thread is a program counter
+// and a set of registers.
+class NfaThreadList {
+ public:
+  NfaThreadList(int capacity, int register_count)
+      : pcs_(capacity),
+        registers_(capacity * register_count),
+        register_count_(register_count),
+        length_(0) { }
+
+  int length() { return length_; }
+  int pc(int i) { return pcs_[i]; }
+  int* registers(int i) { return &registers_[i * register_count_]; }
+  void Clear() { length_ = 0; }
+
+  void Add(int pc, int* registers) {
+    pcs_[length_] = pc;
+    memcpy(this->registers(length_), registers, register_count_ * sizeof(int));
+    length_++;
+  }
+
+ private:
+  ScopedVector<int> pcs_;
+  ScopedVector<int> registers_;
+  int register_count_;
+  int length_;
+};
+
+
+template <typename Char>
+class NfaMatcher {
+ public:
+  NfaMatcher(const int32_t* program, int program_length,
+             Vector<const Char> subject)
+      : program_(program),
+        subject_(subject),
+        register_count_(program[kNfaRegisterCountIndex]),
+        first_(program[kNfaThreadCountIndex], register_count_),
+        second_(program[kNfaThreadCountIndex], register_count_),
+        visited_(program_length),
+        scratch_(register_count_),
+        stack_(16) {
+    for (int i = 0; i < program_length; i++) visited_[i] = -1;
+  }
+
+  bool Match(int* captures, int start_position);
+
+ private:
+  bool CheckAssertion(int type, int position);
+  bool CheckRanges(const int32_t* pc, int c);
+  void AddThread(NfaThreadList* list, int pc, int* registers, int position);
+
+  const int32_t* program_;
+  Vector<const Char> subject_;
+  int register_count_;
+  NfaThreadList first_;
+  NfaThreadList second_;
+  // The position for which each instruction was last added to a thread
+  // list, so that only the highest priority thread reaching it is kept.
+  ScopedVector<int> visited_;
+  ScopedVector<int> scratch_;
+  // Work list for AddThread.  Non-negative entries are instructions to
+  // explore, a negative entry -1 - r is followed by the value to restore
+  // register r to.
+  List<int> stack_;
+};
+
+
+template <typename Char>
+bool NfaMatcher<Char>::CheckAssertion(int type, int position) {
+  int length = subject_.length();
+  switch (type) {
+    case RegExpAssertion::START_OF_INPUT:
+      return position == 0;
+    case RegExpAssertion::START_OF_LINE:
+      return position == 0 || IsNfaLineTerminator(subject_[position - 1]);
+    case RegExpAssertion::END_OF_INPUT:
+      return position == length;
+    case RegExpAssertion::END_OF_LINE:
+      return position == length || IsNfaLineTerminator(subject_[position]);
+    case RegExpAssertion::BOUNDARY:
+    case RegExpAssertion::NON_BOUNDARY: {
+      bool before = position > 0 && IsNfaWordCharacter(subject_[position - 1]);
+      bool after = position < length && IsNfaWordCharacter(subject_[position]);
+      return (before != after) == (type == RegExpAssertion::BOUNDARY);
+    }
+  }
+  UNREACHABLE();
+  return false;
+}
+
+
+template <typename Char>
+bool NfaMatcher<Char>::CheckRanges(const int32_t* pc, int c) {
+  bool negated = pc[1] != 0;
+  int count = pc[2];
+  const int32_t* ranges = pc + 3;
+  for (int i = 0; i < count; i++) {
+    if (ranges[2 * i] <= c && c <= ranges[2 * i + 1]) return !negated;
+  }
+  return negated;
+}
+
+
+// Follows the empty transitions from pc in priority order and adds a thread
+// to the list for each CONSUME and MATCH instruction reached.  The registers
+// are restored before returning.
+template <typename Char>
+void NfaMatcher<Char>::AddThread(NfaThreadList* list,
+                                 int pc,
+                                 int* registers,
+                                 int position) {
+  ASSERT(stack_.is_empty());
+  stack_.Add(pc);
+  while (!stack_.is_empty()) {
+    int entry = stack_.RemoveLast();
+    if (entry < 0) {
+      registers[-1 - entry] = stack_.RemoveLast();
+      continue;
+    }
+    if (visited_[entry] == position) continue;
+    visited_[entry] = position;
+    const int32_t* insn = program_ + entry;
+    switch (insn[0]) {
+      case NFA_CONSUME:
+      case NFA_MATCH:
+        list->Add(entry, registers);
+        break;
+      case NFA_ASSERT:
+        if (CheckAssertion(insn[1], position)) stack_.Add(entry + 2);
+        break;
+      case NFA_FORK:
+        stack_.Add(insn[1]);
+        stack_.Add(entry + 2);
+        break;
+      case NFA_FORK_JUMP_FIRST:
+        stack_.Add(entry + 2);
+        stack_.Add(insn[1]);
+        break;
+      case NFA_JUMP:
+        stack_.Add(insn[1]);
+        break;
+      case NFA_SAVE:
+        stack_.Add(registers[insn[1]]);
+        stack_.Add(-1 - insn[1]);
+        registers[insn[1]] = position;
+        stack_.Add(entry + 2);
+        break;
+      case NFA_CLEAR:
+        for (int r = insn[1]; r <= insn[2]; r++) {
+          stack_.Add(registers[r]);
+          stack_.Add(-1 - r);
+          registers[r] = -1;
+        }
+        stack_.Add(entry + 3);
+        break;
+      default:
+        UNREACHABLE();
+    }
+  }
+}
+
+
+template <typename Char>
+bool NfaMatcher<Char>::Match(int* captures, int start_position) {
+  NfaThreadList* current = &first_;
+  NfaThreadList* next = &second_;
+  int length = subject_.length();
+  bool matched = false;
+  for (int position = start_position; ; position++) {
+    // Starting a match here has lower priority than continuing any match
+    // that started earlier.
+    if (!matched) {
+      for (int i = 0; i < register_count_; i++) scratch_[i] = -1;
+      AddThread(current, kNfaHeaderSize, scratch_.start(), position);
+    }
+    if (current->length() == 0) {
+      if (matched || position == length) break;
+      continue;
+    }
+    next->Clear();
+    for (int i = 0; i < current->length(); i++) {
+      int pc = current->pc(i);
+      const int32_t* insn = program_ + pc;
+      if (insn[0] == NFA_MATCH) {
+        // Threads with lower priority than this one can be dropped.
+        memcpy(captures, current->registers(i), register_count_ * sizeof(int));
+        matched = true;
+        break;
+      }
+      ASSERT(insn[0] == NFA_CONSUME);
+      if (position < length && CheckRanges(insn, subject_[position])) {
+        memcpy(scratch_.start(),
+               current->registers(i),
+               register_count_ * sizeof(int));
+        AddThread(next, pc + 3 + 2 * insn[2], scratch_.start(), position + 1);
+      }
+    }
+    if (position == length) break;
+    NfaThreadList* swap = current;
+    current = next;
+    next = swap;
+  }
+  return matched;
+}
+
+
+bool RegExpNfa::Match(Handle<ByteArray> program,
+                      Handle<String> subject,
+                      int* captures,
+                      int start_position) {
+  ASSERT(subject->IsFlat());
+  AssertNoAllocation no_allocation;
+  const int32_t* code =
+      reinterpret_cast<const int32_t*>(program->GetDataStartAddress());
+  int code_length = program->length() / sizeof(int32_t);
+  if (subject->IsAsciiRepresentation()) {
+    NfaMatcher<char> matcher(code, code_length, subject->ToAsciiVector());
+    return matcher.Match(captures, start_position);
+  } else {
+    NfaMatcher<uc16> matcher(code, code_length, subject->ToUC16Vector());
+    return matcher.Match(captures, start_position);
+  }
+}
+
+} }  // namespace v8::internal
@@ -0,0 +1,66 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef V8_REGEXP_NFA_H_
+#define V8_REGEXP_NFA_H_
+
+namespace v8 {
+namespace internal {
+
+
+class RegExpTree;
+
+
+// A regexp matcher that runs in time linear in the length of the subject
+// (times the size of the pattern), used for regexps whose backtracking
+// matches exceed --regexp-backtrack-limit.  The pattern is compiled to a
+// small program for a Pike style NFA simulation that keeps the threads in
+// priority order, so the match and the captures found are the same as the
+// ones found by the backtracking engines.
+//
+// Only patterns without back references, lookaheads, possessive quantifiers
+// and loops whose body can match the empty string are supported.
+class RegExpNfa : public AllStatic {
+ public:
+  // Compiles a parsed pattern.  Returns a null handle if the pattern is not
+  // supported or the program would be too large.
+  static Handle<ByteArray> Compile(RegExpTree* tree,
+                                   int capture_count,
+                                   bool ignore_case);
+
+  // Looks for a match starting at or after start_position.  On success the
+  // (capture_count + 1) * 2 capture registers are stored in captures.
+  static bool Match(Handle<ByteArray> program,
+                    Handle<String> subject,
+                    int* captures,
+                    int start_position);
+};
+
+
+} }  // namespace v8::internal
+
+#endif  // V8_REGEXP_NFA_H_
@@ -32,6 +32,9 @@
 namespace v8 {
 namespace internal {
 
+DEFINE_ISOLATE_COMPONENT(RegExpStack)
+
+
 RegExpStack::RegExpStack() {
   // Initialize, if not already initialized.
   RegExpStack::EnsureCapacity(0);
@@ -45,59 +48,57 @@ RegExpStack::~RegExpStack() {
 
 
 char* RegExpStack::ArchiveStack(char* to) {
-  size_t size = sizeof(thread_local_);
+  size_t size = sizeof(data()->thread_local_);
   memcpy(reinterpret_cast<void*>(to),
-         &thread_local_,
+         &data()->thread_local_,
          size);
-  thread_local_ = ThreadLocal();
+  data()->thread_local_ = ThreadLocal();
   return to + size;
 }
 
 
 char* RegExpStack::RestoreStack(char* from) {
-  size_t size = sizeof(thread_local_);
-  memcpy(&thread_local_, reinterpret_cast<void*>(from), size);
+  size_t size = sizeof(data()->thread_local_);
+  memcpy(&data()->thread_local_, reinterpret_cast<void*>(from), size);
   return from + size;
 }
 
 
 void RegExpStack::Reset() {
-  if (thread_local_.memory_size_ > kMinimumStackSize) {
-    DeleteArray(thread_local_.memory_);
-    thread_local_ = ThreadLocal();
+  if (data()->thread_local_.memory_size_ > kMinimumStackSize) {
+    DeleteArray(data()->thread_local_.memory_);
+    data()->thread_local_ = ThreadLocal();
   }
 }
 
 
 void RegExpStack::ThreadLocal::Free() {
-  if (thread_local_.memory_size_ > 0) {
-    DeleteArray(thread_local_.memory_);
-    thread_local_ = ThreadLocal();
+  if (memory_size_ > 0) {
+    DeleteArray(memory_);
+    *this = ThreadLocal();
   }
 }
 
 
 Address RegExpStack::EnsureCapacity(size_t size) {
+  ThreadLocal* thread_local = &data()->thread_local_;
   if (size > kMaximumStackSize) return NULL;
   if (size < kMinimumStackSize) size = kMinimumStackSize;
-  if (thread_local_.memory_size_ < size) {
+  if (thread_local->memory_size_ < size) {
     Address new_memory = NewArray<byte>(static_cast<int>(size));
-    if (thread_local_.memory_size_ > 0) {
+    if (thread_local->memory_size_ > 0) {
       // Copy original memory into top of new memory.
       memcpy(reinterpret_cast<void*>(
-          new_memory + size - thread_local_.memory_size_),
-             reinterpret_cast<void*>(thread_local_.memory_),
-             thread_local_.memory_size_);
-      DeleteArray(thread_local_.memory_);
+          new_memory + size - thread_local->memory_size_),
+             reinterpret_cast<void*>(thread_local->memory_),
+             thread_local->memory_size_);
+      DeleteArray(thread_local->memory_);
     }
-    thread_local_.memory_ = new_memory;
-    thread_local_.memory_size_ = size;
-    thread_local_.limit_ = new_memory + kStackLimitSlack * kPointerSize;
+    thread_local->memory_ = new_memory;
+    thread_local->memory_size_ = size;
+    thread_local->limit_ = new_memory + kStackLimitSlack * kPointerSize;
   }
-  return thread_local_.memory_ + thread_local_.memory_size_;
+  return thread_local->memory_ + thread_local->memory_size_;
 }
 
-
-RegExpStack::ThreadLocal RegExpStack::thread_local_;
-
 }}  // namespace v8::internal
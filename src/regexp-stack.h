@@ -49,19 +49,19 @@ class RegExpStack {
 
   // Gives the top of the memory used as stack.
   static Address stack_base() {
-    ASSERT(thread_local_.memory_size_ != 0);
-    return thread_local_.memory_ + thread_local_.memory_size_;
+    ASSERT(data()->thread_local_.memory_size_ != 0);
+    return data()->thread_local_.memory_ + data()->thread_local_.memory_size_;
   }
 
   // The total size of the memory allocated for the stack.
-  static size_t stack_capacity() { return thread_local_.memory_size_; }
+  static size_t stack_capacity() { return data()->thread_local_.memory_size_; }
 
   // If the stack pointer gets below the limit, we should react and
   // either grow the stack or report an out-of-stack exception.
   // There is only a limited number of locations below the stack limit,
   // so users of the stack should check the stack limit during any
   // sequence of pushes longer that this.
-  static Address* limit_address() { return &(thread_local_.limit_); }
+  static Address* limit_address() { return &(data()->thread_local_.limit_); }
 
   // Ensures that there is a memory area with at least the specified size.
   // If passing zero, the default/minimum size buffer is allocated.
@@ -69,11 +69,11 @@ class RegExpStack {
 
   // Thread local archiving.
   static int ArchiveSpacePerThread() {
-    return static_cast<int>(sizeof(thread_local_));
+    return static_cast<int>(sizeof(data()->thread_local_));
   }
   static char* ArchiveStack(char* to);
   static char* RestoreStack(char* from);
-  static void FreeThreadResources() { thread_local_.Free(); }
+  static void FreeThreadResources() { data()->thread_local_.Free(); }
 
  private:
   // Artificial limit used when no memory has been allocated.
@@ -100,12 +100,12 @@ class RegExpStack {
 
   // Address of allocated memory.
   static Address memory_address() {
-    return reinterpret_cast<Address>(&thread_local_.memory_);
+    return reinterpret_cast<Address>(&data()->thread_local_.memory_);
   }
 
   // Address of size of allocated memory.
   static Address memory_size_address() {
-    return reinterpret_cast<Address>(&thread_local_.memory_size_);
+    return reinterpret_cast<Address>(&data()->thread_local_.memory_size_);
   }
 
   // Resets the buffer if it has grown beyond the default/minimum size.
@@ -113,9 +113,18 @@ class RegExpStack {
   // you have to call EnsureCapacity before using it again.
   static void Reset();
 
-  static ThreadLocal thread_local_;
+  class Data {
+   public:
+    ThreadLocal thread_local_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kRegExpStackData));
+  }
 
   friend class ExternalReference;
+  friend class Isolate;
 };
 
 }}  // namespace v8::internal
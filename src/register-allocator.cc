@@ -47,9 +47,11 @@ Result::Result(Register reg, TypeInfo info) {
 }
 
 
+DEFINE_ISOLATE_COMPONENT(Result)
+
+
 Result::ZoneObjectList* Result::ConstantList() {
-  static ZoneObjectList list(10);
-  return &list;
+  return &data()->constant_list_;
 }
 
 
@@ -161,7 +161,20 @@ class Result BASE_EMBEDDED {
 
   inline void CopyTo(Result* destination) const;
 
+  class Data {
+   public:
+    Data() : constant_list_(0) { }
+
+    ZoneObjectList constant_list_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kResultData));
+  }
+
   friend class CodeGeneratorScope;
+  friend class Isolate;
 };
 
 
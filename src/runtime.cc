@@ -45,6 +45,7 @@
 #include "runtime.h"
 #include "scopeinfo.h"
 #include "smart-pointer.h"
+#include "string-search.h"
 #include "stub-cache.h"
 #include "v8threads.h"
 
@@ -94,8 +95,17 @@ namespace internal {
   RUNTIME_ASSERT(obj->IsNumber());                                   \
   type name = NumberTo##Type(obj);
 
-// Non-reentrant string buffer for efficient general use in this file.
-static StaticResource<StringInputBuffer> runtime_string_input_buffer;
+class Runtime::Data {
+ public:
+  // Non-reentrant string buffer for efficient general use in this file.
+  StaticResource<StringInputBuffer> string_input_buffer_;
+
+  unibrow::Mapping<unibrow::ToUppercase, 128> to_upper_mapping_;
+  unibrow::Mapping<unibrow::ToLowercase, 128> to_lower_mapping_;
+};
+
+
+DEFINE_ISOLATE_COMPONENT(Runtime)
 
 
 static Object* DeepCopyBoilerplate(JSObject* boilerplate) {
@@ -1649,6 +1659,33 @@ static Object* CharFromCode(Object* char_code) {
 }
 
 
+// Cons strings are flattened to look up a character that is deeper than
+// this in the tree.
+static const int kMaxConsStringGetDepth = 32;
+
+
+// Looks up a character in a cons string without flattening it. Returns
+// false if the character is too deep down the tree.
+static bool ConsStringGetWithoutFlattening(ConsString* cons,
+                                           int index,
+                                           uint16_t* result) {
+  String* string = cons;
+  for (int depth = 0; StringShape(string).IsCons(); depth++) {
+    if (depth == kMaxConsStringGetDepth) return false;
+    ConsString* node = ConsString::cast(string);
+    String* first = node->first();
+    if (index < first->length()) {
+      string = first;
+    } else {
+      index -= first->length();
+      string = node->second();
+    }
+  }
+  *result = string->Get(index);
+  return true;
+}
+
+
 static Object* Runtime_StringCharCodeAt(Arguments args) {
   NoHandleAllocation ha;
   ASSERT(args.length() == 2);
@@ -1668,17 +1705,24 @@ static Object* Runtime_StringCharCodeAt(Arguments args) {
     i = static_cast<uint32_t>(DoubleToInteger(value));
   }
 
+  if (i >= static_cast<uint32_t>(subject->length())) {
+    return Heap::nan_value();
+  }
+
   // Flatten the string.  If someone wants to get a char at an index
   // in a cons string, it is likely that more indices will be
-  // accessed.
+  // accessed, unless the string is only looked at once while it is
+  // being built.
+  if (!subject->ShouldFlatten()) {
+    uint16_t c;
+    if (ConsStringGetWithoutFlattening(ConsString::cast(subject), i, &c)) {
+      return Smi::FromInt(c);
+    }
+  }
   Object* flat = subject->TryFlatten();
   if (flat->IsFailure()) return flat;
   subject = String::cast(flat);
 
-  if (i >= static_cast<uint32_t>(subject->length())) {
-    return Heap::nan_value();
-  }
-
   return Smi::FromInt(subject->Get(i));
 }
 
@@ -2312,253 +2356,6 @@ static Object* Runtime_StringReplaceRegExpWithString(Arguments args) {
 }
 
 
-// Cap on the maximal shift in the Boyer-Moore implementation. By setting a
-// limit, we can fix the size of tables.
-static const int kBMMaxShift = 0xff;
-// Reduce alphabet to this size.
-static const int kBMAlphabetSize = 0x100;
-// For patterns below this length, the skip length of Boyer-Moore is too short
-// to compensate for the algorithmic overhead compared to simple brute force.
-static const int kBMMinPatternLength = 5;
-
-// Holds the two buffers used by Boyer-Moore string search's Good Suffix
-// shift. Only allows the last kBMMaxShift characters of the needle
-// to be indexed.
-class BMGoodSuffixBuffers {
- public:
-  BMGoodSuffixBuffers() {}
-  inline void init(int needle_length) {
-    ASSERT(needle_length > 1);
-    int start = needle_length < kBMMaxShift ? 0 : needle_length - kBMMaxShift;
-    int len = needle_length - start;
-    biased_suffixes_ = suffixes_ - start;
-    biased_good_suffix_shift_ = good_suffix_shift_ - start;
-    for (int i = 0; i <= len; i++) {
-      good_suffix_shift_[i] = len;
-    }
-  }
-  inline int& suffix(int index) {
-    ASSERT(biased_suffixes_ + index >= suffixes_);
-    return biased_suffixes_[index];
-  }
-  inline int& shift(int index) {
-    ASSERT(biased_good_suffix_shift_ + index >= good_suffix_shift_);
-    return biased_good_suffix_shift_[index];
-  }
- private:
-  int suffixes_[kBMMaxShift + 1];
-  int good_suffix_shift_[kBMMaxShift + 1];
-  int* biased_suffixes_;
-  int* biased_good_suffix_shift_;
-  DISALLOW_COPY_AND_ASSIGN(BMGoodSuffixBuffers);
-};
-
-// buffers reused by BoyerMoore
-static int bad_char_occurrence[kBMAlphabetSize];
-static BMGoodSuffixBuffers bmgs_buffers;
-
-// State of the string match tables.
-// SIMPLE: No usable content in the buffers.
-// BOYER_MOORE_HORSPOOL: The bad_char_occurences table has been populated.
-// BOYER_MOORE: The bmgs_buffers tables have also been populated.
-// Whenever starting with a new needle, one should call InitializeStringSearch
-// to determine which search strategy to use, and in the case of a long-needle
-// strategy, the call also initializes the algorithm to SIMPLE.
-enum StringSearchAlgorithm { SIMPLE_SEARCH, BOYER_MOORE_HORSPOOL, BOYER_MOORE };
-static StringSearchAlgorithm algorithm;
-
-
-// Compute the bad-char table for Boyer-Moore in the static buffer.
-template <typename pchar>
-static void BoyerMoorePopulateBadCharTable(Vector<const pchar> pattern) {
-  // Only preprocess at most kBMMaxShift last characters of pattern.
-  int start = pattern.length() < kBMMaxShift ? 0
-                                             : pattern.length() - kBMMaxShift;
-  // Run forwards to populate bad_char_table, so that *last* instance
-  // of character equivalence class is the one registered.
-  // Notice: Doesn't include the last character.
-  int table_size = (sizeof(pchar) == 1) ? String::kMaxAsciiCharCode + 1
-                                        : kBMAlphabetSize;
-  if (start == 0) {  // All patterns less than kBMMaxShift in length.
-    memset(bad_char_occurrence, -1, table_size * sizeof(*bad_char_occurrence));
-  } else {
-    for (int i = 0; i < table_size; i++) {
-      bad_char_occurrence[i] = start - 1;
-    }
-  }
-  for (int i = start; i < pattern.length() - 1; i++) {
-    pchar c = pattern[i];
-    int bucket = (sizeof(pchar) ==1) ? c : c % kBMAlphabetSize;
-    bad_char_occurrence[bucket] = i;
-  }
-}
-
-
-template <typename pchar>
-static void BoyerMoorePopulateGoodSuffixTable(Vector<const pchar> pattern) {
-  int m = pattern.length();
-  int start = m < kBMMaxShift ? 0 : m - kBMMaxShift;
-  int len = m - start;
-  // Compute Good Suffix tables.
-  bmgs_buffers.init(m);
-
-  bmgs_buffers.shift(m-1) = 1;
-  bmgs_buffers.suffix(m) = m + 1;
-  pchar last_char = pattern[m - 1];
-  int suffix = m + 1;
-  for (int i = m; i > start;) {
-    for (pchar c = pattern[i - 1]; suffix <= m && c != pattern[suffix - 1];) {
-      if (bmgs_buffers.shift(suffix) == len) {
-        bmgs_buffers.shift(suffix) = suffix - i;
-      }
-      suffix = bmgs_buffers.suffix(suffix);
-    }
-    i--;
-    suffix--;
-    bmgs_buffers.suffix(i) = suffix;
-    if (suffix == m) {
-      // No suffix to extend, so we check against last_char only.
-      while (i > start && pattern[i - 1] != last_char) {
-        if (bmgs_buffers.shift(m) == len) {
-          bmgs_buffers.shift(m) = m - i;
-        }
-        i--;
-        bmgs_buffers.suffix(i) = m;
-      }
-      if (i > start) {
-        i--;
-        suffix--;
-        bmgs_buffers.suffix(i) = suffix;
-      }
-    }
-  }
-  if (suffix < m) {
-    for (int i = start; i <= m; i++) {
-      if (bmgs_buffers.shift(i) == len) {
-        bmgs_buffers.shift(i) = suffix - start;
-      }
-      if (i == suffix) {
-        suffix = bmgs_buffers.suffix(suffix);
-      }
-    }
-  }
-}
-
-
-template <typename schar, typename pchar>
-static inline int CharOccurrence(int char_code) {
-  if (sizeof(schar) == 1) {
-    return bad_char_occurrence[char_code];
-  }
-  if (sizeof(pchar) == 1) {
-    if (char_code > String::kMaxAsciiCharCode) {
-      return -1;
-    }
-    return bad_char_occurrence[char_code];
-  }
-  return bad_char_occurrence[char_code % kBMAlphabetSize];
-}
-
-
-// Restricted simplified Boyer-Moore string matching.
-// Uses only the bad-shift table of Boyer-Moore and only uses it
-// for the character compared to the last character of the needle.
-template <typename schar, typename pchar>
-static int BoyerMooreHorspool(Vector<const schar> subject,
-                              Vector<const pchar> pattern,
-                              int start_index,
-                              bool* complete) {
-  ASSERT(algorithm <= BOYER_MOORE_HORSPOOL);
-  int n = subject.length();
-  int m = pattern.length();
-
-  int badness = -m;
-
-  // How bad we are doing without a good-suffix table.
-  int idx;  // No matches found prior to this index.
-  pchar last_char = pattern[m - 1];
-  int last_char_shift = m - 1 - CharOccurrence<schar, pchar>(last_char);
-  // Perform search
-  for (idx = start_index; idx <= n - m;) {
-    int j = m - 1;
-    int c;
-    while (last_char != (c = subject[idx + j])) {
-      int bc_occ = CharOccurrence<schar, pchar>(c);
-      int shift = j - bc_occ;
-      idx += shift;
-      badness += 1 - shift;  // at most zero, so badness cannot increase.
-      if (idx > n - m) {
-        *complete = true;
-        return -1;
-      }
-    }
-    j--;
-    while (j >= 0 && pattern[j] == (subject[idx + j])) j--;
-    if (j < 0) {
-      *complete = true;
-      return idx;
-    } else {
-      idx += last_char_shift;
-      // Badness increases by the number of characters we have
-      // checked, and decreases by the number of characters we
-      // can skip by shifting. It's a measure of how we are doing
-      // compared to reading each character exactly once.
-      badness += (m - j) - last_char_shift;
-      if (badness > 0) {
-        *complete = false;
-        return idx;
-      }
-    }
-  }
-  *complete = true;
-  return -1;
-}
-
-
-template <typename schar, typename pchar>
-static int BoyerMooreIndexOf(Vector<const schar> subject,
-                             Vector<const pchar> pattern,
-                             int idx) {
-  ASSERT(algorithm <= BOYER_MOORE);
-  int n = subject.length();
-  int m = pattern.length();
-  // Only preprocess at most kBMMaxShift last characters of pattern.
-  int start = m < kBMMaxShift ? 0 : m - kBMMaxShift;
-
-  pchar last_char = pattern[m - 1];
-  // Continue search from i.
-  while (idx <= n - m) {
-    int j = m - 1;
-    schar c;
-    while (last_char != (c = subject[idx + j])) {
-      int shift = j - CharOccurrence<schar, pchar>(c);
-      idx += shift;
-      if (idx > n - m) {
-        return -1;
-      }
-    }
-    while (j >= 0 && pattern[j] == (c = subject[idx + j])) j--;
-    if (j < 0) {
-      return idx;
-    } else if (j < start) {
-      // we have matched more than our tables allow us to be smart about.
-      // Fall back on BMH shift.
-      idx += m - 1 - CharOccurrence<schar, pchar>(last_char);
-    } else {
-      int gs_shift = bmgs_buffers.shift(j + 1);       // Good suffix shift.
-      int bc_occ = CharOccurrence<schar, pchar>(c);
-      int shift = j - bc_occ;                         // Bad-char shift.
-      if (gs_shift > shift) {
-        shift = gs_shift;
-      }
-      idx += shift;
-    }
-  }
-
-  return -1;
-}
-
-
 template <typename schar>
 static inline int SingleCharIndexOf(Vector<const schar> string,
                                     schar pattern_char,
@@ -2593,168 +2390,117 @@ static int SingleCharLastIndexOf(Vector<const schar> string,
 }
 
 
-// Trivial string search for shorter strings.
-// On return, if "complete" is set to true, the return value is the
-// final result of searching for the patter in the subject.
-// If "complete" is set to false, the return value is the index where
-// further checking should start, i.e., it's guaranteed that the pattern
-// does not occur at a position prior to the returned index.
-template <typename pchar, typename schar>
-static int SimpleIndexOf(Vector<const schar> subject,
-                         Vector<const pchar> pattern,
-                         int idx,
-                         bool* complete) {
-  // Badness is a count of how much work we have done.  When we have
-  // done enough work we decide it's probably worth switching to a better
-  // algorithm.
-  int badness = -10 - (pattern.length() << 2);
-
-  // We know our pattern is at least 2 characters, we cache the first so
-  // the common case of the first character not matching is faster.
-  pchar pattern_first_char = pattern[0];
-  for (int i = idx, n = subject.length() - pattern.length(); i <= n; i++) {
-    badness++;
-    if (badness > 0) {
-      *complete = false;
-      return i;
-    }
-    if (sizeof(schar) == 1 && sizeof(pchar) == 1) {
-      const schar* pos = reinterpret_cast<const schar*>(
-          memchr(subject.start() + i,
-                 pattern_first_char,
-                 n - i + 1));
-      if (pos == NULL) {
-        *complete = true;
-        return -1;
-      }
-      i = static_cast<int>(pos - subject.start());
-    } else {
-      if (subject[i] != pattern_first_char) continue;
-    }
-    int j = 1;
-    do {
-      if (pattern[j] != subject[i+j]) {
-        break;
-      }
-      j++;
-    } while (j < pattern.length());
-    if (j == pattern.length()) {
-      *complete = true;
-      return i;
-    }
-    badness += j;
-  }
-  *complete = true;
-  return -1;
-}
+// Patterns up to this length are searched for in cons string subjects
+// without flattening them.
+static const int kMaxConsStringSearchPatternLength = 16;
 
-// Simple indexOf that never bails out. For short patterns only.
-template <typename pchar, typename schar>
-static int SimpleIndexOf(Vector<const schar> subject,
-                         Vector<const pchar> pattern,
-                         int idx) {
-  pchar pattern_first_char = pattern[0];
-  for (int i = idx, n = subject.length() - pattern.length(); i <= n; i++) {
-    if (sizeof(schar) == 1 && sizeof(pchar) == 1) {
-      const schar* pos = reinterpret_cast<const schar*>(
-          memchr(subject.start() + i,
-                 pattern_first_char,
-                 n - i + 1));
-      if (pos == NULL) return -1;
-      i = static_cast<int>(pos - subject.start());
-    } else {
-      if (subject[i] != pattern_first_char) continue;
-    }
+// Number of candidate matches spanning several leaves of a cons string
+// after which the search gives up and the subject is flattened.
+static const int kMaxConsStringSearchSpanningChecks = 64;
+
+
+// Returns the index of the first match of the pattern in the leaf, starting
+// at or after from and not after last, or of the first position where the
+// first character of the pattern matches and the match would extend past
+// the end of the leaf. Returns -1 if there is no such position.
+template <typename schar, typename pchar>
+static int ConsStringLeafIndexOf(Vector<const schar> leaf,
+                                 Vector<const pchar> pat,
+                                 int from,
+                                 int last) {
+  pchar pattern_first_char = pat[0];
+  int leaf_length = leaf.length();
+  int pattern_length = pat.length();
+  for (int i = from; i <= last; i++) {
+    if (leaf[i] != pattern_first_char) continue;
+    if (i + pattern_length > leaf_length) return i;
     int j = 1;
-    do {
-      if (pattern[j] != subject[i+j]) {
-        break;
-      }
-      j++;
-    } while (j < pattern.length());
-    if (j == pattern.length()) {
-      return i;
-    }
+    while (j < pattern_length && pat[j] == leaf[i + j]) j++;
+    if (j == pattern_length) return i;
   }
   return -1;
 }
 
 
-// Strategy for searching for a string in another string.
-enum StringSearchStrategy { SEARCH_FAIL, SEARCH_SHORT, SEARCH_LONG };
+// A part of a cons string that starts at the given offset in the subject.
+struct ConsStringPart {
+  String* string;
+  int offset;
+};
 
 
+// Searches a cons string without flattening it, by visiting the flat
+// strings at the leaves of the tree from start_index on.  Matches that span
+// several leaves are checked by reading the subject with a
+// StringCharacterStream.  Returns false if there are too many of those, in
+// which case the subject should be flattened and searched instead.
 template <typename pchar>
-static inline StringSearchStrategy InitializeStringSearch(
-    Vector<const pchar> pat, bool ascii_subject) {
-  ASSERT(pat.length() > 1);
-  // We have an ASCII haystack and a non-ASCII needle. Check if there
-  // really is a non-ASCII character in the needle and bail out if there
-  // is.
-  if (ascii_subject && sizeof(pchar) > 1) {
-    for (int i = 0; i < pat.length(); i++) {
-      uc16 c = pat[i];
-      if (c > String::kMaxAsciiCharCode) {
-        return SEARCH_FAIL;
+static bool ConsStringMatch(String* sub,
+                            Vector<const pchar> pat,
+                            int start_index,
+                            int* result) {
+  int pattern_length = pat.length();
+  int last_index = sub->length() - pattern_length;
+  int spanning_checks = 0;
+  // Second parts of cons strings that are still to be visited.
+  List<ConsStringPart> pending(4);
+  String* string = sub;
+  int offset = 0;
+  int from = start_index;
+  while (true) {
+    while (StringShape(string).IsCons()) {
+      ConsString* cons = ConsString::cast(string);
+      int split = offset + cons->first()->length();
+      if (from < split) {
+        ConsStringPart second = { cons->second(), split };
+        pending.Add(second);
+        string = cons->first();
+      } else {
+        string = cons->second();
+        offset = split;
       }
     }
+    // Search the leaf, which holds the characters from offset on.
+    int leaf_last = Min(last_index, offset + string->length() - 1) - offset;
+    int index = from - offset;
+    while (index <= leaf_last) {
+      if (string->IsAsciiRepresentation()) {
+        index = ConsStringLeafIndexOf(string->ToAsciiVector(),
+                                      pat,
+                                      index,
+                                      leaf_last);
+      } else {
+        index = ConsStringLeafIndexOf(string->ToUC16Vector(),
+                                      pat,
+                                      index,
+                                      leaf_last);
+      }
+      if (index == -1) break;
+      if (index + pattern_length <= string->length()) {
+        *result = offset + index;
+        return true;
+      }
+      if (++spanning_checks > kMaxConsStringSearchSpanningChecks) {
+        return false;
+      }
+      StringCharacterStream stream(sub, offset + index);
+      int j = 0;
+      while (j < pattern_length && stream.GetNext() == pat[j]) j++;
+      if (j == pattern_length) {
+        *result = offset + index;
+        return true;
+      }
+      index++;
+    }
+    if (offset + string->length() > last_index || pending.is_empty()) {
+      *result = -1;
+      return true;
+    }
+    ConsStringPart next = pending.RemoveLast();
+    string = next.string;
+    offset = next.offset;
+    from = offset;
   }
-  if (pat.length() < kBMMinPatternLength) {
-    return SEARCH_SHORT;
-  }
-  algorithm = SIMPLE_SEARCH;
-  return SEARCH_LONG;
-}
-
-
-// Dispatch long needle searches to different algorithms.
-template <typename schar, typename pchar>
-static int ComplexIndexOf(Vector<const schar> sub,
-                          Vector<const pchar> pat,
-                          int start_index) {
-  ASSERT(pat.length() >= kBMMinPatternLength);
-  // Try algorithms in order of increasing setup cost and expected performance.
-  bool complete;
-  int idx = start_index;
-  switch (algorithm) {
-    case SIMPLE_SEARCH:
-      idx = SimpleIndexOf(sub, pat, idx, &complete);
-      if (complete) return idx;
-      BoyerMoorePopulateBadCharTable(pat);
-      algorithm = BOYER_MOORE_HORSPOOL;
-      // FALLTHROUGH.
-    case BOYER_MOORE_HORSPOOL:
-      idx = BoyerMooreHorspool(sub, pat, idx, &complete);
-      if (complete) return idx;
-      // Build the Good Suffix table and continue searching.
-      BoyerMoorePopulateGoodSuffixTable(pat);
-      algorithm = BOYER_MOORE;
-      // FALLTHROUGH.
-    case BOYER_MOORE:
-      return BoyerMooreIndexOf(sub, pat, idx);
-  }
-  UNREACHABLE();
-  return -1;
-}
-
-
-// Dispatch to different search strategies for a single search.
-// If searching multiple times on the same needle, the search
-// strategy should only be computed once and then dispatch to different
-// loops.
-template <typename schar, typename pchar>
-static int StringSearch(Vector<const schar> sub,
-                        Vector<const pchar> pat,
-                        int start_index) {
-  bool ascii_subject = (sizeof(schar) == 1);
-  StringSearchStrategy strategy = InitializeStringSearch(pat, ascii_subject);
-  switch (strategy) {
-    case SEARCH_FAIL: return -1;
-    case SEARCH_SHORT: return SimpleIndexOf(sub, pat, start_index);
-    case SEARCH_LONG: return ComplexIndexOf(sub, pat, start_index);
-  }
-  UNREACHABLE();
-  return -1;
 }
 
 
@@ -2773,6 +2519,19 @@ int Runtime::StringMatch(Handle<String> sub,
   int subject_length = sub->length();
   if (start_index + pattern_length > subject_length) return -1;
 
+  if (pattern_length <= kMaxConsStringSearchPatternLength &&
+      !sub->ShouldFlatten()) {
+    if (!pat->IsFlat()) {
+      FlattenString(pat);
+    }
+    AssertNoAllocation no_heap_allocation;  // ensure vectors stay valid
+    int position;
+    bool done = pat->IsAsciiRepresentation()
+        ? ConsStringMatch(*sub, pat->ToAsciiVector(), start_index, &position)
+        : ConsStringMatch(*sub, pat->ToUC16Vector(), start_index, &position);
+    if (done) return position;
+  }
+
   if (!sub->IsFlat()) {
     FlattenString(sub);
   }
@@ -2810,15 +2569,15 @@ int Runtime::StringMatch(Handle<String> sub,
   if (pat->IsAsciiRepresentation()) {
     Vector<const char> pat_vector = pat->ToAsciiVector();
     if (sub->IsAsciiRepresentation()) {
-      return StringSearch(sub->ToAsciiVector(), pat_vector, start_index);
+      return SearchString(sub->ToAsciiVector(), pat_vector, start_index);
     }
-    return StringSearch(sub->ToUC16Vector(), pat_vector, start_index);
+    return SearchString(sub->ToUC16Vector(), pat_vector, start_index);
   }
   Vector<const uc16> pat_vector = pat->ToUC16Vector();
   if (sub->IsAsciiRepresentation()) {
-    return StringSearch(sub->ToAsciiVector(), pat_vector, start_index);
+    return SearchString(sub->ToAsciiVector(), pat_vector, start_index);
   }
-  return StringSearch(sub->ToUC16Vector(), pat_vector, start_index);
+  return SearchString(sub->ToUC16Vector(), pat_vector, start_index);
 }
 
 
@@ -2978,18 +2737,15 @@ static Object* Runtime_StringLocaleCompare(Arguments args) {
   int d = str1->Get(0) - str2->Get(0);
   if (d != 0) return Smi::FromInt(d);
 
-  str1->TryFlatten();
-  str2->TryFlatten();
-
-  static StringInputBuffer buf1;
-  static StringInputBuffer buf2;
+  if (str1->ShouldFlatten()) str1->TryFlatten();
+  if (str2->ShouldFlatten()) str2->TryFlatten();
 
-  buf1.Reset(str1);
-  buf2.Reset(str2);
+  StringCharacterStream stream1(str1);
+  StringCharacterStream stream2(str2);
 
   for (int i = 0; i < end; i++) {
-    uint16_t char1 = buf1.GetNext();
-    uint16_t char2 = buf2.GetNext();
+    uint16_t char1 = stream1.GetNext();
+    uint16_t char2 = stream2.GetNext();
     if (char1 != char2) return Smi::FromInt(char1 - char2);
   }
 
@@ -3024,6 +2780,129 @@ static Object* Runtime_SubString(Arguments args) {
 }
 
 
+// Two smis before and after the match, for very long strings.
+const int kMaxBuilderEntriesPerRegExpMatch = 5;
+
+
+static void SetLastMatchInfoNoCaptures(Handle<String> subject,
+                                       Handle<JSArray> last_match_info,
+                                       int match_start,
+                                       int match_end) {
+  // Fill last_match_info with a single capture.
+  last_match_info->EnsureSize(2 + RegExpImpl::kLastMatchOverhead);
+  AssertNoAllocation no_gc;
+  FixedArray* elements = FixedArray::cast(last_match_info->elements());
+  RegExpImpl::SetLastCaptureCount(elements, 2);
+  RegExpImpl::SetLastInput(elements, *subject);
+  RegExpImpl::SetLastSubject(elements, *subject);
+  RegExpImpl::SetCapture(elements, 0, match_start);
+  RegExpImpl::SetCapture(elements, 1, match_end);
+}
+
+
+// Fill last_match_info with the match and the captures in registers.
+static void SetLastMatchInfo(Handle<String> subject,
+                             Handle<JSArray> last_match_info,
+                             Vector<int> registers) {
+  int capture_register_count = registers.length();
+  last_match_info->EnsureSize(capture_register_count +
+                              RegExpImpl::kLastMatchOverhead);
+  AssertNoAllocation no_gc;
+  FixedArray* elements = FixedArray::cast(last_match_info->elements());
+  RegExpImpl::SetLastCaptureCount(elements, capture_register_count);
+  RegExpImpl::SetLastSubject(elements, *subject);
+  RegExpImpl::SetLastInput(elements, *subject);
+  for (int i = 0; i < capture_register_count; i++) {
+    RegExpImpl::SetCapture(elements, i, registers[i]);
+  }
+}
+
+
+// Prepares a regexp of either type for being executed repeatedly on the
+// flat subject with ExecRegExpOnce.  Returns the number of registers
+// needed, or a negative value if compiling the regexp threw an exception.
+static int PrepareRegExp(Handle<JSRegExp> regexp, Handle<String> subject) {
+  ASSERT(subject->IsFlat());
+  if (regexp->TypeTag() == JSRegExp::ATOM) return 2;
+  ASSERT_EQ(regexp->TypeTag(), JSRegExp::IRREGEXP);
+  return RegExpImpl::IrregexpPrepare(regexp, subject);
+}
+
+
+// Executes the regexp once from index without touching the last match
+// info.  On success the offsets of the match and its captures are stored
+// in the first registers.
+static RegExpImpl::IrregexpResult ExecRegExpOnce(Handle<JSRegExp> regexp,
+                                                 Handle<String> subject,
+                                                 int index,
+                                                 Vector<int> registers) {
+  if (regexp->TypeTag() == JSRegExp::ATOM) {
+    Handle<String> pattern(
+        String::cast(regexp->DataAt(JSRegExp::kAtomPatternIndex)));
+    int position = Runtime::StringMatch(subject, pattern, index);
+    if (position < 0) return RegExpImpl::RE_FAILURE;
+    registers[0] = position;
+    registers[1] = position + pattern->length();
+    return RegExpImpl::RE_SUCCESS;
+  }
+  return RegExpImpl::IrregexpExecOnce(regexp, subject, index, registers);
+}
+
+
+// Looks up the results of splitting or matching the subject in the results
+// cache.  On a hit the last match info is updated from the cache and the
+// value for the runtime function to return is returned: null, or a new array
+// with a copy of the cached results.  Returns a null handle on a miss.
+static Handle<Object> LookupResultsCache(
+    Handle<String> subject,
+    Handle<Object> key,
+    RegExpResultsCache::ResultsCacheType type,
+    Handle<JSArray> last_match_info) {
+  Object* cached_last_match;
+  Object* cached = RegExpResultsCache::Lookup(*subject,
+                                              *key,
+                                              type,
+                                              &cached_last_match);
+  if (cached->IsUndefined()) return Handle<Object>::null();
+  if (cached->IsNull()) return Factory::null_value();
+  Handle<FixedArray> results(FixedArray::cast(cached));
+  if (cached_last_match->IsFixedArray()) {
+    Handle<FixedArray> registers(FixedArray::cast(cached_last_match));
+    last_match_info->EnsureSize(registers->length() +
+                                RegExpImpl::kLastMatchOverhead);
+    AssertNoAllocation no_gc;
+    FixedArray* elements = FixedArray::cast(last_match_info->elements());
+    RegExpImpl::SetLastCaptureCount(elements, registers->length());
+    RegExpImpl::SetLastSubject(elements, *subject);
+    RegExpImpl::SetLastInput(elements, *subject);
+    for (int i = 0; i < registers->length(); i++) {
+      RegExpImpl::SetCapture(elements, i, Smi::cast(registers->get(i))->value());
+    }
+  }
+  return Factory::NewJSArrayWithElements(Factory::CopyFixedArray(results));
+}
+
+
+// Enters the results (null or a fixed array that is not handed out) and the
+// capture offsets of the last match, if any, into the results cache.
+static void EnterResultsCache(Handle<String> subject,
+                              Handle<Object> key,
+                              RegExpResultsCache::ResultsCacheType type,
+                              Handle<Object> results,
+                              Vector<int> last_match) {
+  if (!subject->IsSymbol()) return;
+  Handle<Object> registers = Factory::undefined_value();
+  if (last_match.length() > 0) {
+    Handle<FixedArray> array = Factory::NewFixedArray(last_match.length());
+    for (int i = 0; i < last_match.length(); i++) {
+      array->set(i, Smi::FromInt(last_match[i]));
+    }
+    registers = array;
+  }
+  RegExpResultsCache::Enter(*subject, *key, type, *results, *registers);
+}
+
+
 static Object* Runtime_StringMatch(Arguments args) {
   ASSERT_EQ(3, args.length());
 
@@ -3032,66 +2911,178 @@ static Object* Runtime_StringMatch(Arguments args) {
   CONVERT_ARG_CHECKED(JSArray, regexp_info, 2);
   HandleScope handles;
 
-  Handle<Object> match = RegExpImpl::Exec(regexp, subject, 0, regexp_info);
+  Handle<Object> key(regexp->data());
+  Handle<Object> cached = LookupResultsCache(subject,
+                                             key,
+                                             RegExpResultsCache::STRING_MATCH,
+                                             regexp_info);
+  if (!cached.is_null()) return *cached;
 
-  if (match.is_null()) {
-    return Failure::Exception();
-  }
-  if (match->IsNull()) {
-    return Heap::null_value();
-  }
+  if (!subject->IsFlat()) FlattenString(subject);
+  int required_registers = PrepareRegExp(regexp, subject);
+  if (required_registers < 0) return Failure::Exception();
+
+  // Run the regexp over the whole subject, collecting the match offsets,
+  // and only update the last match info for the last match.
+  OffsetsVector registers(required_registers);
+  Vector<int> register_vector(registers.vector(), registers.length());
+  ScopedVector<int> last_match((regexp->CaptureCount() + 1) * 2);
   int length = subject->length();
 
   CompilationZoneScope zone_space(DELETE_ON_EXIT);
   ZoneList<int> offsets(8);
+  int index = 0;
   do {
-    int start;
-    int end;
-    {
-      AssertNoAllocation no_alloc;
-      FixedArray* elements = FixedArray::cast(regexp_info->elements());
-      start = Smi::cast(elements->get(RegExpImpl::kFirstCapture))->value();
-      end = Smi::cast(elements->get(RegExpImpl::kFirstCapture + 1))->value();
-    }
+    RegExpImpl::IrregexpResult result =
+        ExecRegExpOnce(regexp, subject, index, register_vector);
+    if (result == RegExpImpl::RE_EXCEPTION) return Failure::Exception();
+    if (result == RegExpImpl::RE_FAILURE) break;
+    int start = register_vector[0];
+    int end = register_vector[1];
     offsets.Add(start);
     offsets.Add(end);
-    int index = start < end ? end : end + 1;
-    if (index > length) break;
-    match = RegExpImpl::Exec(regexp, subject, index, regexp_info);
-    if (match.is_null()) {
-      return Failure::Exception();
-    }
-  } while (!match->IsNull());
+    for (int i = 0; i < last_match.length(); i++) {
+      last_match[i] = register_vector[i];
+    }
+    index = start < end ? end : end + 1;
+  } while (index <= length);
+
+  if (offsets.is_empty()) {
+    EnterResultsCache(subject,
+                      key,
+                      RegExpResultsCache::STRING_MATCH,
+                      Factory::null_value(),
+                      Vector<int>::empty());
+    return Heap::null_value();
+  }
+  SetLastMatchInfo(subject, regexp_info, last_match);
+
   int matches = offsets.length() / 2;
   Handle<FixedArray> elements = Factory::NewFixedArray(matches);
   for (int i = 0; i < matches ; i++) {
+    HandleScope loop_scope;
     int from = offsets.at(i * 2);
     int to = offsets.at(i * 2 + 1);
-    elements->set(i, *Factory::NewSubString(subject, from, to));
+    Handle<String> substring = Factory::NewSubString(subject, from, to);
+    elements->set(i, *substring);
   }
+  EnterResultsCache(subject,
+                    key,
+                    RegExpResultsCache::STRING_MATCH,
+                    elements,
+                    last_match);
+  if (subject->IsSymbol()) elements = Factory::CopyFixedArray(elements);
   Handle<JSArray> result = Factory::NewJSArrayWithElements(elements);
   result->set_length(Smi::FromInt(matches));
   return *result;
 }
 
 
-// Two smis before and after the match, for very long strings.
-const int kMaxBuilderEntriesPerRegExpMatch = 5;
+// Splits the non-empty subject at the matches of the regexp, see ECMA-262
+// section 15.5.4.14.  Returns null if the regexp does not match at all, in
+// which case the last match info is left untouched.
+static Object* Runtime_StringSplitRegExp(Arguments args) {
+  ASSERT_EQ(4, args.length());
 
+  CONVERT_ARG_CHECKED(String, subject, 0);
+  CONVERT_ARG_CHECKED(JSRegExp, regexp, 1);
+  CONVERT_NUMBER_CHECKED(uint32_t, limit, Uint32, args[2]);
+  CONVERT_ARG_CHECKED(JSArray, last_match_info, 3);
+  HandleScope handles;
+  RUNTIME_ASSERT(limit > 0);
 
-static void SetLastMatchInfoNoCaptures(Handle<String> subject,
-                                       Handle<JSArray> last_match_info,
-                                       int match_start,
-                                       int match_end) {
-  // Fill last_match_info with a single capture.
-  last_match_info->EnsureSize(2 + RegExpImpl::kLastMatchOverhead);
-  AssertNoAllocation no_gc;
-  FixedArray* elements = FixedArray::cast(last_match_info->elements());
-  RegExpImpl::SetLastCaptureCount(elements, 2);
-  RegExpImpl::SetLastInput(elements, *subject);
-  RegExpImpl::SetLastSubject(elements, *subject);
-  RegExpImpl::SetCapture(elements, 0, match_start);
-  RegExpImpl::SetCapture(elements, 1, match_end);
+  // Only results without a limit are cached.
+  bool use_cache = limit == 0xffffffffu;
+  Handle<Object> key(regexp->data());
+  if (use_cache) {
+    Handle<Object> cached = LookupResultsCache(subject,
+                                               key,
+                                               RegExpResultsCache::STRING_SPLIT,
+                                               last_match_info);
+    if (!cached.is_null()) return *cached;
+  }
+
+  if (!subject->IsFlat()) FlattenString(subject);
+  int length = subject->length();
+  RUNTIME_ASSERT(length > 0);
+  int required_registers = PrepareRegExp(regexp, subject);
+  if (required_registers < 0) return Failure::Exception();
+
+  int capture_count = regexp->CaptureCount();
+  OffsetsVector registers(required_registers);
+  Vector<int> register_vector(registers.vector(), registers.length());
+  ScopedVector<int> last_match((capture_count + 1) * 2);
+  bool has_match = false;
+
+  FixedArrayBuilder builder(16);
+  bool limit_reached = false;
+  int current_index = 0;
+  int start_index = 0;
+  while (start_index < length) {
+    RegExpImpl::IrregexpResult result =
+        ExecRegExpOnce(regexp, subject, start_index, register_vector);
+    if (result == RegExpImpl::RE_EXCEPTION) return Failure::Exception();
+    if (result == RegExpImpl::RE_FAILURE) break;
+    for (int i = 0; i < last_match.length(); i++) {
+      last_match[i] = register_vector[i];
+    }
+    has_match = true;
+
+    int match_start = register_vector[0];
+    int match_end = register_vector[1];
+    // A match at the end of the subject does not split it.
+    if (match_start == length) break;
+    // Zero length matches at the current index are ignored.
+    if (start_index == match_end && match_end == current_index) {
+      start_index++;
+      continue;
+    }
+
+    builder.EnsureCapacity(1 + capture_count);
+    HandleScope loop_scope;
+    builder.Add(*Factory::NewSubString(subject, current_index, match_start));
+    limit_reached = static_cast<uint32_t>(builder.length()) == limit;
+    for (int i = 1; i <= capture_count && !limit_reached; i++) {
+      int start = register_vector[i * 2];
+      int end = register_vector[i * 2 + 1];
+      if (start >= 0 && end >= 0) {
+        builder.Add(*Factory::NewSubString(subject, start, end));
+      } else {
+        builder.Add(Heap::undefined_value());
+      }
+      limit_reached = static_cast<uint32_t>(builder.length()) == limit;
+    }
+    if (limit_reached) break;
+
+    start_index = current_index = match_end;
+  }
+
+  if (!has_match) {
+    if (use_cache) {
+      EnterResultsCache(subject,
+                        key,
+                        RegExpResultsCache::STRING_SPLIT,
+                        Factory::null_value(),
+                        Vector<int>::empty());
+    }
+    return Heap::null_value();
+  }
+  if (!limit_reached) {
+    builder.EnsureCapacity(1);
+    builder.Add(*Factory::NewSubString(subject, current_index, length));
+  }
+  SetLastMatchInfo(subject, last_match_info, last_match);
+  if (use_cache && subject->IsSymbol()) {
+    Handle<FixedArray> results =
+        Factory::NewFixedArray(builder.length());
+    builder.array()->CopyTo(0, *results, 0, builder.length());
+    EnterResultsCache(subject,
+                      key,
+                      RegExpResultsCache::STRING_SPLIT,
+                      results,
+                      last_match);
+  }
+  return *builder.ToJSArray();
 }
 
 
@@ -3178,65 +3169,36 @@ static bool SearchCharMultiple(Handle<String> subject,
 
 
 template <typename schar, typename pchar>
-static bool SearchStringMultiple(Vector<schar> subject,
-                                 String* pattern,
-                                 Vector<pchar> pattern_string,
-                                 FixedArrayBuilder* builder,
-                                 int* match_pos) {
-  int pos = *match_pos;
-  int subject_length = subject.length();
-  int pattern_length = pattern_string.length();
-  int max_search_start = subject_length - pattern_length;
-  bool is_ascii = (sizeof(schar) == 1);
-  StringSearchStrategy strategy =
-      InitializeStringSearch(pattern_string, is_ascii);
-  switch (strategy) {
-    case SEARCH_FAIL: break;
-    case SEARCH_SHORT:
-      while (pos <= max_search_start) {
-        if (!builder->HasCapacity(kMaxBuilderEntriesPerRegExpMatch)) {
-          *match_pos = pos;
-          return false;
-        }
-        // Position of end of previous match.
-        int match_end = pos + pattern_length;
-        int new_pos = SimpleIndexOf(subject, pattern_string, match_end);
-        if (new_pos >= 0) {
-          // A match.
-          if (new_pos > match_end) {
-            ReplacementStringBuilder::AddSubjectSlice(builder,
-                                                      match_end,
-                                                      new_pos);
-          }
-          pos = new_pos;
-          builder->Add(pattern);
-        } else {
-          break;
-        }
-      }
-      break;
-    case SEARCH_LONG:
-      while (pos  <= max_search_start) {
-        if (!builder->HasCapacity(kMaxBuilderEntriesPerRegExpMatch)) {
-          *match_pos = pos;
-          return false;
-        }
-        int match_end = pos + pattern_length;
-        int new_pos = ComplexIndexOf(subject, pattern_string, match_end);
-        if (new_pos >= 0) {
-          // A match has been found.
-          if (new_pos > match_end) {
-            ReplacementStringBuilder::AddSubjectSlice(builder,
-                                                      match_end,
-                                                      new_pos);
-          }
-          pos = new_pos;
-          builder->Add(pattern);
-        } else {
-         break;
-        }
+static bool SearchStringMultiple(Vector<const schar> subject,
+                                 String* pattern,
+                                 Vector<const pchar> pattern_string,
+                                 FixedArrayBuilder* builder,
+                                 int* match_pos) {
+  int pos = *match_pos;
+  int subject_length = subject.length();
+  int pattern_length = pattern_string.length();
+  int max_search_start = subject_length - pattern_length;
+  StringSearch<pchar, schar> search(pattern_string);
+  while (pos <= max_search_start) {
+    if (!builder->HasCapacity(kMaxBuilderEntriesPerRegExpMatch)) {
+      *match_pos = pos;
+      return false;
+    }
+    // Position of end of previous match.
+    int match_end = pos + pattern_length;
+    int new_pos = search.Search(subject, match_end);
+    if (new_pos >= 0) {
+      // A match.
+      if (new_pos > match_end) {
+        ReplacementStringBuilder::AddSubjectSlice(builder,
+                                                  match_end,
+                                                  new_pos);
       }
+      pos = new_pos;
+      builder->Add(pattern);
+    } else {
       break;
+    }
   }
   if (pos < max_search_start) {
     ReplacementStringBuilder::AddSubjectSlice(builder,
@@ -4674,7 +4636,7 @@ static Object* Runtime_URIEscape(Arguments args) {
   int escaped_length = 0;
   int length = source->length();
   {
-    Access<StringInputBuffer> buffer(&runtime_string_input_buffer);
+    Access<StringInputBuffer> buffer(&Runtime::data()->string_input_buffer_);
     buffer->Reset(source);
     while (buffer->has_more()) {
       uint16_t character = buffer->GetNext();
@@ -4702,7 +4664,7 @@ static Object* Runtime_URIEscape(Arguments args) {
   String* destination = String::cast(o);
   int dest_position = 0;
 
-  Access<StringInputBuffer> buffer(&runtime_string_input_buffer);
+  Access<StringInputBuffer> buffer(&Runtime::data()->string_input_buffer_);
   buffer->Rewind();
   while (buffer->has_more()) {
     uint16_t chr = buffer->GetNext();
@@ -4843,10 +4805,6 @@ static Object* Runtime_StringParseFloat(Arguments args) {
 }
 
 
-static unibrow::Mapping<unibrow::ToUppercase, 128> to_upper_mapping;
-static unibrow::Mapping<unibrow::ToLowercase, 128> to_lower_mapping;
-
-
 template <class Converter>
 static Object* ConvertCaseHelper(String* s,
                                  int length,
@@ -4872,7 +4830,7 @@ static Object* ConvertCaseHelper(String* s,
 
   // Convert all characters to upper case, assuming that they will fit
   // in the buffer
-  Access<StringInputBuffer> buffer(&runtime_string_input_buffer);
+  Access<StringInputBuffer> buffer(&Runtime::data()->string_input_buffer_);
   buffer->Reset(s);
   unibrow::uchar chars[Converter::kMaxWidth];
   // We can assume that the string is not empty
@@ -4946,32 +4904,87 @@ static Object* ConvertCaseHelper(String* s,
 }
 
 
-static inline SeqAsciiString* TryGetSeqAsciiString(String* s) {
-  if (!s->IsFlat() || !s->IsAsciiRepresentation()) return NULL;
-  if (s->IsConsString()) {
-    ASSERT(ConsString::cast(s)->second()->length() == 0);
-    return SeqAsciiString::cast(ConsString::cast(s)->first());
+namespace {
+
+static const uintptr_t kOneInEveryByte = static_cast<uintptr_t>(-1) / 0xFF;
+
+
+// Returns a word that has the high bit set in every byte of w that is
+// strictly between m and n, and all other bits cleared.  All the bytes of
+// w must be ASCII, and 0 < m < n < 0x7F.  No byte can carry or borrow into
+// its neighbour since both sums below stay within 0..0xFF for every byte.
+static inline uintptr_t AsciiRangeMask(uintptr_t w, char m, char n) {
+  ASSERT((w & (kOneInEveryByte * 0x80)) == 0);
+  ASSERT(0 < m && m < n && n < 0x7F);
+  // The high bit is set in every byte that is less than n.
+  uintptr_t below_n = kOneInEveryByte * (0x7F + n) - w;
+  // The high bit is set in every byte that is greater than m.
+  uintptr_t above_m = w + kOneInEveryByte * (0x7F - m);
+  return below_n & above_m & (kOneInEveryByte * 0x80);
+}
+
+
+// Flips the case of the ASCII letters from first to last, copying src to
+// dst.  Returns whether any character was changed.  Aligned strings are
+// converted a word at a time.
+template <char first, char last>
+static bool ConvertAsciiCase(char* dst, const char* src, int length) {
+  // Upper and lower case ASCII letters only differ in this bit.
+  static const char kCaseBit = 'a' - 'A';
+  static const int kStepSize = sizeof(uintptr_t);  // NOLINT
+  bool changed = false;
+  int i = 0;
+  uintptr_t address_bits =
+      reinterpret_cast<uintptr_t>(dst) | reinterpret_cast<uintptr_t>(src);
+  if ((address_bits & (kStepSize - 1)) == 0) {
+    uintptr_t changed_bytes = 0;
+    for (; i <= length - kStepSize; i += kStepSize) {
+      uintptr_t w = *reinterpret_cast<const uintptr_t*>(src + i);
+      uintptr_t mask = AsciiRangeMask(w, first - 1, last + 1);
+      // Move the high bit of every byte to convert down to the case bit.
+      ASSERT((kOneInEveryByte * 0x80) >> 2 == kOneInEveryByte * kCaseBit);
+      *reinterpret_cast<uintptr_t*>(dst + i) = w ^ (mask >> 2);
+      changed_bytes |= mask;
+    }
+    changed = (changed_bytes != 0);
+  }
+  for (; i < length; i++) {
+    char c = src[i];
+    if (first <= c && c <= last) {
+      c ^= kCaseBit;
+      changed = true;
+    }
+    dst[i] = c;
+  }
+  return changed;
+}
+
+
+// Like ConvertAsciiCase, but for a two-byte string all of whose characters
+// are known to be ASCII.
+template <char first, char last>
+static bool ConvertAsciiCase(char* dst, const uc16* src, int length) {
+  static const char kCaseBit = 'a' - 'A';
+  bool changed = false;
+  for (int i = 0; i < length; i++) {
+    ASSERT(src[i] <= String::kMaxAsciiCharCode);
+    char c = static_cast<char>(src[i]);
+    if (first <= c && c <= last) {
+      c ^= kCaseBit;
+      changed = true;
+    }
+    dst[i] = c;
   }
-  return SeqAsciiString::cast(s);
+  return changed;
 }
 
 
-namespace {
-
 struct ToLowerTraits {
   typedef unibrow::ToLowercase UnibrowConverter;
 
-  static bool ConvertAscii(char* dst, char* src, int length) {
-    bool changed = false;
-    for (int i = 0; i < length; ++i) {
-      char c = src[i];
-      if ('A' <= c && c <= 'Z') {
-        c += ('a' - 'A');
-        changed = true;
-      }
-      dst[i] = c;
-    }
-    return changed;
+  template <typename Char>
+  static bool ConvertAscii(char* dst, const Char* src, int length) {
+    return ConvertAsciiCase<'A', 'Z'>(dst, src, length);
   }
 };
 
@@ -4979,23 +4992,23 @@ struct ToLowerTraits {
 struct ToUpperTraits {
   typedef unibrow::ToUppercase UnibrowConverter;
 
-  static bool ConvertAscii(char* dst, char* src, int length) {
-    bool changed = false;
-    for (int i = 0; i < length; ++i) {
-      char c = src[i];
-      if ('a' <= c && c <= 'z') {
-        c -= ('a' - 'A');
-        changed = true;
-      }
-      dst[i] = c;
-    }
-    return changed;
+  template <typename Char>
+  static bool ConvertAscii(char* dst, const Char* src, int length) {
+    return ConvertAsciiCase<'a', 'z'>(dst, src, length);
   }
 };
 
 }  // namespace
 
 
+// Returns whether all the characters of a two-byte vector are ASCII.
+static bool IsAsciiOnly(Vector<const uc16> chars) {
+  uc16 bits = 0;
+  for (int i = 0; i < chars.length(); i++) bits |= chars[i];
+  return bits <= String::kMaxAsciiCharCode;
+}
+
+
 template <typename ConvertTraits>
 static Object* ConvertCase(
     Arguments args,
@@ -5014,13 +5027,23 @@ static Object* ConvertCase(
   // character is also ascii.  This is currently the case, but it
   // might break in the future if we implement more context and locale
   // dependent upper/lower conversions.
-  SeqAsciiString* seq_ascii = TryGetSeqAsciiString(s);
-  if (seq_ascii != NULL) {
+  if (s->IsFlat() && s->IsAsciiRepresentation()) {
+    Object* o = Heap::AllocateRawAsciiString(length);
+    if (o->IsFailure()) return o;
+    SeqAsciiString* result = SeqAsciiString::cast(o);
+    bool has_changed_character = ConvertTraits::ConvertAscii(
+        result->GetChars(), s->ToAsciiVector().start(), length);
+    return has_changed_character ? result : s;
+  }
+
+  // Two-byte strings that only contain ASCII characters are converted the
+  // same way.  The result, if any, is an ASCII string.
+  if (s->IsFlat() && IsAsciiOnly(s->ToUC16Vector())) {
     Object* o = Heap::AllocateRawAsciiString(length);
     if (o->IsFailure()) return o;
     SeqAsciiString* result = SeqAsciiString::cast(o);
     bool has_changed_character = ConvertTraits::ConvertAscii(
-        result->GetChars(), seq_ascii->GetChars(), length);
+        result->GetChars(), s->ToUC16Vector().start(), length);
     return has_changed_character ? result : s;
   }
 
@@ -5034,20 +5057,44 @@ static Object* ConvertCase(
 
 
 static Object* Runtime_StringToLowerCase(Arguments args) {
-  return ConvertCase<ToLowerTraits>(args, &to_lower_mapping);
+  return ConvertCase<ToLowerTraits>(args, &Runtime::data()->to_lower_mapping_);
 }
 
 
 static Object* Runtime_StringToUpperCase(Arguments args) {
-  return ConvertCase<ToUpperTraits>(args, &to_upper_mapping);
+  return ConvertCase<ToUpperTraits>(args, &Runtime::data()->to_upper_mapping_);
 }
 
 
 static inline bool IsTrimWhiteSpace(unibrow::uchar c) {
+  // Check the ASCII white space characters without consulting unibrow.
+  if (c <= String::kMaxAsciiCharCode) {
+    return c == ' ' || ('\t' <= c && c <= '\r');
+  }
   return unibrow::WhiteSpace::Is(c) || c == 0x200b;
 }
 
 
+template <typename Char>
+static inline void TrimFlatString(Vector<const Char> chars,
+                                  bool trim_left,
+                                  bool trim_right,
+                                  int* left,
+                                  int* right) {
+  int length = chars.length();
+  int l = 0;
+  if (trim_left) {
+    while (l < length && IsTrimWhiteSpace(chars[l])) l++;
+  }
+  int r = length;
+  if (trim_right) {
+    while (r > l && IsTrimWhiteSpace(chars[r - 1])) r--;
+  }
+  *left = l;
+  *right = r;
+}
+
+
 static Object* Runtime_StringTrim(Arguments args) {
   NoHandleAllocation ha;
   ASSERT(args.length() == 3);
@@ -5060,17 +5107,22 @@ static Object* Runtime_StringTrim(Arguments args) {
   int length = s->length();
 
   int left = 0;
-  if (trimLeft) {
-    while (left < length && IsTrimWhiteSpace(s->Get(left))) {
-      left++;
-    }
-  }
-
   int right = length;
-  if (trimRight) {
-    while (right > left && IsTrimWhiteSpace(s->Get(right - 1))) {
-      right--;
+  if (!s->IsFlat()) {
+    if (trimLeft) {
+      while (left < length && IsTrimWhiteSpace(s->Get(left))) {
+        left++;
+      }
+    }
+    if (trimRight) {
+      while (right > left && IsTrimWhiteSpace(s->Get(right - 1))) {
+        right--;
+      }
     }
+  } else if (s->IsAsciiRepresentation()) {
+    TrimFlatString(s->ToAsciiVector(), trimLeft, trimRight, &left, &right);
+  } else {
+    TrimFlatString(s->ToUC16Vector(), trimLeft, trimRight, &left, &right);
   }
   return s->SubString(left, right);
 }
@@ -5084,37 +5136,15 @@ void FindStringIndices(Vector<const schar> subject,
   ASSERT(limit > 0);
   // Collect indices of pattern in subject, and the end-of-string index.
   // Stop after finding at most limit values.
-  StringSearchStrategy strategy =
-      InitializeStringSearch(pattern, sizeof(schar) == 1);
-  switch (strategy) {
-    case SEARCH_FAIL: return;
-    case SEARCH_SHORT: {
-      int pattern_length = pattern.length();
-      int index = 0;
-      while (limit > 0) {
-        index = SimpleIndexOf(subject, pattern, index);
-        if (index < 0) return;
-        indices->Add(index);
-        index += pattern_length;
-        limit--;
-      }
-      return;
-    }
-    case SEARCH_LONG: {
-      int pattern_length = pattern.length();
-      int index = 0;
-      while (limit > 0) {
-        index = ComplexIndexOf(subject, pattern, index);
-        if (index < 0) return;
-        indices->Add(index);
-        index += pattern_length;
-        limit--;
-      }
-      return;
-    }
-    default:
-      UNREACHABLE();
-      return;
+  StringSearch<pchar, schar> search(pattern);
+  int pattern_length = pattern.length();
+  int index = 0;
+  while (limit > 0) {
+    index = search.Search(subject, index);
+    if (index < 0) return;
+    indices->Add(index);
+    index += pattern_length;
+    limit--;
   }
 }
 
@@ -5147,6 +5177,16 @@ static Object* Runtime_StringSplit(Arguments args) {
   int pattern_length = pattern->length();
   RUNTIME_ASSERT(pattern_length > 0);
 
+  // Only results without a limit are cached, and only for symbol patterns.
+  bool use_cache = limit == 0xffffffffu && pattern->IsSymbol();
+  if (use_cache) {
+    Handle<Object> cached = LookupResultsCache(subject,
+                                               pattern,
+                                               RegExpResultsCache::STRING_SPLIT,
+                                               Handle<JSArray>::null());
+    if (!cached.is_null()) return *cached;
+  }
+
   // The limit can be very large (0xffffffffu), but since the pattern
   // isn't empty, we can never create more parts than ~half the length
   // of the subject.
@@ -5219,22 +5259,28 @@ static Object* Runtime_StringSplit(Arguments args) {
 
   ASSERT(result->HasFastElements());
 
+  Handle<FixedArray> elements(FixedArray::cast(result->elements()));
   if (part_count == 1 && indices.at(0) == subject_length) {
-    FixedArray::cast(result->elements())->set(0, *subject);
-    return *result;
+    elements->set(0, *subject);
+  } else {
+    int part_start = 0;
+    for (int i = 0; i < part_count; i++) {
+      HandleScope local_loop_handle;
+      int part_end = indices.at(i);
+      Handle<String> substring =
+          Factory::NewSubString(subject, part_start, part_end);
+      elements->set(i, *substring);
+      part_start = part_end + pattern_length;
+    }
   }
 
-  Handle<FixedArray> elements(FixedArray::cast(result->elements()));
-  int part_start = 0;
-  for (int i = 0; i < part_count; i++) {
-    HandleScope local_loop_handle;
-    int part_end = indices.at(i);
-    Handle<String> substring =
-        Factory::NewSubString(subject, part_start, part_end);
-    elements->set(i, *substring);
-    part_start = part_end + pattern_length;
+  if (use_cache && subject->IsSymbol()) {
+    EnterResultsCache(subject,
+                      pattern,
+                      RegExpResultsCache::STRING_SPLIT,
+                      Factory::CopyFixedArray(elements),
+                      Vector<int>::empty());
   }
-
   return *result;
 }
 
@@ -5316,7 +5362,7 @@ static Object* Runtime_StringToArray(Arguments args) {
 
 bool Runtime::IsUpperCaseChar(uint16_t ch) {
   unibrow::uchar chars[unibrow::ToUppercase::kMaxWidth];
-  int char_length = to_upper_mapping.get(ch, 0, chars);
+  int char_length = data()->to_upper_mapping_.get(ch, 0, chars);
   return char_length == 0;
 }
 
@@ -5643,6 +5689,158 @@ static Object* Runtime_StringBuilderConcat(Arguments args) {
 }
 
 
+template <typename sinkchar>
+static inline void StringBuilderJoinHelper(FixedArray* elements,
+                                           int array_length,
+                                           String* separator,
+                                           sinkchar* sink) {
+  int separator_length = separator->length();
+  String* first = String::cast(elements->get(0));
+  int position = first->length();
+  String::WriteToFlat(first, sink, 0, position);
+  for (int i = 1; i < array_length; i++) {
+    if (separator_length > 0) {
+      String::WriteToFlat(separator, sink + position, 0, separator_length);
+      position += separator_length;
+    }
+    String* element = String::cast(elements->get(i));
+    int element_length = element->length();
+    String::WriteToFlat(element, sink + position, 0, element_length);
+    position += element_length;
+  }
+}
+
+
+// Joins the elements of an array of strings with a separator, writing them
+// straight into the result.  Returns undefined if the array is not in fast
+// mode or has holes or elements that are not strings, in which case the
+// caller has to convert the elements itself.
+static Object* Runtime_StringBuilderJoin(Arguments args) {
+  NoHandleAllocation ha;
+  ASSERT(args.length() == 3);
+  CONVERT_CHECKED(JSArray, array, args[0]);
+  CONVERT_CHECKED(String, separator, args[2]);
+  if (!args[1]->IsSmi() || !array->HasFastElements()) {
+    return Heap::undefined_value();
+  }
+  int array_length = Smi::cast(args[1])->value();
+  FixedArray* elements = FixedArray::cast(array->elements());
+  if (array_length < 0 || elements->length() < array_length) {
+    return Heap::undefined_value();
+  }
+  if (array_length == 0) return Heap::empty_string();
+
+  int separator_length = separator->length();
+  bool ascii = separator->IsAsciiRepresentation();
+  int length = 0;
+  for (int i = 0; i < array_length; i++) {
+    Object* element = elements->get(i);
+    if (!element->IsString()) return Heap::undefined_value();
+    String* string = String::cast(element);
+    int increment = string->length();
+    if (i > 0) {
+      if (separator_length > String::kMaxLength - length) {
+        Top::context()->mark_out_of_memory();
+        return Failure::OutOfMemoryException();
+      }
+      length += separator_length;
+    }
+    if (increment > String::kMaxLength - length) {
+      Top::context()->mark_out_of_memory();
+      return Failure::OutOfMemoryException();
+    }
+    length += increment;
+    if (ascii && !string->IsAsciiRepresentation()) ascii = false;
+  }
+  if (array_length == 1) return elements->get(0);
+
+  Object* object;
+  if (ascii) {
+    object = Heap::AllocateRawAsciiString(length);
+    if (object->IsFailure()) return object;
+    SeqAsciiString* answer = SeqAsciiString::cast(object);
+    StringBuilderJoinHelper(elements,
+                            array_length,
+                            separator,
+                            answer->GetChars());
+    return answer;
+  } else {
+    object = Heap::AllocateRawTwoByteString(length);
+    if (object->IsFailure()) return object;
+    SeqTwoByteString* answer = SeqTwoByteString::cast(object);
+    StringBuilderJoinHelper(elements,
+                            array_length,
+                            separator,
+                            answer->GetChars());
+    return answer;
+  }
+}
+
+
+template <typename sinkchar>
+static inline void StringReplaceRangeHelper(String* subject,
+                                            int start,
+                                            int end,
+                                            String* replacement,
+                                            sinkchar* sink) {
+  int replacement_length = replacement->length();
+  String::WriteToFlat(subject, sink, 0, start);
+  String::WriteToFlat(replacement, sink + start, 0, replacement_length);
+  String::WriteToFlat(subject,
+                      sink + start + replacement_length,
+                      end,
+                      subject->length());
+}
+
+
+// Replaces the characters in [start, end) of the subject, writing the
+// prefix, the replacement and the suffix straight into the result.  Used
+// by the replace paths that make a single replacement, which do not need
+// to collect parts in a ReplaceResultBuilder.
+static Object* Runtime_StringReplaceRange(Arguments args) {
+  NoHandleAllocation ha;
+  ASSERT(args.length() == 4);
+  CONVERT_CHECKED(String, subject, args[0]);
+  CONVERT_SMI_CHECKED(start, args[1]);
+  CONVERT_SMI_CHECKED(end, args[2]);
+  CONVERT_CHECKED(String, replacement, args[3]);
+  int subject_length = subject->length();
+  RUNTIME_ASSERT(0 <= start && start <= end && end <= subject_length);
+
+  int kept_length = subject_length - (end - start);
+  if (replacement->length() > String::kMaxLength - kept_length) {
+    Top::context()->mark_out_of_memory();
+    return Failure::OutOfMemoryException();
+  }
+  int length = kept_length + replacement->length();
+  if (length == 0) return Heap::empty_string();
+
+  Object* object;
+  if (subject->IsAsciiRepresentation() &&
+      replacement->IsAsciiRepresentation()) {
+    object = Heap::AllocateRawAsciiString(length);
+    if (object->IsFailure()) return object;
+    SeqAsciiString* answer = SeqAsciiString::cast(object);
+    StringReplaceRangeHelper(subject,
+                             start,
+                             end,
+                             replacement,
+                             answer->GetChars());
+    return answer;
+  } else {
+    object = Heap::AllocateRawTwoByteString(length);
+    if (object->IsFailure()) return object;
+    SeqTwoByteString* answer = SeqTwoByteString::cast(object);
+    StringReplaceRangeHelper(subject,
+                             start,
+                             end,
+                             replacement,
+                             answer->GetChars());
+    return answer;
+  }
+}
+
+
 static Object* Runtime_NumberOr(Arguments args) {
   NoHandleAllocation ha;
   ASSERT(args.length() == 2);
@@ -5770,8 +5968,8 @@ static Object* Runtime_SmiLexicographicCompare(Arguments args) {
 
   // Arrays for the individual characters of the two Smis.  Smis are
   // 31 bit integers and 10 decimal digits are therefore enough.
-  static int x_elms[10];
-  static int y_elms[10];
+  int x_elms[10];
+  int y_elms[10];
 
   // Extract the integer values from the Smis.
   CONVERT_CHECKED(Smi, x, args[0]);
@@ -5822,21 +6020,19 @@ static Object* Runtime_SmiLexicographicCompare(Arguments args) {
 }
 
 
-static Object* StringInputBufferCompare(String* x, String* y) {
-  static StringInputBuffer bufx;
-  static StringInputBuffer bufy;
-  bufx.Reset(x);
-  bufy.Reset(y);
-  while (bufx.has_more() && bufy.has_more()) {
-    int d = bufx.GetNext() - bufy.GetNext();
+static Object* StringCharacterStreamCompare(String* x, String* y) {
+  StringCharacterStream streamx(x);
+  StringCharacterStream streamy(y);
+  while (streamx.has_more() && streamy.has_more()) {
+    int d = streamx.GetNext() - streamy.GetNext();
     if (d < 0) return Smi::FromInt(LESS);
     else if (d > 0) return Smi::FromInt(GREATER);
   }
 
   // x is (non-trivial) prefix of y:
-  if (bufy.has_more()) return Smi::FromInt(LESS);
+  if (streamy.has_more()) return Smi::FromInt(LESS);
   // y is prefix of x:
-  return Smi::FromInt(bufx.has_more() ? GREATER : EQUAL);
+  return Smi::FromInt(streamx.has_more() ? GREATER : EQUAL);
 }
 
 
@@ -5877,7 +6073,7 @@ static Object* FlatStringCompare(String* x, String* y) {
   } else {
     result = (r < 0) ? Smi::FromInt(LESS) : Smi::FromInt(GREATER);
   }
-  ASSERT(result == StringInputBufferCompare(x, y));
+  ASSERT(result == StringCharacterStreamCompare(x, y));
   return result;
 }
 
@@ -5904,13 +6100,19 @@ static Object* Runtime_StringCompare(Arguments args) {
   if (d < 0) return Smi::FromInt(LESS);
   else if (d > 0) return Smi::FromInt(GREATER);
 
+  // Cons strings that are compared once are read without flattening them,
+  // which also saves copying the characters after the first difference.
+  bool flatten_x = x->ShouldFlatten();
+  bool flatten_y = y->ShouldFlatten();
+  if (!flatten_x || !flatten_y) return StringCharacterStreamCompare(x, y);
+
   Object* obj = Heap::PrepareForCompare(x);
   if (obj->IsFailure()) return obj;
   obj = Heap::PrepareForCompare(y);
   if (obj->IsFailure()) return obj;
 
   return (x->IsFlat() && y->IsFlat()) ? FlatStringCompare(x, y)
-                                      : StringInputBufferCompare(x, y);
+                                      : StringCharacterStreamCompare(x, y);
 }
 
 
@@ -7264,6 +7466,440 @@ static Object* Runtime_CompileString(Arguments args) {
 }
 
 
+static Object* Runtime_ParseJson(Arguments args) {
+  HandleScope scope;
+  ASSERT_EQ(1, args.length());
+  CONVERT_ARG_CHECKED(String, source, 0);
+
+  Handle<Object> result = JsonParser::Parse(source);
+  if (result.is_null()) return Failure::Exception();
+  return *result;
+}
+
+
+// Serializes values to JSON text for JSON.stringify (ECMA-262 5th edition,
+// section 15.12.3) when no replacer is given.  Only values whose
+// serialization cannot run JavaScript code are handled: primitives, plain
+// objects without accessors and arrays with fast elements.  For anything
+// else, for instance objects with a toJSON method, the serializer bails
+// out and JSON.stringify falls back to the implementation in json.js.
+// The object graph is walked without allocating on the JavaScript heap,
+// so raw pointers can be used throughout and nothing has to be undone
+// when bailing out.
+class JsonStringifier {
+ public:
+  enum Result { SUCCESS, UNDEFINED, BAILOUT };
+
+  explicit JsonStringifier(Vector<const char> gap)
+      : gap_(gap),
+        buffer_(256),
+        stack_(8),
+        property_order_(8),
+        flat_buffer_(0) { }
+
+  // Append the serialization of the value to the output.  Returns
+  // UNDEFINED if the value does not have a serialization and nothing
+  // was appended.
+  Result Serialize(Object* value);
+
+  // Append a quoted and escaped string to the output.
+  void SerializeString(String* string);
+
+  Vector<const char> output() { return buffer_.ToConstVector(); }
+
+ private:
+  struct PropertyPosition {
+    int enumeration_index;
+    int position;
+  };
+
+  Result SerializeArray(JSArray* array);
+  Result SerializeObject(JSObject* object);
+  Result SerializeProperty(String* key, Object* value, bool* is_first);
+  Result SerializeElement(uint32_t index, Object* value, bool* is_first);
+  void SerializeNumber(double value);
+
+  // Collect the enumerable properties of a fast mode object or a dictionary
+  // in enumeration order.  Returns false if an accessor or another kind of
+  // property that cannot be serialized here is found.
+  bool CollectDescriptors(DescriptorArray* descriptors);
+  bool CollectDictionaryEntries(StringDictionary* dictionary);
+  static int ComparePropertyPositions(const PropertyPosition* a,
+                                      const PropertyPosition* b);
+  void SortPropertyPositions(int start);
+
+  template <typename Char>
+  void SerializeChars(Vector<const Char> chars);
+
+  bool Push(JSObject* object);
+  void Pop() { stack_.RemoveLast(); }
+  void NewLine();
+
+  void Add(char c) { buffer_.Add(c); }
+  void Add(const char* str) {
+    while (*str != '\0') buffer_.Add(*str++);
+  }
+
+  Vector<const char> gap_;
+  List<char> buffer_;
+  List<JSObject*> stack_;
+  List<PropertyPosition> property_order_;
+  List<uc16> flat_buffer_;
+};
+
+
+JsonStringifier::Result JsonStringifier::Serialize(Object* value) {
+  if (value->IsSmi()) {
+    char chars[16];
+    Vector<char> buffer(chars, ARRAY_SIZE(chars));
+    Add(IntToCString(Smi::cast(value)->value(), buffer));
+    return SUCCESS;
+  }
+  if (value->IsHeapNumber()) {
+    SerializeNumber(HeapNumber::cast(value)->value());
+    return SUCCESS;
+  }
+  if (value->IsString()) {
+    SerializeString(String::cast(value));
+    return SUCCESS;
+  }
+  if (value->IsOddball()) {
+    if (value->IsTrue()) {
+      Add("true");
+    } else if (value->IsFalse()) {
+      Add("false");
+    } else if (value->IsNull()) {
+      Add("null");
+    } else {
+      return UNDEFINED;
+    }
+    return SUCCESS;
+  }
+  if (value->IsJSFunction()) return UNDEFINED;
+  if (value->IsJSArray()) return SerializeArray(JSArray::cast(value));
+  if (HeapObject::cast(value)->map()->instance_type() == JS_OBJECT_TYPE) {
+    return SerializeObject(JSObject::cast(value));
+  }
+  return BAILOUT;
+}
+
+
+JsonStringifier::Result JsonStringifier::SerializeArray(JSArray* array) {
+  if (!array->HasFastElements() || !array->length()->IsSmi()) return BAILOUT;
+  // As for objects, a toJSON method on the array or in its prototype chain
+  // is left to the JavaScript implementation.
+  LookupResult lookup;
+  array->Lookup(Heap::to_json_symbol(), &lookup);
+  if (lookup.IsProperty()) return BAILOUT;
+  if (!Push(array)) return BAILOUT;
+  FixedArray* elements = FixedArray::cast(array->elements());
+  int length = Smi::cast(array->length())->value();
+  Add('[');
+  for (int i = 0; i < length; i++) {
+    if (i > 0) Add(',');
+    NewLine();
+    Object* element = elements->get(i);
+    // Holes would have to be looked up in the prototype chain.
+    if (element->IsTheHole()) return BAILOUT;
+    Result result = Serialize(element);
+    if (result == BAILOUT) return BAILOUT;
+    if (result == UNDEFINED) Add("null");
+  }
+  Pop();
+  if (length > 0) NewLine();
+  Add(']');
+  return SUCCESS;
+}
+
+
+JsonStringifier::Result JsonStringifier::SerializeObject(JSObject* object) {
+  Map* map = object->map();
+  if (map->is_access_check_needed() ||
+      map->has_named_interceptor() ||
+      map->has_indexed_interceptor() ||
+      map->has_instance_call_handler()) {
+    return BAILOUT;
+  }
+  // A toJSON method anywhere in the prototype chain has to be called, which
+  // is left to the JavaScript implementation.
+  LookupResult lookup;
+  object->Lookup(Heap::to_json_symbol(), &lookup);
+  if (lookup.IsProperty()) return BAILOUT;
+  if (!object->HasFastElements()) return BAILOUT;
+  if (!Push(object)) return BAILOUT;
+
+  Add('{');
+  bool is_first = true;
+  // Elements are enumerated first, in index order.
+  FixedArray* elements = FixedArray::cast(object->elements());
+  for (int i = 0; i < elements->length(); i++) {
+    Object* element = elements->get(i);
+    if (element->IsTheHole()) continue;
+    if (SerializeElement(i, element, &is_first) == BAILOUT) return BAILOUT;
+  }
+
+  // Named properties are enumerated in the order they were added.  The
+  // order is recorded in property_order_, which is shared with nested
+  // objects, so the positions for this object start at order_start.
+  int order_start = property_order_.length();
+  if (object->HasFastProperties()) {
+    DescriptorArray* descriptors = map->instance_descriptors();
+    if (!CollectDescriptors(descriptors)) return BAILOUT;
+    int order_end = property_order_.length();
+    for (int i = order_start; i < order_end; i++) {
+      int descriptor = property_order_[i].position;
+      Object* value;
+      if (descriptors->GetType(descriptor) == FIELD) {
+        value = object->FastPropertyAt(descriptors->GetFieldIndex(descriptor));
+      } else {
+        ASSERT_EQ(CONSTANT_FUNCTION, descriptors->GetType(descriptor));
+        value = descriptors->GetConstantFunction(descriptor);
+      }
+      Result result =
+          SerializeProperty(descriptors->GetKey(descriptor), value, &is_first);
+      if (result == BAILOUT) return BAILOUT;
+    }
+  } else {
+    StringDictionary* dictionary = object->property_dictionary();
+    if (!CollectDictionaryEntries(dictionary)) return BAILOUT;
+    int order_end = property_order_.length();
+    for (int i = order_start; i < order_end; i++) {
+      int entry = property_order_[i].position;
+      Result result = SerializeProperty(String::cast(dictionary->KeyAt(entry)),
+                                        dictionary->ValueAt(entry),
+                                        &is_first);
+      if (result == BAILOUT) return BAILOUT;
+    }
+  }
+  property_order_.Rewind(order_start);
+
+  Pop();
+  if (!is_first) NewLine();
+  Add('}');
+  return SUCCESS;
+}
+
+
+JsonStringifier::Result JsonStringifier::SerializeProperty(String* key,
+                                                           Object* value,
+                                                           bool* is_first) {
+  int mark = buffer_.length();
+  if (!*is_first) Add(',');
+  NewLine();
+  SerializeString(key);
+  Add(':');
+  if (!gap_.is_empty()) Add(' ');
+  Result result = Serialize(value);
+  if (result == UNDEFINED) {
+    // Properties without a serialization are left out.
+    buffer_.Rewind(mark);
+    return UNDEFINED;
+  }
+  if (result == SUCCESS) *is_first = false;
+  return result;
+}
+
+
+JsonStringifier::Result JsonStringifier::SerializeElement(uint32_t index,
+                                                          Object* value,
+                                                          bool* is_first) {
+  int mark = buffer_.length();
+  if (!*is_first) Add(',');
+  NewLine();
+  char chars[16];
+  Vector<char> buffer(chars, ARRAY_SIZE(chars));
+  Add('"');
+  Add(IntToCString(index, buffer));
+  Add("\":");
+  if (!gap_.is_empty()) Add(' ');
+  Result result = Serialize(value);
+  if (result == UNDEFINED) {
+    buffer_.Rewind(mark);
+    return UNDEFINED;
+  }
+  if (result == SUCCESS) *is_first = false;
+  return result;
+}
+
+
+bool JsonStringifier::CollectDescriptors(DescriptorArray* descriptors) {
+  int start = property_order_.length();
+  for (int i = 0; i < descriptors->number_of_descriptors(); i++) {
+    PropertyDetails details(descriptors->GetDetails(i));
+    switch (details.type()) {
+      case FIELD:
+      case CONSTANT_FUNCTION:
+        if (!details.IsDontEnum()) {
+          PropertyPosition position = { details.index(), i };
+          property_order_.Add(position);
+        }
+        break;
+      case MAP_TRANSITION:
+      case CONSTANT_TRANSITION:
+      case NULL_DESCRIPTOR:
+        break;
+      default:
+        return false;
+    }
+  }
+  SortPropertyPositions(start);
+  return true;
+}
+
+
+bool JsonStringifier::CollectDictionaryEntries(StringDictionary* dictionary) {
+  int start = property_order_.length();
+  int capacity = dictionary->Capacity();
+  for (int i = 0; i < capacity; i++) {
+    Object* key = dictionary->KeyAt(i);
+    if (!dictionary->IsKey(key)) continue;
+    PropertyDetails details = dictionary->DetailsAt(i);
+    if (details.type() != NORMAL) return false;
+    if (details.IsDontEnum()) continue;
+    PropertyPosition position = { details.index(), i };
+    property_order_.Add(position);
+  }
+  SortPropertyPositions(start);
+  return true;
+}
+
+
+int JsonStringifier::ComparePropertyPositions(const PropertyPosition* a,
+                                              const PropertyPosition* b) {
+  return a->enumeration_index - b->enumeration_index;
+}
+
+
+void JsonStringifier::SortPropertyPositions(int start) {
+  int length = property_order_.length() - start;
+  if (length < 2) return;
+  Vector<PropertyPosition>(&property_order_[start], length).Sort(
+      ComparePropertyPositions);
+}
+
+
+bool JsonStringifier::Push(JSObject* object) {
+  // Cyclic structures are reported by the JavaScript implementation.
+  for (int i = 0; i < stack_.length(); i++) {
+    if (stack_[i] == object) return false;
+  }
+  StackLimitCheck check;
+  if (check.HasOverflowed()) return false;
+  stack_.Add(object);
+  return true;
+}
+
+
+void JsonStringifier::NewLine() {
+  if (gap_.is_empty()) return;
+  Add('\n');
+  for (int i = 0; i < stack_.length(); i++) {
+    for (int j = 0; j < gap_.length(); j++) Add(gap_[j]);
+  }
+}
+
+
+void JsonStringifier::SerializeNumber(double value) {
+  if (!isfinite(value)) {
+    Add("null");
+    return;
+  }
+  char chars[100];
+  Vector<char> buffer(chars, ARRAY_SIZE(chars));
+  Add(DoubleToCString(value, buffer));
+}
+
+
+void JsonStringifier::SerializeString(String* string) {
+  if (string->IsFlat()) {
+    if (string->IsAsciiRepresentation()) {
+      SerializeChars(string->ToAsciiVector());
+    } else {
+      SerializeChars(string->ToUC16Vector());
+    }
+  } else {
+    flat_buffer_.Rewind(0);
+    Vector<uc16> chars = flat_buffer_.AddBlock(0, string->length());
+    String::WriteToFlat(string, chars.start(), 0, string->length());
+    SerializeChars(flat_buffer_.ToConstVector());
+  }
+}
+
+
+template <typename Char>
+void JsonStringifier::SerializeChars(Vector<const Char> chars) {
+  static const char kHexDigits[] = "0123456789abcdef";
+  Add('"');
+  for (int i = 0; i < chars.length(); i++) {
+    uc16 c = chars[i];
+    if (c >= 0x20 && c < 0x80 && c != '"' && c != '\\') {
+      Add(static_cast<char>(c));
+      continue;
+    }
+    switch (c) {
+      case '"': Add("\\\""); break;
+      case '\\': Add("\\\\"); break;
+      case '\b': Add("\\b"); break;
+      case '\f': Add("\\f"); break;
+      case '\n': Add("\\n"); break;
+      case '\r': Add("\\r"); break;
+      case '\t': Add("\\t"); break;
+      default:
+        Add("\\u");
+        Add(kHexDigits[(c >> 12) & 0xf]);
+        Add(kHexDigits[(c >> 8) & 0xf]);
+        Add(kHexDigits[(c >> 4) & 0xf]);
+        Add(kHexDigits[c & 0xf]);
+    }
+  }
+  Add('"');
+}
+
+
+static Object* Runtime_JSONStringify(Arguments args) {
+  HandleScope scope;
+  ASSERT_EQ(2, args.length());
+  CONVERT_CHECKED(String, gap, args[1]);
+
+  // JSON.stringify truncates the gap to ten characters.
+  char gap_chars[10];
+  int gap_length = gap->length();
+  if (gap_length > static_cast<int>(ARRAY_SIZE(gap_chars))) {
+    return Heap::false_value();
+  }
+  for (int i = 0; i < gap_length; i++) {
+    uc16 c = gap->Get(i);
+    if (c > String::kMaxAsciiCharCode) return Heap::false_value();
+    gap_chars[i] = static_cast<char>(c);
+  }
+
+  JsonStringifier stringifier(Vector<const char>(gap_chars, gap_length));
+  JsonStringifier::Result result;
+  {
+    AssertNoAllocation no_allocation;
+    result = stringifier.Serialize(args[0]);
+  }
+  // Returning false makes the caller use the JavaScript implementation.
+  if (result == JsonStringifier::BAILOUT) return Heap::false_value();
+  if (result == JsonStringifier::UNDEFINED) return Heap::undefined_value();
+  return *Factory::NewStringFromAscii(stringifier.output());
+}
+
+
+static Object* Runtime_QuoteJSONString(Arguments args) {
+  HandleScope scope;
+  ASSERT_EQ(1, args.length());
+  CONVERT_CHECKED(String, string, args[0]);
+
+  JsonStringifier stringifier(Vector<const char>::empty());
+  {
+    AssertNoAllocation no_allocation;
+    stringifier.SerializeString(string);
+  }
+  return *Factory::NewStringFromAscii(stringifier.output());
+}
+
+
 static ObjectPair CompileGlobalEval(Handle<String> source,
                                     Handle<Object> receiver) {
   // Deal with a normal eval call with a string argument. Compile it
@@ -117,6 +117,8 @@ namespace internal {
   \
   F(StringAdd, 2, 1) \
   F(StringBuilderConcat, 3, 1) \
+  F(StringBuilderJoin, 3, 1) \
+  F(StringReplaceRange, 4, 1) \
   \
   /* Bit operations */ \
   F(NumberOr, 2, 1) \
@@ -168,6 +170,7 @@ namespace internal {
   F(SubString, 3, 1) \
   F(StringReplaceRegExpWithString, 4, 1) \
   F(StringMatch, 3, 1) \
+  F(StringSplitRegExp, 4, 1) \
   F(StringTrim, 3, 1) \
   F(StringToArray, 1, 1) \
   \
@@ -219,6 +222,11 @@ namespace internal {
   F(CompileString, 2, 1) \
   F(GlobalPrint, 1, 1) \
   \
+  /* JSON */ \
+  F(ParseJson, 1, 1) \
+  F(JSONStringify, 2, 1) \
+  F(QuoteJSONString, 1, 1) \
+  \
   /* Eval */ \
   F(GlobalReceiver, 1, 1) \
   F(ResolvePossiblyDirectEval, 3, 2) \
@@ -448,6 +456,15 @@ class Runtime : public AllStatic {
 
   // Helper functions used stubs.
   static void PerformGC(Object* result);
+
+  // The buffers and case mappings of the runtime functions, which are not
+  // members of this class.
+  class Data;
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kRuntimeData));
+  }
 };
 
 
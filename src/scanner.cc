@@ -44,7 +44,35 @@ unibrow::Predicate<unibrow::LineTerminator, 128> Scanner::kIsLineTerminator;
 unibrow::Predicate<unibrow::WhiteSpace, 128> Scanner::kIsWhiteSpace;
 
 
-StaticResource<Scanner::Utf8Decoder> Scanner::utf8_decoder_;
+// Shorthands for the character classes in the table below.
+static const byte kIdS =
+    Scanner::kIdentifierStartClass | Scanner::kIdentifierPartClass;
+static const byte kIdP = Scanner::kIdentifierPartClass;
+static const byte kWS = Scanner::kWhiteSpaceClass;
+static const byte kLT =
+    Scanner::kWhiteSpaceClass | Scanner::kLineTerminatorClass;
+
+const byte Scanner::kAsciiCharClasses[] = {
+  0,    0,    0,    0,    0,    0,    0,    0,     // 0x00
+  0,    kWS,  kLT,  kWS,  kWS,  kLT,  0,    0,     // 0x08
+  0,    0,    0,    0,    0,    0,    0,    0,     // 0x10
+  0,    0,    0,    0,    0,    0,    0,    0,     // 0x18
+  kWS,  0,    0,    0,    kIdS, 0,    0,    0,     // 0x20
+  0,    0,    0,    0,    0,    0,    0,    0,     // 0x28
+  kIdP, kIdP, kIdP, kIdP, kIdP, kIdP, kIdP, kIdP,  // 0x30
+  kIdP, kIdP, 0,    0,    0,    0,    0,    0,     // 0x38
+  0,    kIdS, kIdS, kIdS, kIdS, kIdS, kIdS, kIdS,  // 0x40
+  kIdS, kIdS, kIdS, kIdS, kIdS, kIdS, kIdS, kIdS,  // 0x48
+  kIdS, kIdS, kIdS, kIdS, kIdS, kIdS, kIdS, kIdS,  // 0x50
+  kIdS, kIdS, kIdS, 0,    kIdS, 0,    0,    kIdS,  // 0x58
+  0,    kIdS, kIdS, kIdS, kIdS, kIdS, kIdS, kIdS,  // 0x60
+  kIdS, kIdS, kIdS, kIdS, kIdS, kIdS, kIdS, kIdS,  // 0x68
+  kIdS, kIdS, kIdS, kIdS, kIdS, kIdS, kIdS, kIdS,  // 0x70
+  kIdS, kIdS, kIdS, 0,    0,    0,    0,    0      // 0x78
+};
+
+
+DEFINE_ISOLATE_COMPONENT(Scanner)
 
 
 // ----------------------------------------------------------------------------
@@ -85,38 +113,57 @@ void UTF8Buffer::AddCharSlow(uc32 c) {
 // ----------------------------------------------------------------------------
 // UTF16Buffer
 
-
 UTF16Buffer::UTF16Buffer()
-    : pos_(0), end_(Scanner::kNoEndPosition) { }
+    : data_(NULL), length_(0), offset_(0), pos_(0) { }
 
 
-// CharacterStreamUTF16Buffer
-CharacterStreamUTF16Buffer::CharacterStreamUTF16Buffer()
-    : pushback_buffer_(0), last_(0), stream_(NULL) { }
+UTF16Buffer::~UTF16Buffer() {
+  backing_store_.Dispose();
+}
 
 
-void CharacterStreamUTF16Buffer::Initialize(Handle<String> data,
-                                            unibrow::CharacterStream* input,
-                                            int start_position,
-                                            int end_position) {
-  stream_ = input;
-  if (start_position > 0) {
-    SeekForward(start_position);
+void UTF16Buffer::GrowBackingStore(int capacity, int length) {
+  if (capacity <= backing_store_.length()) return;
+  Vector<uc16> new_store = Vector<uc16>::New(capacity);
+  if (length > 0) {
+    memcpy(new_store.start(), backing_store_.start(), length * sizeof(uc16));
   }
-  end_ = end_position != Scanner::kNoEndPosition ? end_position : kMaxInt;
+  backing_store_.Dispose();
+  backing_store_ = new_store;
 }
 
 
-void CharacterStreamUTF16Buffer::PushBack(uc32 ch) {
-  pushback_buffer()->Add(last_);
-  last_ = ch;
-  pos_--;
+void UTF16Buffer::Initialize(Vector<const uc16> data) {
+  data_ = data.start();
+  length_ = data.length();
+  offset_ = 0;
+  pos_ = 0;
 }
 
 
-uc32 CharacterStreamUTF16Buffer::Advance() {
-  ASSERT(end_ != Scanner::kNoEndPosition);
-  ASSERT(end_ >= 0);
+void UTF16Buffer::Initialize(Handle<String> data,
+                             int start_position,
+                             int end_position) {
+  if (end_position == Scanner::kNoEndPosition) end_position = data->length();
+  ASSERT(0 <= start_position && start_position <= end_position);
+  ASSERT(end_position <= data->length());
+  length_ = end_position - start_position;
+  offset_ = start_position;
+  pos_ = 0;
+  if (StringShape(*data).IsExternalTwoByte()) {
+    // External strings don't move, so they can be read in place.
+    data_ = ExternalTwoByteString::cast(*data)->resource()->data() +
+        start_position;
+  } else {
+    GrowBackingStore(length_, 0);
+    String::WriteToFlat(*data, backing_store_.start(),
+                        start_position, end_position);
+    data_ = backing_store_.start();
+  }
+}
+
+
+void UTF16Buffer::Initialize(unibrow::CharacterStream* stream) {
   // NOTE: It is of importance to Persian / Farsi resources that we do
   // *not* strip format control characters in the scanner; see
   //
@@ -125,209 +172,111 @@ uc32 CharacterStreamUTF16Buffer::Advance() {
   // So, even though ECMA-262, section 7.1, page 11, dictates that we
   // must remove Unicode format-control characters, we do not. This is
   // in line with how IE and SpiderMonkey handles it.
-  if (!pushback_buffer()->is_empty()) {
-    pos_++;
-    return last_ = pushback_buffer()->RemoveLast();
-  } else if (stream_->has_more() && pos_ < end_) {
-    pos_++;
-    uc32 next = stream_->GetNext();
-    return last_ = next;
-  } else {
-    // Note: currently the following increment is necessary to avoid a
-    // test-parser problem!
-    pos_++;
-    return last_ = static_cast<uc32>(-1);
-  }
-}
-
-
-void CharacterStreamUTF16Buffer::SeekForward(int pos) {
-  pos_ = pos;
-  ASSERT(pushback_buffer()->is_empty());
-  stream_->Seek(pos);
-}
-
-
-// ExternalStringUTF16Buffer
-template <typename StringType, typename CharType>
-ExternalStringUTF16Buffer<StringType, CharType>::ExternalStringUTF16Buffer()
-    : raw_data_(NULL) { }
-
-
-template <typename StringType, typename CharType>
-void ExternalStringUTF16Buffer<StringType, CharType>::Initialize(
-     Handle<StringType> data,
-     int start_position,
-     int end_position) {
-  ASSERT(!data.is_null());
-  raw_data_ = data->resource()->data();
-
-  ASSERT(end_position <= data->length());
-  if (start_position > 0) {
-    SeekForward(start_position);
-  }
-  end_ =
-      end_position != Scanner::kNoEndPosition ? end_position : data->length();
-}
-
-
-template <typename StringType, typename CharType>
-uc32 ExternalStringUTF16Buffer<StringType, CharType>::Advance() {
-  if (pos_ < end_) {
-    return raw_data_[pos_++];
-  } else {
-    // note: currently the following increment is necessary to avoid a
-    // test-parser problem!
-    pos_++;
-    return static_cast<uc32>(-1);
+  static const int kInitialCapacity = 1 * KB;
+  int length = 0;
+  while (stream->has_more()) {
+    // Leave room for a surrogate pair.
+    if (length + 2 > backing_store_.length()) {
+      GrowBackingStore(Max(kInitialCapacity, backing_store_.length() * 2),
+                       length);
+    }
+    uc32 c = stream->GetNext();
+    if (c > 0xFFFF) {
+      // Characters outside the basic plane become surrogate pairs.
+      c -= 0x10000;
+      backing_store_[length++] = 0xD800 + (c >> 10);
+      backing_store_[length++] = 0xDC00 + (c & 0x3FF);
+    } else {
+      backing_store_[length++] = c;
+    }
   }
-}
-
-
-template <typename StringType, typename CharType>
-void ExternalStringUTF16Buffer<StringType, CharType>::PushBack(uc32 ch) {
-  pos_--;
-  ASSERT(pos_ >= Scanner::kCharacterLookaheadBufferSize);
-  ASSERT(raw_data_[pos_ - Scanner::kCharacterLookaheadBufferSize] == ch);
-}
-
-
-template <typename StringType, typename CharType>
-void ExternalStringUTF16Buffer<StringType, CharType>::SeekForward(int pos) {
-  pos_ = pos;
+  data_ = backing_store_.start();
+  length_ = length;
+  offset_ = 0;
+  pos_ = 0;
 }
 
 
 // ----------------------------------------------------------------------------
 // Keyword Matcher
-KeywordMatcher::FirstState KeywordMatcher::first_states_[] = {
-  { "break",  KEYWORD_PREFIX, Token::BREAK },
-  { NULL,     C,              Token::ILLEGAL },
-  { NULL,     D,              Token::ILLEGAL },
-  { "else",   KEYWORD_PREFIX, Token::ELSE },
-  { NULL,     F,              Token::ILLEGAL },
-  { NULL,     UNMATCHABLE,    Token::ILLEGAL },
-  { NULL,     UNMATCHABLE,    Token::ILLEGAL },
-  { NULL,     I,              Token::ILLEGAL },
-  { NULL,     UNMATCHABLE,    Token::ILLEGAL },
-  { NULL,     UNMATCHABLE,    Token::ILLEGAL },
-  { NULL,     UNMATCHABLE,    Token::ILLEGAL },
-  { NULL,     UNMATCHABLE,    Token::ILLEGAL },
-  { NULL,     N,              Token::ILLEGAL },
-  { NULL,     UNMATCHABLE,    Token::ILLEGAL },
-  { NULL,     UNMATCHABLE,    Token::ILLEGAL },
-  { NULL,     UNMATCHABLE,    Token::ILLEGAL },
-  { "return", KEYWORD_PREFIX, Token::RETURN },
-  { "switch", KEYWORD_PREFIX, Token::SWITCH },
-  { NULL,     T,              Token::ILLEGAL },
-  { NULL,     UNMATCHABLE,    Token::ILLEGAL },
-  { NULL,     V,              Token::ILLEGAL },
-  { NULL,     W,              Token::ILLEGAL }
+
+// Keywords indexed by their hash.
+const KeywordMatcher::Keyword KeywordMatcher::keywords_[] = {
+  { "default",     7, Token::DEFAULT },
+  { "typeof",      6, Token::TYPEOF },
+  { NULL,         0,  Token::ILLEGAL },
+  { "return",      6, Token::RETURN },
+  { NULL,         0,  Token::ILLEGAL },
+  { NULL,         0,  Token::ILLEGAL },
+  { NULL,         0,  Token::ILLEGAL },
+  { "const",       5, Token::CONST },
+  { NULL,         0,  Token::ILLEGAL },
+  { "in",          2, Token::IN },
+  { NULL,         0,  Token::ILLEGAL },
+  { "debugger",    8, Token::DEBUGGER },
+  { NULL,         0,  Token::ILLEGAL },
+  { NULL,         0,  Token::ILLEGAL },
+  { "finally",     7, Token::FINALLY },
+  { "void",        4, Token::VOID },
+  { NULL,         0,  Token::ILLEGAL },
+  { NULL,         0,  Token::ILLEGAL },
+  { "case",        4, Token::CASE },
+  { NULL,         0,  Token::ILLEGAL },
+  { NULL,         0,  Token::ILLEGAL },
+  { "else",        4, Token::ELSE },
+  { NULL,         0,  Token::ILLEGAL },
+  { NULL,         0,  Token::ILLEGAL },
+  { "this",        4, Token::THIS },
+  { "null",        4, Token::NULL_LITERAL },
+  { "var",         3, Token::VAR },
+  { NULL,         0,  Token::ILLEGAL },
+  { NULL,         0,  Token::ILLEGAL },
+  { "catch",       5, Token::CATCH },
+  { "new",         3, Token::NEW },
+  { NULL,         0,  Token::ILLEGAL },
+  { "false",       5, Token::FALSE_LITERAL },
+  { "instanceof", 10, Token::INSTANCEOF },
+  { NULL,         0,  Token::ILLEGAL },
+  { "throw",       5, Token::THROW },
+  { NULL,         0,  Token::ILLEGAL },
+  { NULL,         0,  Token::ILLEGAL },
+  { "while",       5, Token::WHILE },
+  { "do",          2, Token::DO },
+  { "continue",    8, Token::CONTINUE },
+  { NULL,         0,  Token::ILLEGAL },
+  { NULL,         0,  Token::ILLEGAL },
+  { "try",         3, Token::TRY },
+  { NULL,         0,  Token::ILLEGAL },
+  { NULL,         0,  Token::ILLEGAL },
+  { NULL,         0,  Token::ILLEGAL },
+  { "break",       5, Token::BREAK },
+  { NULL,         0,  Token::ILLEGAL },
+  { "if",          2, Token::IF },
+  { NULL,         0,  Token::ILLEGAL },
+  { "native",      6, Token::NATIVE },
+  { "for",         3, Token::FOR },
+  { "delete",      6, Token::DELETE },
+  { "true",        4, Token::TRUE_LITERAL },
+  { NULL,         0,  Token::ILLEGAL },
+  { NULL,         0,  Token::ILLEGAL },
+  { NULL,         0,  Token::ILLEGAL },
+  { "switch",      6, Token::SWITCH },
+  { NULL,         0,  Token::ILLEGAL },
+  { NULL,         0,  Token::ILLEGAL },
+  { "function",    8, Token::FUNCTION },
+  { "with",        4, Token::WITH },
+  { NULL,         0,  Token::ILLEGAL }
 };
 
 
-void KeywordMatcher::Step(uc32 input) {
-  switch (state_) {
-    case INITIAL: {
-      // matching the first character is the only state with significant fanout.
-      // Match only lower-case letters in range 'b'..'w'.
-      unsigned int offset = input - kFirstCharRangeMin;
-      if (offset < kFirstCharRangeLength) {
-        state_ = first_states_[offset].state;
-        if (state_ == KEYWORD_PREFIX) {
-          keyword_ = first_states_[offset].keyword;
-          counter_ = 1;
-          keyword_token_ = first_states_[offset].token;
-        }
-        return;
-      }
-      break;
-    }
-    case KEYWORD_PREFIX:
-      if (keyword_[counter_] == input) {
-        ASSERT_NE(input, '\0');
-        counter_++;
-        if (keyword_[counter_] == '\0') {
-          state_ = KEYWORD_MATCHED;
-          token_ = keyword_token_;
-        }
-        return;
-      }
-      break;
-    case KEYWORD_MATCHED:
-      token_ = Token::IDENTIFIER;
-      break;
-    case C:
-      if (MatchState(input, 'a', CA)) return;
-      if (MatchState(input, 'o', CO)) return;
-      break;
-    case CA:
-      if (MatchKeywordStart(input, "case", 2, Token::CASE)) return;
-      if (MatchKeywordStart(input, "catch", 2, Token::CATCH)) return;
-      break;
-    case CO:
-      if (MatchState(input, 'n', CON)) return;
-      break;
-    case CON:
-      if (MatchKeywordStart(input, "const", 3, Token::CONST)) return;
-      if (MatchKeywordStart(input, "continue", 3, Token::CONTINUE)) return;
-      break;
-    case D:
-      if (MatchState(input, 'e', DE)) return;
-      if (MatchKeyword(input, 'o', KEYWORD_MATCHED, Token::DO)) return;
-      break;
-    case DE:
-      if (MatchKeywordStart(input, "debugger", 2, Token::DEBUGGER)) return;
-      if (MatchKeywordStart(input, "default", 2, Token::DEFAULT)) return;
-      if (MatchKeywordStart(input, "delete", 2, Token::DELETE)) return;
-      break;
-    case F:
-      if (MatchKeywordStart(input, "false", 1, Token::FALSE_LITERAL)) return;
-      if (MatchKeywordStart(input, "finally", 1, Token::FINALLY)) return;
-      if (MatchKeywordStart(input, "for", 1, Token::FOR)) return;
-      if (MatchKeywordStart(input, "function", 1, Token::FUNCTION)) return;
-      break;
-    case I:
-      if (MatchKeyword(input, 'f', KEYWORD_MATCHED, Token::IF)) return;
-      if (MatchKeyword(input, 'n', IN, Token::IN)) return;
-      break;
-    case IN:
-      token_ = Token::IDENTIFIER;
-      if (MatchKeywordStart(input, "instanceof", 2, Token::INSTANCEOF)) {
-        return;
-      }
-      break;
-    case N:
-      if (MatchKeywordStart(input, "native", 1, Token::NATIVE)) return;
-      if (MatchKeywordStart(input, "new", 1, Token::NEW)) return;
-      if (MatchKeywordStart(input, "null", 1, Token::NULL_LITERAL)) return;
-      break;
-    case T:
-      if (MatchState(input, 'h', TH)) return;
-      if (MatchState(input, 'r', TR)) return;
-      if (MatchKeywordStart(input, "typeof", 1, Token::TYPEOF)) return;
-      break;
-    case TH:
-      if (MatchKeywordStart(input, "this", 2, Token::THIS)) return;
-      if (MatchKeywordStart(input, "throw", 2, Token::THROW)) return;
-      break;
-    case TR:
-      if (MatchKeywordStart(input, "true", 2, Token::TRUE_LITERAL)) return;
-      if (MatchKeyword(input, 'y', KEYWORD_MATCHED, Token::TRY)) return;
-      break;
-    case V:
-      if (MatchKeywordStart(input, "var", 1, Token::VAR)) return;
-      if (MatchKeywordStart(input, "void", 1, Token::VOID)) return;
-      break;
-    case W:
-      if (MatchKeywordStart(input, "while", 1, Token::WHILE)) return;
-      if (MatchKeywordStart(input, "with", 1, Token::WITH)) return;
-      break;
-    default:
-      UNREACHABLE();
+Token::Value KeywordMatcher::Lookup(const char* chars, int length) {
+  if (length < kMinLength || length > kMaxLength) return Token::IDENTIFIER;
+  const Keyword& keyword = keywords_[Hash(chars, length)];
+  if (keyword.length == length &&
+      strncmp(keyword.chars, chars, length) == 0) {
+    return keyword.token;
   }
-  // On fallthrough, it's a failure.
-  state_ = UNMATCHABLE;
+  return Token::IDENTIFIER;
 }
 
 
@@ -335,20 +284,27 @@ void KeywordMatcher::Step(uc32 input) {
 // Scanner
 
 Scanner::Scanner(ParserMode pre)
-    : stack_overflow_(false), is_pre_parsing_(pre == PREPARSE) { }
+    : stack_overflow_(false),
+      stack_limit_(0),
+      is_pre_parsing_(pre == PREPARSE) { }
 
 
 void Scanner::Initialize(Handle<String> source,
                          ParserLanguage language) {
-  safe_string_input_buffer_.Reset(source.location());
-  Init(source, &safe_string_input_buffer_, 0, source->length(), language);
+  source_.Initialize(source, 0, source->length());
+  InitScanning(language);
 }
 
 
 void Scanner::Initialize(Handle<String> source,
                          unibrow::CharacterStream* stream,
                          ParserLanguage language) {
-  Init(source, stream, 0, kNoEndPosition, language);
+  if (source.is_null()) {
+    source_.Initialize(stream);
+  } else {
+    source_.Initialize(source, 0, source->length());
+  }
+  InitScanning(language);
 }
 
 
@@ -356,38 +312,18 @@ void Scanner::Initialize(Handle<String> source,
                          int start_position,
                          int end_position,
                          ParserLanguage language) {
-  safe_string_input_buffer_.Reset(source.location());
-  Init(source, &safe_string_input_buffer_,
-       start_position, end_position, language);
+  source_.Initialize(source, start_position, end_position);
+  InitScanning(language);
 }
 
 
-void Scanner::Init(Handle<String> source,
-                   unibrow::CharacterStream* stream,
-                   int start_position,
-                   int end_position,
-                   ParserLanguage language) {
-  // Initialize the source buffer.
-  if (!source.is_null() && StringShape(*source).IsExternalTwoByte()) {
-    two_byte_string_buffer_.Initialize(
-        Handle<ExternalTwoByteString>::cast(source),
-        start_position,
-        end_position);
-    source_ = &two_byte_string_buffer_;
-  } else if (!source.is_null() && StringShape(*source).IsExternalAscii()) {
-    ascii_string_buffer_.Initialize(
-        Handle<ExternalAsciiString>::cast(source),
-        start_position,
-        end_position);
-    source_ = &ascii_string_buffer_;
-  } else {
-    char_stream_buffer_.Initialize(source,
-                                   stream,
-                                   start_position,
-                                   end_position);
-    source_ = &char_stream_buffer_;
-  }
+void Scanner::Initialize(Vector<const uc16> source, ParserLanguage language) {
+  source_.Initialize(source);
+  InitScanning(language);
+}
 
+
+void Scanner::InitScanning(ParserLanguage language) {
   is_parsing_json_ = (language == JSON);
 
   // Set c0_ (one character ahead)
@@ -405,13 +341,9 @@ void Scanner::Init(Handle<String> source,
 
 
 Token::Value Scanner::Next() {
-  // BUG 1215673: Find a thread safe way to set a stack limit in
-  // pre-parse mode. Otherwise, we cannot safely pre-parse from other
-  // threads.
   current_ = next_;
   // Check for stack-overflow before returning any tokens.
-  StackLimitCheck check;
-  if (check.HasOverflowed()) {
+  if (HasStackOverflowed()) {
     stack_overflow_ = true;
     next_.token = Token::ILLEGAL;
   } else {
@@ -421,6 +353,18 @@ Token::Value Scanner::Next() {
 }
 
 
+bool Scanner::HasStackOverflowed() {
+  if (stack_limit_ == 0) {
+    StackLimitCheck check;
+    return check.HasOverflowed();
+  }
+  // Compare the address of a local against the explicit limit; this does
+  // not depend on any per-thread state of the VM.
+  int marker;
+  return reinterpret_cast<uintptr_t>(&marker) < stack_limit_;
+}
+
+
 void Scanner::StartLiteral() {
   // Use the first buffer unless it's currently in use by the current_ token.
   // In most cases we won't have two literals/identifiers in a row, so
@@ -477,9 +421,9 @@ bool Scanner::SkipJavaScriptWhiteSpace() {
   while (true) {
     // We treat byte-order marks (BOMs) as whitespace for better
     // compatibility with Spidermonkey and other JavaScript engines.
-    while (kIsWhiteSpace.get(c0_) || IsByteOrderMark(c0_)) {
+    while (IsWhiteSpace(c0_, &is_white_space_) || IsByteOrderMark(c0_)) {
       // IsWhiteSpace() includes line terminators!
-      if (kIsLineTerminator.get(c0_)) {
+      if (IsLineTerminator(c0_, &is_line_terminator_)) {
         // Ignore line terminators, but remember them. This is necessary
         // for automatic semicolon insertion.
         has_line_terminator_before_next_ = true;
@@ -519,7 +463,7 @@ Token::Value Scanner::SkipSingleLineComment() {
   // separately by the lexical grammar and becomes part of the
   // stream of input elements for the syntactic grammar (see
   // ECMA-262, section 7.4, page 12).
-  while (c0_ >= 0 && !kIsLineTerminator.get(c0_)) {
+  while (c0_ >= 0 && !IsLineTerminator(c0_, &is_line_terminator_)) {
     Advance();
   }
 
@@ -748,7 +692,7 @@ Token::Value Scanner::ScanJsonIdentifier(const char* text,
     Advance();
     text++;
   }
-  if (kIsIdentifierPart.get(c0_)) return Token::ILLEGAL;
+  if (IsIdentifierPart(c0_, &is_identifier_part_)) return Token::ILLEGAL;
   TerminateLiteral();
   return token;
 }
@@ -972,7 +916,7 @@ void Scanner::ScanJavaScript() {
         break;
 
       default:
-        if (kIsIdentifierStart.get(c0_)) {
+        if (IsIdentifierStart(c0_, &is_identifier_start_)) {
           token = ScanIdentifier();
         } else if (IsDecimalDigit(c0_)) {
           token = ScanNumber(false);
@@ -996,7 +940,7 @@ void Scanner::ScanJavaScript() {
 
 
 void Scanner::SeekForward(int pos) {
-  source_->SeekForward(pos - 1);
+  source_.SeekForward(pos - 1);
   Advance();
   Scan();
 }
@@ -1051,7 +995,7 @@ void Scanner::ScanEscape() {
   Advance();
 
   // Skip escaped newlines.
-  if (kIsLineTerminator.get(c)) {
+  if (IsLineTerminator(c, &is_line_terminator_)) {
     // Allow CR+LF newlines in multiline string literals.
     if (IsCarriageReturn(c) && IsLineFeed(c0_)) Advance();
     // Allow LF+CR newlines in multiline string literals.
@@ -1093,7 +1037,8 @@ Token::Value Scanner::ScanString() {
   Advance();  // consume quote
 
   StartLiteral();
-  while (c0_ != quote && c0_ >= 0 && !kIsLineTerminator.get(c0_)) {
+  while (c0_ != quote && c0_ >= 0 &&
+         !IsLineTerminator(c0_, &is_line_terminator_)) {
     uc32 c = c0_;
     Advance();
     if (c == '\\') {
@@ -1207,7 +1152,7 @@ Token::Value Scanner::ScanNumber(bool seen_period) {
   // not be an identifier start or a decimal digit; see ECMA-262
   // section 7.8.3, page 17 (note that we read only one decimal digit
   // if the value is 0).
-  if (IsDecimalDigit(c0_) || kIsIdentifierStart.get(c0_))
+  if (IsDecimalDigit(c0_) || IsIdentifierStart(c0_, &is_identifier_start_))
     return Token::ILLEGAL;
 
   return Token::NUMBER;
@@ -1227,51 +1172,50 @@ uc32 Scanner::ScanIdentifierUnicodeEscape() {
 
 
 Token::Value Scanner::ScanIdentifier() {
-  ASSERT(kIsIdentifierStart.get(c0_));
+  ASSERT(IsIdentifierStart(c0_, &is_identifier_start_));
 
   StartLiteral();
-  KeywordMatcher keyword_match;
+  // Identifiers containing escapes are never keywords.
+  bool has_escapes = false;
 
   // Scan identifier start character.
   if (c0_ == '\\') {
     uc32 c = ScanIdentifierUnicodeEscape();
     // Only allow legal identifier start characters.
-    if (!kIsIdentifierStart.get(c)) return Token::ILLEGAL;
+    if (!IsIdentifierStart(c, &is_identifier_start_)) return Token::ILLEGAL;
     AddChar(c);
-    keyword_match.Fail();
+    has_escapes = true;
   } else {
-    AddChar(c0_);
-    keyword_match.AddChar(c0_);
-    Advance();
+    AddCharAdvance();
   }
 
   // Scan the rest of the identifier characters.
-  while (kIsIdentifierPart.get(c0_)) {
+  while (IsIdentifierPart(c0_, &is_identifier_part_)) {
     if (c0_ == '\\') {
       uc32 c = ScanIdentifierUnicodeEscape();
       // Only allow legal identifier part characters.
-      if (!kIsIdentifierPart.get(c)) return Token::ILLEGAL;
+      if (!IsIdentifierPart(c, &is_identifier_part_)) return Token::ILLEGAL;
       AddChar(c);
-      keyword_match.Fail();
+      has_escapes = true;
     } else {
-      AddChar(c0_);
-      keyword_match.AddChar(c0_);
-      Advance();
+      AddCharAdvance();
     }
   }
   TerminateLiteral();
 
-  return keyword_match.token();
+  if (has_escapes) return Token::IDENTIFIER;
+  // Look up the complete identifier, excluding the terminating zero.
+  UTF8Buffer* literal = next_.literal_buffer;
+  return KeywordMatcher::Lookup(literal->data(), literal->pos() - 1);
 }
 
 
-
 bool Scanner::IsIdentifier(unibrow::CharacterStream* buffer) {
   // Checks whether the buffer contains an identifier (no escape).
   if (!buffer->has_more()) return false;
-  if (!kIsIdentifierStart.get(buffer->GetNext())) return false;
+  if (!IsIdentifierStart(buffer->GetNext())) return false;
   while (buffer->has_more()) {
-    if (!kIsIdentifierPart.get(buffer->GetNext())) return false;
+    if (!IsIdentifierPart(buffer->GetNext())) return false;
   }
   return true;
 }
@@ -1294,11 +1238,11 @@ bool Scanner::ScanRegExpPattern(bool seen_equal) {
     AddChar('=');
 
   while (c0_ != '/' || in_character_class) {
-    if (kIsLineTerminator.get(c0_) || c0_ < 0)
+    if (IsLineTerminator(c0_, &is_line_terminator_) || c0_ < 0)
       return false;
     if (c0_ == '\\') {  // escaped character
       AddCharAdvance();
-      if (kIsLineTerminator.get(c0_) || c0_ < 0)
+      if (IsLineTerminator(c0_, &is_line_terminator_) || c0_ < 0)
         return false;
       AddCharAdvance();
     } else {  // unescaped character
@@ -1319,7 +1263,7 @@ bool Scanner::ScanRegExpPattern(bool seen_equal) {
 bool Scanner::ScanRegExpFlags() {
   // Scan regular expression flags.
   StartLiteral();
-  while (kIsIdentifierPart.get(c0_)) {
+  while (IsIdentifierPart(c0_, &is_identifier_part_)) {
     if (c0_ == '\\') {
       uc32 c = ScanIdentifierUnicodeEscape();
       if (c != static_cast<uc32>(unibrow::Utf8::kBadChar)) {
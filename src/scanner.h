@@ -84,67 +84,58 @@ class UTF8Buffer {
 };
 
 
-// Interface through which the scanner reads characters from the input source.
+// Buffer of UTF-16 code units the scanner reads its input from. The input
+// is always one contiguous array, so that the scanner can read characters
+// inline. Sources that aren't such an array already are copied into a
+// backing store owned by the buffer: heap strings may move while parsing,
+// ASCII strings have narrower characters and character streams can only be
+// read sequentially.
 class UTF16Buffer {
  public:
   UTF16Buffer();
-  virtual ~UTF16Buffer() {}
+  ~UTF16Buffer();
 
-  virtual void PushBack(uc32 ch) = 0;
-  // Returns a value < 0 when the buffer end is reached.
-  virtual uc32 Advance() = 0;
-  virtual void SeekForward(int pos) = 0;
-
-  int pos() const { return pos_; }
-
- protected:
-  int pos_;  // Current position in the buffer.
-  int end_;  // Position where scanning should stop (EOF).
-};
-
-
-// UTF16 buffer to read characters from a character stream.
-class CharacterStreamUTF16Buffer: public UTF16Buffer {
- public:
-  CharacterStreamUTF16Buffer();
-  virtual ~CharacterStreamUTF16Buffer() {}
-  void Initialize(Handle<String> data,
-                  unibrow::CharacterStream* stream,
-                  int start_position,
-                  int end_position);
-  virtual void PushBack(uc32 ch);
-  virtual uc32 Advance();
-  virtual void SeekForward(int pos);
+  // Reads the characters of data without copying them; data must stay
+  // alive while scanning.
+  void Initialize(Vector<const uc16> data);
+  // Reads the characters of data in the range [start_position, end_position).
+  void Initialize(Handle<String> data, int start_position, int end_position);
+  // Reads all characters of the stream.
+  void Initialize(unibrow::CharacterStream* stream);
 
- private:
-  List<uc32> pushback_buffer_;
-  uc32 last_;
-  unibrow::CharacterStream* stream_;
+  // Returns a value < 0 when the buffer end is reached.
+  inline uc32 Advance() {
+    if (pos_ < length_) return data_[pos_++];
+    // Also move past the end so that pushing back is symmetric.
+    pos_++;
+    return static_cast<uc32>(-1);
+  }
 
-  List<uc32>* pushback_buffer() { return &pushback_buffer_; }
-};
+  // Undoes the last Advance; ch is the character read before it.
+  inline void PushBack(uc32 ch) {
+    pos_--;
+    ASSERT(pos_ >= 1);
+    ASSERT(data_[pos_ - 1] == ch);
+  }
 
+  void SeekForward(int pos) { pos_ = pos - offset_; }
 
-// UTF16 buffer to read characters from an external string.
-template <typename StringType, typename CharType>
-class ExternalStringUTF16Buffer: public UTF16Buffer {
- public:
-  ExternalStringUTF16Buffer();
-  virtual ~ExternalStringUTF16Buffer() {}
-  void Initialize(Handle<StringType> data,
-                  int start_position,
-                  int end_position);
-  virtual void PushBack(uc32 ch);
-  virtual uc32 Advance();
-  virtual void SeekForward(int pos);
+  int pos() const { return offset_ + pos_; }
 
  private:
-  const CharType* raw_data_;  // Pointer to the actual array of characters.
+  const uc16* data_;
+  int length_;
+  int offset_;  // Position in the source of the first character in data_.
+  int pos_;     // Position relative to data_.
+  Vector<uc16> backing_store_;
+
+  // Grows the backing store to at least the given capacity, keeping the
+  // first length characters.
+  void GrowBackingStore(int capacity, int length);
 };
 
 
-class KeywordMatcher {
-//  Incrementally recognize keywords.
+// Recognizes keywords by a perfect hash of the complete identifier.
 //
 //  Recognized keywords:
 //      break case catch const* continue debugger* default delete do else
@@ -153,108 +144,31 @@ class KeywordMatcher {
 //
 //  *: Actually "future reserved keywords". These are the only ones we
 //     recognized, the remaining are allowed as identifiers.
+class KeywordMatcher : public AllStatic {
  public:
-  KeywordMatcher() : state_(INITIAL), token_(Token::IDENTIFIER) {}
-
-  Token::Value token() { return token_; }
-
-  inline void AddChar(uc32 input) {
-    if (state_ != UNMATCHABLE) {
-      Step(input);
-    }
-  }
-
-  void Fail() {
-    token_ = Token::IDENTIFIER;
-    state_ = UNMATCHABLE;
-  }
+  // Returns the token of the keyword spelled by the UTF-8 characters, or
+  // Token::IDENTIFIER if they don't spell a keyword.
+  static Token::Value Lookup(const char* chars, int length);
 
  private:
-  enum State {
-    UNMATCHABLE,
-    INITIAL,
-    KEYWORD_PREFIX,
-    KEYWORD_MATCHED,
-    C,
-    CA,
-    CO,
-    CON,
-    D,
-    DE,
-    F,
-    I,
-    IN,
-    N,
-    T,
-    TH,
-    TR,
-    V,
-    W
-  };
-
-  struct FirstState {
-    const char* keyword;
-    State state;
+  struct Keyword {
+    const char* chars;
+    int length;
     Token::Value token;
   };
 
-  // Range of possible first characters of a keyword.
-  static const unsigned int kFirstCharRangeMin = 'b';
-  static const unsigned int kFirstCharRangeMax = 'w';
-  static const unsigned int kFirstCharRangeLength =
-      kFirstCharRangeMax - kFirstCharRangeMin + 1;
-  // State map for first keyword character range.
-  static FirstState first_states_[kFirstCharRangeLength];
-
-  // Current state.
-  State state_;
-  // Token for currently added characters.
-  Token::Value token_;
-
-  // Matching a specific keyword string (there is only one possible valid
-  // keyword with the current prefix).
-  const char* keyword_;
-  int counter_;
-  Token::Value keyword_token_;
-
-  // If input equals keyword's character at position, continue matching keyword
-  // from that position.
-  inline bool MatchKeywordStart(uc32 input,
-                                const char* keyword,
-                                int position,
-                                Token::Value token_if_match) {
-    if (input == keyword[position]) {
-      state_ = KEYWORD_PREFIX;
-      this->keyword_ = keyword;
-      this->counter_ = position + 1;
-      this->keyword_token_ = token_if_match;
-      return true;
-    }
-    return false;
-  }
+  static const int kMinLength = 2;
+  static const int kMaxLength = 10;
+  static const int kTableSize = 64;
 
-  // If input equals match character, transition to new state and return true.
-  inline bool MatchState(uc32 input, char match, State new_state) {
-    if (input == match) {
-      state_ = new_state;
-      return true;
-    }
-    return false;
-  }
-
-  inline bool MatchKeyword(uc32 input,
-                           char match,
-                           State new_state,
-                           Token::Value keyword_token) {
-    if (input == match) {  // Matched "do".
-      state_ = new_state;
-      token_ = keyword_token;
-      return true;
-    }
-    return false;
+  // The multipliers are chosen so that no two keywords collide.
+  static int Hash(const char* chars, int length) {
+    unsigned first = static_cast<unsigned char>(chars[0]);
+    unsigned second = static_cast<unsigned char>(chars[1]);
+    return (first + second * 35 + length * 11) & (kTableSize - 1);
   }
 
-  void Step(uc32 input);
+  static const Keyword keywords_[kTableSize];
 };
 
 
@@ -278,6 +192,12 @@ class Scanner {
   void Initialize(Handle<String> source,
                   int start_position, int end_position,
                   ParserLanguage language);
+  // Initialize the Scanner to scan UTF-16 source outside the heap.
+  void Initialize(Vector<const uc16> source, ParserLanguage language);
+
+  // Use an explicit stack limit rather than the one of the StackGuard, which
+  // is only valid on the VM thread. Zero means use the StackGuard.
+  void set_stack_limit(uintptr_t stack_limit) { stack_limit_ = stack_limit; }
 
   // Returns the next token.
   Token::Value Next();
@@ -316,6 +236,10 @@ class Scanner {
     return current_.literal_buffer->pos() - 1;
   }
 
+  Vector<const char> literal() const {
+    return Vector<const char>(literal_string(), literal_length());
+  }
+
   // Returns the literal string for the next token (the token that
   // would be returned if Next() were called).
   const char* next_literal_string() const {
@@ -347,7 +271,9 @@ class Scanner {
 
   bool stack_overflow() { return stack_overflow_; }
 
-  static StaticResource<Utf8Decoder>* utf8_decoder() { return &utf8_decoder_; }
+  static StaticResource<Utf8Decoder>* utf8_decoder() {
+    return &data()->utf8_decoder_;
+  }
 
   // Tells whether the buffer contains an identifier (no escapes).
   // Used for checking if a property name is an identifier.
@@ -358,29 +284,74 @@ class Scanner {
   static unibrow::Predicate<unibrow::LineTerminator, 128> kIsLineTerminator;
   static unibrow::Predicate<unibrow::WhiteSpace, 128> kIsWhiteSpace;
 
+  // Character classes of ASCII characters, used by the classification
+  // functions below before falling back to the Unicode predicates.
+  enum CharClass {
+    kIdentifierStartClass = 1 << 0,
+    kIdentifierPartClass = 1 << 1,
+    kWhiteSpaceClass = 1 << 2,
+    kLineTerminatorClass = 1 << 3
+  };
+  static const int kAsciiSize = 128;
+  static const byte kAsciiCharClasses[kAsciiSize];
+
+  static inline bool IsAsciiOfClass(uc32 c, CharClass char_class) {
+    return (kAsciiCharClasses[c] & char_class) != 0;
+  }
+  // The classification functions take the cache for the Unicode predicate
+  // to use for non-ASCII characters. Scanner instances pass their own, so
+  // scanners on different threads never write to a shared cache.
+  static inline bool IsIdentifierStart(
+      uc32 c, unibrow::Predicate<IdentifierStart, 128>* cache) {
+    if (static_cast<unsigned>(c) < kAsciiSize) {
+      return IsAsciiOfClass(c, kIdentifierStartClass);
+    }
+    return cache->get(c);
+  }
+  static inline bool IsIdentifierPart(
+      uc32 c, unibrow::Predicate<IdentifierPart, 128>* cache) {
+    if (static_cast<unsigned>(c) < kAsciiSize) {
+      return IsAsciiOfClass(c, kIdentifierPartClass);
+    }
+    return cache->get(c);
+  }
+  static inline bool IsWhiteSpace(
+      uc32 c, unibrow::Predicate<unibrow::WhiteSpace, 128>* cache) {
+    if (static_cast<unsigned>(c) < kAsciiSize) {
+      return IsAsciiOfClass(c, kWhiteSpaceClass);
+    }
+    return cache->get(c);
+  }
+  static inline bool IsLineTerminator(
+      uc32 c, unibrow::Predicate<unibrow::LineTerminator, 128>* cache) {
+    if (static_cast<unsigned>(c) < kAsciiSize) {
+      return IsAsciiOfClass(c, kLineTerminatorClass);
+    }
+    return cache->get(c);
+  }
+  static inline bool IsIdentifierStart(uc32 c) {
+    return IsIdentifierStart(c, &kIsIdentifierStart);
+  }
+  static inline bool IsIdentifierPart(uc32 c) {
+    return IsIdentifierPart(c, &kIsIdentifierPart);
+  }
+  static inline bool IsWhiteSpace(uc32 c) {
+    return IsWhiteSpace(c, &kIsWhiteSpace);
+  }
+  static inline bool IsLineTerminator(uc32 c) {
+    return IsLineTerminator(c, &kIsLineTerminator);
+  }
+
   static const int kCharacterLookaheadBufferSize = 1;
   static const int kNoEndPosition = 1;
 
  private:
-  void Init(Handle<String> source,
-            unibrow::CharacterStream* stream,
-            int start_position, int end_position,
-            ParserLanguage language);
-
+  void InitScanning(ParserLanguage language);
 
-  // Different UTF16 buffers used to pull characters from. Based on input one of
-  // these will be initialized as the actual data source.
-  CharacterStreamUTF16Buffer char_stream_buffer_;
-  ExternalStringUTF16Buffer<ExternalTwoByteString, uint16_t>
-      two_byte_string_buffer_;
-  ExternalStringUTF16Buffer<ExternalAsciiString, char> ascii_string_buffer_;
+  bool HasStackOverflowed();
 
-  // Source. Will point to one of the buffers declared above.
-  UTF16Buffer* source_;
-
-  // Used to convert the source string into a character stream when a stream
-  // is not passed to the scanner.
-  SafeStringInputBuffer safe_string_input_buffer_;
+  // Source of the characters to scan.
+  UTF16Buffer source_;
 
   // Buffer to hold literal values (identifiers, strings, numbers)
   // using 0-terminated UTF-8 encoding.
@@ -388,7 +359,23 @@ class Scanner {
   UTF8Buffer literal_buffer_2_;
 
   bool stack_overflow_;
-  static StaticResource<Utf8Decoder> utf8_decoder_;
+  uintptr_t stack_limit_;
+
+  class Data {
+   public:
+    StaticResource<Utf8Decoder> utf8_decoder_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kScannerData));
+  }
+
+  // Caches for classifying non-ASCII characters, see IsIdentifierStart.
+  unibrow::Predicate<IdentifierStart, 128> is_identifier_start_;
+  unibrow::Predicate<IdentifierPart, 128> is_identifier_part_;
+  unibrow::Predicate<unibrow::WhiteSpace, 128> is_white_space_;
+  unibrow::Predicate<unibrow::LineTerminator, 128> is_line_terminator_;
 
   // One Unicode character look-ahead; c0_ < 0 at the end of the input.
   uc32 c0_;
@@ -413,9 +400,9 @@ class Scanner {
   void TerminateLiteral();
 
   // Low-level scanning support.
-  void Advance() { c0_ = source_->Advance(); }
+  void Advance() { c0_ = source_.Advance(); }
   void PushBack(uc32 ch) {
-    source_->PushBack(ch);
+    source_.PushBack(ch);
     c0_ = ch;
   }
 
@@ -483,12 +470,14 @@ class Scanner {
 
   // Return the current source position.
   int source_pos() {
-    return source_->pos() - kCharacterLookaheadBufferSize;
+    return source_.pos() - kCharacterLookaheadBufferSize;
   }
 
   // Decodes a unicode escape-sequence which is part of an identifier.
   // If the escape sequence cannot be decoded the result is kBadRune.
   uc32 ScanIdentifierUnicodeEscape();
+
+  friend class Isolate;
 };
 
 } }  // namespace v8::internal
@@ -543,10 +543,11 @@ int ContextSlotCache::Hash(Code* code, String* name) {
 int ContextSlotCache::Lookup(Code* code,
                              String* name,
                              Variable::Mode* mode) {
+  Data* data = ContextSlotCache::data();
   int index = Hash(code, name);
-  Key& key = keys_[index];
+  Key& key = data->keys_[index];
   if ((key.code == code) && key.name->Equals(name)) {
-    Value result(values_[index]);
+    Value result(data->values_[index]);
     if (mode != NULL) *mode = result.mode();
     return result.index() + kNotFound;
   }
@@ -561,12 +562,13 @@ void ContextSlotCache::Update(Code* code,
   String* symbol;
   ASSERT(slot_index > kNotFound);
   if (Heap::LookupSymbolIfExists(name, &symbol)) {
+    Data* data = ContextSlotCache::data();
     int index = Hash(code, symbol);
-    Key& key = keys_[index];
+    Key& key = data->keys_[index];
     key.code = code;
     key.name = symbol;
     // Please note value only takes a uint as index.
-    values_[index] = Value(mode, slot_index - kNotFound).raw();
+    data->values_[index] = Value(mode, slot_index - kNotFound).raw();
 #ifdef DEBUG
     ValidateEntry(code, name, mode, slot_index);
 #endif
@@ -575,14 +577,14 @@ void ContextSlotCache::Update(Code* code,
 
 
 void ContextSlotCache::Clear() {
-  for (int index = 0; index < kLength; index++) keys_[index].code = NULL;
+  Data* data = ContextSlotCache::data();
+  for (int index = 0; index < kLength; index++) {
+    data->keys_[index].code = NULL;
+  }
 }
 
 
-ContextSlotCache::Key ContextSlotCache::keys_[ContextSlotCache::kLength];
-
-
-uint32_t ContextSlotCache::values_[ContextSlotCache::kLength];
+DEFINE_ISOLATE_COMPONENT(ContextSlotCache)
 
 
 #ifdef DEBUG
@@ -593,11 +595,12 @@ void ContextSlotCache::ValidateEntry(Code* code,
                                      int slot_index) {
   String* symbol;
   if (Heap::LookupSymbolIfExists(name, &symbol)) {
+    Data* data = ContextSlotCache::data();
     int index = Hash(code, name);
-    Key& key = keys_[index];
+    Key& key = data->keys_[index];
     ASSERT(key.code == code);
     ASSERT(key.name->Equals(name));
-    Value result(values_[index]);
+    Value result(data->values_[index]);
     ASSERT(result.mode() == mode);
     ASSERT(result.index() + kNotFound == slot_index);
   }
@@ -227,8 +227,18 @@ class ContextSlotCache {
     uint32_t value_;
   };
 
-  static Key keys_[kLength];
-  static uint32_t values_[kLength];
+  class Data {
+   public:
+    Key keys_[kLength];
+    uint32_t values_[kLength];
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kContextSlotCacheData));
+  }
+
+  friend class Isolate;
 };
 
 
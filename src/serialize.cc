@@ -40,6 +40,7 @@
 #include "v8threads.h"
 #include "top.h"
 #include "bootstrapper.h"
+#include "version.h"
 
 namespace v8 {
 namespace internal {
@@ -69,8 +70,9 @@ static int* GetInternalPointer(StatsCounter* counter) {
 class ExternalReferenceTable {
  public:
   static ExternalReferenceTable* instance() {
-    if (!instance_) instance_ = new ExternalReferenceTable();
-    return instance_;
+    Data* data = ExternalReferenceTable::data();
+    if (!data->instance_) data->instance_ = new ExternalReferenceTable();
+    return data->instance_;
   }
 
   int size() const { return refs_.length(); }
@@ -84,7 +86,17 @@ class ExternalReferenceTable {
   int max_id(int code) { return max_id_[code]; }
 
  private:
-  static ExternalReferenceTable* instance_;
+  // The table holds the addresses of the isolate it was made in.
+  class Data {
+   public:
+    ~Data() { delete instance_; }
+    ExternalReferenceTable* instance_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(Isolate::Current()->component_data(
+        Isolate::kExternalReferenceTableData));
+  }
 
   ExternalReferenceTable() : refs_(64) { PopulateTable(); }
   ~ExternalReferenceTable() { }
@@ -105,10 +117,12 @@ class ExternalReferenceTable {
 
   List<ExternalReferenceEntry> refs_;
   int max_id_[kTypeCodeCount];
+
+  friend class Isolate;
 };
 
 
-ExternalReferenceTable* ExternalReferenceTable::instance_ = NULL;
+DEFINE_ISOLATE_COMPONENT(ExternalReferenceTable)
 
 
 void ExternalReferenceTable::AddFromId(TypeCode type,
@@ -524,12 +538,13 @@ ExternalReferenceDecoder::~ExternalReferenceDecoder() {
 }
 
 
-bool Serializer::serialization_enabled_ = false;
-bool Serializer::too_late_to_enable_now_ = false;
-ExternalReferenceDecoder* Deserializer::external_reference_decoder_ = NULL;
+DEFINE_ISOLATE_COMPONENT(Serializer)
 
 
-Deserializer::Deserializer(SnapshotByteSource* source) : source_(source) {
+Deserializer::Deserializer(SnapshotByteSource* source)
+    : source_(source),
+      attached_objects_(NULL),
+      external_reference_decoder_(NULL) {
 }
 
 
@@ -617,7 +632,7 @@ void Deserializer::Deserialize() {
   ASSERT(HandleScopeImplementer::instance()->blocks()->is_empty());
   // Make sure the entire partial snapshot cache is traversed, filling it with
   // valid object pointers.
-  partial_snapshot_cache_length_ = kPartialSnapshotCacheCapacity;
+  data()->partial_snapshot_cache_length_ = kPartialSnapshotCacheCapacity;
   ASSERT_EQ(NULL, external_reference_decoder_);
   external_reference_decoder_ = new ExternalReferenceDecoder();
   Heap::IterateStrongRoots(this, VISIT_ONLY_STRONG);
@@ -737,12 +752,17 @@ void Deserializer::ReadChunk(Object** current,
             new_object = Heap::roots_address()[root_id];                       \
           } else if (where == kPartialSnapshotCache) {                         \
             int cache_index = source_->GetInt();                               \
-            new_object = partial_snapshot_cache_[cache_index];                 \
+            new_object = SerializerDeserializer::data()->                      \
+                partial_snapshot_cache_[cache_index];                          \
           } else if (where == kExternalReference) {                            \
             int reference_id = source_->GetInt();                              \
             Address address =                                                  \
                 external_reference_decoder_->Decode(reference_id);             \
             new_object = reinterpret_cast<Object*>(address);                   \
+          } else if (where == kAttachedReference) {                            \
+            int index = source_->GetInt();                                     \
+            new_object = *attached_objects_->at(index);                        \
+            ASSERT(!Heap::InNewSpace(new_object));                             \
           } else if (where == kBackref) {                                      \
             emit_write_barrier =                                               \
               (space_number == NEW_SPACE && source_space != NEW_SPACE);        \
@@ -879,6 +899,14 @@ void Deserializer::ReadChunk(Object** current,
       // current object.
       CASE_STATEMENT(kRootArray, kPlain, kStartOfObject, 0)
       CASE_BODY(kRootArray, kPlain, kStartOfObject, 0, kUnknownOffsetFromStart)
+      // Find a code object in the roots array and write a pointer to its first
+      // instruction to the current code object.
+      CASE_STATEMENT(kRootArray, kFromCode, kFirstInstruction, 0)
+      CASE_BODY(kRootArray,
+                kFromCode,
+                kFirstInstruction,
+                0,
+                kUnknownOffsetFromStart)
       // Find an object in the partial snapshots cache and write a pointer to it
       // to the current object.
       CASE_STATEMENT(kPartialSnapshotCache, kPlain, kStartOfObject, 0)
@@ -903,6 +931,22 @@ void Deserializer::ReadChunk(Object** current,
                 kStartOfObject,
                 0,
                 kUnknownOffsetFromStart)
+      // Find an object that was attached to the deserializer and write a
+      // pointer to it to the current object.
+      CASE_STATEMENT(kAttachedReference, kPlain, kStartOfObject, 0)
+      CASE_BODY(kAttachedReference,
+                kPlain,
+                kStartOfObject,
+                0,
+                kUnknownOffsetFromStart)
+      // Find a code object that was attached to the deserializer and write a
+      // pointer to its first instruction to the current code object.
+      CASE_STATEMENT(kAttachedReference, kFromCode, kFirstInstruction, 0)
+      CASE_BODY(kAttachedReference,
+                kFromCode,
+                kFirstInstruction,
+                0,
+                kUnknownOffsetFromStart)
 
 #undef CASE_STATEMENT
 #undef CASE_BODY
@@ -1007,11 +1051,7 @@ void StartupSerializer::SerializeStrongReferences() {
   CHECK(HandleScopeImplementer::instance()->blocks()->is_empty());
   CHECK_EQ(0, GlobalHandles::NumberOfWeakHandles());
   // We don't support serializing installed extensions.
-  for (RegisteredExtension* ext = RegisteredExtension::first_extension();
-       ext != NULL;
-       ext = ext->next()) {
-    CHECK_NE(v8::INSTALLED, ext->state());
-  }
+  CHECK(!Bootstrapper::HasInstalledExtensions());
   Heap::IterateStrongRoots(this, VISIT_ONLY_STRONG);
 }
 
@@ -1023,13 +1063,14 @@ void PartialSerializer::Serialize(Object** object) {
   // will contain some references needed to decode the partial snapshot.  We
   // fill it up with undefineds so it has a predictable length so the
   // deserialization code doesn't need to know the length.
-  for (int index = partial_snapshot_cache_length_;
+  SerializerDeserializer::Data* cache = SerializerDeserializer::data();
+  for (int index = cache->partial_snapshot_cache_length_;
        index < kPartialSnapshotCacheCapacity;
        index++) {
-    partial_snapshot_cache_[index] = Heap::undefined_value();
-    startup_serializer_->VisitPointer(&partial_snapshot_cache_[index]);
+    cache->partial_snapshot_cache_[index] = Heap::undefined_value();
+    startup_serializer_->VisitPointer(&cache->partial_snapshot_cache_[index]);
   }
-  partial_snapshot_cache_length_ = kPartialSnapshotCacheCapacity;
+  cache->partial_snapshot_cache_length_ = kPartialSnapshotCacheCapacity;
 }
 
 
@@ -1048,9 +1089,7 @@ void Serializer::VisitPointers(Object** start, Object** end) {
 }
 
 
-Object* SerializerDeserializer::partial_snapshot_cache_[
-    kPartialSnapshotCacheCapacity];
-int SerializerDeserializer::partial_snapshot_cache_length_ = 0;
+DEFINE_ISOLATE_COMPONENT(SerializerDeserializer)
 
 
 // This ensures that the partial snapshot cache keeps things alive during GC and
@@ -1062,9 +1101,10 @@ int SerializerDeserializer::partial_snapshot_cache_length_ = 0;
 // deserialization we therefore need to visit the cache array.  This fills it up
 // with pointers to deserialized objects.
 void SerializerDeserializer::Iterate(ObjectVisitor* visitor) {
+  Data* data = SerializerDeserializer::data();
   visitor->VisitPointers(
-      &partial_snapshot_cache_[0],
-      &partial_snapshot_cache_[partial_snapshot_cache_length_]);
+      &data->partial_snapshot_cache_[0],
+      &data->partial_snapshot_cache_[data->partial_snapshot_cache_length_]);
 }
 
 
@@ -1072,27 +1112,28 @@ void SerializerDeserializer::Iterate(ObjectVisitor* visitor) {
 // the root iteration code (above) will iterate over array elements, writing the
 // references to deserialized objects in them.
 void SerializerDeserializer::SetSnapshotCacheSize(int size) {
-  partial_snapshot_cache_length_ = size;
+  data()->partial_snapshot_cache_length_ = size;
 }
 
 
 int PartialSerializer::PartialSnapshotCacheIndex(HeapObject* heap_object) {
-  for (int i = 0; i < partial_snapshot_cache_length_; i++) {
-    Object* entry = partial_snapshot_cache_[i];
+  SerializerDeserializer::Data* cache = SerializerDeserializer::data();
+  for (int i = 0; i < cache->partial_snapshot_cache_length_; i++) {
+    Object* entry = cache->partial_snapshot_cache_[i];
     if (entry == heap_object) return i;
   }
 
   // We didn't find the object in the cache.  So we add it to the cache and
   // then visit the pointer so that it becomes part of the startup snapshot
   // and we can refer to it from the partial snapshot.
-  int length = partial_snapshot_cache_length_;
+  int length = cache->partial_snapshot_cache_length_;
   CHECK(length < kPartialSnapshotCacheCapacity);
-  partial_snapshot_cache_[length] = heap_object;
-  startup_serializer_->VisitPointer(&partial_snapshot_cache_[length]);
+  cache->partial_snapshot_cache_[length] = heap_object;
+  startup_serializer_->VisitPointer(&cache->partial_snapshot_cache_[length]);
   // We don't recurse from the startup snapshot generator into the partial
   // snapshot generator.
-  ASSERT(length == partial_snapshot_cache_length_);
-  return partial_snapshot_cache_length_++;
+  ASSERT(length == cache->partial_snapshot_cache_length_);
+  return cache->partial_snapshot_cache_length_++;
 }
 
 
@@ -1181,7 +1222,7 @@ void StartupSerializer::SerializeObject(
 
 
 void StartupSerializer::SerializeWeakReferences() {
-  for (int i = partial_snapshot_cache_length_;
+  for (int i = SerializerDeserializer::data()->partial_snapshot_cache_length_;
        i < kPartialSnapshotCacheCapacity;
        i++) {
     sink_->Put(kRootArray + kPlain + kStartOfObject, "RootSerialization");
@@ -1241,7 +1282,7 @@ void PartialSerializer::SerializeObject(
 
 
 void Serializer::ObjectSerializer::Serialize() {
-  int space = Serializer::SpaceOfObject(object_);
+  int space = serializer_->SpaceOfObject(object_);
   int size = object_->Size();
 
   sink_->Put(kNewObject + reference_representation_ + space,
@@ -1448,4 +1489,495 @@ int Serializer::Allocate(int space, int size, bool* new_page) {
 }
 
 
+// A sink that appends to a list of bytes.
+class ListSnapshotByteSink : public SnapshotByteSink {
+ public:
+  explicit ListSnapshotByteSink(List<byte>* data) : data_(data) { }
+  virtual void Put(int byte, const char* description) {
+    data_->Add(static_cast<uint8_t>(byte));
+  }
+  virtual int Position() { return data_->length(); }
+
+ private:
+  List<byte>* data_;
+};
+
+
+// The objects attached to a code cache, which are written to the start of
+// the cache.  The attachments are numbered in the order in which they are
+// written, starting with the script, which is not written.  A code stub is
+// written after the code stubs it refers to.
+class CodeSerializer::Attachments {
+ public:
+  explicit Attachments(Script* script)
+      : sink_(&data_),
+        count_(1),
+        failed_(false) {
+    indices_.AddMapping(script, 0);
+  }
+
+  int IndexOf(HeapObject* object) {
+    return indices_.IsMapped(object) ? indices_.MappedTo(object)
+                                     : kNotAttached;
+  }
+
+  // Starts writing the next attachment and returns its index.
+  int Add(HeapObject* object, AttachmentKind kind) {
+    indices_.AddMapping(object, count_);
+    sink_.Put(kind, "AttachmentKind");
+    return count_++;
+  }
+
+  SnapshotByteSink* sink() { return &sink_; }
+  List<byte>* data() { return &data_; }
+  int count() { return count_; }
+  List<Code*>* stubs_in_progress() { return &stubs_in_progress_; }
+
+  void Fail() { failed_ = true; }
+  bool failed() { return failed_; }
+
+ private:
+  List<byte> data_;
+  ListSnapshotByteSink sink_;
+  SerializationAddressMapper indices_;
+  List<Code*> stubs_in_progress_;
+  int count_;
+  bool failed_;
+};
+
+
+static const uint32_t kCodeCacheMagicNumber = 0xC0DECAC4;
+static const int kCodeCacheHeaderWords = 5;
+static const int kCodeCacheHeaderSize = kCodeCacheHeaderWords * kIntSize;
+
+
+static uint32_t HashBytes(uint32_t hash, const byte* data, int length) {
+  for (int i = 0; i < length; i++) {
+    hash = hash * 31 + data[i];
+  }
+  return hash;
+}
+
+
+// Code caches are only valid for VMs with the same version, configuration
+// and flags as the VM that created them.
+static uint32_t CodeCacheConfigurationHash() {
+  static const char* kConfiguration =
+#if defined(V8_TARGET_ARCH_IA32)
+      "ia32"
+#elif defined(V8_TARGET_ARCH_X64)
+      "x64"
+#elif defined(V8_TARGET_ARCH_ARM)
+      "arm"
+#else
+      "other"
+#endif
+#ifdef DEBUG
+      " debug"
+#endif
+#ifdef ENABLE_DEBUGGER_SUPPORT
+      " debugger"
+#endif
+#ifdef ENABLE_LOGGING_AND_PROFILING
+      " logging"
+#endif
+      "";
+  uint32_t hash = HashBytes(0, reinterpret_cast<const byte*>(kConfiguration),
+                            StrLength(kConfiguration));
+  char version[128];
+  Version::GetString(Vector<char>(version, sizeof(version)));
+  hash = HashBytes(hash, reinterpret_cast<const byte*>(version),
+                   StrLength(version));
+  List<const char*>* flags = FlagList::argv();
+  for (int i = 0; i < flags->length(); i++) {
+    const char* flag = flags->at(i);
+    hash = HashBytes(hash, reinterpret_cast<const byte*>(flag),
+                     StrLength(flag) + 1);
+    DeleteArray(flag);
+  }
+  delete flags;
+  return hash;
+}
+
+
+// The stubs in the non-monomorphic stub cache are only shared through the
+// cache.  Like the code generators this also makes the call IC stub for
+// calls outside of loops, which may be needed when the IC is cleared.
+static Handle<Object> ComputeStubCacheEntry(Code::Kind kind,
+                                            InLoopFlag in_loop,
+                                            int argc) {
+  if (kind == Code::STUB) {
+    CALL_HEAP_FUNCTION(StubCache::ComputeLazyCompile(argc), Object);
+  }
+  if (in_loop == IN_LOOP) ComputeStubCacheEntry(kind, NOT_IN_LOOP, argc);
+  CALL_HEAP_FUNCTION(StubCache::ComputeCallInitialize(argc, in_loop, kind),
+                     Object);
+}
+
+
+static uint32_t SourceHash(String* source) {
+  return source->Hash() ^ static_cast<uint32_t>(source->length());
+}
+
+
+CodeSerializer::CodeGenerationScope::CodeGenerationScope()
+    : serialization_was_enabled_(data()->serialization_enabled_),
+      code_stubs_(Heap::code_stubs()) {
+  // Unlike Serializer::Enable this may be used after code has been
+  // generated without serialization, because the code cache only refers to
+  // code generated in the scope and to code that is attached.
+  data()->serialization_enabled_ = true;
+  Heap::public_set_code_stubs(*Factory::NewNumberDictionary(16));
+}
+
+
+CodeSerializer::CodeGenerationScope::~CodeGenerationScope() {
+  data()->serialization_enabled_ = serialization_was_enabled_;
+  Heap::public_set_code_stubs(*code_stubs_);
+}
+
+
+Vector<byte> CodeSerializer::Serialize(Handle<SharedFunctionInfo> info) {
+  ASSERT(Serializer::enabled());
+  List<byte> payload;
+  ListSnapshotByteSink sink(&payload);
+  {
+    Attachments attachments(Script::cast(info->script()));
+    List<byte> body;
+    ListSnapshotByteSink body_sink(&body);
+    SerializeChunk(*info, &attachments, NULL, &body_sink);
+    if (attachments.failed()) return Vector<byte>();
+    sink.PutInt(attachments.count(), "AttachmentCount");
+    payload.AddAll(*attachments.data());
+    payload.AddAll(body);
+  }
+
+  int length = kCodeCacheHeaderSize + payload.length();
+  byte* data = NewArray<byte>(length);
+  uint32_t header[kCodeCacheHeaderWords] = {
+    kCodeCacheMagicNumber,
+    CodeCacheConfigurationHash(),
+    SourceHash(String::cast(Script::cast(info->script())->source())),
+    static_cast<uint32_t>(payload.length()),
+    HashBytes(0, payload.ToVector().start(), payload.length())
+  };
+  memcpy(data, header, kCodeCacheHeaderSize);
+  memcpy(data + kCodeCacheHeaderSize,
+         payload.ToVector().start(),
+         payload.length());
+  return Vector<byte>(data, length);
+}
+
+
+Handle<SharedFunctionInfo> CodeSerializer::Deserialize(
+    Vector<const byte> data,
+    Handle<Script> script) {
+  if (data.length() < kCodeCacheHeaderSize) {
+    return Handle<SharedFunctionInfo>::null();
+  }
+  uint32_t header[kCodeCacheHeaderWords];
+  memcpy(header, data.start(), kCodeCacheHeaderSize);
+  const byte* payload = data.start() + kCodeCacheHeaderSize;
+  int payload_length = data.length() - kCodeCacheHeaderSize;
+  if (header[0] != kCodeCacheMagicNumber ||
+      header[1] != CodeCacheConfigurationHash() ||
+      header[2] != SourceHash(String::cast(script->source())) ||
+      header[3] != static_cast<uint32_t>(payload_length) ||
+      header[4] != HashBytes(0, payload, payload_length)) {
+    return Handle<SharedFunctionInfo>::null();
+  }
+
+  SnapshotByteSource source(payload, payload_length);
+  List<Handle<Object> > attached;
+  attached.Add(script);
+  int count = source.GetInt();
+  for (int i = 1; i < count; i++) {
+    switch (source.Get()) {
+      case kSymbol: {
+        int length = source.GetInt();
+        const char* chars =
+            reinterpret_cast<const char*>(source.GetBlock(length));
+        attached.Add(Factory::LookupSymbol(Vector<const char>(chars, length)));
+        break;
+      }
+      case kBuiltin: {
+        Builtins::Name name = static_cast<Builtins::Name>(source.GetInt());
+        attached.Add(Handle<Object>(Builtins::builtin(name)));
+        break;
+      }
+      case kStubCacheEntry: {
+        Code::Kind kind = static_cast<Code::Kind>(source.GetInt());
+        InLoopFlag in_loop = static_cast<InLoopFlag>(source.GetInt());
+        int argc = source.GetInt();
+        attached.Add(ComputeStubCacheEntry(kind, in_loop, argc));
+        break;
+      }
+      case kCodeStub:
+        attached.Add(DeserializeCodeStub(&source, &attached));
+        break;
+      default:
+        UNREACHABLE();
+    }
+  }
+  Handle<Object> result = DeserializeChunk(&source, &attached);
+  ASSERT(source.AtEOF());
+  return Handle<SharedFunctionInfo>::cast(result);
+}
+
+
+// A chunk holds the sizes of the spaces used by a serialized object graph
+// followed by the serialized data.
+void CodeSerializer::SerializeChunk(Object* object,
+                                    Attachments* attachments,
+                                    Code* stub,
+                                    SnapshotByteSink* sink) {
+  List<byte> data;
+  ListSnapshotByteSink data_sink(&data);
+  CodeSerializer serializer(&data_sink, attachments, stub);
+  serializer.VisitPointer(&object);
+  for (int i = FIRST_SPACE; i <= LAST_SPACE; i++) {
+    sink->PutInt(serializer.CurrentAllocationAddress(i), "SpaceSize");
+  }
+  sink->PutInt(data.length(), "ChunkLength");
+  for (int i = 0; i < data.length(); i++) {
+    sink->Put(data[i], "Byte");
+  }
+}
+
+
+Handle<Object> CodeSerializer::DeserializeChunk(
+    SnapshotByteSource* source,
+    List<Handle<Object> >* attached) {
+  int sizes[LAST_SPACE + 1];
+  for (int i = FIRST_SPACE; i <= LAST_SPACE; i++) {
+    sizes[i] = source->GetInt();
+  }
+  int length = source->GetInt();
+  SnapshotByteSource chunk(source->GetBlock(length), length);
+  Heap::ReserveSpace(sizes[NEW_SPACE],
+                     sizes[OLD_POINTER_SPACE],
+                     sizes[OLD_DATA_SPACE],
+                     sizes[CODE_SPACE],
+                     sizes[MAP_SPACE],
+                     sizes[CELL_SPACE],
+                     sizes[LO_SPACE]);
+  Object* root;
+  {
+    Deserializer deserializer(&chunk);
+    deserializer.set_attached_objects(attached);
+    deserializer.DeserializePartial(&root);
+  }
+  return Handle<Object>(root);
+}
+
+
+void CodeSerializer::SkipChunk(SnapshotByteSource* source) {
+  for (int i = FIRST_SPACE; i <= LAST_SPACE; i++) {
+    source->GetInt();
+  }
+  source->GetBlock(source->GetInt());
+}
+
+
+// Code stubs that the VM already has are used instead of the copies in the
+// code cache.  The copies of the others are added to Heap::code_stubs().
+Handle<Object> CodeSerializer::DeserializeCodeStub(
+    SnapshotByteSource* source,
+    List<Handle<Object> >* attached) {
+  uint32_t key = source->GetInt();
+  int entry = Heap::code_stubs()->FindEntry(key);
+  if (entry != NumberDictionary::kNotFound) {
+    SkipChunk(source);
+    return Handle<Object>(Heap::code_stubs()->ValueAt(entry));
+  }
+  Handle<Code> code = Handle<Code>::cast(DeserializeChunk(source, attached));
+  Handle<NumberDictionary> dictionary =
+      Factory::DictionaryAtNumberPut(
+          Handle<NumberDictionary>(Heap::code_stubs()),
+          key,
+          code);
+  Heap::public_set_code_stubs(*dictionary);
+  if (code->kind() == Code::STUB || code->kind() == Code::BINARY_OP_IC) {
+    PROFILE(CodeCreateEvent(Logger::STUB_TAG,
+                            *code,
+                            CodeStub::MajorName(code->major_key(), true)));
+  }
+  return code;
+}
+
+
+void CodeSerializer::SerializeObject(
+    Object* o,
+    HowToCode how_to_code,
+    WhereToPoint where_to_point) {
+  CHECK(o->IsHeapObject());
+  HeapObject* heap_object = HeapObject::cast(o);
+
+  if (address_mapper_.IsMapped(heap_object)) {
+    int space = SpaceOfAlreadySerializedObject(heap_object);
+    int address = address_mapper_.MappedTo(heap_object);
+    SerializeReferenceToPreviousObject(space,
+                                       address,
+                                       how_to_code,
+                                       where_to_point);
+    return;
+  }
+
+  int index = attachments_->IndexOf(heap_object);
+  if (index == kNotAttached) {
+    int root_index = RootIndex(heap_object);
+    if (root_index != kInvalidRootIndex) {
+      sink_->Put(kRootArray + how_to_code + where_to_point,
+                 "RootSerialization");
+      sink_->PutInt(root_index, "root_index");
+      return;
+    }
+    if (ShouldBeCopied(heap_object)) {
+      ObjectSerializer serializer(this,
+                                  heap_object,
+                                  sink_,
+                                  how_to_code,
+                                  where_to_point);
+      serializer.Serialize();
+      return;
+    }
+    index = Attach(heap_object);
+    if (index == kNotAttached) {
+      // The code cache is discarded, so the reference is written only to
+      // keep the data consistent.
+      attachments_->Fail();
+      index = 0;
+    }
+  }
+  sink_->Put(kAttachedReference + how_to_code + where_to_point,
+             "AttachedReference");
+  sink_->PutInt(index, "attachment_index");
+}
+
+
+bool CodeSerializer::ShouldBeCopied(HeapObject* object) {
+  if (object->IsCode()) {
+    Code* code = Code::cast(object);
+    bool is_own_code =
+        stub_ == NULL ? code->kind() == Code::FUNCTION : code == stub_;
+    return is_own_code && CanBeRelocated(code);
+  }
+  if (object->IsString()) {
+    return !object->IsSymbol() && !object->IsExternalString();
+  }
+  if (object->IsFixedArray()) {
+    return object->map() == Heap::fixed_array_map();
+  }
+  return object->IsSharedFunctionInfo() || object->IsHeapNumber();
+}
+
+
+// Code can be moved to another VM if all the external addresses it refers to
+// are known to the serializer.
+bool CodeSerializer::CanBeRelocated(Code* code) {
+  int mode_mask = RelocInfo::ModeMask(RelocInfo::EXTERNAL_REFERENCE) |
+                  RelocInfo::ModeMask(RelocInfo::RUNTIME_ENTRY) |
+                  RelocInfo::ModeMask(RelocInfo::INTERNAL_REFERENCE);
+  for (RelocIterator it(code, mode_mask); !it.done(); it.next()) {
+    RelocInfo::Mode mode = it.rinfo()->rmode();
+    Address target;
+    if (mode == RelocInfo::EXTERNAL_REFERENCE) {
+      target = *it.rinfo()->target_reference_address();
+    } else if (mode == RelocInfo::RUNTIME_ENTRY) {
+      target = it.rinfo()->target_address();
+    } else {
+      return false;
+    }
+    if (target != NULL && EncodeExternalReference(target) == 0) return false;
+  }
+  return true;
+}
+
+
+int CodeSerializer::Attach(HeapObject* object) {
+  SnapshotByteSink* sink = attachments_->sink();
+  if (object->IsSymbol()) {
+    String* symbol = String::cast(object);
+    int length;
+    SmartPointer<char> chars =
+        symbol->ToCString(ALLOW_NULLS, ROBUST_STRING_TRAVERSAL, 0, -1, &length);
+    int index = attachments_->Add(object, kSymbol);
+    sink->PutInt(length, "SymbolLength");
+    for (int i = 0; i < length; i++) {
+      sink->Put(chars[i], "SymbolChar");
+    }
+    return index;
+  }
+
+  if (!object->IsCode()) return kNotAttached;
+  Code* code = Code::cast(object);
+
+  for (int i = 0; i < Builtins::builtin_count; i++) {
+    if (Builtins::builtin(static_cast<Builtins::Name>(i)) == code) {
+      int index = attachments_->Add(object, kBuiltin);
+      sink->PutInt(i, "BuiltinIndex");
+      return index;
+    }
+  }
+
+  Code::Kind kind = code->kind();
+  if (kind == Code::STUB ||
+      kind == Code::CALL_IC ||
+      kind == Code::KEYED_CALL_IC) {
+    InLoopFlag in_loop = kind == Code::STUB ? NOT_IN_LOOP : code->ic_in_loop();
+    int argc = code->arguments_count();
+    Code::Flags flags =
+        Code::ComputeFlags(kind, in_loop, UNINITIALIZED, NORMAL, argc);
+    NumberDictionary* cache = Heap::non_monomorphic_cache();
+    int entry = cache->FindEntry(flags);
+    if (code->flags() == flags &&
+        entry != NumberDictionary::kNotFound &&
+        cache->ValueAt(entry) == code) {
+      int index = attachments_->Add(object, kStubCacheEntry);
+      sink->PutInt(kind, "Kind");
+      sink->PutInt(in_loop, "InLoop");
+      sink->PutInt(argc, "ArgumentsCount");
+      return index;
+    }
+    if (kind != Code::STUB) return kNotAttached;
+  }
+
+  Object* key = Heap::code_stubs()->SlowReverseLookup(code);
+  if (!key->IsNumber() || attachments_->stubs_in_progress()->Contains(code)) {
+    return kNotAttached;
+  }
+  // The code stubs the stub refers to are attached while it is serialized.
+  List<byte> chunk;
+  ListSnapshotByteSink chunk_sink(&chunk);
+  attachments_->stubs_in_progress()->Add(code);
+  SerializeChunk(code, attachments_, code, &chunk_sink);
+  attachments_->stubs_in_progress()->RemoveLast();
+  int index = attachments_->Add(object, kCodeStub);
+  sink->PutInt(static_cast<uint32_t>(key->Number()), "CodeStubKey");
+  for (int i = 0; i < chunk.length(); i++) {
+    sink->Put(chunk[i], "Byte");
+  }
+  return index;
+}
+
+
+int CodeSerializer::SpaceOfObject(HeapObject* object) {
+  if (!Heap::InNewSpace(object)) return Serializer::SpaceOfObject(object);
+  if (object->Size() > Page::kMaxHeapObjectSize) {
+    return object->IsFixedArray() ? kLargeFixedArray : kLargeData;
+  }
+  return Heap::TargetSpaceId(object->map()->instance_type());
+}
+
+
+int CodeSerializer::SpaceOfAlreadySerializedObject(HeapObject* object) {
+  if (!Heap::InNewSpace(object)) {
+    return Serializer::SpaceOfAlreadySerializedObject(object);
+  }
+  if (object->Size() > Page::kMaxHeapObjectSize) return LO_SPACE;
+  return Heap::TargetSpaceId(object->map()->instance_type());
+}
+
+
+
 } }  // namespace v8::internal
@@ -130,6 +130,14 @@ class SnapshotByteSource {
 
   int position() { return position_; }
 
+  // Returns the next number_of_bytes bytes and skips over them.
+  const byte* GetBlock(int number_of_bytes) {
+    ASSERT(position_ + number_of_bytes <= length_);
+    const byte* block = data_ + position_;
+    position_ += number_of_bytes;
+    return block;
+  }
+
  private:
   const byte* data_;
   int length_;
@@ -188,7 +196,8 @@ class SerializerDeserializer: public ObjectVisitor {
     kRootArray = 0x9,               // Object is found in root array.
     kPartialSnapshotCache = 0xa,    // Object is in the cache.
     kExternalReference = 0xb,       // Pointer to an external reference.
-    // 0xc-0xf                         Free.
+    kAttachedReference = 0xc,       // Object is attached on deserialization.
+    // 0xd-0xf                         Free.
     kBackref = 0x10,                 // Object is described relative to end.
     // 0x11-0x18                       One per space.
     // 0x19-0x1f                       Common backref offsets.
@@ -247,9 +256,20 @@ class SerializerDeserializer: public ObjectVisitor {
     return space >= FIRST_PAGED_SPACE && space <= LAST_PAGED_SPACE;
   }
 
-  static int partial_snapshot_cache_length_;
   static const int kPartialSnapshotCacheCapacity = 1300;
-  static Object* partial_snapshot_cache_[];
+
+  class Data {
+   public:
+    int partial_snapshot_cache_length_;
+    Object* partial_snapshot_cache_[kPartialSnapshotCacheCapacity];
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(Isolate::Current()->component_data(
+        Isolate::kSerializerDeserializerData));
+  }
+
+  friend class Isolate;
 };
 
 
@@ -292,6 +312,11 @@ class Deserializer: public SerializerDeserializer {
   // Deserialize a single object and the objects reachable from it.
   void DeserializePartial(Object** root);
 
+  // Set the objects that kAttachedReference tags refer to by index.
+  void set_attached_objects(List<Handle<Object> >* attached_objects) {
+    attached_objects_ = attached_objects;
+  }
+
 #ifdef DEBUG
   virtual void Synchronize(const char* tag);
 #endif
@@ -320,7 +345,8 @@ class Deserializer: public SerializerDeserializer {
   List<Address> pages_[SerializerDeserializer::kNumberOfSpaces];
 
   SnapshotByteSource* source_;
-  static ExternalReferenceDecoder* external_reference_decoder_;
+  List<Handle<Object> >* attached_objects_;
+  ExternalReferenceDecoder* external_reference_decoder_;
   // This is the address of the next object that will be allocated in each
   // space.  It is used to calculate the addresses of back-references.
   Address high_water_[LAST_SPACE + 1];
@@ -411,17 +437,18 @@ class Serializer : public SerializerDeserializer {
   }
 
   static void Enable() {
-    if (!serialization_enabled_) {
-      ASSERT(!too_late_to_enable_now_);
+    Data* data = Serializer::data();
+    if (!data->serialization_enabled_) {
+      ASSERT(!data->too_late_to_enable_now_);
     }
-    serialization_enabled_ = true;
+    data->serialization_enabled_ = true;
   }
 
-  static void Disable() { serialization_enabled_ = false; }
+  static void Disable() { data()->serialization_enabled_ = false; }
   // Call this when you have made use of the fact that there is no serialization
   // going on.
-  static void TooLateToEnableNow() { too_late_to_enable_now_ = true; }
-  static bool enabled() { return serialization_enabled_; }
+  static void TooLateToEnableNow() { data()->too_late_to_enable_now_ = true; }
+  static bool enabled() { return data()->serialization_enabled_; }
   SerializationAddressMapper* address_mapper() { return &address_mapper_; }
 #ifdef DEBUG
   virtual void Synchronize(const char* tag);
@@ -481,11 +508,11 @@ class Serializer : public SerializerDeserializer {
   // object space it may return kLargeCode or kLargeFixedArray in order
   // to indicate to the deserializer what kind of large object allocation
   // to make.
-  static int SpaceOfObject(HeapObject* object);
+  virtual int SpaceOfObject(HeapObject* object);
   // This just returns the space of the object.  It will return LO_SPACE
   // for all large objects since you can't check the type of the object
   // once the map has been used for the serialization address.
-  static int SpaceOfAlreadySerializedObject(HeapObject* object);
+  virtual int SpaceOfAlreadySerializedObject(HeapObject* object);
   int Allocate(int space, int size, bool* new_page_started);
   int EncodeExternalReference(Address addr) {
     return external_reference_encoder_->Encode(addr);
@@ -499,12 +526,25 @@ class Serializer : public SerializerDeserializer {
   SnapshotByteSink* sink_;
   int current_root_index_;
   ExternalReferenceEncoder* external_reference_encoder_;
-  static bool serialization_enabled_;
-  // Did we already make use of the fact that serialization was not enabled?
-  static bool too_late_to_enable_now_;
   int large_object_total_;
   SerializationAddressMapper address_mapper_;
 
+  // Hides SerializerDeserializer::Data, so the partial snapshot cache is
+  // reached through SerializerDeserializer::data() in the serializers.
+  class Data {
+   public:
+    bool serialization_enabled_;
+    // Did we already make use of the fact that serialization was not
+    // enabled?
+    bool too_late_to_enable_now_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kSerializerData));
+  }
+
+  friend class Isolate;
   friend class ObjectSerializer;
   friend class Deserializer;
 
@@ -545,6 +585,93 @@ class PartialSerializer : public Serializer {
 };
 
 
+// Serializes a script compiled by Compiler::CompileForCodeCache into a code
+// cache that can be loaded by another VM with the same version, build
+// configuration and flags, see v8::Script::Compile.  The code cache holds the
+// SharedFunctionInfo tree of the script and the code generated for it.
+// Objects that must be unique in a VM, like symbols, builtins and the stubs
+// in the non-monomorphic stub cache, are not copied but attached on
+// deserialization, and so is the script, which is created by the caller.
+// Code stubs are copied, but are only used if the loading VM doesn't have
+// them yet.
+class CodeSerializer : public PartialSerializer {
+ public:
+  // Generates code that can be serialized.  While the scope is active
+  // references to external addresses are recorded as for the snapshot and
+  // code stubs are compiled again into a separate dictionary, because the
+  // ones in Heap::code_stubs() may embed such addresses.  Serialization must
+  // take place inside the scope too.
+  class CodeGenerationScope BASE_EMBEDDED {
+   public:
+    CodeGenerationScope();
+    ~CodeGenerationScope();
+
+   private:
+    bool serialization_was_enabled_;
+    Handle<NumberDictionary> code_stubs_;
+  };
+
+  // Returns the code cache for a script or an empty vector if the code
+  // refers to objects that can't be cached.  The caller owns the data.
+  static Vector<byte> Serialize(Handle<SharedFunctionInfo> info);
+
+  // Returns the SharedFunctionInfo of the script or a null handle if the code
+  // cache was not made for the source of the script by a VM like this one.
+  static Handle<SharedFunctionInfo> Deserialize(Vector<const byte> data,
+                                                Handle<Script> script);
+
+  virtual void SerializeObject(Object* o,
+                               HowToCode how_to_code,
+                               WhereToPoint where_to_point);
+
+ protected:
+  virtual bool ShouldBeInThePartialSnapshotCache(HeapObject* o) {
+    return false;
+  }
+  // Objects in new space are deserialized into the old spaces.
+  virtual int SpaceOfObject(HeapObject* object);
+  virtual int SpaceOfAlreadySerializedObject(HeapObject* object);
+
+ private:
+  class Attachments;
+
+  enum AttachmentKind {
+    kSymbol,
+    kBuiltin,
+    kStubCacheEntry,
+    kCodeStub
+  };
+
+  static const int kNotAttached = -1;
+
+  // Serializes the objects reachable from object, which is either the
+  // SharedFunctionInfo of the script or a code stub.
+  CodeSerializer(SnapshotByteSink* sink, Attachments* attachments, Code* stub)
+      : PartialSerializer(NULL, sink),
+        attachments_(attachments),
+        stub_(stub) { }
+
+  static void SerializeChunk(Object* object,
+                             Attachments* attachments,
+                             Code* stub,
+                             SnapshotByteSink* sink);
+  static Handle<Object> DeserializeChunk(SnapshotByteSource* source,
+                                         List<Handle<Object> >* attached);
+  static void SkipChunk(SnapshotByteSource* source);
+  static Handle<Object> DeserializeCodeStub(SnapshotByteSource* source,
+                                            List<Handle<Object> >* attached);
+
+  bool ShouldBeCopied(HeapObject* object);
+  bool CanBeRelocated(Code* code);
+  int Attach(HeapObject* object);
+
+  Attachments* attachments_;
+  Code* stub_;
+
+  DISALLOW_COPY_AND_ASSIGN(CodeSerializer);
+};
+
+
 class StartupSerializer : public Serializer {
  public:
   explicit StartupSerializer(SnapshotByteSink* sink) : Serializer(sink) {
@@ -552,7 +679,7 @@ class StartupSerializer : public Serializer {
     // strong roots have been serialized we can create a partial snapshot
     // which will repopulate the cache with objects neede by that partial
     // snapshot.
-    partial_snapshot_cache_length_ = 0;
+    SerializerDeserializer::data()->partial_snapshot_cache_length_ = 0;
   }
   // Serialize the current state of the heap.  The order is:
   // 1) Strong references.
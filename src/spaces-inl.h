@@ -220,21 +220,23 @@ void Page::ClearRegionMarks(Address start, Address end, bool reaches_limit) {
 
 
 void Page::FlipMeaningOfInvalidatedWatermarkFlag() {
-  watermark_invalidated_mark_ ^= WATERMARK_INVALIDATED;
+  data()->watermark_invalidated_mark_ ^= WATERMARK_INVALIDATED;
 }
 
 
 bool Page::IsWatermarkValid() {
-  return (flags_ & WATERMARK_INVALIDATED) != watermark_invalidated_mark_;
+  return (flags_ & WATERMARK_INVALIDATED) !=
+      data()->watermark_invalidated_mark_;
 }
 
 
 void Page::InvalidateWatermark(bool value) {
   if (value) {
-    flags_ = (flags_ & ~WATERMARK_INVALIDATED) | watermark_invalidated_mark_;
+    flags_ = (flags_ & ~WATERMARK_INVALIDATED) |
+             data()->watermark_invalidated_mark_;
   } else {
     flags_ = (flags_ & ~WATERMARK_INVALIDATED) |
-             (watermark_invalidated_mark_ ^ WATERMARK_INVALIDATED);
+             (data()->watermark_invalidated_mark_ ^ WATERMARK_INVALIDATED);
   }
 
   ASSERT(IsWatermarkValid() == !value);
@@ -296,13 +298,13 @@ void Page::SetIsLargeObjectPage(bool is_large_object_page) {
 bool MemoryAllocator::IsValidChunk(int chunk_id) {
   if (!IsValidChunkId(chunk_id)) return false;
 
-  ChunkInfo& c = chunks_[chunk_id];
+  ChunkInfo& c = data()->chunks_[chunk_id];
   return (c.address() != NULL) && (c.size() != 0) && (c.owner() != NULL);
 }
 
 
 bool MemoryAllocator::IsValidChunkId(int chunk_id) {
-  return (0 <= chunk_id) && (chunk_id < max_nof_chunks_);
+  return (0 <= chunk_id) && (chunk_id < data()->max_nof_chunks_);
 }
 
 
@@ -312,7 +314,7 @@ bool MemoryAllocator::IsPageInSpace(Page* p, PagedSpace* space) {
   int chunk_id = GetChunkId(p);
   if (!IsValidChunkId(chunk_id)) return false;
 
-  ChunkInfo& c = chunks_[chunk_id];
+  ChunkInfo& c = data()->chunks_[chunk_id];
   return (c.address() <= p->address()) &&
          (p->address() < c.address() + c.size()) &&
          (space == c.owner());
@@ -343,15 +345,16 @@ void MemoryAllocator::SetNextPage(Page* prev, Page* next) {
 PagedSpace* MemoryAllocator::PageOwner(Page* page) {
   int chunk_id = GetChunkId(page);
   ASSERT(IsValidChunk(chunk_id));
-  return chunks_[chunk_id].owner();
+  return data()->chunks_[chunk_id].owner();
 }
 
 
 bool MemoryAllocator::InInitialChunk(Address address) {
-  if (initial_chunk_ == NULL) return false;
+  VirtualMemory* initial_chunk = data()->initial_chunk_;
+  if (initial_chunk == NULL) return false;
 
-  Address start = static_cast<Address>(initial_chunk_->address());
-  return (start <= address) && (address < start + initial_chunk_->size());
+  Address start = static_cast<Address>(initial_chunk->address());
+  return (start <= address) && (address < start + initial_chunk->size());
 }
 
 
@@ -371,14 +374,14 @@ void MemoryAllocator::Unprotect(Address start,
 
 void MemoryAllocator::ProtectChunkFromPage(Page* page) {
   int id = GetChunkId(page);
-  OS::Protect(chunks_[id].address(), chunks_[id].size());
+  OS::Protect(data()->chunks_[id].address(), data()->chunks_[id].size());
 }
 
 
 void MemoryAllocator::UnprotectChunkFromPage(Page* page) {
   int id = GetChunkId(page);
-  OS::Unprotect(chunks_[id].address(), chunks_[id].size(),
-                chunks_[id].owner()->executable() == EXECUTABLE);
+  OS::Unprotect(data()->chunks_[id].address(), data()->chunks_[id].size(),
+                data()->chunks_[id].owner()->executable() == EXECUTABLE);
 }
 
 #endif
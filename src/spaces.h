@@ -303,10 +303,20 @@ class Page {
   STATIC_CHECK(kBitsPerInt - kAllocationWatermarkOffsetShift >=
                kAllocationWatermarkOffsetBits);
 
-  // This field contains the meaning of the WATERMARK_INVALIDATED flag.
-  // Instead of clearing this flag from all pages we just flip
-  // its meaning at the beginning of a scavenge.
-  static intptr_t watermark_invalidated_mark_;
+  class Data {
+   public:
+    Data() : watermark_invalidated_mark_(WATERMARK_INVALIDATED) { }
+
+    // This field contains the meaning of the WATERMARK_INVALIDATED flag.
+    // Instead of clearing this flag from all pages we just flip
+    // its meaning at the beginning of a scavenge.
+    intptr_t watermark_invalidated_mark_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kPageData));
+  }
 
   //---------------------------------------------------------------------------
   // Page header description.
@@ -406,11 +416,11 @@ class CodeRange : public AllStatic {
   // manage it.
   static void TearDown();
 
-  static bool exists() { return code_range_ != NULL; }
+  static bool exists() { return data()->code_range_ != NULL; }
   static bool contains(Address address) {
-    if (code_range_ == NULL) return false;
-    Address start = static_cast<Address>(code_range_->address());
-    return start <= address && address < start + code_range_->size();
+    if (data()->code_range_ == NULL) return false;
+    Address start = static_cast<Address>(data()->code_range_->address());
+    return start <= address && address < start + data()->code_range_->size();
   }
 
   // Allocates a chunk of memory from the large-object portion of
@@ -420,8 +430,6 @@ class CodeRange : public AllStatic {
   static void FreeRawMemory(void* buf, size_t length);
 
  private:
-  // The reserved range of virtual memory that all code objects are put in.
-  static VirtualMemory* code_range_;
   // Plain old data class, just a struct plus a constructor.
   class FreeBlock {
    public:
@@ -434,14 +442,25 @@ class CodeRange : public AllStatic {
     size_t size;
   };
 
-  // Freed blocks of memory are added to the free list.  When the allocation
-  // list is exhausted, the free list is sorted and merged to make the new
-  // allocation list.
-  static List<FreeBlock> free_list_;
-  // Memory is allocated from the free blocks on the allocation list.
-  // The block at current_allocation_block_index_ is the current block.
-  static List<FreeBlock> allocation_list_;
-  static int current_allocation_block_index_;
+  class Data {
+   public:
+    // The reserved range of virtual memory that all code objects are put in.
+    VirtualMemory* code_range_;
+
+    // Freed blocks of memory are added to the free list.  When the
+    // allocation list is exhausted, the free list is sorted and merged to
+    // make the new allocation list.
+    List<FreeBlock> free_list_;
+    // Memory is allocated from the free blocks on the allocation list.
+    // The block at current_allocation_block_index_ is the current block.
+    List<FreeBlock> allocation_list_;
+    int current_allocation_block_index_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kCodeRangeData));
+  }
 
   // Finds a block on the allocation list that contains at least the
   // requested amount of memory.  If none is found, sorts and merges
@@ -451,6 +470,8 @@ class CodeRange : public AllStatic {
   // Compares the start addresses of two free blocks.
   static int CompareFreeBlockAddress(const FreeBlock* left,
                                      const FreeBlock* right);
+
+  friend class Isolate;
 };
 
 
@@ -560,10 +581,13 @@ class MemoryAllocator : public AllStatic {
   static void FreeRawMemory(void* buf, size_t length);
 
   // Returns the maximum available bytes of heaps.
-  static int Available() { return capacity_ < size_ ? 0 : capacity_ - size_; }
+  static int Available() {
+    Data* data = MemoryAllocator::data();
+    return data->capacity_ < data->size_ ? 0 : data->capacity_ - data->size_;
+  }
 
   // Returns allocated spaces in bytes.
-  static int Size() { return size_; }
+  static int Size() { return data()->size_; }
 
   // Returns maximum available bytes that the old space can have.
   static int MaxAvailable() {
@@ -623,15 +647,6 @@ class MemoryAllocator : public AllStatic {
   static const int kChunkSize = kPagesPerChunk * Page::kPageSize;
 
  private:
-  // Maximum space size in bytes.
-  static int capacity_;
-
-  // Allocated space size in bytes.
-  static int size_;
-
-  // The initial chunk of virtual memory.
-  static VirtualMemory* initial_chunk_;
-
   // Allocated chunk info: chunk start address, chunk size, and owning space.
   class ChunkInfo BASE_EMBEDDED {
    public:
@@ -651,16 +666,35 @@ class MemoryAllocator : public AllStatic {
     PagedSpace* owner_;
   };
 
-  // Chunks_, free_chunk_ids_ and top_ act as a stack of free chunk ids.
-  static List<ChunkInfo> chunks_;
-  static List<int> free_chunk_ids_;
-  static int max_nof_chunks_;
-  static int top_;
+  class Data {
+   public:
+    Data();
+
+    // Maximum space size in bytes.
+    int capacity_;
+
+    // Allocated space size in bytes.
+    int size_;
+
+    // The initial chunk of virtual memory.
+    VirtualMemory* initial_chunk_;
+
+    // Chunks_, free_chunk_ids_ and top_ act as a stack of free chunk ids.
+    List<ChunkInfo> chunks_;
+    List<int> free_chunk_ids_;
+    int max_nof_chunks_;
+    int top_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kMemoryAllocatorData));
+  }
 
   // Push/pop a free chunk id onto/from the stack.
   static void Push(int free_chunk_id);
   static int Pop();
-  static bool OutOfChunkIds() { return top_ == 0; }
+  static bool OutOfChunkIds() { return data()->top_ == 0; }
 
   // Frees a chunk.
   static void DeleteChunk(int chunk_id);
@@ -689,6 +723,8 @@ class MemoryAllocator : public AllStatic {
                                   size_t chunk_size,
                                   Page* prev,
                                   Page** last_page_in_use);
+
+  friend class Isolate;
 };
 
 
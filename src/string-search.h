@@ -0,0 +1,512 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef V8_STRING_SEARCH_H_
+#define V8_STRING_SEARCH_H_
+
+namespace v8 {
+namespace internal {
+
+
+// Constants shared by all instantiations of StringSearch.
+class StringSearchBase {
+ protected:
+  // Cap on the maximal shift in the Boyer-Moore implementation. By setting a
+  // limit, we can fix the size of tables. For a needle longer than this limit,
+  // search will not be optimal, since we only build tables for a suffix
+  // of the string, but it is a safe approximation.
+  static const int kBMMaxShift = 0xff;
+
+  // Reduce alphabet to this size.
+  // One of the tables used by Boyer-Moore and Boyer-Moore-Horspool has size
+  // proportional to the input alphabet. We reduce the alphabet size by
+  // equating input characters modulo a smaller alphabet size. This gives
+  // a potentially less efficient searching, but is a safe approximation.
+  // For needles using only characters in the same Unicode 256-code point page,
+  // there is no search speed degradation.
+  static const int kBMAlphabetSize = 0x100;
+
+  // For patterns below this length, the skip length of Boyer-Moore is too short
+  // to compensate for the algorithmic overhead compared to simple brute force.
+  static const int kBMMinPatternLength = 5;
+
+  static inline bool IsAsciiString(Vector<const char>) {
+    return true;
+  }
+
+  static inline bool IsAsciiString(Vector<const uc16> string) {
+    for (int i = 0, n = string.length(); i < n; i++) {
+      if (string[i] > String::kMaxAsciiCharCode) return false;
+    }
+    return true;
+  }
+};
+
+
+// A search for a fixed pattern in subject strings. The search strategy is
+// chosen once, when the object is created, and the Boyer-Moore tables are
+// built on demand the first time the simpler strategies turn out to be
+// doing badly. The tables are owned by the object, so a single instance
+// can be used for any number of searches for the same pattern, and
+// searches for different patterns do not interfere with each other.
+//
+// The pattern characters are not copied, so the object must not outlive
+// the pattern string or survive a GC that could move it.
+template <typename PatternChar, typename SubjectChar>
+class StringSearch : private StringSearchBase {
+ public:
+  explicit StringSearch(Vector<const PatternChar> pattern)
+      : pattern_(pattern),
+        start_(Max(0, pattern.length() - kBMMaxShift)) {
+    ASSERT(pattern.length() > 0);
+    if (sizeof(PatternChar) > sizeof(SubjectChar)) {
+      // An ASCII subject cannot contain a non-ASCII pattern.
+      if (!IsAsciiString(pattern_)) {
+        strategy_ = &FailSearch;
+        return;
+      }
+    }
+    int pattern_length = pattern_.length();
+    if (pattern_length == 1) {
+      strategy_ = &SingleCharSearch;
+    } else if (pattern_length < kBMMinPatternLength) {
+      strategy_ = &LinearSearch;
+    } else {
+      strategy_ = &InitialSearch;
+    }
+  }
+
+  // Returns the index of the first occurrence of the pattern in the subject
+  // at or after index, or -1 if there is none.
+  int Search(Vector<const SubjectChar> subject, int index) {
+    ASSERT(0 <= index && index <= subject.length());
+    return strategy_(this, subject, index);
+  }
+
+ private:
+  typedef int (*SearchFunction)(StringSearch<PatternChar, SubjectChar>*,
+                                Vector<const SubjectChar>,
+                                int);
+
+  static int FailSearch(StringSearch<PatternChar, SubjectChar>*,
+                        Vector<const SubjectChar>,
+                        int) {
+    return -1;
+  }
+
+  static int SingleCharSearch(StringSearch<PatternChar, SubjectChar>* search,
+                              Vector<const SubjectChar> subject,
+                              int index);
+
+  static int LinearSearch(StringSearch<PatternChar, SubjectChar>* search,
+                          Vector<const SubjectChar> subject,
+                          int index);
+
+  static int InitialSearch(StringSearch<PatternChar, SubjectChar>* search,
+                           Vector<const SubjectChar> subject,
+                           int index);
+
+  static int BoyerMooreHorspoolSearch(
+      StringSearch<PatternChar, SubjectChar>* search,
+      Vector<const SubjectChar> subject,
+      int index);
+
+  static int BoyerMooreSearch(StringSearch<PatternChar, SubjectChar>* search,
+                              Vector<const SubjectChar> subject,
+                              int index);
+
+  // Returns the first index at or after index where the first character
+  // of the pattern occurs, such that the rest of the pattern fits in the
+  // subject after it, or -1 if there is no such index.
+  static inline int FindFirstCharacter(Vector<const PatternChar> pattern,
+                                       Vector<const SubjectChar> subject,
+                                       int index);
+
+  void PopulateBoyerMooreHorspoolTable();
+
+  void PopulateBoyerMooreTable();
+
+  inline int CharOccurrence(int char_code) {
+    if (sizeof(SubjectChar) == 1) {
+      return bad_char_table_[char_code];
+    }
+    if (sizeof(PatternChar) == 1) {
+      if (char_code > String::kMaxAsciiCharCode) {
+        return -1;
+      }
+      return bad_char_table_[char_code];
+    }
+    // Both pattern and subject are UC16. Reduce character to equivalence
+    // class.
+    return bad_char_table_[char_code % kBMAlphabetSize];
+  }
+
+  // The good suffix tables only cover the last kBMMaxShift characters of
+  // the pattern, so they are accessed with an index biased by start_.
+  inline int& suffix(int index) {
+    ASSERT(index >= start_);
+    return suffix_table_[index - start_];
+  }
+
+  inline int& shift(int index) {
+    ASSERT(index >= start_);
+    return good_suffix_shift_table_[index - start_];
+  }
+
+  // The pattern to search for.
+  Vector<const PatternChar> pattern_;
+  // Pointer to implementation of the search.
+  SearchFunction strategy_;
+  // Cache value of Max(0, pattern_length() - kBMMaxShift)
+  int start_;
+
+  // Last occurrence in the pattern of each character (equivalence class),
+  // used by Boyer-Moore-Horspool and Boyer-Moore.
+  int bad_char_table_[kBMAlphabetSize];
+  // Good suffix tables, used by Boyer-Moore only.
+  int suffix_table_[kBMMaxShift + 1];
+  int good_suffix_shift_table_[kBMMaxShift + 1];
+
+  DISALLOW_COPY_AND_ASSIGN(StringSearch);
+};
+
+
+template <typename PatternChar, typename SubjectChar>
+int StringSearch<PatternChar, SubjectChar>::FindFirstCharacter(
+    Vector<const PatternChar> pattern,
+    Vector<const SubjectChar> subject,
+    int index) {
+  int max_n = subject.length() - pattern.length() + 1;
+  if (index >= max_n) return -1;
+  if (sizeof(SubjectChar) == 1) {
+    // A two-byte pattern is known to be ASCII here, see the constructor.
+    // The C library's memchr scans many characters at a time on all the
+    // platforms we care about.
+    const SubjectChar* pos = reinterpret_cast<const SubjectChar*>(
+        memchr(subject.start() + index,
+               static_cast<char>(pattern[0]),
+               max_n - index));
+    if (pos == NULL) return -1;
+    return static_cast<int>(pos - subject.start());
+  }
+  SubjectChar search_char = static_cast<SubjectChar>(pattern[0]);
+  for (int i = index; i < max_n; i++) {
+    if (subject[i] == search_char) return i;
+  }
+  return -1;
+}
+
+
+//---------------------------------------------------------------------
+// Single Character Pattern Search Strategy
+//---------------------------------------------------------------------
+
+template <typename PatternChar, typename SubjectChar>
+int StringSearch<PatternChar, SubjectChar>::SingleCharSearch(
+    StringSearch<PatternChar, SubjectChar>* search,
+    Vector<const SubjectChar> subject,
+    int index) {
+  ASSERT_EQ(1, search->pattern_.length());
+  return FindFirstCharacter(search->pattern_, subject, index);
+}
+
+
+//---------------------------------------------------------------------
+// Linear Search Strategy
+//---------------------------------------------------------------------
+
+// Simple linear search for short patterns. Never bails out.
+template <typename PatternChar, typename SubjectChar>
+int StringSearch<PatternChar, SubjectChar>::LinearSearch(
+    StringSearch<PatternChar, SubjectChar>* search,
+    Vector<const SubjectChar> subject,
+    int index) {
+  Vector<const PatternChar> pattern = search->pattern_;
+  ASSERT(pattern.length() > 1);
+  int pattern_length = pattern.length();
+  int i = index;
+  while (true) {
+    i = FindFirstCharacter(pattern, subject, i);
+    if (i < 0) return -1;
+    int j = 1;
+    while (j < pattern_length && pattern[j] == subject[i + j]) j++;
+    if (j == pattern_length) return i;
+    i++;
+  }
+}
+
+
+//---------------------------------------------------------------------
+// Boyer-Moore string search
+//---------------------------------------------------------------------
+
+template <typename PatternChar, typename SubjectChar>
+int StringSearch<PatternChar, SubjectChar>::BoyerMooreSearch(
+    StringSearch<PatternChar, SubjectChar>* search,
+    Vector<const SubjectChar> subject,
+    int start_index) {
+  Vector<const PatternChar> pattern = search->pattern_;
+  int subject_length = subject.length();
+  int pattern_length = pattern.length();
+  // Only preprocess at most kBMMaxShift last characters of pattern.
+  int start = search->start_;
+
+  PatternChar last_char = pattern[pattern_length - 1];
+  int index = start_index;
+  // Continue search from i.
+  while (index <= subject_length - pattern_length) {
+    int j = pattern_length - 1;
+    int c;
+    while (last_char != (c = subject[index + j])) {
+      int shift = j - search->CharOccurrence(c);
+      index += shift;
+      if (index > subject_length - pattern_length) {
+        return -1;
+      }
+    }
+    while (j >= 0 && pattern[j] == (c = subject[index + j])) j--;
+    if (j < 0) {
+      return index;
+    } else if (j < start) {
+      // we have matched more than our tables allow us to be smart about.
+      // Fall back on BMH shift.
+      index += pattern_length - 1 - search->CharOccurrence(last_char);
+    } else {
+      int gs_shift = search->shift(j + 1);         // Good suffix shift.
+      int bc_occ = search->CharOccurrence(c);
+      int shift = j - bc_occ;                      // Bad-char shift.
+      if (gs_shift > shift) {
+        shift = gs_shift;
+      }
+      index += shift;
+    }
+  }
+
+  return -1;
+}
+
+
+template <typename PatternChar, typename SubjectChar>
+void StringSearch<PatternChar, SubjectChar>::PopulateBoyerMooreTable() {
+  int pattern_length = pattern_.length();
+  const PatternChar* pattern = pattern_.start();
+  // Only look at the last kBMMaxShift characters of pattern (from start_
+  // to pattern_length).
+  int start = start_;
+  int length = pattern_length - start;
+
+  // Biased tables so that we can use pattern indices as table indices,
+  // even if we only cover the part of the pattern from offset start.
+  for (int i = start; i <= pattern_length; i++) {
+    shift(i) = length;
+  }
+
+  shift(pattern_length - 1) = 1;
+  suffix(pattern_length) = pattern_length + 1;
+
+  // Find suffixes.
+  PatternChar last_char = pattern[pattern_length - 1];
+  int suffix_index = pattern_length + 1;
+  for (int i = pattern_length; i > start;) {
+    PatternChar c = pattern[i - 1];
+    while (suffix_index <= pattern_length && c != pattern[suffix_index - 1]) {
+      if (shift(suffix_index) == length) {
+        shift(suffix_index) = suffix_index - i;
+      }
+      suffix_index = suffix(suffix_index);
+    }
+    i--;
+    suffix_index--;
+    suffix(i) = suffix_index;
+    if (suffix_index == pattern_length) {
+      // No suffix to extend, so we check against last_char only.
+      while ((i > start) && (pattern[i - 1] != last_char)) {
+        if (shift(pattern_length) == length) {
+          shift(pattern_length) = pattern_length - i;
+        }
+        i--;
+        suffix(i) = pattern_length;
+      }
+      if (i > start) {
+        i--;
+        suffix_index--;
+        suffix(i) = suffix_index;
+      }
+    }
+  }
+  // Build shift table using suffixes.
+  if (suffix_index < pattern_length) {
+    for (int i = start; i <= pattern_length; i++) {
+      if (shift(i) == length) {
+        shift(i) = suffix_index - start;
+      }
+      if (i == suffix_index) {
+        suffix_index = suffix(suffix_index);
+      }
+    }
+  }
+}
+
+
+//---------------------------------------------------------------------
+// Boyer-Moore-Horspool string search.
+//---------------------------------------------------------------------
+
+// Restricted simplified Boyer-Moore string matching.
+// Uses only the bad-shift table of Boyer-Moore and only uses it
+// for the character compared to the last character of the needle.
+// Switches to full Boyer-Moore if it is doing badly.
+template <typename PatternChar, typename SubjectChar>
+int StringSearch<PatternChar, SubjectChar>::BoyerMooreHorspoolSearch(
+    StringSearch<PatternChar, SubjectChar>* search,
+    Vector<const SubjectChar> subject,
+    int start_index) {
+  Vector<const PatternChar> pattern = search->pattern_;
+  int subject_length = subject.length();
+  int pattern_length = pattern.length();
+  int badness = -pattern_length;
+
+  // How bad we are doing without a good-suffix table.
+  PatternChar last_char = pattern[pattern_length - 1];
+  int last_char_shift =
+      pattern_length - 1 - search->CharOccurrence(last_char);
+  // Perform search
+  int index = start_index;  // No matches found prior to this index.
+  while (index <= subject_length - pattern_length) {
+    int j = pattern_length - 1;
+    int c;
+    while (last_char != (c = subject[index + j])) {
+      int bc_occ = search->CharOccurrence(c);
+      int shift = j - bc_occ;
+      index += shift;
+      badness += 1 - shift;  // at most zero, so badness cannot increase.
+      if (index > subject_length - pattern_length) {
+        return -1;
+      }
+    }
+    j--;
+    while (j >= 0 && pattern[j] == (subject[index + j])) j--;
+    if (j < 0) {
+      return index;
+    } else {
+      index += last_char_shift;
+      // Badness increases by the number of characters we have
+      // checked, and decreases by the number of characters we
+      // can skip by shifting. It's a measure of how we are doing
+      // compared to reading each character exactly once.
+      badness += (pattern_length - j) - last_char_shift;
+      if (badness > 0) {
+        search->PopulateBoyerMooreTable();
+        search->strategy_ = &BoyerMooreSearch;
+        return BoyerMooreSearch(search, subject, index);
+      }
+    }
+  }
+  return -1;
+}
+
+
+template <typename PatternChar, typename SubjectChar>
+void StringSearch<PatternChar, SubjectChar>::PopulateBoyerMooreHorspoolTable() {
+  int pattern_length = pattern_.length();
+  // Only preprocess at most kBMMaxShift last characters of pattern.
+  int start = start_;
+  // Run forwards to populate bad_char_table, so that *last* instance
+  // of character equivalence class is the one registered.
+  // Notice: Doesn't include the last character.
+  int table_size = (sizeof(PatternChar) == 1) ? String::kMaxAsciiCharCode + 1
+                                              : kBMAlphabetSize;
+  if (start == 0) {  // All patterns less than kBMMaxShift in length.
+    memset(bad_char_table_, -1, table_size * sizeof(*bad_char_table_));
+  } else {
+    for (int i = 0; i < table_size; i++) {
+      bad_char_table_[i] = start - 1;
+    }
+  }
+  for (int i = start; i < pattern_length - 1; i++) {
+    PatternChar c = pattern_[i];
+    int bucket = (sizeof(PatternChar) == 1) ? c : c % kBMAlphabetSize;
+    bad_char_table_[bucket] = i;
+  }
+}
+
+
+//---------------------------------------------------------------------
+// Linear string search with bailout to BMH.
+//---------------------------------------------------------------------
+
+// Simple linear search for short patterns, which bails out if the string
+// isn't found very early in the subject. Upgrades to BoyerMooreHorspool.
+template <typename PatternChar, typename SubjectChar>
+int StringSearch<PatternChar, SubjectChar>::InitialSearch(
+    StringSearch<PatternChar, SubjectChar>* search,
+    Vector<const SubjectChar> subject,
+    int index) {
+  Vector<const PatternChar> pattern = search->pattern_;
+  int pattern_length = pattern.length();
+  // Badness is a count of how much work we have done.  When we have
+  // done enough work we decide it's probably worth switching to a better
+  // algorithm.
+  int badness = -10 - (pattern_length << 2);
+
+  // We know our pattern is at least 2 characters, we cache the first so
+  // the common case of the first character not matching is faster.
+  for (int i = index, n = subject.length() - pattern_length; i <= n; i++) {
+    badness++;
+    if (badness > 0) {
+      search->PopulateBoyerMooreHorspoolTable();
+      search->strategy_ = &BoyerMooreHorspoolSearch;
+      return BoyerMooreHorspoolSearch(search, subject, i);
+    }
+    i = FindFirstCharacter(pattern, subject, i);
+    if (i < 0) return -1;
+    int j = 1;
+    while (j < pattern_length && pattern[j] == subject[i + j]) j++;
+    if (j == pattern_length) {
+      return i;
+    }
+    badness += j;
+  }
+  return -1;
+}
+
+
+// Perform a single stand-alone search.
+// If searching multiple times for the same pattern, a search
+// object should be constructed once and the Search function then called
+// for each search.
+template <typename SubjectChar, typename PatternChar>
+static int SearchString(Vector<const SubjectChar> subject,
+                        Vector<const PatternChar> pattern,
+                        int start_index) {
+  StringSearch<PatternChar, SubjectChar> search(pattern);
+  return search.Search(subject, start_index);
+}
+
+} }  // namespace v8::internal
+
+#endif  // V8_STRING_SEARCH_H_
@@ -250,19 +250,27 @@ function StringReplace(search, replace) {
   if (start < 0) return subject;
   var end = start + search.length;
 
+  // Compute the string to replace with.  Unless it contains $-expressions
+  // it is written into the result together with the prefix and suffix.
+  if (IS_FUNCTION(replace)) {
+    var replacement = replace.call(null, search, start, subject);
+    return %StringReplaceRange(subject,
+                               start,
+                               end,
+                               TO_STRING_INLINE(replacement));
+  }
+  replace = TO_STRING_INLINE(replace);
+  if (%StringIndexOf(replace, '$', 0) < 0) {
+    return %StringReplaceRange(subject, start, end, replace);
+  }
+
   var builder = new ReplaceResultBuilder(subject);
   // prefix
   builder.addSpecialSlice(0, start);
 
-  // Compute the string to replace with.
-  if (IS_FUNCTION(replace)) {
-    builder.add(replace.call(null, search, start, subject));
-  } else {
-    reusableMatchInfo[CAPTURE0] = start;
-    reusableMatchInfo[CAPTURE1] = end;
-    replace = TO_STRING_INLINE(replace);
-    ExpandReplacement(replace, subject, reusableMatchInfo, builder);
-  }
+  reusableMatchInfo[CAPTURE0] = start;
+  reusableMatchInfo[CAPTURE1] = end;
+  ExpandReplacement(replace, subject, reusableMatchInfo, builder);
 
   // suffix
   builder.addSpecialSlice(end, subject.length);
@@ -478,8 +486,9 @@ function StringReplaceGlobalRegExpWithFunction(subject, regexp, replace) {
       i++;
     }
   }
-  var resultBuilder = new ReplaceResultBuilder(subject, res);
-  var result = resultBuilder.generate();
+  // The result array already holds the parts of the result, with the
+  // slices of the subject encoded as smis.
+  var result = %StringBuilderConcat(res, res.length, subject);
   resultArray.length = 0;
   reusableReplaceArray = resultArray;
   return result;
@@ -489,9 +498,7 @@ function StringReplaceGlobalRegExpWithFunction(subject, regexp, replace) {
 function StringReplaceNonGlobalRegExpWithFunction(subject, regexp, replace) {
   var matchInfo = DoRegExpExec(regexp, subject, 0);
   if (IS_NULL(matchInfo)) return subject;
-  var result = new ReplaceResultBuilder(subject);
   var index = matchInfo[CAPTURE0];
-  result.addSpecialSlice(0, index);
   var endOfMatch = matchInfo[CAPTURE1];
   // Compute the parameter list consisting of the match, captures, index,
   // and subject for the replace function invocation.
@@ -515,11 +522,12 @@ function StringReplaceNonGlobalRegExpWithFunction(subject, regexp, replace) {
     replacement = replace.apply(null, parameters);
   }
 
-  result.add(replacement);  // The add method converts to string if necessary.
   // Can't use matchInfo any more from here, since the function could
   // overwrite it.
-  result.addSpecialSlice(endOfMatch, subject.length);
-  return result.generate();
+  return %StringReplaceRange(subject,
+                             index,
+                             endOfMatch,
+                             TO_STRING_INLINE(replacement));
 }
 
 
@@ -634,49 +642,12 @@ function StringSplit(separator, limit) {
     return [subject];
   }
 
-  var currentIndex = 0;
-  var startIndex = 0;
-  var result = [];
-
-  outer_loop:
-  while (true) {
-
-    if (startIndex === length) {
-      result[result.length] = subject.slice(currentIndex, length);
-      break;
-    }
-
-    var matchInfo = splitMatch(separator, subject, currentIndex, startIndex);
-
-    if (IS_NULL(matchInfo)) {
-      result[result.length] = subject.slice(currentIndex, length);
-      break;
-    }
-
-    var endIndex = matchInfo[CAPTURE1];
-
-    // We ignore a zero-length match at the currentIndex.
-    if (startIndex === endIndex && endIndex === currentIndex) {
-      startIndex++;
-      continue;
-    }
-
-    result[result.length] = SubString(subject, currentIndex, matchInfo[CAPTURE0]);
-    if (result.length === limit) break;
-
-    var num_captures = NUMBER_OF_CAPTURES(matchInfo);
-    for (var i = 2; i < num_captures; i += 2) {
-      var start = matchInfo[CAPTURE(i)];
-      var end = matchInfo[CAPTURE(i + 1)];
-      if (start != -1 && end != -1) {
-        result[result.length] = SubString(subject, start, end);
-      } else {
-        result[result.length] = void 0;
-      }
-      if (result.length === limit) break outer_loop;
-    }
-
-    startIndex = currentIndex = endIndex;
+  // lastMatchInfo is defined in regexp.js.
+  var result = %StringSplitRegExp(subject, separator, limit, lastMatchInfo);
+  if (IS_NULL(result)) {
+    result = [subject];
+  } else {
+    lastMatchInfoOverride = null;
   }
   if (saveAnswer) cache.answer = CloneDenseArray(result);
   cache.answerSaved = saveAnswer;
@@ -904,11 +875,7 @@ function StringSup() {
 
 // ReplaceResultBuilder support.
 function ReplaceResultBuilder(str) {
-  if (%_ArgumentsLength() > 1) {
-    this.elements = %_Arguments(1);
-  } else {
-    this.elements = new $Array();
-  }
+  this.elements = new $Array();
   this.special_string = str;
 }
 
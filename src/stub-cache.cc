@@ -39,8 +39,7 @@ namespace internal {
 // StubCache implementation.
 
 
-StubCache::Entry StubCache::primary_[StubCache::kPrimaryTableSize];
-StubCache::Entry StubCache::secondary_[StubCache::kSecondaryTableSize];
+DEFINE_ISOLATE_COMPONENT(StubCache)
 
 void StubCache::Initialize(bool create_heap_objects) {
   ASSERT(IsPowerOf2(kPrimaryTableSize));
@@ -72,8 +71,9 @@ Code* StubCache::Set(String* name, Map* map, Code* code) {
   ASSERT(Code::ExtractTypeFromFlags(flags) == 0);
 
   // Compute the primary entry.
+  Data* data = StubCache::data();
   int primary_offset = PrimaryOffset(name, flags, map);
-  Entry* primary = entry(primary_, primary_offset);
+  Entry* primary = entry(data->primary_, primary_offset);
   Code* hit = primary->value;
 
   // If the primary entry has useful data in it, we retire it to the
@@ -82,7 +82,7 @@ Code* StubCache::Set(String* name, Map* map, Code* code) {
     Code::Flags primary_flags = Code::RemoveTypeFromFlags(hit->flags());
     int secondary_offset =
         SecondaryOffset(primary->key, primary_flags, primary_offset);
-    Entry* secondary = entry(secondary_, secondary_offset);
+    Entry* secondary = entry(data->secondary_, secondary_offset);
     *secondary = *primary;
   }
 
@@ -767,13 +767,14 @@ Object* StubCache::ComputeLazyCompile(int argc) {
 
 
 void StubCache::Clear() {
+  Data* data = StubCache::data();
   for (int i = 0; i < kPrimaryTableSize; i++) {
-    primary_[i].key = Heap::empty_string();
-    primary_[i].value = Builtins::builtin(Builtins::Illegal);
+    data->primary_[i].key = Heap::empty_string();
+    data->primary_[i].value = Builtins::builtin(Builtins::Illegal);
   }
   for (int j = 0; j < kSecondaryTableSize; j++) {
-    secondary_[j].key = Heap::empty_string();
-    secondary_[j].value = Builtins::builtin(Builtins::Illegal);
+    data->secondary_[j].key = Heap::empty_string();
+    data->secondary_[j].value = Builtins::builtin(Builtins::Illegal);
   }
 }
 
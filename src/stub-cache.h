@@ -235,8 +235,17 @@ class StubCache : public AllStatic {
   friend class SCTableReference;
   static const int kPrimaryTableSize = 2048;
   static const int kSecondaryTableSize = 512;
-  static Entry primary_[];
-  static Entry secondary_[];
+
+  class Data {
+   public:
+    Entry primary_[kPrimaryTableSize];
+    Entry secondary_[kSecondaryTableSize];
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kStubCacheData));
+  }
 
   // Computes the hashed offsets for primary and secondary caches.
   static int PrimaryOffset(String* name, Code::Flags flags, Map* map) {
@@ -284,6 +293,8 @@ class StubCache : public AllStatic {
     return reinterpret_cast<Entry*>(
         reinterpret_cast<Address>(table) + (offset << shift_amount));
   }
+
+  friend class Isolate;
 };
 
 
@@ -307,8 +318,8 @@ class SCTableReference {
 
   static StubCache::Entry* first_entry(StubCache::Table table) {
     switch (table) {
-      case StubCache::kPrimary: return StubCache::primary_;
-      case StubCache::kSecondary: return StubCache::secondary_;
+      case StubCache::kPrimary: return StubCache::data()->primary_;
+      case StubCache::kSecondary: return StubCache::data()->secondary_;
     }
     UNREACHABLE();
     return NULL;
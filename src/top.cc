@@ -39,18 +39,19 @@
 namespace v8 {
 namespace internal {
 
-ThreadLocalTop Top::thread_local_;
-Mutex* Top::break_access_ = OS::CreateMutex();
+Top::Data::Data() : break_access_(OS::CreateMutex()) {
+}
 
-NoAllocationStringAllocator* preallocated_message_space = NULL;
 
-Address top_addresses[] = {
-#define C(name) reinterpret_cast<Address>(Top::name()),
-    TOP_ADDRESS_LIST(C)
-    TOP_ADDRESS_LIST_PROF(C)
-#undef C
-    NULL
-};
+Top::Data::~Data() {
+  delete break_access_;
+}
+
+
+DEFINE_ISOLATE_COMPONENT(Top)
+
+
+NoAllocationStringAllocator* preallocated_message_space = NULL;
 
 
 v8::TryCatch* ThreadLocalTop::TryCatchHandler() {
@@ -77,7 +78,17 @@ void ThreadLocalTop::Initialize() {
 
 
 Address Top::get_address_from_id(Top::AddressId id) {
-  return top_addresses[id];
+  // The addresses are those of the current isolate, so they are looked up
+  // on every call.
+  switch (id) {
+#define C(name) case k_##name: return reinterpret_cast<Address>(Top::name());
+    TOP_ADDRESS_LIST(C)
+    TOP_ADDRESS_LIST_PROF(C)
+#undef C
+    default:
+      UNREACHABLE();
+      return NULL;
+  }
 }
 
 
@@ -89,7 +100,7 @@ char* Top::Iterate(ObjectVisitor* v, char* thread_storage) {
 
 
 void Top::IterateThread(ThreadVisitor* v) {
-  v->VisitThread(&thread_local_);
+  v->VisitThread(&isolate_data()->thread_local_);
 }
 
 
@@ -122,13 +133,13 @@ void Top::Iterate(ObjectVisitor* v, ThreadLocalTop* thread) {
 
 
 void Top::Iterate(ObjectVisitor* v) {
-  ThreadLocalTop* current_t = &thread_local_;
+  ThreadLocalTop* current_t = &isolate_data()->thread_local_;
   Iterate(v, current_t);
 }
 
 
 void Top::InitializeThreadLocal() {
-  thread_local_.Initialize();
+  isolate_data()->thread_local_.Initialize();
   clear_pending_exception();
   clear_pending_message();
   clear_scheduled_exception();
@@ -244,10 +255,8 @@ Semaphore* PreallocatedMemoryThread::data_ready_semaphore_ = NULL;
 char* PreallocatedMemoryThread::data_ = NULL;
 unsigned PreallocatedMemoryThread::length_ = 0;
 
-static bool initialized = false;
-
 void Top::Initialize() {
-  CHECK(!initialized);
+  CHECK(!isolate_data()->initialized_);
 
   InitializeThreadLocal();
 
@@ -260,12 +269,12 @@ void Top::Initialize() {
                                         PreallocatedMemoryThread::length());
     PreallocatedStorage::Init(PreallocatedMemoryThread::length() / 4);
   }
-  initialized = true;
+  isolate_data()->initialized_ = true;
 }
 
 
 void Top::TearDown() {
-  if (initialized) {
+  if (isolate_data()->initialized_) {
     // Remove the external reference to the preallocated stack memory.
     if (preallocated_message_space != NULL) {
       delete preallocated_message_space;
@@ -273,7 +282,7 @@ void Top::TearDown() {
     }
 
     PreallocatedMemoryThread::StopThread();
-    initialized = false;
+    isolate_data()->initialized_ = false;
   }
 }
 
@@ -286,21 +295,21 @@ void Top::RegisterTryCatchHandler(v8::TryCatch* that) {
   // returned will be the address of the C++ try catch handler itself.
   Address address = reinterpret_cast<Address>(
       SimulatorStack::RegisterCTryCatch(reinterpret_cast<uintptr_t>(that)));
-  thread_local_.set_try_catch_handler_address(address);
+  isolate_data()->thread_local_.set_try_catch_handler_address(address);
 }
 
 
 void Top::UnregisterTryCatchHandler(v8::TryCatch* that) {
-  ASSERT(thread_local_.TryCatchHandler() == that);
-  thread_local_.set_try_catch_handler_address(
+  ASSERT(isolate_data()->thread_local_.TryCatchHandler() == that);
+  isolate_data()->thread_local_.set_try_catch_handler_address(
       reinterpret_cast<Address>(that->next_));
-  thread_local_.catcher_ = NULL;
+  isolate_data()->thread_local_.catcher_ = NULL;
   SimulatorStack::UnregisterCTryCatch();
 }
 
 
 void Top::MarkCompactPrologue(bool is_compacting) {
-  MarkCompactPrologue(is_compacting, &thread_local_);
+  MarkCompactPrologue(is_compacting, &isolate_data()->thread_local_);
 }
 
 
@@ -322,7 +331,7 @@ void Top::MarkCompactEpilogue(bool is_compacting, char* data) {
 
 
 void Top::MarkCompactEpilogue(bool is_compacting) {
-  MarkCompactEpilogue(is_compacting, &thread_local_);
+  MarkCompactEpilogue(is_compacting, &isolate_data()->thread_local_);
 }
 
 
@@ -333,29 +342,25 @@ void Top::MarkCompactEpilogue(bool is_compacting, ThreadLocalTop* thread) {
 }
 
 
-static int stack_trace_nesting_level = 0;
-static StringStream* incomplete_message = NULL;
-
-
 Handle<String> Top::StackTraceString() {
-  if (stack_trace_nesting_level == 0) {
-    stack_trace_nesting_level++;
+  if (isolate_data()->stack_trace_nesting_level_ == 0) {
+    isolate_data()->stack_trace_nesting_level_++;
     HeapStringAllocator allocator;
     StringStream::ClearMentionedObjectCache();
     StringStream accumulator(&allocator);
-    incomplete_message = &accumulator;
+    isolate_data()->incomplete_message_ = &accumulator;
     PrintStack(&accumulator);
     Handle<String> stack_trace = accumulator.ToString();
-    incomplete_message = NULL;
-    stack_trace_nesting_level = 0;
+    isolate_data()->incomplete_message_ = NULL;
+    isolate_data()->stack_trace_nesting_level_ = 0;
     return stack_trace;
-  } else if (stack_trace_nesting_level == 1) {
-    stack_trace_nesting_level++;
+  } else if (isolate_data()->stack_trace_nesting_level_ == 1) {
+    isolate_data()->stack_trace_nesting_level_++;
     OS::PrintError(
       "\n\nAttempt to print stack while printing stack (double fault)\n");
     OS::PrintError(
       "If you are lucky you may find a partial stack dump on stdout.\n\n");
-    incomplete_message->OutputToStdOut();
+    isolate_data()->incomplete_message_->OutputToStdOut();
     return Factory::empty_symbol();
   } else {
     OS::Abort();
@@ -448,8 +453,8 @@ Local<StackTrace> Top::CaptureCurrentStackTrace(
 
 
 void Top::PrintStack() {
-  if (stack_trace_nesting_level == 0) {
-    stack_trace_nesting_level++;
+  if (isolate_data()->stack_trace_nesting_level_ == 0) {
+    isolate_data()->stack_trace_nesting_level_++;
 
     StringAllocator* allocator;
     if (preallocated_message_space == NULL) {
@@ -465,23 +470,23 @@ void Top::PrintStack() {
 
     StringStream::ClearMentionedObjectCache();
     StringStream accumulator(allocator);
-    incomplete_message = &accumulator;
+    isolate_data()->incomplete_message_ = &accumulator;
     PrintStack(&accumulator);
     accumulator.OutputToStdOut();
     accumulator.Log();
-    incomplete_message = NULL;
-    stack_trace_nesting_level = 0;
+    isolate_data()->incomplete_message_ = NULL;
+    isolate_data()->stack_trace_nesting_level_ = 0;
     if (preallocated_message_space == NULL) {
       // Remove the HeapStringAllocator created above.
       delete allocator;
     }
-  } else if (stack_trace_nesting_level == 1) {
-    stack_trace_nesting_level++;
+  } else if (isolate_data()->stack_trace_nesting_level_ == 1) {
+    isolate_data()->stack_trace_nesting_level_++;
     OS::PrintError(
       "\n\nAttempt to print stack while printing stack (double fault)\n");
     OS::PrintError(
       "If you are lucky you may find a partial stack dump on stdout.\n\n");
-    incomplete_message->OutputToStdOut();
+    isolate_data()->incomplete_message_->OutputToStdOut();
   }
 }
 
@@ -517,13 +522,13 @@ void Top::PrintStack(StringStream* accumulator) {
 
 
 void Top::SetFailedAccessCheckCallback(v8::FailedAccessCheckCallback callback) {
-  ASSERT(thread_local_.failed_access_check_callback_ == NULL);
-  thread_local_.failed_access_check_callback_ = callback;
+  ASSERT(isolate_data()->thread_local_.failed_access_check_callback_ == NULL);
+  isolate_data()->thread_local_.failed_access_check_callback_ = callback;
 }
 
 
 void Top::ReportFailedAccessCheck(JSObject* receiver, v8::AccessType type) {
-  if (!thread_local_.failed_access_check_callback_) return;
+  if (!isolate_data()->thread_local_.failed_access_check_callback_) return;
 
   ASSERT(receiver->IsAccessCheckNeeded());
   ASSERT(Top::context());
@@ -540,7 +545,7 @@ void Top::ReportFailedAccessCheck(JSObject* receiver, v8::AccessType type) {
   HandleScope scope;
   Handle<JSObject> receiver_handle(receiver);
   Handle<Object> data(AccessCheckInfo::cast(data_obj)->data());
-  thread_local_.failed_access_check_callback_(
+  isolate_data()->thread_local_.failed_access_check_callback_(
     v8::Utils::ToLocal(receiver_handle),
     type,
     v8::Utils::ToLocal(data));
@@ -718,8 +723,8 @@ void Top::ScheduleThrow(Object* exception) {
   // When scheduling a throw we first throw the exception to get the
   // error reporting if it is uncaught before rescheduling it.
   Throw(exception);
-  thread_local_.scheduled_exception_ = pending_exception();
-  thread_local_.external_caught_exception_ = false;
+  isolate_data()->thread_local_.scheduled_exception_ = pending_exception();
+  isolate_data()->thread_local_.external_caught_exception_ = false;
   clear_pending_exception();
 }
 
@@ -808,7 +813,8 @@ bool Top::ShouldReturnException(bool* is_caught_externally,
 
   // Get the address of the external handler so we can compare the address to
   // determine which one is closer to the top of the stack.
-  Address external_handler_address = thread_local_.try_catch_handler_address();
+  Address external_handler_address =
+      isolate_data()->thread_local_.try_catch_handler_address();
 
   // The exception has been externally caught if and only if there is
   // an external handler which is on top of the top-most try-catch
@@ -819,7 +825,7 @@ bool Top::ShouldReturnException(bool* is_caught_externally,
 
   if (*is_caught_externally) {
     // Only report the exception if the external handler is verbose.
-    return thread_local_.TryCatchHandler()->is_verbose_;
+    return isolate_data()->thread_local_.TryCatchHandler()->is_verbose_;
   } else {
     // Report the exception if it isn't caught by JavaScript code.
     return handler == NULL;
@@ -856,7 +862,7 @@ void Top::DoThrow(Object* exception,
   MessageLocation potential_computed_location;
   bool try_catch_needs_message =
       is_caught_externally &&
-      thread_local_.TryCatchHandler()->capture_message_;
+      isolate_data()->thread_local_.TryCatchHandler()->capture_message_;
   if (report_exception || try_catch_needs_message) {
     if (location == NULL) {
       // If no location was specified we use a computed one instead
@@ -875,19 +881,20 @@ void Top::DoThrow(Object* exception,
   }
 
   // Save the message for reporting if the the exception remains uncaught.
-  thread_local_.has_pending_message_ = report_exception;
-  thread_local_.pending_message_ = message;
+  ThreadLocalTop* thread_local = GetCurrentThread();
+  thread_local->has_pending_message_ = report_exception;
+  thread_local->pending_message_ = message;
   if (!message_obj.is_null()) {
-    thread_local_.pending_message_obj_ = *message_obj;
+    thread_local->pending_message_obj_ = *message_obj;
     if (location != NULL) {
-      thread_local_.pending_message_script_ = *location->script();
-      thread_local_.pending_message_start_pos_ = location->start_pos();
-      thread_local_.pending_message_end_pos_ = location->end_pos();
+      thread_local->pending_message_script_ = *location->script();
+      thread_local->pending_message_start_pos_ = location->start_pos();
+      thread_local->pending_message_end_pos_ = location->end_pos();
     }
   }
 
   if (is_caught_externally) {
-    thread_local_.catcher_ = thread_local_.TryCatchHandler();
+    thread_local->catcher_ = thread_local->TryCatchHandler();
   }
 
   // NOTE: Notifying the debugger or generating the message
@@ -898,43 +905,44 @@ void Top::DoThrow(Object* exception,
 
 
 void Top::ReportPendingMessages() {
+  ThreadLocalTop* thread_local = &isolate_data()->thread_local_;
   ASSERT(has_pending_exception());
   setup_external_caught();
   // If the pending exception is OutOfMemoryException set out_of_memory in
   // the global context.  Note: We have to mark the global context here
   // since the GenerateThrowOutOfMemory stub cannot make a RuntimeCall to
   // set it.
-  bool external_caught = thread_local_.external_caught_exception_;
+  bool external_caught = thread_local->external_caught_exception_;
   HandleScope scope;
-  if (thread_local_.pending_exception_ == Failure::OutOfMemoryException()) {
+  if (thread_local->pending_exception_ == Failure::OutOfMemoryException()) {
     context()->mark_out_of_memory();
-  } else if (thread_local_.pending_exception_ ==
+  } else if (thread_local->pending_exception_ ==
              Heap::termination_exception()) {
     if (external_caught) {
-      thread_local_.TryCatchHandler()->can_continue_ = false;
-      thread_local_.TryCatchHandler()->exception_ = Heap::null_value();
+      thread_local->TryCatchHandler()->can_continue_ = false;
+      thread_local->TryCatchHandler()->exception_ = Heap::null_value();
     }
   } else {
     Handle<Object> exception(pending_exception());
-    thread_local_.external_caught_exception_ = false;
+    thread_local->external_caught_exception_ = false;
     if (external_caught) {
-      thread_local_.TryCatchHandler()->can_continue_ = true;
-      thread_local_.TryCatchHandler()->exception_ =
-        thread_local_.pending_exception_;
-      if (!thread_local_.pending_message_obj_->IsTheHole()) {
-        try_catch_handler()->message_ = thread_local_.pending_message_obj_;
+      thread_local->TryCatchHandler()->can_continue_ = true;
+      thread_local->TryCatchHandler()->exception_ =
+        thread_local->pending_exception_;
+      if (!thread_local->pending_message_obj_->IsTheHole()) {
+        try_catch_handler()->message_ = thread_local->pending_message_obj_;
       }
     }
-    if (thread_local_.has_pending_message_) {
-      thread_local_.has_pending_message_ = false;
-      if (thread_local_.pending_message_ != NULL) {
-        MessageHandler::ReportMessage(thread_local_.pending_message_);
-      } else if (!thread_local_.pending_message_obj_->IsTheHole()) {
-        Handle<Object> message_obj(thread_local_.pending_message_obj_);
-        if (thread_local_.pending_message_script_ != NULL) {
-          Handle<Script> script(thread_local_.pending_message_script_);
-          int start_pos = thread_local_.pending_message_start_pos_;
-          int end_pos = thread_local_.pending_message_end_pos_;
+    if (thread_local->has_pending_message_) {
+      thread_local->has_pending_message_ = false;
+      if (thread_local->pending_message_ != NULL) {
+        MessageHandler::ReportMessage(thread_local->pending_message_);
+      } else if (!thread_local->pending_message_obj_->IsTheHole()) {
+        Handle<Object> message_obj(thread_local->pending_message_obj_);
+        if (thread_local->pending_message_script_ != NULL) {
+          Handle<Script> script(thread_local->pending_message_script_);
+          int start_pos = thread_local->pending_message_start_pos_;
+          int end_pos = thread_local->pending_message_end_pos_;
           MessageLocation location(script, start_pos, end_pos);
           MessageHandler::ReportMessage(&location, message_obj);
         } else {
@@ -942,7 +950,7 @@ void Top::ReportPendingMessages() {
         }
       }
     }
-    thread_local_.external_caught_exception_ = external_caught;
+    thread_local->external_caught_exception_ = external_caught;
     set_pending_exception(*exception);
   }
   clear_pending_message();
@@ -965,17 +973,17 @@ bool Top::OptionalRescheduleException(bool is_bottom_call) {
 
     if (is_termination_exception) {
       if (is_bottom_call) {
-        thread_local_.external_caught_exception_ = false;
+        isolate_data()->thread_local_.external_caught_exception_ = false;
         clear_pending_exception();
         return false;
       }
-    } else if (thread_local_.external_caught_exception_) {
+    } else if (isolate_data()->thread_local_.external_caught_exception_) {
       // If the exception is externally caught, clear it if there are no
       // JavaScript frames on the way to the C++ frame that has the
       // external handler.
-      ASSERT(thread_local_.try_catch_handler_address() != NULL);
+      ASSERT(isolate_data()->thread_local_.try_catch_handler_address() != NULL);
       Address external_handler_address =
-          thread_local_.try_catch_handler_address();
+          isolate_data()->thread_local_.try_catch_handler_address();
       JavaScriptFrameIterator it;
       if (it.done() || (it.frame()->sp() > external_handler_address)) {
         clear_exception = true;
@@ -984,14 +992,14 @@ bool Top::OptionalRescheduleException(bool is_bottom_call) {
 
     // Clear the exception if needed.
     if (clear_exception) {
-      thread_local_.external_caught_exception_ = false;
+      isolate_data()->thread_local_.external_caught_exception_ = false;
       clear_pending_exception();
       return false;
     }
   }
 
   // Reschedule the exception.
-  thread_local_.scheduled_exception_ = pending_exception();
+  isolate_data()->thread_local_.scheduled_exception_ = pending_exception();
   clear_pending_exception();
   return true;
 }
@@ -1015,7 +1023,7 @@ bool Top::is_out_of_memory() {
 
 
 Handle<Context> Top::global_context() {
-  GlobalObject* global = thread_local_.context_->global();
+  GlobalObject* global = isolate_data()->thread_local_.context_->global();
   return Handle<Context>(global->global_context());
 }
 
@@ -1043,25 +1051,27 @@ Handle<Context> Top::GetCallingGlobalContext() {
 
 
 char* Top::ArchiveThread(char* to) {
-  memcpy(to, reinterpret_cast<char*>(&thread_local_), sizeof(thread_local_));
+  memcpy(to, reinterpret_cast<char*>(GetCurrentThread()),
+         sizeof(ThreadLocalTop));
   InitializeThreadLocal();
-  return to + sizeof(thread_local_);
+  return to + sizeof(ThreadLocalTop);
 }
 
 
 char* Top::RestoreThread(char* from) {
-  memcpy(reinterpret_cast<char*>(&thread_local_), from, sizeof(thread_local_));
-  return from + sizeof(thread_local_);
+  memcpy(reinterpret_cast<char*>(GetCurrentThread()), from,
+         sizeof(ThreadLocalTop));
+  return from + sizeof(ThreadLocalTop);
 }
 
 
 ExecutionAccess::ExecutionAccess() {
-  Top::break_access_->Lock();
+  Top::isolate_data()->break_access_->Lock();
 }
 
 
 ExecutionAccess::~ExecutionAccess() {
-  Top::break_access_->Unlock();
+  Top::isolate_data()->break_access_->Unlock();
 }
 
 
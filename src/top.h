@@ -146,53 +146,59 @@ class Top {
   static Address get_address_from_id(AddressId id);
 
   // Access to top context (where the current function object was created).
-  static Context* context() { return thread_local_.context_; }
+  static Context* context() { return isolate_data()->thread_local_.context_; }
   static void set_context(Context* context) {
-    thread_local_.context_ = context;
+    isolate_data()->thread_local_.context_ = context;
+  }
+  static Context** context_address() {
+    return &isolate_data()->thread_local_.context_;
   }
-  static Context** context_address() { return &thread_local_.context_; }
 
-  static SaveContext* save_context() {return thread_local_.save_context_; }
+  static SaveContext* save_context() {
+    return isolate_data()->thread_local_.save_context_;
+  }
   static void set_save_context(SaveContext* save) {
-    thread_local_.save_context_ = save;
+    isolate_data()->thread_local_.save_context_ = save;
   }
 
   // Access to current thread id.
-  static int thread_id() { return thread_local_.thread_id_; }
-  static void set_thread_id(int id) { thread_local_.thread_id_ = id; }
+  static int thread_id() { return isolate_data()->thread_local_.thread_id_; }
+  static void set_thread_id(int id) {
+    isolate_data()->thread_local_.thread_id_ = id;
+  }
 
   // Interface to pending exception.
   static Object* pending_exception() {
     ASSERT(has_pending_exception());
-    return thread_local_.pending_exception_;
+    return isolate_data()->thread_local_.pending_exception_;
   }
   static bool external_caught_exception() {
-    return thread_local_.external_caught_exception_;
+    return isolate_data()->thread_local_.external_caught_exception_;
   }
   static void set_pending_exception(Object* exception) {
-    thread_local_.pending_exception_ = exception;
+    isolate_data()->thread_local_.pending_exception_ = exception;
   }
   static void clear_pending_exception() {
-    thread_local_.pending_exception_ = Heap::the_hole_value();
+    isolate_data()->thread_local_.pending_exception_ = Heap::the_hole_value();
   }
 
   static Object** pending_exception_address() {
-    return &thread_local_.pending_exception_;
+    return &isolate_data()->thread_local_.pending_exception_;
   }
   static bool has_pending_exception() {
-    return !thread_local_.pending_exception_->IsTheHole();
+    return !isolate_data()->thread_local_.pending_exception_->IsTheHole();
   }
   static void clear_pending_message() {
-    thread_local_.has_pending_message_ = false;
-    thread_local_.pending_message_ = NULL;
-    thread_local_.pending_message_obj_ = Heap::the_hole_value();
-    thread_local_.pending_message_script_ = NULL;
+    isolate_data()->thread_local_.has_pending_message_ = false;
+    isolate_data()->thread_local_.pending_message_ = NULL;
+    isolate_data()->thread_local_.pending_message_obj_ = Heap::the_hole_value();
+    isolate_data()->thread_local_.pending_message_script_ = NULL;
   }
   static v8::TryCatch* try_catch_handler() {
-    return thread_local_.TryCatchHandler();
+    return isolate_data()->thread_local_.TryCatchHandler();
   }
   static Address try_catch_handler_address() {
-    return thread_local_.try_catch_handler_address();
+    return isolate_data()->thread_local_.try_catch_handler_address();
   }
   // This method is called by the api after operations that may throw
   // exceptions.  If an exception was thrown and not handled by an external
@@ -202,29 +208,29 @@ class Top {
 
 
   static bool* external_caught_exception_address() {
-    return &thread_local_.external_caught_exception_;
+    return &isolate_data()->thread_local_.external_caught_exception_;
   }
 
   static Object** scheduled_exception_address() {
-    return &thread_local_.scheduled_exception_;
+    return &isolate_data()->thread_local_.scheduled_exception_;
   }
 
   static Object* scheduled_exception() {
     ASSERT(has_scheduled_exception());
-    return thread_local_.scheduled_exception_;
+    return isolate_data()->thread_local_.scheduled_exception_;
   }
   static bool has_scheduled_exception() {
-    return !thread_local_.scheduled_exception_->IsTheHole();
+    return !isolate_data()->thread_local_.scheduled_exception_->IsTheHole();
   }
   static void clear_scheduled_exception() {
-    thread_local_.scheduled_exception_ = Heap::the_hole_value();
+    isolate_data()->thread_local_.scheduled_exception_ = Heap::the_hole_value();
   }
 
   static void setup_external_caught() {
-    thread_local_.external_caught_exception_ =
+    isolate_data()->thread_local_.external_caught_exception_ =
         has_pending_exception() &&
-        (thread_local_.catcher_ != NULL) &&
-        (try_catch_handler() == thread_local_.catcher_);
+        (isolate_data()->thread_local_.catcher_ != NULL) &&
+        (try_catch_handler() == isolate_data()->thread_local_.catcher_);
   }
 
   // Tells whether the current context has experienced an out of memory
@@ -238,9 +244,11 @@ class Top {
   static Address handler(ThreadLocalTop* thread) { return thread->handler_; }
 
   static inline Address* c_entry_fp_address() {
-    return &thread_local_.c_entry_fp_;
+    return &isolate_data()->thread_local_.c_entry_fp_;
+  }
+  static inline Address* handler_address() {
+    return &isolate_data()->thread_local_.handler_;
   }
-  static inline Address* handler_address() { return &thread_local_.handler_; }
 
 #ifdef ENABLE_LOGGING_AND_PROFILING
   // Bottom JS entry (see StackTracer::Trace in log.cc).
@@ -248,12 +256,14 @@ class Top {
     return thread->js_entry_sp_;
   }
   static inline Address* js_entry_sp_address() {
-    return &thread_local_.js_entry_sp_;
+    return &isolate_data()->thread_local_.js_entry_sp_;
   }
 #endif
 
   // Generated code scratch locations.
-  static void* formal_count_address() { return &thread_local_.formal_count_; }
+  static void* formal_count_address() {
+    return &isolate_data()->thread_local_.formal_count_;
+  }
 
   static void MarkCompactPrologue(bool is_compacting);
   static void MarkCompactEpilogue(bool is_compacting);
@@ -345,7 +355,8 @@ class Top {
   static Handle<Context> GetCallingGlobalContext();
 
   static Handle<JSBuiltinsObject> builtins() {
-    return Handle<JSBuiltinsObject>(thread_local_.context_->builtins());
+    return Handle<JSBuiltinsObject>(
+        isolate_data()->thread_local_.context_->builtins());
   }
 
   static void RegisterTryCatchHandler(v8::TryCatch* that);
@@ -358,17 +369,42 @@ class Top {
   GLOBAL_CONTEXT_FIELDS(TOP_GLOBAL_CONTEXT_FIELD_ACCESSOR)
 #undef TOP_GLOBAL_CONTEXT_FIELD_ACCESSOR
 
-  static inline ThreadLocalTop* GetCurrentThread() { return &thread_local_; }
+  static inline ThreadLocalTop* GetCurrentThread() {
+    return &isolate_data()->thread_local_;
+  }
   static int ArchiveSpacePerThread() { return sizeof(ThreadLocalTop); }
   static char* ArchiveThread(char* to);
   static char* RestoreThread(char* from);
-  static void FreeThreadResources() { thread_local_.Free(); }
+  static void FreeThreadResources() { isolate_data()->thread_local_.Free(); }
 
   static const char* kStackOverflowMessage;
 
  private:
-  // The context that initiated this JS execution.
-  static ThreadLocalTop thread_local_;
+  class Data {
+   public:
+    Data();
+    ~Data();
+
+    // The context that initiated this JS execution.
+    ThreadLocalTop thread_local_;
+
+    // Debug.
+    // Mutex for serializing access to break control structures.
+    Mutex* break_access_;
+
+    bool initialized_;
+
+    // Guards against recursion when printing the stack trace.
+    int stack_trace_nesting_level_;
+    StringStream* incomplete_message_;
+  };
+
+  // Not named data(), which is the accessor of the global context field.
+  static Data* isolate_data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kTopData));
+  }
+
   static void InitializeThreadLocal();
   static void PrintStackTrace(FILE* out, ThreadLocalTop* thread);
   static void MarkCompactPrologue(bool is_compacting,
@@ -376,10 +412,7 @@ class Top {
   static void MarkCompactEpilogue(bool is_compacting,
                                   ThreadLocalTop* archived_thread_data);
 
-  // Debug.
-  // Mutex for serializing access to break control structures.
-  static Mutex* break_access_;
-
+  friend class Isolate;
   friend class SaveContext;
   friend class AssertNoContextChange;
   friend class ExecutionAccess;
@@ -626,6 +626,29 @@ static inline void CopyChars(sinkchar* dest, const sourcechar* src, int chars) {
 }
 
 
+// Returns the index of the first char that is not ASCII, or the length if
+// they all are.  Checks a word at a time where possible.
+static inline int NonAsciiStart(const char* chars, int length) {
+  const char* start = chars;
+  const char* limit = chars + length;
+#ifdef V8_HOST_CAN_READ_UNALIGNED
+  static const int kStepSize = sizeof(uintptr_t);  // NOLINT
+  static const uintptr_t kNonAsciiMask =
+      static_cast<uintptr_t>(-1) / 0xFF * 0x80;
+  while (chars <= limit - kStepSize) {
+    if ((*reinterpret_cast<const uintptr_t*>(chars) & kNonAsciiMask) != 0) {
+      break;
+    }
+    chars += kStepSize;
+  }
+#endif
+  while (chars < limit && static_cast<unsigned char>(*chars) < 0x80) {
+    chars++;
+  }
+  return static_cast<int>(chars - start);
+}
+
+
 // Compare ASCII/16bit chars to ASCII/16bit chars.
 template <typename lchar, typename rchar>
 static inline int CompareChars(const lchar* lhs, const rchar* rhs, int chars) {
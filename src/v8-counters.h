@@ -84,6 +84,10 @@ namespace internal {
   SC(compilation_cache_misses, V8.CompilationCacheMisses)             \
   SC(regexp_cache_hits, V8.RegExpCacheHits)                           \
   SC(regexp_cache_misses, V8.RegExpCacheMisses)                       \
+  SC(regexp_results_cache_hits, V8.RegExpResultsCacheHits)            \
+  SC(regexp_results_cache_misses, V8.RegExpResultsCacheMisses)        \
+  SC(regexp_backtrack_limit_hits, V8.RegExpBacktrackLimitHits)        \
+  SC(regexp_nfa_matches, V8.RegExpNfaMatches)                         \
   /* Amount of evaled source code. */                                 \
   SC(total_eval_size, V8.TotalEvalSize)                               \
   /* Amount of loaded source code. */                                 \
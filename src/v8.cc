@@ -39,31 +39,23 @@
 namespace v8 {
 namespace internal {
 
-bool V8::is_running_ = false;
-bool V8::has_been_setup_ = false;
-bool V8::has_been_disposed_ = false;
-bool V8::has_fatal_error_ = false;
+DEFINE_ISOLATE_COMPONENT(V8)
 
-bool V8::Initialize(Deserializer* des) {
-  bool create_heap_objects = des == NULL;
-  if (has_been_disposed_ || has_fatal_error_) return false;
-  if (IsRunning()) return true;
 
-  is_running_ = true;
-  has_been_setup_ = true;
-  has_fatal_error_ = false;
-  has_been_disposed_ = false;
-#ifdef DEBUG
-  // The initialization process does not handle memory exhaustion.
-  DisallowAllocationFailure disallow_allocation_failure;
-#endif
+// Serializes the initialization of isolates, which sets up the parts of the
+// VM that all isolates share the first time.
+static Mutex* init_mutex = OS::CreateMutex();
+static bool process_has_been_setup = false;
+static bool cpu_has_been_setup = false;
+
+
+void V8::SetupProcess() {
+  if (process_has_been_setup) return;
+  process_has_been_setup = true;
 
   // Enable logging before setting up the heap
   Logger::Setup();
 
-  CpuProfiler::Setup();
-  HeapProfiler::Setup();
-
   // Setup the platform OS support.
   OS::Setup();
 
@@ -72,6 +64,31 @@ bool V8::Initialize(Deserializer* des) {
   ::assembler::arm::Simulator::Initialize();
 #endif
 
+  OProfileAgent::Initialize();
+}
+
+
+bool V8::Initialize(Deserializer* des) {
+  bool create_heap_objects = des == NULL;
+  Data* data = V8::data();
+  if (data->has_been_disposed_ || data->has_fatal_error_) return false;
+  if (IsRunning()) return true;
+
+  ScopedLock init_lock(init_mutex);
+  data->is_running_ = true;
+  data->has_been_setup_ = true;
+  data->has_fatal_error_ = false;
+  data->has_been_disposed_ = false;
+#ifdef DEBUG
+  // The initialization process does not handle memory exhaustion.
+  DisallowAllocationFailure disallow_allocation_failure;
+#endif
+
+  SetupProcess();
+
+  CpuProfiler::Setup();
+  HeapProfiler::Setup();
+
   { // NOLINT
     // Ensure that the thread has a valid stack guard.  The v8::Locker object
     // will ensure this too, but we don't have to use lockers if we are only
@@ -114,9 +131,11 @@ bool V8::Initialize(Deserializer* des) {
   // Setup the CPU support. Must be done after heap setup and after
   // any deserialization because we have to have the initial heap
   // objects in place for creating the code object used for probing.
-  CPU::Setup();
-
-  OProfileAgent::Initialize();
+  // The CPU features are the same for all isolates.
+  if (!cpu_has_been_setup) {
+    CPU::Setup();
+    cpu_has_been_setup = true;
+  }
 
   // If we are deserializing, log non-function code objects and compiled
   // functions found in the snapshot.
@@ -131,15 +150,17 @@ bool V8::Initialize(Deserializer* des) {
 
 
 void V8::SetFatalError() {
-  is_running_ = false;
-  has_fatal_error_ = true;
+  data()->is_running_ = false;
+  data()->has_fatal_error_ = true;
 }
 
 
 void V8::TearDown() {
-  if (!has_been_setup_ || has_been_disposed_) return;
+  Data* data = V8::data();
+  if (!data->has_been_setup_ || data->has_been_disposed_) return;
+  bool is_default_isolate = Isolate::Current()->IsDefaultIsolate();
 
-  OProfileAgent::TearDown();
+  if (is_default_isolate) OProfileAgent::TearDown();
 
   if (FLAG_preemption) {
     v8::Locker locker;
@@ -157,10 +178,11 @@ void V8::TearDown() {
 
   Heap::TearDown();
 
-  Logger::TearDown();
+  // The log is shared by all isolates.
+  if (is_default_isolate) Logger::TearDown();
 
-  is_running_ = false;
-  has_been_disposed_ = true;
+  data->is_running_ = false;
+  data->has_been_disposed_ = true;
 }
 
 
@@ -174,8 +196,8 @@ static uint32_t random_seed() {
 
 uint32_t V8::Random() {
   // Random number generator using George Marsaglia's MWC algorithm.
-  static uint32_t hi = 0;
-  static uint32_t lo = 0;
+  uint32_t hi = data()->random_hi_;
+  uint32_t lo = data()->random_lo_;
 
   // Initialize seed using the system random(). If one of the seeds
   // should ever become zero again, or if random() returns zero, we
@@ -187,6 +209,8 @@ uint32_t V8::Random() {
   // Mix the bits.
   hi = 36969 * (hi & 0xFFFF) + (hi >> 16);
   lo = 18273 * (lo & 0xFFFF) + (lo >> 16);
+  data()->random_hi_ = hi;
+  data()->random_lo_ = lo;
   return (hi << 16) + (lo & 0xFFFF);
 }
 
@@ -58,6 +58,7 @@
 #include "allocation.h"
 #include "utils.h"
 #include "flags.h"
+#include "isolate.h"
 
 // Objects & heap
 #include "objects.h"
@@ -86,9 +87,11 @@ class V8 : public AllStatic {
   // empty heap.
   static bool Initialize(Deserializer* des);
   static void TearDown();
-  static bool IsRunning() { return is_running_; }
+  static bool IsRunning() { return data()->is_running_; }
   // To be dead you have to have lived
-  static bool IsDead() { return has_fatal_error_ || has_been_disposed_; }
+  static bool IsDead() {
+    return data()->has_fatal_error_ || data()->has_been_disposed_;
+  }
   static void SetFatalError();
 
   // Report process out of memory. Implementation found in api.cc.
@@ -102,16 +105,32 @@ class V8 : public AllStatic {
   static bool IdleNotification();
 
  private:
-  // True if engine is currently running
-  static bool is_running_;
-  // True if V8 has ever been run
-  static bool has_been_setup_;
-  // True if error has been signaled for current engine
-  // (reset to false if engine is restarted)
-  static bool has_fatal_error_;
-  // True if engine has been shut down
-  // (reset if engine is restarted)
-  static bool has_been_disposed_;
+  class Data {
+   public:
+    // True if engine is currently running
+    bool is_running_;
+    // True if V8 has ever been run
+    bool has_been_setup_;
+    // True if error has been signaled for current engine
+    // (reset to false if engine is restarted)
+    bool has_fatal_error_;
+    // True if engine has been shut down
+    // (reset if engine is restarted)
+    bool has_been_disposed_;
+    // State of the random number generator.
+    uint32_t random_hi_;
+    uint32_t random_lo_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kV8Data));
+  }
+
+  // Sets up the parts of the VM that all isolates share.
+  static void SetupProcess();
+
+  friend class Isolate;
 };
 
 } }  // namespace v8::internal
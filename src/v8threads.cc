@@ -36,12 +36,6 @@
 
 namespace v8 {
 
-static internal::Thread::LocalStorageKey thread_state_key =
-    internal::Thread::CreateThreadLocalKey();
-static internal::Thread::LocalStorageKey thread_id_key =
-    internal::Thread::CreateThreadLocalKey();
-
-
 // Track whether this V8 instance has ever called v8::Locker. This allows the
 // API code to verify that the lock is always held when V8 is being entered.
 bool Locker::active_ = false;
@@ -128,14 +122,15 @@ bool ThreadManager::RestoreThread() {
   // First check whether the current thread has been 'lazily archived', ie
   // not archived at all.  If that is the case we put the state storage we
   // had prepared back in the free list, since we didn't need it after all.
-  if (lazily_archived_thread_.IsSelf()) {
-    lazily_archived_thread_.Initialize(ThreadHandle::INVALID);
-    ASSERT(Thread::GetThreadLocal(thread_state_key) ==
-           lazily_archived_thread_state_);
-    lazily_archived_thread_state_->set_id(kInvalidId);
-    lazily_archived_thread_state_->LinkInto(ThreadState::FREE_LIST);
-    lazily_archived_thread_state_ = NULL;
-    Thread::SetThreadLocal(thread_state_key, NULL);
+  Data* data = ThreadManager::data();
+  if (data->lazily_archived_thread_.IsSelf()) {
+    data->lazily_archived_thread_.Initialize(ThreadHandle::INVALID);
+    ASSERT(Thread::GetThreadLocal(data->thread_state_key_) ==
+           data->lazily_archived_thread_state_);
+    data->lazily_archived_thread_state_->set_id(kInvalidId);
+    data->lazily_archived_thread_state_->LinkInto(ThreadState::FREE_LIST);
+    data->lazily_archived_thread_state_ = NULL;
+    Thread::SetThreadLocal(data->thread_state_key_, NULL);
     return true;
   }
 
@@ -145,11 +140,12 @@ bool ThreadManager::RestoreThread() {
 
   // If there is another thread that was lazily archived then we have to really
   // archive it now.
-  if (lazily_archived_thread_.IsValid()) {
+  if (data->lazily_archived_thread_.IsValid()) {
     EagerlyArchiveThread();
   }
   ThreadState* state =
-      reinterpret_cast<ThreadState*>(Thread::GetThreadLocal(thread_state_key));
+      reinterpret_cast<ThreadState*>(
+          Thread::GetThreadLocal(data->thread_state_key_));
   if (state == NULL) {
     // This is a new thread.
     StackGuard::InitThread(access);
@@ -165,7 +161,7 @@ bool ThreadManager::RestoreThread() {
   from = StackGuard::RestoreStackGuard(from);
   from = RegExpStack::RestoreStack(from);
   from = Bootstrapper::RestoreState(from);
-  Thread::SetThreadLocal(thread_state_key, NULL);
+  Thread::SetThreadLocal(data->thread_state_key_, NULL);
   if (state->terminate_on_restore()) {
     StackGuard::TerminateExecution();
     state->set_terminate_on_restore(false);
@@ -178,15 +174,15 @@ bool ThreadManager::RestoreThread() {
 
 
 void ThreadManager::Lock() {
-  mutex_->Lock();
-  mutex_owner_.Initialize(ThreadHandle::SELF);
+  data()->mutex_->Lock();
+  data()->mutex_owner_.Initialize(ThreadHandle::SELF);
   ASSERT(IsLockedByCurrentThread());
 }
 
 
 void ThreadManager::Unlock() {
-  mutex_owner_.Initialize(ThreadHandle::INVALID);
-  mutex_->Unlock();
+  data()->mutex_owner_.Initialize(ThreadHandle::INVALID);
+  data()->mutex_->Unlock();
 }
 
 
@@ -203,16 +199,29 @@ static int ArchiveSpacePerThread() {
 }
 
 
-ThreadState* ThreadState::free_anchor_ = new ThreadState();
-ThreadState* ThreadState::in_use_anchor_ = new ThreadState();
-
-
 ThreadState::ThreadState() : id_(ThreadManager::kInvalidId),
                              terminate_on_restore_(false),
+                             data_(NULL),
                              next_(this), previous_(this) {
 }
 
 
+ThreadState::~ThreadState() {
+  DeleteArray(data_);
+}
+
+
+void ThreadState::DeleteList(ThreadState* anchor) {
+  ThreadState* state = anchor->next_;
+  while (state != anchor) {
+    ThreadState* next = state->next_;
+    delete state;
+    state = next;
+  }
+  delete anchor;
+}
+
+
 void ThreadState::AllocateSpace() {
   data_ = NewArray<char>(ArchiveSpacePerThread());
 }
@@ -226,7 +235,8 @@ void ThreadState::Unlink() {
 
 void ThreadState::LinkInto(List list) {
   ThreadState* flying_anchor =
-      list == FREE_LIST ? free_anchor_ : in_use_anchor_;
+      list == FREE_LIST ? ThreadManager::data()->free_anchor_
+                        : ThreadManager::data()->in_use_anchor_;
   next_ = flying_anchor->next_;
   previous_ = flying_anchor;
   flying_anchor->next_ = this;
@@ -235,8 +245,9 @@ void ThreadState::LinkInto(List list) {
 
 
 ThreadState* ThreadState::GetFree() {
-  ThreadState* gotten = free_anchor_->next_;
-  if (gotten == free_anchor_) {
+  ThreadState* free_anchor = ThreadManager::data()->free_anchor_;
+  ThreadState* gotten = free_anchor->next_;
+  if (gotten == free_anchor) {
     ThreadState* new_thread_state = new ThreadState();
     new_thread_state->AllocateSpace();
     return new_thread_state;
@@ -247,12 +258,12 @@ ThreadState* ThreadState::GetFree() {
 
 // Gets the first in the list of archived threads.
 ThreadState* ThreadState::FirstInUse() {
-  return in_use_anchor_->Next();
+  return ThreadManager::data()->in_use_anchor_->Next();
 }
 
 
 ThreadState* ThreadState::Next() {
-  if (next_ == in_use_anchor_) return NULL;
+  if (next_ == ThreadManager::data()->in_use_anchor_) return NULL;
   return next_;
 }
 
@@ -260,21 +271,40 @@ ThreadState* ThreadState::Next() {
 // Thread ids must start with 1, because in TLS having thread id 0 can't
 // be distinguished from not having a thread id at all (since NULL is
 // defined as 0.)
-int ThreadManager::last_id_ = 0;
-Mutex* ThreadManager::mutex_ = OS::CreateMutex();
-ThreadHandle ThreadManager::mutex_owner_(ThreadHandle::INVALID);
-ThreadHandle ThreadManager::lazily_archived_thread_(ThreadHandle::INVALID);
-ThreadState* ThreadManager::lazily_archived_thread_state_ = NULL;
+ThreadManager::Data::Data()
+    : last_id_(0),
+      mutex_(OS::CreateMutex()),
+      mutex_owner_(ThreadHandle::INVALID),
+      lazily_archived_thread_(ThreadHandle::INVALID),
+      lazily_archived_thread_state_(NULL),
+      free_anchor_(new ThreadState()),
+      in_use_anchor_(new ThreadState()),
+      thread_state_key_(Thread::CreateThreadLocalKey()),
+      thread_id_key_(Thread::CreateThreadLocalKey()) {
+}
+
+
+ThreadManager::Data::~Data() {
+  ThreadState::DeleteList(free_anchor_);
+  ThreadState::DeleteList(in_use_anchor_);
+  Thread::DeleteThreadLocalKey(thread_state_key_);
+  Thread::DeleteThreadLocalKey(thread_id_key_);
+  delete mutex_;
+}
+
+
+DEFINE_ISOLATE_COMPONENT(ThreadManager)
 
 
 void ThreadManager::ArchiveThread() {
-  ASSERT(!lazily_archived_thread_.IsValid());
+  ASSERT(!data()->lazily_archived_thread_.IsValid());
   ASSERT(!IsArchived());
   ThreadState* state = ThreadState::GetFree();
   state->Unlink();
-  Thread::SetThreadLocal(thread_state_key, reinterpret_cast<void*>(state));
-  lazily_archived_thread_.Initialize(ThreadHandle::SELF);
-  lazily_archived_thread_state_ = state;
+  Thread::SetThreadLocal(data()->thread_state_key_,
+                         reinterpret_cast<void*>(state));
+  data()->lazily_archived_thread_.Initialize(ThreadHandle::SELF);
+  data()->lazily_archived_thread_state_ = state;
   ASSERT(state->id() == kInvalidId);
   state->set_id(CurrentId());
   ASSERT(state->id() != kInvalidId);
@@ -282,7 +312,7 @@ void ThreadManager::ArchiveThread() {
 
 
 void ThreadManager::EagerlyArchiveThread() {
-  ThreadState* state = lazily_archived_thread_state_;
+  ThreadState* state = data()->lazily_archived_thread_state_;
   state->LinkInto(ThreadState::IN_USE_LIST);
   char* to = state->data();
   // Ensure that data containing GC roots are archived first, and handle them
@@ -296,8 +326,8 @@ void ThreadManager::EagerlyArchiveThread() {
   to = StackGuard::ArchiveStackGuard(to);
   to = RegExpStack::ArchiveStack(to);
   to = Bootstrapper::ArchiveState(to);
-  lazily_archived_thread_.Initialize(ThreadHandle::INVALID);
-  lazily_archived_thread_state_ = NULL;
+  data()->lazily_archived_thread_.Initialize(ThreadHandle::INVALID);
+  data()->lazily_archived_thread_state_ = NULL;
 }
 
 
@@ -314,7 +344,7 @@ void ThreadManager::FreeThreadResources() {
 
 
 bool ThreadManager::IsArchived() {
-  return Thread::HasThreadLocal(thread_state_key);
+  return Thread::HasThreadLocal(data()->thread_state_key_);
 }
 
 
@@ -365,23 +395,23 @@ void ThreadManager::MarkCompactEpilogue(bool is_compacting) {
 
 
 int ThreadManager::CurrentId() {
-  return Thread::GetThreadLocalInt(thread_id_key);
+  return Thread::GetThreadLocalInt(data()->thread_id_key_);
 }
 
 
 void ThreadManager::AssignId() {
   if (!HasId()) {
     ASSERT(Locker::IsLocked());
-    int thread_id = ++last_id_;
+    int thread_id = ++data()->last_id_;
     ASSERT(thread_id > 0);  // see the comment near last_id_ definition.
-    Thread::SetThreadLocalInt(thread_id_key, thread_id);
+    Thread::SetThreadLocalInt(data()->thread_id_key_, thread_id);
     Top::set_thread_id(thread_id);
   }
 }
 
 
 bool ThreadManager::HasId() {
-  return Thread::HasThreadLocal(thread_id_key);
+  return Thread::HasThreadLocal(data()->thread_id_key_);
 }
 
 
@@ -397,12 +427,13 @@ void ThreadManager::TerminateExecution(int thread_id) {
 
 
 // This is the ContextSwitcher singleton. There is at most a single thread
-// running which delivers preemption events to V8 threads.
-ContextSwitcher* ContextSwitcher::singleton_ = NULL;
+// per isolate running which delivers preemption events to V8 threads.
+DEFINE_ISOLATE_COMPONENT(ContextSwitcher)
 
 
 ContextSwitcher::ContextSwitcher(int every_n_ms)
-  : keep_going_(true),
+  : isolate_(Isolate::Current()),
+    keep_going_(true),
     sleep_ms_(every_n_ms) {
 }
 
@@ -411,14 +442,15 @@ ContextSwitcher::ContextSwitcher(int every_n_ms)
 // ContextSwitcher thread if needed.
 void ContextSwitcher::StartPreemption(int every_n_ms) {
   ASSERT(Locker::IsLocked());
-  if (singleton_ == NULL) {
+  Data* data = ContextSwitcher::data();
+  if (data->singleton_ == NULL) {
     // If the ContextSwitcher thread is not running at the moment start it now.
-    singleton_ = new ContextSwitcher(every_n_ms);
-    singleton_->Start();
+    data->singleton_ = new ContextSwitcher(every_n_ms);
+    data->singleton_->Start();
   } else {
     // ContextSwitcher thread is already running, so we just change the
     // scheduling interval.
-    singleton_->sleep_ms_ = every_n_ms;
+    data->singleton_->sleep_ms_ = every_n_ms;
   }
 }
 
@@ -427,14 +459,15 @@ void ContextSwitcher::StartPreemption(int every_n_ms) {
 // must cooperatively schedule amongst them from this point on.
 void ContextSwitcher::StopPreemption() {
   ASSERT(Locker::IsLocked());
-  if (singleton_ != NULL) {
+  Data* data = ContextSwitcher::data();
+  if (data->singleton_ != NULL) {
     // The ContextSwitcher thread is running. We need to stop it and release
     // its resources.
-    singleton_->keep_going_ = false;
-    singleton_->Join();  // Wait for the ContextSwitcher thread to exit.
+    data->singleton_->keep_going_ = false;
+    data->singleton_->Join();  // Wait for the ContextSwitcher thread to exit.
     // Thread has exited, now we can delete it.
-    delete(singleton_);
-    singleton_ = NULL;
+    delete(data->singleton_);
+    data->singleton_ = NULL;
   }
 }
 
@@ -442,10 +475,12 @@ void ContextSwitcher::StopPreemption() {
 // Main loop of the ContextSwitcher thread: Preempt the currently running V8
 // thread at regular intervals.
 void ContextSwitcher::Run() {
+  isolate_->Enter();
   while (keep_going_) {
     OS::Sleep(sleep_ms_);
     StackGuard::Preempt();
   }
+  isolate_->Exit();
 }
 
 
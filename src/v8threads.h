@@ -60,6 +60,11 @@ class ThreadState {
   char* data() { return data_; }
  private:
   ThreadState();
+  ~ThreadState();
+
+  // Deletes the states on the list with the given flying anchor, and the
+  // anchor.
+  static void DeleteList(ThreadState* anchor);
 
   void AllocateSpace();
 
@@ -69,13 +74,7 @@ class ThreadState {
   ThreadState* next_;
   ThreadState* previous_;
 
-  // In the following two lists there is always at least one object on the list.
-  // The first object is a flying anchor that is only there to simplify linking
-  // and unlinking.
-  // Head of linked list of free states.
-  static ThreadState* free_anchor_;
-  // Head of linked list of states in use.
-  static ThreadState* in_use_anchor_;
+  friend class ThreadManager;
 };
 
 
@@ -107,7 +106,9 @@ class ThreadManager : public AllStatic {
   static void IterateArchivedThreads(ThreadVisitor* v);
   static void MarkCompactPrologue(bool is_compacting);
   static void MarkCompactEpilogue(bool is_compacting);
-  static bool IsLockedByCurrentThread() { return mutex_owner_.IsSelf(); }
+  static bool IsLockedByCurrentThread() {
+    return data()->mutex_owner_.IsSelf();
+  }
 
   static int CurrentId();
   static void AssignId();
@@ -119,11 +120,37 @@ class ThreadManager : public AllStatic {
  private:
   static void EagerlyArchiveThread();
 
-  static int last_id_;  // V8 threads are identified through an integer.
-  static Mutex* mutex_;
-  static ThreadHandle mutex_owner_;
-  static ThreadHandle lazily_archived_thread_;
-  static ThreadState* lazily_archived_thread_state_;
+  class Data {
+   public:
+    Data();
+    ~Data();
+
+    int last_id_;  // V8 threads are identified through an integer.
+    Mutex* mutex_;
+    ThreadHandle mutex_owner_;
+    ThreadHandle lazily_archived_thread_;
+    ThreadState* lazily_archived_thread_state_;
+
+    // In the following two lists there is always at least one object on the
+    // list. The first object is a flying anchor that is only there to
+    // simplify linking and unlinking.
+    // Head of linked list of free states.
+    ThreadState* free_anchor_;
+    // Head of linked list of states in use.
+    ThreadState* in_use_anchor_;
+
+    // The archived state and the id of a thread in this isolate.
+    Thread::LocalStorageKey thread_state_key_;
+    Thread::LocalStorageKey thread_id_key_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kThreadManagerData));
+  }
+
+  friend class Isolate;
+  friend class ThreadState;
 };
 
 
@@ -131,6 +158,8 @@ class ThreadManager : public AllStatic {
 // multiple running V8 threads. Generally it is necessary to call
 // StartPreemption if there is more than one thread running. If not, a single
 // JavaScript can take full control of V8 and not allow other threads to run.
+// Each isolate has its own ContextSwitcher thread, which preempts the threads
+// of that isolate.
 class ContextSwitcher: public Thread {
  public:
   // Set the preemption interval for the ContextSwitcher thread.
@@ -148,10 +177,21 @@ class ContextSwitcher: public Thread {
 
   void Run();
 
+  Isolate* isolate_;
   bool keep_going_;
   int sleep_ms_;
 
-  static ContextSwitcher* singleton_;
+  class Data {
+   public:
+    ContextSwitcher* singleton_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kContextSwitcherData));
+  }
+
+  friend class Isolate;
 };
 
 } }  // namespace v8::internal
@@ -83,8 +83,8 @@ void VirtualFrame::PrepareForReturn() {
 VirtualFrame::RegisterAllocationScope::RegisterAllocationScope(
     CodeGenerator* cgen)
   : cgen_(cgen),
-    old_is_spilled_(SpilledScope::is_spilled_) {
-  SpilledScope::is_spilled_ = false;
+    old_is_spilled_(SpilledScope::is_spilled()) {
+  SpilledScope::set_is_spilled(false);
   if (old_is_spilled_) {
     VirtualFrame* frame = cgen->frame();
     if (frame != NULL) {
@@ -95,7 +95,7 @@ VirtualFrame::RegisterAllocationScope::RegisterAllocationScope(
 
 
 VirtualFrame::RegisterAllocationScope::~RegisterAllocationScope() {
-  SpilledScope::is_spilled_ = old_is_spilled_;
+  SpilledScope::set_is_spilled(old_is_spilled_);
   if (old_is_spilled_) {
     VirtualFrame* frame = cgen_->frame();
     if (frame != NULL) {
@@ -74,8 +74,9 @@ VMState::VMState(StateTag state)
   if (state == EXTERNAL) state = OTHER;
 #endif
   state_ = state;
-  previous_ = current_state_;  // Save the previous state.
-  current_state_ = this;       // Install the new state.
+  Data* data = VMState::data();
+  previous_ = data->current_state_;  // Save the previous state.
+  data->current_state_ = this;       // Install the new state.
 
 #ifdef ENABLE_LOGGING_AND_PROFILING
   if (FLAG_log_state_changes) {
@@ -103,7 +104,7 @@ VMState::VMState(StateTag state)
 
 VMState::~VMState() {
   if (disabled_) return;
-  current_state_ = previous_;  // Return to the previous state.
+  data()->current_state_ = previous_;  // Return to the previous state.
 
 #ifdef ENABLE_LOGGING_AND_PROFILING
   if (FLAG_log_state_changes) {
@@ -32,8 +32,6 @@
 namespace v8 {
 namespace internal {
 
-#ifdef ENABLE_VMSTATE_TRACKING
-VMState* VMState::current_state_ = NULL;
-#endif
+DEFINE_ISOLATE_COMPONENT(VMState)
 
 } }  // namespace v8::internal
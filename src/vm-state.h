@@ -44,15 +44,17 @@ class VMState BASE_EMBEDDED {
 
   // Used for debug asserts.
   static bool is_outermost_external() {
-    return current_state_ == NULL;
+    return data()->current_state_ == NULL;
   }
 
   static StateTag current_state() {
-    return current_state_ ? current_state_->state() : EXTERNAL;
+    VMState* state = data()->current_state_;
+    return state != NULL ? state->state() : EXTERNAL;
   }
 
   static Address external_callback() {
-    return current_state_ ? current_state_->external_callback_ : NULL;
+    VMState* state = data()->current_state_;
+    return state != NULL ? state->external_callback_ : NULL;
   }
 
  private:
@@ -60,13 +62,24 @@ class VMState BASE_EMBEDDED {
   StateTag state_;
   VMState* previous_;
   Address external_callback_;
-
-  // A stack of VM states.
-  static VMState* current_state_;
 #else
  public:
   explicit VMState(StateTag state) {}
 #endif
+
+ private:
+  class Data {
+   public:
+    // A stack of VM states.
+    VMState* current_state_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kVMStateData));
+  }
+
+  friend class Isolate;
 };
 
 } }  // namespace v8::internal
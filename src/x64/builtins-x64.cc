@@ -956,6 +956,11 @@ static void Generate_JSConstructStubHelper(MacroAssembler* masm,
     __ CmpInstanceType(rax, JS_FUNCTION_TYPE);
     __ j(equal, &rt_call);
 
+    // Pretenured objects are allocated in old space by the runtime.
+    __ testb(FieldOperand(rax, Map::kBitField2Offset),
+             Immediate(1 << Map::kIsPretenured));
+    __ j(not_zero, &rt_call);
+
     // Now allocate the JSObject on the heap.
     __ movzxbq(rdi, FieldOperand(rax, Map::kInstanceSizeOffset));
     __ shl(rdi, Immediate(kPointerSizeLog2));
@@ -8208,7 +8208,8 @@ void TranscendentalCacheStub::Generate(MacroAssembler* masm) {
   // rcx = TranscendentalCache::hash(double value).
   __ movq(rax, ExternalReference::transcendental_cache_array_address());
   // rax points to cache array.
-  __ movq(rax, Operand(rax, type_ * sizeof(TranscendentalCache::caches_[0])));
+  __ movq(rax, Operand(rax, type_ *
+                       sizeof(TranscendentalCache::data()->caches_[0])));
   // rax points to the cache for the type type_.
   // If NULL, the cache hasn't been initialized yet, so go through runtime.
   __ testq(rax, rax);
@@ -8585,6 +8586,20 @@ void RegExpExecStub::Generate(MacroAssembler* masm) {
   __ SmiCompare(rax, rbx);
   __ j(above_equal, &runtime);
 
+  // rax: Previous index as smi
+  // rbx: Length of subject string as smi
+  // rcx: RegExp data (FixedArray)
+  // Leave long subjects to the runtime if the regexp has a literal prefix,
+  // as searching for the prefix first is faster than trying each position.
+  Label no_prefix_scan;
+  __ subq(rbx, rax);
+  __ SmiCompare(rbx, Smi::FromInt(RegExpImpl::kPrefixScanMinLength));
+  __ j(less, &no_prefix_scan);
+  __ CompareRoot(FieldOperand(rcx, JSRegExp::kIrregexpPrefixOffset),
+                 Heap::kUndefinedValueRootIndex);
+  __ j(not_equal, &runtime);
+  __ bind(&no_prefix_scan);
+
   // rcx: RegExp data (FixedArray)
   // rdx: Number of capture registers
   // Check that the fourth object is a JSArray object.
@@ -8768,7 +8783,8 @@ void RegExpExecStub::Generate(MacroAssembler* masm) {
   __ cmpl(rax, Immediate(NativeRegExpMacroAssembler::FAILURE));
   __ j(equal, &failure);
   __ cmpl(rax, Immediate(NativeRegExpMacroAssembler::EXCEPTION));
-  // If not exception it can only be retry. Handle that in the runtime system.
+  // If not exception it can only be retry or an exceeded backtrack limit.
+  // Handle that in the runtime system.
   __ j(not_equal, &runtime);
   // Result must now be exception. If there is no pending exception already a
   // stack overflow (on the backtrack stack) was detected in RegExp code but
@@ -10957,8 +10973,13 @@ void StringCharCodeAtGenerator::GenerateFast(MacroAssembler* masm) {
   __ j(zero, &flat_string);
 
   // Handle non-flat strings.
-  __ testb(result_, Immediate(kIsConsStringMask));
-  __ j(zero, &call_runtime_);
+  Label sliced_string;
+  __ and_(result_, Immediate(kStringRepresentationMask));
+  ASSERT(kConsStringTag < kExternalStringTag);
+  ASSERT(kSlicedStringTag > kExternalStringTag);
+  __ cmpb(result_, Immediate(kExternalStringTag));
+  __ j(greater, &sliced_string);
+  __ j(equal, &call_runtime_);
 
   // ConsString.
   // Check whether the right hand side is the empty string (i.e. if
@@ -10976,6 +10997,22 @@ void StringCharCodeAtGenerator::GenerateFast(MacroAssembler* masm) {
   ASSERT(kSeqStringTag == 0);
   __ testb(result_, Immediate(kStringRepresentationMask));
   __ j(not_zero, &call_runtime_);
+  __ jmp(&flat_string);
+
+  // SlicedString.
+  // The parent of a sliced string is either sequential or external. Only
+  // handle a sequential parent here and read the character from it at the
+  // index adjusted by the offset of the slice.
+  __ bind(&sliced_string);
+  __ movq(result_, FieldOperand(object_, SlicedString::kParentOffset));
+  __ movq(result_, FieldOperand(result_, HeapObject::kMapOffset));
+  __ movzxbl(result_, FieldOperand(result_, Map::kInstanceTypeOffset));
+  ASSERT(kSeqStringTag == 0);
+  __ testb(result_, Immediate(kStringRepresentationMask));
+  __ j(not_zero, &call_runtime_);
+  // Both the index and the offset are smis, so they can be added directly.
+  __ addq(scratch_, FieldOperand(object_, SlicedString::kOffsetOffset));
+  __ movq(object_, FieldOperand(object_, SlicedString::kParentOffset));
 
   // Check for 1-byte or 2-byte string.
   __ bind(&flat_string);
@@ -11662,6 +11699,53 @@ void SubStringStub::Generate(MacroAssembler* masm) {
   // rax: string
   // rbx: instance type
   // rcx: result string length
+  // Long sub strings share the characters of the string instead of copying
+  // them. The sliced string refers to the underlying sequential string.
+  Label copy_string, make_sliced_string, set_slice_fields;
+  __ cmpl(rcx, Immediate(SlicedString::kMinLength));
+  __ j(less, &copy_string);
+  __ movq(rdx, Operand(rsp, kFromOffset));
+  __ movl(rdi, rbx);
+  __ and_(rdi, Immediate(kStringRepresentationMask));
+  ASSERT_EQ(0, kSeqStringTag);
+  __ j(zero, &make_sliced_string);
+  __ cmpl(rdi, Immediate(kSlicedStringTag));
+  __ j(not_equal, &runtime);
+  // A slice of a sliced string refers to the parent of the slice. Both the
+  // index and the offset are smis, so they can be added directly.
+  __ addq(rdx, FieldOperand(rax, SlicedString::kOffsetOffset));
+  __ movq(rax, FieldOperand(rax, SlicedString::kParentOffset));
+  __ movq(rbx, FieldOperand(rax, HeapObject::kMapOffset));
+  __ movzxbl(rbx, FieldOperand(rbx, Map::kInstanceTypeOffset));
+  // External parents are handled in the runtime system.
+  __ testb(rbx, Immediate(kStringRepresentationMask));
+  __ j(not_zero, &runtime);
+
+  __ bind(&make_sliced_string);
+  // rax: sequential parent string
+  // rbx: instance type of parent string
+  // rcx: result string length
+  // rdx: offset of the result in the parent (smi)
+  Label two_byte_slice;
+  ASSERT(kAsciiStringTag != 0);
+  __ testb(rbx, Immediate(kStringEncodingMask));
+  __ j(zero, &two_byte_slice);
+  __ AllocateAsciiSlicedString(rdi, rbx, no_reg, &runtime);
+  __ jmp(&set_slice_fields);
+  __ bind(&two_byte_slice);
+  __ AllocateSlicedString(rdi, rbx, no_reg, &runtime);
+  __ bind(&set_slice_fields);
+  __ Integer32ToSmi(rcx, rcx);
+  __ movq(FieldOperand(rdi, String::kLengthOffset), rcx);
+  __ movq(FieldOperand(rdi, String::kHashFieldOffset),
+          Immediate(String::kEmptyHashField));
+  __ movq(FieldOperand(rdi, SlicedString::kParentOffset), rax);
+  __ movq(FieldOperand(rdi, SlicedString::kOffsetOffset), rdx);
+  __ movq(rax, rdi);
+  __ IncrementCounter(&Counters::sub_string_native, 1);
+  __ ret(kArgumentsSize);
+
+  __ bind(&copy_string);
   // Check for flat ascii string
   Label non_ascii_flat;
   __ JumpIfInstanceTypeIsNotSequentialAscii(rbx, rbx, &non_ascii_flat);
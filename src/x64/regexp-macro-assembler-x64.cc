@@ -85,6 +85,8 @@ namespace internal {
  *      position -1). Used to initialize capture registers to a non-position.
  *    - At start of string (if 1, we are starting at the start of the
  *      string, otherwise 0)
+ *    - Number of backtracks so far (only used when backtracking is
+ *      limited, see --regexp-backtrack-limit).
  *    - register 0  rbp[-n]   (Only positions must be stored in the first
  *    - register 1  rbp[-n-8]  num_saved_registers_ registers)
  *    - ...
@@ -164,6 +166,12 @@ void RegExpMacroAssemblerX64::AdvanceRegister(int reg, int by) {
 
 void RegExpMacroAssemblerX64::Backtrack() {
   CheckPreemption();
+  int limit = backtrack_limit();
+  if (limit > 0) {
+    __ incq(Operand(rbp, kBacktrackCount));
+    __ cmpq(Operand(rbp, kBacktrackCount), Immediate(limit));
+    __ j(equal, &backtrack_limit_label_);
+  }
   // Pop Code* offset from backtrack stack, add Code* and jump to location.
   Pop(rbx);
   __ addq(rbx, code_object_pointer());
@@ -739,6 +747,7 @@ Handle<Object> RegExpMacroAssemblerX64::GetCode(Handle<String> source) {
 #endif
 
   __ push(Immediate(0));  // Make room for "at start" constant.
+  __ push(Immediate(0));  // Backtrack count.
 
   // Check if we have space on the stack for registers.
   Label stack_limit_hit;
@@ -883,6 +892,13 @@ Handle<Object> RegExpMacroAssemblerX64::GetCode(Handle<String> source) {
 
   Label exit_with_exception;
 
+  // Exit after too many backtracks.
+  if (backtrack_limit_label_.is_linked()) {
+    __ bind(&backtrack_limit_label_);
+    __ movq(rax, Immediate(BACKTRACK_LIMIT));
+    __ jmp(&exit_label_);
+  }
+
   // Preempt-code
   if (check_preempt_label_.is_linked()) {
     SafeCallTarget(&check_preempt_label_);
@@ -1181,10 +1197,11 @@ int RegExpMacroAssemblerX64::CheckStackGuardState(Address* return_address,
   }
 
   // Otherwise, the content of the string might have moved. It must still
-  // be a sequential or external string with the same content.
+  // be a sequential, sliced or external string with the same content.
   // Update the start and end pointers in the stack frame to the current
   // location (whether it has actually moved or not).
   ASSERT(StringShape(*subject).IsSequential() ||
+      StringShape(*subject).IsSliced() ||
       StringShape(*subject).IsExternal());
 
   // The original start address of the characters to match.
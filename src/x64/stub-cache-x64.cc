@@ -2245,6 +2245,11 @@ Object* ConstructStubCompiler::CompileConstructStub(
   __ Assert(not_equal, "Function constructed by construct stub.");
 #endif
 
+  // Pretenured objects are allocated in old space by the generic stub.
+  __ testb(FieldOperand(rbx, Map::kBitField2Offset),
+           Immediate(1 << Map::kIsPretenured));
+  __ j(not_zero, &generic_stub_call);
+
   // Now allocate the JSObject in new space.
   // rdi: constructor
   // rbx: initial map
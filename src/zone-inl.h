@@ -42,8 +42,9 @@ inline void* Zone::New(int size) {
   size = RoundUp(size, kAlignment);
 
   // Check if the requested size is available without expanding.
-  Address result = position_;
-  if ((position_ += size) > limit_) result = NewExpand(size);
+  Data* data = Zone::data();
+  Address result = data->position_;
+  if ((data->position_ += size) > data->limit_) result = NewExpand(size);
 
   // Check that the result has the proper alignment and return it.
   ASSERT(IsAddressAligned(result, kAlignment, 0));
@@ -58,13 +59,15 @@ T* Zone::NewArray(int length) {
 
 
 bool Zone::excess_allocation() {
-  return segment_bytes_allocated_ > zone_excess_limit_;
+  Data* data = Zone::data();
+  return data->segment_bytes_allocated_ > data->zone_excess_limit_;
 }
 
 
 void Zone::adjust_segment_bytes_allocated(int delta) {
-  segment_bytes_allocated_ += delta;
-  Counters::zone_segment_bytes.Set(segment_bytes_allocated_);
+  Data* data = Zone::data();
+  data->segment_bytes_allocated_ += delta;
+  Counters::zone_segment_bytes.Set(data->segment_bytes_allocated_);
 }
 
 
@@ -34,14 +34,9 @@ namespace v8 {
 namespace internal {
 
 
-Address Zone::position_ = 0;
-Address Zone::limit_ = 0;
-int Zone::zone_excess_limit_ = 256 * MB;
-int Zone::segment_bytes_allocated_ = 0;
-
-bool AssertNoZoneAllocation::allow_allocation_ = true;
-
-int ZoneScope::nesting_ = 0;
+DEFINE_ISOLATE_COMPONENT(Zone)
+DEFINE_ISOLATE_COMPONENT(AssertNoZoneAllocation)
+DEFINE_ISOLATE_COMPONENT(ZoneScope)
 
 // Segments represent chunks of memory: They have starting address
 // (encoded in the this pointer) and a size in bytes. Segments are
@@ -60,8 +55,8 @@ class Segment {
   Address start() const { return address(sizeof(Segment)); }
   Address end() const { return address(size_); }
 
-  static Segment* head() { return head_; }
-  static void set_head(Segment* head) { head_ = head; }
+  static Segment* head() { return data()->head_; }
+  static void set_head(Segment* head) { data()->head_ = head; }
 
   // Creates a new segment, sets it size, and pushes it to the front
   // of the segment chain. Returns the new segment.
@@ -69,9 +64,10 @@ class Segment {
     Segment* result = reinterpret_cast<Segment*>(Malloced::New(size));
     Zone::adjust_segment_bytes_allocated(size);
     if (result != NULL) {
-      result->next_ = head_;
+      Data* data = Segment::data();
+      result->next_ = data->head_;
       result->size_ = size;
-      head_ = result;
+      data->head_ = result;
     }
     return result;
   }
@@ -82,23 +78,42 @@ class Segment {
     Malloced::Delete(segment);
   }
 
-  static int bytes_allocated() { return bytes_allocated_; }
+  static int bytes_allocated() { return data()->bytes_allocated_; }
 
  private:
+  class Data {
+   public:
+    // Frees the segments that are left when the isolate goes away.
+    ~Data() {
+      while (head_ != NULL) {
+        Segment* next = head_->next();
+        Malloced::Delete(head_);
+        head_ = next;
+      }
+    }
+
+    Segment* head_;
+    int bytes_allocated_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kSegmentData));
+  }
+
   // Computes the address of the nth byte in this segment.
   Address address(int n) const {
     return Address(this) + n;
   }
 
-  static Segment* head_;
-  static int bytes_allocated_;
   Segment* next_;
   int size_;
+
+  friend class Isolate;
 };
 
 
-Segment* Segment::head_ = NULL;
-int Segment::bytes_allocated_ = 0;
+DEFINE_ISOLATE_COMPONENT(Segment)
 
 
 void Zone::DeleteAll() {
@@ -136,16 +151,17 @@ void Zone::DeleteAll() {
   // variables 'position' and 'limit' to prepare for future allocate
   // attempts. Otherwise, we must clear the position and limit to
   // force a new segment to be allocated on demand.
+  Data* data = Zone::data();
   if (keep != NULL) {
     Address start = keep->start();
-    position_ = RoundUp(start, kAlignment);
-    limit_ = keep->end();
+    data->position_ = RoundUp(start, kAlignment);
+    data->limit_ = keep->end();
 #ifdef DEBUG
     // Zap the contents of the kept segment (but not the header).
     memset(start, kZapDeadByte, keep->capacity());
 #endif
   } else {
-    position_ = limit_ = 0;
+    data->position_ = data->limit_ = 0;
   }
 
   // Update the head segment to be the kept segment (if any).
@@ -156,8 +172,9 @@ void Zone::DeleteAll() {
 Address Zone::NewExpand(int size) {
   // Make sure the requested size is already properly aligned and that
   // there isn't enough room in the Zone to satisfy the request.
+  Data* data = Zone::data();
   ASSERT(size == RoundDown(size, kAlignment));
-  ASSERT(position_ + size > limit_);
+  ASSERT(data->position_ + size > data->limit_);
 
   // Compute the new segment size. We use a 'high water mark'
   // strategy, where we increase the segment size every time we expand
@@ -184,9 +201,9 @@ Address Zone::NewExpand(int size) {
 
   // Recompute 'top' and 'limit' based on the new segment.
   Address result = RoundUp(segment->start(), kAlignment);
-  position_ = result + size;
-  limit_ = segment->end();
-  ASSERT(position_ <= limit_);
+  data->position_ = result + size;
+  data->limit_ = segment->end();
+  ASSERT(data->position_ <= data->limit_);
   return result;
 }
 
@@ -85,16 +85,32 @@ class Zone {
   // Never keep segments larger than this size in bytes around.
   static const int kMaximumKeptSegmentSize = 64 * KB;
 
-  // Report zone excess when allocation exceeds this limit.
-  static int zone_excess_limit_;
-
-  // The number of bytes allocated in segments.  Note that this number
-  // includes memory allocated from the OS but not yet allocated from
-  // the zone.
-  static int segment_bytes_allocated_;
+  class Data {
+   public:
+    Data() : zone_excess_limit_(256 * MB) { }
+
+    // Report zone excess when allocation exceeds this limit.
+    int zone_excess_limit_;
+
+    // The number of bytes allocated in segments.  Note that this number
+    // includes memory allocated from the OS but not yet allocated from
+    // the zone.
+    int segment_bytes_allocated_;
+
+    // The free region in the current (front) segment is represented as
+    // the half-open interval [position, limit). The 'position' variable
+    // is guaranteed to be aligned as dictated by kAlignment.
+    Address position_;
+    Address limit_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kZoneData));
+  }
 
-  // The Zone is intentionally a singleton; you should not try to
-  // allocate instances of the class.
+  // The Zone is intentionally a singleton per isolate; you should not try
+  // to allocate instances of the class.
   Zone() { UNREACHABLE(); }
 
 
@@ -104,12 +120,7 @@ class Zone {
   // room in the Zone already.
   static Address NewExpand(int size);
 
-
-  // The free region in the current (front) segment is represented as
-  // the half-open interval [position, limit). The 'position' variable
-  // is guaranteed to be aligned as dictated by kAlignment.
-  static Address position_;
-  static Address limit_;
+  friend class Isolate;
 };
 
 
@@ -134,14 +145,28 @@ class ZoneObject {
 
 class AssertNoZoneAllocation {
  public:
-  AssertNoZoneAllocation() : prev_(allow_allocation_) {
-    allow_allocation_ = false;
+  AssertNoZoneAllocation() {
+    Data* data = AssertNoZoneAllocation::data();
+    prev_ = data->allow_allocation_;
+    data->allow_allocation_ = false;
   }
-  ~AssertNoZoneAllocation() { allow_allocation_ = prev_; }
-  static bool allow_allocation() { return allow_allocation_; }
+  ~AssertNoZoneAllocation() { data()->allow_allocation_ = prev_; }
+  static bool allow_allocation() { return data()->allow_allocation_; }
  private:
+  class Data {
+   public:
+    Data() : allow_allocation_(true) { }
+    bool allow_allocation_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(Isolate::Current()->component_data(
+        Isolate::kAssertNoZoneAllocationData));
+  }
+
   bool prev_;
-  static bool allow_allocation_;
+
+  friend class Isolate;
 };
 
 
@@ -178,16 +203,16 @@ class ZoneList: public List<T, ZoneListAllocationPolicy> {
 class ZoneScope BASE_EMBEDDED {
  public:
   explicit ZoneScope(ZoneScopeMode mode) : mode_(mode) {
-    nesting_++;
+    data()->nesting_++;
   }
 
   virtual ~ZoneScope() {
     if (ShouldDeleteOnExit()) Zone::DeleteAll();
-    --nesting_;
+    --data()->nesting_;
   }
 
   bool ShouldDeleteOnExit() {
-    return nesting_ == 1 && mode_ == DELETE_ON_EXIT;
+    return data()->nesting_ == 1 && mode_ == DELETE_ON_EXIT;
   }
 
   // For ZoneScopes that do not delete on exit by default, call this
@@ -196,11 +221,22 @@ class ZoneScope BASE_EMBEDDED {
     mode_ = DELETE_ON_EXIT;
   }
 
-  static int nesting() { return nesting_; }
+  static int nesting() { return data()->nesting_; }
 
  private:
+  class Data {
+   public:
+    int nesting_;
+  };
+
+  static Data* data() {
+    return static_cast<Data*>(
+        Isolate::Current()->component_data(Isolate::kZoneScopeData));
+  }
+
   ZoneScopeMode mode_;
-  static int nesting_;
+
+  friend class Isolate;
 };
 
 
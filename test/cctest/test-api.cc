@@ -32,6 +32,7 @@
 #include "api.h"
 #include "compilation-cache.h"
 #include "execution.h"
+#include "serialize.h"
 #include "snapshot.h"
 #include "platform.h"
 #include "top.h"
@@ -4184,6 +4185,66 @@ THREADED_TEST(StringWrite) {
 }
 
 
+THREADED_TEST(StringWriteUtf8) {
+  v8::HandleScope scope;
+  LocalContext context;
+  // "abc", U+00E9 and U+20AC.
+  const char* utf8 = "abc\xc3\xa9\xe2\x82\xac";
+  v8::Handle<String> str = String::New(utf8);
+  CHECK_EQ(5, str->Length());
+  CHECK_EQ(8, str->Utf8Length());
+  CHECK_EQ(8, str->Utf8Length());
+  v8::Handle<String> ascii = String::New("abcdefghijklmnopq\x7f");
+  CHECK_EQ(18, ascii->Length());
+  CHECK_EQ(18, ascii->Utf8Length());
+  v8::Handle<String> cons = v8::Handle<String>::Cast(
+      CompileRun("var s = 'abcdefghijklmnopqrstuvwxyz'; s + '\\u20ac' + s"));
+  CHECK_EQ(55, cons->Utf8Length());
+
+  char buf[100];
+  int len;
+  int nchars;
+
+  memset(buf, 0x1, sizeof(buf));
+  len = str->WriteUtf8(buf, sizeof(buf), &nchars);
+  CHECK_EQ(9, len);
+  CHECK_EQ(5, nchars);
+  CHECK_EQ(0, strcmp(utf8, buf));
+
+  // Characters that do not fit completely are not written.
+  memset(buf, 0x1, sizeof(buf));
+  len = str->WriteUtf8(buf, 7, &nchars);
+  CHECK_EQ(5, len);
+  CHECK_EQ(4, nchars);
+  CHECK_EQ(0, strncmp("abc\xc3\xa9\1", buf, 6));
+
+  memset(buf, 0x1, sizeof(buf));
+  len = str->WriteUtf8(buf, 8, &nchars);
+  CHECK_EQ(8, len);
+  CHECK_EQ(5, nchars);
+  CHECK_EQ(0, strncmp(utf8, buf, 8));
+  CHECK_EQ(1, buf[8]);
+
+  memset(buf, 0x1, sizeof(buf));
+  len = ascii->WriteUtf8(buf, 4, &nchars);
+  CHECK_EQ(4, len);
+  CHECK_EQ(4, nchars);
+  CHECK_EQ(0, strncmp("abcd\1", buf, 5));
+
+  memset(buf, 0x1, sizeof(buf));
+  len = ascii->WriteUtf8(buf, -1, &nchars);
+  CHECK_EQ(19, len);
+  CHECK_EQ(18, nchars);
+  CHECK_EQ(0, strcmp("abcdefghijklmnopq\x7f", buf));
+
+  memset(buf, 0x1, sizeof(buf));
+  len = cons->WriteUtf8(buf, sizeof(buf), &nchars);
+  CHECK_EQ(56, len);
+  CHECK_EQ(53, nchars);
+  CHECK_EQ(0, strncmp("xyz\xe2\x82\xac" "abc", buf + 23, 9));
+}
+
+
 THREADED_TEST(ToArrayIndex) {
   v8::HandleScope scope;
   LocalContext context;
@@ -8496,6 +8557,90 @@ TEST(PreCompileDeserializationError) {
 }
 
 
+static const char* kCodeCacheSource =
+    "function Point(x, y) { this.x = x; this.y = y; }\n"
+    "Point.prototype.sum = function() { return this.x + this.y; };\n"
+    "var points = [];\n"
+    "for (var i = 0; i < 10; i++) points.push(new Point(i, i * 0.5));\n"
+    "var total = 0;\n"
+    "for (var i = 0; i < points.length; i++) total += points[i].sum();\n"
+    "var o = { a: 1, b: 'two', c: [3, 4.5, 'six'] };\n"
+    "var text = 'caf\\u00e9'.toUpperCase() + /a(b+)/.exec('xabbb')[1];\n"
+    "(function() {\n"
+    "  try { throw new Error('e'); } catch (e) { return e.message; }\n"
+    "})() + total + o.c[2] + text.charCodeAt(3) + text.length;";
+
+
+static bool CodeCacheFits(v8::CodeCacheData* code_cache, const char* source) {
+  i::Handle<i::Script> script =
+      i::Factory::NewScript(v8::Utils::OpenHandle(*v8_str(source)));
+  i::Vector<const i::byte> data(
+      reinterpret_cast<const i::byte*>(code_cache->Data()),
+      code_cache->Length());
+  return !i::CodeSerializer::Deserialize(data, script).is_null();
+}
+
+
+// Tests that scripts can be compiled from the code cache made for them.
+TEST(CodeCache) {
+  v8::HandleScope scope;
+  v8::CodeCacheData* code_cache;
+  {
+    LocalContext context;
+    v8::ScriptOrigin origin(v8_str("code-cache.js"));
+    v8::CodeCacheData* created =
+        v8::CodeCacheData::Create(v8_str(kCodeCacheSource), &origin);
+    CHECK(created != NULL);
+    // Making the code cache doesn't run the script.
+    CHECK(context->Global()->Get(v8_str("total"))->IsUndefined());
+    code_cache = v8::CodeCacheData::New(created->Data(), created->Length());
+    CHECK_EQ(created->Length(), code_cache->Length());
+    delete created;
+  }
+  i::Heap::CollectAllGarbage(false);
+
+  for (int i = 0; i < 2; i++) {
+    LocalContext context;
+    CHECK(CodeCacheFits(code_cache, kCodeCacheSource));
+    v8::ScriptOrigin origin(v8_str("code-cache.js"));
+    v8::Local<Script> script =
+        v8::Script::Compile(v8_str(kCodeCacheSource), code_cache, &origin);
+    CHECK(!script.IsEmpty());
+    i::Heap::CollectAllGarbage(false);
+    v8::String::AsciiValue result(script->Run());
+    CHECK_EQ("e67.5six2017", *result);
+    ExpectString("new Point(1, 2).sum() + typeof o.b", "3string");
+  }
+
+  // Code caches for other sources or flags are not used.
+  const char* other_source = "var total = 1; total + 1";
+  CHECK(!CodeCacheFits(code_cache, other_source));
+  {
+    LocalContext context;
+    v8::Local<Script> script =
+        v8::Script::Compile(v8_str(other_source), code_cache, NULL);
+    CHECK_EQ(2, script->Run()->Int32Value());
+  }
+  bool allow_natives_syntax = i::FLAG_allow_natives_syntax;
+  i::FLAG_allow_natives_syntax = !allow_natives_syntax;
+  CHECK(!CodeCacheFits(code_cache, kCodeCacheSource));
+  i::FLAG_allow_natives_syntax = allow_natives_syntax;
+  delete code_cache;
+}
+
+
+// Tests that scripts with syntax errors don't get a code cache.
+TEST(CodeCacheWithError) {
+  v8::HandleScope scope;
+  LocalContext context;
+  v8::TryCatch try_catch;
+  v8::CodeCacheData* code_cache =
+      v8::CodeCacheData::Create(v8_str("function foo(a) { return 1 * * 2; }"));
+  CHECK(code_cache == NULL);
+  CHECK(try_catch.HasCaught());
+}
+
+
 // Verifies that the Handle<String> and const char* versions of the API produce
 // the same results (at least for one trivial case).
 TEST(PreCompileAPIVariationsAreSame) {
@@ -8520,6 +8665,89 @@ TEST(PreCompileAPIVariationsAreSame) {
 }
 
 
+class PreCompileThread : public i::Thread {
+ public:
+  static const int kIterations = 200;
+
+  PreCompileThread(const uint16_t* source, int length)
+      : source_(source), length_(length), data_(NULL), done_(false) {}
+  // Preparses the source repeatedly so that it overlaps with the VM thread
+  // running scripts, and checks that each run gives the same data.
+  virtual void Run() {
+    data_ = v8::ScriptData::PreCompile(source_, length_);
+    for (int i = 1; i < kIterations && data_ != NULL; i++) {
+      v8::ScriptData* data = v8::ScriptData::PreCompile(source_, length_);
+      if (data == NULL ||
+          data->Length() != data_->Length() ||
+          memcmp(data->Data(), data_->Data(), data_->Length()) != 0) {
+        delete data_;
+        data_ = NULL;
+      }
+      delete data;
+    }
+    done_ = true;
+  }
+  v8::ScriptData* data() { return data_; }
+  bool done() { return done_; }
+ private:
+  const uint16_t* source_;
+  int length_;
+  v8::ScriptData* data_;
+  volatile bool done_;
+};
+
+
+// Verifies that UTF-16 source can be preparsed on another thread without
+// a Locker while the VM thread parses and runs scripts, and that the result
+// is the same as preparsing on the VM thread.
+TEST(PreCompileOnOtherThread) {
+  v8::HandleScope scope;
+  LocalContext env;
+
+  // The source has number literals and non-ASCII identifiers ('@' stands
+  // for U+00E9), which the scanner classifies through the Unicode tables.
+  const char* cstring =
+      "function foo(a) { function bar(b) { return a + b; } return bar(1); }"
+      "var o = { 1: 1.5, 0x10: 2e3, 'x': .5e-1 };"
+      "var caf@ = 017 + 1.25; function @t@() { return caf@; }"
+      "foo(2);";
+  int length = i::StrLength(cstring);
+  i::ScopedVector<uint16_t> source(length);
+  for (int i = 0; i < length; i++) {
+    source[i] = cstring[i] == '@' ? 0xe9 : cstring[i];
+  }
+
+  PreCompileThread thread(source.start(), length);
+  thread.Start();
+  // Keep the VM thread scanning non-ASCII identifiers and converting
+  // number literals until the other thread is done.
+  const char* busy = "var \u00e9l\u00e8ve = 1.5e3 + 0.125 + 0x1f + 'z'.length;";
+  int runs = 0;
+  do {
+    v8::HandleScope inner;
+    Script::Compile(v8_str(busy))->Run();
+    runs++;
+  } while (!thread.done());
+  thread.Join();
+  CHECK_GT(runs, 0);
+  v8::ScriptData* sd = thread.data();
+  CHECK(sd != NULL);
+  CHECK(!sd->HasError());
+
+  v8::ScriptData* sd_from_string =
+      v8::ScriptData::PreCompile(v8::String::New(source.start(), length));
+  CHECK_EQ(sd_from_string->Length(), sd->Length());
+  CHECK_EQ(0, memcmp(sd_from_string->Data(), sd->Data(), sd->Length()));
+
+  Local<Script> script =
+      Script::Compile(v8::String::New(source.start(), length), NULL, sd);
+  CHECK_EQ(3, script->Run()->Int32Value());
+
+  delete sd_from_string;
+  delete sd;
+}
+
+
 // This tests that we do not allow dictionary load/call inline caches
 // to use functions that have not yet been compiled.  The potential
 // problem of loading a function that has not yet been compiled can
@@ -10923,3 +11151,118 @@ THREADED_TEST(TestEviction) {
   v8::internal::Heap::ClearJSFunctionResultCaches();
   ExpectString(code, "PASSED");
 }
+
+
+TEST(IsolateNewDispose) {
+  v8::Isolate* current_isolate = v8::Isolate::GetCurrent();
+  v8::Isolate* isolate = v8::Isolate::New();
+  CHECK(isolate != NULL);
+  CHECK(isolate != current_isolate);
+  CHECK(v8::Isolate::GetCurrent() == current_isolate);
+  isolate->Dispose();
+}
+
+
+static int RunInIsolate(v8::Isolate* isolate, const char* source) {
+  v8::Isolate::Scope isolate_scope(isolate);
+  CHECK(v8::Isolate::GetCurrent() == isolate);
+  v8::HandleScope scope;
+  LocalContext context;
+  return CompileRun(source)->Int32Value();
+}
+
+
+TEST(IsolateEnterExit) {
+  v8::Isolate* default_isolate = v8::Isolate::GetCurrent();
+  v8::Isolate* isolate1 = v8::Isolate::New();
+  v8::Isolate* isolate2 = v8::Isolate::New();
+  {
+    v8::Isolate::Scope isolate_scope(isolate1);
+    CHECK(v8::Isolate::GetCurrent() == isolate1);
+    v8::HandleScope scope;
+    LocalContext context;
+    CompileRun("var x = 1;");
+    // The other isolate has its own heap and globals.
+    CHECK_EQ(2, RunInIsolate(isolate2, "this.x === undefined ? 2 : 3"));
+    CHECK(v8::Isolate::GetCurrent() == isolate1);
+    // Entering the same isolate again nests.
+    CHECK_EQ(1, RunInIsolate(isolate1, "var x = 1; x"));
+    CHECK(v8::Isolate::GetCurrent() == isolate1);
+    CHECK_EQ(1, CompileRun("x")->Int32Value());
+  }
+  CHECK(v8::Isolate::GetCurrent() == default_isolate);
+  isolate1->Dispose();
+  isolate2->Dispose();
+}
+
+
+class IsolateThread : public i::Thread {
+ public:
+  IsolateThread(v8::Isolate* isolate, int fib_limit)
+      : isolate_(isolate), fib_limit_(fib_limit), result_(0) { }
+
+  // Computes fibonacci numbers in the isolate while forcing collections of
+  // its heap.
+  virtual void Run() {
+    v8::Isolate::Scope isolate_scope(isolate_);
+    v8::HandleScope scope;
+    LocalContext context;
+    i::ScopedVector<char> code(1024);
+    i::OS::SNPrintF(code,
+                    "function fib(n) {"
+                    "  if (n <= 2) return 1;"
+                    "  return fib(n - 1) + fib(n - 2);"
+                    "}"
+                    "var result = 0;"
+                    "for (var i = 0; i < 10; i++) {"
+                    "  result = fib(%d);"
+                    "}"
+                    "result",
+                    fib_limit_);
+    v8::Local<v8::Script> script = v8::Script::Compile(v8_str(code.start()));
+    for (int i = 0; i < 5; i++) {
+      result_ = script->Run()->Int32Value();
+      i::Heap::CollectAllGarbage(i % 2 == 0);
+    }
+  }
+
+  int result() { return result_; }
+
+ private:
+  v8::Isolate* isolate_;
+  int fib_limit_;
+  int result_;
+};
+
+
+TEST(MultipleIsolatesOnIndividualThreads) {
+  v8::Isolate* isolate1 = v8::Isolate::New();
+  v8::Isolate* isolate2 = v8::Isolate::New();
+
+  IsolateThread thread1(isolate1, 21);
+  IsolateThread thread2(isolate2, 12);
+
+  // Run the isolates in parallel with each other and with the default
+  // isolate on this thread.
+  thread1.Start();
+  thread2.Start();
+
+  v8::HandleScope scope;
+  LocalContext context;
+  for (int i = 0; i < 5; i++) {
+    CHECK_EQ(55, CompileRun("function fib(n) {"
+                            "  return n <= 2 ? 1 : fib(n - 1) + fib(n - 2);"
+                            "}"
+                            "fib(10)")->Int32Value());
+    i::Heap::CollectAllGarbage(false);
+  }
+
+  thread1.Join();
+  thread2.Join();
+
+  CHECK_EQ(10946, thread1.result());
+  CHECK_EQ(144, thread2.result());
+
+  isolate1->Dispose();
+  isolate2->Dispose();
+}
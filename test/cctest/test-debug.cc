@@ -370,7 +370,7 @@ namespace internal {
 
 // Collect the currently debugged functions.
 Handle<FixedArray> GetDebuggedFunctions() {
-  v8::internal::DebugInfoListNode* node = Debug::debug_info_list_;
+  v8::internal::DebugInfoListNode* node = Debug::data()->debug_info_list_;
 
   // Find the number of debugged functions.
   int count = 0;
@@ -406,7 +406,7 @@ void CheckDebuggerUnloaded(bool check_functions) {
   // Check that the debugger context is cleared and that there is no debug
   // information stored for the debugger.
   CHECK(Debug::debug_context().is_null());
-  CHECK_EQ(NULL, Debug::debug_info_list_);
+  CHECK_EQ(NULL, Debug::data()->debug_info_list_);
 
   // Collect garbage to ensure weak handles are cleared.
   Heap::CollectAllGarbage(false);
@@ -438,7 +438,7 @@ void CheckDebuggerUnloaded(bool check_functions) {
 
 
 void ForceUnloadDebugger() {
-  Debugger::never_unload_debugger_ = false;
+  Debugger::data()->never_unload_debugger_ = false;
   Debugger::UnloadDebugger();
 }
 
@@ -565,4 +565,160 @@ TEST(HeapSnapshot) {
   CHECK(has_b2_2_x_ref);
 }
 
+namespace {
+
+class TestStream : public v8::OutputStream {
+ public:
+  explicit TestStream(int abort_after_chunks)
+      : abort_after_chunks_(abort_after_chunks),
+        chunks_count_(0),
+        eos_signaled_(0) {
+  }
+  void EndOfStream() { ++eos_signaled_; }
+  int GetChunkSize() { return kChunkSize; }
+  WriteResult WriteAsciiChunk(char* data, int size) {
+    CHECK_GT(size, 0);
+    CHECK_GE(kChunkSize, size);
+    for (int i = 0; i < size; ++i) buffer_.Add(data[i]);
+    return ++chunks_count_ == abort_after_chunks_ ? kAbort : kContinue;
+  }
+  // Returns a null terminated copy of the next line of output, or NULL
+  // after the last line.
+  const char* NextLine(int* position) {
+    if (*position >= buffer_.length()) return NULL;
+    int end = *position;
+    while (buffer_[end] != '\n') ++end;
+    line_.Clear();
+    for (; *position < end; ++*position) line_.Add(buffer_[*position]);
+    line_.Add('\0');
+    ++*position;
+    return line_.ToVector().start();
+  }
+  int chunks_count() const { return chunks_count_; }
+  int eos_signaled() const { return eos_signaled_; }
+
+  static const int kChunkSize = 64;
+
+ private:
+  const int abort_after_chunks_;
+  int chunks_count_;
+  int eos_signaled_;
+  i::List<char> buffer_;
+  i::List<char> line_;
+};
+
+}  // namespace
+
+
+// Collects the ids of all the string entries with the given contents.  A
+// string evicted from the writer's string cache is emitted again under a
+// new id, so there can be more than one.
+static void FindStringIds(TestStream* stream,
+                          const char* quoted,
+                          i::List<int>* ids) {
+  int position = 0;
+  for (const char* line = stream->NextLine(&position);
+       line != NULL;
+       line = stream->NextLine(&position)) {
+    int id;
+    char text[64];
+    if (sscanf(line, "string,%d,%63s", &id, text) == 2 &&
+        strcmp(quoted, text) == 0) {
+      ids->Add(id);
+    }
+  }
+}
+
+
+TEST(HeapSnapshotStreaming) {
+  v8::HandleScope scope;
+  v8::Handle<v8::Context> env = v8::Context::New();
+  env->Enter();
+
+  CompileAndRunScript(
+      "function A3() {}\n"
+      "function B3(x) { this.b3_field = x; }\n"
+      "var a3 = new A3();\n"
+      "var b3 = new B3(a3);");
+
+  TestStream stream(-1);
+  v8::HeapProfiler::StreamSnapshot(v8::String::New("stream"), &stream);
+  CHECK_EQ(1, stream.eos_signaled());
+  CHECK_GT(stream.chunks_count(), 1);
+
+  i::List<int> a3_names, a3_properties, field_properties;
+  FindStringIds(&stream, "\"A3\"", &a3_names);
+  FindStringIds(&stream, "\"a3\"", &a3_properties);
+  FindStringIds(&stream, "\"b3_field\"", &field_properties);
+  CHECK_GT(a3_names.length(), 0);
+  CHECK_GT(a3_properties.length(), 0);
+  CHECK_GT(field_properties.length(), 0);
+
+  // Find the node of a3 and check that it is referenced from the global
+  // object through the 'a3' property and from b3 through 'b3_field'.
+  int position = 0;
+  const char* line = stream.NextLine(&position);
+  CHECK_EQ(0, strcmp("heap-snapshot,\"stream\"", line));
+  line = stream.NextLine(&position);
+  CHECK_EQ(0, strncmp("node,0,0,0,0", line, 12));
+  i::List<intptr_t> globals;
+  intptr_t a3_node = 0;
+  for (line = stream.NextLine(&position);
+       line != NULL && strncmp("edge,", line, 5) == 0;
+       line = stream.NextLine(&position)) {
+    int type, index;
+    intptr_t to;
+    CHECK_EQ(3, sscanf(line, "edge,%d,%d,%" V8PRIdPTR, &type, &index, &to));
+    CHECK_EQ(v8::HeapGraphEdge::ELEMENT, type);
+    globals.Add(to);
+  }
+  CHECK_GT(globals.length(), 0);
+  bool in_global = false;
+  bool has_global_a3_ref = false, has_b3_field_ref = false;
+  intptr_t global_a3 = 0, b3_field = 0;
+  for (; line != NULL; line = stream.NextLine(&position)) {
+    int type, name;
+    intptr_t id;
+    if (sscanf(line, "node,%d,%" V8PRIdPTR ",%d", &type, &id, &name) == 3) {
+      in_global = globals.Contains(id);
+      if (type == v8::HeapGraphNode::OBJECT && a3_names.Contains(name)) {
+        CHECK(a3_node == 0);
+        a3_node = id;
+      }
+    } else if (sscanf(line, "edge,%d,%d,%" V8PRIdPTR, &type, &name, &id) == 3) {
+      if (in_global && type == v8::HeapGraphEdge::PROPERTY &&
+          a3_properties.Contains(name)) {
+        has_global_a3_ref = true;
+        global_a3 = id;
+      }
+      if (type == v8::HeapGraphEdge::PROPERTY &&
+          field_properties.Contains(name)) {
+        has_b3_field_ref = true;
+        b3_field = id;
+      }
+    }
+  }
+  CHECK(has_global_a3_ref);
+  CHECK(has_b3_field_ref);
+  CHECK(a3_node != 0);
+  CHECK(a3_node == global_a3);
+  CHECK(a3_node == b3_field);
+
+  env->Exit();
+}
+
+
+TEST(HeapSnapshotStreamingAbort) {
+  v8::HandleScope scope;
+  v8::Handle<v8::Context> env = v8::Context::New();
+  env->Enter();
+
+  TestStream stream(2);
+  v8::HeapProfiler::StreamSnapshot(v8::String::New("abort"), &stream);
+  CHECK_EQ(2, stream.chunks_count());
+  CHECK_EQ(0, stream.eos_signaled());
+
+  env->Exit();
+}
+
 #endif  // ENABLE_LOGGING_AND_PROFILING
@@ -4,6 +4,7 @@
 
 #include "v8.h"
 
+#include "compilation-cache.h"
 #include "execution.h"
 #include "factory.h"
 #include "macro-assembler.h"
@@ -960,8 +961,7 @@ TEST(Regression39128) {
 
 TEST(TestCodeFlushing) {
   i::FLAG_allow_natives_syntax = true;
-  // If we do not flush code this test is invalid.
-  if (!FLAG_flush_code) return;
+  FLAG_flush_code = true;
   InitializeVM();
   v8::HandleScope scope;
   const char* source = "function foo() {"
@@ -998,3 +998,217 @@ TEST(TestCodeFlushing) {
   CompileRun("foo()");
   CHECK(function->shared()->is_compiled());
 }
+
+
+static v8::Handle<v8::Value> CollectGarbageRepeatedly(
+    const v8::Arguments& args) {
+  for (int i = 0; i < SharedFunctionInfo::kMaxCodeAge + 1; i++) {
+    Heap::CollectAllGarbage(true);
+  }
+  return v8::Undefined();
+}
+
+
+TEST(TestCodeFlushingKeepsActiveCode) {
+  FLAG_flush_code = true;
+  InitializeVM();
+  v8::HandleScope scope;
+  env->Global()->Set(
+      v8_str("gc"),
+      v8::FunctionTemplate::New(CollectGarbageRepeatedly)->GetFunction());
+  CompileRun("function bar() { gc(); }"
+             "function baz() {}"
+             "bar(); baz();");
+  // Drop the script from the compilation cache so that only the code age
+  // protects the functions.
+  CompilationCache::Clear();
+
+  Handle<String> bar_name = Factory::LookupAsciiSymbol("bar");
+  Handle<JSFunction> bar(
+      JSFunction::cast(Top::context()->global()->GetProperty(*bar_name)));
+  Handle<String> baz_name = Factory::LookupAsciiSymbol("baz");
+  Handle<JSFunction> baz(
+      JSFunction::cast(Top::context()->global()->GetProperty(*baz_name)));
+  CHECK(bar->shared()->is_compiled());
+  CHECK(baz->shared()->is_compiled());
+
+  // bar is on the stack during all the collections, baz is not.
+  CompileRun("bar()");
+  CHECK(bar->shared()->is_compiled());
+  CHECK_EQ(1, bar->shared()->code_age());
+  CHECK(!baz->shared()->is_compiled());
+  CHECK_EQ(0, baz->shared()->code_age());
+
+  // Code becomes old unless it is used.
+  Heap::CollectAllGarbage(true);
+  CHECK_EQ(2, bar->shared()->code_age());
+}
+
+
+// Code age only tells whether a function was on a stack at a full GC, not
+// whether it ran in between, so code is not flushed by default: a function
+// that is called between collections must stay compiled.
+TEST(TestCodeFlushingKeepsCalledCode) {
+  InitializeVM();
+  v8::HandleScope scope;
+  CompileRun("function foo() { return 42; }"
+             "foo();");
+  // Drop the script from the compilation cache so that it does not keep
+  // the code alive.
+  CompilationCache::Clear();
+
+  Handle<String> foo_name = Factory::LookupAsciiSymbol("foo");
+  Handle<JSFunction> foo(
+      JSFunction::cast(Top::context()->global()->GetProperty(*foo_name)));
+  CHECK(foo->shared()->is_compiled());
+
+  for (int i = 0; i < SharedFunctionInfo::kMaxCodeAge + 1; i++) {
+    CHECK_EQ(42, CompileRun("foo()")->Int32Value());
+    Heap::CollectAllGarbage(true);
+    CHECK(foo->shared()->is_compiled());
+  }
+}
+
+
+TEST(RegExpCacheKeepsReusedRegExps) {
+  InitializeVM();
+  v8::HandleScope scope;
+  CompilationCache::Clear();
+  Handle<String> reused = Factory::NewStringFromAscii(CStrVector("x+y"));
+  Handle<String> once = Factory::NewStringFromAscii(CStrVector("z+w"));
+  JSRegExp::Flags flags(JSRegExp::NONE);
+
+  CompileRun("/x+y/.exec('xxy'); /z+w/.exec('zzw');");
+  // Evaluating the literal again looks it up in the cache, which moves it
+  // to the long-lived table.
+  CompileRun("/x+y/.exec('xy');");
+  Heap::CollectAllGarbage(true);
+  Heap::CollectAllGarbage(true);
+  Heap::CollectAllGarbage(true);
+
+  CHECK(CompilationCache::LookupRegExp(once, flags).is_null());
+  Handle<FixedArray> data = CompilationCache::LookupRegExp(reused, flags);
+  CHECK(!data.is_null());
+  // The compiled code is kept with the data.
+  CHECK(!data->get(JSRegExp::kIrregexpASCIICodeIndex)->IsTheHole());
+
+  CompilationCache::Clear();
+  CHECK(CompilationCache::LookupRegExp(reused, flags).is_null());
+}
+
+
+TEST(IdleNotificationCollectsOldGeneration) {
+  InitializeVM();
+  v8::HandleScope scope;
+  // A fresh heap is not collected on idle notifications.
+  CHECK(!Heap::OldGenerationIdleLimitReached());
+  int gc_count = Heap::gc_count();
+  Heap::IdleNotification();
+  CHECK_EQ(gc_count, Heap::gc_count());
+
+  Heap::CollectAllGarbage(false);
+  CHECK(!Heap::OldGenerationIdleLimitReached());
+
+  // Fill the old generation with garbage until it passes the idle limit.
+  while (!Heap::OldGenerationIdleLimitReached()) {
+    v8::HandleScope inner_scope;
+    Factory::NewFixedArray(1000, TENURED);
+  }
+
+  Heap::IdleNotification();
+  CHECK(!Heap::OldGenerationIdleLimitReached());
+}
+
+
+TEST(ParallelScavenge) {
+  InitializeVM();
+  FLAG_parallel_scavenge = true;
+  FLAG_parallel_gc_threads = 3;
+  v8::HandleScope scope;
+
+  // Old space arrays spread over many pages, every other one holding
+  // pointers to new space objects.
+  const int kCount = 5000;
+  Handle<FixedArray> holders = Factory::NewFixedArray(kCount, TENURED);
+  for (int i = 0; i < kCount; i++) {
+    v8::HandleScope inner_scope;
+    Handle<FixedArray> holder = Factory::NewFixedArray(4, TENURED);
+    if (i % 2 == 0) {
+      Handle<FixedArray> young = Factory::NewFixedArray(1);
+      young->set(0, Smi::FromInt(i));
+      holder->set(1, *young);
+    }
+    holders->set(i, *holder);
+  }
+
+  // The first scavenge copies the young objects within new space and the
+  // second one promotes them.  Both need the dirty regions to be updated.
+  for (int gc = 0; gc < 2; gc++) {
+    CHECK(Heap::CollectGarbage(0, NEW_SPACE));
+    for (int i = 0; i < kCount; i++) {
+      FixedArray* holder = FixedArray::cast(holders->get(i));
+      if (i % 2 == 0) {
+        FixedArray* young = FixedArray::cast(holder->get(1));
+        CHECK_EQ(Smi::FromInt(i), young->get(0));
+      } else {
+        CHECK(holder->get(1)->IsUndefined());
+      }
+    }
+  }
+
+  FLAG_parallel_scavenge = false;
+}
+
+
+static JSObject* GetGlobalObject(const char* name) {
+  Object* value =
+      Top::context()->global()->GetProperty(*Factory::LookupAsciiSymbol(name));
+  return JSObject::cast(value);
+}
+
+
+TEST(Pretenuring) {
+  if (!FLAG_pretenuring) return;
+  InitializeVM();
+  v8::HandleScope scope;
+
+  // Long lived objects created by a constructor and by an object literal.
+  // Full GCs drop the pretenuring decisions, so start right after one and
+  // create few enough objects not to trigger another.
+  CompileRun("function Point(x, y) { this.x = x; this.y = y; }"
+             "function MakeEntry(i) { return { key: i, value: i }; }"
+             "var points = [];"
+             "var entries = [];");
+  Heap::CollectAllGarbage(false);
+  CompileRun("for (var i = 0; i < 20000; i++) {"
+             "  points.push(new Point(i, i));"
+             "  entries.push(MakeEntry(i));"
+             "}");
+
+  CompileRun("var point = new Point(1, 2);");
+  JSObject* point = GetGlobalObject("point");
+  CHECK(point->map()->is_pretenured());
+  CHECK(!Heap::InNewSpace(point));
+
+  CompileRun("var entry = MakeEntry(1);");
+  JSObject* entry = GetGlobalObject("entry");
+  CHECK(entry->map()->is_pretenured());
+  CHECK(!Heap::InNewSpace(entry));
+
+  // Short lived objects stay in new space.
+  CompileRun("function Temp(i) { this.i = i; }"
+             "for (var i = 0; i < 100000; i++) new Temp(i);"
+             "var temporary = new Temp(0);");
+  JSObject* temporary = GetGlobalObject("temporary");
+  CHECK(!temporary->map()->is_pretenured());
+  CHECK(Heap::InNewSpace(temporary));
+
+  // Full GCs drop the decisions, so objects that stop being long-lived are
+  // allocated in new space again.
+  Handle<Map> point_map(GetGlobalObject("point")->map());
+  Heap::CollectAllGarbage(false);
+  CHECK(!point_map->is_pretenured());
+  CompileRun("points = null;"
+             "point = new Point(1, 2);");
+  CHECK(Heap::InNewSpace(GetGlobalObject("point")));
+}
@@ -0,0 +1,212 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+
+#include <stdlib.h>
+
+#include "v8.h"
+
+#include "api.h"
+#include "compiler.h"
+#include "execution.h"
+#include "factory.h"
+#include "parser.h"
+#include "platform.h"
+#include "cctest.h"
+
+using namespace v8::internal;
+
+static v8::Persistent<v8::Context> env;
+
+static void InitializeVM() {
+  if (env.IsEmpty()) env = v8::Context::New();
+  v8::HandleScope scope;
+  env->Enter();
+}
+
+
+static Handle<Object> ParseJson(const char* source) {
+  return JsonParser::Parse(Factory::NewStringFromAscii(CStrVector(source)));
+}
+
+
+static void CheckJsonNumber(double expected, const char* source) {
+  Handle<Object> result = ParseJson(source);
+  CHECK(!result.is_null());
+  CHECK(result->IsNumber());
+  CHECK_EQ(expected, result->Number());
+}
+
+
+static void CheckJsonString(const char* expected, const char* source) {
+  Handle<Object> result = ParseJson(source);
+  CHECK(!result.is_null());
+  CHECK(result->IsString());
+  CHECK(String::cast(*result)->IsEqualTo(CStrVector(expected)));
+}
+
+
+static void CheckJsonError(const char* source) {
+  Handle<Object> result = ParseJson(source);
+  CHECK(result.is_null());
+  CHECK(Top::has_pending_exception());
+  Handle<Object> exception(Top::pending_exception());
+  Top::clear_pending_exception();
+  CHECK(exception->IsJSObject());
+  Handle<Object> name =
+      GetProperty(Handle<JSObject>::cast(exception), "name");
+  CHECK(String::cast(*name)->IsEqualTo(CStrVector("SyntaxError")));
+}
+
+
+TEST(JsonParsePrimitives) {
+  InitializeVM();
+  v8::HandleScope scope;
+
+  CHECK(ParseJson("true")->IsTrue());
+  CHECK(ParseJson(" false ")->IsFalse());
+  CHECK(ParseJson("\tnull\r\n")->IsNull());
+
+  CHECK(ParseJson("0")->IsSmi());
+  CHECK(ParseJson("123456789")->IsSmi());
+  CheckJsonNumber(0, "0");
+  CheckJsonNumber(-42, "-42");
+  CheckJsonNumber(1234567890, "1234567890");
+  CheckJsonNumber(0.5, "0.5");
+  CheckJsonNumber(-1.5e3, "-1.5e3");
+  CheckJsonNumber(25, "2.5E+1");
+  CheckJsonNumber(0.025, "2.5e-2");
+  Handle<Object> minus_zero = ParseJson("-0");
+  CHECK(minus_zero->IsHeapNumber());
+  CHECK_EQ(-V8_INFINITY, 1.0 / minus_zero->Number());
+
+  CheckJsonString("", "\"\"");
+  CheckJsonString("abc", "\"abc\"");
+  CheckJsonString("a\"b\\c/d\b\f\n\r\t", "\"a\\\"b\\\\c\\/d\\b\\f\\n\\r\\t\"");
+  CheckJsonString("AB", "\"\\u0041\\u0042\"");
+
+  Handle<Object> two_byte = ParseJson("\"\\u1234x\"");
+  CHECK(two_byte->IsString());
+  CHECK_EQ(2, String::cast(*two_byte)->length());
+  CHECK_EQ(0x1234, String::cast(*two_byte)->Get(0));
+}
+
+
+TEST(JsonParseObjectsAndArrays) {
+  InitializeVM();
+  v8::HandleScope scope;
+
+  Handle<Object> array = ParseJson("[1, \"x\", [], {}, [true, [null]]]");
+  CHECK(array->IsJSArray());
+  CHECK(JSArray::cast(*array)->HasFastElements());
+  CHECK_EQ(Smi::FromInt(5), JSArray::cast(*array)->length());
+
+  Handle<Object> object = ParseJson("{\"a\": 1, \"b\": {\"c\": [2]}, \"7\": 3}");
+  CHECK(object->IsJSObject());
+  Handle<JSObject> json_object = Handle<JSObject>::cast(object);
+  CHECK(json_object->HasFastProperties());
+  CHECK(json_object->HasLocalProperty(*Factory::LookupAsciiSymbol("a")));
+  CHECK(json_object->HasLocalProperty(*Factory::LookupAsciiSymbol("b")));
+  CHECK(json_object->HasLocalElement(7));
+  CHECK_EQ(Smi::FromInt(3), json_object->GetElement(7));
+}
+
+
+TEST(JsonParseSharesMaps) {
+  InitializeVM();
+  v8::HandleScope scope;
+
+  Handle<Object> array = ParseJson(
+      "[{\"x\": 1, \"y\": 2}, {\"x\": 3, \"y\": 4}, {\"y\": 5, \"x\": 6}]");
+  CHECK(array->IsJSArray());
+  FixedArray* elements = FixedArray::cast(JSArray::cast(*array)->elements());
+  HeapObject* first = HeapObject::cast(elements->get(0));
+  HeapObject* second = HeapObject::cast(elements->get(1));
+  HeapObject* third = HeapObject::cast(elements->get(2));
+  CHECK_EQ(first->map(), second->map());
+  CHECK_NE(first->map(), third->map());
+}
+
+
+TEST(JsonParseErrors) {
+  InitializeVM();
+  v8::HandleScope scope;
+
+  CheckJsonError("");
+  CheckJsonError(" ");
+  CheckJsonError("abc");
+  CheckJsonError("[1, 2");
+  CheckJsonError("[1, 2,]");
+  CheckJsonError("[01]");
+  CheckJsonError("[1.]");
+  CheckJsonError("[.5]");
+  CheckJsonError("[1e]");
+  CheckJsonError("{\"x\": 3");
+  CheckJsonError("{\"x\" 3}");
+  CheckJsonError("{x: 3}");
+  CheckJsonError("{'x': 3}");
+  CheckJsonError("\"\\x41\"");
+  CheckJsonError("\"\\u004\"");
+  CheckJsonError("\"unterminated");
+  CheckJsonError("\"tab\tin string\"");
+  CheckJsonError("tru");
+  CheckJsonError("nullx");
+  CheckJsonError("1 2");
+}
+
+
+static void BuildJsonDocument(StringStream* stream, int entries) {
+  stream->Add("[");
+  for (int i = 0; i < entries; i++) {
+    if (i > 0) stream->Add(",\n");
+    stream->Add("{\"id\": %d, \"name\": \"entry\\t%d\", \"score\": %d.25, "
+                "\"tags\": [\"a\", \"b\", null, true, false], "
+                "\"nested\": {\"x\": -%d, \"y\": \"\\u00e9\"}}",
+                i, i, i, i);
+  }
+  stream->Add("]");
+}
+
+
+// Parse a large document both with the JSON parser and by compiling it
+// as JSON validated JavaScript, which is what JSON.parse used to do, check
+// that the results are the same and print the time spent on each.
+TEST(JsonParseVersusCompile) {
+  InitializeVM();
+  v8::HandleScope scope;
+
+  HeapStringAllocator allocator;
+  StringStream stream(&allocator);
+  BuildJsonDocument(&stream, 5000);
+  Handle<String> source = stream.ToString();
+
+  double start = OS::TimeCurrentMillis();
+  Handle<Object> parsed = JsonParser::Parse(source);
+  double parse_time = OS::TimeCurrentMillis() - start;
+  CHECK(!parsed.is_null());
+
+  start = OS::TimeCurrentMillis();
+  Handle<Context> context(Top::context()->global_context());
+  Handle<SharedFunctionInfo> shared =
+      Compiler::CompileEval(source, context, true, Compiler::VALIDATE_JSON);
+  CHECK(!shared.is_null());
+  Handle<JSFunction> function =
+      Factory::NewFunctionFromSharedFunctionInfo(shared, context);
+  bool has_pending_exception;
+  Handle<Object> receiver(Top::context()->global_proxy());
+  Handle<Object> compiled =
+      Execution::Call(function, receiver, 0, NULL, &has_pending_exception);
+  double compile_time = OS::TimeCurrentMillis() - start;
+  CHECK(!has_pending_exception);
+
+  v8::Handle<v8::Object> global = env->Global();
+  v8::Handle<v8::Function> stringify = v8::Handle<v8::Function>::Cast(
+      v8::Handle<v8::Object>::Cast(global->Get(v8::String::New("JSON")))->Get(
+          v8::String::New("stringify")));
+  v8::Handle<v8::Value> parsed_arg[] = { v8::Utils::ToLocal(parsed) };
+  v8::Handle<v8::Value> compiled_arg[] = { v8::Utils::ToLocal(compiled) };
+  v8::String::Utf8Value parsed_json(stringify->Call(global, 1, parsed_arg));
+  v8::String::Utf8Value compiled_json(stringify->Call(global, 1, compiled_arg));
+  CHECK_EQ(*compiled_json, *parsed_json);
+
+  PrintF("JSON parse: %.1f ms, compile and run: %.1f ms (%d characters)\n",
+         parse_time, compile_time, source->length());
+}
@@ -30,6 +30,7 @@
 #include "v8.h"
 
 #include "global-handles.h"
+#include "mark-compact.h"
 #include "snapshot.h"
 #include "top.h"
 #include "cctest.h"
@@ -339,3 +340,125 @@ TEST(ObjectGroups) {
   // All objects should be gone. 5 global handles in total.
   CHECK_EQ(5, NumberOfWeakCalls);
 }
+
+
+TEST(ParallelMarking) {
+  InitializeVM();
+  FLAG_parallel_marking = true;
+  FLAG_parallel_gc_threads = 3;
+
+  v8::HandleScope handle_scope;
+
+  // A wide array of short chains, which makes the marking threads share
+  // work, and a long chain.  The wide array is only reachable through the
+  // holder, as the bodies of roots are marked by the main thread.
+  const int kWidth = 200000;
+  const int kDepth = 3;
+  Handle<FixedArray> holder = Factory::NewFixedArray(1);
+  {
+    v8::HandleScope inner_scope;
+    Handle<FixedArray> wide = Factory::NewFixedArray(kWidth, TENURED);
+    for (int i = 0; i < kWidth; i++) {
+      Handle<FixedArray> chain = Factory::NewFixedArray(2, TENURED);
+      chain->set(0, Smi::FromInt(i));
+      for (int j = 1; j < kDepth; j++) {
+        Handle<FixedArray> link = Factory::NewFixedArray(2, TENURED);
+        link->set(0, Smi::FromInt(i));
+        link->set(1, *chain);
+        chain = link;
+      }
+      wide->set(i, *chain);
+    }
+    holder->set(0, *wide);
+  }
+  const int kLength = 10000;
+  Handle<FixedArray> list = Factory::NewFixedArray(2, TENURED);
+  for (int i = 1; i < kLength; i++) {
+    Handle<FixedArray> link = Factory::NewFixedArray(2, TENURED);
+    link->set(0, Smi::FromInt(i));
+    link->set(1, *list);
+    list = link;
+  }
+
+  CHECK(Heap::CollectGarbage(0, OLD_POINTER_SPACE));
+  CHECK_EQ(0, MarkCompactCollector::previous_marked_count());
+
+#ifdef DEBUG
+  // The work was actually shared and not done by a single thread.
+  int threads_used = 0;
+  for (int i = 0; i < FLAG_parallel_gc_threads; i++) {
+    if (MarkCompactCollector::ParallelMarkingWorkCount(i) > 0) threads_used++;
+  }
+  CHECK_GT(threads_used, 1);
+#endif
+
+  FixedArray* wide = FixedArray::cast(holder->get(0));
+  for (int i = 0; i < kWidth; i++) {
+    FixedArray* chain = FixedArray::cast(wide->get(i));
+    for (int j = 0; j < kDepth; j++) {
+      CHECK_EQ(Smi::FromInt(i), chain->get(0));
+      if (j < kDepth - 1) chain = FixedArray::cast(chain->get(1));
+    }
+  }
+  FixedArray* link = *list;
+  for (int i = kLength - 1; i > 0; i--) {
+    CHECK_EQ(Smi::FromInt(i), link->get(0));
+    link = FixedArray::cast(link->get(1));
+  }
+
+  FLAG_parallel_marking = false;
+}
+
+
+TEST(ParallelSweeping) {
+  InitializeVM();
+  FLAG_parallel_sweeping = true;
+  FLAG_parallel_gc_threads = 3;
+  FLAG_never_compact = true;
+
+  v8::HandleScope handle_scope;
+
+  // Interleave live and dead arrays over many pages of old pointer space,
+  // followed by a run of dead arrays at the end of the space.
+  const int kCount = 20000;
+  Handle<FixedArray> live = Factory::NewFixedArray(kCount, TENURED);
+  {
+    v8::HandleScope inner_scope;
+    for (int i = 0; i < kCount; i++) {
+      Handle<FixedArray> array = Factory::NewFixedArray(8, TENURED);
+      array->set(0, Smi::FromInt(i));
+      if (i % 3 == 0) live->set(i, *array);
+    }
+    for (int i = 0; i < kCount; i++) Factory::NewFixedArray(8, TENURED);
+  }
+
+  int size_before = Heap::old_pointer_space()->Size();
+  CHECK(Heap::CollectGarbage(0, OLD_POINTER_SPACE));
+  CHECK_EQ(0, MarkCompactCollector::previous_marked_count());
+  CHECK_GT(size_before, Heap::old_pointer_space()->Size());
+
+  for (int i = 0; i < kCount; i++) {
+    if (i % 3 == 0) {
+      CHECK_EQ(Smi::FromInt(i), FixedArray::cast(live->get(i))->get(0));
+    } else {
+      CHECK(live->get(i)->IsUndefined());
+    }
+  }
+
+  // The freed memory is reused and survives another collection.
+  for (int i = 0; i < kCount; i++) {
+    if (i % 3 != 0) {
+      Handle<FixedArray> array = Factory::NewFixedArray(4, TENURED);
+      array->set(0, Smi::FromInt(-i));
+      live->set(i, *array);
+    }
+  }
+  CHECK(Heap::CollectGarbage(0, OLD_POINTER_SPACE));
+  for (int i = 0; i < kCount; i++) {
+    int expected = (i % 3 == 0) ? i : -i;
+    CHECK_EQ(Smi::FromInt(expected), FixedArray::cast(live->get(i))->get(0));
+  }
+
+  FLAG_parallel_sweeping = false;
+  FLAG_never_compact = false;
+}
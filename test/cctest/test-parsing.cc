@@ -31,6 +31,7 @@
 
 #include "token.h"
 #include "scanner.h"
+#include "parser.h"
 #include "utils.h"
 
 #include "cctest.h"
@@ -61,69 +62,207 @@ TEST(KeywordMatcher) {
 
   KeywordToken key_token;
   for (int i = 0; (key_token = keywords[i]).keyword != NULL; i++) {
-    i::KeywordMatcher matcher;
     const char* keyword = key_token.keyword;
     int length = i::StrLength(keyword);
     for (int j = 0; j < length; j++) {
       if (key_token.token == i::Token::INSTANCEOF && j == 2) {
         // "in" is a prefix of "instanceof". It's the only keyword
         // that is a prefix of another.
-        CHECK_EQ(i::Token::IN, matcher.token());
+        CHECK_EQ(i::Token::IN, i::KeywordMatcher::Lookup(keyword, j));
       } else {
-        CHECK_EQ(i::Token::IDENTIFIER, matcher.token());
+        CHECK_EQ(i::Token::IDENTIFIER, i::KeywordMatcher::Lookup(keyword, j));
       }
-      matcher.AddChar(keyword[j]);
     }
-    CHECK_EQ(key_token.token, matcher.token());
+    CHECK_EQ(key_token.token, i::KeywordMatcher::Lookup(keyword, length));
     // Adding more characters will make keyword matching fail.
-    matcher.AddChar('z');
-    CHECK_EQ(i::Token::IDENTIFIER, matcher.token());
-    // Adding a keyword later will not make it match again.
-    matcher.AddChar('i');
-    matcher.AddChar('f');
-    CHECK_EQ(i::Token::IDENTIFIER, matcher.token());
+    i::EmbeddedVector<char, 16> longer;
+    i::OS::SNPrintF(longer, "%sz", keyword);
+    CHECK_EQ(i::Token::IDENTIFIER,
+             i::KeywordMatcher::Lookup(longer.start(), length + 1));
   }
 
   // Future keywords are not recognized.
   const char* future_keyword;
   for (int i = 0; (future_keyword = future_keywords[i]) != NULL; i++) {
-    i::KeywordMatcher matcher;
     int length = i::StrLength(future_keyword);
-    for (int j = 0; j < length; j++) {
-      matcher.AddChar(future_keyword[j]);
-    }
-    CHECK_EQ(i::Token::IDENTIFIER, matcher.token());
+    CHECK_EQ(i::Token::IDENTIFIER,
+             i::KeywordMatcher::Lookup(future_keyword, length));
   }
 
   // Zero isn't ignored at first.
-  i::KeywordMatcher bad_start;
-  bad_start.AddChar(0);
-  CHECK_EQ(i::Token::IDENTIFIER, bad_start.token());
-  bad_start.AddChar('i');
-  bad_start.AddChar('f');
-  CHECK_EQ(i::Token::IDENTIFIER, bad_start.token());
+  CHECK_EQ(i::Token::IDENTIFIER, i::KeywordMatcher::Lookup("\0if", 3));
 
   // Zero isn't ignored at end.
-  i::KeywordMatcher bad_end;
-  bad_end.AddChar('i');
-  bad_end.AddChar('f');
-  CHECK_EQ(i::Token::IF, bad_end.token());
-  bad_end.AddChar(0);
-  CHECK_EQ(i::Token::IDENTIFIER, bad_end.token());
+  CHECK_EQ(i::Token::IF, i::KeywordMatcher::Lookup("if\0", 2));
+  CHECK_EQ(i::Token::IDENTIFIER, i::KeywordMatcher::Lookup("if\0", 3));
 
   // Case isn't ignored.
-  i::KeywordMatcher bad_case;
-  bad_case.AddChar('i');
-  bad_case.AddChar('F');
-  CHECK_EQ(i::Token::IDENTIFIER, bad_case.token());
-
-  // If we mark it as failure, continuing won't help.
-  i::KeywordMatcher full_stop;
-  full_stop.AddChar('i');
-  CHECK_EQ(i::Token::IDENTIFIER, full_stop.token());
-  full_stop.Fail();
-  CHECK_EQ(i::Token::IDENTIFIER, full_stop.token());
-  full_stop.AddChar('f');
-  CHECK_EQ(i::Token::IDENTIFIER, full_stop.token());
+  CHECK_EQ(i::Token::IDENTIFIER, i::KeywordMatcher::Lookup("iF", 2));
+
+  // Identifiers with the same hash as a keyword don't match it.
+  CHECK_EQ(i::Token::IDENTIFIER, i::KeywordMatcher::Lookup("no", 2));
+}
+
+
+TEST(ScannerAsciiCharClasses) {
+  for (int c = 0; c < i::Scanner::kAsciiSize; c++) {
+    CHECK_EQ(i::Scanner::kIsIdentifierStart.get(c),
+             i::Scanner::IsIdentifierStart(c));
+    CHECK_EQ(i::Scanner::kIsIdentifierPart.get(c),
+             i::Scanner::IsIdentifierPart(c));
+    CHECK_EQ(i::Scanner::kIsWhiteSpace.get(c), i::Scanner::IsWhiteSpace(c));
+    CHECK_EQ(i::Scanner::kIsLineTerminator.get(c),
+             i::Scanner::IsLineTerminator(c));
+  }
+}
+
+
+// Scans the rest of the input and returns a checksum of the tokens, their
+// positions and their literal contents. Sets *tokens to the token count.
+static uint32_t ScanChecksum(i::Scanner* scanner, int* tokens) {
+  uint32_t checksum = 0;
+  *tokens = 0;
+  i::Token::Value token;
+  do {
+    token = scanner->Next();
+    CHECK_NE(i::Token::ILLEGAL, token);
+    i::Scanner::Location location = scanner->location();
+    checksum = checksum * 31 + token;
+    checksum = checksum * 31 + location.beg_pos;
+    checksum = checksum * 31 + location.end_pos;
+    if (token == i::Token::IDENTIFIER ||
+        token == i::Token::STRING ||
+        token == i::Token::NUMBER) {
+      const char* literal = scanner->literal_string();
+      for (int i = 0; i < scanner->literal_length(); i++) {
+        checksum = checksum * 31 + static_cast<unsigned char>(literal[i]);
+      }
+    }
+    (*tokens)++;
+  } while (token != i::Token::EOS);
+  return checksum;
 }
 
+
+// Scans a large program from each kind of source the scanner reads and
+// prints the best time of a few runs. All sources must give the same tokens
+// with the same positions and literals.
+TEST(ScanLargeProgram) {
+  v8::V8::Initialize();
+  v8::HandleScope scope;
+
+  const char* snippet =
+      "function f(a, b) { var x = a + b * 2; /* comment */\n"
+      "  if (x > 10 && typeof b != 'undefined') return 'string';\n"
+      "  for (var i = 0; i < x; i++) { x -= 0.5; }  // comment\n"
+      "  return this.value instanceof Object ? null : x; }\n";
+  const int kRepeat = 10000;
+  int snippet_length = i::StrLength(snippet);
+  int length = snippet_length * kRepeat;
+  i::ScopedVector<char> ascii(length + 1);
+  i::ScopedVector<i::uc16> two_byte(length);
+  for (int i = 0; i < kRepeat; i++) {
+    memcpy(&ascii[i * snippet_length], snippet, snippet_length);
+  }
+  ascii[length] = '\0';
+  for (int i = 0; i < length; i++) two_byte[i] = ascii[i];
+  i::Handle<i::String> string =
+      i::Factory::NewStringFromAscii(i::Vector<const char>(ascii.start(),
+                                                           length));
+
+  static const int kSources = 3;
+  static const int kRuns = 5;
+  const char* names[kSources] = { "heap string", "UTF-8 stream", "UTF-16" };
+  int token_counts[kSources];
+  uint32_t checksums[kSources];
+  for (int source = 0; source < kSources; source++) {
+    double best_time = 0;
+    // The timed runs only scan; the final run computes the checksum.
+    for (int run = 0; run <= kRuns; run++) {
+      double start = i::OS::TimeCurrentMillis();
+      i::Scanner scanner(i::PARSE);
+      unibrow::Utf8InputBuffer<> stream(ascii.start(), length);
+      if (source == 0) {
+        scanner.Initialize(string, i::JAVASCRIPT);
+      } else if (source == 1) {
+        scanner.Initialize(i::Handle<i::String>(), &stream, i::JAVASCRIPT);
+      } else {
+        scanner.Initialize(i::Vector<const i::uc16>(two_byte.start(), length),
+                           i::JAVASCRIPT);
+      }
+      if (run == kRuns) {
+        checksums[source] = ScanChecksum(&scanner, &token_counts[source]);
+        break;
+      }
+      i::Token::Value token;
+      do {
+        token = scanner.Next();
+        CHECK_NE(i::Token::ILLEGAL, token);
+      } while (token != i::Token::EOS);
+      double time = i::OS::TimeCurrentMillis() - start;
+      if (run == 0 || time < best_time) best_time = time;
+    }
+    i::PrintF("Scanned %d tokens from %s in %.1f ms\n",
+              token_counts[source], names[source], best_time);
+  }
+  CHECK_EQ(token_counts[0], token_counts[1]);
+  CHECK_EQ(token_counts[0], token_counts[2]);
+  CHECK(checksums[0] == checksums[1]);
+  CHECK(checksums[0] == checksums[2]);
+}
+
+
+// Returns the preparse data entry of the function whose name and formal
+// parameters start with the given text.
+static i::FunctionEntry FunctionEntryOf(i::ScriptDataImpl* data,
+                                        const char* program,
+                                        const char* function) {
+  const char* position = strstr(program, function);
+  CHECK(position != NULL);
+  position = strchr(position, '(');
+  i::FunctionEntry entry =
+      data->GetFunctionEnd(static_cast<int>(position - program));
+  CHECK(entry.is_valid());
+  return entry;
+}
+
+
+TEST(PreparseFunctionContexts) {
+  v8::V8::Initialize();
+  const char* program =
+      "function captured(x) { function inner() { return x; } }\n"
+      "function module() {\n"
+      "  var v = 1;\n"
+      "  function f(a) { var w; return function g() { return a + w; }; }\n"
+      "  return f(v);\n"
+      "}\n"
+      "function evals() { function h() { eval('1'); } }\n"
+      "function withs(o) { with (o) { } function k() { } }\n"
+      "function catches() { try { } catch (e) { } function l() { } }\n"
+      "var named = function self() { return function() { return self; }; };\n"
+      "function args(m) { return function() { return arguments; }; }\n";
+  v8::ScriptData* data =
+      v8::ScriptData::PreCompile(program, i::StrLength(program));
+  CHECK(!data->HasError());
+  i::ScriptDataImpl* pre_data = static_cast<i::ScriptDataImpl*>(data);
+
+  i::FunctionEntry entry = FunctionEntryOf(pre_data, program, "captured(");
+  CHECK(entry.needs_context());
+  CHECK_EQ(1, entry.inner_function_count());
+  CHECK(!FunctionEntryOf(pre_data, program, "inner(").needs_context());
+
+  entry = FunctionEntryOf(pre_data, program, "module(");
+  CHECK(!entry.needs_context());
+  CHECK_EQ(2, entry.inner_function_count());
+  CHECK(FunctionEntryOf(pre_data, program, "f(a)").needs_context());
+  entry = FunctionEntryOf(pre_data, program, "g(");
+  CHECK(!entry.needs_context());
+  CHECK_EQ(0, entry.inner_function_count());
+
+  CHECK(FunctionEntryOf(pre_data, program, "evals(").needs_context());
+  CHECK(FunctionEntryOf(pre_data, program, "withs(").needs_context());
+  CHECK(FunctionEntryOf(pre_data, program, "catches(").needs_context());
+  CHECK(FunctionEntryOf(pre_data, program, "self(").needs_context());
+  CHECK(!FunctionEntryOf(pre_data, program, "args(").needs_context());
+  delete data;
+}
@@ -11,6 +11,7 @@
 
 #include "api.h"
 #include "factory.h"
+#include "string-search.h"
 #include "cctest.h"
 #include "zone-inl.h"
 
@@ -481,3 +482,182 @@ TEST(CachedHashOverflow) {
     }
   }
 }
+
+
+TEST(SlicedStrings) {
+  ZoneScope zone(DELETE_ON_EXIT);
+
+  InitializeVM();
+  v8::HandleScope handle_scope;
+
+  static const char* kText = "0123456789abcdefghijklmnopqrstuvwxyz";
+  Handle<String> parent = Factory::NewStringFromAscii(CStrVector(kText));
+  CHECK(parent->IsSeqAsciiString());
+
+  // Long substrings share the characters of their parent.
+  Handle<String> slice = Factory::NewSubString(parent, 5, 25);
+  CHECK(slice->IsSlicedString());
+  CHECK(slice->IsAsciiRepresentation());
+  CHECK_EQ(*parent, SlicedString::cast(*slice)->parent());
+  CHECK_EQ(5, SlicedString::cast(*slice)->offset());
+  CHECK(slice->IsEqualTo(CStrVector("56789abcdefghijklmno")));
+  CHECK_EQ('a', slice->Get(5));
+  Vector<const char> chars = slice->ToAsciiVector();
+  CHECK_EQ(20, chars.length());
+  CHECK_EQ(0, strncmp(kText + 5, chars.start(), chars.length()));
+
+  // Slicing a slice refers directly to the original parent.
+  Handle<String> slice_of_slice = Factory::NewSubString(slice, 2, 17);
+  CHECK(slice_of_slice->IsSlicedString());
+  CHECK_EQ(*parent, SlicedString::cast(*slice_of_slice)->parent());
+  CHECK_EQ(7, SlicedString::cast(*slice_of_slice)->offset());
+  CHECK(slice_of_slice->IsEqualTo(CStrVector("789abcdefghijkl")));
+
+  // Short substrings are still copied.
+  Handle<String> short_substring =
+      Factory::NewSubString(parent, 0, SlicedString::kMinLength - 1);
+  CHECK(!short_substring->IsSlicedString());
+
+  // Slices keep their parent alive and stay valid when objects move.
+  Heap::CollectGarbage(0, NEW_SPACE);
+  Heap::CollectAllGarbage(false);
+  CHECK(slice->IsSlicedString());
+  CHECK(slice->IsEqualTo(CStrVector("56789abcdefghijklmno")));
+  Handle<String> copy = Factory::NewStringFromAscii(CStrVector(kText + 5));
+  Traverse(Factory::NewSubString(copy, 0, 20), slice);
+
+  // Slices of two-byte and external strings.
+  uc16* two_byte = Zone::NewArray<uc16>(20);
+  for (int i = 0; i < 20; i++) two_byte[i] = 0x1234 + i;
+  Handle<String> two_byte_parent =
+      Factory::NewStringFromTwoByte(Vector<const uc16>(two_byte, 20));
+  Handle<String> two_byte_slice = Factory::NewSubString(two_byte_parent, 3, 18);
+  CHECK(two_byte_slice->IsSlicedString());
+  CHECK(two_byte_slice->IsTwoByteRepresentation());
+  CHECK_EQ(0x1234 + 3, two_byte_slice->Get(0));
+  CHECK_EQ(0x1234 + 17, two_byte_slice->ToUC16Vector()[14]);
+
+  char* ascii = Zone::NewArray<char>(20);
+  memcpy(ascii, kText, 20);
+  Handle<String> external_parent = Factory::NewExternalStringFromAscii(
+      new AsciiResource(Vector<const char>(ascii, 20)));
+  Handle<String> external_slice = Factory::NewSubString(external_parent, 1, 19);
+  CHECK(external_slice->IsSlicedString());
+  CHECK(external_slice->IsEqualTo(CStrVector("123456789abcdefghi")));
+}
+
+
+TEST(SlicedStringsFromScript) {
+  InitializeVM();
+  v8::HandleScope handle_scope;
+
+  // Exercise the generated code for substring, charCodeAt and regexp
+  // matching on sliced strings.
+  static const char* source =
+      "var s = 'xxxxxxxxxxxxxxxxxxxxabcdefghijklmnopqrstuvwxyz';"
+      "function test() {"
+      "  var slice = s.substring(20);"
+      "  if (slice != 'abcdefghijklmnopqrstuvwxyz') return 1;"
+      "  if (slice.charCodeAt(2) != 99) return 2;"
+      "  if (slice.charAt(25) != 'z') return 3;"
+      "  if (!/^abc/.test(slice)) return 4;"
+      "  if (/^x/.test(slice)) return 5;"
+      "  var m = /k(l+)m/.exec(slice);"
+      "  if (m.index != 10 || m[1] != 'l') return 6;"
+      "  var slice_of_slice = slice.substring(1, 20);"
+      "  if (slice_of_slice != 'bcdefghijklmnopqrst') return 7;"
+      "  if (slice_of_slice.indexOf('t') != 18) return 8;"
+      "  if (slice.toUpperCase() != 'ABCDEFGHIJKLMNOPQRSTUVWXYZ') return 9;"
+      "  if (slice.replace(/[aeiou]/g, '') != 'bcdfghjklmnpqrstvwxyz')"
+      "    return 10;"
+      "  return 0;"
+      "}"
+      "var result = 0;"
+      "for (var i = 0; i < 100 && result == 0; i++) result = test();"
+      "result";
+  CHECK_EQ(0,
+           v8::Script::Compile(v8::String::New(source))->Run()->Int32Value());
+}
+
+
+template <typename PatternChar, typename SubjectChar>
+static int NaiveIndexOf(Vector<const SubjectChar> subject,
+                        Vector<const PatternChar> pattern,
+                        int index) {
+  for (int i = index; i + pattern.length() <= subject.length(); i++) {
+    int j = 0;
+    while (j < pattern.length() && pattern[j] == subject[i + j]) j++;
+    if (j == pattern.length()) return i;
+  }
+  return -1;
+}
+
+
+// Check all occurrences of a pattern in a subject found by reusing one
+// search object against a naive search. A second search object for a
+// different pattern is used in between to check that they don't share
+// any state.
+template <typename PatternChar, typename SubjectChar>
+static void CheckStringSearch(Vector<const SubjectChar> subject,
+                              Vector<const PatternChar> pattern,
+                              Vector<const PatternChar> other_pattern) {
+  StringSearch<PatternChar, SubjectChar> search(pattern);
+  StringSearch<PatternChar, SubjectChar> other_search(other_pattern);
+  int index = 0;
+  int other_index = 0;
+  while (true) {
+    int expected = NaiveIndexOf(subject, pattern, index);
+    CHECK_EQ(expected, search.Search(subject, index));
+    if (other_index >= 0) {
+      int other_expected = NaiveIndexOf(subject, other_pattern, other_index);
+      CHECK_EQ(other_expected, other_search.Search(subject, other_index));
+      other_index = other_expected < 0 ? -1 : other_expected + 1;
+    }
+    if (expected < 0) break;
+    index = expected + 1;
+  }
+}
+
+
+TEST(StringSearch) {
+  static const int kSubjectLength = 5000;
+  // Pattern lengths that use each of the search strategies, including
+  // patterns longer than the Boyer-Moore tables.
+  static const int kPatternLengths[] = { 1, 2, 4, 5, 10, 40, 300, 600 };
+  char ascii_subject[kSubjectLength];
+  uc16 two_byte_subject[kSubjectLength];
+  for (int alphabet = 2; alphabet <= 16; alphabet *= 2) {
+    for (int i = 0; i < kSubjectLength; i++) {
+      int c = gen() % alphabet;
+      ascii_subject[i] = 'a' + c;
+      // Mostly the same characters as the ASCII subject, so that ASCII
+      // patterns are found in it too.
+      two_byte_subject[i] = (i % 100 == 0) ? 0x1234 + c : 'a' + c;
+    }
+    Vector<const char> ascii(ascii_subject, kSubjectLength);
+    Vector<const uc16> two_byte(two_byte_subject, kSubjectLength);
+    for (size_t i = 0; i < ARRAY_SIZE(kPatternLengths); i++) {
+      int length = kPatternLengths[i];
+      // Take the patterns from the subjects so that they occur at least
+      // once.
+      int start = gen() % (kSubjectLength - length);
+      int other_start = gen() % (kSubjectLength - length);
+      CheckStringSearch(ascii,
+                        ascii.SubVector(start, start + length),
+                        ascii.SubVector(other_start, other_start + length));
+      CheckStringSearch(two_byte,
+                        two_byte.SubVector(start, start + length),
+                        two_byte.SubVector(other_start,
+                                           other_start + length));
+      CheckStringSearch(two_byte,
+                        ascii.SubVector(start, start + length),
+                        ascii.SubVector(other_start, other_start + length));
+      // A two-byte pattern never occurs in an ASCII subject if it contains
+      // a non-ASCII character.
+      CheckStringSearch(ascii,
+                        two_byte.SubVector(start, start + length),
+                        two_byte.SubVector(other_start,
+                                           other_start + length));
+    }
+  }
+}
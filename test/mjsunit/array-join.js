@@ -43,3 +43,43 @@ assertThrows("a.join('*')");
 Array.prototype.toString = function() { return "array"; }
 assertEquals('array*3*4*array*array', a.join('*'));
 
+
+// Test joining arrays of strings, which are joined without converting the
+// elements first, and arrays with holes and elements of other types.
+var strings = ['a', 'bc', '', 'def'];
+assertEquals('abcdef', strings.join(''));
+assertEquals('a,bc,,def', strings.join());
+assertEquals('a, bc, , def', strings.join(', '));
+assertEquals('a\u1234bc\u1234\u1234def', strings.join('\u1234'));
+strings.push('\u1234');
+assertEquals('a-bc--def-\u1234', strings.join('-'));
+assertEquals('abc', ['abc'].join('-'));
+assertEquals('', [].join('-'));
+assertEquals('', [''].join('-'));
+
+var holes = ['a', , 'b', , ];
+assertEquals('a--b-', holes.join('-'));
+assertEquals('ab', holes.join(''));
+assertEquals('1-x--', [1, 'x', null, undefined].join('-'));
+
+// The length of the array is respected.
+var long_array = ['x', 'y', 'z'];
+long_array.length = 5;
+assertEquals('x,y,z,,', long_array.join());
+
+// A toString function that makes the array an array of strings.
+var changing = [{ toString: function() {
+  changing[0] = 'a';
+  return changing.join('+');
+}}, 'b'];
+assertEquals('+b', changing.join('+'));
+assertEquals('a+b', changing.join('+'));
+
+// Arrays longer than the initial maximum fast elements array size, whose
+// elements have to be converted.
+var numbers = [];
+for (var i = 0; i < 120000; i++) numbers.push(i % 10);
+var joined = numbers.join(',');
+assertEquals(2 * 120000 - 1, joined.length);
+assertEquals('0,1,2', joined.substring(0, 5));
+assertEquals('8,9', joined.substring(joined.length - 3));
@@ -117,9 +117,10 @@ function testArgumentTypes(name, argc) {
 var knownProblems = {
   "Abort": true,
 
-  // Avoid calling the concat operation, because weird lengths
+  // Avoid calling the concat and join operations, because weird lengths
   // may lead to out-of-memory.
   "StringBuilderConcat": true,
+  "StringBuilderJoin": true,
 
   // These functions use pseudo-stack-pointers and are not robust
   // to unexpected integer values.
@@ -313,3 +313,43 @@ TestInvalid('1); throw "foo"; (1');
 var x = 0;
 eval("(1); x++; (1)");
 TestInvalid('1); x++; (1');
+
+// Properties are serialized in enumeration order, elements first, for both
+// fast and dictionary mode objects.
+var ordered = {};
+ordered.z = 1;
+ordered.y = 2;
+ordered[3] = 'three';
+ordered[1] = 'one';
+assertEquals('{"1":"one","3":"three","z":1,"y":2}', JSON.stringify(ordered));
+var slow = {};
+for (var i = 0; i < 40; i++) slow['p' + i] = i;
+delete slow.p1;
+var expected = [];
+for (var i = 0; i < 40; i++) if (i != 1) expected.push('"p' + i + '":' + i);
+assertEquals('{' + expected.join(',') + '}', JSON.stringify(slow));
+
+// Accessors, toJSON methods and cycles found inside otherwise plain
+// structures.
+assertEquals('[{"x":1}]', JSON.stringify([{get x() { return 1; }}]));
+assertEquals('{"a":[42]}',
+             JSON.stringify({a: [{toJSON: function() { return 42; }}]}));
+var cyclic = [{}];
+cyclic[0].self = cyclic;
+assertThrows(function () { JSON.stringify(cyclic); }, TypeError);
+
+assertEquals('"\\u0000\\u001f\\u00e9\\u1234\\"\\\\/"',
+             JSON.stringify('\x00\x1f\u00e9\u1234"\\/'));
+assertEquals('[\n 1,\n [\n  2\n ],\n {}\n]',
+             JSON.stringify([1, [2], {}], null, 1));
+
+// toJSON methods on arrays, both own and inherited.
+var withToJSON = [1, 2];
+withToJSON.toJSON = function() { return 5; };
+assertEquals('5', JSON.stringify(withToJSON));
+assertEquals('{"x":5}', JSON.stringify({x: withToJSON}));
+Array.prototype.toJSON = function() { return 'array'; };
+assertEquals('"array"', JSON.stringify([1, 2]));
+assertEquals('{"x":"array"}', JSON.stringify({x: [1]}));
+delete Array.prototype.toJSON;
+assertEquals('[1,2]', JSON.stringify([1, 2]));
@@ -0,0 +1,93 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Test that nested functions behave the same when the bodies of inner
+// functions are skipped, using the preparse data of this script, while
+// the function around them is compiled lazily.
+
+var global = 1;
+
+function module() {
+  function counter(start) {
+    var count = start;
+    return function() { return count++; };
+  }
+  function literals() {
+    return function() {
+      return [[1, 2], { a: /x+/g.source }, [3]];
+    };
+  }
+  function Point(x, y) {
+    this.x = x;
+    this.y = y;
+  }
+  function calls(f) { return function() { return f() + global; }; }
+  function named() {
+    return function self(n) {
+      return n == 0 ? 0 : n + (function() { return self(n - 1); })();
+    };
+  }
+  function evals() {
+    var local = 7;
+    return function() { return eval("local"); };
+  }
+  function withs(o) {
+    with (o) { return function() { return p; }; }
+  }
+  function catches() {
+    try { throw 3; } catch (e) { return function() { return e; }; }
+  }
+  function args() {
+    return function() { return arguments.length; };
+  }
+  function deep() {
+    return function() {
+      var a = 1;
+      return function() {
+        var b = 2;
+        return function() { return a + b; };
+      };
+    };
+  }
+  return { counter: counter, literals: literals, Point: Point, calls: calls,
+           named: named, evals: evals, withs: withs, catches: catches,
+           args: args, deep: deep };
+}
+
+var m = module();
+var c = m.counter(5);
+assertEquals(5, c());
+assertEquals(6, c());
+assertEquals([[1, 2], { a: "x+" }, [3]], m.literals()());
+assertEquals(3, new m.Point(1, 2).x + new m.Point(1, 2).y);
+assertEquals(3, m.calls(function() { return 2; })());
+assertEquals(6, m.named()(3));
+assertEquals(7, m.evals()());
+assertEquals(4, m.withs({ p: 4 })());
+assertEquals(3, m.catches()());
+assertEquals(2, m.args()(1, 2));
+assertEquals(3, m.deep()()()());
@@ -0,0 +1,70 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --regexp-backtrack-limit=1000
+
+// Test that matches that backtrack too much are redone by the linear time
+// matcher, and give up if the pattern is not supported by it.
+
+function repeat(s, n) {
+  var result = "";
+  for (var i = 0; i < n; i++) result += s;
+  return result;
+}
+
+var as = repeat("a", 40);
+
+// These would take exponential time to fail or succeed by backtracking.
+assertNull(/(a+)+b/.exec(as));
+assertNull(/(a|aa)+$/.exec(as + "!"));
+assertNull(/^(\w+\s?)*$/.exec(repeat("word ", 10) + "!"));
+assertEquals([as + "b", as], /(a+)+b/.exec(as + "b"));
+assertEquals([as + "c", "a"], /(a|aa)+c/.exec(as + "c"));
+assertEquals(["x" + as + "b", "x", as], /(x)(a+)*b/.exec("yx" + as + "b"));
+assertEquals([as + "B", "a"], /(a|a?a)+b/i.exec(as + "B"));
+
+// Captures, lazy quantifiers and anchors follow the backtracking semantics.
+var subject = repeat("ab", 30) + "ba";
+assertEquals(["ab", "a", "b"], /(a|ab)*?(b)/.exec(subject));
+assertEquals([subject, "a", undefined],
+             /^(?:(a)|(ab)|b)*(?:a|b)*$/.exec(subject));
+assertEquals(["a" + repeat("ba", 29), "a", "a"],
+             /(a)(?:(?:b(a)|x+)+|y)+/.exec(subject));
+assertEquals(["ba", "b"],
+             /^(\w)(?:\w|\s|x+x+)+$/m.exec(repeat("x", 30) + "!\nba"));
+
+// Global matching and replacing.
+var text = repeat("aaaa b ", 10);
+assertEquals(10, text.match(/(?:a|aa)+(?:a+)+ b/g).length);
+assertEquals(repeat("- ", 10), text.replace(/(a|aa)+(a+)+ b/g, "-"));
+
+// Back references are not supported by the linear time matcher, so the
+// match fails when the limit is reached, even if there is a match later on.
+var xs = repeat("x", 30) + "!xxxxy";
+assertNull(/(x)(?:x+x+)+\1y/.exec(xs));
+assertEquals(["xxxxy", "x"], /(x)(?:x+x+)+\1y/.exec(xs.substring(30)));
+assertEquals(["xxxxy"], /(?:x+x+)+y/.exec(xs));
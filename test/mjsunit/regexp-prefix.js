@@ -0,0 +1,78 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Test regexps that every match must start with a literal string, on
+// subjects long enough for the matcher to search for that string first.
+
+var pad = new Array(301).join("x");
+
+function testExec(expected, re, subject, index) {
+  var m = re.exec(pad + subject);
+  if (expected == null) {
+    assertNull(m, re.source);
+  } else {
+    assertArrayEquals(expected, m, re.source);
+    assertEquals(300 + index, m.index, re.source + " index");
+  }
+}
+
+testExec(["foo12", "12"], /foo(\d+)/, "foo12 foo34", 0);
+testExec(["foo34", "34"], /foo(\d+)/, "foo foo34", 4);
+testExec(null, /foo(\d+)/, "foo fo", 0);
+testExec(null, /foo(\d+)/, "fo", 0);
+testExec(["bar"], /\bbar/, " bar xbar", 1);
+testExec(["bar"], /\bbar/, "xbar bar", 5);
+testExec(["bar"], /^bar/m, "xbar\nbar", 5);
+testExec(null, /^bar/, "bar", 0);
+testExec(["abc"], /(?=ab)abc/, "abd abc", 4);
+testExec(["abababc", "ab"], /(ab)+c/, "abababc", 0);
+testExec(["aab"], /a{2}b/, "ab aab", 3);
+testExec(["aaaab"], /a{2,}b/, "ab aaaab", 3);
+testExec(["z"], /(?:)z/, "z", 0);
+testExec(["cd"], /ab|cd/, "cd", 0);
+testExec(["ሴx"], /ሴx/, "ሴx", 0);
+testExec(null, /ሴx/, "ስx", 0);
+testExec(["xa", "a"], /x(a)/, "a", -1);
+
+// Case insensitive regexps match the prefix in any case.
+testExec(["FOO1", "1"], /foo(\d)/i, "FOO1", 0);
+
+// Global regexps start searching from lastIndex.
+var re = /q(\d)/g;
+var subject = pad + "q1q2";
+re.lastIndex = 301;
+assertArrayEquals(["q2", "2"], re.exec(subject));
+assertEquals(304, re.lastIndex);
+assertNull(re.exec(subject));
+assertEquals(0, re.lastIndex);
+
+assertEquals("<1>b2<3>", (pad + "a1b2a3").replace(/a(\d)/g, "<$1>").slice(300));
+assertArrayEquals(["a1", "a3"], (pad + "a1b2a3").match(/a\d/g));
+assertArrayEquals(["a1", "a3"], "a1b2a3".match(/a\d/g));
+assertEquals(pad.length + 2, (pad + "a1b2a3").search(/b\d/));
+assertEquals(-1, (pad + "a1b2a3").search(/b\d\d/));
+assertArrayEquals([pad, "b2", ""], (pad + "a1b2a3").split(/a\d/));
@@ -0,0 +1,87 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// Test case conversion, trimming and comparison of ASCII and two-byte
+// strings of lengths around the word size.
+
+function repeat(s, n) {
+  var result = "";
+  for (var i = 0; i < n; i++) result += s;
+  return result;
+}
+
+var letters = "@AZ[`az{ 09~\x7f";
+var lower = "@az[`az{ 09~\x7f";
+var upper = "@AZ[`AZ{ 09~\x7f";
+for (var i = 0; i < 40; i++) {
+  var prefix = repeat("x", i);
+  var s = prefix + letters + prefix.toUpperCase();
+  assertEquals(prefix + lower + prefix, s.toLowerCase());
+  assertEquals(prefix.toUpperCase() + upper + prefix.toUpperCase(),
+               s.toUpperCase());
+  // Substrings start at all alignments.
+  for (var j = 0; j < 9; j++) {
+    var sub = s.substring(j);
+    assertEquals(s.toLowerCase().substring(j), sub.toLowerCase());
+    assertEquals(s.toUpperCase().substring(j), sub.toUpperCase());
+  }
+}
+
+// Strings that need no conversion.
+assertEquals("abc def", "abc def".toLowerCase());
+assertEquals("ABC DEF", "ABC DEF".toUpperCase());
+assertEquals("", "".toLowerCase());
+
+// Two-byte strings with only ASCII characters, made by slicing off the
+// non-ASCII character of a two-byte string.
+var two_byte = "\u1234Hello, World!";
+assertEquals("hello, world!", two_byte.substring(1).toLowerCase());
+assertEquals("HELLO, WORLD!", two_byte.substring(1).toUpperCase());
+assertEquals("\u1234hello, world!", two_byte.toLowerCase());
+assertEquals("\u1234HELLO, WORLD!", two_byte.toUpperCase());
+assertEquals("\u03b1\u03b2 abc", "\u0391\u0392 ABC".toLowerCase());
+assertEquals("SS ABC", "\u00df abc".toUpperCase());
+
+// Trimming.
+var white = " \t\n\v\f\r\u00a0\u2028\u3000\u200b";
+assertEquals("a b", (white + "a b" + white).trim());
+assertEquals("a b" + white, (white + "a b" + white).trimLeft());
+assertEquals(white + "a b", (white + "a b" + white).trimRight());
+assertEquals("\u1234", (white + "\u1234" + white).trim());
+assertEquals("", white.trim());
+assertEquals("x", (repeat(" ", 20) + "x" + repeat("\t", 20)).trim());
+assertEquals("\x08x\x0e", "\x08x\x0e".trim());
+
+// Comparison of ASCII and two-byte strings with the same contents.
+for (var i = 0; i < 20; i++) {
+  var ascii = repeat("ab", i) + "c";
+  var uc16 = ("\u1234" + ascii).substring(1);
+  assertTrue(ascii == uc16);
+  assertFalse(ascii + "d" == uc16 + "e");
+  assertFalse(ascii.substring(1) + "c" == uc16.substring(1) + "d");
+}
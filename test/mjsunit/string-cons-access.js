@@ -0,0 +1,77 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Test string operations on cons strings that are not flattened because
+// they are only used once, comparing with the results on flat strings.
+
+var parts = ["a", "b", "ab", "ba", "ሴ", "xyz", "aaaa", "bሴa"];
+
+var seed = 17;
+function random(n) {
+  seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+  return seed % n;
+}
+
+function check(left, right, flat) {
+  var pattern = flat.substr(random(flat.length), 1 + random(20));
+  var from = random(flat.length);
+  assertEquals(flat.indexOf(pattern, from),
+               (left + right).indexOf(pattern, from));
+  assertEquals(flat.indexOf("abሴ"), (left + right).indexOf("abሴ"));
+  var index = random(flat.length);
+  assertEquals(flat.charCodeAt(index), (left + right).charCodeAt(index));
+  assertTrue(flat == left + right);
+  var other = flat.substring(0, index) + "q" + flat.substring(index + 1);
+  assertEquals(flat < other, left + right < other);
+  assertEquals(flat.localeCompare(other), (left + right).localeCompare(other));
+}
+
+for (var i = 0; i < 200; i++) {
+  var chosen = [];
+  var length = 100 + random(400);
+  for (var j = 0; j < length; j++) chosen.push(parts[random(parts.length)]);
+  var flat = chosen.join("");
+  var split = random(length);
+  var left = "";
+  var right = "";
+  for (var j = 0; j < split; j++) left += chosen[j];
+  for (var j = length - 1; j >= split; j--) right = chosen[j] + right;
+  check(left, right, flat);
+}
+
+// Inspect a string after each step while building it.
+var s = "";
+var expected = [];
+for (var i = 0; i < 1000; i++) {
+  s += "line " + i + "\n";
+  expected.push("line " + i + "\n");
+  assertEquals("\n".charCodeAt(0), s.charCodeAt(s.length - 1));
+  assertEquals(s.length - String(i).length - 6,
+               s.indexOf("line " + i, s.length - 20));
+  assertEquals(0, s.indexOf("line 0\n"));
+}
+assertEquals(expected.join(""), s);
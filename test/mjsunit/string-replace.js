@@ -207,3 +207,18 @@ replaceTest("[ab-aabb-ab-b][az-aazz-az-z]",
 
 replaceTest("[ab-aabb-ab-b][az-aazz-az-z]",
             "abaz", /a(.)/g, replacer);
+
+// Single replacements write the prefix, the replacement and the suffix
+// straight into the result.
+replaceTest("axc", "abc", "b", "x");
+replaceTest("abc", "abc", "", "");
+replaceTest("", "abc", "abc", "");
+replaceTest("xyz", "abc", "abc", "xyz");
+replaceTest("aሴc", "abc", "b", "ሴ");
+replaceTest("ሴxc", "ሴbc", "b", "x");
+replaceTest("a42c", "abc", "b", function() { return 42; });
+replaceTest("anullc", "abc", /b/, function() { return null; });
+replaceTest("a[b,1]c", "abc", "b",
+            function(m, i) { return "[" + m + "," + i + "]"; });
+replaceTest("a[b]c", "abc", /(b)/, function(m, c1) { return "[" + c1 + "]"; });
+replaceTest("a<b>c", "abc", "b", "<$&>");
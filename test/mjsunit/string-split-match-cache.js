@@ -0,0 +1,71 @@
+// Copyright 2010 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --expose-gc
+
+// Repeatedly split and match the same (symbol) subjects, using fresh
+// regexp objects so that the results come from the runtime results cache,
+// and check that the results and the last match info are right and that
+// modifying a result does not affect later results.
+
+var subject = "key1=value1;key2=value2;key3";
+
+function splitString() { return subject.split(";"); }
+function splitRegExp() { return subject.split(/([;=])/); }
+function matchRegExp() { return subject.match(/key(\d)/g); }
+
+for (var i = 0; i < 3; i++) {
+  var parts = splitString();
+  assertArrayEquals(["key1=value1", "key2=value2", "key3"], parts);
+  parts[0] = "modified";
+  parts.push("extra");
+
+  parts = splitRegExp();
+  assertEquals(9, parts.length);
+  assertEquals("value2", parts[6]);
+  assertEquals(";", RegExp.lastMatch);
+  assertEquals("key1=value1;key2=value2", RegExp.leftContext);
+  parts.length = 0;
+
+  var matches = matchRegExp();
+  assertArrayEquals(["key1", "key2", "key3"], matches);
+  assertEquals("key3", RegExp.lastMatch);
+  assertEquals("3", RegExp.$1);
+  matches[1] = "modified";
+
+  assertNull(subject.match(/nomatch/g));
+  assertArrayEquals([subject], subject.split(/nomatch/));
+  // The last match info is not updated when there is no match.
+  assertEquals("key3", RegExp.lastMatch);
+
+  // Splitting with a limit gives a different result.
+  assertArrayEquals(["key1", "="], subject.split(/([;=])/, 2));
+  assertEquals("=", RegExp.lastMatch);
+  assertEquals("key1", RegExp.leftContext);
+
+  if (i == 1) gc();
+}
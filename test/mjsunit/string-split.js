@@ -124,3 +124,22 @@ expected = ["a", "b"]
 result = "ab".split(/(?=)/);
 assertArrayEquals(expected, result, 20);
 
+
+// Captures, limits and the last match info.
+assertArrayEquals(["a", "1", "b", "2"], "a1b2c3".split(/(\d)/, 4), 21);
+assertArrayEquals(["A", undefined, "B", "bold", "/", "B", "and"],
+                  "A<B>bold</B>and".split(/<(\/)?([^<>]+)>/), 22);
+"a b c".split(/ /, 2);
+assertEquals(" ", RegExp.lastMatch, 23);
+assertEquals("c", RegExp.rightContext, 24);
+"abc".split(/$/);
+assertEquals("abc", RegExp.leftContext, 25);
+"xyz".split(/q/);
+assertEquals("abc", RegExp.leftContext, 26);
+
+// Split a long subject.
+var parts = [];
+for (var i = 0; i < 10000; i++) parts.push("part" + i);
+result = parts.join(", ").split(/\s*,\s*/);
+assertEquals(10000, result.length, 27);
+assertEquals("part9999", result[9999], 28);
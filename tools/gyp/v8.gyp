@@ -333,6 +333,8 @@
         '../../src/ic.h',
         '../../src/interpreter-irregexp.cc',
         '../../src/interpreter-irregexp.h',
+        '../../src/isolate.cc',
+        '../../src/isolate.h',
         '../../src/jump-target-inl.h',
         '../../src/jump-target.cc',
         '../../src/jump-target.h',
@@ -378,6 +380,8 @@
         '../../src/regexp-macro-assembler-tracer.h',
         '../../src/regexp-macro-assembler.cc',
         '../../src/regexp-macro-assembler.h',
+        '../../src/regexp-nfa.cc',
+        '../../src/regexp-nfa.h',
         '../../src/regexp-stack.cc',
         '../../src/regexp-stack.h',
         '../../src/register-allocator.h',
@@ -403,6 +407,7 @@
         '../../src/spaces.cc',
         '../../src/spaces.h',
         '../../src/string-stream.cc',
+        '../../src/string-search.h',
         '../../src/string-stream.h',
         '../../src/stub-cache.cc',
         '../../src/stub-cache.h',